@@ -0,0 +1,92 @@
+/**
+ ********************************************************************************
+ * @file        BenchAdc.cpp
+ *
+ * @brief       Benchmark of the acquisition engine on the host: a converter thread fills the buffer with the
+ *              simulated dual ADC, the processing thread receives, sums and releases the blocks. The converter
+ *              completes a half only after the previous one is released, so the rate is the one of the
+ *              slower thread and the lost blocks show a broken hand over.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AcquisitionEngine.hpp"
+#include "AdcFrontEndSim.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace Adc;
+
+namespace {
+
+/// @brief Blocks per measurement.
+constexpr uint32_t BLOCKS{20000U};
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%u blocks per measurement, 2 samples per word\n\n", BLOCKS);
+    std::printf("%-12s %8s %14s %10s\n", "block words", "blocks", "MSamples/s", "lost");
+
+    for (const uint16_t blockWords : {256U, 1024U, 4096U})
+    {
+        for (const uint8_t blocks : {4U, 8U})
+        {
+            AdcFrontEndSim frontEnd;
+            AcquisitionEngine engine(frontEnd);
+            std::vector<uint32_t> buffer(static_cast<size_t>(blockWords) * blocks);
+            (void)engine.Start({MultiMode::DUAL_SIMULTANEOUS, 1000000U, buffer.data(), blockWords, blocks});
+
+            std::atomic<uint32_t> released{0U};
+            const uint32_t halfWords = blockWords * (blocks / 2U);
+            const auto start = std::chrono::steady_clock::now();
+            std::thread converter([&]() {
+                while (engine.GetProducedBlocks() < BLOCKS)
+                {
+                    frontEnd.Convert(halfWords - 1U);
+                    while (released.load(std::memory_order_acquire) < engine.GetProducedBlocks())
+                    {
+                        std::this_thread::yield();
+                    }
+                    frontEnd.Convert(1U);
+                }
+            });
+
+            uint64_t sum = 0U;
+            SampleBlock block{};
+            while (engine.GetProducedBlocks() < BLOCKS)
+            {
+                if (!engine.Receive(block))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (const uint32_t word : block.words)
+                {
+                    sum += Master(word) + Slave(word);
+                }
+                (void)engine.Release(block);
+                released.fetch_add(1U, std::memory_order_release);
+            }
+            converter.join();
+            const double seconds = Since(start);
+            const double rate = 2.0 * blockWords * static_cast<double>(engine.GetProducedBlocks()) / seconds / 1e6;
+            std::printf("%-12u %8u %14.1f %10u %s\n", blockWords, blocks, rate, engine.GetLostBlocks(),
+                        (sum > 0U) ? "" : "(no data)");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ ********************************************************************************
+ * @file        BenchAudio.cpp
+ *
+ * @brief       Benchmark of the audio engine on the host: the simulated port runs as a null device (no
+ *              recording) and the engine mixes N sources per period, then the asynchronous resampler converts
+ *              between 44.1 kHz and 48 kHz. The real time factor is the audio time per processing time.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AsyncResampler.hpp"
+#include "AudioEngine.hpp"
+#include "SaiPortSim.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Audio;
+
+namespace {
+
+/// @brief Audio seconds per measurement.
+constexpr uint32_t SECONDS{20U};
+
+/// @brief Frame rate of the engine.
+constexpr uint32_t RATE{48000U};
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief A source which repeats a period of noise.
+class Pattern : public IAudioSource
+{
+    public:
+        explicit Pattern(uint32_t seed)
+        {
+            for (float& sample : mSamples)
+            {
+                seed = (seed * 1664525U) + 1013904223U;
+                sample = static_cast<float>(static_cast<int32_t>(seed)) / 4294967296.0F;
+            }
+        }
+
+        uint32_t Read(std::span<float> frames, uint8_t channels) override
+        {
+            const size_t count = std::min(frames.size(), mSamples.size());
+            std::copy_n(mSamples.begin(), count, frames.begin());
+            return static_cast<uint32_t>(count / channels);
+        }
+
+    private:
+        std::array<float, MAX_PERIOD_FRAMES * MAX_CHANNELS> mSamples{};
+};
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%u s of audio per measurement at %u Hz\n\n", SECONDS, RATE);
+    std::printf("%-10s %9s %8s %14s %12s\n", "channels", "period", "sources", "us/period", "realtime");
+
+    for (const uint8_t channels : {2U, 8U})
+    {
+        for (const uint16_t period : {32U, 128U})
+        {
+            for (const uint8_t sources : {1U, 4U, 8U})
+            {
+                SaiPortSim port;
+                port.SetRecording(false);
+                AudioEngine engine(port);
+                std::vector<Pattern> patterns;
+                patterns.reserve(sources);
+                for (uint8_t i = 0U; i < sources; i++)
+                {
+                    patterns.emplace_back(i + 1U);
+                    uint8_t index = 0U;
+                    (void)engine.GetMixer().AddSource(patterns.back(), 0.1F, index);
+                }
+                std::vector<int32_t> tx(2U * period * channels);
+                std::vector<int32_t> rx(2U * period * channels);
+                (void)engine.Start({RATE, channels, period, tx.data(), rx.data()});
+
+                const uint32_t periods = SECONDS * RATE / period;
+                const auto start = std::chrono::steady_clock::now();
+                (void)port.Tick(periods);
+                const double seconds = Since(start);
+                std::printf("%-10u %9u %8u %14.2f %12.0f\n", channels, period, sources,
+                            seconds / periods * 1e6, SECONDS / seconds);
+            }
+        }
+    }
+
+    std::printf("\n%-10s %9s %8s %14s %12s\n", "channels", "input", "output", "ns/frame", "realtime");
+    for (const uint8_t channels : {2U, 8U})
+    {
+        for (const auto& [inputRate, outputRate] : {std::pair{44100U, 48000U}, std::pair{48000U, 44100U}})
+        {
+            std::vector<float> fifo(static_cast<size_t>(channels) * 1024U);
+            AsyncResampler resampler;
+            (void)resampler.Configure({inputRate, outputRate, channels, fifo});
+
+            // the producer delivers its frames of a period ahead of every read
+            std::vector<float> input(static_cast<size_t>(channels) * 2U * 64U, 0.1F);
+            std::vector<float> output(static_cast<size_t>(channels) * 64U);
+            const double step = static_cast<double>(inputRate) / outputRate;
+            const uint32_t periods = SECONDS * outputRate / 64U;
+            double due = 0.0;
+            uint64_t written = 0U;
+            const auto start = std::chrono::steady_clock::now();
+            for (uint32_t p = 0U; p < periods; p++)
+            {
+                due += step * 64.0;
+                const auto frames = static_cast<size_t>(static_cast<uint64_t>(due) - written);
+                written += resampler.Write({input.data(), frames * channels});
+                (void)resampler.Read(output, channels);
+            }
+            const double seconds = Since(start);
+            std::printf("%-10u %9u %8u %14.1f %12.0f %s\n", channels, inputRate, outputRate,
+                        seconds / (static_cast<double>(periods) * 64.0) * 1e9, SECONDS / seconds,
+                        (resampler.GetUnderruns() == 0U) ? "" : "(underrun)");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ ********************************************************************************
+ * @file        BenchCan.cpp
+ *
+ * @brief       Benchmark of the CAN router: interrupts and cost per frame for the RX FIFO
+ *              watermark and the perfect hash lookup against a linear subscription scan.
+ *              Worst case wait of control frames behind a bulk backlog per TX in-flight limit.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CanRouter.hpp"
+#include "CanTxScheduler.hpp"
+#include "FdcanSim.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace Can;
+
+namespace {
+
+/// @brief Frames per measurement.
+constexpr size_t FRAME_COUNT{1000000U};
+
+/// @brief Subscribed identifiers.
+constexpr uint32_t SUBSCRIPTIONS{128U};
+
+/// @brief 80 % load of 1 Mbit/s arbitration and 5 Mbit/s data phase with 64 byte frames, about 110 us per frame.
+constexpr double FRAME_TIME_US{110.0};
+
+/// @brief Sums the first byte, so the handler reads the message RAM.
+class Sink : public CanRouter::IHandler
+{
+    public:
+        void OnFrame(const CanFrame& frame) override
+        {
+            sum = sum + frame.pData[0];
+        }
+
+        volatile uint32_t sum{0U};
+};
+
+/// @brief The subscribed identifiers, spread over the standard range.
+uint32_t IdOf(uint32_t index)
+{
+    return 0x010U + (index * 13U);
+}
+
+/**
+ * @brief   All frames through filter, FIFO and router.
+ * @return  Nanoseconds per frame, interrupts per frame in irqPerFrame.
+ */
+double RouteCost(uint32_t watermark, double& irqPerFrame)
+{
+    auto controller = std::make_unique<FdcanSim<>>();
+    auto router = std::make_unique<CanRouter>(*controller, CanRouter::Config{watermark, 0U});
+    Sink sink;
+    for (uint32_t i = 0U; i < SUBSCRIPTIONS; i++)
+    {
+        (void)router->Subscribe(IdOf(i), false, RxFifo::FIFO0, sink);
+    }
+    (void)router->Start();
+
+    std::array<uint8_t, MAX_DATA_SIZE> data{};
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < FRAME_COUNT; i++)
+    {
+        data[0] = static_cast<uint8_t>(i);
+        (void)controller->InjectFrame(IdOf(static_cast<uint32_t>((i * 7U) % SUBSCRIPTIONS)), false, data.data(),
+                                      data.size());
+    }
+    router->Poll();
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    irqPerFrame = static_cast<double>(controller->GetInterrupts()) / static_cast<double>(FRAME_COUNT);
+    return ns / static_cast<double>(FRAME_COUNT);
+}
+
+/// @return Nanoseconds per lookup, perfect hash or linear scan of the subscriptions.
+double LookupCost(bool hash)
+{
+    auto table = std::make_unique<IdTable>();
+    std::vector<uint32_t> ids;
+    for (uint32_t i = 0U; i < SUBSCRIPTIONS; i++)
+    {
+        ids.push_back(IdOf(i));
+        (void)table->Add(IdTable::MakeKey(IdOf(i), false), static_cast<uint16_t>(i));
+    }
+    (void)table->Build();
+
+    volatile uint32_t found = 0U;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < FRAME_COUNT; i++)
+    {
+        const uint32_t id = IdOf(static_cast<uint32_t>((i * 7U) % SUBSCRIPTIONS));
+        if (hash)
+        {
+            found = found + table->Find(IdTable::MakeKey(id, false));
+        }
+        else
+        {
+            for (size_t route = 0U; route < ids.size(); route++)
+            {
+                if (ids[route] == id)
+                {
+                    found = found + static_cast<uint32_t>(route);
+                    break;
+                }
+            }
+        }
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+           static_cast<double>(FRAME_COUNT);
+}
+
+/// @brief Frame slots as time base, one tick per sent frame.
+class FrameClock : public Utils::ITimeSource
+{
+    public:
+        uint64_t GetTimeNs() const override {return now;};
+
+        uint64_t now{0U};
+};
+
+/**
+ * @brief   A bulk backlog of FIFO depth with a control frame every 10th bus slot.
+ * @return  Worst wait of a control frame in frame times.
+ */
+uint64_t ControlWait(uint32_t maxInFlight)
+{
+    constexpr size_t BULK_FRAMES{2000U};
+    auto controller = std::make_unique<FdcanSim<>>();
+    FrameClock clock;
+    CanTxScheduler scheduler(*controller, clock, CanTxScheduler::Config{maxInFlight});
+    (void)scheduler.SetClass(0x000U, 0x0FFU, false, TxClass::CONTROL);
+    (void)scheduler.SetClass(0x600U, 0x7FFU, false, TxClass::BULK);
+    scheduler.Start();
+
+    std::array<uint8_t, MAX_DATA_SIZE> data{};
+    std::vector<TxRequest> bulk(BULK_FRAMES);
+    for (size_t i = 0U; i < bulk.size(); i++)
+    {
+        bulk[i].frame = TxFrame{0x600U + static_cast<uint32_t>(i % 0x100U), false, true, true, MAX_DATA_SIZE, data.data()};
+        (void)scheduler.Submit(bulk[i]);
+    }
+    TxRequest control{};
+    control.frame = TxFrame{0x010U, false, false, false, 8U, data.data()};
+    CanFrame frame{};
+    while (controller->TransmitNext(frame))
+    {
+        clock.now++;
+        if (((clock.now % 10U) == 0U) && (control.status != Status::PENDING))
+        {
+            (void)scheduler.Submit(control);
+        }
+    }
+    return scheduler.GetLatency(TxClass::CONTROL).maxNs;
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%u subscriptions, 64 byte FD frames, one frame every %.0f us at 80 %% bus load\n\n", SUBSCRIPTIONS,
+                FRAME_TIME_US);
+
+    std::printf("%-10s %12s %12s\n", "watermark", "irq/frame", "ns/frame");
+    for (const uint32_t watermark : {0U, 4U, 16U, 32U, 48U})
+    {
+        double irqPerFrame = 0.0;
+        const double ns = RouteCost(watermark, irqPerFrame);
+        std::printf("%-10u %12.3f %12.1f\n", watermark, irqPerFrame, ns);
+    }
+
+    std::printf("\nlookup of %u identifiers: perfect hash %.1f ns, linear scan %.1f ns\n", SUBSCRIPTIONS,
+                LookupCost(true), LookupCost(false));
+
+    std::printf("\n%-10s %24s\n", "in-flight", "worst control wait/frames");
+    for (const uint32_t maxInFlight : {1U, 2U, 4U, 8U, 32U})
+    {
+        std::printf("%-10u %24llu\n", maxInFlight, static_cast<unsigned long long>(ControlWait(maxInFlight)));
+    }
+    return 0;
+}
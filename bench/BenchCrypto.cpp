@@ -0,0 +1,82 @@
+/**
+ ********************************************************************************
+ * @file        BenchCrypto.cpp
+ *
+ * @brief       Throughput benchmark of the crypto service with the software engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CryptoService.hpp"
+#include "CryptoEngineSoft.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Crypto;
+
+namespace {
+
+/// @brief Total payload per measurement.
+constexpr size_t TOTAL_BYTES{64U * 1024U * 1024U};
+
+double Run(CryptoService& service, Algorithm algo, size_t packetSize)
+{
+    AesKey key{};
+    key.length = 16U;
+    for (size_t i = 0U; i < key.length; i++)
+    {
+        key.bytes[i] = static_cast<uint8_t>(i);
+    }
+
+    std::vector<uint8_t> buffer(packetSize, 0xA5U);
+    std::array<uint8_t, 16> aad{};
+    CryptoJob job{};
+    job.algorithm = algo;
+    job.pKey = &key;
+    job.pInput = buffer.data();
+    job.pOutput = buffer.data();
+    job.length = static_cast<uint32_t>(packetSize);
+    if (algo == Algorithm::AES_GCM)
+    {
+        job.pAad = aad.data();
+        job.aadLength = static_cast<uint32_t>(aad.size());
+    }
+
+    const size_t packets = TOTAL_BYTES / packetSize;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < packets; i++)
+    {
+        job.iv[11] = static_cast<uint8_t>(i);
+        (void)service.Submit(job);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+    return (static_cast<double>(packets * packetSize) / (1024.0 * 1024.0)) / seconds;
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    CryptoEngineSoft engine;
+    CryptoService service(engine);
+
+    AesKey probe{};
+    probe.length = 16U;
+    CryptoJob job{};
+    job.pKey = &probe;
+    (void)engine.Process(job);
+
+    std::printf("AES engine: %s\n", engine.IsAccelerated() ? "AES-NI/PCLMULQDQ" : "portable software");
+    std::printf("%-8s %10s %12s\n", "mode", "packet", "MiB/s");
+    for (const size_t size : {64U, 256U, 1500U, 16384U})
+    {
+        std::printf("%-8s %10zu %12.1f\n", "AES-CTR", size, Run(service, Algorithm::AES_CTR, size));
+        std::printf("%-8s %10zu %12.1f\n", "AES-GCM", size, Run(service, Algorithm::AES_GCM, size));
+    }
+    return 0;
+}
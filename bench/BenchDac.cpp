@@ -0,0 +1,79 @@
+/**
+ ********************************************************************************
+ * @file        BenchDac.cpp
+ *
+ * @brief       Benchmark of the DAC waveform engine on the host: the simulated port runs without recording
+ *              and the engine renders N tones (constant or sweeping) per half of the ring at 1 MSPS. The
+ *              real time factor is the signal time per processing time.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DacEngine.hpp"
+#include "DacPortSim.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Dac;
+
+namespace {
+
+/// @brief Signal seconds per measurement.
+constexpr uint32_t SECONDS{20U};
+
+/// @brief Sample rate of the stream.
+constexpr uint32_t RATE{1000000U};
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%u s of signal per measurement at %u Hz\n\n", SECONDS, RATE);
+    std::printf("%-10s %6s %8s %8s %12s %10s\n", "channels", "half", "tones", "sweep", "ns/frame", "realtime");
+
+    for (const uint8_t channels : {1U, 2U})
+    {
+        for (const uint8_t tones : {1U, 4U, 8U})
+        {
+            for (const bool sweep : {false, true})
+            {
+                DacPortSim port;
+                port.SetRecording(false);
+                DacEngine engine(port);
+                for (uint8_t channel = 0U; channel < channels; channel++)
+                {
+                    DdsSynth& synth = engine.GetSynth(channel);
+                    for (uint8_t i = 0U; i < tones; i++)
+                    {
+                        (void)synth.SetTone(i, {1000.0F * (i + 1U), 0.1F, 0.0F, {}});
+                        if (sweep)
+                        {
+                            (void)synth.SetSweep(i, {20000.0F * (i + 1U), 0.1F, SweepMode::BOUNCE});
+                        }
+                    }
+                }
+                constexpr uint16_t HALF{1000U};
+                std::vector<uint32_t> ring(2U * HALF);
+                (void)engine.Start({RATE, channels, HALF, ring.data()});
+
+                const uint32_t halves = SECONDS * RATE / HALF;
+                const auto start = std::chrono::steady_clock::now();
+                (void)port.Tick(halves);
+                const double seconds = Since(start);
+                std::printf("%-10u %6u %8u %8s %12.2f %10.0f\n", channels, HALF, tones, sweep ? "yes" : "no",
+                            seconds / (static_cast<double>(halves) * HALF) * 1e9, SECONDS / seconds);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ ********************************************************************************
+ * @file        BenchDsp.cpp
+ *
+ * @brief       Benchmark of the float dsp kernels on the host: FIR, biquad cascade, complex and real FFT,
+ *              matrix multiply and statistics in MSamples/s per kernel set.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "BiquadCascade.hpp"
+#include "ComplexFft.hpp"
+#include "FirFilter.hpp"
+#include "MatrixMath.hpp"
+#include "RealFft.hpp"
+#include "Statistics.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief Samples per block, an audio or FFT frame.
+constexpr uint32_t COUNT{1024U};
+
+/// @brief Blocks per measurement.
+constexpr uint32_t ROUNDS{2000U};
+
+/// @brief Rows and columns of the square matrices.
+constexpr uint16_t DIMENSION{32U};
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Million samples per second of a block operation.
+template<typename Run>
+double Measure(uint32_t samples, Run run)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0U; n < ROUNDS; n++)
+    {
+        run();
+    }
+    return static_cast<double>(samples) * ROUNDS / Since(start) / 1e6;
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%u samples per block, %u blocks per measurement, MSamples/s\n", COUNT, ROUNDS);
+    std::printf("matrix: %ux%u multiply, a sample is an element of the product\n\n", DIMENSION, DIMENSION);
+
+    std::vector<float> in(2U * COUNT);
+    std::vector<float> out(2U * COUNT);
+    for (uint32_t i = 0U; i < in.size(); i++)
+    {
+        in[i] = static_cast<float>(static_cast<int32_t>(i * 2654435761U)) / 2147483648.0F;
+    }
+    std::vector<float> taps(64U);
+    for (uint32_t i = 0U; i < taps.size(); i++)
+    {
+        taps[i] = 1.0F / static_cast<float>(taps.size());
+    }
+    const std::vector<float> sections{
+        0.0675F, 0.1349F, 0.0675F, 1.1430F, -0.4128F,
+        0.2066F, 0.4131F, 0.2066F, 0.3695F, -0.1958F,
+        0.0675F, 0.1349F, 0.0675F, 1.1430F, -0.4128F,
+        0.2066F, 0.4131F, 0.2066F, 0.3695F, -0.1958F};
+    std::vector<float> a(DIMENSION * DIMENSION, 0.5F);
+    std::vector<float> b(DIMENSION * DIMENSION, 0.25F);
+    std::vector<float> c(DIMENSION * DIMENSION);
+
+    std::printf("%-8s %10s %10s %10s %10s %10s %10s\n", "kernel", "fir64", "biquad4", "cfft1024", "rfft1024",
+                "matmul", "mean+var");
+    const char* pKernels[] = {"scalar", "avx2"};
+    for (uint32_t k = 0U; k <= static_cast<uint32_t>(GetBestSimdKernel()); k++)
+    {
+        const SimdKernel kernel = static_cast<SimdKernel>(k);
+        FirFilter fir(kernel);
+        (void)fir.Configure(taps);
+        BiquadCascade biquad(kernel);
+        (void)biquad.Configure(sections);
+        ComplexFft cfft(kernel);
+        (void)cfft.Configure(COUNT);
+        RealFft rfft(kernel);
+        (void)rfft.Configure(COUNT);
+        MatrixMath math(kernel);
+        Matrix ma{DIMENSION, DIMENSION, a.data()};
+        Matrix mb{DIMENSION, DIMENSION, b.data()};
+        Matrix mc{DIMENSION, DIMENSION, c.data()};
+        Statistics statistics(kernel);
+        const std::span<const float> block(in.data(), COUNT);
+        float mean = 0.0F;
+        float variance = 0.0F;
+
+        const double firRate = Measure(COUNT, [&]() {(void)fir.Process(block, out);});
+        const double biquadRate = Measure(COUNT, [&]() {(void)biquad.Process(block, out);});
+        // the transforms of a constant frame, the copy is part of the measurement
+        const double cfftRate = Measure(COUNT, [&]() {out = in; (void)cfft.Forward(out);});
+        const double rfftRate = Measure(COUNT, [&]() {(void)rfft.Forward(block, out);});
+        const double matrixRate = Measure(DIMENSION * DIMENSION, [&]() {(void)math.Multiply(ma, mb, mc);});
+        const double statisticsRate = Measure(COUNT, [&]() {
+            (void)statistics.Mean(block, mean);
+            (void)statistics.Variance(block, variance);
+        });
+        std::printf("%-8s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", pKernels[k], firRate, biquadRate, cfftRate,
+                    rfftRate, matrixRate, statisticsRate);
+    }
+    return 0;
+}
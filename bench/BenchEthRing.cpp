@@ -0,0 +1,155 @@
+/**
+ ********************************************************************************
+ * @file        BenchEthRing.cpp
+ *
+ * @brief       Benchmark of the ETH descriptor ring simulation: drops per ring depth and
+ *              the cost of the zero-copy receive path against a copying one.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "EthDeviceSim.hpp"
+#include "PacketPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace Net;
+
+namespace {
+
+/// @brief Frames per measurement.
+constexpr size_t FRAME_COUNT{200000U};
+
+/// @brief Maximum ethernet frame without FCS.
+constexpr size_t FRAME_SIZE{1514U};
+
+/// @brief 100 Mbit/s: 1538 byte times per maximum frame (preamble, FCS, IFG) = 123 us.
+constexpr double FRAME_TIME_US{123.04};
+
+/// @brief Frames received per timed drain, the clock reads are spread over them.
+constexpr size_t RECEIVE_BURST{4U};
+
+/// @brief Runs of each receive path.
+constexpr uint32_t RECEIVE_RUNS{5U};
+
+std::unique_ptr<PacketPoolStorage<PBUF_COUNT>> sStorage{std::make_unique<PacketPoolStorage<PBUF_COUNT>>()};
+
+/// @brief Results of the measured reads, a volatile store the compiler can't drop.
+volatile uint32_t sSink{0U};
+
+/// @brief The application reads every byte of a payload segment.
+uint32_t Consume(const uint8_t* pData, size_t length)
+{
+    uint32_t sum = 0U;
+    for (size_t i = 0U; i < length; i++)
+    {
+        sum += pData[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief   Frames arrive in bursts while the application is busy, then it drains the ring.
+ * @return  Dropped frames in percent.
+ */
+template <size_t DEPTH>
+double DropRate(size_t burst)
+{
+    PacketPool pool(sStorage->buffers.data(), PBUF_COUNT);
+    EthDeviceSim<DEPTH, TX_DESC_COUNT> device(pool);
+    device.Start();
+    const std::vector<uint8_t> frame(FRAME_SIZE, 0x5AU);
+
+    for (size_t sent = 0U; sent < FRAME_COUNT; sent += burst)
+    {
+        for (size_t i = 0U; i < burst; i++)
+        {
+            (void)device.InjectFrame(frame.data(), frame.size());
+        }
+        PacketBuffer* pFrame{nullptr};
+        while ((pFrame = device.Receive()) != nullptr)
+        {
+            (void)pool.Free(pFrame);
+        }
+    }
+    return (100.0 * device.GetRxDropped()) / static_cast<double>(FRAME_COUNT);
+}
+
+/// @return Nanoseconds per received frame, with or without a copy into an application buffer.
+double ReceiveCost(bool copy)
+{
+    PacketPool pool(sStorage->buffers.data(), PBUF_COUNT);
+    EthDeviceSim<> device(pool);
+    device.Start();
+    const std::vector<uint8_t> frame(FRAME_SIZE, 0x5AU);
+    std::vector<uint8_t> appBuffer(FRAME_SIZE);
+    double busy = 0.0;
+    size_t received = 0U;
+
+    for (size_t sent = 0U; sent < FRAME_COUNT; sent += RECEIVE_BURST)
+    {
+        for (size_t i = 0U; i < RECEIVE_BURST; i++)
+        {
+            (void)device.InjectFrame(frame.data(), frame.size());
+        }
+
+        // only the application side is measured, InjectFrame plays the DMA
+        const auto start = std::chrono::steady_clock::now();
+        PacketBuffer* pFrame{nullptr};
+        while ((pFrame = device.Receive()) != nullptr)
+        {
+            // both paths read the same segments, they differ in the copy only
+            uint32_t sum = 0U;
+            size_t offset = 0U;
+            for (const PacketBuffer* pBuffer = pFrame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+            {
+                const uint8_t* pData = pBuffer->pPayload;
+                if (copy)
+                {
+                    std::memcpy(&appBuffer[offset], pData, pBuffer->length);
+                    pData = &appBuffer[offset];
+                }
+                sum += Consume(pData, pBuffer->length);
+                offset += pBuffer->length;
+            }
+            (void)pool.Free(pFrame);
+            sSink = sum;
+            received++;
+        }
+        busy += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    return busy / static_cast<double>(received);
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("Configured rings: RX %zu, TX %zu descriptors, pool %zu buffers\n", RX_DESC_COUNT, TX_DESC_COUNT, PBUF_COUNT);
+    std::printf("A burst of N maximum frames at 100 Mbit/s spans N * %.0f us of application latency\n\n", FRAME_TIME_US);
+
+    std::printf("%-8s %10s %10s %10s %10s\n", "burst", "depth 4", "depth 8", "depth 16", "depth 32");
+    for (const size_t burst : {2U, 4U, 6U, 8U, 12U, 16U})
+    {
+        std::printf("%-8zu %9.1f%% %9.1f%% %9.1f%% %9.1f%%\n", burst,
+                    DropRate<4>(burst), DropRate<8>(burst), DropRate<16>(burst), DropRate<32>(burst));
+    }
+
+    // alternating runs, the best of each path is the one least disturbed by the host
+    double zeroCopy = ReceiveCost(false);
+    double copying = ReceiveCost(true);
+    for (uint32_t run = 1U; run < RECEIVE_RUNS; run++)
+    {
+        zeroCopy = std::min(zeroCopy, ReceiveCost(false));
+        copying = std::min(copying, ReceiveCost(true));
+    }
+    std::printf("\nreceive path per %zu byte frame: zero-copy %.0f ns, copy %.0f ns\n", FRAME_SIZE, zeroCopy, copying);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ ********************************************************************************
+ * @file        BenchFilter.cpp
+ *
+ * @brief       Benchmark of the filter bank on the host: throughput of the software FMAC model per kernel
+ *              set for 8 channels of ADC blocks, FIR with 16 to 64 taps and a biquad.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FilterBank.hpp"
+#include "FilterEngineSoft.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief Channels and samples per block (one ADC buffer half).
+constexpr uint8_t CHANNELS{8U};
+constexpr uint16_t BLOCK{256U};
+
+/// @brief Blocks per channel and measurement.
+constexpr uint32_t ROUNDS{400U};
+
+/// @brief The acquisition rate per channel in samples per second.
+constexpr double RATE{100e3};
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Megasamples per second of the bank, all channels use the filter.
+double Measure(FilterEngineSoft::Kernel kernel, const FilterConfig& config)
+{
+    FilterEngineSoft engine(kernel);
+    FilterBank bank(engine);
+    std::vector<int16_t> input(static_cast<size_t>(CHANNELS) * BLOCK);
+    std::vector<int16_t> output(input.size());
+    std::vector<FilterBlock> blocks(CHANNELS);
+    for (size_t i = 0U; i < input.size(); i++)
+    {
+        input[i] = static_cast<int16_t>((i * 2654435761U) >> 16U);
+    }
+    for (uint8_t ch = 0U; ch < CHANNELS; ch++)
+    {
+        (void)bank.Configure(ch, config);
+        blocks[ch] = FilterBlock{ch, &input[ch * BLOCK], &output[ch * BLOCK], BLOCK};
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0U; n < ROUNDS; n++)
+    {
+        for (FilterBlock& block : blocks)
+        {
+            (void)bank.Submit(block);
+        }
+    }
+    return static_cast<double>(CHANNELS) * BLOCK * ROUNDS / Since(start) / 1e6;
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%u channels, %u samples per block, load for %.0f kHz per channel\n\n", CHANNELS, BLOCK,
+                RATE / 1e3);
+
+    const char* pKernels[] = {"scalar", "avx2"};
+    std::vector<int16_t> b(MAX_TAPS_B);
+    for (size_t i = 0U; i < b.size(); i++)
+    {
+        b[i] = static_cast<int16_t>(600 - static_cast<int32_t>(i * 9U));
+    }
+    const std::vector<int16_t> b2{0x0800, 0x1000, 0x0800};
+    const std::vector<int16_t> a2{0x5000, -0x2000};
+    const FilterConfig configs[] = {
+        {FilterType::FIR, b.data(), 16U},
+        {FilterType::FIR, b.data(), 32U},
+        {FilterType::FIR, b.data(), 64U},
+        {FilterType::IIR, b2.data(), 3U, a2.data(), 2U, 1U}};
+    const char* pNames[] = {"fir16", "fir32", "fir64", "biquad"};
+
+    std::printf("%-8s %-8s %12s %10s\n", "kernel", "filter", "MS/s", "load %");
+    for (uint32_t k = 0U; k <= static_cast<uint32_t>(FilterEngineSoft::GetBestKernel()); k++)
+    {
+        for (uint32_t f = 0U; f < 4U; f++)
+        {
+            const double msps = Measure(static_cast<FilterEngineSoft::Kernel>(k), configs[f]);
+            std::printf("%-8s %-8s %12.1f %10.2f\n", pKernels[k], pNames[f], msps,
+                        100.0 * CHANNELS * RATE / (msps * 1e6));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ ********************************************************************************
+ * @file        BenchGfx.cpp
+ *
+ * @brief       Benchmark of the 2D graphics on the host: fill, blit with pixel format conversion and blend
+ *              throughput of the software engine per kernel set for a 800x480 display frame.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "Gfx2D.hpp"
+#include "GfxEngineSoft.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Video;
+
+namespace {
+
+/// @brief Display frame size (WVGA).
+constexpr uint16_t WIDTH{800U};
+constexpr uint16_t HEIGHT{480U};
+
+/// @brief Frames per measurement.
+constexpr uint32_t FRAMES{50U};
+
+/// @brief A frame with its pixel storage.
+struct Image
+{
+    std::vector<uint8_t> data;
+    Frame frame;
+
+    explicit Image(PixelFormat format)
+    : data(static_cast<size_t>(WIDTH) * HEIGHT * BytesPerPixel(format))
+    , frame{data.data(), WIDTH, HEIGHT, WIDTH * BytesPerPixel(format), format}
+    {
+        for (size_t i = 0U; i < data.size(); i++)
+        {
+            data[i] = static_cast<uint8_t>((i * 7U) ^ (i >> 9U));
+        }
+    }
+};
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Megapixels per second of a drawing operation, one full frame per call.
+template<typename Draw>
+double Measure(Gfx2D& gfx, Draw draw)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0U; n < FRAMES; n++)
+    {
+        (void)draw();
+        (void)gfx.Flush();
+    }
+    return static_cast<double>(WIDTH) * HEIGHT * FRAMES / Since(start) / 1e6;
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%ux%u frames, %u per measurement\n\n", WIDTH, HEIGHT, FRAMES);
+
+    const char* pKernels[] = {"scalar", "sse4.1", "avx2"};
+    const char* pFormats[] = {"ARGB8888", "RGB888", "RGB565", "L8"};
+    const Rect all{0U, 0U, WIDTH, HEIGHT};
+    Image screen(PixelFormat::RGB565);
+
+    std::printf("%-8s %-10s %14s %14s %14s\n", "kernel", "format", "blit Mpx/s", "blend Mpx/s", "fill Mpx/s");
+    for (uint32_t k = 0U; k <= static_cast<uint32_t>(GfxEngineSoft::GetBestKernel()); k++)
+    {
+        GfxEngineSoft engine(static_cast<GfxEngineSoft::Kernel>(k));
+        Gfx2D gfx(engine);
+        for (uint32_t f = 0U; f < 4U; f++)
+        {
+            // the format as source into the RGB565 screen and as fill target, L8 is no target
+            Image source(static_cast<PixelFormat>(f));
+            const double blitMps = Measure(gfx, [&]() {return gfx.Blit(source.frame, all, screen.frame, 0U, 0U);});
+            const double blendMps = Measure(gfx, [&]() {return gfx.Blend(source.frame, all, screen.frame, 0U, 0U,
+                                                                         160U);});
+            std::printf("%-8s %-10s %14.1f %14.1f", pKernels[k], pFormats[f], blitMps, blendMps);
+            if (source.frame.format == PixelFormat::L8)
+            {
+                std::printf(" %14s\n", "-");
+            }
+            else
+            {
+                std::printf(" %14.1f\n", Measure(gfx, [&]() {return gfx.Fill(source.frame, all, 0x80FF8000U);}));
+            }
+        }
+    }
+    return 0;
+}
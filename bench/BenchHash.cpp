@@ -0,0 +1,75 @@
+/**
+ ********************************************************************************
+ * @file        BenchHash.cpp
+ *
+ * @brief       Throughput benchmark of the hash service with the software engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "HashService.hpp"
+#include "HashEngineSoft.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Crypto;
+
+namespace {
+
+/// @brief Total payload per measurement.
+constexpr size_t TOTAL_BYTES{64U * 1024U * 1024U};
+
+double Run(HashService& service, HashAlgorithm algo, size_t messageSize)
+{
+    const std::array<uint8_t, 32> key{};
+    std::vector<uint8_t> buffer(messageSize, 0xA5U);
+    std::array<uint8_t, 32> digest{};
+
+    HashStream stream{};
+    if (algo == HashAlgorithm::HMAC_SHA256)
+    {
+        (void)service.OpenHmac(stream, key.data(), key.size());
+    }
+    else
+    {
+        (void)service.Open(stream);
+    }
+
+    HashRequest request{};
+    request.pData = buffer.data();
+    request.length = static_cast<uint32_t>(messageSize);
+    request.final = true;
+    request.pDigest = digest.data();
+
+    const size_t messages = TOTAL_BYTES / messageSize;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0U; i < messages; i++)
+    {
+        buffer[0] = static_cast<uint8_t>(i);
+        (void)service.Submit(stream, request);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+    return (static_cast<double>(messages * messageSize) / (1024.0 * 1024.0)) / seconds;
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    HashEngineSoft engine;
+    HashService service(engine);
+
+    std::printf("SHA-256 engine: %s\n", engine.IsAccelerated() ? "SHA-NI" : "portable software");
+    std::printf("%-12s %10s %12s\n", "mode", "message", "MiB/s");
+    for (const size_t size : {64U, 256U, 1500U, 16384U})
+    {
+        std::printf("%-12s %10zu %12.1f\n", "SHA-256", size, Run(service, HashAlgorithm::SHA256, size));
+        std::printf("%-12s %10zu %12.1f\n", "HMAC-SHA256", size, Run(service, HashAlgorithm::HMAC_SHA256, size));
+    }
+    return 0;
+}
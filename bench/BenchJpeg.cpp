@@ -0,0 +1,154 @@
+/**
+ ********************************************************************************
+ * @file        BenchJpeg.cpp
+ *
+ * @brief       Benchmark of the JPEG pipeline on the host: MCU color conversion throughput per pixel format
+ *              and subsampling, and encode/decode frame rates of the software codec through the service
+ *              for a VGA camera frame.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "JpegCodecSoft.hpp"
+#include "JpegColor.hpp"
+#include "JpegService.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace Video;
+
+namespace {
+
+/// @brief Camera frame size (VGA).
+constexpr uint16_t WIDTH{640U};
+constexpr uint16_t HEIGHT{480U};
+
+/// @brief Frames per measurement.
+constexpr uint32_t FRAMES{20U};
+
+/// @brief A gradient with texture, about the entropy of a camera image.
+void Paint(const Frame& frame)
+{
+    for (uint32_t y = 0U; y < frame.height; y++)
+    {
+        for (uint32_t x = 0U; x < frame.width; x++)
+        {
+            uint8_t* p = &frame.pData[(y * frame.stride) + (x * BytesPerPixel(frame.format))];
+            const uint32_t value = (x + (2U * y) + (((x ^ y) & 8U) * 4U)) & 0xFFU;
+            for (uint32_t i = 0U; i < BytesPerPixel(frame.format); i++)
+            {
+                p[i] = static_cast<uint8_t>(value + (i * 50U));
+            }
+        }
+    }
+}
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Megapixels per second of ToMcus and FromMcus.
+void Convert(PixelFormat format, Subsampling subsampling, double& toMps, double& fromMps)
+{
+    std::vector<uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT * BytesPerPixel(format));
+    const Frame frame{pixels.data(), WIDTH, HEIGHT, WIDTH * BytesPerPixel(format), format};
+    Paint(frame);
+    const JpegInfo info{WIDTH, HEIGHT, subsampling, 90U};
+    std::vector<uint8_t> mcus(info.McuCount() * info.McuSize());
+    const double pixelCount = static_cast<double>(WIDTH) * HEIGHT * FRAMES;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0U; n < FRAMES; n++)
+    {
+        JpegColor::ToMcus(frame, subsampling, 0U, info.McuCount(), mcus.data());
+    }
+    toMps = pixelCount / Since(start) / 1e6;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0U; n < FRAMES; n++)
+    {
+        JpegColor::FromMcus(mcus.data(), info, 0U, info.McuCount(), frame);
+    }
+    fromMps = pixelCount / Since(start) / 1e6;
+}
+
+/// @brief Run the service and the codec until all jobs are done.
+void Process(JpegService& service, JpegCodecSoft& codec)
+{
+    while (service.Service())
+    {
+        codec.Poll();
+    }
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%ux%u frames, %u per measurement\n\n", WIDTH, HEIGHT, FRAMES);
+
+    const char* pFormats[] = {"ARGB8888", "RGB888", "RGB565"};
+    const char* pLayouts[] = {"gray", "4:4:4", "4:2:2", "4:2:0"};
+    std::printf("%-10s %-8s %16s %16s\n", "format", "layout", "to MCU Mpx/s", "from MCU Mpx/s");
+    for (uint32_t f = 0U; f < 3U; f++)
+    {
+        for (uint32_t s = 1U; s < 4U; s++)
+        {
+            double toMps = 0.0;
+            double fromMps = 0.0;
+            Convert(static_cast<PixelFormat>(f), static_cast<Subsampling>(s), toMps, fromMps);
+            std::printf("%-10s %-8s %16.1f %16.1f\n", pFormats[f], pLayouts[s], toMps, fromMps);
+        }
+    }
+
+    // RGB565 camera frames through the service, 4:2:0 quality 80
+    std::vector<uint8_t> pixels(static_cast<size_t>(WIDTH) * HEIGHT * 2U);
+    const Frame frame{pixels.data(), WIDTH, HEIGHT, WIDTH * 2U, PixelFormat::RGB565};
+    Paint(frame);
+    std::vector<uint8_t> stream(512U * 1024U);
+    auto codec = std::make_unique<JpegCodecSoft>();
+    auto service = std::make_unique<JpegService>(*codec);
+
+    std::printf("\n%-8s %12s %12s %12s %12s\n", "layout", "bytes", "encode fps", "decode fps", "stalls");
+    for (uint32_t s = 1U; s < 4U; s++)
+    {
+        std::vector<JpegJob> jobs(FRAMES);
+        auto start = std::chrono::steady_clock::now();
+        for (JpegJob& job : jobs)
+        {
+            job.operation = JpegOperation::ENCODE;
+            job.frame = frame;
+            job.subsampling = static_cast<Subsampling>(s);
+            job.quality = 80U;
+            job.pStream = stream.data();
+            job.streamSize = static_cast<uint32_t>(stream.size());
+            (void)service->Submit(job);
+        }
+        Process(*service, *codec);
+        const double encodeFps = FRAMES / Since(start);
+        const uint32_t length = jobs.back().streamLength;
+
+        start = std::chrono::steady_clock::now();
+        for (JpegJob& job : jobs)
+        {
+            job = JpegJob{};
+            job.operation = JpegOperation::DECODE;
+            job.frame = frame;
+            job.pStream = stream.data();
+            job.streamSize = length;
+            (void)service->Submit(job);
+        }
+        Process(*service, *codec);
+        const double decodeFps = FRAMES / Since(start);
+        std::printf("%-8s %12u %12.1f %12.1f %12u\n", pLayouts[s], length, encodeFps, decodeFps,
+                    service->GetInputStalls() + service->GetOutputStalls());
+    }
+    return 0;
+}
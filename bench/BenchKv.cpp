@@ -0,0 +1,115 @@
+/**
+ ********************************************************************************
+ * @file        BenchKv.cpp
+ *
+ * @brief       Benchmark of the key/value store on the internal flash emulator: boot time index rebuild
+ *              per count of keys and records, flash words and sector erases per update against the
+ *              rewrite of a whole 128 KB sector per configuration write.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FlashBankSim.hpp"
+#include "KvStore.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using namespace Flash;
+
+namespace {
+
+/// @brief Mounts per measurement.
+constexpr uint32_t MOUNTS{50U};
+
+/// @brief Updates of the wear measurement.
+constexpr uint32_t UPDATES{100000U};
+
+/// @brief Bytes of a configuration value.
+constexpr size_t VALUE_SIZE{24U};
+
+/// @brief Key of an index.
+std::string KeyOf(uint32_t index)
+{
+    return "cfg." + std::to_string(index);
+}
+
+/**
+ * @brief   Fill the active sector with updates of the keys up to the compaction threshold, then mount.
+ * @return  Microseconds per mount, records scanned in records.
+ */
+double MountCost(uint32_t keys, uint32_t& records)
+{
+    auto bank = std::make_unique<FlashBankSim>();
+    KvStore::Config config{};
+    config.compactThreshold = 0U;
+    {
+        auto store = std::make_unique<KvStore>(*bank, config);
+        (void)store->Mount();
+        std::array<uint8_t, VALUE_SIZE> value{};
+        for (uint32_t i = 0U; store->GetFree() > KvStore::RECORD_ALIGN * 4U; i++)
+        {
+            value[0] = static_cast<uint8_t>(i);
+            (void)store->Set(KeyOf(i % keys).c_str(), value.data(), value.size());
+        }
+    }
+
+    auto store = std::make_unique<KvStore>(*bank, config);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i < MOUNTS; i++)
+    {
+        (void)store->Mount();
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    records = store->GetScanned();
+    return us / MOUNTS;
+}
+
+/**
+ * @brief   Updates of the keys with background compaction.
+ * @return  Updates per sector erase, flash words per update in words.
+ */
+double UpdatesPerErase(uint32_t keys, double& words)
+{
+    auto bank = std::make_unique<FlashBankSim>();
+    auto store = std::make_unique<KvStore>(*bank);
+    (void)store->Mount();
+    std::array<uint8_t, VALUE_SIZE> value{};
+    for (uint32_t i = 0U; i < UPDATES; i++)
+    {
+        value[0] = static_cast<uint8_t>(i);
+        (void)store->Set(KeyOf(i % keys).c_str(), value.data(), value.size());
+        (void)store->Service();
+    }
+    words = static_cast<double>(bank->GetPrograms()) / UPDATES;
+    return static_cast<double>(UPDATES) / static_cast<double>(bank->GetErases());
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("two 128 KB sectors, %zu byte values, full active sector at boot\n\n", VALUE_SIZE);
+
+    std::printf("%-8s %10s %14s %14s\n", "keys", "records", "us/mount", "ns/record");
+    for (const uint32_t keys : {16U, 64U, 256U})
+    {
+        uint32_t records = 0U;
+        const double us = MountCost(keys, records);
+        std::printf("%-8u %10u %14.1f %14.1f\n", keys, records, us, (us * 1000.0) / records);
+    }
+
+    std::printf("\n%-8s %16s %16s %24s\n", "keys", "updates/erase", "words/update", "sector rewrite words");
+    for (const uint32_t keys : {16U, 64U, 256U})
+    {
+        double words = 0.0;
+        const double updates = UpdatesPerErase(keys, words);
+        // a rewrite of the configuration sector erases it and programs all 4096 flash words per update
+        std::printf("%-8u %16.1f %16.2f %24u\n", keys, updates, words, 128U * 1024U / 32U);
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ ********************************************************************************
+ * @file        BenchLog.cpp
+ *
+ * @brief       Benchmark of the recording files on the file backed card: modeled card throughput and host
+ *              cost per chunk size for a stream of 64 byte sensor records, and the modeled recovery time
+ *              after a power loss per checkpoint interval.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "BlockDeviceFile.hpp"
+#include "LogReader.hpp"
+#include "LogWriter.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+using namespace Storage;
+
+namespace {
+
+/// @brief Bytes of a sensor record.
+constexpr uint16_t RECORD_SIZE{64U};
+
+/// @brief Recorded bytes (16 MB).
+constexpr uint32_t RECORD_BYTES{16U * 1024U * 1024U};
+
+/// @brief Data blocks of the file.
+constexpr uint32_t FILE_BLOCKS{40000U};
+
+/// @brief Result of a recording.
+struct Result
+{
+    double cardMBs;         //!< Modeled card throughput of the record data
+    double hostMBs;         //!< Host throughput of the whole path
+    double maxAppendUs;     //!< Longest Append and Service call
+    uint32_t dropped;       //!< Records without free buffer
+};
+
+/// @brief Record 16 MB with a chunk size, the card completes each transfer at the next service call.
+Result Record(const char* pPath, uint32_t chunkBlocks)
+{
+    BlockDeviceFile card;
+    (void)card.Open(pPath);
+    auto writer = std::make_unique<LogWriter>(card, LogWriter::Config{chunkBlocks, 8192U, 32U});
+    (void)writer->Format();
+    (void)writer->Create("imu", FILE_BLOCKS);
+    (void)writer->Open("imu", false);
+    const uint64_t busy = card.GetBusyUs();
+    std::array<uint8_t, RECORD_SIZE> data{};
+    double maxUs = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0U; n < (RECORD_BYTES / RECORD_SIZE); n++)
+    {
+        data[0] = static_cast<uint8_t>(n);
+        const auto before = std::chrono::steady_clock::now();
+        (void)writer->Append(1U, n, data.data(), RECORD_SIZE);
+        (void)writer->Service();
+        const auto after = std::chrono::steady_clock::now();
+        maxUs = std::max(maxUs, std::chrono::duration<double, std::micro>(after - before).count());
+        card.Poll();
+    }
+    (void)writer->Close();
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    const double bytes = static_cast<double>(writer->GetRecords()) * RECORD_SIZE;
+    return Result{bytes / static_cast<double>(card.GetBusyUs() - busy), bytes / us, maxUs, writer->GetDropped()};
+}
+
+/**
+ * @brief   Cut the power after 8 MB and measure the recovery by Open.
+ * @return  Modeled card milliseconds of the recovery, recovered chunks in chunks.
+ */
+double Recovery(const char* pPath, uint32_t checkpointChunks, uint32_t& chunks)
+{
+    BlockDeviceFile card;
+    (void)card.Open(pPath);
+    std::array<uint8_t, RECORD_SIZE> data{};
+    {
+        auto writer = std::make_unique<LogWriter>(card, LogWriter::Config{64U, 8192U, checkpointChunks});
+        (void)writer->Format();
+        (void)writer->Create("imu", FILE_BLOCKS);
+        (void)writer->Open("imu", false);
+        // the recording stops without Close just before the next checkpoint
+        for (uint32_t n = 0U; (n < ((RECORD_BYTES / 2U) / RECORD_SIZE)) || (writer->GetChunks() % checkpointChunks) !=
+             (checkpointChunks - 1U); n++)
+        {
+            (void)writer->Append(1U, n, data.data(), RECORD_SIZE);
+            (void)writer->Service();
+            card.Poll();
+        }
+    }
+    auto writer = std::make_unique<LogWriter>(card);
+    (void)writer->Mount();
+    const uint64_t busy = card.GetBusyUs();
+    (void)writer->Open("imu", false);
+    chunks = writer->GetRecoveredChunks();
+    return static_cast<double>(card.GetBusyUs() - busy) / 1000.0;
+}
+
+} // end anonymous namespace
+
+
+int main(int argc, char* argv[])
+{
+    const char* pPath = (argc > 1) ? argv[1] : "benchLog.img";
+    std::printf("%u MB of %u byte records, checkpoint per 32 chunks, extents aligned to 4 MB\n\n",
+                RECORD_BYTES / (1024U * 1024U), RECORD_SIZE);
+
+    std::printf("%-14s %12s %12s %16s %10s\n", "chunk", "card MB/s", "host MB/s", "max append us", "dropped");
+    for (const uint32_t chunkBlocks : {8U, 16U, 32U, 64U})
+    {
+        const Result result = Record(pPath, chunkBlocks);
+        std::printf("%2u blocks      %12.2f %12.1f %16.1f %10u\n", chunkBlocks, result.cardMBs, result.hostMBs,
+                    result.maxAppendUs, result.dropped);
+    }
+
+    // the image holds the last recording, read it back in place
+    LogReader reader;
+    if ((reader.Open(pPath) == Status::OK) && (reader.OpenFile("imu") == Status::OK))
+    {
+        LogRecord record{};
+        uint64_t bytes = 0U;
+        const auto start = std::chrono::steady_clock::now();
+        while (reader.Next(record))
+        {
+            bytes += record.length;
+        }
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::printf("\nhost reader        %.1f MB/s over %llu records\n", static_cast<double>(bytes) / us,
+                    static_cast<unsigned long long>(reader.GetRecords()));
+    }
+    reader.Close();
+
+    std::printf("\n%-20s %18s %18s\n", "checkpoint chunks", "recovered chunks", "recovery ms");
+    for (const uint32_t checkpointChunks : {8U, 32U, 128U})
+    {
+        uint32_t chunks = 0U;
+        const double ms = Recovery(pPath, checkpointChunks, chunks);
+        std::printf("%-20u %18u %18.1f\n", checkpointChunks, chunks, ms);
+    }
+    (void)std::remove(pPath);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ ********************************************************************************
+ * @file        BenchMath.cpp
+ *
+ * @brief       Benchmark of the fast math functions on the host: sine/cosine, atan2 and magnitude per kernel
+ *              set compared with libm.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FastMath.hpp"
+#include "MathEngineSoft.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief Values per span, a FFT frame.
+constexpr uint32_t COUNT{4096U};
+
+/// @brief Spans per measurement.
+constexpr uint32_t ROUNDS{500U};
+
+/// @brief Seconds since a start point.
+double Since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Million calculations per second of a span operation.
+template<typename Run>
+double Measure(Run run)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0U; n < ROUNDS; n++)
+    {
+        run();
+    }
+    return static_cast<double>(COUNT) * ROUNDS / Since(start) / 1e6;
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("%u values per span, %u spans per measurement\n\n", COUNT, ROUNDS);
+
+    std::vector<int32_t> a(COUNT);
+    std::vector<int32_t> b(COUNT);
+    std::vector<Complex> z(COUNT);
+    std::vector<int32_t> out0(COUNT);
+    std::vector<int32_t> out1(COUNT);
+    for (uint32_t i = 0U; i < COUNT; i++)
+    {
+        a[i] = static_cast<int32_t>(i * 2654435761U);
+        b[i] = static_cast<int32_t>(i * 40503U * 65537U);
+        z[i] = {a[i] / 2, b[i] / 2};
+    }
+
+    std::printf("%-8s %14s %14s %14s\n", "kernel", "sincos M/s", "atan2 M/s", "magnitude M/s");
+    const char* pKernels[] = {"scalar", "avx2"};
+    for (uint32_t k = 0U; k <= static_cast<uint32_t>(MathEngineSoft::GetBestKernel()); k++)
+    {
+        MathEngineSoft engine(static_cast<MathEngineSoft::Kernel>(k));
+        FastMath math(engine);
+        const double sincos = Measure([&]() {(void)math.SinCos(a, out0, out1);});
+        const double atan2 = Measure([&]() {(void)math.Atan2(a, b, out0);});
+        const double magnitude = Measure([&]() {(void)math.Magnitude(z, out0);});
+        std::printf("%-8s %14.1f %14.1f %14.1f\n", pKernels[k], sincos, atan2, magnitude);
+    }
+
+    // the same in double precision with libm
+    constexpr double SCALE{2147483648.0};
+    constexpr double PI{3.14159265358979323846};
+    const double sincos = Measure([&]() {
+        for (uint32_t i = 0U; i < COUNT; i++)
+        {
+            const double angle = a[i] * (PI / SCALE);
+            out0[i] = static_cast<int32_t>(std::sin(angle) * (SCALE - 1.0));
+            out1[i] = static_cast<int32_t>(std::cos(angle) * (SCALE - 1.0));
+        }
+    });
+    const double atan2 = Measure([&]() {
+        for (uint32_t i = 0U; i < COUNT; i++)
+        {
+            out0[i] = static_cast<int32_t>(std::atan2(static_cast<double>(a[i]), b[i]) * ((SCALE - 1.0) / PI));
+        }
+    });
+    const double magnitude = Measure([&]() {
+        for (uint32_t i = 0U; i < COUNT; i++)
+        {
+            out0[i] = static_cast<int32_t>(std::hypot(static_cast<double>(z[i].re), z[i].im));
+        }
+    });
+    std::printf("%-8s %14.1f %14.1f %14.1f\n", "libm", sincos, atan2, magnitude);
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ ********************************************************************************
+ * @file        BenchStorage.cpp
+ *
+ * @brief       Benchmark of the block cache on the file backed card: modeled card throughput of a
+ *              continuous recording written block by block without cache against merged write-backs,
+ *              and of a stream read with and without read-ahead. The CPU time of the cache is
+ *              measured on the host.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "BlockCache.hpp"
+#include "BlockDeviceFile.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace Storage;
+
+namespace {
+
+/// @brief Blocks of a recording (8 MB).
+constexpr uint32_t RECORD_BLOCKS{16384U};
+
+/// @brief Result of one run.
+struct Result
+{
+    double cardMBs;         //!< Modeled card throughput
+    double cpuMBs;          //!< Host throughput of the whole path
+    uint32_t commands;      //!< Card commands
+};
+
+/// @brief Run cache and card until both are idle.
+void RunAll(BlockCache& cache, BlockDeviceFile& card)
+{
+    while (cache.Service())
+    {
+        (void)card.RunToIdle();
+    }
+}
+
+/// @brief Throughputs of a run over bytes.
+Result ResultOf(const BlockDeviceFile& card, double us, uint32_t commands)
+{
+    const double bytes = static_cast<double>(RECORD_BLOCKS) * BLOCK_SIZE;
+    return Result{bytes / static_cast<double>(card.GetBusyUs()), bytes / us, commands};
+}
+
+/// @brief Record with a blocking single block write per block.
+Result RecordDirect(const char* pPath)
+{
+    BlockDeviceFile card;
+    (void)card.Open(pPath);
+    std::vector<uint8_t> block(BLOCK_SIZE, 0xA5U);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i < RECORD_BLOCKS; i++)
+    {
+        (void)card.StartWrite(i, block.data(), 1U);
+        (void)card.RunToIdle();
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return ResultOf(card, us, card.GetWrites());
+}
+
+/// @brief Record through the cache with requests of chunk blocks.
+Result RecordCached(const char* pPath, uint32_t chunk, uint32_t maxTransfer)
+{
+    BlockDeviceFile card;
+    (void)card.Open(pPath);
+    auto cache = std::make_unique<BlockCache>(card, BlockCache::Config{maxTransfer, 16U, maxTransfer / 2U});
+    std::vector<uint8_t> data(static_cast<size_t>(chunk) * BLOCK_SIZE, 0x5AU);
+    BlockRequest request{};
+    request.operation = BlockOperation::WRITE;
+    request.count = chunk;
+    request.pData = data.data();
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i < RECORD_BLOCKS; i += chunk)
+    {
+        request.block = i;
+        (void)cache->Submit(request);
+        RunAll(*cache, card);
+    }
+    request.operation = BlockOperation::FLUSH;
+    (void)cache->Submit(request);
+    RunAll(*cache, card);
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return ResultOf(card, us, card.GetWrites());
+}
+
+/// @brief Read the recording back block by block through the cache.
+Result ReadStream(const char* pPath, uint32_t readAhead)
+{
+    BlockDeviceFile card;
+    (void)card.Open(pPath);
+    auto cache = std::make_unique<BlockCache>(card, BlockCache::Config{BlockCache::MAX_TRANSFER_BLOCKS, readAhead, 32U});
+    std::vector<uint8_t> block(BLOCK_SIZE);
+    BlockRequest request{};
+    request.operation = BlockOperation::READ;
+    request.count = 1U;
+    request.pData = block.data();
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0U; i < RECORD_BLOCKS; i++)
+    {
+        request.block = i;
+        (void)cache->Submit(request);
+        RunAll(*cache, card);
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return ResultOf(card, us, card.GetReads());
+}
+
+/// @brief Print a result line.
+void Print(const char* pName, const Result& result)
+{
+    std::printf("%-34s %10u %14.2f %14.1f\n", pName, result.commands, result.cardMBs, result.cpuMBs);
+}
+
+} // end anonymous namespace
+
+
+int main(int argc, char* argv[])
+{
+    const char* pPath = (argc > 1) ? argv[1] : "benchStorage.img";
+    const BlockDeviceFile::Config card{};
+    std::printf("%u blocks recorded, card model: read command %u us, write command %u us, %u us per block\n\n",
+                RECORD_BLOCKS, card.readCommandUs, card.writeCommandUs, card.blockUs);
+
+    std::printf("%-34s %10s %14s %14s\n", "write", "commands", "card MB/s", "host MB/s");
+    Print("single block, no cache", RecordDirect(pPath));
+    Print("1 block requests, 8 block runs", RecordCached(pPath, 1U, 8U));
+    Print("1 block requests, 64 block runs", RecordCached(pPath, 1U, 64U));
+    Print("8 block requests, 64 block runs", RecordCached(pPath, 8U, 64U));
+
+    std::printf("\n%-34s %10s %14s %14s\n", "read", "commands", "card MB/s", "host MB/s");
+    Print("1 block requests, no read-ahead", ReadStream(pPath, 0U));
+    Print("1 block requests, 16 read-ahead", ReadStream(pPath, 16U));
+    Print("1 block requests, 63 read-ahead", ReadStream(pPath, 63U));
+    (void)std::remove(pPath);
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ ********************************************************************************
+ * @file        BenchUdp.cpp
+ *
+ * @brief       Benchmark of the UDP send path on the descriptor ring simulation: software checksum,
+ *              checksum offload and batched transmit per payload size.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "EthDeviceSim.hpp"
+#include "UdpStack.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+using namespace Net;
+
+namespace {
+
+/// @brief Datagrams per measurement.
+constexpr size_t DATAGRAM_COUNT{400000U};
+
+/// @brief Datagrams handed over per SendBatch.
+constexpr size_t BATCH{TX_DESC_COUNT};
+
+const MacAddress MAC{0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x01U};
+
+std::unique_ptr<PacketPoolStorage<PBUF_COUNT>> sStorage{std::make_unique<PacketPoolStorage<PBUF_COUNT>>()};
+
+/// @brief Reports checksum offload to the stack but skips the emulation, the MAC does it for free.
+class OffloadDevice : public EthDeviceSim<>
+{
+    public:
+        using EthDeviceSim<>::EthDeviceSim;
+        void SetChecksumOffload(bool enable) override {mOffload = enable;};
+        bool IsChecksumOffload() const override {return mOffload;};
+
+    private:
+        bool mOffload{false};
+};
+
+/// @return Nanoseconds per datagram.
+double SendCost(size_t payload, bool offload, bool batch)
+{
+    PacketPool pool(sStorage->buffers.data(), PBUF_COUNT);
+    OffloadDevice device(pool);
+    device.Start();
+    device.SetChecksumOffload(offload);
+    UdpStack stack(device, pool, MAC, Utils::IpAddressV4("192.168.1.10"), Utils::IpAddressV4("255.255.255.0"),
+                   Utils::IpAddressV4("192.168.1.1"));
+    UdpFlow flow;
+    (void)stack.OpenFlow(flow, Utils::IpAddressV4("255.255.255.255"), 5000U, 5001U);
+
+    PacketBuffer* datagrams[BATCH];
+    for (PacketBuffer*& pDatagram : datagrams)
+    {
+        pDatagram = stack.AllocDatagram();
+        for (size_t i = 0U; i < payload; i++)
+        {
+            pDatagram->pPayload[i] = static_cast<uint8_t>(i);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t sent = 0U; sent < DATAGRAM_COUNT; sent += BATCH)
+    {
+        for (PacketBuffer* pDatagram : datagrams)
+        {
+            pDatagram->pPayload = &pDatagram->data[UdpStack::HEADROOM];
+            pDatagram->length = static_cast<uint16_t>(payload);
+            pDatagram->totalLength = pDatagram->length;
+        }
+        if (batch)
+        {
+            (void)stack.SendBatch(flow, datagrams, BATCH);
+        }
+        else
+        {
+            for (PacketBuffer* pDatagram : datagrams)
+            {
+                (void)stack.Send(flow, *pDatagram);
+            }
+        }
+        (void)device.TransmitPending(nullptr, nullptr);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    device.ReleaseTx();
+    for (PacketBuffer* pDatagram : datagrams)
+    {
+        (void)pool.Free(pDatagram);
+    }
+    return ns / static_cast<double>(DATAGRAM_COUNT);
+}
+
+} // end anonymous namespace
+
+
+int main()
+{
+    std::printf("UDP send path on the ring simulation, ns per datagram\n\n");
+    std::printf("%-8s %12s %12s %12s %14s\n", "payload", "sw checksum", "offload", "batch", "offload MiB/s");
+    for (const size_t payload : {16U, 64U, 256U, 512U, 1024U, 1472U})
+    {
+        const double software = SendCost(payload, false, false);
+        const double offload = SendCost(payload, true, false);
+        const double batch = SendCost(payload, true, true);
+        std::printf("%-8zu %12.1f %12.1f %12.1f %14.0f\n", payload, software, offload, batch,
+                    (static_cast<double>(payload) * 1.0e9) / (batch * 1024.0 * 1024.0));
+    }
+    return 0;
+}
@@ -25,13 +25,38 @@ include_directories(
     ${CMAKE_SOURCE_DIR}/include
     ${CMAKE_SOURCE_DIR}/src
     ${CMAKE_SOURCE_DIR}/src/utils
+    ${CMAKE_SOURCE_DIR}/src/crypto
+    ${CMAKE_SOURCE_DIR}/src/net
+    ${CMAKE_SOURCE_DIR}/src/can
+    ${CMAKE_SOURCE_DIR}/src/spi
+    ${CMAKE_SOURCE_DIR}/src/flash
+    ${CMAKE_SOURCE_DIR}/src/storage
+    ${CMAKE_SOURCE_DIR}/src/video
+    ${CMAKE_SOURCE_DIR}/src/dsp
+    ${CMAKE_SOURCE_DIR}/src/adc
+    ${CMAKE_SOURCE_DIR}/src/audio
+    ${CMAKE_SOURCE_DIR}/src/dma
+    ${CMAKE_SOURCE_DIR}/src/dac
 )
 ################################################################################
 # Add the subdirectories which includes used libs with own CmakeLists.txt
 ################################################################################
 add_subdirectory(src/utils)
+add_subdirectory(src/crypto)
+add_subdirectory(src/net)
+add_subdirectory(src/can)
+add_subdirectory(src/spi)
+add_subdirectory(src/flash)
+add_subdirectory(src/storage)
+add_subdirectory(src/video)
+add_subdirectory(src/dsp)
+add_subdirectory(src/adc)
+add_subdirectory(src/audio)
+add_subdirectory(src/dma)
+add_subdirectory(src/dac)
 add_subdirectory(lib/googletest)
 add_subdirectory(tests) 
+add_subdirectory(bench)
 
 # add executable 
 add_executable(${EXECUTABLE} ${SOURCES})
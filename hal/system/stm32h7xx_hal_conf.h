@@ -217,8 +217,16 @@
 #define  USE_HAL_WWDG_REGISTER_CALLBACKS    0U /* WWDG register callback disabled    */
 
 /* ########################### Ethernet Configuration ######################### */
-#define ETH_TX_DESC_CNT         4  /* number of Ethernet Tx DMA descriptors */
-#define ETH_RX_DESC_CNT         4  /* number of Ethernet Rx DMA descriptors */
+/* the ring depths are normally set by CMake (ETH_RX_DESC_CNT / ETH_TX_DESC_CNT) */
+#if !defined(ETH_TX_DESC_CNT)
+#define ETH_TX_DESC_CNT         8  /* number of Ethernet Tx DMA descriptors */
+#endif
+#if !defined(ETH_RX_DESC_CNT)
+#define ETH_RX_DESC_CNT         16 /* number of Ethernet Rx DMA descriptors */
+#endif
+
+/* IEEE 1588 time stamping of the MAC (HAL_ETH_PTP_*, HAL_ETH_TxPtpCallback) */
+#define HAL_ETH_USE_PTP
 
 #define ETH_MAC_ADDR0    (0x02UL)
 #define ETH_MAC_ADDR1    (0x00UL)
@@ -0,0 +1,149 @@
+/**
+ ********************************************************************************
+ * @file        AcquisitionEngine.cpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, acquisition engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AcquisitionEngine.hpp"
+
+using namespace Adc;
+
+
+AcquisitionEngine::AcquisitionEngine(IAdcFrontEnd& frontEnd)
+: mFrontEnd(frontEnd)
+{
+    mFrontEnd.SetListener(this);
+}
+
+
+AcquisitionEngine::~AcquisitionEngine()
+{
+    Stop();
+    mFrontEnd.SetListener(nullptr);
+}
+
+
+Status AcquisitionEngine::Start(const AcquisitionConfig& config)
+{
+    if (IsRunning())
+    {
+        return Status::BUSY;
+    }
+    if (!config.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (!mCalibrated)
+    {
+        const Status status = mFrontEnd.Calibrate();
+        if (status != Status::OK)
+        {
+            return status;
+        }
+        mCalibrated = true;
+    }
+
+    // the interrupt is idle, the counters and the queue belong to this thread now
+    mConfig = config;
+    mQueue.Clear();
+    mProduced.store(0U, std::memory_order_relaxed);
+    mDropped.store(0U, std::memory_order_relaxed);
+    mOverruns.store(0U, std::memory_order_relaxed);
+    mOverwritten.store(0U, std::memory_order_relaxed);
+    mRunning.store(true, std::memory_order_release);
+    const Status status = mFrontEnd.Start(config.mode, config.sampleRate, config.pBuffer, config.BufferWords());
+    if (status != Status::OK)
+    {
+        mRunning.store(false, std::memory_order_release);
+    }
+    return status;
+}
+
+
+void AcquisitionEngine::Stop()
+{
+    if (IsRunning())
+    {
+        mFrontEnd.Stop();
+        mRunning.store(false, std::memory_order_release);
+    }
+}
+
+
+bool AcquisitionEngine::Receive(SampleBlock& block)
+{
+    while (mQueue.Pop(block))
+    {
+        if (!IsOverwritten(block.sequence))
+        {
+            return true;
+        }
+        mOverwritten.fetch_add(1U, std::memory_order_release);
+    }
+    return false;
+}
+
+
+bool AcquisitionEngine::Release(const SampleBlock& block)
+{
+    if (IsOverwritten(block.sequence))
+    {
+        mOverwritten.fetch_add(1U, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+
+void AcquisitionEngine::OnHalfFilled(uint8_t half)
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+    const uint32_t halfBlocks = mConfig.blocks / 2U;
+    uint32_t produced = mProduced.load(std::memory_order_relaxed);
+    // the slot of the next sequence is the filled half unless the event of the other half was missed
+    if (((produced % mConfig.blocks) / halfBlocks) != half)
+    {
+        mDropped.fetch_add(halfBlocks, std::memory_order_release);
+        produced += halfBlocks;
+    }
+    for (uint32_t i = 0U; i < halfBlocks; i++)
+    {
+        const uint32_t sequence = produced + i;
+        const uint32_t slot = sequence % mConfig.blocks;
+        const SampleBlock block{{&mConfig.pBuffer[slot * mConfig.blockWords], mConfig.blockWords}, sequence};
+        if (!mQueue.Push(block))
+        {
+            mDropped.fetch_add(1U, std::memory_order_release);
+        }
+    }
+    mProduced.store(produced + halfBlocks, std::memory_order_release);
+}
+
+
+void AcquisitionEngine::OnError(Status status)
+{
+    if (status == Status::OVERRUN)
+    {
+        mOverruns.fetch_add(1U, std::memory_order_release);
+        return;
+    }
+    mRunning.store(false, std::memory_order_release);
+}
+
+
+bool AcquisitionEngine::IsOverwritten(uint32_t sequence) const
+{
+    // the half of the block is refilled after the DMA has filled the other half
+    const uint32_t halfStart = sequence - (sequence % (mConfig.blocks / 2U));
+    return (mProduced.load(std::memory_order_acquire) - halfStart) >= mConfig.blocks;
+}
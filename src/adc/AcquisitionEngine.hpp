@@ -0,0 +1,135 @@
+/**
+ ********************************************************************************
+ * @file        AcquisitionEngine.hpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, synchronized dual ADC acquisition with zero-copy block delivery.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IAdcFrontEnd.hpp"
+#include "SpscQueue.hpp"
+#include <atomic>
+namespace Adc {
+
+
+/**
+ * @brief   This class provides the blocks of a continuous dual ADC acquisition to a processing thread.
+ * @details The front end fills the DMA buffer in a ring, every filled half queues its blocks (a span into
+ *          the buffer and a running sequence number) into a lock-free SPSC queue. The processing thread takes
+ *          them with @ref Receive without copy and hands them back with @ref Release.\n
+ *          A block stays valid until the DMA has filled the other half and starts to refill its own half.
+ *          @ref Receive skips blocks which are already overwritten, @ref Release tells whether the data was
+ *          still intact while the thread worked on it (up to the latency of the half interrupt). Both count
+ *          a loss, like blocks dropped on a full queue. Conversion overruns of the ADC are counted apart.\n
+ *          The converters are calibrated once before the first start.
+ * @note    @ref Start, @ref Stop, @ref Receive and @ref Release belong to the processing thread, the front
+ *          end events to the interrupt context.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe for one processing thread and the front end interrupt.
+ *
+ */
+class AcquisitionEngine : private IAdcFrontEnd::IListener
+{
+    public:
+
+        /**
+         * @brief   Constructs the engine on a front end.
+         *
+         * @param   frontEnd    The converters.
+         */
+        explicit AcquisitionEngine(IAdcFrontEnd& frontEnd);
+
+        /// @brief Destructor, stops the acquisition.
+        ~AcquisitionEngine();
+
+        AcquisitionEngine(AcquisitionEngine const &) = delete;             //!< Copy constructor
+        AcquisitionEngine& operator=(AcquisitionEngine const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Calibrate if not done yet and start the acquisition, the counters restart.
+         *
+         * @param   config  The configuration, the buffer must outlive the acquisition.
+         *
+         * @return  OK, BUSY, INVALID_PARAM or the error of the front end.
+         */
+        Status Start(const AcquisitionConfig& config);
+
+        /// @brief Stop the acquisition, queued blocks stay receivable until they are overwritten.
+        void Stop();
+
+        /**
+         * @brief   Take the oldest intact block.
+         *
+         * @param   block   Receives the block.
+         *
+         * @return  true if a block was taken.
+         */
+        bool Receive(SampleBlock& block);
+
+        /**
+         * @brief   Hand a block back.
+         *
+         * @param   block   The received block.
+         *
+         * @return  true if the DMA has not refilled the block while it was used.
+         */
+        bool Release(const SampleBlock& block);
+
+        /// @brief The acquisition runs.
+        bool IsRunning() const {return mRunning.load(std::memory_order_acquire);};
+
+        /// @brief Blocks filled by the DMA since the start.
+        uint32_t GetProducedBlocks() const {return mProduced.load(std::memory_order_acquire);};
+
+        /// @brief Blocks dropped, skipped or overwritten while used since the start.
+        uint32_t GetLostBlocks() const
+        {
+            return mDropped.load(std::memory_order_acquire) + mOverwritten.load(std::memory_order_acquire);
+        };
+
+        /// @brief Conversion overruns of the converters since the start.
+        uint32_t GetOverruns() const {return mOverruns.load(std::memory_order_acquire);};
+
+        /// @brief The converters are calibrated.
+        bool IsCalibrated() const {return mCalibrated;};
+
+    private:
+
+        /// @copydoc IAdcFrontEnd::IListener::OnHalfFilled
+        void OnHalfFilled(uint8_t half) override;
+
+        /// @copydoc IAdcFrontEnd::IListener::OnError
+        void OnError(Status status) override;
+
+        /// @brief The half of the block is refilled or already reused.
+        bool IsOverwritten(uint32_t sequence) const;
+
+        /// @brief The converters.
+        IAdcFrontEnd& mFrontEnd;
+
+        /// @brief The running configuration.
+        AcquisitionConfig mConfig{};
+
+        /// @brief Blocks from the interrupt to the processing thread.
+        Utils::SpscQueue<SampleBlock, MAX_BLOCKS> mQueue{};
+
+        /// @brief The converters are calibrated.
+        bool mCalibrated{false};
+
+        std::atomic<bool> mRunning{false};          //!< The acquisition runs
+        std::atomic<uint32_t> mProduced{0U};        //!< Filled blocks, written by the interrupt
+        std::atomic<uint32_t> mDropped{0U};         //!< Blocks not queued, written by the interrupt
+        std::atomic<uint32_t> mOverruns{0U};        //!< Overruns, written by the interrupt
+        std::atomic<uint32_t> mOverwritten{0U};     //!< Stale blocks, written by the processing thread
+};
+
+} // end namespace Adc
@@ -0,0 +1,265 @@
+/**
+ ********************************************************************************
+ * @file        AdcFrontEndHal.cpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, dual ADC front end implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AdcFrontEndHal.hpp"
+#include "DCache.hpp"
+
+using namespace Adc;
+
+AdcFrontEndHal* AdcFrontEndHal::spInstance = nullptr;
+
+namespace {
+
+/// @brief Counts of the 16 bit prescaler and auto reload registers.
+constexpr uint32_t TIMER_RANGE{65536U};
+
+} // end anonymous namespace
+
+
+AdcFrontEndHal::AdcFrontEndHal(ADC_HandleTypeDef& master, ADC_HandleTypeDef& slave, TIM_HandleTypeDef& trigger,
+                               uint32_t timerClock, uint32_t interleaveDelay)
+: mMaster(master), mSlave(slave), mTrigger(trigger), mTimerClock(timerClock), mInterleaveDelay(interleaveDelay)
+{
+    spInstance = this;
+}
+
+
+AdcFrontEndHal::~AdcFrontEndHal()
+{
+    Stop();
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+AdcFrontEndHal* AdcFrontEndHal::GetInstance(const ADC_HandleTypeDef* hadc)
+{
+    if ((spInstance != nullptr) && (&spInstance->mMaster == hadc))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status AdcFrontEndHal::Calibrate()
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    ADC_HandleTypeDef* handles[] = {&mMaster, &mSlave};
+    for (size_t i = 0U; i < mCalibration.size(); i++)
+    {
+        ADC_HandleTypeDef* hadc = handles[i];
+        HAL_StatusTypeDef result = HAL_ADCEx_Calibration_Start(hadc, ADC_CALIB_OFFSET_LINEARITY, ADC_SINGLE_ENDED);
+        if (result == HAL_OK)
+        {
+            mCalibration[i].offset = HAL_ADCEx_Calibration_GetValue(hadc, ADC_SINGLE_ENDED);
+            result = HAL_ADCEx_LinearCalibration_GetValue(hadc, mCalibration[i].linear.data());
+        }
+        if (result != HAL_OK)
+        {
+            return ToStatus(result);
+        }
+    }
+    mCalibrated = true;
+    return Status::OK;
+}
+
+
+Status AdcFrontEndHal::Start(MultiMode mode, uint32_t sampleRate, uint32_t* pBuffer, uint32_t words)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if ((pBuffer == nullptr) || (words < 2U) || ((words % 2U) != 0U) || (SetRate(sampleRate) != Status::OK))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mFailed)
+    {
+        const Status status = Recover();
+        if (status != Status::OK)
+        {
+            return status;
+        }
+    }
+
+    ADC_MultiModeTypeDef multimode{};
+    multimode.Mode = (mode == MultiMode::DUAL_INTERLEAVED) ? ADC_DUALMODE_INTERL : ADC_DUALMODE_REGSIMULT;
+    multimode.DualModeData = ADC_DUALMODEDATAFORMAT_32_10_BITS;
+    multimode.TwoSamplingDelay = mInterleaveDelay;
+    HAL_StatusTypeDef result = HAL_ADCEx_MultiModeConfigChannel(&mMaster, &multimode);
+    if (result != HAL_OK)
+    {
+        return ToStatus(result);
+    }
+
+    // no dirty line may be evicted into the buffer while the DMA writes it
+    Utils::DCache::Invalidate(pBuffer, words * sizeof(uint32_t));
+    mpBuffer = pBuffer;
+    mWords = words;
+    mRunning = true;
+    result = HAL_ADCEx_MultiModeStart_DMA(&mMaster, pBuffer, words);
+    if (result == HAL_OK)
+    {
+        result = HAL_TIM_Base_Start(&mTrigger);
+    }
+    if (result != HAL_OK)
+    {
+        Stop();
+        mFailed = true;
+    }
+    return ToStatus(result);
+}
+
+
+void AdcFrontEndHal::Stop()
+{
+    (void)HAL_TIM_Base_Stop(&mTrigger);
+    if (mRunning)
+    {
+        (void)HAL_ADCEx_MultiModeStop_DMA(&mMaster);
+        mRunning = false;
+    }
+}
+
+
+void AdcFrontEndHal::OnHalf(uint8_t half)
+{
+    const uint32_t halfWords = mWords / 2U;
+    Utils::DCache::Invalidate(&mpBuffer[half * halfWords], halfWords * sizeof(uint32_t));
+    if (mpListener != nullptr)
+    {
+        mpListener->OnHalfFilled(half);
+    }
+}
+
+
+void AdcFrontEndHal::OnError()
+{
+    if ((HAL_ADC_GetError(&mMaster) & HAL_ADC_ERROR_OVR) != 0U)
+    {
+        if (mpListener != nullptr)
+        {
+            mpListener->OnError(Status::OVERRUN);
+        }
+    }
+    // the DMA requests are blocked, the next start recovers the converters
+    (void)HAL_TIM_Base_Stop(&mTrigger);
+    mRunning = false;
+    mFailed = true;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnError(Status::HW_ERROR);
+    }
+}
+
+
+Status AdcFrontEndHal::SetRate(uint32_t sampleRate)
+{
+    if ((sampleRate == 0U) || ((mTimerClock % sampleRate) != 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const uint32_t ticks = mTimerClock / sampleRate;
+    const uint32_t prescaler = ((ticks - 1U) / TIMER_RANGE) + 1U;
+    if ((ticks < 2U) || ((ticks % prescaler) != 0U) || (prescaler > TIMER_RANGE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    __HAL_TIM_SET_PRESCALER(&mTrigger, prescaler - 1U);
+    __HAL_TIM_SET_AUTORELOAD(&mTrigger, (ticks / prescaler) - 1U);
+    // load the prescaler now, not at the next update
+    mTrigger.Instance->EGR = TIM_EGR_UG;
+    return Status::OK;
+}
+
+
+Status AdcFrontEndHal::Recover()
+{
+    // the DMA stream still waits for requests
+    (void)HAL_ADCEx_MultiModeStop_DMA(&mMaster);
+    ADC_HandleTypeDef* handles[] = {&mMaster, &mSlave};
+    for (size_t i = 0U; i < mCalibration.size(); i++)
+    {
+        ADC_HandleTypeDef* hadc = handles[i];
+        HAL_StatusTypeDef result = HAL_ADC_DeInit(hadc);
+        if (result == HAL_OK)
+        {
+            result = HAL_ADC_Init(hadc);
+        }
+        if ((result == HAL_OK) && mCalibrated)
+        {
+            result = HAL_ADCEx_Calibration_SetValue(hadc, ADC_SINGLE_ENDED, mCalibration[i].offset);
+        }
+        if ((result == HAL_OK) && mCalibrated)
+        {
+            result = HAL_ADCEx_LinearCalibration_SetValue(hadc, mCalibration[i].linear.data());
+        }
+        if (result != HAL_OK)
+        {
+            return ToStatus(result);
+        }
+    }
+    mFailed = false;
+    return Status::OK;
+}
+
+
+Status AdcFrontEndHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    AdcFrontEndHal* pFrontEnd = AdcFrontEndHal::GetInstance(hadc);
+    if (pFrontEnd != nullptr)
+    {
+        pFrontEnd->OnHalf(0U);
+    }
+}
+
+
+extern "C" void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
+{
+    AdcFrontEndHal* pFrontEnd = AdcFrontEndHal::GetInstance(hadc);
+    if (pFrontEnd != nullptr)
+    {
+        pFrontEnd->OnHalf(1U);
+    }
+}
+
+
+extern "C" void HAL_ADC_ErrorCallback(ADC_HandleTypeDef* hadc)
+{
+    AdcFrontEndHal* pFrontEnd = AdcFrontEndHal::GetInstance(hadc);
+    if (pFrontEnd != nullptr)
+    {
+        pFrontEnd->OnError();
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ ********************************************************************************
+ * @file        AdcFrontEndHal.hpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, dual ADC in multimode with timer trigger and circular DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IAdcFrontEnd.hpp"
+#include "stm32h7xx_hal.h"
+#include <array>
+namespace Adc {
+
+
+/**
+ * @brief   This class provides the IAdcFrontEnd on ADC1 (master) and ADC2 (slave) of the STM32H7.
+ * @details @ref Calibrate runs the offset and linearity calibration of both converters
+ *          (HAL_ADCEx_Calibration_Start with ADC_CALIB_OFFSET_LINEARITY) and keeps the factors
+ *          (HAL_ADCEx_Calibration_GetValue, HAL_ADCEx_LinearCalibration_GetValue).\n
+ *          @ref Start sets the trigger timer to the sample rate, configures the multimode
+ *          (HAL_ADCEx_MultiModeConfigChannel: simultaneous or interleaved, 32 bit dual data format) and runs
+ *          HAL_ADCEx_MultiModeStart_DMA into the circular buffer. The half and full transfer callbacks
+ *          invalidate the D-Cache lines of the filled half and report it.\n
+ *          An overrun blocks the DMA requests of the converters, it is reported as OVERRUN and HW_ERROR. After
+ *          a failure the next start initialises both converters again and restores the kept factors with
+ *          HAL_ADCEx_Calibration_SetValue and HAL_ADCEx_LinearCalibration_SetValue instead of a calibration.
+ * @note    The application initialises the ADC handles (16 bit, external trigger on the TRGO of the timer,
+ *          ADC_CONVERSIONDATA_DMA_CIRCULAR on the master, the regular channels), the timer (TRGO on update)
+ *          and the DMA of the master, and calls HAL_ADC_IRQHandler and the DMA handler.
+ *          The buffer must be located in a DMA accessible RAM (not DTCM) and 32 byte aligned. One instance
+ *          is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one AcquisitionEngine.
+ *
+ */
+class AdcFrontEndHal : public IAdcFrontEnd
+{
+    public:
+
+        /**
+         * @brief   Constructs the front end for initialised handles.
+         *
+         * @param   master              Handle of ADC1.
+         * @param   slave               Handle of ADC2.
+         * @param   trigger             Handle of the trigger timer.
+         * @param   timerClock          Kernel clock of the timer in Hz.
+         * @param   interleaveDelay     ADC_TWOSAMPLINGDELAY_x of the interleaved mode, half a conversion.
+         */
+        AdcFrontEndHal(ADC_HandleTypeDef& master, ADC_HandleTypeDef& slave, TIM_HandleTypeDef& trigger,
+                       uint32_t timerClock, uint32_t interleaveDelay);
+
+        /// @brief Destructor.
+        ~AdcFrontEndHal() override;
+
+        AdcFrontEndHal(AdcFrontEndHal const &) = delete;             //!< Copy constructor
+        AdcFrontEndHal& operator=(AdcFrontEndHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc IAdcFrontEnd::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IAdcFrontEnd::Calibrate
+        Status Calibrate() override;
+
+        /// @copydoc IAdcFrontEnd::Start
+        Status Start(MultiMode mode, uint32_t sampleRate, uint32_t* pBuffer, uint32_t words) override;
+
+        /// @copydoc IAdcFrontEnd::Stop
+        void Stop() override;
+
+        /// @brief A half is filled, called by the conversion callbacks.
+        void OnHalf(uint8_t half);
+
+        /// @brief Overrun or DMA error, called by HAL_ADC_ErrorCallback.
+        void OnError();
+
+        /// @brief Front end bound to the master handle or nullptr.
+        static AdcFrontEndHal* GetInstance(const ADC_HandleTypeDef* hadc);
+
+    private:
+
+        /// @brief Calibration factors of a converter.
+        struct Calibration
+        {
+            uint32_t offset;                                            //!< Offset factor
+            std::array<uint32_t, ADC_LINEAR_CALIB_REG_COUNT> linear;    //!< Linearity factors
+        };
+
+        /// @brief Set the trigger period.
+        Status SetRate(uint32_t sampleRate);
+
+        /// @brief Initialise both converters and restore the factors.
+        Status Recover();
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        ADC_HandleTypeDef& mMaster;         //!< ADC1
+        ADC_HandleTypeDef& mSlave;          //!< ADC2
+        TIM_HandleTypeDef& mTrigger;        //!< Trigger timer
+        uint32_t mTimerClock;               //!< Kernel clock of the timer
+        uint32_t mInterleaveDelay;          //!< Delay of the slave in the interleaved mode
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief Factors of the master and the slave.
+        std::array<Calibration, 2U> mCalibration{};
+
+        uint32_t* mpBuffer{nullptr};        //!< The circular buffer
+        uint32_t mWords{0U};                //!< Words of the buffer
+        bool mCalibrated{false};            //!< The factors are valid
+        volatile bool mRunning{false};      //!< The conversions run
+        volatile bool mFailed{false};       //!< The converters need a recovery
+
+        /// @brief The single front end instance, the device has one ADC1/ADC2 pair.
+        static AdcFrontEndHal* spInstance;
+};
+
+} // end namespace Adc
@@ -0,0 +1,192 @@
+/**
+ ********************************************************************************
+ * @file        AdcFrontEndSim.hpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, host simulation of the dual ADC with circular DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IAdcFrontEnd.hpp"
+#include "SignalGenerator.hpp"
+namespace Adc {
+
+
+/**
+ * @brief   This class provides an IAdcFrontEnd which converts synthetic signals on the host.
+ * @details The converter side (@ref Convert) writes one word per trigger into the circular buffer and reports
+ *          each filled half, the listener is called synchronously like the interrupt. In the simultaneous
+ *          mode the master and the slave sample their own signal at the trigger index, in the interleaved
+ *          mode both sample the master signal at twice the rate (master even, slave odd indices).\n
+ *          @ref InjectOverrun and @ref InjectFault model the error interrupts.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * @ref Convert may run in another thread (the simulated interrupt context) while no Start or Stop is called.
+ *
+ */
+class AdcFrontEndSim : public IAdcFrontEnd
+{
+    public:
+
+        /// @brief Constructor, both signals are ramps.
+        AdcFrontEndSim() = default;
+
+        AdcFrontEndSim(AdcFrontEndSim const &) = delete;             //!< Copy constructor
+        AdcFrontEndSim& operator=(AdcFrontEndSim const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Set the input signals.
+         *
+         * @param   master  Signal of the master.
+         * @param   slave   Signal of the slave, unused in the interleaved mode.
+         */
+        void SetSignals(const SignalGenerator& master, const SignalGenerator& slave)
+        {
+            mMaster = master;
+            mSlave = slave;
+        }
+
+        /// @brief Result of the next calibrations.
+        void SetCalibrationResult(Status status) {mCalibrationResult = status;};
+
+        /**
+         * @brief   Converter side: convert triggers.
+         *
+         * @param   words   Maximum count of words.
+         *
+         * @return  Count of converted words, 0 if stopped.
+         */
+        size_t Convert(size_t words)
+        {
+            size_t converted = 0U;
+            while (mRunning && (converted < words))
+            {
+                const uint64_t index = mTriggers;
+                uint32_t word = 0U;
+                if (mMode == MultiMode::DUAL_INTERLEAVED)
+                {
+                    word = mMaster.Sample(2U * index) | (static_cast<uint32_t>(mMaster.Sample((2U * index) + 1U)) << 16U);
+                }
+                else
+                {
+                    word = mMaster.Sample(index) | (static_cast<uint32_t>(mSlave.Sample(index)) << 16U);
+                }
+                mpBuffer[mPos] = word;
+                mPos++;
+                mTriggers++;
+                converted++;
+                if ((mPos == (mWords / 2U)) || (mPos == mWords))
+                {
+                    const uint8_t filled = (mPos == mWords) ? 1U : 0U;
+                    mPos = (mPos == mWords) ? 0U : mPos;
+                    if (mpListener != nullptr)
+                    {
+                        mpListener->OnHalfFilled(filled);
+                    }
+                }
+            }
+            return converted;
+        }
+
+        /// @brief Report lost conversions, the acquisition continues.
+        void InjectOverrun()
+        {
+            if (mRunning && (mpListener != nullptr))
+            {
+                mpListener->OnError(Status::OVERRUN);
+            }
+        }
+
+        /// @brief Report a DMA error, the acquisition stops.
+        void InjectFault()
+        {
+            if (mRunning)
+            {
+                mRunning = false;
+                if (mpListener != nullptr)
+                {
+                    mpListener->OnError(Status::HW_ERROR);
+                }
+            }
+        }
+
+        /// @copydoc IAdcFrontEnd::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IAdcFrontEnd::Calibrate
+        Status Calibrate() override
+        {
+            if (mRunning)
+            {
+                return Status::BUSY;
+            }
+            mCalibrations++;
+            return mCalibrationResult;
+        }
+
+        /// @copydoc IAdcFrontEnd::Start
+        Status Start(MultiMode mode, uint32_t sampleRate, uint32_t* pBuffer, uint32_t words) override
+        {
+            if (mRunning)
+            {
+                return Status::BUSY;
+            }
+            if ((pBuffer == nullptr) || (sampleRate == 0U) || (words < 2U) || ((words % 2U) != 0U))
+            {
+                return Status::INVALID_PARAM;
+            }
+            mMode = mode;
+            mSampleRate = sampleRate;
+            mpBuffer = pBuffer;
+            mWords = words;
+            mPos = 0U;
+            mTriggers = 0U;
+            mRunning = true;
+            return Status::OK;
+        }
+
+        /// @copydoc IAdcFrontEnd::Stop
+        void Stop() override {mRunning = false;};
+
+        /// @brief The conversions run.
+        bool IsRunning() const {return mRunning;};
+
+        /// @brief The multimode of the last start.
+        MultiMode GetMode() const {return mMode;};
+
+        /// @brief The trigger rate of the last start.
+        uint32_t GetSampleRate() const {return mSampleRate;};
+
+        /// @brief Count of calibrations.
+        uint32_t GetCalibrations() const {return mCalibrations;};
+
+        /// @brief Triggers since the last start.
+        uint64_t GetTriggers() const {return mTriggers;};
+
+    private:
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        SignalGenerator mMaster{};                  //!< Signal of the master
+        SignalGenerator mSlave{};                   //!< Signal of the slave
+        Status mCalibrationResult{Status::OK};      //!< Result of the calibrations
+        MultiMode mMode{MultiMode::DUAL_SIMULTANEOUS};  //!< Multimode
+        uint32_t mSampleRate{0U};                   //!< Trigger rate
+        uint32_t* mpBuffer{nullptr};                //!< The circular buffer
+        uint32_t mWords{0U};                        //!< Words of the buffer
+        uint32_t mPos{0U};                          //!< Next word of the buffer
+        uint64_t mTriggers{0U};                     //!< Converted words
+        uint32_t mCalibrations{0U};                 //!< Calibrations
+        bool mRunning{false};                       //!< The conversions run
+};
+
+} // end namespace Adc
@@ -0,0 +1,93 @@
+/**
+ ********************************************************************************
+ * @file        AdcTypes.hpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, types of the synchronized acquisition.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+namespace Adc {
+
+
+/// @brief Result of an acquisition operation or event.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The acquisition runs
+    INVALID_PARAM=2,  //!< Parameter or configuration is inconsistent
+    HW_ERROR=3,       //!< The peripheral or its DMA failed, the acquisition stopped
+    OVERRUN=4         //!< Conversions were lost, the acquisition continues
+};
+
+/// @brief Multimode of the master (ADC1) and the slave (ADC2).
+enum class MultiMode : uint8_t
+{
+    DUAL_SIMULTANEOUS=0,  //!< Both sample at every trigger, two channels
+    DUAL_INTERLEAVED=1    //!< The slave samples half a period later, one channel at twice the rate
+};
+
+/// @brief Maximum words of the DMA buffer, the limit of the DMA counter.
+constexpr uint32_t MAX_BUFFER_WORDS{65535U};
+
+/// @brief Maximum blocks of the DMA buffer.
+constexpr uint32_t MAX_BLOCKS{32U};
+
+/**
+ * @brief Configuration of an acquisition.
+ * @details The DMA buffer holds @ref blocks blocks of @ref blockWords words in a ring, each half of it is
+ *          delivered when the DMA has filled it.
+ */
+struct AcquisitionConfig
+{
+    MultiMode mode;         //!< The multimode
+    uint32_t sampleRate;    //!< Trigger rate in Hz, the interleaved mode samples at twice the rate
+    uint32_t* pBuffer;      //!< DMA buffer, 32 byte aligned, in a DMA accessible RAM
+    uint16_t blockWords;    //!< Words per block, a multiple of 8 (a cache line)
+    uint8_t blocks;         //!< Blocks in the buffer, even, 2 .. @ref MAX_BLOCKS
+
+    /// @brief The words of the buffer.
+    uint32_t BufferWords() const {return static_cast<uint32_t>(blockWords) * blocks;};
+
+    /// @brief Parameters in range.
+    bool IsValid() const
+    {
+        return (pBuffer != nullptr) && (sampleRate > 0U) && (blockWords > 0U) && ((blockWords % 8U) == 0U)
+            && (blocks >= 2U) && (blocks <= MAX_BLOCKS) && ((blocks % 2U) == 0U)
+            && (BufferWords() <= MAX_BUFFER_WORDS) && (mode <= MultiMode::DUAL_INTERLEAVED);
+    }
+};
+
+/**
+ * @brief A block of conversions in the DMA buffer.
+ * @details Every word holds the master result in the lower and the slave result in the upper half (the
+ *          common data register in 32 bit dual format). In the interleaved mode the master result is the
+ *          earlier sample.
+ */
+struct SampleBlock
+{
+    std::span<const uint32_t> words;    //!< The words, valid until the DMA refills them
+    uint32_t sequence;                  //!< Running number since the start
+};
+
+/// @brief The master result of a word.
+inline uint16_t Master(uint32_t word)
+{
+    return static_cast<uint16_t>(word & 0xFFFFU);
+}
+
+/// @brief The slave result of a word.
+inline uint16_t Slave(uint32_t word)
+{
+    return static_cast<uint16_t>(word >> 16U);
+}
+
+} // end namespace Adc
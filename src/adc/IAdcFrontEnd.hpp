@@ -0,0 +1,97 @@
+/**
+ ********************************************************************************
+ * @file        IAdcFrontEnd.hpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, interface of a dual ADC with circular DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "AdcTypes.hpp"
+namespace Adc {
+
+
+/**
+ * @brief   This class provides the converters of an acquisition (hardware or simulation).
+ * @details @ref Start triggers the master and the slave by a timer and streams the words of the common data
+ *          register through a circular buffer, each filled half is reported while the other one is written.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one AcquisitionEngine.
+ *
+ */
+class IAdcFrontEnd
+{
+    public:
+
+        /// @brief Receiver of the conversion events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A half of the buffer is filled, called from the interrupt context.
+                 * @param half      0 for the first, 1 for the second half.
+                 */
+                virtual void OnHalfFilled(uint8_t half) = 0;
+
+                /**
+                 * @brief Conversions were lost or the transfer failed, called from the interrupt context.
+                 * @param status    OVERRUN or HW_ERROR (the transfer stopped).
+                 */
+                virtual void OnError(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IAdcFrontEnd() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Calibrate offset and linearity of both converters, only while no acquisition runs.
+         * @return OK, BUSY, HW_ERROR.
+         */
+        virtual Status Calibrate() = 0;
+
+        /**
+         * @brief Start the triggered conversions into a circular buffer.
+         * @param mode          The multimode.
+         * @param sampleRate    Trigger rate in Hz.
+         * @param pBuffer       The buffer.
+         * @param words         Words of the buffer, even.
+         * @return OK, BUSY, INVALID_PARAM (rate not reachable), HW_ERROR.
+         */
+        virtual Status Start(MultiMode mode, uint32_t sampleRate, uint32_t* pBuffer, uint32_t words) = 0;
+
+        /// @brief Stop the conversions.
+        virtual void Stop() = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IAdcFrontEnd() = default;
+
+        IAdcFrontEnd(IAdcFrontEnd const &) = default;             //!< Copy constructor
+        IAdcFrontEnd(IAdcFrontEnd &&) = default;                  //!< Move constructor
+
+        IAdcFrontEnd& operator=(IAdcFrontEnd const &) = default;  //!< Copy assignment
+        IAdcFrontEnd& operator=(IAdcFrontEnd &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Adc
@@ -0,0 +1,90 @@
+/**
+ ********************************************************************************
+ * @file        SignalGenerator.hpp
+ *
+ * @namespace   Adc
+ *
+ * @brief       Adc, synthetic input signal of the host simulation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+namespace Adc {
+
+
+/**
+ * @brief   This class provides the 16 bit conversion results of a synthetic input at a sample index.
+ * @details RAMP counts the sample index modulo 2^16, every lost or repeated sample breaks the sequence.
+ *          SINE is offset + amplitude * sin(2 * pi * frequency * index + phase), rounded and limited to the
+ *          range of the converter, the frequency in cycles per sample.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe, it has no mutable state.
+ *
+ */
+class SignalGenerator
+{
+    public:
+
+        /// @brief Wave forms.
+        enum class Shape : uint8_t
+        {
+            RAMP=0,     //!< The sample index
+            SINE=1      //!< A sine wave
+        };
+
+        /// @brief Constructs a ramp.
+        SignalGenerator() = default;
+
+        /**
+         * @brief   Constructs a sine wave.
+         *
+         * @param   frequency   Cycles per sample, below 0.5.
+         * @param   amplitude   Amplitude in LSB.
+         * @param   offset      Offset in LSB.
+         * @param   phase       Phase in rad.
+         */
+        SignalGenerator(double frequency, double amplitude, double offset, double phase = 0.0)
+        : mShape(Shape::SINE), mFrequency(frequency), mAmplitude(amplitude), mOffset(offset), mPhase(phase) {};
+
+        /**
+         * @brief   The conversion result.
+         *
+         * @param   index   Sample index since the start.
+         *
+         * @return  The result.
+         */
+        uint16_t Sample(uint64_t index) const
+        {
+            if (mShape == Shape::RAMP)
+            {
+                return static_cast<uint16_t>(index & 0xFFFFU);
+            }
+            constexpr double TWO_PI{6.28318530717958647692};
+            // the fraction of the cycle keeps the argument small for long runs
+            const double cycle = std::fmod(mFrequency * static_cast<double>(index), 1.0);
+            const double value = mOffset + (mAmplitude * std::sin((TWO_PI * cycle) + mPhase));
+            return static_cast<uint16_t>(std::clamp(std::lround(value), 0L, 65535L));
+        }
+
+        /// @brief The wave form.
+        Shape GetShape() const {return mShape;};
+
+    private:
+
+        Shape mShape{Shape::RAMP};  //!< Wave form
+        double mFrequency{0.0};     //!< Cycles per sample
+        double mAmplitude{0.0};     //!< Amplitude in LSB
+        double mOffset{0.0};        //!< Offset in LSB
+        double mPhase{0.0};         //!< Phase in rad
+};
+
+} // end namespace Adc
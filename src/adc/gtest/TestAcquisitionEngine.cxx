@@ -0,0 +1,252 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../AcquisitionEngine.hpp"
+#include "../AdcFrontEndSim.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Adc;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  CalibratesOnceBeforeTheFirstStart
+*   (0)  DeliversTheBlocksInOrder
+*   (0)  InterleavedModeDoublesTheRate
+*   (0)  CountsLostBlocksAndOverruns
+*   (0)  StreamsAcrossThreadsWithoutLoss
+*/
+
+namespace {
+
+/// @brief Words per block of the tests.
+constexpr uint16_t BLOCK_WORDS{64U};
+
+/// @brief A configuration on a buffer.
+AcquisitionConfig Config(std::vector<uint32_t>& buffer, MultiMode mode, uint8_t blocks)
+{
+    buffer.assign(static_cast<size_t>(BLOCK_WORDS) * blocks, 0U);
+    return {mode, 1000000U, buffer.data(), BLOCK_WORDS, blocks};
+}
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(AcquisitionEngine_Test, CalibratesOnceBeforeTheFirstStart)
+{
+    AdcFrontEndSim frontEnd;
+    AcquisitionEngine engine(frontEnd);
+    std::vector<uint32_t> buffer;
+    AcquisitionConfig config = Config(buffer, MultiMode::DUAL_SIMULTANEOUS, 4U);
+
+    // a failed calibration keeps the acquisition off
+    frontEnd.SetCalibrationResult(Status::HW_ERROR);
+    EXPECT_EQ(Status::HW_ERROR, engine.Start(config));
+    EXPECT_FALSE(engine.IsCalibrated());
+    EXPECT_FALSE(frontEnd.IsRunning());
+
+    frontEnd.SetCalibrationResult(Status::OK);
+    ASSERT_EQ(Status::OK, engine.Start(config));
+    EXPECT_TRUE(engine.IsCalibrated());
+    EXPECT_EQ(2U, frontEnd.GetCalibrations());
+    EXPECT_EQ(1000000U, frontEnd.GetSampleRate());
+    EXPECT_EQ(Status::BUSY, engine.Start(config));
+    engine.Stop();
+    EXPECT_FALSE(frontEnd.IsRunning());
+    ASSERT_EQ(Status::OK, engine.Start(config));
+    EXPECT_EQ(2U, frontEnd.GetCalibrations());
+    engine.Stop();
+
+    // the buffer shape
+    for (const auto& [words, blocks] : {std::pair<uint16_t, uint8_t>{60U, 4U}, {64U, 3U}, {64U, 0U},
+                                        {64U, MAX_BLOCKS + 2U}, {8192U, 16U}})
+    {
+        AcquisitionConfig invalid = config;
+        invalid.blockWords = words;
+        invalid.blocks = blocks;
+        EXPECT_EQ(Status::INVALID_PARAM, engine.Start(invalid)) << words << " " << static_cast<int>(blocks);
+    }
+    config.pBuffer = nullptr;
+    EXPECT_EQ(Status::INVALID_PARAM, engine.Start(config));
+}
+
+
+TEST(AcquisitionEngine_Test, DeliversTheBlocksInOrder)
+{
+    AdcFrontEndSim frontEnd;
+    const SignalGenerator sine(0.01, 30000.0, 32768.0);
+    frontEnd.SetSignals(SignalGenerator(), sine);
+    AcquisitionEngine engine(frontEnd);
+    std::vector<uint32_t> buffer;
+    ASSERT_EQ(Status::OK, engine.Start(Config(buffer, MultiMode::DUAL_SIMULTANEOUS, 4U)));
+
+    SampleBlock block{};
+    EXPECT_FALSE(engine.Receive(block));
+    // less than a half delivers nothing
+    frontEnd.Convert(2U * BLOCK_WORDS - 1U);
+    EXPECT_FALSE(engine.Receive(block));
+
+    uint32_t sequence = 0U;
+    for (uint32_t round = 0U; round < 5U; round++)
+    {
+        frontEnd.Convert((round == 0U) ? 1U : (2U * BLOCK_WORDS));
+        for (uint32_t i = 0U; i < 2U; i++)
+        {
+            ASSERT_TRUE(engine.Receive(block));
+            ASSERT_EQ(sequence, block.sequence);
+            ASSERT_EQ(BLOCK_WORDS, block.words.size());
+            // zero copy, the block is the slot in the buffer
+            EXPECT_EQ(&buffer[(sequence % 4U) * BLOCK_WORDS], block.words.data());
+            for (uint32_t w = 0U; w < BLOCK_WORDS; w++)
+            {
+                const uint64_t index = (static_cast<uint64_t>(sequence) * BLOCK_WORDS) + w;
+                ASSERT_EQ(static_cast<uint16_t>(index), Master(block.words[w]));
+                ASSERT_EQ(sine.Sample(index), Slave(block.words[w]));
+            }
+            EXPECT_TRUE(engine.Release(block));
+            sequence++;
+        }
+        EXPECT_FALSE(engine.Receive(block));
+    }
+    EXPECT_EQ(10U, engine.GetProducedBlocks());
+    EXPECT_EQ(0U, engine.GetLostBlocks());
+}
+
+
+TEST(AcquisitionEngine_Test, InterleavedModeDoublesTheRate)
+{
+    AdcFrontEndSim frontEnd;
+    AcquisitionEngine engine(frontEnd);
+    std::vector<uint32_t> buffer;
+    ASSERT_EQ(Status::OK, engine.Start(Config(buffer, MultiMode::DUAL_INTERLEAVED, 2U)));
+    EXPECT_EQ(MultiMode::DUAL_INTERLEAVED, frontEnd.GetMode());
+
+    uint16_t expected = 0U;
+    SampleBlock block{};
+    for (uint32_t i = 0U; i < 3U; i++)
+    {
+        frontEnd.Convert(BLOCK_WORDS);
+        ASSERT_TRUE(engine.Receive(block));
+        // the master sample precedes the slave sample of the same word
+        for (const uint32_t word : block.words)
+        {
+            ASSERT_EQ(expected, Master(word));
+            ASSERT_EQ(static_cast<uint16_t>(expected + 1U), Slave(word));
+            expected = static_cast<uint16_t>(expected + 2U);
+        }
+        EXPECT_TRUE(engine.Release(block));
+    }
+}
+
+
+TEST(AcquisitionEngine_Test, CountsLostBlocksAndOverruns)
+{
+    AdcFrontEndSim frontEnd;
+    AcquisitionEngine engine(frontEnd);
+    std::vector<uint32_t> buffer;
+    ASSERT_EQ(Status::OK, engine.Start(Config(buffer, MultiMode::DUAL_SIMULTANEOUS, 4U)));
+
+    // a block is valid until the DMA has filled the other half
+    frontEnd.Convert(2U * BLOCK_WORDS);
+    SampleBlock held{};
+    ASSERT_TRUE(engine.Receive(held));
+    frontEnd.Convert((2U * BLOCK_WORDS) - 1U);
+    EXPECT_TRUE(engine.Release(held));
+    ASSERT_TRUE(engine.Receive(held));
+    EXPECT_EQ(1U, held.sequence);
+    frontEnd.Convert(1U);
+    EXPECT_FALSE(engine.Release(held));
+    EXPECT_EQ(1U, engine.GetLostBlocks());
+
+    // the queued blocks of refilled halves are skipped
+    SampleBlock block{};
+    ASSERT_TRUE(engine.Receive(block));
+    EXPECT_EQ(2U, block.sequence);
+    frontEnd.Convert(4U * BLOCK_WORDS);
+    ASSERT_TRUE(engine.Receive(block));
+    EXPECT_EQ(6U, block.sequence);
+    EXPECT_EQ(4U, engine.GetLostBlocks());
+
+    // a stalled consumer loses the blocks beyond the queue and the overwritten ones
+    frontEnd.Convert(40U * BLOCK_WORDS);
+    EXPECT_EQ(48U, engine.GetProducedBlocks());
+    EXPECT_FALSE(engine.Receive(block));
+    EXPECT_EQ(48U - 3U, engine.GetLostBlocks());
+
+    // an overrun is counted, a fault stops the acquisition
+    frontEnd.InjectOverrun();
+    EXPECT_EQ(1U, engine.GetOverruns());
+    EXPECT_TRUE(engine.IsRunning());
+    frontEnd.InjectFault();
+    EXPECT_FALSE(engine.IsRunning());
+    EXPECT_EQ(0U, frontEnd.Convert(BLOCK_WORDS));
+    ASSERT_EQ(Status::OK, engine.Start(Config(buffer, MultiMode::DUAL_SIMULTANEOUS, 4U)));
+    EXPECT_EQ(0U, engine.GetProducedBlocks());
+}
+
+
+TEST(AcquisitionEngine_Test, StreamsAcrossThreadsWithoutLoss)
+{
+    AdcFrontEndSim frontEnd;
+    AcquisitionEngine engine(frontEnd);
+    std::vector<uint32_t> buffer;
+    ASSERT_EQ(Status::OK, engine.Start(Config(buffer, MultiMode::DUAL_SIMULTANEOUS, 8U)));
+
+    constexpr uint32_t BLOCKS{20000U};
+    std::atomic<uint32_t> released{0U};
+    // the converter fills a half while the consumer works on the other one, the half event waits for it
+    std::thread converter([&]() {
+        for (uint32_t produced = 0U; produced < BLOCKS; produced += 4U)
+        {
+            frontEnd.Convert((4U * BLOCK_WORDS) - 1U);
+            while ((released.load(std::memory_order_acquire) < produced) && (engine.GetLostBlocks() == 0U))
+            {
+                std::this_thread::yield();
+            }
+            frontEnd.Convert(1U);
+        }
+    });
+
+    uint32_t expected = 0U;
+    bool intact = true;
+    SampleBlock block{};
+    while ((expected < BLOCKS) && (engine.GetLostBlocks() == 0U))
+    {
+        if (!engine.Receive(block))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        intact = intact && (block.sequence == expected);
+        for (uint32_t w = 0U; w < BLOCK_WORDS; w++)
+        {
+            const uint64_t index = (static_cast<uint64_t>(block.sequence) * BLOCK_WORDS) + w;
+            intact = intact && (Master(block.words[w]) == static_cast<uint16_t>(index));
+        }
+        intact = engine.Release(block) && intact;
+        expected++;
+        released.store(expected, std::memory_order_release);
+    }
+    converter.join();
+    engine.Stop();
+    EXPECT_TRUE(intact);
+    EXPECT_EQ(BLOCKS, engine.GetProducedBlocks());
+    EXPECT_EQ(0U, engine.GetLostBlocks());
+}
+
+} // end namespace GTest
@@ -0,0 +1,234 @@
+/**
+ ********************************************************************************
+ * @file        AsyncResampler.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, asynchronous sample rate converter implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AsyncResampler.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+/// @brief Shape of the Kaiser window, about 90 dB stop band.
+constexpr double KAISER_BETA{9.0};
+
+/// @brief Cut off in units of the lower rate.
+constexpr double CUTOFF{0.45};
+
+/// @brief Time constant of the fill low pass in seconds.
+constexpr double FILL_TAU{0.05};
+
+/// @brief Natural frequency of the drift loop in rad/s.
+constexpr double LOOP_FREQUENCY{2.0};
+
+/// @brief Damping of the drift loop.
+constexpr double LOOP_DAMPING{1.0};
+
+/// @brief Modified Bessel function of the first kind, order zero.
+double BesselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (uint32_t k = 1U; term > (sum * 1e-12); k++)
+    {
+        const double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+    }
+    return sum;
+}
+
+} // end anonymous namespace
+
+
+Status AsyncResampler::Configure(const ResamplerConfig& config)
+{
+    if ((config.inputRate == 0U) || (config.outputRate == 0U) || (config.channels < 1U)
+        || (config.channels > MAX_CHANNELS) || ((config.fifo.size() / config.channels) < (2U * TAPS)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mConfig = config;
+    mCapacity = static_cast<uint32_t>(config.fifo.size() / config.channels);
+
+    // windowed sinc over TAPS input frames at PHASES times the input rate, the phase PHASES is zero
+    const uint32_t length = PHASES * TAPS;
+    const double cutoff = CUTOFF * std::min(1.0, static_cast<double>(config.outputRate) / config.inputRate);
+    std::array<double, (PHASES + 1U) * TAPS> prototype{};
+    double sum = 0.0;
+    for (uint32_t m = 0U; m < length; m++)
+    {
+        const double t = (static_cast<double>(m) - (length / 2.0)) / PHASES;
+        const double x = 2.0 * cutoff * t;
+        const double sinc = (std::fabs(x) < 1e-12) ? 1.0 : (std::sin(PI * x) / (PI * x));
+        const double edge = (2.0 * m / length) - 1.0;
+        const double window = BesselI0(KAISER_BETA * std::sqrt(1.0 - (edge * edge))) / BesselI0(KAISER_BETA);
+        prototype[m] = 2.0 * cutoff * sinc * window;
+        sum += prototype[m];
+    }
+    // tap k of phase p is the prototype at k * PHASES + p, stored oldest input frame first
+    for (uint32_t p = 0U; p <= PHASES; p++)
+    {
+        for (uint32_t k = 0U; k < TAPS; k++)
+        {
+            const uint32_t m = (k * PHASES) + p;
+            const double value = (m < length) ? (prototype[m] * PHASES / sum) : 0.0;
+            mCoefficients[(p * TAPS) + (TAPS - 1U - k)] = static_cast<float>(value);
+        }
+    }
+
+    // the loop gains of a fill error relative to the target
+    const double plant = static_cast<double>(config.inputRate) / (mCapacity / 2U);
+    mProportionalGain = 2.0 * LOOP_DAMPING * LOOP_FREQUENCY / plant;
+    mIntegralGain = LOOP_FREQUENCY * LOOP_FREQUENCY / plant;
+
+    for (std::array<float, 2U * TAPS>& history : mHistory)
+    {
+        history.fill(0.0F);
+    }
+    mHistoryPos = 0U;
+    mPosition = 1.0;
+    mNominal = static_cast<double>(config.inputRate) / config.outputRate;
+    mStep = mNominal;
+    mPrimed = false;
+    mAverageFill = 0.0;
+    mIntegral = 0.0;
+    mHead.store(0U, std::memory_order_relaxed);
+    mTail.store(0U, std::memory_order_relaxed);
+    mUnderruns.store(0U, std::memory_order_relaxed);
+    mDropped.store(0U, std::memory_order_relaxed);
+    mCorrection.store(0.0, std::memory_order_release);
+    return Status::OK;
+}
+
+
+uint32_t AsyncResampler::Write(std::span<const float> frames)
+{
+    if (mCapacity == 0U)
+    {
+        return 0U;
+    }
+    const uint8_t channels = mConfig.channels;
+    const uint32_t count = static_cast<uint32_t>(frames.size() / channels);
+    const uint32_t head = mHead.load(std::memory_order_relaxed);
+    const uint32_t tail = mTail.load(std::memory_order_acquire);
+    const uint32_t accepted = std::min(count, mCapacity - (head - tail));
+    for (uint32_t i = 0U; i < accepted; i++)
+    {
+        std::copy_n(&frames[static_cast<size_t>(i) * channels], channels,
+                    &mConfig.fifo[static_cast<size_t>((head + i) % mCapacity) * channels]);
+    }
+    mHead.store(head + accepted, std::memory_order_release);
+    if (accepted < count)
+    {
+        mDropped.fetch_add(count - accepted, std::memory_order_relaxed);
+    }
+    return accepted;
+}
+
+
+uint32_t AsyncResampler::Read(std::span<float> frames, uint8_t channels)
+{
+    if ((mCapacity == 0U) || (channels != mConfig.channels))
+    {
+        return 0U;
+    }
+    const uint32_t requested = static_cast<uint32_t>(frames.size() / channels);
+    const uint32_t head = mHead.load(std::memory_order_acquire);
+    uint32_t tail = mTail.load(std::memory_order_relaxed);
+
+    // silent until half the FIFO is buffered
+    if (!mPrimed)
+    {
+        if ((head - tail) < (mCapacity / 2U))
+        {
+            std::fill(frames.begin(), frames.end(), 0.0F);
+            return requested;
+        }
+        mPrimed = true;
+        mAverageFill = static_cast<double>(head - tail);
+    }
+
+    uint32_t produced = 0U;
+    for (; produced < requested; produced++)
+    {
+        while ((mPosition >= 1.0) && (tail != head))
+        {
+            Advance(tail);
+            tail++;
+            mPosition -= 1.0;
+        }
+        if (mPosition >= 1.0)
+        {
+            mUnderruns.fetch_add(1U, std::memory_order_relaxed);
+            mPrimed = false;
+            break;
+        }
+
+        // two neighbouring phases, linear in between
+        const double scaled = mPosition * PHASES;
+        const uint32_t phase = std::min(static_cast<uint32_t>(scaled), PHASES - 1U);
+        const float fraction = static_cast<float>(scaled - phase);
+        const float* pLower = &mCoefficients[phase * TAPS];
+        const float* pUpper = pLower + TAPS;
+        for (uint8_t c = 0U; c < channels; c++)
+        {
+            const float* pWindow = &mHistory[c][mHistoryPos];
+            float lower = 0.0F;
+            float upper = 0.0F;
+            for (uint32_t k = 0U; k < TAPS; k++)
+            {
+                lower += pLower[k] * pWindow[k];
+                upper += pUpper[k] * pWindow[k];
+            }
+            frames[(static_cast<size_t>(produced) * channels) + c] = lower + (fraction * (upper - lower));
+        }
+        mPosition += mStep;
+    }
+    mTail.store(tail, std::memory_order_release);
+    Regulate(requested);
+    return produced;
+}
+
+
+void AsyncResampler::Advance(uint32_t tail)
+{
+    const float* pFrame = &mConfig.fifo[static_cast<size_t>(tail % mCapacity) * mConfig.channels];
+    for (uint8_t c = 0U; c < mConfig.channels; c++)
+    {
+        mHistory[c][mHistoryPos] = pFrame[c];
+        mHistory[c][mHistoryPos + TAPS] = pFrame[c];
+    }
+    mHistoryPos = (mHistoryPos + 1U) % TAPS;
+}
+
+
+void AsyncResampler::Regulate(uint32_t frames)
+{
+    if (!mPrimed)
+    {
+        return;
+    }
+    // PI loop on the smoothed fill, a full FIFO consumes faster
+    const double dt = static_cast<double>(frames) / mConfig.outputRate;
+    const double fill = mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_relaxed);
+    mAverageFill += std::min(1.0, dt / FILL_TAU) * (fill - mAverageFill);
+    const double target = mCapacity / 2U;
+    const double error = (mAverageFill - target) / target;
+    mIntegral = std::clamp(mIntegral + (mIntegralGain * error * dt), -MAX_CORRECTION, MAX_CORRECTION);
+    const double correction = std::clamp((mProportionalGain * error) + mIntegral, -MAX_CORRECTION, MAX_CORRECTION);
+    mStep = mNominal * (1.0 + correction);
+    mCorrection.store(correction, std::memory_order_relaxed);
+}
@@ -0,0 +1,145 @@
+/**
+ ********************************************************************************
+ * @file        AsyncResampler.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, asynchronous polyphase sample rate converter.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IAudioSource.hpp"
+#include <array>
+#include <atomic>
+namespace Audio {
+
+
+/**
+ * @brief Configuration of a sample rate converter.
+ */
+struct ResamplerConfig
+{
+    uint32_t inputRate;         //!< Nominal frame rate of the producer in Hz
+    uint32_t outputRate;        //!< Frame rate of the audio engine in Hz
+    uint8_t channels;           //!< Samples per frame 1 .. @ref MAX_CHANNELS
+    std::span<float> fifo;      //!< Storage of the input FIFO, a whole number of frames
+};
+
+
+/**
+ * @brief   This class provides the frames of a producer with its own clock as a source of the audio engine.
+ * @details The producer writes frames at its rate into a lock-free FIFO (@ref Write), the engine reads them
+ *          at its rate (@ref Read). Every output frame is a polyphase FIR over @ref TAPS input frames: the
+ *          prototype (windowed sinc, Kaiser, cut off at 0.45 of the lower rate) is split into @ref PHASES
+ *          phases, the fractional position interpolates linearly between two neighbouring phases.\n
+ *          The step between the output frames is the nominal rate ratio corrected by a PI loop which holds
+ *          the FIFO at half its size, it follows the drift between the two clocks up to
+ *          @ref MAX_CORRECTION. The FIFO fill is the latency of the producer.\n
+ *          The output is silent until the FIFO is half full. A FIFO which runs empty is an underrun (the
+ *          mixer fills up the period), the converter waits for half a FIFO again. Frames which do not fit
+ *          into the FIFO are dropped and counted.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe for one producer (@ref Write) and the engine
+ * (@ref Read). @ref Configure only while neither side runs.
+ *
+ */
+class AsyncResampler : public IAudioSource
+{
+    public:
+
+        /// @brief Phases of the prototype filter.
+        static constexpr uint32_t PHASES{64U};
+
+        /// @brief Taps per phase, input frames per output frame.
+        static constexpr uint32_t TAPS{32U};
+
+        /// @brief Largest relative correction of the rate ratio.
+        static constexpr double MAX_CORRECTION{0.002};
+
+        /// @brief Constructor, configure before use.
+        AsyncResampler() = default;
+
+        AsyncResampler(AsyncResampler const &) = delete;             //!< Copy constructor
+        AsyncResampler& operator=(AsyncResampler const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Design the filter and clear the FIFO and the loop.
+         *
+         * @param   config  The configuration, the FIFO storage must outlive the converter.
+         *
+         * @return  OK or INVALID_PARAM (rates, channels, FIFO below 2 * @ref TAPS frames).
+         */
+        Status Configure(const ResamplerConfig& config);
+
+        /**
+         * @brief   Producer side: append frames.
+         *
+         * @param   frames  Interleaved frames.
+         *
+         * @return  Frames accepted, the rest is dropped.
+         */
+        uint32_t Write(std::span<const float> frames);
+
+        /// @copydoc IAudioSource::Read
+        uint32_t Read(std::span<float> frames, uint8_t channels) override;
+
+        /// @brief The relative correction of the rate ratio.
+        double GetCorrection() const {return mCorrection.load(std::memory_order_relaxed);};
+
+        /// @brief Frames in the FIFO.
+        uint32_t GetFill() const
+        {
+            return mHead.load(std::memory_order_acquire) - mTail.load(std::memory_order_acquire);
+        };
+
+        /// @brief The FIFO ran empty since the configuration.
+        uint32_t GetUnderruns() const {return mUnderruns.load(std::memory_order_relaxed);};
+
+        /// @brief Frames dropped on a full FIFO since the configuration.
+        uint32_t GetDropped() const {return mDropped.load(std::memory_order_relaxed);};
+
+    private:
+
+        /// @brief Move an input frame from the FIFO into the history.
+        void Advance(uint32_t tail);
+
+        /// @brief Adjust the ratio to the FIFO fill after a period.
+        void Regulate(uint32_t frames);
+
+        /// @brief The configuration.
+        ResamplerConfig mConfig{0U, 0U, 0U, {}};
+
+        /// @brief Capacity of the FIFO in frames.
+        uint32_t mCapacity{0U};
+
+        /// @brief Phase major coefficients, the taps of a phase reversed, one extra phase for the interpolation.
+        alignas(32) std::array<float, (PHASES + 1U) * TAPS> mCoefficients{};
+
+        /// @brief Last TAPS input frames per channel, stored twice for a contiguous window.
+        alignas(32) std::array<std::array<float, 2U * TAPS>, MAX_CHANNELS> mHistory{};
+
+        uint32_t mHistoryPos{0U};           //!< Oldest frame of the window
+        double mPosition{1.0};              //!< Position between the newest input frames
+        double mNominal{1.0};               //!< Input frames per output frame
+        double mStep{1.0};                  //!< Corrected input frames per output frame
+        bool mPrimed{false};                //!< The FIFO was filled to the target
+        double mAverageFill{0.0};           //!< Low pass of the fill in frames
+        double mIntegral{0.0};              //!< Integral part of the correction
+        double mProportionalGain{0.0};      //!< Correction per relative fill error
+        double mIntegralGain{0.0};          //!< Correction per relative fill error and second
+
+        std::atomic<uint32_t> mHead{0U};        //!< Frames written, by the producer
+        std::atomic<uint32_t> mTail{0U};        //!< Frames read, by the engine
+        std::atomic<uint32_t> mUnderruns{0U};   //!< Empty FIFO, by the engine
+        std::atomic<uint32_t> mDropped{0U};     //!< Dropped frames, by the producer
+        std::atomic<double> mCorrection{0.0};   //!< Correction, by the engine
+};
+
+} // end namespace Audio
@@ -0,0 +1,125 @@
+/**
+ ********************************************************************************
+ * @file        AudioEngine.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, full duplex audio engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AudioEngine.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+namespace {
+
+/// @brief Full scale of a 24 bit slot.
+constexpr float FULL_SCALE{8388608.0F};
+
+/// @brief Largest 24 bit sample.
+constexpr float MAX_SAMPLE{8388607.0F};
+
+} // end anonymous namespace
+
+
+AudioEngine::AudioEngine(ISaiPort& port)
+: mPort(port)
+{
+    mPort.SetListener(this);
+}
+
+
+AudioEngine::~AudioEngine()
+{
+    Stop();
+    mPort.SetListener(nullptr);
+}
+
+
+Status AudioEngine::Start(const StreamConfig& config)
+{
+    if (IsRunning())
+    {
+        return Status::BUSY;
+    }
+    if (!config.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    // the interrupt is idle, the first two periods are silent
+    mConfig = config;
+    std::fill_n(config.pTx, config.RingWords(), 0);
+    mNextHalf = 0U;
+    mPeriods.store(0U, std::memory_order_relaxed);
+    mXruns.store(0U, std::memory_order_relaxed);
+    mRunning.store(true, std::memory_order_release);
+
+    const Status status = mPort.Start(config);
+    if (status != Status::OK)
+    {
+        mRunning.store(false, std::memory_order_release);
+    }
+    return status;
+}
+
+
+void AudioEngine::Stop()
+{
+    if (IsRunning())
+    {
+        mPort.Stop();
+        mRunning.store(false, std::memory_order_release);
+    }
+}
+
+
+void AudioEngine::OnPeriod(uint8_t half)
+{
+    if (half != mNextHalf)
+    {
+        // a whole period was missed, both directions repeat a half
+        mXruns.fetch_add(1U, std::memory_order_relaxed);
+    }
+    mNextHalf = half ^ 1U;
+
+    const uint32_t samples = mConfig.PeriodSamples();
+    const int32_t* pRx = mConfig.pRx + (static_cast<size_t>(half) * samples);
+    for (uint32_t i = 0U; i < samples; i++)
+    {
+        // the 24 bit sample is right aligned, the upper byte is undefined
+        const auto word = static_cast<uint32_t>(pRx[i]);
+        mCapture[i] = static_cast<float>(static_cast<int32_t>(word << 8U) >> 8) / FULL_SCALE;
+    }
+
+    const std::span<float> playback(mPlayback.data(), samples);
+    mMixer.Mix(playback, mConfig.channels);
+    if (mpProcessor != nullptr)
+    {
+        mpProcessor->Process({mCapture.data(), samples}, playback, mConfig.channels);
+    }
+
+    int32_t* pTx = mConfig.pTx + (static_cast<size_t>(half) * samples);
+    for (uint32_t i = 0U; i < samples; i++)
+    {
+        pTx[i] = static_cast<int32_t>(std::lrint(std::clamp(playback[i] * FULL_SCALE, -FULL_SCALE, MAX_SAMPLE)));
+    }
+    mPeriods.fetch_add(1U, std::memory_order_release);
+}
+
+
+void AudioEngine::OnError(Status status)
+{
+    mXruns.fetch_add(1U, std::memory_order_relaxed);
+    if (status != Status::OVERRUN)
+    {
+        // the port has stopped
+        mRunning.store(false, std::memory_order_release);
+    }
+}
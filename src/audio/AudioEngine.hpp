@@ -0,0 +1,148 @@
+/**
+ ********************************************************************************
+ * @file        AudioEngine.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, full duplex low latency audio engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "AudioMixer.hpp"
+#include "ISaiPort.hpp"
+#include <array>
+#include <atomic>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides a full duplex stream with a period processor and a source mixer.
+ * @details The port runs both directions through ping-pong rings of two periods. When the receiver has
+ *          filled half h the engine runs the period in the interrupt:
+ *          1. the received slots are sign extended and scaled to full scale one (capture)
+ *          2. the mixer sums its sources into the playback period
+ *          3. the processor (if set) reads the capture and modifies the playback in place
+ *          4. the playback is rounded, saturated to 24 bit and written into transmit half h.
+ *
+ *          The transmitter sends half h again after the other half, so a received frame leaves the port
+ *          two periods later (@ref GetLatencyFrames, periods of 32 frames at 48 kHz give 1.33 ms). A period which
+ *          arrives out of turn (the interrupt was late for a whole period) and an overrun or underrun of the
+ *          port are counted as xrun.
+ * @note    The period must finish within one period time. @ref Start, @ref Stop, @ref SetProcessor and the
+ *          sources of the mixer belong to the control thread while the engine is stopped.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe for one control thread and the port interrupt.
+ *
+ */
+class AudioEngine : private ISaiPort::IListener
+{
+    public:
+
+        /// @brief Processing of a period.
+        class IProcessor
+        {
+            public:
+                /**
+                 * @brief Process a period, called from the interrupt context.
+                 * @param capture   The received frames.
+                 * @param playback  The mixed frames, modified in place.
+                 * @param channels  Samples per frame.
+                 */
+                virtual void Process(std::span<const float> capture, std::span<float> playback, uint8_t channels) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IProcessor() = default;
+        };
+
+        /**
+         * @brief   Constructs the engine on a port.
+         *
+         * @param   port    The full duplex port.
+         */
+        explicit AudioEngine(ISaiPort& port);
+
+        /// @brief Destructor, stops the stream.
+        ~AudioEngine();
+
+        AudioEngine(AudioEngine const &) = delete;             //!< Copy constructor
+        AudioEngine& operator=(AudioEngine const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Clear the transmit ring and start the stream, the counters restart.
+         *
+         * @param   config  The stream, the rings must outlive it.
+         *
+         * @return  OK, BUSY, INVALID_PARAM or the error of the port.
+         */
+        Status Start(const StreamConfig& config);
+
+        /// @brief Stop the stream.
+        void Stop();
+
+        /// @brief Hold the stream, see ISaiPort::Pause.
+        Status Pause() {return mPort.Pause();};
+
+        /// @brief Continue the stream, see ISaiPort::Resume.
+        Status Resume() {return mPort.Resume();};
+
+        /// @brief Set the period processor, nullptr for none.
+        void SetProcessor(IProcessor* pProcessor) {mpProcessor = pProcessor;};
+
+        /// @brief The mixer of the playback.
+        AudioMixer& GetMixer() {return mMixer;};
+
+        /// @brief The stream runs.
+        bool IsRunning() const {return mRunning.load(std::memory_order_acquire);};
+
+        /// @brief Periods processed since the start.
+        uint32_t GetPeriods() const {return mPeriods.load(std::memory_order_acquire);};
+
+        /// @brief Late periods, overruns and underruns since the start.
+        uint32_t GetXruns() const {return mXruns.load(std::memory_order_acquire);};
+
+        /// @brief Frames from the receiver to the transmitter.
+        uint32_t GetLatencyFrames() const {return 2U * mConfig.periodFrames;};
+
+    private:
+
+        /// @copydoc ISaiPort::IListener::OnPeriod
+        void OnPeriod(uint8_t half) override;
+
+        /// @copydoc ISaiPort::IListener::OnError
+        void OnError(Status status) override;
+
+        /// @brief The full duplex port.
+        ISaiPort& mPort;
+
+        /// @brief The running configuration.
+        StreamConfig mConfig{0U, 0U, 0U, nullptr, nullptr};
+
+        /// @brief The source mixer.
+        AudioMixer mMixer{};
+
+        /// @brief The period processor.
+        IProcessor* mpProcessor{nullptr};
+
+        /// @brief The next expected half.
+        uint8_t mNextHalf{0U};
+
+        /// @brief Received period.
+        alignas(32) std::array<float, MAX_PERIOD_FRAMES * MAX_CHANNELS> mCapture{};
+
+        /// @brief Period to transmit.
+        alignas(32) std::array<float, MAX_PERIOD_FRAMES * MAX_CHANNELS> mPlayback{};
+
+        std::atomic<bool> mRunning{false};      //!< The stream runs
+        std::atomic<uint32_t> mPeriods{0U};     //!< Processed periods, written by the interrupt
+        std::atomic<uint32_t> mXruns{0U};       //!< Xruns, written by the interrupt
+};
+
+} // end namespace Audio
@@ -0,0 +1,107 @@
+/**
+ ********************************************************************************
+ * @file        AudioMixer.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, mixer implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AudioMixer.hpp"
+#include <algorithm>
+
+using namespace Audio;
+
+
+Status AudioMixer::AddSource(IAudioSource& source, float gain, uint8_t& index)
+{
+    for (uint8_t i = 0U; i < MAX_SOURCES; i++)
+    {
+        if (mSlots[i].pSource == nullptr)
+        {
+            mSlots[i].gain.store(gain, std::memory_order_relaxed);
+            mSlots[i].underruns.store(0U, std::memory_order_relaxed);
+            mSlots[i].pSource = &source;
+            index = i;
+            return Status::OK;
+        }
+    }
+    return Status::INVALID_PARAM;
+}
+
+
+void AudioMixer::RemoveSource(uint8_t index)
+{
+    if (index < MAX_SOURCES)
+    {
+        mSlots[index].pSource = nullptr;
+    }
+}
+
+
+void AudioMixer::SetGain(uint8_t index, float gain)
+{
+    if (index < MAX_SOURCES)
+    {
+        mSlots[index].gain.store(gain, std::memory_order_relaxed);
+    }
+}
+
+
+uint32_t AudioMixer::GetUnderruns(uint8_t index) const
+{
+    return (index < MAX_SOURCES) ? mSlots[index].underruns.load(std::memory_order_relaxed) : 0U;
+}
+
+
+void AudioMixer::Mix(std::span<float> bus, uint8_t channels)
+{
+    const size_t samples = std::min(bus.size(), mScratch.size());
+    bool first = true;
+    for (Slot& slot : mSlots)
+    {
+        if (slot.pSource == nullptr)
+        {
+            continue;
+        }
+        const float gain = slot.gain.load(std::memory_order_relaxed);
+        if (first)
+        {
+            // the first source writes the bus
+            Read(slot, bus.first(samples), channels);
+            for (size_t i = 0U; i < samples; i++)
+            {
+                bus[i] *= gain;
+            }
+            first = false;
+        }
+        else
+        {
+            Read(slot, {mScratch.data(), samples}, channels);
+            for (size_t i = 0U; i < samples; i++)
+            {
+                bus[i] += gain * mScratch[i];
+            }
+        }
+    }
+    if (first)
+    {
+        std::fill(bus.begin(), bus.end(), 0.0F);
+    }
+}
+
+
+void AudioMixer::Read(Slot& slot, std::span<float> frames, uint8_t channels)
+{
+    const uint32_t requested = static_cast<uint32_t>(frames.size() / channels);
+    const uint32_t delivered = std::min(slot.pSource->Read(frames, channels), requested);
+    if (delivered < requested)
+    {
+        std::fill(frames.begin() + (static_cast<ptrdiff_t>(delivered) * channels), frames.end(), 0.0F);
+        slot.underruns.fetch_add(1U, std::memory_order_relaxed);
+    }
+}
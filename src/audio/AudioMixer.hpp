@@ -0,0 +1,98 @@
+/**
+ ********************************************************************************
+ * @file        AudioMixer.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, in-place mixer of the audio sources.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IAudioSource.hpp"
+#include <array>
+#include <atomic>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the sum of up to @ref MAX_SOURCES sources with a gain each.
+ * @details @ref Mix lets the first source write straight into the bus and scales it in place, every further
+ *          source is read into one scratch period and accumulated into the bus, so the mix needs no buffer per
+ *          source. A source which delivers less than the period is filled up with silence and counted as
+ *          underrun. The bus is not limited, the conversion to the slots saturates.
+ * @note    @ref AddSource and @ref RemoveSource only while the engine is stopped, the gains may change any
+ *          time.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe for @ref SetGain and the counters, else not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class AudioMixer
+{
+    public:
+
+        /// @brief Maximum sources.
+        static constexpr uint8_t MAX_SOURCES{8U};
+
+        /// @brief Constructor.
+        AudioMixer() = default;
+
+        AudioMixer(AudioMixer const &) = delete;             //!< Copy constructor
+        AudioMixer& operator=(AudioMixer const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Add a source.
+         *
+         * @param   source  The source, must outlive the mixer or be removed.
+         * @param   gain    Linear gain.
+         * @param   index   Receives the index of the source.
+         *
+         * @return  OK or INVALID_PARAM (no free slot).
+         */
+        Status AddSource(IAudioSource& source, float gain, uint8_t& index);
+
+        /// @brief Remove the source of an index.
+        void RemoveSource(uint8_t index);
+
+        /// @brief Set the linear gain of a source.
+        void SetGain(uint8_t index, float gain);
+
+        /**
+         * @brief   Mix the sources into the bus.
+         *
+         * @param   bus         The period, up to @ref MAX_PERIOD_FRAMES frames, overwritten.
+         * @param   channels    Samples per frame.
+         */
+        void Mix(std::span<float> bus, uint8_t channels);
+
+        /// @brief Underruns of a source since it was added.
+        uint32_t GetUnderruns(uint8_t index) const;
+
+    private:
+
+        /// @brief A mixer slot.
+        struct Slot
+        {
+            IAudioSource* pSource{nullptr};         //!< The source, nullptr if free
+            std::atomic<float> gain{0.0F};          //!< Linear gain
+            std::atomic<uint32_t> underruns{0U};    //!< Short periods
+        };
+
+        /// @brief Read a source and fill up a short period.
+        void Read(Slot& slot, std::span<float> frames, uint8_t channels);
+
+        /// @brief The sources.
+        std::array<Slot, MAX_SOURCES> mSlots{};
+
+        /// @brief Period of a further source.
+        alignas(32) std::array<float, MAX_PERIOD_FRAMES * MAX_CHANNELS> mScratch{};
+};
+
+} // end namespace Audio
@@ -0,0 +1,180 @@
+/**
+ ********************************************************************************
+ * @file        AudioTypes.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, types of the microphone front end and the audio streams.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+namespace Audio {
+
+
+/// @brief Result of an audio operation or event.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The stream runs
+    INVALID_PARAM=2,  //!< Parameter or configuration is inconsistent
+    HW_ERROR=3,       //!< The peripheral or its DMA failed, the stream stopped
+    OVERRUN=4         //!< Conversions were lost, the stream continues
+};
+
+/// @brief Sample format of the PCM blocks.
+enum class PcmFormat : uint8_t
+{
+    PCM16=0,    //!< int16_t, full scale +-32767
+    PCM24=1     //!< int32_t right aligned, full scale +-8388607
+};
+
+/// @brief Maximum microphones, the filters of the DFSDM of the STM32H7Ax/H7Bx.
+constexpr uint32_t MAX_CHANNELS{8U};
+
+/// @brief Maximum blocks of the rings.
+constexpr uint32_t MAX_BLOCKS{32U};
+
+/// @brief Maximum frames of a block.
+constexpr uint32_t MAX_BLOCK_FRAMES{512U};
+
+/// @brief Maximum frames of a period of the audio engine.
+constexpr uint32_t MAX_PERIOD_FRAMES{256U};
+
+/// @brief Maximum words of a DMA ring, the limit of the DMA counter.
+constexpr uint32_t MAX_RING_WORDS{65535U};
+
+/// @brief Largest value of the 24 bit data register.
+constexpr int32_t MAX_RAW{0x7FFFFF};
+
+/**
+ * @brief Settings of the sinc filter of a DFSDM filter and the shift of its channel.
+ * @details The filter output is Sinc^order decimated by the oversampling ratio, the integrator sums
+ *          integrator outputs. The full scale of a PDM stream is oversampling^order * integrator, shifted
+ *          right by rightShift (rounded) it must fit the 24 bit data register.
+ */
+struct SincConfig
+{
+    uint8_t order;          //!< Sinc order 1 .. 5 (FastSinc is not supported)
+    uint16_t oversampling;  //!< Filter oversampling ratio 1 .. 1024
+    uint16_t integrator;    //!< Integrator oversampling ratio 1 .. 256
+    uint8_t rightShift;     //!< Data right shift of the channel 0 .. 31
+
+    /// @brief Full scale of the data register for a PDM stream of ones.
+    double FullScale() const
+    {
+        double scale = integrator;
+        for (uint8_t i = 0U; i < order; i++)
+        {
+            scale *= oversampling;
+        }
+        for (uint8_t i = 0U; i < rightShift; i++)
+        {
+            scale *= 0.5;
+        }
+        return scale;
+    }
+
+    /// @brief Parameters in range and the full scale fits the data register.
+    bool IsValid() const
+    {
+        return (order >= 1U) && (order <= 5U) && (oversampling >= 1U) && (oversampling <= 1024U)
+            && (integrator >= 1U) && (integrator <= 256U) && (rightShift <= 31U)
+            && (FullScale() <= (MAX_RAW + 0.5));
+    }
+};
+
+/**
+ * @brief Configuration of a microphone stream.
+ * @details Every channel has a DMA ring of @ref blocks blocks of @ref blockFrames data register words in
+ *          pRaw (channel c starts at c * RingWords()). The PCM ring in pPcm holds the same number of blocks
+ *          with the frames of all channels interleaved.
+ */
+struct PdmConfig
+{
+    uint8_t channels;               //!< Microphones 1 .. @ref MAX_CHANNELS, one DFSDM filter each
+    SincConfig sinc;                //!< The hardware decimation
+    uint32_t pdmClock;              //!< Bit clock of the microphones in Hz
+    uint8_t compensationTaps;       //!< Taps of the sinc droop compensation, odd 3 .. 63, 0 off
+    float highPassHz;               //!< Cut off of the high pass (2nd order Butterworth), 0 off
+    PcmFormat format;               //!< The PCM format
+    int32_t* pRaw;                  //!< DMA rings, 32 byte aligned, in a DMA accessible RAM
+    void* pPcm;                     //!< PCM ring, int16_t or int32_t aligned
+    uint16_t blockFrames;           //!< Frames per block, a multiple of 8, up to @ref MAX_BLOCK_FRAMES
+    uint8_t blocks;                 //!< Blocks of the rings, even, 2 .. @ref MAX_BLOCKS
+
+    /// @brief The PCM rate in Hz.
+    uint32_t OutputRate() const {return pdmClock / (static_cast<uint32_t>(sinc.oversampling) * sinc.integrator);};
+
+    /// @brief The words of the DMA ring of a channel.
+    uint32_t RingWords() const {return static_cast<uint32_t>(blockFrames) * blocks;};
+
+    /// @brief The samples of a PCM block.
+    uint32_t BlockSamples() const {return static_cast<uint32_t>(blockFrames) * channels;};
+
+    /// @brief Parameters in range.
+    bool IsValid() const
+    {
+        return (channels >= 1U) && (channels <= MAX_CHANNELS) && sinc.IsValid() && (OutputRate() > 0U)
+            && ((compensationTaps == 0U) || ((compensationTaps >= 3U) && (compensationTaps <= 63U)
+                                             && ((compensationTaps % 2U) == 1U)))
+            && (highPassHz >= 0.0F) && ((2.0F * highPassHz) < static_cast<float>(OutputRate()))
+            && (format <= PcmFormat::PCM24) && (pRaw != nullptr) && (pPcm != nullptr)
+            && (blockFrames > 0U) && ((blockFrames % 8U) == 0U) && (blockFrames <= MAX_BLOCK_FRAMES)
+            && (blocks >= 2U) && (blocks <= MAX_BLOCKS) && ((blocks % 2U) == 0U) && (RingWords() <= MAX_RING_WORDS);
+    }
+};
+
+/**
+ * @brief A block of PCM frames in the PCM ring.
+ * @details The samples of the frames are interleaved, channel 0 first. The span of the configured format
+ *          holds the samples, the other one is empty.
+ */
+struct PcmBlock
+{
+    std::span<const int16_t> pcm16;     //!< Samples in PCM16, valid until the ring slot is rewritten
+    std::span<const int32_t> pcm24;     //!< Samples in PCM24, valid until the ring slot is rewritten
+    uint32_t sequence;                  //!< Running number since the start
+};
+
+/**
+ * @brief Configuration of a full duplex stream.
+ * @details The transmit and the receive ring hold two periods (ping-pong) of 32 bit slots with the 24 bit
+ *          samples right aligned, the frames interleaved, channel 0 first.
+ */
+struct StreamConfig
+{
+    uint32_t sampleRate;    //!< Frame rate in Hz
+    uint8_t channels;       //!< Slots per frame 1 .. @ref MAX_CHANNELS
+    uint16_t periodFrames;  //!< Frames per period, a multiple of 8, up to @ref MAX_PERIOD_FRAMES
+    int32_t* pTx;           //!< Transmit ring, 32 byte aligned, in a DMA accessible RAM
+    int32_t* pRx;           //!< Receive ring, 32 byte aligned, in a DMA accessible RAM
+
+    /// @brief The words of a ring.
+    uint32_t RingWords() const {return 2U * PeriodSamples();};
+
+    /// @brief The samples of a period.
+    uint32_t PeriodSamples() const {return static_cast<uint32_t>(periodFrames) * channels;};
+
+    /// @brief Parameters in range.
+    bool IsValid() const
+    {
+        return (sampleRate > 0U) && (channels >= 1U) && (channels <= MAX_CHANNELS) && (periodFrames > 0U)
+            && ((periodFrames % 8U) == 0U) && (periodFrames <= MAX_PERIOD_FRAMES) && (pTx != nullptr)
+            && (pRx != nullptr);
+    }
+};
+
+/// @brief The 24 bit result of a data register word (channel number in the low bits).
+inline int32_t RawValue(int32_t word)
+{
+    return word >> 8;
+}
+
+} // end namespace Audio
@@ -0,0 +1,58 @@
+/**
+ ********************************************************************************
+ * @file        IAudioSource.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, interface of a source of the mixer.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "AudioTypes.hpp"
+#include <span>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides frames to the mixer in the period of the audio engine.
+ * @details The frames are interleaved float samples with full scale one, the channel count of the stream.
+ *  - - -
+ *
+ * __Thread safety:__
+ * @ref Read is called from the interrupt context of the audio engine.
+ *
+ */
+class IAudioSource
+{
+    public:
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IAudioSource() = default;
+
+        /**
+         * @brief Write the next frames.
+         * @param frames    Receives the frames, a whole number of frames.
+         * @param channels  Samples per frame.
+         * @return Frames written, less than requested is an underrun.
+         */
+        virtual uint32_t Read(std::span<float> frames, uint8_t channels) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IAudioSource() = default;
+
+        IAudioSource(IAudioSource const &) = default;             //!< Copy constructor
+        IAudioSource(IAudioSource &&) = default;                  //!< Move constructor
+
+        IAudioSource& operator=(IAudioSource const &) = default;  //!< Copy assignment
+        IAudioSource& operator=(IAudioSource &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Audio
@@ -0,0 +1,92 @@
+/**
+ ********************************************************************************
+ * @file        IPdmFrontEnd.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, interface of the sigma-delta filters of the microphones.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "AudioTypes.hpp"
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the hardware decimation of PDM microphones (hardware or simulation).
+ * @details @ref Start runs one sinc filter per microphone, all started by the same trigger, and streams the
+ *          data register words of every filter through its own circular buffer. A half is reported when it
+ *          is filled in the buffers of all channels.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one PdmPipeline.
+ *
+ */
+class IPdmFrontEnd
+{
+    public:
+
+        /// @brief Receiver of the conversion events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A half of the buffers is filled, called from the interrupt context.
+                 * @param half      0 for the first, 1 for the second half.
+                 */
+                virtual void OnHalfFilled(uint8_t half) = 0;
+
+                /**
+                 * @brief Conversions were lost or the transfer failed, called from the interrupt context.
+                 * @param status    OVERRUN or HW_ERROR (the transfer stopped).
+                 */
+                virtual void OnError(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IPdmFrontEnd() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start the continuous conversions of the channels.
+         * @param sinc          The filter settings.
+         * @param channels      Number of channels.
+         * @param pBuffer       The buffers, channel c starts at c * words.
+         * @param words         Words of the buffer of a channel, even.
+         * @return OK, BUSY, INVALID_PARAM (more channels than filters), HW_ERROR.
+         */
+        virtual Status Start(const SincConfig& sinc, uint8_t channels, int32_t* pBuffer, uint32_t words) = 0;
+
+        /// @brief Stop the conversions.
+        virtual void Stop() = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IPdmFrontEnd() = default;
+
+        IPdmFrontEnd(IPdmFrontEnd const &) = default;             //!< Copy constructor
+        IPdmFrontEnd(IPdmFrontEnd &&) = default;                  //!< Move constructor
+
+        IPdmFrontEnd& operator=(IPdmFrontEnd const &) = default;  //!< Copy assignment
+        IPdmFrontEnd& operator=(IPdmFrontEnd &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Audio
@@ -0,0 +1,101 @@
+/**
+ ********************************************************************************
+ * @file        ISaiPort.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, interface of a full duplex serial audio port.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "AudioTypes.hpp"
+namespace Audio {
+
+
+/**
+ * @brief   This class provides a full duplex audio port with ping-pong DMA (hardware or host device).
+ * @details @ref Start runs the receiver and the transmitter on the same frame clock, each through a circular
+ *          ring of two periods. When the receiver has filled a half the transmitter has just sent the same
+ *          half of its ring, the port reports the half and the listener exchanges both.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one AudioEngine.
+ *
+ */
+class ISaiPort
+{
+    public:
+
+        /// @brief Receiver of the period events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A period is received and may be transmitted next, called from the interrupt context.
+                 * @param half      0 for the first, 1 for the second half of the rings.
+                 */
+                virtual void OnPeriod(uint8_t half) = 0;
+
+                /**
+                 * @brief Samples were lost or the transfer failed, called from the interrupt context.
+                 * @param status    OVERRUN (overrun or underrun of the port) or HW_ERROR (the stream stopped).
+                 */
+                virtual void OnError(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~ISaiPort() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start receiver and transmitter.
+         * @param config    The stream, the transmit ring holds the first two periods.
+         * @return OK, BUSY, INVALID_PARAM (rate or slots not supported), HW_ERROR.
+         */
+        virtual Status Start(const StreamConfig& config) = 0;
+
+        /// @brief Stop receiver and transmitter.
+        virtual void Stop() = 0;
+
+        /**
+         * @brief Hold the DMA of both directions, the frame clock continues.
+         * @return OK or HW_ERROR.
+         */
+        virtual Status Pause() = 0;
+
+        /**
+         * @brief Continue the DMA of both directions.
+         * @return OK or HW_ERROR.
+         */
+        virtual Status Resume() = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        ISaiPort() = default;
+
+        ISaiPort(ISaiPort const &) = default;             //!< Copy constructor
+        ISaiPort(ISaiPort &&) = default;                  //!< Move constructor
+
+        ISaiPort& operator=(ISaiPort const &) = default;  //!< Copy assignment
+        ISaiPort& operator=(ISaiPort &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Audio
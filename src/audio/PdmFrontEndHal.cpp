@@ -0,0 +1,259 @@
+/**
+ ********************************************************************************
+ * @file        PdmFrontEndHal.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, DFSDM front end implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "PdmFrontEndHal.hpp"
+#include "DCache.hpp"
+#include <algorithm>
+
+using namespace Audio;
+
+PdmFrontEndHal* PdmFrontEndHal::spInstance = nullptr;
+
+namespace {
+
+/// @brief FORD of the sinc orders 1 .. 5.
+constexpr std::array<uint32_t, 5U> SINC_ORDERS{DFSDM_FILTER_SINC1_ORDER, DFSDM_FILTER_SINC2_ORDER,
+                                               DFSDM_FILTER_SINC3_ORDER, DFSDM_FILTER_SINC4_ORDER,
+                                               DFSDM_FILTER_SINC5_ORDER};
+
+} // end anonymous namespace
+
+
+PdmFrontEndHal::PdmFrontEndHal(std::span<const Microphone> microphones)
+{
+    for (const Microphone& microphone : microphones.first(std::min<size_t>(microphones.size(), FILTERS)))
+    {
+        mMicrophones[mCount] = microphone;
+        mCount++;
+    }
+    spInstance = this;
+}
+
+
+PdmFrontEndHal::~PdmFrontEndHal()
+{
+    Stop();
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+PdmFrontEndHal* PdmFrontEndHal::GetInstance(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter)
+{
+    if ((spInstance != nullptr) && (spInstance->IndexOf(hdfsdm_filter) < FILTERS))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status PdmFrontEndHal::Start(const SincConfig& sinc, uint8_t channels, int32_t* pBuffer, uint32_t words)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if (!sinc.IsValid() || (channels == 0U) || (channels > mCount) || (pBuffer == nullptr) || (words < 2U)
+        || ((words % 2U) != 0U) || (mMicrophones[0].pFilter->Instance != DFSDM1_Filter0))
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (uint8_t i = 0U; i < channels; i++)
+    {
+        const Status status = Configure(i, sinc);
+        if (status != Status::OK)
+        {
+            return status;
+        }
+    }
+
+    // no dirty line may be evicted into the buffers while the DMA writes them
+    Utils::DCache::Invalidate(pBuffer, channels * words * sizeof(int32_t));
+    mpBuffer = pBuffer;
+    mWords = words;
+    mChannels = channels;
+    mFilled = {0U, 0U};
+    mRunning = true;
+    // the synchronous filters wait for the software start of filter 0
+    HAL_StatusTypeDef result = HAL_OK;
+    for (uint8_t i = channels; (i-- > 0U) && (result == HAL_OK);)
+    {
+        DFSDM_Filter_HandleTypeDef* hfilter = mMicrophones[i].pFilter;
+        result = HAL_DFSDM_FilterRegularStart_DMA(hfilter, &pBuffer[i * words], words);
+        // the regular overrun interrupt is not part of the DMA start
+        SET_BIT(hfilter->Instance->FLTCR2, DFSDM_FLTCR2_ROVRIE);
+    }
+    if (result != HAL_OK)
+    {
+        Stop();
+    }
+    return ToStatus(result);
+}
+
+
+void PdmFrontEndHal::Stop()
+{
+    if (mRunning)
+    {
+        // filter 0 first, the others stop at the same frame
+        for (uint8_t i = 0U; i < mChannels; i++)
+        {
+            DFSDM_Filter_HandleTypeDef* hfilter = mMicrophones[i].pFilter;
+            CLEAR_BIT(hfilter->Instance->FLTCR2, DFSDM_FLTCR2_ROVRIE);
+            (void)HAL_DFSDM_FilterRegularStop_DMA(hfilter);
+        }
+        mRunning = false;
+    }
+}
+
+
+void PdmFrontEndHal::OnHalf(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter, uint8_t half)
+{
+    const uint8_t index = IndexOf(hdfsdm_filter);
+    if (!mRunning || (index >= mChannels))
+    {
+        return;
+    }
+    const uint32_t halfWords = mWords / 2U;
+    Utils::DCache::Invalidate(&mpBuffer[(index * mWords) + (half * halfWords)], halfWords * sizeof(int32_t));
+    // the filters run in step, the last one of a half completes it
+    mFilled[half] |= static_cast<uint8_t>(1U << index);
+    if (mFilled[half] == static_cast<uint8_t>((1U << mChannels) - 1U))
+    {
+        mFilled[half] = 0U;
+        if (mpListener != nullptr)
+        {
+            mpListener->OnHalfFilled(half);
+        }
+    }
+}
+
+
+void PdmFrontEndHal::OnError(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter)
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    if (HAL_DFSDM_FilterGetError(hdfsdm_filter) == DFSDM_FILTER_ERROR_REGULAR_OVERRUN)
+    {
+        if (mpListener != nullptr)
+        {
+            mpListener->OnError(Status::OVERRUN);
+        }
+        return;
+    }
+    Stop();
+    if (mpListener != nullptr)
+    {
+        mpListener->OnError(Status::HW_ERROR);
+    }
+}
+
+
+Status PdmFrontEndHal::Configure(uint8_t index, const SincConfig& sinc)
+{
+    // the shift can only change while the channel is disabled
+    DFSDM_Channel_HandleTypeDef* hchannel = mMicrophones[index].pChannel;
+    HAL_StatusTypeDef result = HAL_OK;
+    if (hchannel->Init.RightBitShift != sinc.rightShift)
+    {
+        hchannel->Init.RightBitShift = sinc.rightShift;
+        result = HAL_DFSDM_ChannelDeInit(hchannel);
+        if (result == HAL_OK)
+        {
+            result = HAL_DFSDM_ChannelInit(hchannel);
+        }
+    }
+
+    DFSDM_Filter_HandleTypeDef* hfilter = mMicrophones[index].pFilter;
+    hfilter->Init.RegularParam.Trigger = (index == 0U) ? DFSDM_FILTER_SW_TRIGGER : DFSDM_FILTER_SYNC_TRIGGER;
+    hfilter->Init.RegularParam.FastMode = ENABLE;
+    hfilter->Init.RegularParam.DmaMode = ENABLE;
+    hfilter->Init.FilterParam.SincOrder = SINC_ORDERS[sinc.order - 1U];
+    hfilter->Init.FilterParam.Oversampling = sinc.oversampling;
+    hfilter->Init.FilterParam.IntOversampling = sinc.integrator;
+    if (result == HAL_OK)
+    {
+        result = HAL_DFSDM_FilterDeInit(hfilter);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_DFSDM_FilterInit(hfilter);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_DFSDM_FilterConfigRegChannel(hfilter, mMicrophones[index].channel, DFSDM_CONTINUOUS_CONV_ON);
+    }
+    return ToStatus(result);
+}
+
+
+uint8_t PdmFrontEndHal::IndexOf(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter) const
+{
+    for (uint8_t i = 0U; i < mCount; i++)
+    {
+        if (mMicrophones[i].pFilter == hdfsdm_filter)
+        {
+            return i;
+        }
+    }
+    return FILTERS;
+}
+
+
+Status PdmFrontEndHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_DFSDM_FilterRegConvHalfCpltCallback(DFSDM_Filter_HandleTypeDef* hdfsdm_filter)
+{
+    PdmFrontEndHal* pFrontEnd = PdmFrontEndHal::GetInstance(hdfsdm_filter);
+    if (pFrontEnd != nullptr)
+    {
+        pFrontEnd->OnHalf(hdfsdm_filter, 0U);
+    }
+}
+
+
+extern "C" void HAL_DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef* hdfsdm_filter)
+{
+    PdmFrontEndHal* pFrontEnd = PdmFrontEndHal::GetInstance(hdfsdm_filter);
+    if (pFrontEnd != nullptr)
+    {
+        pFrontEnd->OnHalf(hdfsdm_filter, 1U);
+    }
+}
+
+
+extern "C" void HAL_DFSDM_FilterErrorCallback(DFSDM_Filter_HandleTypeDef* hdfsdm_filter)
+{
+    PdmFrontEndHal* pFrontEnd = PdmFrontEndHal::GetInstance(hdfsdm_filter);
+    if (pFrontEnd != nullptr)
+    {
+        pFrontEnd->OnError(hdfsdm_filter);
+    }
+}
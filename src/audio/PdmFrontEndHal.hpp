@@ -0,0 +1,134 @@
+/**
+ ********************************************************************************
+ * @file        PdmFrontEndHal.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, PDM microphones on the DFSDM.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IPdmFrontEnd.hpp"
+#include "stm32h7xx_hal.h"
+#include <array>
+#include <span>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the IPdmFrontEnd on the DFSDM1 of the STM32H7, one filter per microphone.
+ * @details @ref Start sets the data right shift of every channel (HAL_DFSDM_ChannelInit), initialises every
+ *          filter with the sinc order, the oversampling ratios, fast mode and regular DMA
+ *          (HAL_DFSDM_FilterInit) and selects its channel for continuous conversions
+ *          (HAL_DFSDM_FilterConfigRegChannel). Filter 0 is started by software, the others by the
+ *          synchronous trigger (RSYNC), so all filters start with the same bit and stay in step. Each one
+ *          streams by HAL_DFSDM_FilterRegularStart_DMA into its circular buffer.\n
+ *          The half and full transfer callbacks invalidate the D-Cache lines of the filled half of the
+ *          channel, a half is reported when all channels have filled it. A regular overrun is reported as
+ *          OVERRUN (the DMA continues), a DMA error stops all filters and is reported as HW_ERROR.
+ * @note    The STM32H743 has 4 filters, the STM32H7Ax/H7Bx 8, a microphone pair on one data line uses two
+ *          channels (rising and falling edge) and two filters. The first microphone must use
+ *          DFSDM1_Filter0.\n
+ *          The application initialises the channel handles (SPI input, clock output, the edge), the filter
+ *          handles with their circular DMA (HAL_DFSDM_FilterMspInit) and calls HAL_DFSDM_IRQHandler and the
+ *          DMA handlers. The buffers must be located in a DMA accessible RAM (not DTCM) and 32 byte aligned.
+ *          One instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one PdmPipeline.
+ *
+ */
+class PdmFrontEndHal : public IPdmFrontEnd
+{
+    public:
+
+#if defined(DFSDM1_Filter7)
+        /// @brief Filters of the DFSDM1.
+        static constexpr uint8_t FILTERS{8U};
+#else
+        /// @brief Filters of the DFSDM1.
+        static constexpr uint8_t FILTERS{4U};
+#endif
+
+        /// @brief The peripherals of a microphone.
+        struct Microphone
+        {
+            DFSDM_Filter_HandleTypeDef* pFilter;    //!< The filter
+            DFSDM_Channel_HandleTypeDef* pChannel;  //!< The channel
+            uint32_t channel;                       //!< DFSDM_CHANNEL_x of the channel
+        };
+
+        /**
+         * @brief   Constructs the front end for initialised handles.
+         *
+         * @param   microphones     The microphones, at most @ref FILTERS.
+         */
+        explicit PdmFrontEndHal(std::span<const Microphone> microphones);
+
+        /// @brief Destructor.
+        ~PdmFrontEndHal() override;
+
+        PdmFrontEndHal(PdmFrontEndHal const &) = delete;             //!< Copy constructor
+        PdmFrontEndHal& operator=(PdmFrontEndHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc IPdmFrontEnd::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IPdmFrontEnd::Start
+        Status Start(const SincConfig& sinc, uint8_t channels, int32_t* pBuffer, uint32_t words) override;
+
+        /// @copydoc IPdmFrontEnd::Stop
+        void Stop() override;
+
+        /**
+         * @brief   A half of a channel is filled, called by the conversion callbacks.
+         *
+         * @param   hdfsdm_filter   The filter.
+         * @param   half            0 for the first, 1 for the second half.
+         */
+        void OnHalf(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter, uint8_t half);
+
+        /// @brief Overrun or DMA error, called by HAL_DFSDM_FilterErrorCallback.
+        void OnError(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter);
+
+        /// @brief Front end which uses a filter handle or nullptr.
+        static PdmFrontEndHal* GetInstance(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter);
+
+    private:
+
+        /// @brief Initialise the channel and the filter of a microphone.
+        Status Configure(uint8_t index, const SincConfig& sinc);
+
+        /// @brief Index of the microphone of a filter or @ref FILTERS.
+        uint8_t IndexOf(const DFSDM_Filter_HandleTypeDef* hdfsdm_filter) const;
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The microphones.
+        std::array<Microphone, FILTERS> mMicrophones{};
+
+        /// @brief Number of microphones.
+        uint8_t mCount{0U};
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        int32_t* mpBuffer{nullptr};                 //!< The circular buffers
+        uint32_t mWords{0U};                        //!< Words of the buffer of a channel
+        uint8_t mChannels{0U};                      //!< Running channels
+        std::array<uint8_t, 2U> mFilled{};          //!< Channels which filled a half, one bit each
+        volatile bool mRunning{false};              //!< The conversions run
+
+        /// @brief The single front end instance, the device has one DFSDM1.
+        static PdmFrontEndHal* spInstance;
+};
+
+} // end namespace Audio
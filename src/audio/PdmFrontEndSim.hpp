@@ -0,0 +1,177 @@
+/**
+ ********************************************************************************
+ * @file        PdmFrontEndSim.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, simulated DFSDM filters with PDM microphones.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IPdmFrontEnd.hpp"
+#include "PdmModulator.hpp"
+#include "SincModel.hpp"
+#include <array>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the IPdmFrontEnd on the host with the bit exact filter model.
+ * @details The converter side (@ref Convert) runs the bit stream of every microphone through its SincModel,
+ *          writes the results as data register words (result in bits 31..8, channel in bits 2..0) into the
+ *          circular buffers and reports each filled half, the listener is called synchronously like the
+ *          interrupt. All channels convert the same frame, like filters started by one trigger.\n
+ *          @ref InjectOverrun and @ref InjectFault model the error interrupts.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * @ref Convert may run in another thread (the simulated interrupt context) while no Start or Stop is called.
+ *
+ */
+class PdmFrontEndSim : public IPdmFrontEnd
+{
+    public:
+
+        /// @brief Constructor, all microphones are silent.
+        PdmFrontEndSim() = default;
+
+        PdmFrontEndSim(PdmFrontEndSim const &) = delete;             //!< Copy constructor
+        PdmFrontEndSim& operator=(PdmFrontEndSim const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Set the input of a microphone.
+         *
+         * @param   channel     The channel, below @ref MAX_CHANNELS.
+         * @param   modulator   The bit stream.
+         */
+        void SetSignal(uint8_t channel, const PdmModulator& modulator)
+        {
+            if (channel < MAX_CHANNELS)
+            {
+                mModulators[channel] = modulator;
+            }
+        }
+
+        /**
+         * @brief   Converter side: convert frames.
+         *
+         * @param   frames  Maximum count of frames.
+         *
+         * @return  Count of converted frames, 0 if stopped.
+         */
+        size_t Convert(size_t frames)
+        {
+            size_t converted = 0U;
+            while (mRunning && (converted < frames))
+            {
+                for (uint8_t c = 0U; c < mChannels; c++)
+                {
+                    int32_t value = 0;
+                    bool complete = false;
+                    while (!complete)
+                    {
+                        complete = mFilters[c].Push(mModulators[c].Next(), value);
+                    }
+                    mpBuffer[(static_cast<size_t>(c) * mWords) + mPos] = static_cast<int32_t>(
+                        (static_cast<uint32_t>(value) << 8U) | c);
+                }
+                mPos++;
+                mFrames++;
+                converted++;
+                if ((mPos == (mWords / 2U)) || (mPos == mWords))
+                {
+                    const uint8_t filled = (mPos == mWords) ? 1U : 0U;
+                    mPos = (mPos == mWords) ? 0U : mPos;
+                    if (mpListener != nullptr)
+                    {
+                        mpListener->OnHalfFilled(filled);
+                    }
+                }
+            }
+            return converted;
+        }
+
+        /// @brief Report lost conversions, the stream continues.
+        void InjectOverrun()
+        {
+            if (mRunning && (mpListener != nullptr))
+            {
+                mpListener->OnError(Status::OVERRUN);
+            }
+        }
+
+        /// @brief Report a DMA error, the stream stops.
+        void InjectFault()
+        {
+            if (mRunning)
+            {
+                mRunning = false;
+                if (mpListener != nullptr)
+                {
+                    mpListener->OnError(Status::HW_ERROR);
+                }
+            }
+        }
+
+        /// @copydoc IPdmFrontEnd::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IPdmFrontEnd::Start
+        Status Start(const SincConfig& sinc, uint8_t channels, int32_t* pBuffer, uint32_t words) override
+        {
+            if (mRunning)
+            {
+                return Status::BUSY;
+            }
+            if (!sinc.IsValid() || (channels == 0U) || (channels > MAX_CHANNELS) || (pBuffer == nullptr)
+                || (words < 2U) || ((words % 2U) != 0U))
+            {
+                return Status::INVALID_PARAM;
+            }
+            for (SincModel& filter : mFilters)
+            {
+                filter = SincModel(sinc);
+            }
+            mChannels = channels;
+            mpBuffer = pBuffer;
+            mWords = words;
+            mPos = 0U;
+            mFrames = 0U;
+            mRunning = true;
+            return Status::OK;
+        }
+
+        /// @copydoc IPdmFrontEnd::Stop
+        void Stop() override {mRunning = false;};
+
+        /// @brief The conversions run.
+        bool IsRunning() const {return mRunning;};
+
+        /// @brief Channels of the last start.
+        uint8_t GetChannels() const {return mChannels;};
+
+        /// @brief Frames since the last start.
+        uint64_t GetFrames() const {return mFrames;};
+
+    private:
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        std::array<PdmModulator, MAX_CHANNELS> mModulators{};   //!< Bit streams of the microphones
+        std::array<SincModel, MAX_CHANNELS> mFilters{};         //!< Filters of the channels
+        uint8_t mChannels{0U};                                  //!< Converted channels
+        int32_t* mpBuffer{nullptr};                             //!< The circular buffers
+        uint32_t mWords{0U};                                    //!< Words of the buffer of a channel
+        uint32_t mPos{0U};                                      //!< Next word of the buffers
+        uint64_t mFrames{0U};                                   //!< Converted frames
+        bool mRunning{false};                                   //!< The conversions run
+};
+
+} // end namespace Audio
@@ -0,0 +1,75 @@
+/**
+ ********************************************************************************
+ * @file        PdmModulator.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, PDM test vectors of a synthetic microphone.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the bit stream of a PDM microphone for a synthetic input.
+ * @details The input offset + amplitude * sin(2 * pi * frequency * index) (full scale one, the frequency in
+ *          cycles per bit) runs through a second order sigma-delta modulator, every bit is +1 or -1. The
+ *          modulator is stable up to a magnitude of about 0.7.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class PdmModulator
+{
+    public:
+
+        /// @brief Constructs silence.
+        PdmModulator() = default;
+
+        /**
+         * @brief   Constructs a sine wave.
+         *
+         * @param   frequency   Cycles per bit.
+         * @param   amplitude   Amplitude, full scale one.
+         * @param   offset      Offset, full scale one.
+         */
+        PdmModulator(double frequency, double amplitude, double offset = 0.0)
+        : mFrequency(frequency), mAmplitude(amplitude), mOffset(offset) {};
+
+        /// @brief The next bit, +1 or -1.
+        int8_t Next()
+        {
+            constexpr double TWO_PI{6.28318530717958647692};
+            // the fraction of the cycle keeps the argument small for long runs
+            const double cycle = std::fmod(mFrequency * static_cast<double>(mIndex), 1.0);
+            const double input = mOffset + (mAmplitude * std::sin(TWO_PI * cycle));
+            mIndex++;
+
+            const double output = (mIntegrator2 >= 0.0) ? 1.0 : -1.0;
+            mIntegrator1 += input - output;
+            mIntegrator2 += mIntegrator1 - output;
+            return static_cast<int8_t>(output);
+        }
+
+    private:
+
+        double mFrequency{0.0};     //!< Cycles per bit
+        double mAmplitude{0.0};     //!< Amplitude
+        double mOffset{0.0};        //!< Offset
+        uint64_t mIndex{0U};        //!< Bits since the construction
+        double mIntegrator1{0.0};   //!< First integrator of the modulator
+        double mIntegrator2{0.0};   //!< Second integrator of the modulator
+};
+
+} // end namespace Audio
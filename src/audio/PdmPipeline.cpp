@@ -0,0 +1,241 @@
+/**
+ ********************************************************************************
+ * @file        PdmPipeline.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, PDM microphone pipeline implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "PdmPipeline.hpp"
+#include "SincCompensation.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Audio;
+
+namespace {
+
+/// @brief Full scale of PCM16.
+constexpr float FULL_SCALE_16{32767.0F};
+
+/// @brief Full scale of PCM24.
+constexpr float FULL_SCALE_24{8388607.0F};
+
+/// @brief A sample scaled, rounded and saturated.
+inline int32_t Quantize(float sample, float fullScale)
+{
+    return static_cast<int32_t>(std::lrint(std::clamp(sample * fullScale, -fullScale, fullScale)));
+}
+
+/// @brief Biquad of a 2nd order Butterworth high pass in the sign convention of BiquadCascade.
+std::array<float, Dsp::BiquadCascade::COEFFICIENTS> HighPass(double cutOff, double sampleRate)
+{
+    constexpr double PI{3.14159265358979323846};
+    const double omega = 2.0 * PI * cutOff / sampleRate;
+    const double cosine = std::cos(omega);
+    const double alpha = std::sin(omega) / std::sqrt(2.0);
+    const double a0 = 1.0 + alpha;
+    const double b0 = (1.0 + cosine) / (2.0 * a0);
+    return {static_cast<float>(b0), static_cast<float>(-2.0 * b0), static_cast<float>(b0),
+            static_cast<float>(2.0 * cosine / a0), static_cast<float>(-(1.0 - alpha) / a0)};
+}
+
+} // end anonymous namespace
+
+
+PdmPipeline::PdmPipeline(IPdmFrontEnd& frontEnd)
+: mFrontEnd(frontEnd)
+{
+    mFrontEnd.SetListener(this);
+}
+
+
+PdmPipeline::~PdmPipeline()
+{
+    Stop();
+    mFrontEnd.SetListener(nullptr);
+}
+
+
+Status PdmPipeline::Start(const PdmConfig& config)
+{
+    if (IsRunning())
+    {
+        return Status::BUSY;
+    }
+    if (!config.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    // the interrupt is idle, the filters, the counters and the queue belong to this thread now
+    mConfig = config;
+    mScale = static_cast<float>(1.0 / config.sinc.FullScale());
+    std::array<float, SincCompensation::MAX_TAPS> taps{};
+    if ((config.compensationTaps > 0U)
+        && (SincCompensation::Design(config.sinc, {taps.data(), config.compensationTaps}) != Status::OK))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const auto highPass = HighPass(config.highPassHz, config.OutputRate());
+    for (uint8_t c = 0U; c < config.channels; c++)
+    {
+        if (config.compensationTaps > 0U)
+        {
+            (void)mCompensation[c].Configure({taps.data(), config.compensationTaps});
+        }
+        if (config.highPassHz > 0.0F)
+        {
+            (void)mHighPass[c].Configure(highPass);
+        }
+    }
+    mQueue.Clear();
+    mProduced.store(0U, std::memory_order_relaxed);
+    mDropped.store(0U, std::memory_order_relaxed);
+    mOverruns.store(0U, std::memory_order_relaxed);
+    mOverwritten.store(0U, std::memory_order_relaxed);
+    mRunning.store(true, std::memory_order_release);
+    const Status status = mFrontEnd.Start(config.sinc, config.channels, config.pRaw, config.RingWords());
+    if (status != Status::OK)
+    {
+        mRunning.store(false, std::memory_order_release);
+    }
+    return status;
+}
+
+
+void PdmPipeline::Stop()
+{
+    if (IsRunning())
+    {
+        mFrontEnd.Stop();
+        mRunning.store(false, std::memory_order_release);
+    }
+}
+
+
+bool PdmPipeline::Receive(PcmBlock& block)
+{
+    while (mQueue.Pop(block))
+    {
+        if (!IsOverwritten(block.sequence))
+        {
+            return true;
+        }
+        mOverwritten.fetch_add(1U, std::memory_order_release);
+    }
+    return false;
+}
+
+
+bool PdmPipeline::Release(const PcmBlock& block)
+{
+    if (IsOverwritten(block.sequence))
+    {
+        mOverwritten.fetch_add(1U, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+
+void PdmPipeline::OnHalfFilled(uint8_t half)
+{
+    if (!IsRunning())
+    {
+        return;
+    }
+    const uint32_t halfBlocks = mConfig.blocks / 2U;
+    uint32_t produced = mProduced.load(std::memory_order_relaxed);
+    // the slot of the next sequence is the filled half unless the event of the other half was missed
+    if (((produced % mConfig.blocks) / halfBlocks) != half)
+    {
+        mDropped.fetch_add(halfBlocks, std::memory_order_release);
+        produced += halfBlocks;
+    }
+    for (uint32_t i = 0U; i < halfBlocks; i++)
+    {
+        ProcessBlock(produced + i);
+    }
+    mProduced.store(produced + halfBlocks, std::memory_order_release);
+}
+
+
+void PdmPipeline::OnError(Status status)
+{
+    if (status == Status::OVERRUN)
+    {
+        mOverruns.fetch_add(1U, std::memory_order_release);
+        return;
+    }
+    mRunning.store(false, std::memory_order_release);
+}
+
+
+void PdmPipeline::ProcessBlock(uint32_t sequence)
+{
+    const uint32_t slot = sequence % mConfig.blocks;
+    const uint32_t frames = mConfig.blockFrames;
+    const uint32_t channels = mConfig.channels;
+    const std::span<float> work(mWork.data(), frames);
+    int16_t* const pPcm16 = static_cast<int16_t*>(mConfig.pPcm) + (slot * mConfig.BlockSamples());
+    int32_t* const pPcm24 = static_cast<int32_t*>(mConfig.pPcm) + (slot * mConfig.BlockSamples());
+
+    for (uint32_t c = 0U; c < channels; c++)
+    {
+        const int32_t* const pRaw = &mConfig.pRaw[(c * mConfig.RingWords()) + (slot * frames)];
+        for (uint32_t i = 0U; i < frames; i++)
+        {
+            work[i] = static_cast<float>(RawValue(pRaw[i])) * mScale;
+        }
+        if (mConfig.compensationTaps > 0U)
+        {
+            (void)mCompensation[c].Process(work, work);
+        }
+        if (mConfig.highPassHz > 0.0F)
+        {
+            (void)mHighPass[c].Process(work, work);
+        }
+        if (mConfig.format == PcmFormat::PCM16)
+        {
+            for (uint32_t i = 0U; i < frames; i++)
+            {
+                pPcm16[(i * channels) + c] = static_cast<int16_t>(Quantize(work[i], FULL_SCALE_16));
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0U; i < frames; i++)
+            {
+                pPcm24[(i * channels) + c] = Quantize(work[i], FULL_SCALE_24);
+            }
+        }
+    }
+
+    PcmBlock block{{}, {}, sequence};
+    if (mConfig.format == PcmFormat::PCM16)
+    {
+        block.pcm16 = {pPcm16, mConfig.BlockSamples()};
+    }
+    else
+    {
+        block.pcm24 = {pPcm24, mConfig.BlockSamples()};
+    }
+    if (!mQueue.Push(block))
+    {
+        mDropped.fetch_add(1U, std::memory_order_release);
+    }
+}
+
+
+bool PdmPipeline::IsOverwritten(uint32_t sequence) const
+{
+    // the half of the block is rewritten after the pipeline has written the other half
+    const uint32_t halfStart = sequence - (sequence % (mConfig.blocks / 2U));
+    return (mProduced.load(std::memory_order_acquire) - halfStart) >= mConfig.blocks;
+}
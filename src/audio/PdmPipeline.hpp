@@ -0,0 +1,152 @@
+/**
+ ********************************************************************************
+ * @file        PdmPipeline.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, PDM microphone pipeline with zero-copy PCM block delivery.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "BiquadCascade.hpp"
+#include "FirFilter.hpp"
+#include "IPdmFrontEnd.hpp"
+#include "SpscQueue.hpp"
+#include <array>
+#include <atomic>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides synchronized PCM blocks of up to @ref MAX_CHANNELS PDM microphones.
+ * @details The front end decimates every microphone in hardware (sinc filter and integrator) into its DMA
+ *          ring. When a half of the rings is filled the pipeline runs the software stage over its blocks,
+ *          channel by channel:
+ *          1. the data register words are scaled to full scale one
+ *          2. the sinc droop compensation (SincCompensation) flattens the pass band
+ *          3. the high pass (2nd order Butterworth) removes the offset of the microphone
+ *          4. the samples are rounded, saturated and interleaved into the PCM ring.
+ *
+ *          Every block is queued (spans into the PCM ring and a running sequence number) into a lock-free
+ *          SPSC queue, the processing thread takes them with @ref Receive without copy and hands them back
+ *          with @ref Release. A block stays valid until the pipeline has written the other half of the ring
+ *          and starts to rewrite its own half, like the blocks of Adc::AcquisitionEngine.
+ * @note    The software stage runs in the DMA interrupt, it must finish a half within the time the DMA
+ *          needs to fill the other one. @ref Start, @ref Stop, @ref Receive and @ref Release belong to the
+ *          processing thread.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe for one processing thread and the front end interrupt.
+ *
+ */
+class PdmPipeline : private IPdmFrontEnd::IListener
+{
+    public:
+
+        /**
+         * @brief   Constructs the pipeline on a front end.
+         *
+         * @param   frontEnd    The hardware decimation.
+         */
+        explicit PdmPipeline(IPdmFrontEnd& frontEnd);
+
+        /// @brief Destructor, stops the stream.
+        ~PdmPipeline();
+
+        PdmPipeline(PdmPipeline const &) = delete;             //!< Copy constructor
+        PdmPipeline& operator=(PdmPipeline const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Design the software stage and start the stream, the counters restart.
+         *
+         * @param   config  The configuration, the rings must outlive the stream.
+         *
+         * @return  OK, BUSY, INVALID_PARAM or the error of the front end.
+         */
+        Status Start(const PdmConfig& config);
+
+        /// @brief Stop the stream, queued blocks stay receivable until they are overwritten.
+        void Stop();
+
+        /**
+         * @brief   Take the oldest intact block.
+         *
+         * @param   block   Receives the block.
+         *
+         * @return  true if a block was taken.
+         */
+        bool Receive(PcmBlock& block);
+
+        /**
+         * @brief   Hand a block back.
+         *
+         * @param   block   The received block.
+         *
+         * @return  true if the pipeline has not rewritten the block while it was used.
+         */
+        bool Release(const PcmBlock& block);
+
+        /// @brief The stream runs.
+        bool IsRunning() const {return mRunning.load(std::memory_order_acquire);};
+
+        /// @brief Blocks written since the start.
+        uint32_t GetProducedBlocks() const {return mProduced.load(std::memory_order_acquire);};
+
+        /// @brief Blocks dropped, skipped or overwritten while used since the start.
+        uint32_t GetLostBlocks() const
+        {
+            return mDropped.load(std::memory_order_acquire) + mOverwritten.load(std::memory_order_acquire);
+        };
+
+        /// @brief Conversion overruns of the filters since the start.
+        uint32_t GetOverruns() const {return mOverruns.load(std::memory_order_acquire);};
+
+    private:
+
+        /// @copydoc IPdmFrontEnd::IListener::OnHalfFilled
+        void OnHalfFilled(uint8_t half) override;
+
+        /// @copydoc IPdmFrontEnd::IListener::OnError
+        void OnError(Status status) override;
+
+        /// @brief Run the software stage of a block and queue it.
+        void ProcessBlock(uint32_t sequence);
+
+        /// @brief The half of the block is rewritten or already reused.
+        bool IsOverwritten(uint32_t sequence) const;
+
+        /// @brief The hardware decimation.
+        IPdmFrontEnd& mFrontEnd;
+
+        /// @brief The running configuration.
+        PdmConfig mConfig{};
+
+        /// @brief Scale of a data register value to full scale one.
+        float mScale{1.0F};
+
+        /// @brief Sinc droop compensation per channel.
+        std::array<Dsp::FirFilter, MAX_CHANNELS> mCompensation;
+
+        /// @brief High pass per channel.
+        std::array<Dsp::BiquadCascade, MAX_CHANNELS> mHighPass;
+
+        /// @brief Samples of the channel in work.
+        alignas(32) std::array<float, MAX_BLOCK_FRAMES> mWork{};
+
+        /// @brief Blocks from the interrupt to the processing thread.
+        Utils::SpscQueue<PcmBlock, MAX_BLOCKS> mQueue{};
+
+        std::atomic<bool> mRunning{false};          //!< The stream runs
+        std::atomic<uint32_t> mProduced{0U};        //!< Written blocks, written by the interrupt
+        std::atomic<uint32_t> mDropped{0U};         //!< Blocks not queued, written by the interrupt
+        std::atomic<uint32_t> mOverruns{0U};        //!< Overruns, written by the interrupt
+        std::atomic<uint32_t> mOverwritten{0U};     //!< Stale blocks, written by the processing thread
+};
+
+} // end namespace Audio
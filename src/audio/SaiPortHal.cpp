@@ -0,0 +1,222 @@
+/**
+ ********************************************************************************
+ * @file        SaiPortHal.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, SAI port implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SaiPortHal.hpp"
+#include "DCache.hpp"
+
+using namespace Audio;
+
+SaiPortHal* SaiPortHal::spInstance = nullptr;
+
+SaiPortHal::SaiPortHal(SAI_HandleTypeDef& hsaiTx, SAI_HandleTypeDef& hsaiRx)
+: mHsaiTx(hsaiTx)
+, mHsaiRx(hsaiRx)
+{
+    spInstance = this;
+}
+
+
+SaiPortHal::~SaiPortHal()
+{
+    Stop();
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+SaiPortHal* SaiPortHal::GetInstance(const SAI_HandleTypeDef* hsai)
+{
+    if ((spInstance != nullptr) && ((hsai == &spInstance->mHsaiTx) || (hsai == &spInstance->mHsaiRx)))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status SaiPortHal::Start(const StreamConfig& config)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if (!config.IsValid() || (mHsaiTx.Init.DataSize != SAI_DATASIZE_24) || (mHsaiRx.Init.DataSize != SAI_DATASIZE_24)
+        || (mHsaiTx.SlotInit.SlotNumber != config.channels) || (mHsaiRx.SlotInit.SlotNumber != config.channels))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    // the master generates the frame clock of the new rate
+    HAL_StatusTypeDef result = HAL_OK;
+    if (mHsaiTx.Init.AudioFrequency != config.sampleRate)
+    {
+        mHsaiTx.Init.AudioFrequency = config.sampleRate;
+        result = HAL_SAI_DeInit(&mHsaiTx);
+        if (result == HAL_OK)
+        {
+            result = HAL_SAI_Init(&mHsaiTx);
+        }
+        if (result != HAL_OK)
+        {
+            return ToStatus(result);
+        }
+    }
+
+    // the silent first periods go out, no dirty line may be evicted into the receive ring
+    const uint32_t bytes = config.RingWords() * sizeof(int32_t);
+    Utils::DCache::Clean(config.pTx, bytes);
+    Utils::DCache::Invalidate(config.pRx, bytes);
+    mConfig = config;
+    mRunning = true;
+    // the synchronous receiver waits for the clock of the transmitter
+    const auto words = static_cast<uint16_t>(config.RingWords());
+    result = HAL_SAI_Receive_DMA(&mHsaiRx, reinterpret_cast<uint8_t*>(config.pRx), words);
+    if (result == HAL_OK)
+    {
+        result = HAL_SAI_Transmit_DMA(&mHsaiTx, reinterpret_cast<uint8_t*>(config.pTx), words);
+    }
+    if (result != HAL_OK)
+    {
+        Stop();
+    }
+    return ToStatus(result);
+}
+
+
+void SaiPortHal::Stop()
+{
+    if (mRunning)
+    {
+        // the master first, the slave loses its clock
+        (void)HAL_SAI_DMAStop(&mHsaiTx);
+        (void)HAL_SAI_DMAStop(&mHsaiRx);
+        mRunning = false;
+    }
+}
+
+
+Status SaiPortHal::Pause()
+{
+    if (!mRunning)
+    {
+        return Status::OK;
+    }
+    HAL_StatusTypeDef result = HAL_SAI_DMAPause(&mHsaiTx);
+    if (result == HAL_OK)
+    {
+        result = HAL_SAI_DMAPause(&mHsaiRx);
+    }
+    return ToStatus(result);
+}
+
+
+Status SaiPortHal::Resume()
+{
+    if (!mRunning)
+    {
+        return Status::OK;
+    }
+    HAL_StatusTypeDef result = HAL_SAI_DMAResume(&mHsaiRx);
+    if (result == HAL_OK)
+    {
+        result = HAL_SAI_DMAResume(&mHsaiTx);
+    }
+    return ToStatus(result);
+}
+
+
+void SaiPortHal::OnHalf(uint8_t half)
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    const uint32_t samples = mConfig.PeriodSamples();
+    const uint32_t offset = half * samples;
+    Utils::DCache::Invalidate(&mConfig.pRx[offset], samples * sizeof(int32_t));
+    if (mpListener != nullptr)
+    {
+        mpListener->OnPeriod(half);
+    }
+    // the transmitter reaches this half after the other one
+    Utils::DCache::Clean(&mConfig.pTx[offset], samples * sizeof(int32_t));
+}
+
+
+void SaiPortHal::OnError(const SAI_HandleTypeDef* hsai)
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    const uint32_t error = HAL_SAI_GetError(hsai);
+    if ((error & ~(HAL_SAI_ERROR_OVR | HAL_SAI_ERROR_UDR)) == 0U)
+    {
+        if (mpListener != nullptr)
+        {
+            mpListener->OnError(Status::OVERRUN);
+        }
+        return;
+    }
+    Stop();
+    if (mpListener != nullptr)
+    {
+        mpListener->OnError(Status::HW_ERROR);
+    }
+}
+
+
+Status SaiPortHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef* hsai)
+{
+    SaiPortHal* pPort = SaiPortHal::GetInstance(hsai);
+    if ((pPort != nullptr) && (hsai == pPort->GetReceiver()))
+    {
+        pPort->OnHalf(0U);
+    }
+}
+
+
+extern "C" void HAL_SAI_RxCpltCallback(SAI_HandleTypeDef* hsai)
+{
+    SaiPortHal* pPort = SaiPortHal::GetInstance(hsai);
+    if ((pPort != nullptr) && (hsai == pPort->GetReceiver()))
+    {
+        pPort->OnHalf(1U);
+    }
+}
+
+
+extern "C" void HAL_SAI_ErrorCallback(SAI_HandleTypeDef* hsai)
+{
+    SaiPortHal* pPort = SaiPortHal::GetInstance(hsai);
+    if (pPort != nullptr)
+    {
+        pPort->OnError(hsai);
+    }
+}
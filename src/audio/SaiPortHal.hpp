@@ -0,0 +1,113 @@
+/**
+ ********************************************************************************
+ * @file        SaiPortHal.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, full duplex audio port on the SAI.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISaiPort.hpp"
+#include "stm32h7xx_hal.h"
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the ISaiPort on the two blocks of one SAI of the STM32H7.
+ * @details The transmit block is the master and generates the frame clock, the receive block runs
+ *          synchronous to it, so both rings advance with the same frame. @ref Start sets the audio frequency
+ *          of the master (HAL_SAI_Init if it changes), starts the receiver (HAL_SAI_Receive_DMA), which waits
+ *          for the clock, and then the transmitter (HAL_SAI_Transmit_DMA).\n
+ *          The half and full receive callbacks invalidate the D-Cache lines of the received half, report it
+ *          and clean the lines of the same half of the transmit ring the listener has just written. An
+ *          overrun or underrun is reported as OVERRUN (the DMA continues), any other error stops both blocks
+ *          and is reported as HW_ERROR.
+ * @note    The application initialises both handles for 24 bit data in 32 bit slots with one slot per
+ *          channel (e.g. HAL_SAI_InitProtocol with SAI_PROTOCOL_DATASIZE_24BIT), links the circular DMA with
+ *          word transfers (HAL_SAI_MspInit) and calls HAL_SAI_IRQHandler and the DMA handlers. The rings must
+ *          be located in a DMA accessible RAM (not DTCM) and 32 byte aligned, the period a multiple of 8
+ *          samples keeps the halves on whole cache lines. One instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one AudioEngine.
+ *
+ */
+class SaiPortHal : public ISaiPort
+{
+    public:
+
+        /**
+         * @brief   Constructs the port for initialised handles.
+         *
+         * @param   hsaiTx  The transmit block, master.
+         * @param   hsaiRx  The receive block, synchronous slave.
+         */
+        SaiPortHal(SAI_HandleTypeDef& hsaiTx, SAI_HandleTypeDef& hsaiRx);
+
+        /// @brief Destructor.
+        ~SaiPortHal() override;
+
+        SaiPortHal(SaiPortHal const &) = delete;             //!< Copy constructor
+        SaiPortHal& operator=(SaiPortHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc ISaiPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ISaiPort::Start
+        Status Start(const StreamConfig& config) override;
+
+        /// @copydoc ISaiPort::Stop
+        void Stop() override;
+
+        /// @copydoc ISaiPort::Pause
+        Status Pause() override;
+
+        /// @copydoc ISaiPort::Resume
+        Status Resume() override;
+
+        /**
+         * @brief   A half of the receive ring is filled, called by the receive callbacks.
+         *
+         * @param   half    0 for the first, 1 for the second half.
+         */
+        void OnHalf(uint8_t half);
+
+        /// @brief Overrun, underrun or transfer error, called by HAL_SAI_ErrorCallback.
+        void OnError(const SAI_HandleTypeDef* hsai);
+
+        /// @brief Port which uses a SAI handle or nullptr.
+        static SaiPortHal* GetInstance(const SAI_HandleTypeDef* hsai);
+
+        /// @brief The receive block of the port.
+        const SAI_HandleTypeDef* GetReceiver() const {return &mHsaiRx;};
+
+    private:
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The transmit block.
+        SAI_HandleTypeDef& mHsaiTx;
+
+        /// @brief The receive block.
+        SAI_HandleTypeDef& mHsaiRx;
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        StreamConfig mConfig{0U, 0U, 0U, nullptr, nullptr};     //!< The running stream
+        volatile bool mRunning{false};                          //!< The stream runs
+
+        /// @brief The single port instance.
+        static SaiPortHal* spInstance;
+};
+
+} // end namespace Audio
@@ -0,0 +1,180 @@
+/**
+ ********************************************************************************
+ * @file        SaiPortSim.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, simulated full duplex audio port.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISaiPort.hpp"
+#include <algorithm>
+#include <vector>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the ISaiPort on the host as a null device with a recorded output.
+ * @details The frame clock side (@ref Tick) runs period by period like the DMA: the transmitter sends half h
+ *          of the transmit ring (appended to the output), the receiver fills half h of the receive ring from
+ *          the input (silence behind its end), then the half is reported. The listener is called
+ *          synchronously like the interrupt.\n
+ *          @ref InjectLatePeriod drops the report of the next period (the DMA continues), @ref InjectOverrun
+ *          and @ref InjectFault model the error interrupts. In pause the DMA and the reports hold.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * @ref Tick may run in another thread (the simulated interrupt context) while no Start or Stop is called.
+ *
+ */
+class SaiPortSim : public ISaiPort
+{
+    public:
+
+        /// @brief Constructor, the input is silent.
+        SaiPortSim() = default;
+
+        SaiPortSim(SaiPortSim const &) = delete;             //!< Copy constructor
+        SaiPortSim& operator=(SaiPortSim const &) = delete;  //!< Copy assignment
+
+        /// @brief Set the received slots (interleaved frames), the position restarts.
+        void SetInput(std::vector<int32_t> input)
+        {
+            mInput = std::move(input);
+            mInputPos = 0U;
+        }
+
+        /// @brief Record the transmitted slots into the output.
+        void SetRecording(bool record) {mRecording = record;};
+
+        /**
+         * @brief   Frame clock side: run periods.
+         *
+         * @param   periods     Count of periods.
+         *
+         * @return  Count of periods run, 0 if stopped.
+         */
+        uint32_t Tick(uint32_t periods)
+        {
+            uint32_t ticked = 0U;
+            while (mRunning && !mPaused && (ticked < periods))
+            {
+                const uint32_t samples = mConfig.PeriodSamples();
+                const size_t offset = static_cast<size_t>(mHalf) * samples;
+                if (mRecording)
+                {
+                    mOutput.insert(mOutput.end(), mConfig.pTx + offset, mConfig.pTx + offset + samples);
+                }
+                for (uint32_t i = 0U; i < samples; i++)
+                {
+                    mConfig.pRx[offset + i] = (mInputPos < mInput.size()) ? mInput[mInputPos++] : 0;
+                }
+                const uint8_t half = mHalf;
+                mHalf ^= 1U;
+                ticked++;
+                if (mLate)
+                {
+                    mLate = false;
+                }
+                else if (mpListener != nullptr)
+                {
+                    mpListener->OnPeriod(half);
+                }
+            }
+            return ticked;
+        }
+
+        /// @brief The report of the next period is lost.
+        void InjectLatePeriod() {mLate = true;};
+
+        /// @brief Report an overrun of the receiver, the stream continues.
+        void InjectOverrun()
+        {
+            if (mRunning && (mpListener != nullptr))
+            {
+                mpListener->OnError(Status::OVERRUN);
+            }
+        }
+
+        /// @brief Report a DMA error, the stream stops.
+        void InjectFault()
+        {
+            if (mRunning)
+            {
+                mRunning = false;
+                if (mpListener != nullptr)
+                {
+                    mpListener->OnError(Status::HW_ERROR);
+                }
+            }
+        }
+
+        /// @copydoc ISaiPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ISaiPort::Start
+        Status Start(const StreamConfig& config) override
+        {
+            if (mRunning)
+            {
+                return Status::BUSY;
+            }
+            if (!config.IsValid())
+            {
+                return Status::INVALID_PARAM;
+            }
+            mConfig = config;
+            mHalf = 0U;
+            mLate = false;
+            mPaused = false;
+            mRunning = true;
+            return Status::OK;
+        }
+
+        /// @copydoc ISaiPort::Stop
+        void Stop() override {mRunning = false;};
+
+        /// @copydoc ISaiPort::Pause
+        Status Pause() override
+        {
+            mPaused = mRunning;
+            return Status::OK;
+        }
+
+        /// @copydoc ISaiPort::Resume
+        Status Resume() override
+        {
+            mPaused = false;
+            return Status::OK;
+        }
+
+        /// @brief The stream runs.
+        bool IsRunning() const {return mRunning;};
+
+        /// @brief The transmitted slots while recording.
+        const std::vector<int32_t>& GetOutput() const {return mOutput;};
+
+    private:
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        StreamConfig mConfig{0U, 0U, 0U, nullptr, nullptr}; //!< The running stream
+        std::vector<int32_t> mInput{};                      //!< Received slots
+        size_t mInputPos{0U};                               //!< Next received slot
+        std::vector<int32_t> mOutput{};                     //!< Transmitted slots
+        bool mRecording{true};                              //!< Record the output
+        uint8_t mHalf{0U};                                  //!< Half of the next period
+        bool mLate{false};                                  //!< Drop the next report
+        bool mPaused{false};                                //!< DMA on hold
+        bool mRunning{false};                               //!< The stream runs
+};
+
+} // end namespace Audio
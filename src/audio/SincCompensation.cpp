@@ -0,0 +1,131 @@
+/**
+ ********************************************************************************
+ * @file        SincCompensation.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, sinc droop compensation implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SincCompensation.hpp"
+#include <array>
+#include <cmath>
+#include <utility>
+
+using namespace Audio;
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+/// @brief Frequencies of the least squares grid up to half the output rate.
+constexpr uint32_t GRID{512U};
+
+/// @brief Weight of the error above the pass band.
+constexpr double STOP_WEIGHT{0.001};
+
+/// @brief Cosine terms of a symmetric FIR of MAX_TAPS taps.
+constexpr uint32_t TERMS{(SincCompensation::MAX_TAPS + 1U) / 2U};
+
+/// @brief Magnitude of a box of length at a frequency in units of its input rate, one at DC.
+double Box(double frequency, double length)
+{
+    const double denominator = length * std::sin(PI * frequency);
+    if (std::fabs(denominator) < 1e-12)
+    {
+        return 1.0;
+    }
+    return std::fabs(std::sin(PI * frequency * length) / denominator);
+}
+
+} // end anonymous namespace
+
+
+double SincCompensation::Response(const SincConfig& sinc, double frequency)
+{
+    // the sinc runs at the bit rate, the integrator at the filter rate
+    const double decimation = static_cast<double>(sinc.oversampling) * sinc.integrator;
+    const double bitFrequency = frequency / decimation;
+    const double integrator = Box(bitFrequency * sinc.oversampling, sinc.integrator);
+    return std::pow(Box(bitFrequency, sinc.oversampling), sinc.order) * integrator;
+}
+
+
+Status SincCompensation::Design(const SincConfig& sinc, std::span<float> coefficients)
+{
+    const size_t taps = coefficients.size();
+    if (!sinc.IsValid() || (taps < 3U) || (taps > MAX_TAPS) || ((taps % 2U) == 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    // H(f) = sum a[k] cos(2 pi f k), normal equations of the weighted fit on the grid
+    const size_t terms = (taps + 1U) / 2U;
+    std::array<std::array<double, TERMS + 1U>, TERMS> system{};
+    for (uint32_t g = 0U; g <= GRID; g++)
+    {
+        const double frequency = 0.5 * g / GRID;
+        const bool pass = frequency <= PASSBAND;
+        const double weight = pass ? 1.0 : STOP_WEIGHT;
+        const double target = pass ? (1.0 / Response(sinc, frequency)) : 0.0;
+        std::array<double, TERMS> basis{};
+        for (size_t k = 0U; k < terms; k++)
+        {
+            basis[k] = std::cos(2.0 * PI * frequency * static_cast<double>(k));
+        }
+        for (size_t row = 0U; row < terms; row++)
+        {
+            for (size_t column = 0U; column < terms; column++)
+            {
+                system[row][column] += weight * basis[row] * basis[column];
+            }
+            system[row][terms] += weight * basis[row] * target;
+        }
+    }
+
+    // Gauss elimination with partial pivoting, the matrix is symmetric positive definite
+    for (size_t pivot = 0U; pivot < terms; pivot++)
+    {
+        size_t best = pivot;
+        for (size_t row = pivot + 1U; row < terms; row++)
+        {
+            if (std::fabs(system[row][pivot]) > std::fabs(system[best][pivot]))
+            {
+                best = row;
+            }
+        }
+        std::swap(system[pivot], system[best]);
+        for (size_t row = pivot + 1U; row < terms; row++)
+        {
+            const double factor = system[row][pivot] / system[pivot][pivot];
+            for (size_t column = pivot; column <= terms; column++)
+            {
+                system[row][column] -= factor * system[pivot][column];
+            }
+        }
+    }
+    std::array<double, TERMS> a{};
+    for (size_t row = terms; row-- > 0U;)
+    {
+        double sum = system[row][terms];
+        for (size_t column = row + 1U; column < terms; column++)
+        {
+            sum -= system[row][column] * a[column];
+        }
+        a[row] = sum / system[row][row];
+    }
+
+    // h[center] = a[0], h[center +- k] = a[k] / 2
+    const size_t center = terms - 1U;
+    coefficients[center] = static_cast<float>(a[0]);
+    for (size_t k = 1U; k < terms; k++)
+    {
+        coefficients[center - k] = static_cast<float>(0.5 * a[k]);
+        coefficients[center + k] = static_cast<float>(0.5 * a[k]);
+    }
+    return Status::OK;
+}
@@ -0,0 +1,66 @@
+/**
+ ********************************************************************************
+ * @file        SincCompensation.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, design of the sinc droop compensation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "AudioTypes.hpp"
+#include <span>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the linear phase FIR which flattens the pass band of a DFSDM filter.
+ * @details The response of the sinc filter and the integrator falls towards the band edge, e.g. by 12 dB at
+ *          0.4 of the output rate for a sinc5. The FIR is the weighted least squares fit of
+ *          1 / response in the pass band (0 .. @ref PASSBAND of the output rate) and of zero above it with a
+ *          small weight, which keeps the gain outside the pass band bounded.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe, it has no state.
+ *
+ */
+class SincCompensation
+{
+    public:
+
+        /// @brief Edge of the flattened pass band in units of the output rate.
+        static constexpr double PASSBAND{0.4};
+
+        /// @brief Maximum taps.
+        static constexpr uint32_t MAX_TAPS{63U};
+
+        SincCompensation() = delete;    //!< Static functions only
+
+        /**
+         * @brief   Design the compensation.
+         *
+         * @param   sinc            The filter settings.
+         * @param   coefficients    Receives the taps, odd size 3 .. @ref MAX_TAPS.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        static Status Design(const SincConfig& sinc, std::span<float> coefficients);
+
+        /**
+         * @brief   Magnitude of the sinc filter and the integrator, one at DC.
+         *
+         * @param   sinc        The filter settings.
+         * @param   frequency   Frequency in units of the output rate.
+         *
+         * @return  The magnitude.
+         */
+        static double Response(const SincConfig& sinc, double frequency);
+};
+
+} // end namespace Audio
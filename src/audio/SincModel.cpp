@@ -0,0 +1,67 @@
+/**
+ ********************************************************************************
+ * @file        SincModel.cpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, DFSDM filter model implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SincModel.hpp"
+#include <algorithm>
+
+using namespace Audio;
+
+
+void SincModel::Reset()
+{
+    mIntegrators.fill(0U);
+    mCombs.fill(0U);
+    mBits = 0U;
+    mOutputs = 0U;
+    mSum = 0;
+}
+
+
+bool SincModel::Push(int8_t bit, int32_t& value)
+{
+    uint64_t stage = (bit > 0) ? 1U : ~static_cast<uint64_t>(0U);
+    for (uint8_t i = 0U; i < mConfig.order; i++)
+    {
+        mIntegrators[i] += stage;
+        stage = mIntegrators[i];
+    }
+    mBits++;
+    if (mBits < mConfig.oversampling)
+    {
+        return false;
+    }
+    mBits = 0U;
+
+    for (uint8_t i = 0U; i < mConfig.order; i++)
+    {
+        const uint64_t delayed = mCombs[i];
+        mCombs[i] = stage;
+        stage -= delayed;
+    }
+    mSum += static_cast<int64_t>(stage);
+    mOutputs++;
+    if (mOutputs < mConfig.integrator)
+    {
+        return false;
+    }
+    mOutputs = 0U;
+
+    int64_t result = mSum;
+    mSum = 0;
+    if (mConfig.rightShift > 0U)
+    {
+        result = (result + (static_cast<int64_t>(1) << (mConfig.rightShift - 1U))) >> mConfig.rightShift;
+    }
+    value = static_cast<int32_t>(std::clamp<int64_t>(result, -MAX_RAW - 1, MAX_RAW));
+    return true;
+}
@@ -0,0 +1,83 @@
+/**
+ ********************************************************************************
+ * @file        SincModel.hpp
+ *
+ * @namespace   Audio
+ *
+ * @brief       Audio, bit exact model of a DFSDM filter.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "AudioTypes.hpp"
+#include <array>
+namespace Audio {
+
+
+/**
+ * @brief   This class provides the data register values of a DFSDM filter for a PDM bit stream.
+ * @details The sinc filter of order N is a cascade of N integrators at the bit rate and N combs at the
+ *          decimated rate, which equals the convolution with N boxes of oversampling bits (the history
+ *          before the start is zero). The integrator sums @ref SincConfig::integrator filter outputs, the
+ *          sum is shifted right rounded to nearest and saturated to 24 bit like the channel does it.\n
+ *          The integer stages wrap around in 64 bit, the results are exact for every valid configuration.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class SincModel
+{
+    public:
+
+        /// @brief Constructs a sinc1 filter without decimation.
+        SincModel() = default;
+
+        /**
+         * @brief   Constructs the filter.
+         *
+         * @param   config  The filter settings, valid.
+         */
+        explicit SincModel(const SincConfig& config) : mConfig(config) {};
+
+        /// @brief Clear the filter stages.
+        void Reset();
+
+        /**
+         * @brief   Filter a bit.
+         *
+         * @param   bit     The bit, +1 or -1.
+         * @param   value   Receives the 24 bit result when one is complete.
+         *
+         * @return  true if a result is complete.
+         */
+        bool Push(int8_t bit, int32_t& value);
+
+    private:
+
+        /// @brief The filter settings.
+        SincConfig mConfig{1U, 1U, 1U, 0U};
+
+        /// @brief The integrators of the sinc filter.
+        std::array<uint64_t, 5U> mIntegrators{};
+
+        /// @brief The delays of the combs.
+        std::array<uint64_t, 5U> mCombs{};
+
+        /// @brief Bits of the running filter output.
+        uint16_t mBits{0U};
+
+        /// @brief Filter outputs in the running integrator sum.
+        uint16_t mOutputs{0U};
+
+        /// @brief The running integrator sum.
+        int64_t mSum{0};
+};
+
+} // end namespace Audio
@@ -0,0 +1,383 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../PdmPipeline.hpp"
+#include "../PdmFrontEndSim.hpp"
+#include "../SincCompensation.hpp"
+#include "../SincModel.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Audio;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  SincModelIsTheBoxConvolution
+*   (0)  CompensationFlattensThePassBand
+*   (0)  HighPassRemovesTheOffset
+*   (0)  DeliversSynchronizedFramesInBothFormats
+*   (0)  CountsLostBlocksAndRejectsInvalidConfigs
+*/
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+/// @brief 3.072 MHz bit clock, sinc5 and 64 times oversampling give 48 kHz.
+constexpr uint32_t PDM_CLOCK{3072000U};
+constexpr SincConfig SINC5{5U, 64U, 1U, 8U};
+constexpr uint16_t BLOCK_FRAMES{64U};
+
+/// @brief Rings of a stream.
+struct Rings
+{
+    std::vector<int32_t> raw;
+    std::vector<int32_t> pcm;
+};
+
+PdmConfig Config(Rings& rings, uint8_t channels, uint8_t blocks, PcmFormat format = PcmFormat::PCM24)
+{
+    rings.raw.assign(static_cast<size_t>(channels) * BLOCK_FRAMES * blocks, 0);
+    rings.pcm.assign(static_cast<size_t>(channels) * BLOCK_FRAMES * blocks, 0);
+    return {channels, SINC5, PDM_CLOCK, 31U, 0.0F, format, rings.raw.data(), rings.pcm.data(), BLOCK_FRAMES, blocks};
+}
+
+/// @brief The samples of one channel of all received blocks.
+std::vector<double> Collect(PdmPipeline& pipeline, uint8_t channels, uint8_t channel)
+{
+    std::vector<double> samples;
+    PcmBlock block{};
+    while (pipeline.Receive(block))
+    {
+        for (size_t i = channel; i < block.pcm24.size(); i += channels)
+        {
+            samples.push_back(block.pcm24[i] / 8388607.0);
+        }
+        EXPECT_TRUE(pipeline.Release(block));
+    }
+    return samples;
+}
+
+/// @brief Run a stream for halves of the rings and collect a channel.
+std::vector<double> Stream(PdmFrontEndSim& frontEnd, PdmPipeline& pipeline, const PdmConfig& config, uint32_t halves,
+                           uint8_t channel)
+{
+    std::vector<double> samples;
+    for (uint32_t i = 0U; i < halves; i++)
+    {
+        frontEnd.Convert(config.RingWords() / 2U);
+        const std::vector<double> part = Collect(pipeline, config.channels, channel);
+        samples.insert(samples.end(), part.begin(), part.end());
+    }
+    return samples;
+}
+
+/// @brief Mean of the samples behind skip.
+double Mean(const std::vector<double>& samples, size_t skip)
+{
+    double sum = 0.0;
+    for (size_t n = skip; n < samples.size(); n++)
+    {
+        sum += samples[n];
+    }
+    return sum / static_cast<double>(samples.size() - skip);
+}
+
+/// @brief Amplitude of a tone (cycles per sample) by a least squares fit of sine, cosine and offset.
+double Amplitude(const std::vector<double>& samples, size_t skip, double frequency)
+{
+    double ss = 0.0, cc = 0.0, sc = 0.0, sy = 0.0, cy = 0.0;
+    for (size_t n = skip; n < samples.size(); n++)
+    {
+        const double s = std::sin(2.0 * PI * frequency * n);
+        const double c = std::cos(2.0 * PI * frequency * n);
+        ss += s * s;
+        cc += c * c;
+        sc += s * c;
+        sy += s * samples[n];
+        cy += c * samples[n];
+    }
+    const double det = (ss * cc) - (sc * sc);
+    const double a = ((sy * cc) - (cy * sc)) / det;
+    const double b = ((cy * ss) - (sy * sc)) / det;
+    return std::hypot(a, b);
+}
+
+/// @brief Gain in dB of the pipeline for a tone.
+double GainDb(uint8_t compensationTaps, double frequency)
+{
+    constexpr double AMPLITUDE{0.5};
+    PdmFrontEndSim frontEnd;
+    PdmPipeline pipeline(frontEnd);
+    Rings rings;
+    PdmConfig config = Config(rings, 1U, 4U);
+    config.compensationTaps = compensationTaps;
+    frontEnd.SetSignal(0U, PdmModulator(frequency / PDM_CLOCK, AMPLITUDE));
+    EXPECT_EQ(Status::OK, pipeline.Start(config));
+
+    const std::vector<double> samples = Stream(frontEnd, pipeline, config, 24U, 0U);
+    return 20.0 * std::log10(Amplitude(samples, 64U, frequency / config.OutputRate()) / AMPLITUDE);
+}
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(PdmPipeline_Test, SincModelIsTheBoxConvolution)
+{
+    std::mt19937 random(1U);
+    std::vector<int8_t> bits(4000U);
+    for (int8_t& bit : bits)
+    {
+        bit = ((random() & 1U) != 0U) ? 1 : -1;
+    }
+
+    for (uint8_t order = 1U; order <= 5U; order++)
+    {
+        const SincConfig config{order, 8U, 3U, 2U};
+        // the kernel: order boxes of 8 ones
+        std::vector<int64_t> kernel{1};
+        for (uint8_t i = 0U; i < order; i++)
+        {
+            std::vector<int64_t> next(kernel.size() + 7U, 0);
+            for (size_t k = 0U; k < kernel.size(); k++)
+            {
+                for (size_t j = 0U; j < 8U; j++)
+                {
+                    next[k + j] += kernel[k];
+                }
+            }
+            kernel = next;
+        }
+
+        SincModel model(config);
+        size_t results = 0U;
+        int64_t sum = 0;
+        for (size_t n = 0U; n < bits.size(); n++)
+        {
+            int32_t value = 0;
+            const bool complete = model.Push(bits[n], value);
+            if (((n + 1U) % 8U) == 0U)
+            {
+                int64_t output = 0;
+                for (size_t j = 0U; (j < kernel.size()) && (j <= n); j++)
+                {
+                    output += kernel[j] * bits[n - j];
+                }
+                sum += output;
+            }
+            ASSERT_EQ(((n + 1U) % 24U) == 0U, complete) << n;
+            if (complete)
+            {
+                // shifted by 2, rounded to nearest
+                ASSERT_EQ(static_cast<int32_t>((sum + 2) >> 2), value) << static_cast<int>(order) << " " << n;
+                sum = 0;
+                results++;
+            }
+        }
+        EXPECT_EQ(bits.size() / 24U, results);
+    }
+
+    // ones saturate the data register
+    SincModel saturated(SincConfig{5U, 64U, 1U, 0U});
+    int32_t value = 0;
+    for (uint32_t n = 0U; n < 64U * 6U; n++)
+    {
+        (void)saturated.Push(1, value);
+    }
+    EXPECT_EQ(MAX_RAW, value);
+}
+
+
+TEST(PdmPipeline_Test, CompensationFlattensThePassBand)
+{
+    // the sinc5 droops by 12 dB at 0.4 of the output rate
+    EXPECT_NEAR(-12.1, 20.0 * std::log10(SincCompensation::Response(SINC5, 0.4)), 0.1);
+    const double reference = GainDb(31U, 1000.0);
+    EXPECT_NEAR(0.0, reference, 0.05);
+    for (const double frequency : {4000.0, 10000.0, 16000.0, 19000.0})
+    {
+        EXPECT_NEAR(reference, GainDb(31U, frequency), 0.2) << frequency;
+    }
+    // without the compensation the modelled droop remains
+    const double raw = GainDb(0U, 16000.0);
+    EXPECT_NEAR(20.0 * std::log10(SincCompensation::Response(SINC5, 16000.0 / 48000.0)), raw, 0.1);
+    EXPECT_LT(raw, -7.0);
+}
+
+
+
+TEST(PdmPipeline_Test, HighPassRemovesTheOffset)
+{
+    // 1 kHz with a large offset, 48 samples per cycle
+    constexpr double FREQUENCY{1000.0};
+    for (const float highPass : {0.0F, 20.0F})
+    {
+        PdmFrontEndSim frontEnd;
+        PdmPipeline pipeline(frontEnd);
+        Rings rings;
+        PdmConfig config = Config(rings, 1U, 4U);
+        config.highPassHz = highPass;
+        frontEnd.SetSignal(0U, PdmModulator(FREQUENCY / PDM_CLOCK, 0.2, 0.3));
+        ASSERT_EQ(Status::OK, pipeline.Start(config));
+
+        // 0.25 s, the mean of the last 100 cycles
+        const std::vector<double> samples = Stream(frontEnd, pipeline, config, 94U, 0U);
+        ASSERT_EQ(94U * 128U, samples.size());
+        const double mean = Mean(samples, samples.size() - 4800U);
+        EXPECT_NEAR((highPass > 0.0F) ? 0.0 : 0.3, mean, 0.002);
+        EXPECT_NEAR(0.2, Amplitude(samples, samples.size() - 4800U, FREQUENCY / config.OutputRate()), 0.002);
+    }
+}
+
+
+TEST(PdmPipeline_Test, DeliversSynchronizedFramesInBothFormats)
+{
+    constexpr uint8_t CHANNELS{8U};
+    std::vector<int32_t> pcm24;
+    for (const PcmFormat format : {PcmFormat::PCM24, PcmFormat::PCM16})
+    {
+        PdmFrontEndSim frontEnd;
+        PdmPipeline pipeline(frontEnd);
+        Rings rings;
+        const PdmConfig config = Config(rings, CHANNELS, 4U, format);
+        // the same microphone signal on all channels gives the same bits
+        for (uint8_t c = 0U; c < CHANNELS; c++)
+        {
+            frontEnd.SetSignal(c, PdmModulator(3000.0 / PDM_CLOCK, 0.6));
+        }
+        ASSERT_EQ(Status::OK, pipeline.Start(config));
+        EXPECT_EQ(CHANNELS, frontEnd.GetChannels());
+
+        uint32_t expected = 0U;
+        for (uint32_t i = 0U; i < 8U; i++)
+        {
+            frontEnd.Convert(2U * BLOCK_FRAMES);
+            PcmBlock block{};
+            while (pipeline.Receive(block))
+            {
+                EXPECT_EQ(expected, block.sequence);
+                expected++;
+                const bool wide = format == PcmFormat::PCM24;
+                ASSERT_EQ(wide ? (CHANNELS * BLOCK_FRAMES) : 0U, block.pcm24.size());
+                ASSERT_EQ(wide ? 0U : (CHANNELS * BLOCK_FRAMES), block.pcm16.size());
+                for (size_t frame = 0U; frame < BLOCK_FRAMES; frame++)
+                {
+                    const size_t first = frame * CHANNELS;
+                    const int32_t value = wide ? block.pcm24[first] : block.pcm16[first];
+                    for (size_t c = 1U; c < CHANNELS; c++)
+                    {
+                        ASSERT_EQ(value, wide ? block.pcm24[first + c] : block.pcm16[first + c]) << frame;
+                    }
+                    if (wide)
+                    {
+                        pcm24.push_back(value);
+                    }
+                    else
+                    {
+                        // the same stream in 16 bit
+                        const size_t index = (static_cast<size_t>(block.sequence) * BLOCK_FRAMES) + frame;
+                        ASSERT_NEAR(pcm24[index] * (32767.0 / 8388607.0), value, 0.51) << index;
+                    }
+                }
+                EXPECT_TRUE(pipeline.Release(block));
+            }
+        }
+        EXPECT_EQ(16U, expected);
+        EXPECT_EQ(0U, pipeline.GetLostBlocks());
+    }
+
+    // the channels keep their order in the frame
+    PdmFrontEndSim frontEnd;
+    PdmPipeline pipeline(frontEnd);
+    Rings rings;
+    PdmConfig config = Config(rings, CHANNELS, 2U, PcmFormat::PCM16);
+    config.compensationTaps = 0U;
+    for (uint8_t c = 0U; c < CHANNELS; c++)
+    {
+        frontEnd.SetSignal(c, PdmModulator(0.0, 0.0, (c - 3.5) * 0.1));
+    }
+    ASSERT_EQ(Status::OK, pipeline.Start(config));
+    // the last block of the two rounds is the intact one
+    frontEnd.Convert(4U * BLOCK_FRAMES);
+    PcmBlock block{};
+    ASSERT_TRUE(pipeline.Receive(block));
+    EXPECT_EQ(3U, block.sequence);
+    for (size_t c = 0U; c < CHANNELS; c++)
+    {
+        EXPECT_NEAR((c - 3.5) * 0.1 * 32767.0, block.pcm16[((BLOCK_FRAMES - 1U) * CHANNELS) + c], 20.0) << c;
+    }
+}
+
+
+TEST(PdmPipeline_Test, CountsLostBlocksAndRejectsInvalidConfigs)
+{
+    PdmFrontEndSim frontEnd;
+    PdmPipeline pipeline(frontEnd);
+    Rings rings;
+    const PdmConfig config = Config(rings, 2U, 4U);
+
+    std::vector<PdmConfig> invalid(9U, config);
+    invalid[0].channels = 0U;
+    invalid[1].channels = MAX_CHANNELS + 1U;
+    invalid[2].sinc.rightShift = 7U;
+    invalid[3].compensationTaps = 4U;
+    invalid[4].highPassHz = 24000.0F;
+    invalid[5].blockFrames = 60U;
+    invalid[6].blocks = 3U;
+    invalid[7].pRaw = nullptr;
+    invalid[8].format = static_cast<PcmFormat>(2U);
+    for (const PdmConfig& bad : invalid)
+    {
+        EXPECT_EQ(Status::INVALID_PARAM, pipeline.Start(bad));
+    }
+    EXPECT_FALSE(frontEnd.IsRunning());
+
+    ASSERT_EQ(Status::OK, pipeline.Start(config));
+    EXPECT_EQ(Status::BUSY, pipeline.Start(config));
+
+    // a block is stale when the other half is written
+    frontEnd.Convert(2U * BLOCK_FRAMES);
+    PcmBlock held{};
+    ASSERT_TRUE(pipeline.Receive(held));
+    EXPECT_EQ(0U, held.sequence);
+    frontEnd.Convert(2U * BLOCK_FRAMES);
+    EXPECT_FALSE(pipeline.Release(held));
+    PcmBlock block{};
+    ASSERT_TRUE(pipeline.Receive(block));
+    EXPECT_EQ(2U, block.sequence);
+    EXPECT_TRUE(pipeline.Release(block));
+    EXPECT_EQ(4U, pipeline.GetProducedBlocks());
+    EXPECT_EQ(2U, pipeline.GetLostBlocks());
+
+    frontEnd.InjectOverrun();
+    EXPECT_EQ(1U, pipeline.GetOverruns());
+    EXPECT_TRUE(pipeline.IsRunning());
+    frontEnd.InjectFault();
+    EXPECT_FALSE(pipeline.IsRunning());
+    EXPECT_EQ(0U, frontEnd.Convert(BLOCK_FRAMES));
+
+    // a restart clears the counters
+    ASSERT_EQ(Status::OK, pipeline.Start(config));
+    EXPECT_EQ(0U, pipeline.GetProducedBlocks());
+    EXPECT_EQ(0U, pipeline.GetLostBlocks());
+    EXPECT_EQ(0U, pipeline.GetOverruns());
+    pipeline.Stop();
+    EXPECT_FALSE(frontEnd.IsRunning());
+}
+
+} // end namespace GTest
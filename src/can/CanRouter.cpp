@@ -0,0 +1,243 @@
+/**
+ ********************************************************************************
+ * @file        CanRouter.cpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, message router implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CanRouter.hpp"
+
+using namespace Can;
+
+
+CanRouter::CanRouter(ICanController& controller, const Config& config)
+: mController(controller)
+, mConfig(config)
+{
+}
+
+
+CanRouter::CanRouter(ICanController& controller)
+: CanRouter(controller, Config{})
+{
+}
+
+
+CanRouter::~CanRouter()
+{
+    Stop();
+}
+
+
+Status CanRouter::Subscribe(uint32_t first, uint32_t last, bool extended, RxFifo fifo, IHandler& handler)
+{
+    const uint32_t maxId = extended ? MAX_EXT_ID : MAX_STD_ID;
+    if (mStarted || (mRouteCount >= MAX_SUBSCRIPTIONS) || (first > last) || (last > maxId))
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (size_t i = 0U; i < mRouteCount; i++)
+    {
+        // an identifier has one handler, the hash table can't hold it twice
+        const Route& route = mRoutes[i];
+        if ((route.extended == extended) && (first <= route.last) && (route.first <= last))
+        {
+            return Status::INVALID_PARAM;
+        }
+    }
+    const uint32_t width = last - first + 1U;
+    if (width > MAX_EXPANDED_RANGE)
+    {
+        if (mWideCount >= MAX_WIDE_RANGES)
+        {
+            return Status::INVALID_PARAM;
+        }
+        mWide[mWideCount] = static_cast<uint16_t>(mRouteCount);
+        mWideCount++;
+    }
+    else
+    {
+        if ((mExpandedIds + width) > IdTable::MAX_KEYS)
+        {
+            return Status::INVALID_PARAM;
+        }
+        mExpandedIds += width;
+    }
+    mRoutes[mRouteCount] = Route{&handler, first, last, extended, fifo};
+    mRouteCount++;
+    return Status::OK;
+}
+
+
+Status CanRouter::Start()
+{
+    if (mStarted)
+    {
+        return Status::OK;
+    }
+
+    std::array<FilterCompiler::Range, MAX_SUBSCRIPTIONS> ranges{};
+    for (size_t i = 0U; i < mRouteCount; i++)
+    {
+        const Route& route = mRoutes[i];
+        ranges[i] = FilterCompiler::Range{route.first, route.last, route.extended, route.fifo};
+    }
+    Status status = mCompiler.Compile(ranges.data(), mRouteCount, mController.GetFilterCapacity(false),
+                                      mController.GetFilterCapacity(true), mFilters);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    mTable.Clear();
+    for (size_t i = 0U; i < mRouteCount; i++)
+    {
+        const Route& route = mRoutes[i];
+        if ((route.last - route.first) >= MAX_EXPANDED_RANGE)
+        {
+            continue;
+        }
+        for (uint32_t id = route.first; id <= route.last; id++)
+        {
+            (void)mTable.Add(IdTable::MakeKey(id, route.extended), static_cast<uint16_t>(i));
+        }
+    }
+    status = mTable.Build();
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    status = mController.ConfigFilters(mFilters);
+    if (status == Status::OK)
+    {
+        status = mController.SetWatermark(RxFifo::FIFO0, mConfig.watermarkFifo0);
+    }
+    if (status == Status::OK)
+    {
+        status = mController.SetWatermark(RxFifo::FIFO1, mConfig.watermarkFifo1);
+    }
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    mController.SetListener(this);
+    mStarted = true;
+    return Status::OK;
+}
+
+
+void CanRouter::Stop()
+{
+    if (!mStarted)
+    {
+        return;
+    }
+    mController.SetListener(nullptr);
+    mStarted = false;
+}
+
+
+void CanRouter::Clear()
+{
+    if (mStarted)
+    {
+        return;
+    }
+    mRouteCount = 0U;
+    mExpandedIds = 0U;
+    mWideCount = 0U;
+    mTable.Clear();
+}
+
+
+size_t CanRouter::Drain(RxFifo fifo)
+{
+    size_t total = 0U;
+    RxFifoWindow window = mController.GetRxFifo(fifo);
+    // frames which arrive during a batch are taken along, bounded to two FIFO rounds
+    while ((window.fillLevel > 0U) && (total < (2U * static_cast<size_t>(window.depth))))
+    {
+        const uint32_t dataBytes = (window.elementWords - static_cast<uint32_t>(Element::HEADER_WORDS)) * 4U;
+        uint32_t index = window.getIndex;
+        for (uint32_t n = 0U; n < window.fillLevel; n++)
+        {
+            const volatile uint32_t* pElement = &window.pBase[index * window.elementWords];
+            const uint32_t r0 = pElement[0];
+            const uint32_t r1 = pElement[1];
+
+            CanFrame frame{};
+            frame.extended = (r0 & Element::R0_XTD) != 0U;
+            frame.id = frame.extended ? (r0 & Element::R0_EXT_ID_MASK) : ((r0 >> Element::R0_STD_ID_POS) & MAX_STD_ID);
+            frame.esi = (r0 & Element::R0_ESI) != 0U;
+            frame.fd = (r1 & Element::R1_FDF) != 0U;
+            frame.brs = (r1 & Element::R1_BRS) != 0U;
+            frame.filterIndex = static_cast<uint8_t>((r1 >> Element::R1_FIDX_POS) & Element::R1_FIDX_MASK);
+            frame.timestamp = static_cast<uint16_t>(r1 & Element::R1_TS_MASK);
+            const uint8_t length = DlcToLength(r1 >> Element::R1_DLC_POS);
+            // the message RAM keeps only the configured data field size
+            frame.length = (length < dataBytes) ? length : static_cast<uint8_t>(dataBytes);
+            // the element is not written again before the acknowledge, it is read without copy
+            frame.pData = reinterpret_cast<const uint8_t*>(const_cast<const uint32_t*>(&pElement[Element::HEADER_WORDS]));
+
+            IHandler* pHandler = Lookup(frame.id, frame.extended);
+            if (pHandler != nullptr)
+            {
+                pHandler->OnFrame(frame);
+                mDispatched = mDispatched + 1U;
+            }
+            else
+            {
+                mUnmatched = mUnmatched + 1U;
+            }
+            index = ((index + 1U) == window.depth) ? 0U : (index + 1U);
+        }
+        mController.AcknowledgeRx(fifo, (index == 0U) ? (window.depth - 1U) : (index - 1U));
+        mBatches = mBatches + 1U;
+        total += window.fillLevel;
+        window = mController.GetRxFifo(fifo);
+    }
+    return total;
+}
+
+
+void CanRouter::Poll()
+{
+    if (!mStarted)
+    {
+        return;
+    }
+    (void)Drain(RxFifo::FIFO0);
+    (void)Drain(RxFifo::FIFO1);
+}
+
+
+void CanRouter::OnRxFifo(RxFifo fifo)
+{
+    (void)Drain(fifo);
+}
+
+
+CanRouter::IHandler* CanRouter::Lookup(uint32_t id, bool extended) const
+{
+    const uint16_t route = mTable.Find(IdTable::MakeKey(id, extended));
+    if (route != IdTable::NO_ROUTE)
+    {
+        return mRoutes[route].pHandler;
+    }
+    for (size_t i = 0U; i < mWideCount; i++)
+    {
+        const Route& wide = mRoutes[mWide[i]];
+        if ((wide.extended == extended) && (id >= wide.first) && (id <= wide.last))
+        {
+            return wide.pHandler;
+        }
+    }
+    return nullptr;
+}
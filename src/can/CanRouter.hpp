@@ -0,0 +1,208 @@
+/**
+ ********************************************************************************
+ * @file        CanRouter.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, message router from the FDCAN RX FIFOs to frame handlers.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "FilterCompiler.hpp"
+#include "ICanController.hpp"
+#include "IdTable.hpp"
+namespace Can {
+
+
+/**
+ * @brief   This class dispatches the received frames of an FDCAN to the handlers of the subscribed identifiers.
+ * @details The subscriptions (identifier ranges with handler and FIFO) are collected before @ref Start,
+ *          which compiles them into the hardware filter list (FilterCompiler), so the controller stores
+ *          only subscribed frames. The identifiers of ranges up to @ref MAX_EXPANDED_RANGE wide are entered
+ *          into a perfect hash (IdTable), a frame finds its handler with one table probe independent of
+ *          the count of subscriptions. Wider ranges are checked after a miss.\n
+ *          The FIFOs are drained in batches: the controller signals a FIFO when it reaches its watermark,
+ *          the router walks the filled elements in place in the message RAM, calls the handlers with a
+ *          view of each element and gives the whole batch back with one acknowledge. Frames which stay
+ *          below the watermark are picked up by @ref Poll.
+ * @note    Subscribe and Start while the controller is initialised but not started (the global filter
+ *          can only be written then).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * Subscribe/Start/Stop from one thread. Drain runs in the FDCAN interrupt, Poll must be called from a
+ * context which neither preempts nor is preempted by it (e.g. a timer interrupt of the same priority).
+ *
+ */
+class CanRouter : private ICanController::IListener
+{
+    public:
+
+        /// @brief Receiver of the frames of a subscription.
+        class IHandler
+        {
+            public:
+                /**
+                 * @brief A subscribed frame was received, called from the drain context.
+                 * @param frame     The frame, the data is valid during the call only.
+                 */
+                virtual void OnFrame(const CanFrame& frame) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IHandler() = default;
+        };
+
+        /// @brief Maximum count of subscriptions.
+        static constexpr size_t MAX_SUBSCRIPTIONS{FilterCompiler::MAX_RANGES};
+
+        /// @brief Ranges up to this width are entered identifier by identifier into the hash table.
+        static constexpr uint32_t MAX_EXPANDED_RANGE{32U};
+
+        /// @brief Maximum count of wider ranges.
+        static constexpr size_t MAX_WIDE_RANGES{8U};
+
+        /// @brief Router configuration.
+        struct Config
+        {
+            uint32_t watermarkFifo0{16U};   //!< Batch size of FIFO 0, the high rate FIFO
+            uint32_t watermarkFifo1{0U};    //!< Batch size of FIFO 1, 0 signals every frame
+        };
+
+        /**
+         * @brief   Constructs the router.
+         *
+         * @param   controller  The FDCAN.
+         * @param   config      Watermarks of the FIFOs.
+         */
+        CanRouter(ICanController& controller, const Config& config);
+
+        /// @brief Constructs the router with the default watermarks.
+        explicit CanRouter(ICanController& controller);
+
+        /// @brief Destructor, unbinds the controller.
+        ~CanRouter();
+
+        CanRouter(CanRouter const &) = delete;             //!< Copy constructor
+        CanRouter& operator=(CanRouter const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Subscribe a range of identifiers.
+         *
+         * @param   first       First identifier.
+         * @param   last        Last identifier (inclusive).
+         * @param   extended    29 bit identifiers.
+         * @param   fifo        FIFO of the frames, FIFO 0 for high rate traffic.
+         * @param   handler     Receiver of the frames.
+         *
+         * @return  OK, INVALID_PARAM for invalid identifiers, an overlap with a subscribed range, a full table
+         *          or a started router.
+         */
+        Status Subscribe(uint32_t first, uint32_t last, bool extended, RxFifo fifo, IHandler& handler);
+
+        /// @brief Subscribe a single identifier, see above.
+        Status Subscribe(uint32_t id, bool extended, RxFifo fifo, IHandler& handler)
+        {
+            return Subscribe(id, id, extended, fifo, handler);
+        };
+
+        /**
+         * @brief   Compile the filters, build the identifier table and bind the controller.
+         *
+         * @return  OK, INVALID_PARAM for overlapping subscriptions or filters which do not fit, HW_ERROR.
+         */
+        Status Start();
+
+        /// @brief Unbind the controller, the subscriptions are kept.
+        void Stop();
+
+        /// @brief Remove all subscriptions of a stopped router.
+        void Clear();
+
+        /**
+         * @brief   Dispatch the elements of a FIFO.
+         *
+         * @param   fifo    The FIFO.
+         *
+         * @return  Count of read elements.
+         */
+        size_t Drain(RxFifo fifo);
+
+        /// @brief Drain both FIFOs, also elements below the watermark.
+        void Poll();
+
+        /// @brief The compiled filter list.
+        const FilterSet& GetFilters() const {return mFilters;};
+
+        /// @brief Frames passed to a handler.
+        uint32_t GetDispatched() const {return mDispatched;};
+
+        /// @brief Frames without subscription, passed by merged filters.
+        uint32_t GetUnmatched() const {return mUnmatched;};
+
+        /// @brief Count of batches (acknowledges).
+        uint32_t GetBatches() const {return mBatches;};
+
+    private:
+
+        /// @brief One subscription.
+        struct Route
+        {
+            IHandler* pHandler{nullptr};    //!< Receiver
+            uint32_t first{0U};             //!< First identifier
+            uint32_t last{0U};              //!< Last identifier
+            bool extended{false};           //!< 29 bit identifiers
+            RxFifo fifo{RxFifo::FIFO0};     //!< FIFO
+        };
+
+        /// @brief Controller event, see ICanController::IListener.
+        void OnRxFifo(RxFifo fifo) override;
+
+        /// @brief The handler of a received identifier or nullptr.
+        IHandler* Lookup(uint32_t id, bool extended) const;
+
+        /// @brief The FDCAN.
+        ICanController& mController;
+
+        /// @brief Watermarks.
+        const Config mConfig;
+
+        /// @brief Subscriptions in the order of Subscribe.
+        std::array<Route, MAX_SUBSCRIPTIONS> mRoutes{};
+
+        /// @brief Count of subscriptions.
+        size_t mRouteCount{0U};
+
+        /// @brief Identifiers entered into the table.
+        size_t mExpandedIds{0U};
+
+        /// @brief Indices of the wide routes.
+        std::array<uint16_t, MAX_WIDE_RANGES> mWide{};
+
+        /// @brief Count of wide routes.
+        size_t mWideCount{0U};
+
+        /// @brief Perfect hash of the narrow routes.
+        IdTable mTable{};
+
+        /// @brief Filter compiler, keeps its working list off the stack.
+        FilterCompiler mCompiler{};
+
+        /// @brief Compiled filters.
+        FilterSet mFilters{};
+
+        /// @brief The controller is bound.
+        bool mStarted{false};
+
+        volatile uint32_t mDispatched{0U};  //!< Frames passed to a handler
+        volatile uint32_t mUnmatched{0U};   //!< Frames without handler
+        volatile uint32_t mBatches{0U};     //!< Acknowledged batches
+};
+
+} // end namespace Can
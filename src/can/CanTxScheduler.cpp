@@ -0,0 +1,250 @@
+/**
+ ********************************************************************************
+ * @file        CanTxScheduler.cpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, transmit scheduler implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CanTxScheduler.hpp"
+#include "CriticalSection.hpp"
+
+using namespace Can;
+
+
+CanTxScheduler::CanTxScheduler(ICanController& controller, const Utils::ITimeSource& clock, const Config& config)
+: mController(controller)
+, mClock(clock)
+, mMaxInFlight((config.maxInFlight == 0U) ? 1U :
+               ((config.maxInFlight < MAX_TX_ELEMENTS) ? config.maxInFlight : static_cast<uint32_t>(MAX_TX_ELEMENTS)))
+{
+}
+
+
+CanTxScheduler::CanTxScheduler(ICanController& controller, const Utils::ITimeSource& clock)
+: CanTxScheduler(controller, clock, Config{})
+{
+}
+
+
+CanTxScheduler::~CanTxScheduler()
+{
+    Stop();
+}
+
+
+Status CanTxScheduler::SetClass(uint32_t first, uint32_t last, bool extended, TxClass txClass)
+{
+    const uint32_t maxId = extended ? MAX_EXT_ID : MAX_STD_ID;
+    if ((mRangeCount >= MAX_CLASS_RANGES) || (first > last) || (last > maxId))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mRanges[mRangeCount] = ClassRange{first, last, extended, txClass};
+    mRangeCount++;
+    return Status::OK;
+}
+
+
+void CanTxScheduler::Start()
+{
+    Utils::CriticalSection lock;
+    if (mStarted)
+    {
+        return;
+    }
+    mController.SetTxListener(this);
+    mStarted = true;
+    Refill();
+}
+
+
+void CanTxScheduler::Stop()
+{
+    Utils::CriticalSection lock;
+    if (!mStarted)
+    {
+        return;
+    }
+    mController.SetTxListener(nullptr);
+    mStarted = false;
+}
+
+
+Status CanTxScheduler::Submit(TxRequest& request)
+{
+    const TxFrame& frame = request.frame;
+    const uint32_t maxId = frame.extended ? MAX_EXT_ID : MAX_STD_ID;
+    if ((frame.id > maxId) || (frame.length > MAX_DATA_SIZE) || ((frame.length > 8U) && !frame.fd) ||
+        ((frame.length > 0U) && (frame.pData == nullptr)) || (request.status == Status::PENDING))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    request.txClass = Classify(frame.id, frame.extended);
+    request.submitNs = mClock.GetTimeNs();
+    request.doneNs = 0U;
+    request.pNext = nullptr;
+    request.status = Status::PENDING;
+
+    Utils::CriticalSection lock;
+    Queue& queue = mQueues[static_cast<size_t>(request.txClass)];
+    if (queue.pTail == nullptr)
+    {
+        queue.pHead = &request;
+    }
+    else
+    {
+        queue.pTail->pNext = &request;
+    }
+    queue.pTail = &request;
+    queue.count++;
+    Refill();
+    return Status::OK;
+}
+
+
+void CanTxScheduler::Service()
+{
+    bool more = true;
+    while (more)
+    {
+        TxRequest* pDone = nullptr;
+        {
+            Utils::CriticalSection lock;
+            TxEvent event{};
+            more = mController.GetTxEvent(event);
+            if (more)
+            {
+                pDone = Complete(event);
+            }
+        }
+        if (pDone != nullptr)
+        {
+            // the callback may submit the same handle again
+            const TxRequest::Callback pCallback = pDone->pCallback;
+            void* const pContext = pDone->pContext;
+            pDone->status = Status::OK;
+            if (pCallback != nullptr)
+            {
+                pCallback(*pDone, pContext);
+            }
+        }
+    }
+
+    // one batch for all elements the events have freed
+    Utils::CriticalSection lock;
+    Refill();
+}
+
+
+TxClass CanTxScheduler::Classify(uint32_t id, bool extended) const
+{
+    for (size_t i = 0U; i < mRangeCount; i++)
+    {
+        const ClassRange& range = mRanges[i];
+        if ((range.extended == extended) && (id >= range.first) && (id <= range.last))
+        {
+            return range.txClass;
+        }
+    }
+    return TxClass::NORMAL;
+}
+
+
+CanTxScheduler::Latency CanTxScheduler::GetLatency(TxClass txClass) const
+{
+    Utils::CriticalSection lock;
+    return mLatency[static_cast<size_t>(txClass)];
+}
+
+
+void CanTxScheduler::OnTxEvent()
+{
+    Service();
+}
+
+
+void CanTxScheduler::Refill()
+{
+    if (!mStarted)
+    {
+        return;
+    }
+    uint32_t free = mController.GetTxFreeLevel();
+    bool added = false;
+    while ((mInFlight < mMaxInFlight) && (free > 0U))
+    {
+        Queue* pQueue = nullptr;
+        for (Queue& queue : mQueues)
+        {
+            if (queue.pHead != nullptr)
+            {
+                pQueue = &queue;
+                break;
+            }
+        }
+        if (pQueue == nullptr)
+        {
+            break;
+        }
+
+        // a free slot exists while mInFlight < mMaxInFlight <= MAX_TX_ELEMENTS
+        size_t slot = 0U;
+        while (mSlots[slot] != nullptr)
+        {
+            slot++;
+        }
+        TxRequest* pRequest = pQueue->pHead;
+        if (mController.AddTx(pRequest->frame, static_cast<uint8_t>(slot)) != Status::OK)
+        {
+            // retried with the next TX event or Submit
+            break;
+        }
+        pQueue->pHead = pRequest->pNext;
+        if (pQueue->pHead == nullptr)
+        {
+            pQueue->pTail = nullptr;
+        }
+        pQueue->count--;
+        pRequest->pNext = nullptr;
+        mSlots[slot] = pRequest;
+        mInFlight = mInFlight + 1U;
+        free--;
+        added = true;
+    }
+    if (added)
+    {
+        mRefills = mRefills + 1U;
+    }
+}
+
+
+TxRequest* CanTxScheduler::Complete(const TxEvent& event)
+{
+    TxRequest* pRequest = (event.marker < MAX_TX_ELEMENTS) ? mSlots[event.marker] : nullptr;
+    if ((pRequest == nullptr) || (pRequest->frame.id != event.id) || (pRequest->frame.extended != event.extended))
+    {
+        mUnmatched = mUnmatched + 1U;
+        return nullptr;
+    }
+    mSlots[event.marker] = nullptr;
+    mInFlight = mInFlight - 1U;
+
+    pRequest->doneNs = mClock.GetTimeNs();
+    pRequest->timestamp = event.timestamp;
+    const uint64_t latency = pRequest->doneNs - pRequest->submitNs;
+    Latency& stats = mLatency[static_cast<size_t>(pRequest->txClass)];
+    stats.count++;
+    stats.totalNs += latency;
+    if (latency > stats.maxNs)
+    {
+        stats.maxNs = latency;
+    }
+    return pRequest;
+}
@@ -0,0 +1,188 @@
+/**
+ ********************************************************************************
+ * @file        CanTxScheduler.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, transmit scheduler with priority classes over the FDCAN TX queue.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICanController.hpp"
+#include "ITimeSource.hpp"
+namespace Can {
+
+
+/**
+ * @brief   This class schedules transmit requests of several priority classes onto one FDCAN.
+ * @details Every identifier belongs to a class (@ref SetClass, NORMAL if not configured). Each class
+ *          has its own software queue, the classes are served in strict priority: CONTROL before
+ *          NORMAL before BULK, so bulk transfers only use the bus time the other classes leave idle.\n
+ *          The hardware gets at most @ref Config::maxInFlight elements. A control frame therefore waits
+ *          for at most this count of frames already handed to the FDCAN plus the frame on the wire,
+ *          independent of the length of the bulk queue. In queue mode the FDCAN itself sends the lowest
+ *          identifier first, which shortens this further when control frames have the lower identifiers.\n
+ *          Every element carries its in-flight slot as message marker. The TX event interrupt reads all
+ *          stored events, matches them back to the request handles, completes them with the latency
+ *          (time source at Submit to time source at the event) and refills all free elements in one batch.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.\n
+ * Submit may be called from threads and ISR's, the completion path runs in the TX event interrupt.
+ * SetClass/Start/Stop from one thread before the traffic starts.
+ *
+ */
+class CanTxScheduler : private ICanController::ITxListener
+{
+    public:
+
+        /// @brief Maximum count of class ranges.
+        static constexpr size_t MAX_CLASS_RANGES{16U};
+
+        /// @brief Scheduler configuration.
+        struct Config
+        {
+            uint32_t maxInFlight{4U};   //!< Elements handed to the FDCAN at once, bounds the wait of control frames
+        };
+
+        /// @brief Latency statistics of one class.
+        struct Latency
+        {
+            uint32_t count{0U};         //!< Completed requests
+            uint64_t totalNs{0U};       //!< Sum of the latencies
+            uint64_t maxNs{0U};         //!< Worst latency
+        };
+
+        /**
+         * @brief   Constructs the scheduler.
+         *
+         * @param   controller  The FDCAN.
+         * @param   clock       Time base of the latency measurement.
+         * @param   config      Limit of the in-flight elements.
+         */
+        CanTxScheduler(ICanController& controller, const Utils::ITimeSource& clock, const Config& config);
+
+        /// @brief Constructs the scheduler with the default configuration.
+        CanTxScheduler(ICanController& controller, const Utils::ITimeSource& clock);
+
+        /// @brief Destructor, unbinds the controller.
+        ~CanTxScheduler();
+
+        CanTxScheduler(CanTxScheduler const &) = delete;             //!< Copy constructor
+        CanTxScheduler& operator=(CanTxScheduler const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Assign a range of identifiers to a class, the first matching range wins.
+         *
+         * @param   first       First identifier.
+         * @param   last        Last identifier (inclusive).
+         * @param   extended    29 bit identifiers.
+         * @param   txClass     The class.
+         *
+         * @return  OK, INVALID_PARAM for invalid identifiers or a full table.
+         */
+        Status SetClass(uint32_t first, uint32_t last, bool extended, TxClass txClass);
+
+        /// @brief Bind the TX event interrupt and hand queued requests to the FDCAN.
+        void Start();
+
+        /// @brief Unbind the controller, queued requests stay queued.
+        void Stop();
+
+        /**
+         * @brief   Queue a request, the handle is owned by the scheduler until completion.
+         *
+         * @param   request     The request, status PENDING until the TX event.
+         *
+         * @return  OK, INVALID_PARAM for an invalid frame or a pending request.
+         */
+        Status Submit(TxRequest& request);
+
+        /// @brief Read the TX events and refill the FDCAN, also called by the TX event interrupt.
+        void Service();
+
+        /// @brief Class of an identifier.
+        TxClass Classify(uint32_t id, bool extended) const;
+
+        /// @brief Requests waiting in the software queue of a class.
+        uint32_t GetQueued(TxClass txClass) const {return mQueues[static_cast<size_t>(txClass)].count;};
+
+        /// @brief Elements handed to the FDCAN and not yet confirmed by a TX event.
+        uint32_t GetInFlight() const {return mInFlight;};
+
+        /// @brief Latency statistics of a class.
+        Latency GetLatency(TxClass txClass) const;
+
+        /// @brief Count of refill batches which handed at least one element to the FDCAN.
+        uint32_t GetRefills() const {return mRefills;};
+
+        /// @brief TX events without in-flight request.
+        uint32_t GetUnmatched() const {return mUnmatched;};
+
+    private:
+
+        /// @brief One class range.
+        struct ClassRange
+        {
+            uint32_t first{0U};                 //!< First identifier
+            uint32_t last{0U};                  //!< Last identifier
+            bool extended{false};               //!< 29 bit identifiers
+            TxClass txClass{TxClass::NORMAL};   //!< Class
+        };
+
+        /// @brief Intrusive queue of one class.
+        struct Queue
+        {
+            TxRequest* pHead{nullptr};  //!< Oldest request
+            TxRequest* pTail{nullptr};  //!< Newest request
+            uint32_t count{0U};         //!< Queued requests
+        };
+
+        /// @brief Controller event, see ICanController::ITxListener.
+        void OnTxEvent() override;
+
+        /// @brief Hand queued requests to the free elements, called in the critical section.
+        void Refill();
+
+        /// @brief Remove the request of an event from the in-flight slots, nullptr if unknown.
+        TxRequest* Complete(const TxEvent& event);
+
+        /// @brief The FDCAN.
+        ICanController& mController;
+
+        /// @brief Time base of the latencies.
+        const Utils::ITimeSource& mClock;
+
+        /// @brief In-flight limit, clamped to MAX_TX_ELEMENTS.
+        const uint32_t mMaxInFlight;
+
+        /// @brief Class ranges in the order of SetClass.
+        std::array<ClassRange, MAX_CLASS_RANGES> mRanges{};
+
+        /// @brief Count of class ranges.
+        size_t mRangeCount{0U};
+
+        /// @brief Software queues per class.
+        std::array<Queue, TX_CLASS_COUNT> mQueues{};
+
+        /// @brief Requests in the FDCAN, indexed by message marker.
+        std::array<TxRequest*, MAX_TX_ELEMENTS> mSlots{};
+
+        /// @brief Latency statistics per class.
+        std::array<Latency, TX_CLASS_COUNT> mLatency{};
+
+        /// @brief The controller is bound.
+        bool mStarted{false};
+
+        volatile uint32_t mInFlight{0U};    //!< Occupied slots
+        volatile uint32_t mRefills{0U};     //!< Refill batches
+        volatile uint32_t mUnmatched{0U};   //!< Unknown markers
+};
+
+} // end namespace Can
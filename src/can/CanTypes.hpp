@@ -0,0 +1,221 @@
+/**
+ ********************************************************************************
+ * @file        CanTypes.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, common types and message RAM layout of the FDCAN peripheral.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+namespace Can {
+
+
+/// @brief Largest data field of a CAN-FD frame.
+constexpr size_t MAX_DATA_SIZE{64U};
+
+/// @brief Largest standard (11 bit) identifier.
+constexpr uint32_t MAX_STD_ID{0x7FFU};
+
+/// @brief Largest extended (29 bit) identifier.
+constexpr uint32_t MAX_EXT_ID{0x1FFFFFFFU};
+
+/// @brief Standard filter elements of one FDCAN (FDCAN_InitTypeDef::StdFiltersNbr).
+constexpr size_t MAX_STD_FILTERS{128U};
+
+/// @brief Extended filter elements of one FDCAN (FDCAN_InitTypeDef::ExtFiltersNbr).
+constexpr size_t MAX_EXT_FILTERS{64U};
+
+/// @brief Elements of one RX FIFO.
+constexpr size_t MAX_FIFO_DEPTH{64U};
+
+/// @brief TX buffers of one FDCAN (dedicated buffers and FIFO/queue elements together).
+constexpr size_t MAX_TX_ELEMENTS{32U};
+
+
+/// @brief Result of a CAN operation.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< No free element, retry later
+    INVALID_PARAM=2,  //!< Inconsistent parameter (identifier, overlap, capacity)
+    HW_ERROR=3,       //!< The FDCAN reported an error
+    PENDING=4         //!< Request is queued or on the bus
+};
+
+/// @brief RX FIFO of the message RAM.
+enum class RxFifo : uint8_t
+{
+    FIFO0=0,    //!< RX FIFO 0
+    FIFO1=1     //!< RX FIFO 1
+};
+
+/// @brief Count of RX FIFOs.
+constexpr size_t RX_FIFO_COUNT{2U};
+
+
+/// @brief Filter element types (SFT / EFT of the message RAM).
+enum class FilterType : uint8_t
+{
+    RANGE=0,    //!< id1 to id2
+    DUAL=1,     //!< id1 or id2
+    MASK=2      //!< id1 is the filter, id2 the mask
+};
+
+/// @brief One compiled filter element.
+struct FilterElement
+{
+    FilterType type{FilterType::RANGE};     //!< Element type
+    RxFifo fifo{RxFifo::FIFO0};             //!< Destination of matching frames
+    uint32_t id1{0U};                       //!< First identifier
+    uint32_t id2{0U};                       //!< Second identifier (range end, second ID or mask)
+};
+
+/// @brief The filter list of one FDCAN.
+struct FilterSet
+{
+    std::array<FilterElement, MAX_STD_FILTERS> standard{};  //!< Standard elements
+    size_t standardCount{0U};                               //!< Used standard elements
+    std::array<FilterElement, MAX_EXT_FILTERS> extended{};  //!< Extended elements
+    size_t extendedCount{0U};                               //!< Used extended elements
+
+    /// @brief False if ranges were merged to fit and the filters also pass unsubscribed identifiers.
+    bool exact{true};
+};
+
+
+/**
+ * @brief   A received frame, a view of the element in the message RAM.
+ * @note    pData points into the RX FIFO and is valid only during the handler call.
+ */
+struct CanFrame
+{
+    uint32_t id{0U};                //!< Identifier
+    bool extended{false};           //!< 29 bit identifier
+    bool fd{false};                 //!< FD format
+    bool brs{false};                //!< Bit rate switch
+    bool esi{false};                //!< Error state of the transmitter
+    uint8_t length{0U};             //!< Data bytes, decoded from the DLC
+    uint8_t filterIndex{0U};        //!< Index of the matching filter element
+    uint16_t timestamp{0U};         //!< RX timestamp counter
+    const uint8_t* pData{nullptr};  //!< Data bytes
+};
+
+
+/// @brief Transmit classes of the scheduler, in the order of priority.
+enum class TxClass : uint8_t
+{
+    CONTROL=0,  //!< Control frames, bounded latency
+    NORMAL=1,   //!< Periodic process data
+    BULK=2      //!< Transfers which fill the idle bus time
+};
+
+/// @brief Count of transmit classes.
+constexpr size_t TX_CLASS_COUNT{3U};
+
+/// @brief A frame to transmit, the data is copied into the message RAM by ICanController::AddTx.
+struct TxFrame
+{
+    uint32_t id{0U};                //!< Identifier
+    bool extended{false};           //!< 29 bit identifier
+    bool fd{false};                 //!< FD format, required for more than 8 bytes
+    bool brs{false};                //!< Bit rate switch of the data phase
+    uint8_t length{0U};             //!< Data bytes, rounded up to the next DLC length with zero padding
+    const uint8_t* pData{nullptr};  //!< Data bytes, may be nullptr for length 0
+};
+
+/// @brief One element of the TX event FIFO.
+struct TxEvent
+{
+    uint32_t id{0U};                //!< Identifier
+    bool extended{false};           //!< 29 bit identifier
+    uint8_t marker{0U};             //!< Message marker of the TX element
+    uint16_t timestamp{0U};         //!< Timestamp counter at the start of frame
+};
+
+/**
+ * @brief   Handle of one transmit request.
+ * @details The handle and the data are owned by the caller and must stay valid until the completion
+ *          callback has been called (or @ref status left PENDING). The times are taken from the time
+ *          source of the scheduler, doneNs - submitNs is the latency from Submit to the TX event.
+ */
+struct TxRequest
+{
+    /// @brief Completion callback, called in the TX event context (ISR on the target).
+    using Callback = void (*)(TxRequest& request, void* pContext);
+
+    TxFrame frame{};                    //!< The frame
+
+    Callback pCallback{nullptr};        //!< Optional completion callback
+    void* pContext{nullptr};            //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or on the bus.
+    volatile Status status{Status::OK};
+
+    TxClass txClass{TxClass::NORMAL};   //!< Class of the identifier, written by the scheduler
+    uint64_t submitNs{0U};              //!< Time of Submit
+    uint64_t doneNs{0U};                //!< Time the TX event was read
+    uint16_t timestamp{0U};             //!< Timestamp counter of the TX event
+
+    /// @brief Intrusive queue link, owned by the scheduler.
+    TxRequest* pNext{nullptr};
+};
+
+
+/**
+ * @brief   Bit layout of the RX element header (RM0433, FDCAN RX buffer and FIFO element).
+ * @details R0 holds the identifier, R1 the length, format and filter index. The data words follow.
+ */
+namespace Element {
+
+constexpr size_t HEADER_WORDS{2U};                  //!< R0, R1
+
+constexpr uint32_t R0_ESI{1UL << 31U};              //!< Error state indicator
+constexpr uint32_t R0_XTD{1UL << 30U};              //!< Extended identifier
+constexpr uint32_t R0_RTR{1UL << 29U};              //!< Remote frame
+constexpr uint32_t R0_EXT_ID_MASK{0x1FFFFFFFU};     //!< Extended identifier
+constexpr uint32_t R0_STD_ID_POS{18U};              //!< Position of the standard identifier
+
+constexpr uint32_t R1_ANMF{1UL << 31U};             //!< Accepted non-matching frame
+constexpr uint32_t R1_FIDX_POS{24U};                //!< Position of the filter index
+constexpr uint32_t R1_FIDX_MASK{0x7FU};             //!< Filter index
+constexpr uint32_t R1_FDF{1UL << 21U};              //!< FD format
+constexpr uint32_t R1_BRS{1UL << 20U};              //!< Bit rate switch
+constexpr uint32_t R1_DLC_POS{16U};                 //!< Position of the DLC
+constexpr uint32_t R1_DLC_MASK{0xFU};               //!< DLC
+constexpr uint32_t R1_TS_MASK{0xFFFFU};             //!< RX timestamp
+
+} // end namespace Element
+
+
+/// @brief Data bytes of a DLC.
+constexpr uint8_t DlcToLength(uint32_t dlc)
+{
+    constexpr std::array<uint8_t, 16> LENGTHS{0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+    return LENGTHS[dlc & 0xFU];
+}
+
+/// @brief Smallest DLC which holds length bytes.
+constexpr uint32_t LengthToDlc(size_t length)
+{
+    if (length <= 8U)
+    {
+        return static_cast<uint32_t>(length);
+    }
+    uint32_t dlc = 9U;
+    while ((dlc < 15U) && (DlcToLength(dlc) < length))
+    {
+        dlc++;
+    }
+    return dlc;
+}
+
+} // end namespace Can
@@ -0,0 +1,336 @@
+/**
+ ********************************************************************************
+ * @file        FdcanHal.cpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, FDCAN controller implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FdcanHal.hpp"
+#include <cstring>
+
+using namespace Can;
+
+std::array<FdcanHal*, FdcanHal::INSTANCE_COUNT> FdcanHal::sInstances{};
+
+namespace {
+
+/// @brief HAL filter type of an element.
+uint32_t ToHalType(FilterType type, bool extended)
+{
+    switch (type)
+    {
+        case FilterType::DUAL:
+            return FDCAN_FILTER_DUAL;
+        case FilterType::MASK:
+            return FDCAN_FILTER_MASK;
+        default:
+            // the extended ID mask must not narrow a range
+            return extended ? FDCAN_FILTER_RANGE_NO_EIDM : FDCAN_FILTER_RANGE;
+    }
+}
+
+/// @brief Write one filter list, the unused elements are disabled.
+bool WriteFilters(FDCAN_HandleTypeDef& hfdcan, const FilterElement* pElements, size_t count, size_t capacity,
+                  bool extended)
+{
+    for (size_t i = 0U; i < capacity; i++)
+    {
+        FDCAN_FilterTypeDef config{};
+        config.IdType = extended ? FDCAN_EXTENDED_ID : FDCAN_STANDARD_ID;
+        config.FilterIndex = static_cast<uint32_t>(i);
+        if (i < count)
+        {
+            const FilterElement& element = pElements[i];
+            config.FilterType = ToHalType(element.type, extended);
+            config.FilterConfig = (element.fifo == RxFifo::FIFO0) ? FDCAN_FILTER_TO_RXFIFO0 : FDCAN_FILTER_TO_RXFIFO1;
+            config.FilterID1 = element.id1;
+            config.FilterID2 = element.id2;
+        }
+        else
+        {
+            config.FilterType = FDCAN_FILTER_DUAL;
+            config.FilterConfig = FDCAN_FILTER_DISABLE;
+        }
+        if (HAL_FDCAN_ConfigFilter(&hfdcan, &config) != HAL_OK)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // end anonymous namespace
+
+
+FdcanHal::FdcanHal(FDCAN_HandleTypeDef& hfdcan)
+: mHfdcan(hfdcan)
+{
+    const size_t slot = (hfdcan.Instance == FDCAN2) ? 1U : 0U;
+    sInstances[slot] = this;
+}
+
+
+FdcanHal::~FdcanHal()
+{
+    Stop();
+    for (FdcanHal*& pInstance : sInstances)
+    {
+        if (pInstance == this)
+        {
+            pInstance = nullptr;
+        }
+    }
+}
+
+
+Status FdcanHal::Start()
+{
+    uint32_t interrupts = FDCAN_IT_RX_FIFO0_MESSAGE_LOST | FDCAN_IT_RX_FIFO1_MESSAGE_LOST;
+    interrupts |= (mWatermark[0] > 0U) ? FDCAN_IT_RX_FIFO0_WATERMARK : FDCAN_IT_RX_FIFO0_NEW_MESSAGE;
+    interrupts |= (mWatermark[1] > 0U) ? FDCAN_IT_RX_FIFO1_WATERMARK : FDCAN_IT_RX_FIFO1_NEW_MESSAGE;
+    interrupts |= FDCAN_IT_TX_EVT_FIFO_NEW_DATA | FDCAN_IT_TX_EVT_FIFO_ELT_LOST;
+    if ((HAL_FDCAN_ActivateNotification(&mHfdcan, interrupts, 0U) != HAL_OK) || (HAL_FDCAN_Start(&mHfdcan) != HAL_OK))
+    {
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+void FdcanHal::Stop()
+{
+    if (mHfdcan.State == HAL_FDCAN_STATE_BUSY)
+    {
+        (void)HAL_FDCAN_Stop(&mHfdcan);
+    }
+}
+
+
+Status FdcanHal::ConfigFilters(const FilterSet& filters)
+{
+    const size_t stdCapacity = GetFilterCapacity(false);
+    const size_t extCapacity = GetFilterCapacity(true);
+    if ((filters.standardCount > stdCapacity) || (filters.extendedCount > extCapacity))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (!WriteFilters(mHfdcan, filters.standard.data(), filters.standardCount, stdCapacity, false) ||
+        !WriteFilters(mHfdcan, filters.extended.data(), filters.extendedCount, extCapacity, true))
+    {
+        return Status::HW_ERROR;
+    }
+    if (HAL_FDCAN_ConfigGlobalFilter(&mHfdcan, FDCAN_REJECT, FDCAN_REJECT, FDCAN_REJECT_REMOTE,
+                                     FDCAN_REJECT_REMOTE) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+size_t FdcanHal::GetFilterCapacity(bool extended) const
+{
+    return extended ? mHfdcan.Init.ExtFiltersNbr : mHfdcan.Init.StdFiltersNbr;
+}
+
+
+Status FdcanHal::SetWatermark(RxFifo fifo, uint32_t level)
+{
+    const uint32_t depth = (fifo == RxFifo::FIFO0) ? mHfdcan.Init.RxFifo0ElmtsNbr : mHfdcan.Init.RxFifo1ElmtsNbr;
+    if (level > depth)
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (HAL_FDCAN_ConfigFifoWatermark(&mHfdcan, (fifo == RxFifo::FIFO0) ? FDCAN_CFG_RX_FIFO0 : FDCAN_CFG_RX_FIFO1,
+                                      level) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+    mWatermark[static_cast<size_t>(fifo)] = level;
+    return Status::OK;
+}
+
+
+RxFifoWindow FdcanHal::GetRxFifo(RxFifo fifo) const
+{
+    RxFifoWindow window{};
+    if (fifo == RxFifo::FIFO0)
+    {
+        const uint32_t status = READ_REG(mHfdcan.Instance->RXF0S);
+        window.pBase = reinterpret_cast<const volatile uint32_t*>(mHfdcan.msgRam.RxFIFO0SA);
+        window.elementWords = mHfdcan.Init.RxFifo0ElmtSize;
+        window.depth = mHfdcan.Init.RxFifo0ElmtsNbr;
+        window.getIndex = (status & FDCAN_RXF0S_F0GI) >> FDCAN_RXF0S_F0GI_Pos;
+        window.fillLevel = (status & FDCAN_RXF0S_F0FL) >> FDCAN_RXF0S_F0FL_Pos;
+    }
+    else
+    {
+        const uint32_t status = READ_REG(mHfdcan.Instance->RXF1S);
+        window.pBase = reinterpret_cast<const volatile uint32_t*>(mHfdcan.msgRam.RxFIFO1SA);
+        window.elementWords = mHfdcan.Init.RxFifo1ElmtSize;
+        window.depth = mHfdcan.Init.RxFifo1ElmtsNbr;
+        window.getIndex = (status & FDCAN_RXF1S_F1GI) >> FDCAN_RXF1S_F1GI_Pos;
+        window.fillLevel = (status & FDCAN_RXF1S_F1FL) >> FDCAN_RXF1S_F1FL_Pos;
+    }
+    return window;
+}
+
+
+void FdcanHal::AcknowledgeRx(RxFifo fifo, uint32_t index)
+{
+    // the FDCAN releases all elements from the get index up to the acknowledged one
+    if (fifo == RxFifo::FIFO0)
+    {
+        WRITE_REG(mHfdcan.Instance->RXF0A, index);
+    }
+    else
+    {
+        WRITE_REG(mHfdcan.Instance->RXF1A, index);
+    }
+}
+
+
+void FdcanHal::OnRxFifo(RxFifo fifo, uint32_t interrupts)
+{
+    const uint32_t lostFlag = (fifo == RxFifo::FIFO0) ? FDCAN_IT_RX_FIFO0_MESSAGE_LOST : FDCAN_IT_RX_FIFO1_MESSAGE_LOST;
+    if ((interrupts & lostFlag) != 0U)
+    {
+        mLost[static_cast<size_t>(fifo)] = mLost[static_cast<size_t>(fifo)] + 1U;
+    }
+    if (mpListener != nullptr)
+    {
+        mpListener->OnRxFifo(fifo);
+    }
+}
+
+
+uint32_t FdcanHal::GetTxFreeLevel() const
+{
+    return HAL_FDCAN_GetTxFifoFreeLevel(&mHfdcan);
+}
+
+
+Status FdcanHal::AddTx(const TxFrame& frame, uint8_t marker)
+{
+    const uint32_t maxId = frame.extended ? MAX_EXT_ID : MAX_STD_ID;
+    if ((frame.id > maxId) || (frame.length > MAX_DATA_SIZE) || ((frame.length > 8U) && !frame.fd) ||
+        ((frame.length > 0U) && (frame.pData == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    FDCAN_TxHeaderTypeDef header{};
+    header.Identifier = frame.id;
+    header.IdType = frame.extended ? FDCAN_EXTENDED_ID : FDCAN_STANDARD_ID;
+    header.TxFrameType = FDCAN_DATA_FRAME;
+    header.DataLength = LengthToDlc(frame.length);
+    header.ErrorStateIndicator = FDCAN_ESI_ACTIVE;
+    header.BitRateSwitch = frame.brs ? FDCAN_BRS_ON : FDCAN_BRS_OFF;
+    header.FDFormat = frame.fd ? FDCAN_FD_CAN : FDCAN_CLASSIC_CAN;
+    header.TxEventFifoControl = FDCAN_STORE_TX_EVENTS;
+    header.MessageMarker = marker;
+
+    // the HAL copies whole words up to the DLC length, shorter data is padded on the stack
+    const uint8_t* pData = frame.pData;
+    std::array<uint8_t, MAX_DATA_SIZE> padded{};
+    const uint8_t dlcLength = DlcToLength(header.DataLength);
+    if ((frame.length != dlcLength) || ((dlcLength % 4U) != 0U))
+    {
+        if (frame.length > 0U)
+        {
+            std::memcpy(padded.data(), frame.pData, frame.length);
+        }
+        pData = padded.data();
+    }
+
+    if (HAL_FDCAN_GetTxFifoFreeLevel(&mHfdcan) == 0U)
+    {
+        return Status::BUSY;
+    }
+    if (HAL_FDCAN_AddMessageToTxFifoQ(&mHfdcan, &header, pData) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+bool FdcanHal::GetTxEvent(TxEvent& event)
+{
+    if ((READ_REG(mHfdcan.Instance->TXEFS) & FDCAN_TXEFS_EFFL) == 0U)
+    {
+        return false;
+    }
+    FDCAN_TxEventFifoTypeDef element{};
+    if (HAL_FDCAN_GetTxEvent(&mHfdcan, &element) != HAL_OK)
+    {
+        return false;
+    }
+    event.id = element.Identifier;
+    event.extended = element.IdType == FDCAN_EXTENDED_ID;
+    event.marker = static_cast<uint8_t>(element.MessageMarker);
+    event.timestamp = static_cast<uint16_t>(element.TxTimestamp);
+    return true;
+}
+
+
+void FdcanHal::OnTxEvent(uint32_t interrupts)
+{
+    if ((interrupts & FDCAN_IT_TX_EVT_FIFO_ELT_LOST) != 0U)
+    {
+        mTxLost = mTxLost + 1U;
+    }
+    if (mpTxListener != nullptr)
+    {
+        mpTxListener->OnTxEvent();
+    }
+}
+
+
+FdcanHal* FdcanHal::GetInstance(const FDCAN_HandleTypeDef* hfdcan)
+{
+    for (FdcanHal* pInstance : sInstances)
+    {
+        if ((pInstance != nullptr) && (&pInstance->mHfdcan == hfdcan))
+        {
+            return pInstance;
+        }
+    }
+    return nullptr;
+}
+
+
+extern "C" void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef* hfdcan, uint32_t RxFifo0ITs)
+{
+    FdcanHal* pController = FdcanHal::GetInstance(hfdcan);
+    if (pController != nullptr)
+    {
+        pController->OnRxFifo(RxFifo::FIFO0, RxFifo0ITs);
+    }
+}
+
+
+extern "C" void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef* hfdcan, uint32_t RxFifo1ITs)
+{
+    FdcanHal* pController = FdcanHal::GetInstance(hfdcan);
+    if (pController != nullptr)
+    {
+        pController->OnRxFifo(RxFifo::FIFO1, RxFifo1ITs);
+    }
+}
+
+
+extern "C" void HAL_FDCAN_TxEventFifoCallback(FDCAN_HandleTypeDef* hfdcan, uint32_t TxEventFifoITs)
+{
+    FdcanHal* pController = FdcanHal::GetInstance(hfdcan);
+    if (pController != nullptr)
+    {
+        pController->OnTxEvent(TxEventFifoITs);
+    }
+}
@@ -0,0 +1,144 @@
+/**
+ ********************************************************************************
+ * @file        FdcanHal.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, ICanController on the FDCAN peripheral through HAL_FDCAN.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICanController.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace Can {
+
+
+/**
+ * @brief   This class provides the ICanController on an FDCAN instance through HAL_FDCAN.
+ * @details The filters are written with HAL_FDCAN_ConfigFilter, unused elements of the configured list
+ *          are disabled and the global filter rejects non-matching and remote frames. The RX FIFOs are
+ *          read in place: GetRxFifo reads RXFnS once per batch and hands out the FIFO start address of
+ *          the message RAM, AcknowledgeRx writes RXFnA. HAL_FDCAN_GetRxMessage is not used, it copies
+ *          every frame and acknowledges every element.\n
+ *          A FIFO with watermark raises the listener from HAL_FDCAN_RxFifoNCallback on RFnW, a FIFO
+ *          without watermark on every new element (RFnN). Lost frames (RFnL) are counted and signalled.\n
+ *          Frames are sent with HAL_FDCAN_AddMessageToTxFifoQ and store a TX event with their marker.
+ *          HAL_FDCAN_TxEventFifoCallback (TEFN) raises the TX listener, which reads the events with
+ *          HAL_FDCAN_GetTxEvent. The HAL register callbacks are disabled in this project, the weak
+ *          callbacks are overridden instead of HAL_FDCAN_RegisterTxEventFifoCallback.
+ * @note    The application initialises the handle with HAL_FDCAN_Init (bit timing, message RAM layout,
+ *          RX FIFOs in blocking mode, TxEventsNbr at least TxFifoQueueElmtsNbr), lets the router configure filters and watermarks and calls
+ *          @ref Start afterwards. FDCAN1 and FDCAN2 may have one instance each.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to read and acknowledge a FIFO from one context.
+ *
+ */
+class FdcanHal : public ICanController
+{
+    public:
+
+        /**
+         * @brief   Constructs the controller.
+         *
+         * @param   hfdcan  The initialised FDCAN handle.
+         */
+        explicit FdcanHal(FDCAN_HandleTypeDef& hfdcan);
+
+        /// @brief Destructor.
+        ~FdcanHal() override;
+
+        FdcanHal(FdcanHal const &) = delete;             //!< Copy constructor
+        FdcanHal& operator=(FdcanHal const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Enable the RX and TX event interrupts and start the FDCAN.
+         *
+         * @return  OK or HW_ERROR.
+         */
+        Status Start();
+
+        /// @brief Stop the FDCAN.
+        void Stop();
+
+        /// @copydoc ICanController::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ICanController::ConfigFilters
+        Status ConfigFilters(const FilterSet& filters) override;
+
+        /// @copydoc ICanController::GetFilterCapacity
+        size_t GetFilterCapacity(bool extended) const override;
+
+        /// @copydoc ICanController::SetWatermark
+        Status SetWatermark(RxFifo fifo, uint32_t level) override;
+
+        /// @copydoc ICanController::GetRxFifo
+        RxFifoWindow GetRxFifo(RxFifo fifo) const override;
+
+        /// @copydoc ICanController::AcknowledgeRx
+        void AcknowledgeRx(RxFifo fifo, uint32_t index) override;
+
+        /// @copydoc ICanController::GetRxLost
+        uint32_t GetRxLost(RxFifo fifo) const override {return mLost[static_cast<size_t>(fifo)];};
+
+        /// @copydoc ICanController::SetTxListener
+        void SetTxListener(ITxListener* pListener) override {mpTxListener = pListener;};
+
+        /// @copydoc ICanController::GetTxFreeLevel
+        uint32_t GetTxFreeLevel() const override;
+
+        /// @copydoc ICanController::AddTx
+        Status AddTx(const TxFrame& frame, uint8_t marker) override;
+
+        /// @copydoc ICanController::GetTxEvent
+        bool GetTxEvent(TxEvent& event) override;
+
+        /// @brief TX events a full TX event FIFO had to drop.
+        uint32_t GetTxLost() const {return mTxLost;};
+
+        /// @brief HAL_FDCAN_RxFifo0Callback / HAL_FDCAN_RxFifo1Callback.
+        void OnRxFifo(RxFifo fifo, uint32_t interrupts);
+
+        /// @brief HAL_FDCAN_TxEventFifoCallback.
+        void OnTxEvent(uint32_t interrupts);
+
+        /// @brief The instance of a handle or nullptr.
+        static FdcanHal* GetInstance(const FDCAN_HandleTypeDef* hfdcan);
+
+    private:
+
+        /// @brief Count of FDCAN peripherals.
+        static constexpr size_t INSTANCE_COUNT{2U};
+
+        /// @brief The FDCAN handle.
+        FDCAN_HandleTypeDef& mHfdcan;
+
+        /// @brief The RX listener.
+        IListener* mpListener{nullptr};
+
+        /// @brief Watermark per FIFO.
+        std::array<uint32_t, RX_FIFO_COUNT> mWatermark{};
+
+        /// @brief Lost frames per FIFO.
+        std::array<volatile uint32_t, RX_FIFO_COUNT> mLost{};
+
+        /// @brief The TX listener.
+        ITxListener* mpTxListener{nullptr};
+
+        /// @brief Lost TX events.
+        volatile uint32_t mTxLost{0U};
+
+        /// @brief The instances of FDCAN1 and FDCAN2.
+        static std::array<FdcanHal*, INSTANCE_COUNT> sInstances;
+};
+
+} // end namespace Can
@@ -0,0 +1,483 @@
+/**
+ ********************************************************************************
+ * @file        FdcanSim.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, host simulation of the FDCAN filters, RX FIFOs and TX queue in the message RAM.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICanController.hpp"
+#include <cstring>
+namespace Can {
+
+
+/**
+ * @brief   This class provides an ICanController which models the message RAM of the FDCAN on the host.
+ * @details The filter elements are encoded into words like HAL_FDCAN_ConfigFilter does and the bus side
+ *          (@ref InjectFrame) runs the acceptance filtering of the peripheral on these words: standard or
+ *          extended list in order, first match wins, non-matching frames are rejected. Accepted frames are
+ *          written as RX elements (Can::Element layout) into the FIFO, a full FIFO loses the new frame
+ *          (blocking mode). The get index, fill level and acknowledge follow the RXFnS / RXFnA registers,
+ *          the listener is called synchronously like the interrupt.\n
+ *          The FIFO depth and the data field size are template parameters, like RxFifoNElmtsNbr and
+ *          RxFifoNElmtSize of FDCAN_InitTypeDef.\n
+ *          On the TX side @ref TransmitNext lets the next pending element win the arbitration: the oldest
+ *          one in FIFO mode, the lowest identifier in queue mode (TXBC.TFQM). The sent frame leaves its
+ *          marker and timestamp in the TX event FIFO and raises the TX listener.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+template <size_t FIFO_DEPTH = MAX_FIFO_DEPTH, size_t DATA_BYTES = MAX_DATA_SIZE>
+class FdcanSim : public ICanController
+{
+    public:
+
+        static_assert((FIFO_DEPTH > 0U) && (FIFO_DEPTH <= MAX_FIFO_DEPTH), "an RX FIFO has 1 to 64 elements");
+        static_assert((DATA_BYTES >= 8U) && (DATA_BYTES <= MAX_DATA_SIZE) && ((DATA_BYTES % 4U) == 0U),
+                      "the data field has 8 to 64 bytes in full words");
+
+        /// @brief Words of one RX element.
+        static constexpr uint32_t ELEMENT_WORDS{static_cast<uint32_t>(Element::HEADER_WORDS + (DATA_BYTES / 4U))};
+
+        /**
+         * @brief   Constructs the controller.
+         *
+         * @param   stdFilters  Standard filter elements in the message RAM.
+         * @param   extFilters  Extended filter elements in the message RAM.
+         * @param   txElements  Elements of the TX FIFO/queue (TxFifoQueueElmtsNbr).
+         */
+        explicit FdcanSim(size_t stdFilters = MAX_STD_FILTERS, size_t extFilters = MAX_EXT_FILTERS,
+                          size_t txElements = MAX_TX_ELEMENTS)
+        : mStdCapacity((stdFilters < MAX_STD_FILTERS) ? stdFilters : MAX_STD_FILTERS)
+        , mExtCapacity((extFilters < MAX_EXT_FILTERS) ? extFilters : MAX_EXT_FILTERS)
+        , mTxCapacity((txElements < MAX_TX_ELEMENTS) ? txElements : MAX_TX_ELEMENTS)
+        {
+        }
+
+        FdcanSim(FdcanSim const &) = delete;             //!< Copy constructor
+        FdcanSim& operator=(FdcanSim const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Bus side: a frame is received.
+         *
+         * @param   id          Identifier.
+         * @param   extended    29 bit identifier.
+         * @param   pData       Data bytes, may be nullptr for length 0.
+         * @param   length      Data bytes, rounded up to the next DLC length.
+         * @param   timestamp   Value of the timestamp counter.
+         *
+         * @return  true if stored in a FIFO, false if rejected by the filters or lost.
+         */
+        bool InjectFrame(uint32_t id, bool extended, const uint8_t* pData, size_t length, uint16_t timestamp = 0U)
+        {
+            uint32_t filterIndex{0U};
+            RxFifo fifo{RxFifo::FIFO0};
+            if ((length > DATA_BYTES) || !Match(id, extended, filterIndex, fifo))
+            {
+                mRejected++;
+                return false;
+            }
+
+            Fifo& rx = mFifo[static_cast<size_t>(fifo)];
+            if (rx.fillLevel == FIFO_DEPTH)
+            {
+                rx.lost++;
+                Notify(fifo);
+                return false;
+            }
+
+            const uint32_t dlc = LengthToDlc(length);
+            uint32_t* pElement = &rx.ram[rx.putIndex * ELEMENT_WORDS];
+            pElement[0] = extended ? (id | Element::R0_XTD) : (id << Element::R0_STD_ID_POS);
+            pElement[1] = (filterIndex << Element::R1_FIDX_POS) | (dlc << Element::R1_DLC_POS) | timestamp |
+                          ((length > 8U) ? (Element::R1_FDF | Element::R1_BRS) : 0U);
+            uint8_t* pBytes = reinterpret_cast<uint8_t*>(&pElement[Element::HEADER_WORDS]);
+            std::memset(pBytes, 0, DATA_BYTES);
+            if (length > 0U)
+            {
+                std::memcpy(pBytes, pData, length);
+            }
+            rx.putIndex = (rx.putIndex + 1U) % FIFO_DEPTH;
+            rx.fillLevel++;
+            mReceived++;
+
+            // RFnW when the level reaches the watermark, RFnN on every element without watermark
+            if ((rx.watermark == 0U) || (rx.fillLevel == rx.watermark))
+            {
+                Notify(fifo);
+            }
+            return true;
+        }
+
+        /**
+         * @brief   Bus side: the next pending TX element wins the arbitration and is sent.
+         *
+         * @param   frame       The sent frame, the data is valid until the next TransmitNext.
+         * @param   timestamp   Value of the timestamp counter.
+         *
+         * @return  false if no element is pending.
+         */
+        bool TransmitNext(CanFrame& frame, uint16_t timestamp = 0U)
+        {
+            TxElement* pNext = nullptr;
+            for (size_t i = 0U; i < mTxCapacity; i++)
+            {
+                TxElement& element = mTx[i];
+                if (!element.pending)
+                {
+                    continue;
+                }
+                if ((pNext == nullptr) ||
+                    (mTxQueueMode ? (Arbitration(element) < Arbitration(*pNext)) : (element.order < pNext->order)))
+                {
+                    pNext = &element;
+                }
+            }
+            if (pNext == nullptr)
+            {
+                return false;
+            }
+
+            pNext->pending = false;
+            mTxPending--;
+            mSent = pNext->frame;
+            frame = CanFrame{};
+            frame.id = mSent.frame.id;
+            frame.extended = mSent.frame.extended;
+            frame.fd = mSent.frame.fd;
+            frame.brs = mSent.frame.brs;
+            frame.length = mSent.frame.length;
+            frame.timestamp = timestamp;
+            frame.pData = mSent.data.data();
+
+            if (mEventFill == MAX_TX_ELEMENTS)
+            {
+                mTxLost++;
+            }
+            else
+            {
+                mEvents[(mEventGet + mEventFill) % MAX_TX_ELEMENTS] =
+                    TxEvent{mSent.frame.id, mSent.frame.extended, pNext->marker, timestamp};
+                mEventFill++;
+            }
+            // TEFN on every stored event
+            mTxInterrupts++;
+            if (mpTxListener != nullptr)
+            {
+                mpTxListener->OnTxEvent();
+            }
+            return true;
+        }
+
+        /// @brief Queue mode (lowest identifier first) instead of FIFO mode, like TxFifoQueueMode.
+        void SetTxQueueMode(bool queue) {mTxQueueMode = queue;};
+
+        /// @copydoc ICanController::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ICanController::ConfigFilters
+        Status ConfigFilters(const FilterSet& filters) override
+        {
+            if ((filters.standardCount > mStdCapacity) || (filters.extendedCount > mExtCapacity))
+            {
+                return Status::INVALID_PARAM;
+            }
+            mStdFilters.fill(0U);
+            mExtFilters.fill(0U);
+            for (size_t i = 0U; i < filters.standardCount; i++)
+            {
+                const FilterElement& element = filters.standard[i];
+                // SFT | SFEC | SFID1 | SFID2, like HAL_FDCAN_ConfigFilter
+                mStdFilters[i] = (static_cast<uint32_t>(element.type) << 30U) | (ToConfig(element.fifo) << 27U) |
+                                 (element.id1 << 16U) | element.id2;
+            }
+            for (size_t i = 0U; i < filters.extendedCount; i++)
+            {
+                const FilterElement& element = filters.extended[i];
+                mExtFilters[2U * i] = (ToConfig(element.fifo) << 29U) | element.id1;
+                mExtFilters[(2U * i) + 1U] = (ToExtType(element.type) << 30U) | element.id2;
+            }
+            return Status::OK;
+        }
+
+        /// @copydoc ICanController::GetFilterCapacity
+        size_t GetFilterCapacity(bool extended) const override {return extended ? mExtCapacity : mStdCapacity;};
+
+        /// @copydoc ICanController::SetWatermark
+        Status SetWatermark(RxFifo fifo, uint32_t level) override
+        {
+            if (level > FIFO_DEPTH)
+            {
+                return Status::INVALID_PARAM;
+            }
+            mFifo[static_cast<size_t>(fifo)].watermark = level;
+            return Status::OK;
+        }
+
+        /// @copydoc ICanController::GetRxFifo
+        RxFifoWindow GetRxFifo(RxFifo fifo) const override
+        {
+            const Fifo& rx = mFifo[static_cast<size_t>(fifo)];
+            RxFifoWindow window{};
+            window.pBase = rx.ram.data();
+            window.elementWords = ELEMENT_WORDS;
+            window.depth = static_cast<uint32_t>(FIFO_DEPTH);
+            window.getIndex = rx.getIndex;
+            window.fillLevel = rx.fillLevel;
+            return window;
+        }
+
+        /// @copydoc ICanController::AcknowledgeRx
+        void AcknowledgeRx(RxFifo fifo, uint32_t index) override
+        {
+            Fifo& rx = mFifo[static_cast<size_t>(fifo)];
+            const uint32_t count = ((index + FIFO_DEPTH - rx.getIndex) % FIFO_DEPTH) + 1U;
+            if ((index >= FIFO_DEPTH) || (count > rx.fillLevel))
+            {
+                return;
+            }
+            rx.getIndex = (index + 1U) % FIFO_DEPTH;
+            rx.fillLevel -= count;
+            rx.acknowledges++;
+        }
+
+        /// @copydoc ICanController::GetRxLost
+        uint32_t GetRxLost(RxFifo fifo) const override {return mFifo[static_cast<size_t>(fifo)].lost;};
+
+        /// @copydoc ICanController::SetTxListener
+        void SetTxListener(ITxListener* pListener) override {mpTxListener = pListener;};
+
+        /// @copydoc ICanController::GetTxFreeLevel
+        uint32_t GetTxFreeLevel() const override {return static_cast<uint32_t>(mTxCapacity - mTxPending);};
+
+        /// @copydoc ICanController::AddTx
+        Status AddTx(const TxFrame& frame, uint8_t marker) override
+        {
+            const uint32_t maxId = frame.extended ? MAX_EXT_ID : MAX_STD_ID;
+            if ((frame.id > maxId) || (frame.length > MAX_DATA_SIZE) || ((frame.length > 8U) && !frame.fd) ||
+                ((frame.length > 0U) && (frame.pData == nullptr)))
+            {
+                return Status::INVALID_PARAM;
+            }
+            for (size_t i = 0U; i < mTxCapacity; i++)
+            {
+                TxElement& element = mTx[i];
+                if (element.pending)
+                {
+                    continue;
+                }
+                element.frame.frame = frame;
+                element.frame.frame.length = DlcToLength(LengthToDlc(frame.length));
+                element.frame.data.fill(0U);
+                if (frame.length > 0U)
+                {
+                    std::memcpy(element.frame.data.data(), frame.pData, frame.length);
+                }
+                element.frame.frame.pData = nullptr;
+                element.marker = marker;
+                element.order = mTxOrder++;
+                element.pending = true;
+                mTxPending++;
+                return Status::OK;
+            }
+            return Status::BUSY;
+        }
+
+        /// @copydoc ICanController::GetTxEvent
+        bool GetTxEvent(TxEvent& event) override
+        {
+            if (mEventFill == 0U)
+            {
+                return false;
+            }
+            event = mEvents[mEventGet];
+            mEventGet = (mEventGet + 1U) % MAX_TX_ELEMENTS;
+            mEventFill--;
+            return true;
+        }
+
+        /// @brief Frames rejected by the filters.
+        uint32_t GetRejected() const {return mRejected;};
+
+        /// @brief Frames stored in a FIFO.
+        uint32_t GetReceived() const {return mReceived;};
+
+        /// @brief Count of listener calls (interrupts).
+        uint32_t GetInterrupts() const {return mInterrupts;};
+
+        /// @brief Count of RXFnA writes of a FIFO.
+        uint32_t GetAcknowledges(RxFifo fifo) const {return mFifo[static_cast<size_t>(fifo)].acknowledges;};
+
+        /// @brief Count of TX listener calls (interrupts).
+        uint32_t GetTxInterrupts() const {return mTxInterrupts;};
+
+        /// @brief TX events a full TX event FIFO had to drop.
+        uint32_t GetTxLost() const {return mTxLost;};
+
+    private:
+
+        /// @brief State of one RX FIFO.
+        struct Fifo
+        {
+            std::array<uint32_t, FIFO_DEPTH * ELEMENT_WORDS> ram{};     //!< Elements in the message RAM
+            uint32_t getIndex{0U};                                      //!< F0GI
+            uint32_t putIndex{0U};                                      //!< F0PI
+            uint32_t fillLevel{0U};                                     //!< F0FL
+            uint32_t watermark{0U};                                     //!< F0WM
+            uint32_t lost{0U};                                          //!< Lost frames
+            uint32_t acknowledges{0U};                                  //!< RXFnA writes
+        };
+
+        /// @brief A copy of a frame with its data.
+        struct SentFrame
+        {
+            TxFrame frame{};                                //!< Header, pData unused
+            std::array<uint8_t, MAX_DATA_SIZE> data{};      //!< Data, zero padded to the DLC length
+        };
+
+        /// @brief One element of the TX FIFO/queue.
+        struct TxElement
+        {
+            SentFrame frame{};          //!< Frame
+            uint32_t order{0U};         //!< Put order of the FIFO mode
+            uint8_t marker{0U};         //!< Message marker
+            bool pending{false};        //!< Transmission requested
+        };
+
+        /// @brief Arbitration field, a standard frame wins against an extended one with the same base identifier.
+        static uint32_t Arbitration(const TxElement& element)
+        {
+            const TxFrame& frame = element.frame.frame;
+            return frame.extended ? ((frame.id << 1U) | 1U) : (frame.id << 19U);
+        }
+
+        /// @brief SFEC / EFEC of a FIFO (FDCAN_FILTER_TO_RXFIFO0 / 1).
+        static uint32_t ToConfig(RxFifo fifo)
+        {
+            return (fifo == RxFifo::FIFO0) ? 1U : 2U;
+        }
+
+        /// @brief EFT of a type, ranges ignore the extended ID mask (FDCAN_FILTER_RANGE_NO_EIDM).
+        static uint32_t ToExtType(FilterType type)
+        {
+            return (type == FilterType::RANGE) ? 3U : static_cast<uint32_t>(type);
+        }
+
+        /// @brief Compare an identifier with a filter element.
+        static bool Hit(uint32_t type, uint32_t id, uint32_t id1, uint32_t id2)
+        {
+            switch (type)
+            {
+                case 0U:
+                case 3U:
+                    return (id >= id1) && (id <= id2);
+                case 1U:
+                    return (id == id1) || (id == id2);
+                default:
+                    return (id & id2) == (id1 & id2);
+            }
+        }
+
+        /// @brief Acceptance filtering, the first enabled element which matches decides.
+        bool Match(uint32_t id, bool extended, uint32_t& filterIndex, RxFifo& fifo) const
+        {
+            const size_t count = extended ? mExtCapacity : mStdCapacity;
+            for (size_t i = 0U; i < count; i++)
+            {
+                uint32_t config{0U};
+                bool hit{false};
+                if (extended)
+                {
+                    config = mExtFilters[2U * i] >> 29U;
+                    hit = Hit(mExtFilters[(2U * i) + 1U] >> 30U, id, mExtFilters[2U * i] & MAX_EXT_ID,
+                              mExtFilters[(2U * i) + 1U] & MAX_EXT_ID);
+                }
+                else
+                {
+                    config = (mStdFilters[i] >> 27U) & 0x7U;
+                    hit = Hit(mStdFilters[i] >> 30U, id, (mStdFilters[i] >> 16U) & MAX_STD_ID, mStdFilters[i] & MAX_STD_ID);
+                }
+                if ((config == 0U) || !hit)
+                {
+                    continue;
+                }
+                if ((config != 1U) && (config != 2U))
+                {
+                    // reject, priority and buffer elements are not used by the router
+                    return false;
+                }
+                filterIndex = static_cast<uint32_t>(i);
+                fifo = (config == 1U) ? RxFifo::FIFO0 : RxFifo::FIFO1;
+                return true;
+            }
+            return false;
+        }
+
+        /// @brief Raise the FIFO interrupt.
+        void Notify(RxFifo fifo)
+        {
+            mInterrupts++;
+            if (mpListener != nullptr)
+            {
+                mpListener->OnRxFifo(fifo);
+            }
+        }
+
+        /// @brief Configured standard elements.
+        const size_t mStdCapacity;
+
+        /// @brief Configured extended elements.
+        const size_t mExtCapacity;
+
+        /// @brief Standard filter list.
+        std::array<uint32_t, MAX_STD_FILTERS> mStdFilters{};
+
+        /// @brief Extended filter list, two words per element.
+        std::array<uint32_t, 2U * MAX_EXT_FILTERS> mExtFilters{};
+
+        /// @brief RX FIFO 0 and 1.
+        std::array<Fifo, RX_FIFO_COUNT> mFifo{};
+
+        /// @brief The RX listener.
+        IListener* mpListener{nullptr};
+
+        /// @brief Configured TX elements.
+        const size_t mTxCapacity;
+
+        /// @brief TX FIFO/queue elements.
+        std::array<TxElement, MAX_TX_ELEMENTS> mTx{};
+
+        /// @brief The last sent frame.
+        SentFrame mSent{};
+
+        /// @brief TX event FIFO.
+        std::array<TxEvent, MAX_TX_ELEMENTS> mEvents{};
+
+        /// @brief The TX listener.
+        ITxListener* mpTxListener{nullptr};
+
+        uint32_t mTxPending{0U};    //!< Pending TX elements
+        uint32_t mTxOrder{0U};      //!< Put counter
+        uint32_t mEventGet{0U};     //!< EFGI
+        uint32_t mEventFill{0U};    //!< EFFL
+        bool mTxQueueMode{false};   //!< TFQM
+
+        uint32_t mRejected{0U};     //!< Rejected frames
+        uint32_t mReceived{0U};     //!< Stored frames
+        uint32_t mInterrupts{0U};   //!< Listener calls
+        uint32_t mTxInterrupts{0U}; //!< TX listener calls
+        uint32_t mTxLost{0U};       //!< Dropped TX events
+};
+
+} // end namespace Can
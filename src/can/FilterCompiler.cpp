@@ -0,0 +1,258 @@
+/**
+ ********************************************************************************
+ * @file        FilterCompiler.cpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, filter compiler implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FilterCompiler.hpp"
+#include <cstdint>
+
+using namespace Can;
+
+namespace {
+
+/// @brief Sort order: standard before extended, then by the first identifier.
+bool Less(const FilterCompiler::Range& a, const FilterCompiler::Range& b)
+{
+    if (a.extended != b.extended)
+    {
+        return !a.extended;
+    }
+    return a.first < b.first;
+}
+
+bool IsSingle(const FilterCompiler::Range& range)
+{
+    return range.first == range.last;
+}
+
+} // end anonymous namespace
+
+
+Status FilterCompiler::Compile(const Range* pRanges, size_t count, size_t stdBudget, size_t extBudget,
+                               FilterSet& filters)
+{
+    filters.standardCount = 0U;
+    filters.extendedCount = 0U;
+    filters.exact = true;
+    if ((count > MAX_RANGES) || ((pRanges == nullptr) && (count != 0U)))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    // insertion sort, the list is short and compiled once
+    mCount = 0U;
+    for (size_t i = 0U; i < count; i++)
+    {
+        const Range& range = pRanges[i];
+        const uint32_t maxId = range.extended ? MAX_EXT_ID : MAX_STD_ID;
+        if ((range.first > range.last) || (range.last > maxId))
+        {
+            return Status::INVALID_PARAM;
+        }
+        size_t pos = mCount;
+        while ((pos > 0U) && Less(range, mWork[pos - 1U]))
+        {
+            mWork[pos] = mWork[pos - 1U];
+            pos--;
+        }
+        mWork[pos] = range;
+        mCount++;
+    }
+
+    for (size_t i = 1U; i < mCount; i++)
+    {
+        // an identifier can only have one destination
+        if ((mWork[i].extended == mWork[i - 1U].extended) && (mWork[i].first <= mWork[i - 1U].last))
+        {
+            return Status::INVALID_PARAM;
+        }
+    }
+    Join();
+
+    size_t split = 0U;
+    while ((split < mCount) && !mWork[split].extended)
+    {
+        split++;
+    }
+    bool merged = false;
+    const size_t extCount = mCount - split;
+    const size_t stdEnd = Reduce(0U, split, (stdBudget < MAX_STD_FILTERS) ? stdBudget : MAX_STD_FILTERS, merged);
+    if (stdEnd == SIZE_MAX)
+    {
+        return Status::INVALID_PARAM;
+    }
+    const size_t extEnd = Reduce(stdEnd, stdEnd + extCount, (extBudget < MAX_EXT_FILTERS) ? extBudget : MAX_EXT_FILTERS,
+                                 merged);
+    if (extEnd == SIZE_MAX)
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    filters.standardCount = Emit(mWork.data(), mWork.data() + stdEnd, filters.standard.data());
+    filters.extendedCount = Emit(mWork.data() + stdEnd, mWork.data() + extEnd, filters.extended.data());
+    filters.exact = !merged;
+    return Status::OK;
+}
+
+
+void FilterCompiler::Join()
+{
+    size_t out = 0U;
+    for (size_t i = 0U; i < mCount; i++)
+    {
+        if ((out > 0U) && (mWork[out - 1U].extended == mWork[i].extended) && (mWork[out - 1U].fifo == mWork[i].fifo) &&
+            ((mWork[out - 1U].last + 1U) == mWork[i].first))
+        {
+            mWork[out - 1U].last = mWork[i].last;
+        }
+        else
+        {
+            mWork[out] = mWork[i];
+            out++;
+        }
+    }
+    mCount = out;
+}
+
+
+size_t FilterCompiler::Cost(size_t begin, size_t end) const
+{
+    std::array<size_t, RX_FIFO_COUNT> ranges{};
+    std::array<size_t, RX_FIFO_COUNT> singles{};
+    for (size_t i = begin; i < end; i++)
+    {
+        const size_t fifo = static_cast<size_t>(mWork[i].fifo);
+        if (IsSingle(mWork[i]))
+        {
+            singles[fifo]++;
+        }
+        else
+        {
+            ranges[fifo]++;
+        }
+    }
+    size_t cost = 0U;
+    for (size_t fifo = 0U; fifo < RX_FIFO_COUNT; fifo++)
+    {
+        cost += ranges[fifo] + ((singles[fifo] + 1U) / 2U);
+    }
+    return cost;
+}
+
+
+size_t FilterCompiler::Saving(size_t begin, size_t end, size_t index) const
+{
+    const Range& a = mWork[index];
+    const Range& b = mWork[index + 1U];
+    if (!IsSingle(a) && !IsSingle(b))
+    {
+        return 1U;
+    }
+    if (IsSingle(a) && IsSingle(b))
+    {
+        // two halves of DUAL elements become one RANGE
+        return 0U;
+    }
+    // a single leaves its DUAL element, that saves one element only if it was the odd one
+    size_t singles = 0U;
+    for (size_t i = begin; i < end; i++)
+    {
+        if ((mWork[i].fifo == a.fifo) && IsSingle(mWork[i]))
+        {
+            singles++;
+        }
+    }
+    return ((singles % 2U) != 0U) ? 1U : 0U;
+}
+
+
+size_t FilterCompiler::Reduce(size_t begin, size_t end, size_t budget, bool& merged)
+{
+    while (Cost(begin, end) > budget)
+    {
+        // prefer merges which save an element, then the smallest gap
+        size_t best = SIZE_MAX;
+        size_t bestSaving = 0U;
+        uint32_t bestGap = UINT32_MAX;
+        for (size_t i = begin; (i + 1U) < end; i++)
+        {
+            if (mWork[i].fifo != mWork[i + 1U].fifo)
+            {
+                continue;
+            }
+            const size_t saving = Saving(begin, end, i);
+            const uint32_t gap = mWork[i + 1U].first - mWork[i].last - 1U;
+            if ((best == SIZE_MAX) || (saving > bestSaving) || ((saving == bestSaving) && (gap < bestGap)))
+            {
+                best = i;
+                bestSaving = saving;
+                bestGap = gap;
+            }
+        }
+        if (best == SIZE_MAX)
+        {
+            return SIZE_MAX;
+        }
+        mWork[best].last = mWork[best + 1U].last;
+        Erase(best + 1U);
+        end--;
+        merged = true;
+    }
+    return end;
+}
+
+
+void FilterCompiler::Erase(size_t index)
+{
+    for (size_t i = index; (i + 1U) < mCount; i++)
+    {
+        mWork[i] = mWork[i + 1U];
+    }
+    mCount--;
+}
+
+
+size_t FilterCompiler::Emit(const Range* pBegin, const Range* pEnd, FilterElement* pElements)
+{
+    size_t count = 0U;
+    for (size_t fifo = 0U; fifo < RX_FIFO_COUNT; fifo++)
+    {
+        const Range* pPending = nullptr;
+        for (const Range* pRange = pBegin; pRange != pEnd; pRange++)
+        {
+            if (static_cast<size_t>(pRange->fifo) != fifo)
+            {
+                continue;
+            }
+            if (!IsSingle(*pRange))
+            {
+                pElements[count] = FilterElement{FilterType::RANGE, pRange->fifo, pRange->first, pRange->last};
+                count++;
+            }
+            else if (pPending == nullptr)
+            {
+                pPending = pRange;
+            }
+            else
+            {
+                pElements[count] = FilterElement{FilterType::DUAL, pRange->fifo, pPending->first, pRange->first};
+                pPending = nullptr;
+                count++;
+            }
+        }
+        if (pPending != nullptr)
+        {
+            pElements[count] = FilterElement{FilterType::DUAL, pPending->fifo, pPending->first, pPending->first};
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,103 @@
+/**
+ ********************************************************************************
+ * @file        FilterCompiler.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, compiles subscribed identifier ranges into FDCAN filter elements.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "CanTypes.hpp"
+namespace Can {
+
+
+/**
+ * @brief   This class turns a declarative list of identifier ranges into the minimum list of
+ *          standard and extended filter elements.
+ * @details The ranges are sorted per identifier type, adjacent ranges of the same FIFO are joined.
+ *          Every range of two or more identifiers takes one RANGE element, single identifiers are
+ *          paired into DUAL elements, which is the minimum for an exact filter.\n
+ *          If the list does not fit into the element budget, neighbouring ranges of the same FIFO
+ *          are merged, the merge with the smallest gap (fewest identifiers accepted in addition)
+ *          which saves an element first. The filters then also pass unsubscribed identifiers
+ *          (FilterSet::exact is false), the router rejects them in software. A merge never covers
+ *          an identifier of the other FIFO.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class FilterCompiler
+{
+    public:
+
+        /// @brief Maximum count of ranges of one compilation.
+        static constexpr size_t MAX_RANGES{128U};
+
+        /// @brief A subscribed identifier range.
+        struct Range
+        {
+            uint32_t first{0U};             //!< First identifier
+            uint32_t last{0U};              //!< Last identifier (inclusive)
+            bool extended{false};           //!< 29 bit identifiers
+            RxFifo fifo{RxFifo::FIFO0};     //!< Destination FIFO
+        };
+
+        /// @brief Constructor.
+        FilterCompiler() = default;
+
+        FilterCompiler(FilterCompiler const &) = delete;             //!< Copy constructor
+        FilterCompiler& operator=(FilterCompiler const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Compile a list of ranges.
+         *
+         * @param   pRanges     The ranges.
+         * @param   count       Count of ranges, at most MAX_RANGES.
+         * @param   stdBudget   Available standard filter elements.
+         * @param   extBudget   Available extended filter elements.
+         * @param   filters     Receives the elements.
+         *
+         * @return  OK, INVALID_PARAM for invalid or overlapping ranges or if the budget can not be met.
+         */
+        Status Compile(const Range* pRanges, size_t count, size_t stdBudget, size_t extBudget, FilterSet& filters);
+
+    private:
+
+        /// @brief Join adjacent ranges of the same type and FIFO.
+        void Join();
+
+        /// @brief Count of elements of the ranges [begin, end).
+        size_t Cost(size_t begin, size_t end) const;
+
+        /// @brief Elements saved by merging the range at index with its successor.
+        size_t Saving(size_t begin, size_t end, size_t index) const;
+
+        /**
+         * @brief   Merge ranges of [begin, end) until they fit into the budget.
+         * @return  The new end or SIZE_MAX if the budget can not be met.
+         */
+        size_t Reduce(size_t begin, size_t end, size_t budget, bool& merged);
+
+        /// @brief Remove the range at index.
+        void Erase(size_t index);
+
+        /// @brief Emit the elements of [begin, end).
+        static size_t Emit(const Range* pBegin, const Range* pEnd, FilterElement* pElements);
+
+        /// @brief Working copy of the ranges, sorted.
+        std::array<Range, MAX_RANGES> mWork{};
+
+        /// @brief Used entries of mWork.
+        size_t mCount{0U};
+};
+
+} // end namespace Can
@@ -0,0 +1,164 @@
+/**
+ ********************************************************************************
+ * @file        ICanController.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, interface of an FDCAN controller with direct access to the message RAM.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "CanTypes.hpp"
+namespace Can {
+
+
+/// @brief Snapshot of an RX FIFO, the elements are read in place.
+struct RxFifoWindow
+{
+    const volatile uint32_t* pBase{nullptr};    //!< First element of the FIFO in the message RAM
+    uint32_t elementWords{0U};                  //!< Words per element (header and data)
+    uint32_t depth{0U};                         //!< Elements of the FIFO
+    uint32_t getIndex{0U};                      //!< Oldest element
+    uint32_t fillLevel{0U};                     //!< Count of elements to read
+};
+
+
+/**
+ * @brief   This class provides the RX and TX side of an FDCAN (hardware or simulation).
+ * @details The received elements stay in the message RAM: @ref GetRxFifo describes the filled part of a
+ *          FIFO, the reader decodes the elements in place (layout in Can::Element) and gives a whole
+ *          batch back with one @ref AcknowledgeRx of the last element.\n
+ *          The listener is called when a FIFO reaches its watermark, when it lost a frame and when
+ *          the first frame arrives in a FIFO without watermark.\n
+ *          Frames to transmit are put into the TX FIFO/queue with a message marker, every sent frame
+ *          leaves an element with this marker in the TX event FIFO and raises the TX listener.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to read and acknowledge a FIFO from one context.
+ *
+ */
+class ICanController
+{
+    public:
+
+        /// @brief Receiver of the RX FIFO events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief Elements are ready, called from the interrupt context.
+                 * @param fifo  The FIFO which has elements to read.
+                 */
+                virtual void OnRxFifo(RxFifo fifo) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Receiver of the TX event FIFO events.
+        class ITxListener
+        {
+            public:
+                /// @brief A frame was sent and its TX event stored, called from the interrupt context.
+                virtual void OnTxEvent() = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~ITxListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~ICanController() = default;
+
+        /**
+         * @brief Register the RX listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Load the filter elements, non-matching frames and remote frames are rejected.
+         * @param filters   The elements, at most @ref GetFilterCapacity of each type.
+         * @return OK, INVALID_PARAM if the list exceeds the capacity, HW_ERROR.
+         */
+        virtual Status ConfigFilters(const FilterSet& filters) = 0;
+
+        /**
+         * @brief Filter elements configured in the message RAM.
+         * @param extended  Extended instead of standard elements.
+         */
+        virtual size_t GetFilterCapacity(bool extended) const = 0;
+
+        /**
+         * @brief Set the fill level which raises the listener.
+         * @param fifo      The FIFO.
+         * @param level     Elements, 0 disables the watermark and signals every new element.
+         * @return OK, INVALID_PARAM if level exceeds the depth, HW_ERROR.
+         */
+        virtual Status SetWatermark(RxFifo fifo, uint32_t level) = 0;
+
+        /**
+         * @brief Describe the filled part of a FIFO.
+         * @param fifo  The FIFO.
+         */
+        virtual RxFifoWindow GetRxFifo(RxFifo fifo) const = 0;
+
+        /**
+         * @brief Release the elements up to and including index.
+         * @param fifo  The FIFO.
+         * @param index Element index of the last read element.
+         */
+        virtual void AcknowledgeRx(RxFifo fifo, uint32_t index) = 0;
+
+        /**
+         * @brief Count of frames a full FIFO had to drop.
+         * @param fifo  The FIFO.
+         */
+        virtual uint32_t GetRxLost(RxFifo fifo) const = 0;
+
+        /**
+         * @brief Register the TX listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetTxListener(ITxListener* pListener) = 0;
+
+        /// @brief Free elements of the TX FIFO/queue.
+        virtual uint32_t GetTxFreeLevel() const = 0;
+
+        /**
+         * @brief Put a frame into the TX FIFO/queue, the data is copied.
+         * @param frame     The frame.
+         * @param marker    Message marker of the TX event.
+         * @return OK, BUSY if no element is free, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status AddTx(const TxFrame& frame, uint8_t marker) = 0;
+
+        /**
+         * @brief Read and release the oldest TX event.
+         * @param event     The event.
+         * @return false if the TX event FIFO is empty.
+         */
+        virtual bool GetTxEvent(TxEvent& event) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        ICanController() = default;
+
+        ICanController(ICanController const &) = default;             //!< Copy constructor
+        ICanController(ICanController &&) = default;                  //!< Move constructor
+
+        ICanController& operator=(ICanController const &) = default;  //!< Copy assignment
+        ICanController& operator=(ICanController &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Can
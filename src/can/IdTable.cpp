@@ -0,0 +1,148 @@
+/**
+ ********************************************************************************
+ * @file        IdTable.cpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, perfect hash table implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "IdTable.hpp"
+
+using namespace Can;
+
+namespace {
+
+/// @brief Smallest power of two >= value.
+uint32_t PowerOfTwo(size_t value)
+{
+    uint32_t result = 1U;
+    while (result < value)
+    {
+        result <<= 1U;
+    }
+    return result;
+}
+
+} // end anonymous namespace
+
+
+IdTable::IdTable()
+{
+    Clear();
+}
+
+
+void IdTable::Clear()
+{
+    mCount = 0U;
+    mSlots.fill(Slot{});
+    mSeeds.fill(0U);
+    mSlotMask = 0U;
+    mBucketMask = 0U;
+}
+
+
+Status IdTable::Add(uint32_t key, uint16_t route)
+{
+    if ((mCount >= MAX_KEYS) || (route == NO_ROUTE) || (key == EMPTY_KEY))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mKeys[mCount] = Slot{key, route};
+    mCount++;
+    return Status::OK;
+}
+
+
+Status IdTable::Build()
+{
+    mSlots.fill(Slot{});
+    mSeeds.fill(0U);
+    mSlotMask = PowerOfTwo(2U * mCount) - 1U;
+    const uint32_t buckets = PowerOfTwo((mCount + 1U) / 2U);
+    mBucketMask = buckets - 1U;
+
+    // counting sort of the keys by bucket
+    std::array<uint16_t, MAX_BUCKETS + 1U>& start = mBucketStart;
+    start.fill(0U);
+    for (size_t i = 0U; i < mCount; i++)
+    {
+        start[(Hash(mKeys[i].key, BUCKET_SEED) & mBucketMask) + 1U]++;
+    }
+    size_t largest = 0U;
+    for (size_t b = 0U; b < buckets; b++)
+    {
+        largest = (start[b + 1U] > largest) ? start[b + 1U] : largest;
+        start[b + 1U] = static_cast<uint16_t>(start[b + 1U] + start[b]);
+    }
+    std::array<uint16_t, MAX_BUCKETS> fill{};
+    for (size_t i = 0U; i < mCount; i++)
+    {
+        const uint32_t b = Hash(mKeys[i].key, BUCKET_SEED) & mBucketMask;
+        mOrder[start[b] + fill[b]] = static_cast<uint16_t>(i);
+        fill[b]++;
+    }
+
+    // the large buckets first, while the table is empty
+    for (size_t size = largest; size > 0U; size--)
+    {
+        for (size_t b = 0U; b < buckets; b++)
+        {
+            if ((static_cast<size_t>(start[b + 1U] - start[b]) == size) && !PlaceBucket(b))
+            {
+                Clear();
+                return Status::INVALID_PARAM;
+            }
+        }
+    }
+    return Status::OK;
+}
+
+
+bool IdTable::PlaceBucket(size_t bucket)
+{
+    const size_t begin = mBucketStart[bucket];
+    const size_t end = mBucketStart[bucket + 1U];
+    for (size_t i = begin + 1U; i < end; i++)
+    {
+        for (size_t j = begin; j < i; j++)
+        {
+            if (mKeys[mOrder[i]].key == mKeys[mOrder[j]].key)
+            {
+                // a duplicate never finds a seed
+                return false;
+            }
+        }
+    }
+
+    for (uint32_t seed = 1U; seed < MAX_SEED_TRIES; seed++)
+    {
+        size_t placed = begin;
+        while (placed < end)
+        {
+            Slot& slot = mSlots[Hash(mKeys[mOrder[placed]].key, seed) & mSlotMask];
+            if (slot.key != EMPTY_KEY)
+            {
+                break;
+            }
+            slot = mKeys[mOrder[placed]];
+            placed++;
+        }
+        if (placed == end)
+        {
+            mSeeds[bucket] = seed;
+            return true;
+        }
+        // roll back the keys of this try
+        for (size_t i = begin; i < placed; i++)
+        {
+            mSlots[Hash(mKeys[mOrder[i]].key, seed) & mSlotMask] = Slot{};
+        }
+    }
+    return false;
+}
@@ -0,0 +1,158 @@
+/**
+ ********************************************************************************
+ * @file        IdTable.hpp
+ *
+ * @namespace   Can
+ *
+ * @brief       Can, perfect hash table from CAN identifiers to routes.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "CanTypes.hpp"
+namespace Can {
+
+
+/**
+ * @brief   This class maps a fixed set of identifiers to route indices with a collision free hash.
+ * @details The keys are collected by @ref Add, @ref Build constructs a perfect hash in two levels
+ *          (hash and displace): a first hash selects a bucket of about two keys, every bucket owns a
+ *          seed which places all its keys into free slots of a table with twice the key count.
+ *          The buckets are placed largest first, a seed is found after a few tries.\n
+ *          A lookup costs two hashes, one seed load and one slot compare, independent of the count of
+ *          routes. Identifiers which are not in the set hit a slot with a different key and are
+ *          reported as NO_ROUTE.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * Find may be called from ISR's while the table is not modified.
+ *
+ */
+class IdTable
+{
+    public:
+
+        /// @brief Maximum count of keys.
+        static constexpr size_t MAX_KEYS{512U};
+
+        /// @brief Result of Find for unknown identifiers.
+        static constexpr uint16_t NO_ROUTE{0xFFFFU};
+
+        /// @brief Constructor.
+        IdTable();
+
+        IdTable(IdTable const &) = delete;             //!< Copy constructor
+        IdTable& operator=(IdTable const &) = delete;  //!< Copy assignment
+
+        /// @brief The key of an identifier, extended identifiers get bit 31.
+        static constexpr uint32_t MakeKey(uint32_t id, bool extended)
+        {
+            return extended ? (id | EXTENDED_FLAG) : id;
+        };
+
+        /// @brief Remove all keys.
+        void Clear();
+
+        /**
+         * @brief   Add a key, effective after the next Build.
+         *
+         * @param   key     The key, see @ref MakeKey.
+         * @param   route   The value, not NO_ROUTE.
+         *
+         * @return  OK, INVALID_PARAM if the table is full.
+         */
+        Status Add(uint32_t key, uint16_t route);
+
+        /**
+         * @brief   Construct the hash of the added keys.
+         *
+         * @return  OK, INVALID_PARAM for a duplicate key.
+         */
+        Status Build();
+
+        /**
+         * @brief   Look up a key.
+         *
+         * @param   key     The key, see @ref MakeKey.
+         *
+         * @return  The route or NO_ROUTE.
+         */
+        uint16_t Find(uint32_t key) const
+        {
+            const Slot& slot = mSlots[Hash(key, mSeeds[Hash(key, BUCKET_SEED) & mBucketMask]) & mSlotMask];
+            return (slot.key == key) ? slot.route : NO_ROUTE;
+        };
+
+        /// @brief Count of keys.
+        size_t GetSize() const {return mCount;};
+
+    private:
+
+        /// @brief Flag of extended identifiers in the key.
+        static constexpr uint32_t EXTENDED_FLAG{0x80000000U};
+
+        /// @brief Key of an unused slot, no identifier has bit 30.
+        static constexpr uint32_t EMPTY_KEY{0xFFFFFFFFU};
+
+        /// @brief Seed of the bucket hash.
+        static constexpr uint32_t BUCKET_SEED{0x5BD1E995U};
+
+        /// @brief Buckets of a full table.
+        static constexpr size_t MAX_BUCKETS{MAX_KEYS / 2U};
+
+        /// @brief Seeds tried per bucket before Build gives up.
+        static constexpr uint32_t MAX_SEED_TRIES{0x10000U};
+
+        /// @brief One entry of the table.
+        struct Slot
+        {
+            uint32_t key{EMPTY_KEY};    //!< Key
+            uint16_t route{NO_ROUTE};   //!< Value
+        };
+
+        /// @brief Mixing hash (murmur3 finalizer) of a key with a seed.
+        static uint32_t Hash(uint32_t key, uint32_t seed)
+        {
+            uint32_t x = key ^ seed;
+            x ^= x >> 16U;
+            x *= 0x85EBCA6BU;
+            x ^= x >> 13U;
+            x *= 0xC2B2AE35U;
+            x ^= x >> 16U;
+            return x;
+        };
+
+        /// @brief Find a seed which places the keys of a bucket into free slots.
+        bool PlaceBucket(size_t bucket);
+
+        /// @brief Keys in the order of Add.
+        std::array<Slot, MAX_KEYS> mKeys{};
+
+        /// @brief Count of keys.
+        size_t mCount{0U};
+
+        /// @brief Hash table.
+        std::array<Slot, 2U * MAX_KEYS> mSlots{};
+
+        /// @brief Seed per bucket.
+        std::array<uint32_t, MAX_BUCKETS> mSeeds{};
+
+        /// @brief Key indices sorted by bucket (Build only).
+        std::array<uint16_t, MAX_KEYS> mOrder{};
+
+        /// @brief First entry of each bucket in mOrder, one more for the end (Build only).
+        std::array<uint16_t, MAX_BUCKETS + 1U> mBucketStart{};
+
+        /// @brief Table size - 1.
+        uint32_t mSlotMask{0U};
+
+        /// @brief Bucket count - 1.
+        uint32_t mBucketMask{0U};
+};
+
+} // end namespace Can
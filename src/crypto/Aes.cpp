@@ -0,0 +1,500 @@
+/**
+ ********************************************************************************
+ * @file        Aes.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, portable AES and GHASH implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "Aes.hpp"
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRYPTO_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Crypto;
+
+namespace {
+
+/// @brief S-box and encryption T-table, generated at compile time.
+struct AesTables
+{
+    std::array<uint8_t, 256> sbox{};
+    std::array<uint32_t, 256> te0{};
+};
+
+constexpr uint8_t XTime(uint8_t x)
+{
+    return static_cast<uint8_t>((x << 1U) ^ (((x & 0x80U) != 0U) ? 0x1BU : 0x00U));
+}
+
+constexpr uint8_t Rotl8(uint8_t x, unsigned int n)
+{
+    return static_cast<uint8_t>((x << n) | (x >> (8U - n)));
+}
+
+constexpr AesTables MakeTables()
+{
+    AesTables t{};
+    std::array<uint8_t, 256> expTab{};
+    std::array<uint8_t, 256> logTab{};
+
+    // 3 is a generator of GF(2^8)*
+    uint8_t p = 1U;
+    for (unsigned int i = 0U; i < 255U; i++)
+    {
+        expTab[i] = p;
+        logTab[p] = static_cast<uint8_t>(i);
+        p = static_cast<uint8_t>(p ^ XTime(p));
+    }
+
+    for (unsigned int x = 0U; x < 256U; x++)
+    {
+        const uint8_t inv = (x == 0U) ? 0U : expTab[(255U - logTab[x]) % 255U];
+        const uint8_t s = static_cast<uint8_t>(inv ^ Rotl8(inv, 1U) ^ Rotl8(inv, 2U) ^ Rotl8(inv, 3U) ^ Rotl8(inv, 4U) ^ 0x63U);
+        const uint8_t s2 = XTime(s);
+        const uint8_t s3 = static_cast<uint8_t>(s2 ^ s);
+        t.sbox[x] = s;
+        t.te0[x] = (static_cast<uint32_t>(s2) << 24U) | (static_cast<uint32_t>(s) << 16U)
+                 | (static_cast<uint32_t>(s) << 8U) | static_cast<uint32_t>(s3);
+    }
+    return t;
+}
+
+constexpr AesTables kTables = MakeTables();
+
+inline uint32_t Ror(uint32_t x, unsigned int n)
+{
+    return (x >> n) | (x << (32U - n));
+}
+
+inline uint32_t Load32Be(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24U) | (static_cast<uint32_t>(p[1]) << 16U)
+         | (static_cast<uint32_t>(p[2]) << 8U) | static_cast<uint32_t>(p[3]);
+}
+
+inline void Store32Be(uint8_t* p, uint32_t v)
+{
+    p[0] = static_cast<uint8_t>(v >> 24U);
+    p[1] = static_cast<uint8_t>(v >> 16U);
+    p[2] = static_cast<uint8_t>(v >> 8U);
+    p[3] = static_cast<uint8_t>(v);
+}
+
+inline uint64_t Load64Be(const uint8_t* p)
+{
+    return (static_cast<uint64_t>(Load32Be(p)) << 32U) | Load32Be(p + 4);
+}
+
+inline void Store64Be(uint8_t* p, uint64_t v)
+{
+    Store32Be(p, static_cast<uint32_t>(v >> 32U));
+    Store32Be(p + 4, static_cast<uint32_t>(v));
+}
+
+inline void Inc32(std::array<uint8_t, Aes::BLOCK_SIZE>& counter)
+{
+    Store32Be(&counter[12], Load32Be(&counter[12]) + 1U);
+}
+
+/// @brief Reduction constants of the 4-bit GHASH table method.
+constexpr std::array<uint64_t, 16> kLast4{
+    0x0000U, 0x1c20U, 0x3840U, 0x2460U, 0x7080U, 0x6ca0U, 0x48c0U, 0x54e0U,
+    0xe100U, 0xfd20U, 0xd940U, 0xc560U, 0x9180U, 0x8da0U, 0xa9c0U, 0xb5e0U
+};
+
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+
+bool CpuHasAesNi()
+{
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("aes") != 0) && (__builtin_cpu_supports("sse4.1") != 0);
+}
+
+bool CpuHasPclmul()
+{
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("pclmul") != 0) && (__builtin_cpu_supports("ssse3") != 0);
+}
+
+__attribute__((target("aes,sse4.1")))
+void AesNiEncrypt(const uint8_t* pRk, size_t rounds, const uint8_t* pIn, uint8_t* pOut)
+{
+    const __m128i* rk = reinterpret_cast<const __m128i*>(pRk);
+    __m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn)), _mm_loadu_si128(&rk[0]));
+    for (size_t r = 1U; r < rounds; r++)
+    {
+        b = _mm_aesenc_si128(b, _mm_loadu_si128(&rk[r]));
+    }
+    b = _mm_aesenclast_si128(b, _mm_loadu_si128(&rk[rounds]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pOut), b);
+}
+
+__attribute__((target("aes,sse4.1")))
+void AesNiCtr(const uint8_t* pRk, size_t rounds, std::array<uint8_t, Aes::BLOCK_SIZE>& counter,
+              const uint8_t* pIn, uint8_t* pOut, size_t len)
+{
+    const __m128i* rk = reinterpret_cast<const __m128i*>(pRk);
+    const __m128i k0 = _mm_loadu_si128(&rk[0]);
+
+    // four blocks in flight hide the latency of aesenc
+    while (len >= (4U * Aes::BLOCK_SIZE))
+    {
+        alignas(16) uint8_t ctr[4][Aes::BLOCK_SIZE];
+        for (size_t i = 0U; i < 4U; i++)
+        {
+            std::memcpy(ctr[i], counter.data(), Aes::BLOCK_SIZE);
+            Inc32(counter);
+        }
+        __m128i b0 = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(ctr[0])), k0);
+        __m128i b1 = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(ctr[1])), k0);
+        __m128i b2 = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(ctr[2])), k0);
+        __m128i b3 = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(ctr[3])), k0);
+        for (size_t r = 1U; r < rounds; r++)
+        {
+            const __m128i k = _mm_loadu_si128(&rk[r]);
+            b0 = _mm_aesenc_si128(b0, k);
+            b1 = _mm_aesenc_si128(b1, k);
+            b2 = _mm_aesenc_si128(b2, k);
+            b3 = _mm_aesenc_si128(b3, k);
+        }
+        const __m128i kl = _mm_loadu_si128(&rk[rounds]);
+        b0 = _mm_aesenclast_si128(b0, kl);
+        b1 = _mm_aesenclast_si128(b1, kl);
+        b2 = _mm_aesenclast_si128(b2, kl);
+        b3 = _mm_aesenclast_si128(b3, kl);
+
+        const __m128i* in = reinterpret_cast<const __m128i*>(pIn);
+        __m128i* out = reinterpret_cast<__m128i*>(pOut);
+        _mm_storeu_si128(&out[0], _mm_xor_si128(_mm_loadu_si128(&in[0]), b0));
+        _mm_storeu_si128(&out[1], _mm_xor_si128(_mm_loadu_si128(&in[1]), b1));
+        _mm_storeu_si128(&out[2], _mm_xor_si128(_mm_loadu_si128(&in[2]), b2));
+        _mm_storeu_si128(&out[3], _mm_xor_si128(_mm_loadu_si128(&in[3]), b3));
+
+        pIn += 4U * Aes::BLOCK_SIZE;
+        pOut += 4U * Aes::BLOCK_SIZE;
+        len -= 4U * Aes::BLOCK_SIZE;
+    }
+
+    while (len > 0U)
+    {
+        uint8_t ks[Aes::BLOCK_SIZE];
+        AesNiEncrypt(pRk, rounds, counter.data(), ks);
+        Inc32(counter);
+        const size_t n = (len < Aes::BLOCK_SIZE) ? len : Aes::BLOCK_SIZE;
+        for (size_t i = 0U; i < n; i++)
+        {
+            pOut[i] = static_cast<uint8_t>(pIn[i] ^ ks[i]);
+        }
+        pIn += n;
+        pOut += n;
+        len -= n;
+    }
+}
+
+/// @brief GF(2^128) multiplication on byte reflected operands (Intel carry-less multiplication guide).
+__attribute__((target("pclmul,ssse3")))
+__m128i ClmulGfMul(__m128i a, __m128i b)
+{
+    __m128i t3 = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i t4 = _mm_clmulepi64_si128(a, b, 0x10);
+    __m128i t5 = _mm_clmulepi64_si128(a, b, 0x01);
+    __m128i t6 = _mm_clmulepi64_si128(a, b, 0x11);
+
+    t4 = _mm_xor_si128(t4, t5);
+    t5 = _mm_slli_si128(t4, 8);
+    t4 = _mm_srli_si128(t4, 8);
+    t3 = _mm_xor_si128(t3, t5);
+    t6 = _mm_xor_si128(t6, t4);
+
+    // shift the 256 bit product left by one (bit reflection)
+    __m128i t7 = _mm_srli_epi32(t3, 31);
+    __m128i t8 = _mm_srli_epi32(t6, 31);
+    t3 = _mm_slli_epi32(t3, 1);
+    t6 = _mm_slli_epi32(t6, 1);
+    __m128i t9 = _mm_srli_si128(t7, 12);
+    t8 = _mm_slli_si128(t8, 4);
+    t7 = _mm_slli_si128(t7, 4);
+    t3 = _mm_or_si128(t3, t7);
+    t6 = _mm_or_si128(t6, t8);
+    t6 = _mm_or_si128(t6, t9);
+
+    // reduction modulo x^128 + x^7 + x^2 + x + 1
+    t7 = _mm_slli_epi32(t3, 31);
+    t8 = _mm_slli_epi32(t3, 30);
+    t9 = _mm_slli_epi32(t3, 25);
+    t7 = _mm_xor_si128(t7, t8);
+    t7 = _mm_xor_si128(t7, t9);
+    t8 = _mm_srli_si128(t7, 4);
+    t7 = _mm_slli_si128(t7, 12);
+    t3 = _mm_xor_si128(t3, t7);
+
+    __m128i t2 = _mm_srli_epi32(t3, 1);
+    t4 = _mm_srli_epi32(t3, 2);
+    t5 = _mm_srli_epi32(t3, 7);
+    t2 = _mm_xor_si128(t2, t4);
+    t2 = _mm_xor_si128(t2, t5);
+    t2 = _mm_xor_si128(t2, t8);
+    t3 = _mm_xor_si128(t3, t2);
+    return _mm_xor_si128(t6, t3);
+}
+
+__attribute__((target("pclmul,ssse3")))
+void ClmulMultiply(uint8_t* pState, const uint8_t* pH)
+{
+    const __m128i swap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pState)), swap);
+    const __m128i h = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pH)), swap);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pState), _mm_shuffle_epi8(ClmulGfMul(x, h), swap));
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+bool Aes::SetKey(const uint8_t* pKey, size_t keyLen)
+{
+    if ((pKey == nullptr) || ((keyLen != 16U) && (keyLen != 24U) && (keyLen != 32U)))
+    {
+        return false;
+    }
+
+    const size_t nk = keyLen / 4U;
+    mRounds = nk + 6U;
+    const size_t total = 4U * (mRounds + 1U);
+
+    for (size_t i = 0U; i < nk; i++)
+    {
+        mRoundKeys[i] = Load32Be(&pKey[4U * i]);
+    }
+
+    uint8_t rcon = 0x01U;
+    for (size_t i = nk; i < total; i++)
+    {
+        uint32_t temp = mRoundKeys[i - 1U];
+        if ((i % nk) == 0U)
+        {
+            temp = (temp << 8U) | (temp >> 24U);
+            temp = (static_cast<uint32_t>(kTables.sbox[(temp >> 24U) & 0xFFU]) << 24U)
+                 | (static_cast<uint32_t>(kTables.sbox[(temp >> 16U) & 0xFFU]) << 16U)
+                 | (static_cast<uint32_t>(kTables.sbox[(temp >> 8U) & 0xFFU]) << 8U)
+                 | static_cast<uint32_t>(kTables.sbox[temp & 0xFFU]);
+            temp ^= static_cast<uint32_t>(rcon) << 24U;
+            rcon = XTime(rcon);
+        }
+        else if ((nk > 6U) && ((i % nk) == 4U))
+        {
+            temp = (static_cast<uint32_t>(kTables.sbox[(temp >> 24U) & 0xFFU]) << 24U)
+                 | (static_cast<uint32_t>(kTables.sbox[(temp >> 16U) & 0xFFU]) << 16U)
+                 | (static_cast<uint32_t>(kTables.sbox[(temp >> 8U) & 0xFFU]) << 8U)
+                 | static_cast<uint32_t>(kTables.sbox[temp & 0xFFU]);
+        }
+        mRoundKeys[i] = mRoundKeys[i - nk] ^ temp;
+    }
+
+    for (size_t i = 0U; i < total; i++)
+    {
+        Store32Be(&mRoundKeyBytes[4U * i], mRoundKeys[i]);
+    }
+
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+    static const bool hasAesNi = CpuHasAesNi();
+    mAccelerated = hasAesNi;
+#endif
+    return true;
+}
+
+
+void Aes::EncryptBlock(const uint8_t* pIn, uint8_t* pOut) const
+{
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+    if (mAccelerated)
+    {
+        AesNiEncrypt(mRoundKeyBytes.data(), mRounds, pIn, pOut);
+        return;
+    }
+#endif
+
+    const auto& te = kTables.te0;
+    const auto& sb = kTables.sbox;
+    const uint32_t* rk = mRoundKeys.data();
+
+    uint32_t s0 = Load32Be(&pIn[0]) ^ rk[0];
+    uint32_t s1 = Load32Be(&pIn[4]) ^ rk[1];
+    uint32_t s2 = Load32Be(&pIn[8]) ^ rk[2];
+    uint32_t s3 = Load32Be(&pIn[12]) ^ rk[3];
+
+    for (size_t r = 1U; r < mRounds; r++)
+    {
+        rk += 4;
+        const uint32_t t0 = te[s0 >> 24U] ^ Ror(te[(s1 >> 16U) & 0xFFU], 8U) ^ Ror(te[(s2 >> 8U) & 0xFFU], 16U) ^ Ror(te[s3 & 0xFFU], 24U) ^ rk[0];
+        const uint32_t t1 = te[s1 >> 24U] ^ Ror(te[(s2 >> 16U) & 0xFFU], 8U) ^ Ror(te[(s3 >> 8U) & 0xFFU], 16U) ^ Ror(te[s0 & 0xFFU], 24U) ^ rk[1];
+        const uint32_t t2 = te[s2 >> 24U] ^ Ror(te[(s3 >> 16U) & 0xFFU], 8U) ^ Ror(te[(s0 >> 8U) & 0xFFU], 16U) ^ Ror(te[s1 & 0xFFU], 24U) ^ rk[2];
+        const uint32_t t3 = te[s3 >> 24U] ^ Ror(te[(s0 >> 16U) & 0xFFU], 8U) ^ Ror(te[(s1 >> 8U) & 0xFFU], 16U) ^ Ror(te[s2 & 0xFFU], 24U) ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+    rk += 4;
+
+    auto lastRound = [&sb](uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t k) -> uint32_t
+    {
+        return ((static_cast<uint32_t>(sb[a >> 24U]) << 24U)
+              | (static_cast<uint32_t>(sb[(b >> 16U) & 0xFFU]) << 16U)
+              | (static_cast<uint32_t>(sb[(c >> 8U) & 0xFFU]) << 8U)
+              | static_cast<uint32_t>(sb[d & 0xFFU])) ^ k;
+    };
+
+    Store32Be(&pOut[0], lastRound(s0, s1, s2, s3, rk[0]));
+    Store32Be(&pOut[4], lastRound(s1, s2, s3, s0, rk[1]));
+    Store32Be(&pOut[8], lastRound(s2, s3, s0, s1, rk[2]));
+    Store32Be(&pOut[12], lastRound(s3, s0, s1, s2, rk[3]));
+}
+
+
+void Aes::Ctr(std::array<uint8_t, BLOCK_SIZE>& counter, const uint8_t* pIn, uint8_t* pOut, size_t len) const
+{
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+    if (mAccelerated)
+    {
+        AesNiCtr(mRoundKeyBytes.data(), mRounds, counter, pIn, pOut, len);
+        return;
+    }
+#endif
+
+    while (len > 0U)
+    {
+        uint8_t ks[BLOCK_SIZE];
+        EncryptBlock(counter.data(), ks);
+        Inc32(counter);
+        const size_t n = (len < BLOCK_SIZE) ? len : BLOCK_SIZE;
+        for (size_t i = 0U; i < n; i++)
+        {
+            pOut[i] = static_cast<uint8_t>(pIn[i] ^ ks[i]);
+        }
+        pIn += n;
+        pOut += n;
+        len -= n;
+    }
+}
+
+
+void GHash::SetKey(const std::array<uint8_t, Aes::BLOCK_SIZE>& h)
+{
+    mH = h;
+
+    uint64_t vh = Load64Be(&h[0]);
+    uint64_t vl = Load64Be(&h[8]);
+    mHl[8] = vl;
+    mHh[8] = vh;
+    mHl[0] = 0U;
+    mHh[0] = 0U;
+
+    for (size_t i = 4U; i > 0U; i >>= 1U)
+    {
+        const uint32_t t = static_cast<uint32_t>(vl & 1U) * 0xE1000000U;
+        vl = (vh << 63U) | (vl >> 1U);
+        vh = (vh >> 1U) ^ (static_cast<uint64_t>(t) << 32U);
+        mHl[i] = vl;
+        mHh[i] = vh;
+    }
+
+    for (size_t i = 2U; i <= 8U; i *= 2U)
+    {
+        vh = mHh[i];
+        vl = mHl[i];
+        for (size_t j = 1U; j < i; j++)
+        {
+            mHh[i + j] = vh ^ mHh[j];
+            mHl[i + j] = vl ^ mHl[j];
+        }
+    }
+
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+    static const bool hasPclmul = CpuHasPclmul();
+    mAccelerated = hasPclmul;
+#endif
+    Reset();
+}
+
+
+void GHash::Reset()
+{
+    mState.fill(0U);
+}
+
+
+void GHash::Multiply()
+{
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+    if (mAccelerated)
+    {
+        ClmulMultiply(mState.data(), mH.data());
+        return;
+    }
+#endif
+
+    const uint8_t* x = mState.data();
+    uint8_t lo = static_cast<uint8_t>(x[15] & 0x0FU);
+    uint64_t zh = mHh[lo];
+    uint64_t zl = mHl[lo];
+
+    for (int i = 15; i >= 0; i--)
+    {
+        lo = static_cast<uint8_t>(x[i] & 0x0FU);
+        const uint8_t hi = static_cast<uint8_t>((x[i] >> 4U) & 0x0FU);
+
+        if (i != 15)
+        {
+            const uint8_t rem = static_cast<uint8_t>(zl & 0x0FU);
+            zl = (zh << 60U) | (zl >> 4U);
+            zh = (zh >> 4U) ^ (kLast4[rem] << 48U);
+            zh ^= mHh[lo];
+            zl ^= mHl[lo];
+        }
+
+        const uint8_t rem = static_cast<uint8_t>(zl & 0x0FU);
+        zl = (zh << 60U) | (zl >> 4U);
+        zh = (zh >> 4U) ^ (kLast4[rem] << 48U);
+        zh ^= mHh[hi];
+        zl ^= mHl[hi];
+    }
+
+    Store64Be(&mState[0], zh);
+    Store64Be(&mState[8], zl);
+}
+
+
+void GHash::Update(const uint8_t* pData, size_t len)
+{
+    while (len > 0U)
+    {
+        const size_t n = (len < Aes::BLOCK_SIZE) ? len : Aes::BLOCK_SIZE;
+        for (size_t i = 0U; i < n; i++)
+        {
+            mState[i] ^= pData[i];
+        }
+        Multiply();
+        pData += n;
+        len -= n;
+    }
+}
+
+
+void GHash::Final(uint64_t aadLen, uint64_t dataLen, std::array<uint8_t, Aes::BLOCK_SIZE>& out)
+{
+    uint8_t lenBlock[Aes::BLOCK_SIZE];
+    Store64Be(&lenBlock[0], aadLen * 8U);
+    Store64Be(&lenBlock[8], dataLen * 8U);
+    Update(lenBlock, sizeof(lenBlock));
+    out = mState;
+}
@@ -0,0 +1,164 @@
+/**
+ ********************************************************************************
+ * @file        Aes.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, portable AES block cipher with CTR keystream and GHASH.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides the AES forward cipher (128/192/256 bit) and the CTR keystream.
+ * @details The software path uses 32-bit T-tables which are generated at compile time.
+ *          On x86-64 hosts the AES-NI instructions are used when the CPU supports them
+ *          (runtime check), the results are identical.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class Aes
+{
+    public:
+
+        /// @brief AES block size in bytes.
+        static constexpr size_t BLOCK_SIZE{16U};
+
+        /// @brief Maximal count of rounds (AES-256).
+        static constexpr size_t MAX_ROUNDS{14U};
+
+        /**
+         * @brief   Expand a key.
+         *
+         * @param   pKey    Key bytes.
+         * @param   keyLen  16, 24 or 32.
+         *
+         * @return  false on an invalid key length.
+         */
+        bool SetKey(const uint8_t* pKey, size_t keyLen);
+
+        /**
+         * @brief   Encrypt one block.
+         *
+         * @param   pIn     16 input bytes.
+         * @param   pOut    16 output bytes, may be equal to pIn.
+         */
+        void EncryptBlock(const uint8_t* pIn, uint8_t* pOut) const;
+
+        /**
+         * @brief   XOR the CTR keystream onto a buffer.
+         * @details The 32 LSBs of the counter block are incremented big endian per block,
+         *          which matches the CRYP peripheral and the GCM inc32 function.
+         *
+         * @param   counter Counter block, updated to the next unused value.
+         * @param   pIn     Input bytes.
+         * @param   pOut    Output bytes, may be equal to pIn.
+         * @param   len     Length in bytes, a partial last block consumes a full counter.
+         */
+        void Ctr(std::array<uint8_t, BLOCK_SIZE>& counter, const uint8_t* pIn, uint8_t* pOut, size_t len) const;
+
+        /// @brief True if the AES-NI path is used.
+        bool IsAccelerated() const {return mAccelerated;};
+
+        /// @brief Count of rounds of the expanded key.
+        size_t GetRounds() const {return mRounds;};
+
+        /// @brief Expanded round keys in byte order (FIPS-197 layout).
+        const uint8_t* GetRoundKeys() const {return mRoundKeyBytes.data();};
+
+    private:
+
+        /// @brief Expanded round keys, big endian words.
+        std::array<uint32_t, 4U * (MAX_ROUNDS + 1U)> mRoundKeys{};
+
+        /// @brief Expanded round keys, byte order (used by AES-NI).
+        std::array<uint8_t, 16U * (MAX_ROUNDS + 1U)> mRoundKeyBytes{};
+
+        /// @brief Count of rounds, 10, 12 or 14.
+        size_t mRounds{0U};
+
+        /// @brief True if the hardware path is used.
+        bool mAccelerated{false};
+};
+
+
+/**
+ * @brief   This class provides the GHASH universal hash of GCM.
+ * @details The software path uses 4-bit tables (Shoup), on x86-64 hosts PCLMULQDQ is used
+ *          when available.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class GHash
+{
+    public:
+
+        /**
+         * @brief   Set the hash subkey and reset the state.
+         *
+         * @param   h   Hash subkey H = E(K, 0^128).
+         */
+        void SetKey(const std::array<uint8_t, Aes::BLOCK_SIZE>& h);
+
+        /// @brief Reset the state, keep the key.
+        void Reset();
+
+        /**
+         * @brief   Absorb data, a partial last block is zero padded.
+         * @note    Every call is padded to a block boundary (GCM processes AAD and ciphertext
+         *          separately), so only the last call per section may pass a partial block.
+         *
+         * @param   pData   Input bytes.
+         * @param   len     Length in bytes.
+         */
+        void Update(const uint8_t* pData, size_t len);
+
+        /**
+         * @brief   Absorb the length block and return the hash.
+         *
+         * @param   aadLen      AAD length in bytes.
+         * @param   dataLen     Ciphertext length in bytes.
+         * @param   out         Hash value.
+         */
+        void Final(uint64_t aadLen, uint64_t dataLen, std::array<uint8_t, Aes::BLOCK_SIZE>& out);
+
+    private:
+
+        /// @brief Multiply the state with H.
+        void Multiply();
+
+        /// @brief Shoup table, high halves.
+        std::array<uint64_t, 16> mHh{};
+
+        /// @brief Shoup table, low halves.
+        std::array<uint64_t, 16> mHl{};
+
+        /// @brief Hash subkey.
+        std::array<uint8_t, Aes::BLOCK_SIZE> mH{};
+
+        /// @brief Running state.
+        std::array<uint8_t, Aes::BLOCK_SIZE> mState{};
+
+        /// @brief True if the PCLMULQDQ path is used.
+        bool mAccelerated{false};
+};
+
+} // end namespace Crypto
@@ -0,0 +1,221 @@
+/**
+ ********************************************************************************
+ * @file        CryptoEngineHal.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, CRYP peripheral engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CryptoEngineHal.hpp"
+#include "DCache.hpp"
+
+#if defined(CRYP)
+#include <cstring>
+
+using namespace Crypto;
+
+CryptoEngineHal* CryptoEngineHal::spInstance{nullptr};
+
+namespace {
+
+inline uint32_t Load32Be(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24U) | (static_cast<uint32_t>(p[1]) << 16U)
+         | (static_cast<uint32_t>(p[2]) << 8U) | static_cast<uint32_t>(p[3]);
+}
+
+inline bool IsWordAligned(const void* p)
+{
+    return (reinterpret_cast<uintptr_t>(p) & 0x3U) == 0U;
+}
+
+} // end anonymous namespace
+
+
+CryptoEngineHal::CryptoEngineHal(CRYP_HandleTypeDef& hcryp)
+: mHcryp(hcryp)
+{
+    spInstance = this;
+}
+
+
+CryptoEngineHal::~CryptoEngineHal()
+{
+    spInstance = nullptr;
+}
+
+
+CryptoEngineHal* CryptoEngineHal::FromHandle(const CRYP_HandleTypeDef* hcryp)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHcryp == hcryp))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status CryptoEngineHal::Start(CryptoJob& job)
+{
+    if ((job.length > 0xFFFFU) || (job.aadLength > 0xFFFFU)
+        || !IsWordAligned(job.pInput) || !IsWordAligned(job.pOutput) || !IsWordAligned(job.pAad))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    const AesKey& key = *job.pKey;
+    mKeyWords.fill(0U);
+    for (uint32_t i = 0U; i < (key.length / 4U); i++)
+    {
+        mKeyWords[i] = Load32Be(&key.bytes[4U * i]);
+    }
+
+    const bool gcm = (job.algorithm == Algorithm::AES_GCM);
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        mIvWords[i] = Load32Be(&job.iv[4U * i]);
+    }
+    if (gcm)
+    {
+        // the peripheral starts the payload with inc32(J0)
+        mIvWords[3] = 0x00000002U;
+    }
+
+    CRYP_ConfigTypeDef conf{};
+    conf.DataType = CRYP_BYTE_SWAP;
+    conf.KeySize = (key.length == 16U) ? CRYP_KEYSIZE_128B : ((key.length == 24U) ? CRYP_KEYSIZE_192B : CRYP_KEYSIZE_256B);
+    conf.pKey = mKeyWords.data();
+    conf.pInitVect = mIvWords.data();
+    conf.Algorithm = gcm ? CRYP_AES_GCM : CRYP_AES_CTR;
+    conf.Header = const_cast<uint32_t*>(reinterpret_cast<const uint32_t*>(job.pAad));
+    conf.HeaderSize = job.aadLength;
+    conf.B0 = nullptr;
+    conf.DataWidthUnit = CRYP_DATAWIDTHUNIT_BYTE;
+    conf.HeaderWidthUnit = CRYP_HEADERWIDTHUNIT_BYTE;
+    conf.KeyIVConfigSkip = CRYP_KEYIVCONFIG_ALWAYS;
+
+    if (HAL_CRYP_SetConfig(&mHcryp, &conf) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+
+    mpJob = &job;
+
+    if (job.length == 0U)
+    {
+        // nothing for the DMA, a GCM tag over the AAD only still needs the init and header phase
+        if (gcm && (HAL_CRYP_Encrypt(&mHcryp, nullptr, 0U, nullptr, TAG_TIMEOUT_MS) != HAL_OK))
+        {
+            mpJob = nullptr;
+            return Status::HW_ERROR;
+        }
+        Complete(Status::OK);
+        return Status::OK;
+    }
+
+    Utils::DCache::Clean(job.pInput, job.length);
+    if (job.pOutput != job.pInput)
+    {
+        Utils::DCache::CleanInvalidate(job.pOutput, job.length);
+    }
+
+    uint32_t* pIn = const_cast<uint32_t*>(reinterpret_cast<const uint32_t*>(job.pInput));
+    uint32_t* pOut = reinterpret_cast<uint32_t*>(job.pOutput);
+    const uint16_t size = static_cast<uint16_t>(job.length);
+    const HAL_StatusTypeDef rc = (job.direction == Direction::ENCRYPT)
+                               ? HAL_CRYP_Encrypt_DMA(&mHcryp, pIn, size, pOut)
+                               : HAL_CRYP_Decrypt_DMA(&mHcryp, pIn, size, pOut);
+    if (rc != HAL_OK)
+    {
+        mpJob = nullptr;
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+void CryptoEngineHal::OnTransferComplete()
+{
+    Complete(Status::OK);
+}
+
+
+void CryptoEngineHal::OnError()
+{
+    Complete(Status::HW_ERROR);
+}
+
+
+void CryptoEngineHal::Complete(Status status)
+{
+    CryptoJob* pJob = mpJob;
+    if (pJob == nullptr)
+    {
+        return;
+    }
+    mpJob = nullptr;
+
+    if (pJob->length > 0U)
+    {
+        Utils::DCache::Invalidate(pJob->pOutput, pJob->length);
+    }
+
+    if ((status == Status::OK) && (pJob->algorithm == Algorithm::AES_GCM))
+    {
+        if (HAL_CRYPEx_AESGCM_GenerateAuthTAG(&mHcryp, mTagWords.data(), TAG_TIMEOUT_MS) != HAL_OK)
+        {
+            status = Status::HW_ERROR;
+        }
+        else if (pJob->direction == Direction::ENCRYPT)
+        {
+            // byte swap mode, the words are already in stream order
+            std::memcpy(pJob->tag.data(), mTagWords.data(), pJob->tag.size());
+        }
+        else
+        {
+            const uint8_t* pTag = reinterpret_cast<const uint8_t*>(mTagWords.data());
+            uint8_t diff = 0U;
+            for (size_t i = 0U; i < pJob->tag.size(); i++)
+            {
+                diff = static_cast<uint8_t>(diff | (pTag[i] ^ pJob->tag[i]));
+            }
+            if (diff != 0U)
+            {
+                std::memset(pJob->pOutput, 0, pJob->length);
+                status = Status::AUTH_FAILED;
+            }
+        }
+    }
+
+    if (mpListener != nullptr)
+    {
+        mpListener->OnJobDone(*pJob, status);
+    }
+}
+
+
+extern "C" void HAL_CRYP_OutCpltCallback(CRYP_HandleTypeDef* hcryp)
+{
+    CryptoEngineHal* pEngine = CryptoEngineHal::FromHandle(hcryp);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnTransferComplete();
+    }
+}
+
+
+extern "C" void HAL_CRYP_ErrorCallback(CRYP_HandleTypeDef* hcryp)
+{
+    CryptoEngineHal* pEngine = CryptoEngineHal::FromHandle(hcryp);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnError();
+    }
+}
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ ********************************************************************************
+ * @file        CryptoEngineHal.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, AES-CTR/GCM engine on the CRYP peripheral with DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICryptoEngine.hpp"
+#include "stm32h7xx_hal.h"
+#include <array>
+
+#if defined(CRYP)
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides an AES-CTR/GCM engine on top of HAL_CRYP_Encrypt_DMA / HAL_CRYP_Decrypt_DMA.
+ * @details Every job reconfigures key and IV (HAL_CRYP_SetConfig) and moves the payload by DMA.
+ *          The completion is reported from HAL_CRYP_OutCpltCallback, the GCM tag is generated there.
+ *          The D-Cache lines of the buffers are cleaned/invalidated around the transfer.
+ * @note    Only available on devices with CRYP (STM32H75x/H73x), the STM32H743 has none, use
+ *          CryptoEngineSoft there. The CRYP handle, its DMA handles and the interrupts are
+ *          initialised by the application (HAL_CRYP_Init / HAL_CRYP_MspInit).\n
+ *          The payload and the AAD must be word aligned and at most 65535 bytes per job.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one CryptoService.
+ *
+ */
+class CryptoEngineHal : public ICryptoEngine
+{
+    public:
+
+        /// @brief Timeout of the GCM final phase in ms.
+        static constexpr uint32_t TAG_TIMEOUT_MS{10U};
+
+        /**
+         * @brief   Constructs the engine for an initialised CRYP handle.
+         *
+         * @param   hcryp       The CRYP handle.
+         */
+        explicit CryptoEngineHal(CRYP_HandleTypeDef& hcryp);
+
+        /// @brief Destructor.
+        ~CryptoEngineHal() override;
+
+        /// @copydoc ICryptoEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ICryptoEngine::Start
+        Status Start(CryptoJob& job) override;
+
+        /// @brief Output DMA finished, called by HAL_CRYP_OutCpltCallback.
+        void OnTransferComplete();
+
+        /// @brief Peripheral or DMA error, called by HAL_CRYP_ErrorCallback.
+        void OnError();
+
+        /// @brief Engine bound to a CRYP handle or nullptr.
+        static CryptoEngineHal* FromHandle(const CRYP_HandleTypeDef* hcryp);
+
+    private:
+
+        /// @brief Report the active job.
+        void Complete(Status status);
+
+        /// @brief The CRYP handle.
+        CRYP_HandleTypeDef& mHcryp;
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief Job owned by the peripheral.
+        CryptoJob* volatile mpJob{nullptr};
+
+        /// @brief Key in register order (big endian words).
+        std::array<uint32_t, 8> mKeyWords{};
+
+        /// @brief IV / initial counter in register order.
+        std::array<uint32_t, 4> mIvWords{};
+
+        /// @brief GCM tag read back from the peripheral.
+        std::array<uint32_t, 4> mTagWords{};
+
+        /// @brief The single engine instance, the device has one CRYP.
+        static CryptoEngineHal* spInstance;
+};
+
+} // end namespace Crypto
+#endif
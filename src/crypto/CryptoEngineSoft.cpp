@@ -0,0 +1,139 @@
+/**
+ ********************************************************************************
+ * @file        CryptoEngineSoft.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, software AES-CTR/GCM engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CryptoEngineSoft.hpp"
+#include <cstring>
+
+using namespace Crypto;
+
+
+Status CryptoEngineSoft::Start(CryptoJob& job)
+{
+    const Status status = Process(job);
+    if (mpListener != nullptr)
+    {
+        mpListener->OnJobDone(job, status);
+    }
+    return Status::OK;
+}
+
+
+Status CryptoEngineSoft::Process(CryptoJob& job)
+{
+    if (job.pKey == nullptr)
+    {
+        return Status::INVALID_PARAM;
+    }
+    SelectKey(*job.pKey);
+    if (mCachedKey.length == 0U)
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    if (job.algorithm == Algorithm::AES_CTR)
+    {
+        std::array<uint8_t, Aes::BLOCK_SIZE> counter = job.iv;
+        mAes.Ctr(counter, job.pInput, job.pOutput, job.length);
+        return Status::OK;
+    }
+    return ProcessGcm(job);
+}
+
+
+void CryptoEngineSoft::SelectKey(const AesKey& key)
+{
+    if ((key.length == mCachedKey.length) && (std::memcmp(key.bytes.data(), mCachedKey.bytes.data(), key.length) == 0))
+    {
+        return;
+    }
+
+    mCachedKey.length = 0U;
+    if (mAes.SetKey(key.bytes.data(), key.length))
+    {
+        std::array<uint8_t, Aes::BLOCK_SIZE> h{};
+        mAes.EncryptBlock(h.data(), h.data());
+        mGHash.SetKey(h);
+        mCachedKey = key;
+    }
+}
+
+
+Status CryptoEngineSoft::ProcessGcm(CryptoJob& job)
+{
+    // J0 = IV || 0^31 || 1, the payload starts with inc32(J0)
+    std::array<uint8_t, Aes::BLOCK_SIZE> j0{};
+    std::memcpy(j0.data(), job.iv.data(), 12U);
+    j0[15] = 0x01U;
+    std::array<uint8_t, Aes::BLOCK_SIZE> counter = j0;
+    counter[15] = 0x02U;
+
+    mGHash.Reset();
+    if (job.aadLength > 0U)
+    {
+        mGHash.Update(job.pAad, job.aadLength);
+    }
+
+    const bool decrypt = (job.direction == Direction::DECRYPT);
+    const uint8_t* pIn = job.pInput;
+    uint8_t* pOut = job.pOutput;
+    size_t remaining = job.length;
+    while (remaining > 0U)
+    {
+        const size_t n = (remaining < CHUNK_SIZE) ? remaining : CHUNK_SIZE;
+        if (decrypt)
+        {
+            // hash the ciphertext before an in-place operation overwrites it
+            mGHash.Update(pIn, n);
+            mAes.Ctr(counter, pIn, pOut, n);
+        }
+        else
+        {
+            mAes.Ctr(counter, pIn, pOut, n);
+            mGHash.Update(pOut, n);
+        }
+        pIn += n;
+        pOut += n;
+        remaining -= n;
+    }
+
+    std::array<uint8_t, Aes::BLOCK_SIZE> tag{};
+    mGHash.Final(job.aadLength, job.length, tag);
+    std::array<uint8_t, Aes::BLOCK_SIZE> ekj0{};
+    mAes.EncryptBlock(j0.data(), ekj0.data());
+    for (size_t i = 0U; i < Aes::BLOCK_SIZE; i++)
+    {
+        tag[i] ^= ekj0[i];
+    }
+
+    if (!decrypt)
+    {
+        job.tag = tag;
+        return Status::OK;
+    }
+
+    // constant time compare, unauthenticated plaintext is never handed out
+    uint8_t diff = 0U;
+    for (size_t i = 0U; i < Aes::BLOCK_SIZE; i++)
+    {
+        diff = static_cast<uint8_t>(diff | (tag[i] ^ job.tag[i]));
+    }
+    if (diff != 0U)
+    {
+        if (job.length > 0U)
+        {
+            std::memset(job.pOutput, 0, job.length);
+        }
+        return Status::AUTH_FAILED;
+    }
+    return Status::OK;
+}
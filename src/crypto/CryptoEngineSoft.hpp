@@ -0,0 +1,86 @@
+/**
+ ********************************************************************************
+ * @file        CryptoEngineSoft.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, software AES-CTR/GCM engine (host backend and fallback).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICryptoEngine.hpp"
+#include "Aes.hpp"
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides a software AES-CTR/GCM engine with the ICryptoEngine interface.
+ * @details The job is processed synchronously inside @ref Start and reported to the listener
+ *          before Start returns. On the host the AES-NI and PCLMULQDQ instructions are used
+ *          if present, on the target it serves as fallback for devices without CRYP.
+ *          The expanded key and the GHASH tables are cached for consecutive jobs with the same key.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class CryptoEngineSoft : public ICryptoEngine
+{
+    public:
+
+        /// @brief Constructor.
+        CryptoEngineSoft() = default;
+
+        /// @brief Destructor.
+        ~CryptoEngineSoft() override = default;
+
+        /// @copydoc ICryptoEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ICryptoEngine::Start
+        Status Start(CryptoJob& job) override;
+
+        /**
+         * @brief   Process a job without listener (blocking).
+         *
+         * @param   job     The job descriptor.
+         *
+         * @return  Result of the job.
+         */
+        Status Process(CryptoJob& job);
+
+        /// @brief True if the AES-NI path is used.
+        bool IsAccelerated() const {return mAes.IsAccelerated();};
+
+    private:
+
+        /// @brief Chunk size of the interleaved GHASH/CTR loop, keeps the data in L1.
+        static constexpr size_t CHUNK_SIZE{1024U};
+
+        /// @brief Expand the key if it differs from the cached one.
+        void SelectKey(const AesKey& key);
+
+        /// @brief AES-GCM of one job.
+        Status ProcessGcm(CryptoJob& job);
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief Block cipher with the cached key schedule.
+        Aes mAes{};
+
+        /// @brief GHASH with the cached subkey.
+        GHash mGHash{};
+
+        /// @brief Key of the cached schedule.
+        AesKey mCachedKey{};
+};
+
+} // end namespace Crypto
@@ -0,0 +1,164 @@
+/**
+ ********************************************************************************
+ * @file        CryptoService.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, asynchronous job queue implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CryptoService.hpp"
+#include "CriticalSection.hpp"
+
+using namespace Crypto;
+
+
+CryptoService::CryptoService(ICryptoEngine& engine)
+: mEngine(engine)
+{
+    mEngine.SetListener(this);
+}
+
+
+CryptoService::~CryptoService()
+{
+    mEngine.SetListener(nullptr);
+}
+
+
+bool CryptoService::IsValid(const CryptoJob& job)
+{
+    bool valid = (job.pKey != nullptr);
+
+    if (valid)
+    {
+        const uint8_t keyLen = job.pKey->length;
+        valid = (keyLen == 16U) || (keyLen == 24U) || (keyLen == 32U);
+    }
+
+    if (valid && (job.length > 0U))
+    {
+        valid = (job.pInput != nullptr) && (job.pOutput != nullptr);
+        if (valid && (job.pInput != job.pOutput))
+        {
+            // in-place is fine, a partial overlap would destroy not yet processed input
+            const uint8_t* pIn = job.pInput;
+            const uint8_t* pOut = job.pOutput;
+            valid = ((pOut + job.length) <= pIn) || ((pIn + job.length) <= pOut);
+        }
+    }
+
+    if (valid && (job.aadLength > 0U))
+    {
+        valid = (job.algorithm == Algorithm::AES_GCM) && (job.pAad != nullptr);
+    }
+
+    return valid;
+}
+
+
+Status CryptoService::Submit(CryptoJob& job)
+{
+    if (!IsValid(job))
+    {
+        job.status = Status::INVALID_PARAM;
+        return Status::INVALID_PARAM;
+    }
+
+    job.status = Status::PENDING;
+    job.pNext = nullptr;
+    {
+        Utils::CriticalSection cs;
+        if (mpTail != nullptr)
+        {
+            mpTail->pNext = &job;
+        }
+        else
+        {
+            mpHead = &job;
+        }
+        mpTail = &job;
+    }
+
+    StartNext();
+    return Status::PENDING;
+}
+
+
+bool CryptoService::IsIdle() const
+{
+    Utils::CriticalSection cs;
+    return (mpActive == nullptr) && (mpHead == nullptr);
+}
+
+
+void CryptoService::StartNext()
+{
+    for (;;)
+    {
+        CryptoJob* pJob{nullptr};
+        {
+            Utils::CriticalSection cs;
+            if ((mpActive != nullptr) || (mpHead == nullptr) || mStarting)
+            {
+                return;
+            }
+            pJob = mpHead;
+            mpHead = pJob->pNext;
+            if (mpHead == nullptr)
+            {
+                mpTail = nullptr;
+            }
+            pJob->pNext = nullptr;
+            mpActive = pJob;
+            mStarting = true;
+        }
+
+        const Status status = mEngine.Start(*pJob);
+
+        {
+            Utils::CriticalSection cs;
+            mStarting = false;
+            if (status != Status::OK)
+            {
+                mpActive = nullptr;
+            }
+        }
+
+        if (status != Status::OK)
+        {
+            Finish(*pJob, status);
+        }
+    }
+}
+
+
+void CryptoService::OnJobDone(CryptoJob& job, Status status)
+{
+    {
+        Utils::CriticalSection cs;
+        mpActive = nullptr;
+    }
+
+    // keep the engine busy while the callback of the finished job runs
+    StartNext();
+    Finish(job, status);
+}
+
+
+void CryptoService::Finish(CryptoJob& job, Status status)
+{
+    {
+        Utils::CriticalSection cs;
+        mCompleted = mCompleted + 1U;
+    }
+    job.status = status;
+    if (job.pCallback != nullptr)
+    {
+        job.pCallback(job, job.pContext);
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ ********************************************************************************
+ * @file        CryptoService.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, asynchronous job queue in front of an AES engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICryptoEngine.hpp"
+#include <cstdint>
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides an asynchronous crypto job queue which pipelines jobs to one engine.
+ * @details Jobs are linked intrusively into a FIFO, so submitting never allocates or copies.
+ *          When the engine reports a job, the next job is started before the callback of the
+ *          finished job runs. This keeps the peripheral busy while the CPU handles the result.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.\n
+ * Submit may be called from threads and ISR's, the completion path runs in the engine context.
+ *
+ */
+class CryptoService : private ICryptoEngine::IListener
+{
+    public:
+
+        /**
+         * @brief   Constructs the service and binds it to the engine.
+         *
+         * @param   engine      The engine which executes the jobs.
+         */
+        explicit CryptoService(ICryptoEngine& engine);
+
+        /// @brief Destructor, unbinds the engine.
+        ~CryptoService();
+
+        CryptoService(CryptoService const &) = delete;             //!< Copy constructor
+        CryptoService& operator=(CryptoService const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Validate and queue a job.
+         *
+         * @param   job     The job descriptor, owned by the caller until completion.
+         *
+         * @return  PENDING if queued, INVALID_PARAM if the descriptor was rejected.
+         */
+        Status Submit(CryptoJob& job);
+
+        /**
+         * @brief   Check the descriptor of a job.
+         *
+         * @param   job     The job descriptor.
+         *
+         * @return  true if the job can be processed.
+         */
+        static bool IsValid(const CryptoJob& job);
+
+        /// @brief True if no job is queued or running.
+        bool IsIdle() const;
+
+        /// @brief Count of finished jobs since construction.
+        uint32_t GetCompletedCount() const {return mCompleted;};
+
+    private:
+
+        /// @brief Engine completion, see ICryptoEngine::IListener.
+        void OnJobDone(CryptoJob& job, Status status) override;
+
+        /// @brief Start queued jobs while the engine is idle.
+        void StartNext();
+
+        /// @brief Publish the result and call the user callback.
+        void Finish(CryptoJob& job, Status status);
+
+        /// @brief The executing engine.
+        ICryptoEngine& mEngine;
+
+        /// @brief First queued job.
+        CryptoJob* mpHead{nullptr};
+
+        /// @brief Last queued job.
+        CryptoJob* mpTail{nullptr};
+
+        /// @brief Job owned by the engine.
+        CryptoJob* volatile mpActive{nullptr};
+
+        /// @brief Set while ICryptoEngine::Start runs, turns synchronous completions into a loop.
+        volatile bool mStarting{false};
+
+        /// @brief Finished jobs.
+        volatile uint32_t mCompleted{0U};
+};
+
+} // end namespace Crypto
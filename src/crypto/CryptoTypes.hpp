@@ -0,0 +1,102 @@
+/**
+ ********************************************************************************
+ * @file        CryptoTypes.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, common types of the crypto offload service.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+namespace Crypto {
+
+
+/// @brief Result of a crypto operation or request.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    PENDING=1,        //!< Job is queued or running
+    INVALID_PARAM=2,  //!< Job descriptor is inconsistent (key size, buffers, lengths)
+    AUTH_FAILED=3,    //!< GCM decryption finished but the authentication tag did not match
+    HW_ERROR=4        //!< The engine reported an error (DMA, peripheral, timeout)
+};
+
+/// @brief Supported AES modes.
+enum class Algorithm : uint8_t
+{
+    AES_CTR=0,  //!< Counter mode, the 32 LSBs of the counter block are incremented per block (like the CRYP peripheral)
+    AES_GCM=1   //!< Galois counter mode with 96-bit IV and 128-bit tag
+};
+
+/// @brief Direction of a job.
+enum class Direction : uint8_t
+{
+    ENCRYPT=0,  //!< Plaintext to ciphertext, GCM writes the tag
+    DECRYPT=1   //!< Ciphertext to plaintext, GCM verifies the tag
+};
+
+
+/**
+ * @brief   AES key material, 128, 192 or 256 bit.
+ * @note    Engines may cache the expanded key schedule, a key object should not be modified
+ *          while a job which refers to it is pending.
+ */
+struct AesKey
+{
+    /// @brief Key bytes, only the first @ref length bytes are valid.
+    std::array<uint8_t, 32> bytes{};
+
+    /// @brief Key length in bytes: 16, 24 or 32.
+    uint8_t length{0U};
+};
+
+
+/**
+ * @brief   Descriptor of one crypto job.
+ * @details The descriptor and all referenced buffers are owned by the caller and must stay valid
+ *          until the completion callback has been called (or @ref status left PENDING).
+ *          The service never copies payload data. For in-place operation set pOutput equal to pInput.
+ * @note    For the DMA backend the buffers should be 32 byte aligned (D-Cache line size)
+ *          and must be located in a DMA accessible RAM (not DTCM).
+ */
+struct CryptoJob
+{
+    /// @brief Completion callback, called in the engine completion context (ISR on the target).
+    using Callback = void (*)(CryptoJob& job, void* pContext);
+
+    Algorithm algorithm{Algorithm::AES_GCM};    //!< AES mode
+    Direction direction{Direction::ENCRYPT};    //!< Encrypt or decrypt
+    const AesKey* pKey{nullptr};                //!< Key, must stay valid until completion
+
+    /// @brief GCM: the 12 byte IV in the first bytes. CTR: the complete 16 byte initial counter block.
+    std::array<uint8_t, 16> iv{};
+
+    const uint8_t* pAad{nullptr};               //!< GCM additional authenticated data (may be nullptr)
+    uint32_t aadLength{0U};                     //!< Length of the AAD in bytes
+
+    const uint8_t* pInput{nullptr};             //!< Input payload
+    uint8_t* pOutput{nullptr};                  //!< Output payload, may be equal to pInput
+    uint32_t length{0U};                        //!< Payload length in bytes
+
+    /// @brief GCM tag, written on encryption and expected on decryption.
+    std::array<uint8_t, 16> tag{};
+
+    Callback pCallback{nullptr};                //!< Optional completion callback
+    void* pContext{nullptr};                    //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or running.
+    volatile Status status{Status::OK};
+
+    /// @brief Intrusive queue link, owned by the service.
+    CryptoJob* pNext{nullptr};
+};
+
+} // end namespace Crypto
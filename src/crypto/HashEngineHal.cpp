@@ -0,0 +1,211 @@
+/**
+ ********************************************************************************
+ * @file        HashEngineHal.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, HASH peripheral engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "HashEngineHal.hpp"
+#include "DCache.hpp"
+
+#if defined(HASH)
+
+using namespace Crypto;
+
+HashEngineHal* HashEngineHal::spInstance{nullptr};
+
+namespace {
+
+inline bool IsWordAligned(const void* p)
+{
+    return (reinterpret_cast<uintptr_t>(p) & 0x3U) == 0U;
+}
+
+inline uint8_t* ContextBuffer(HashStream& stream)
+{
+    return reinterpret_cast<uint8_t*>(stream.engineContext.data());
+}
+
+} // end anonymous namespace
+
+
+HashEngineHal::HashEngineHal(HASH_HandleTypeDef& hhash)
+: mHhash(hhash)
+{
+    spInstance = this;
+}
+
+
+HashEngineHal::~HashEngineHal()
+{
+    spInstance = nullptr;
+}
+
+
+HashEngineHal* HashEngineHal::FromHandle(const HASH_HandleTypeDef* hhash)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHhash == hhash))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+void HashEngineHal::Release(HashStream& stream)
+{
+    if (mpResident == &stream)
+    {
+        mpResident = nullptr;
+    }
+}
+
+
+void HashEngineHal::SwitchTo(HashStream& stream)
+{
+    if (mpResident == &stream)
+    {
+        return;
+    }
+
+    if ((mpResident != nullptr) && mpResident->engineStarted)
+    {
+        HAL_HASH_ContextSaving(&mHhash, ContextBuffer(*mpResident));
+    }
+
+    if (stream.engineStarted)
+    {
+        HAL_HASH_ContextRestoring(&mHhash, ContextBuffer(stream));
+        mHhash.Phase = HAL_HASH_PHASE_PROCESS;
+    }
+    mpResident = &stream;
+}
+
+
+Status HashEngineHal::Feed(HashStream& stream, const uint8_t* pData, uint32_t len, bool last)
+{
+    if ((!last && ((len % 64U) != 0U)) || ((len > 0U) && (pData == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    SwitchTo(stream);
+    if (!stream.engineStarted)
+    {
+        // the next HAL call writes ALGO and INIT
+        mHhash.Phase = HAL_HASH_PHASE_READY;
+        stream.engineStarted = true;
+    }
+
+    mpStream = &stream;
+    mLast = last;
+
+    if ((len < DMA_THRESHOLD) || !IsWordAligned(pData))
+    {
+        HAL_StatusTypeDef rc = HAL_OK;
+        if (last)
+        {
+            __HAL_HASH_RESET_MDMAT();
+            rc = HAL_HASHEx_SHA256_Accmlt_End(&mHhash, pData, len, stream.digest.data(), TIMEOUT_MS);
+        }
+        else
+        {
+            rc = HAL_HASHEx_SHA256_Accmlt(&mHhash, pData, len);
+        }
+        Complete((rc == HAL_OK) ? Status::OK : Status::HW_ERROR);
+        return Status::OK;
+    }
+
+    Utils::DCache::Clean(pData, len);
+    if (last)
+    {
+        __HAL_HASH_RESET_MDMAT();
+    }
+    else
+    {
+        // multi buffer mode, no digest calculation at the end of the transfer
+        __HAL_HASH_SET_MDMAT();
+    }
+
+    if (HAL_HASHEx_SHA256_Start_DMA(&mHhash, pData, len) != HAL_OK)
+    {
+        mpStream = nullptr;
+        mpResident = nullptr;
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+void HashEngineHal::OnInputComplete()
+{
+    HashStream* pStream = mpStream;
+    if (pStream == nullptr)
+    {
+        return;
+    }
+
+    Status status = Status::OK;
+    if (mLast && (HAL_HASHEx_SHA256_Finish(&mHhash, pStream->digest.data(), TIMEOUT_MS) != HAL_OK))
+    {
+        status = Status::HW_ERROR;
+    }
+    Complete(status);
+}
+
+
+void HashEngineHal::OnError()
+{
+    Complete(Status::HW_ERROR);
+}
+
+
+void HashEngineHal::Complete(Status status)
+{
+    HashStream* pStream = mpStream;
+    if (pStream == nullptr)
+    {
+        return;
+    }
+    mpStream = nullptr;
+
+    if (mLast || (status != Status::OK))
+    {
+        // nothing worth saving, the next hash starts with INIT
+        pStream->engineStarted = false;
+        mpResident = nullptr;
+    }
+
+    if (mpListener != nullptr)
+    {
+        mpListener->OnFeedDone(*pStream, status);
+    }
+}
+
+
+extern "C" void HAL_HASH_InCpltCallback(HASH_HandleTypeDef* hhash)
+{
+    HashEngineHal* pEngine = HashEngineHal::FromHandle(hhash);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnInputComplete();
+    }
+}
+
+
+extern "C" void HAL_HASH_ErrorCallback(HASH_HandleTypeDef* hhash)
+{
+    HashEngineHal* pEngine = HashEngineHal::FromHandle(hhash);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnError();
+    }
+}
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ ********************************************************************************
+ * @file        HashEngineHal.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, SHA-256 engine on the HASH peripheral with DMA and context swapping.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IHashEngine.hpp"
+#include "stm32h7xx_hal.h"
+
+#if defined(HASH)
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides a SHA-256 engine on top of HAL_HASHEx_SHA256_Start_DMA.
+ * @details The peripheral holds the context of one stream (the resident stream). When a feed of
+ *          another stream arrives, the resident context is saved with HAL_HASH_ContextSaving into its
+ *          HashStream::engineContext and the new one is restored with HAL_HASH_ContextRestoring.
+ *          Consecutive feeds of the same stream skip the swap.\n
+ *          Intermediate feeds run with MDMAT set (multi buffer DMA, no digest), the last feed clears
+ *          MDMAT and the digest is read in HAL_HASH_InCpltCallback. Short or unaligned feeds are
+ *          written by the CPU (HAL_HASHEx_SHA256_Accmlt) because the DMA setup costs more.
+ * @note    Only available on devices with HASH (STM32H75x/H73x), the STM32H743 has none, use
+ *          HashEngineSoft there. The HASH handle (DataType HASH_DATATYPE_8B), its DMA handle and the
+ *          interrupts are initialised by the application (HAL_HASH_Init / HAL_HASH_MspInit).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one HashService.
+ *
+ */
+class HashEngineHal : public IHashEngine
+{
+    public:
+
+        /// @brief Timeout of the digest phase and of CPU feeds in ms.
+        static constexpr uint32_t TIMEOUT_MS{10U};
+
+        /// @brief Feeds below this size are written by the CPU.
+        static constexpr uint32_t DMA_THRESHOLD{256U};
+
+        /**
+         * @brief   Constructs the engine for an initialised HASH handle.
+         *
+         * @param   hhash       The HASH handle.
+         */
+        explicit HashEngineHal(HASH_HandleTypeDef& hhash);
+
+        /// @brief Destructor.
+        ~HashEngineHal() override;
+
+        /// @copydoc IHashEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IHashEngine::Feed
+        Status Feed(HashStream& stream, const uint8_t* pData, uint32_t len, bool last) override;
+
+        /// @copydoc IHashEngine::Release
+        void Release(HashStream& stream) override;
+
+        /// @brief Input DMA finished, called by HAL_HASH_InCpltCallback.
+        void OnInputComplete();
+
+        /// @brief Peripheral or DMA error, called by HAL_HASH_ErrorCallback.
+        void OnError();
+
+        /// @brief Engine bound to a HASH handle or nullptr.
+        static HashEngineHal* FromHandle(const HASH_HandleTypeDef* hhash);
+
+    private:
+
+        /// @brief Save the resident context and restore the one of the stream.
+        void SwitchTo(HashStream& stream);
+
+        /// @brief Report the active feed.
+        void Complete(Status status);
+
+        /// @brief The HASH handle.
+        HASH_HandleTypeDef& mHhash;
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief Stream whose context is in the peripheral.
+        HashStream* mpResident{nullptr};
+
+        /// @brief Stream of the running feed.
+        HashStream* volatile mpStream{nullptr};
+
+        /// @brief The running feed is the last one.
+        bool mLast{false};
+
+        /// @brief The single engine instance, the device has one HASH.
+        static HashEngineHal* spInstance;
+};
+
+} // end namespace Crypto
+#endif
@@ -0,0 +1,65 @@
+/**
+ ********************************************************************************
+ * @file        HashEngineSoft.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, software SHA-256 engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "HashEngineSoft.hpp"
+
+using namespace Crypto;
+
+
+Status HashEngineSoft::Feed(HashStream& stream, const uint8_t* pData, uint32_t len, bool last)
+{
+    if ((!last && ((len % Sha256::BLOCK_SIZE) != 0U)) || ((len > 0U) && (pData == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    Sha256::State state{};
+    uint64_t compressed{0U};
+    if (stream.engineStarted)
+    {
+        for (size_t i = 0U; i < state.size(); i++)
+        {
+            state[i] = stream.engineContext[i];
+        }
+        compressed = (static_cast<uint64_t>(stream.engineContext[9]) << 32U) | stream.engineContext[8];
+    }
+    else
+    {
+        Sha256::InitState(state);
+        stream.engineStarted = true;
+    }
+
+    if (last)
+    {
+        Sha256::Digest digest{};
+        Sha256::Finalize(state, compressed, pData, len, digest);
+        stream.digest = digest;
+    }
+    else
+    {
+        Sha256::Compress(state, pData, len / Sha256::BLOCK_SIZE);
+        compressed += len;
+        for (size_t i = 0U; i < state.size(); i++)
+        {
+            stream.engineContext[i] = state[i];
+        }
+        stream.engineContext[8] = static_cast<uint32_t>(compressed);
+        stream.engineContext[9] = static_cast<uint32_t>(compressed >> 32U);
+    }
+
+    if (mpListener != nullptr)
+    {
+        mpListener->OnFeedDone(stream, Status::OK);
+    }
+    return Status::OK;
+}
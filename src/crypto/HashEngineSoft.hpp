@@ -0,0 +1,61 @@
+/**
+ ********************************************************************************
+ * @file        HashEngineSoft.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, software SHA-256 engine (host backend and fallback).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IHashEngine.hpp"
+#include "Sha256.hpp"
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides a software SHA-256 engine with the IHashEngine interface.
+ * @details The feed is processed synchronously inside @ref Feed and reported to the listener
+ *          before Feed returns. The stream context holds the chaining state (words 0..7) and the
+ *          count of compressed bytes (words 8..9). On the host the SHA extensions are used if present.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class HashEngineSoft : public IHashEngine
+{
+    public:
+
+        /// @brief Constructor.
+        HashEngineSoft() = default;
+
+        /// @brief Destructor.
+        ~HashEngineSoft() override = default;
+
+        /// @copydoc IHashEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IHashEngine::Feed
+        Status Feed(HashStream& stream, const uint8_t* pData, uint32_t len, bool last) override;
+
+        /// @copydoc IHashEngine::Release
+        void Release(HashStream& stream) override {(void)stream;};
+
+        /// @brief True if the SHA-NI path is used.
+        bool IsAccelerated() const {return Sha256::IsAccelerated();};
+
+    private:
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+};
+
+} // end namespace Crypto
@@ -0,0 +1,455 @@
+/**
+ ********************************************************************************
+ * @file        HashService.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, multi-stream SHA-256/HMAC service implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "HashService.hpp"
+#include "Sha256.hpp"
+#include "CriticalSection.hpp"
+#include <cstring>
+
+using namespace Crypto;
+
+namespace {
+
+constexpr uint8_t IPAD{0x36U};
+constexpr uint8_t OPAD{0x5CU};
+
+} // end anonymous namespace
+
+
+HashService::HashService(IHashEngine& engine)
+: mEngine(engine)
+{
+    mEngine.SetListener(this);
+}
+
+
+HashService::~HashService()
+{
+    mEngine.SetListener(nullptr);
+}
+
+
+bool HashService::IsBusy(const HashStream& stream)
+{
+    Utils::CriticalSection cs;
+    return stream.scheduled || (stream.pHead != nullptr);
+}
+
+
+Status HashService::Open(HashStream& stream)
+{
+    if (IsBusy(stream))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    mEngine.Release(stream);
+    stream.algorithm = HashAlgorithm::SHA256;
+    stream.outerPad.fill(0U);
+    ResetMessage(stream);
+    return Status::OK;
+}
+
+
+Status HashService::OpenHmac(HashStream& stream, const uint8_t* pKey, size_t keyLen)
+{
+    if (((pKey == nullptr) && (keyLen > 0U)) || IsBusy(stream))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    std::array<uint8_t, Sha256::BLOCK_SIZE> k0{};
+    if (keyLen > Sha256::BLOCK_SIZE)
+    {
+        // rare, hashed on the CPU instead of a queued turn
+        const Sha256::Digest kh = Sha256::Hash(pKey, keyLen);
+        std::memcpy(k0.data(), kh.data(), kh.size());
+    }
+    else if (keyLen > 0U)
+    {
+        std::memcpy(k0.data(), pKey, keyLen);
+    }
+
+    mEngine.Release(stream);
+    stream.algorithm = HashAlgorithm::HMAC_SHA256;
+    for (size_t i = 0U; i < k0.size(); i++)
+    {
+        stream.outerPad[i] = static_cast<uint8_t>(k0[i] ^ OPAD);
+    }
+    k0.fill(0U);
+    ResetMessage(stream);
+    return Status::OK;
+}
+
+
+Status HashService::Close(HashStream& stream)
+{
+    if (IsBusy(stream))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    mEngine.Release(stream);
+    stream.outerPad.fill(0U);
+    stream.carry.fill(0U);
+    stream.carryLength = 0U;
+    stream.engineStarted = false;
+    return Status::OK;
+}
+
+
+Status HashService::Submit(HashStream& stream, HashRequest& request)
+{
+    if (((request.length > 0U) && (request.pData == nullptr)) || (request.final && (request.pDigest == nullptr)))
+    {
+        request.status = Status::INVALID_PARAM;
+        return Status::INVALID_PARAM;
+    }
+
+    request.status = Status::PENDING;
+    request.offset = 0U;
+    request.pNext = nullptr;
+    {
+        Utils::CriticalSection cs;
+        if (stream.pTail != nullptr)
+        {
+            stream.pTail->pNext = &request;
+        }
+        else
+        {
+            stream.pHead = &request;
+        }
+        stream.pTail = &request;
+
+        if (!stream.scheduled)
+        {
+            stream.scheduled = true;
+            stream.pNextReady = nullptr;
+            if (mpReadyTail != nullptr)
+            {
+                mpReadyTail->pNextReady = &stream;
+            }
+            else
+            {
+                mpReadyHead = &stream;
+            }
+            mpReadyTail = &stream;
+        }
+    }
+
+    Dispatch();
+    return Status::PENDING;
+}
+
+
+bool HashService::IsIdle() const
+{
+    Utils::CriticalSection cs;
+    return (mpActive == nullptr) && (mpReadyHead == nullptr);
+}
+
+
+void HashService::Dispatch()
+{
+    for (;;)
+    {
+        HashStream* pStream{nullptr};
+        {
+            Utils::CriticalSection cs;
+            if ((mpActive != nullptr) || (mpReadyHead == nullptr) || mDispatching)
+            {
+                return;
+            }
+            pStream = mpReadyHead;
+            mpReadyHead = pStream->pNextReady;
+            if (mpReadyHead == nullptr)
+            {
+                mpReadyTail = nullptr;
+            }
+            pStream->pNextReady = nullptr;
+            mpActive = pStream;
+            mDispatching = true;
+        }
+
+        HashRequest* pAbsorbed{nullptr};
+        Slice slice{};
+        const bool feed = NextSlice(*pStream, slice, pAbsorbed);
+        Status status{Status::OK};
+        if (feed)
+        {
+            mSlice = slice;
+            status = mEngine.Feed(*pStream, slice.pData, slice.length, slice.last);
+        }
+
+        {
+            Utils::CriticalSection cs;
+            mDispatching = false;
+            if (!feed || (status != Status::OK))
+            {
+                mpActive = nullptr;
+            }
+        }
+
+        HashRequest* pFailed{nullptr};
+        if (status != Status::OK)
+        {
+            Utils::CriticalSection cs;
+            pFailed = pStream->pHead;
+            pStream->pHead = nullptr;
+            pStream->pTail = nullptr;
+        }
+        if (pFailed != nullptr)
+        {
+            mEngine.Release(*pStream);
+            ResetMessage(*pStream);
+        }
+
+        if (!feed || (status != Status::OK))
+        {
+            // a started feed reschedules the stream in OnFeedDone
+            Reschedule(*pStream);
+        }
+        Finish(pAbsorbed, Status::OK);
+        Finish(pFailed, status);
+    }
+}
+
+
+bool HashService::NextSlice(HashStream& stream, Slice& slice, HashRequest*& pDone)
+{
+    HashRequest* pDoneTail{nullptr};
+
+    for (;;)
+    {
+        if (stream.phase == HashStream::Phase::OUTER_KEY)
+        {
+            slice = {stream.carry.data(), stream.carryLength, false, true};
+            return true;
+        }
+        if (stream.phase == HashStream::Phase::OUTER_DIGEST)
+        {
+            slice = {stream.carry.data(), stream.carryLength, true, true};
+            return true;
+        }
+
+        HashRequest* pRequest{nullptr};
+        {
+            Utils::CriticalSection cs;
+            pRequest = stream.pHead;
+        }
+        if (pRequest == nullptr)
+        {
+            return false;
+        }
+
+        const uint8_t* pData = (pRequest->pData != nullptr) ? &pRequest->pData[pRequest->offset] : nullptr;
+        uint32_t remaining = pRequest->length - pRequest->offset;
+
+        if (stream.carryLength > 0U)
+        {
+            // complete the partial block first, the rest of the chunk is read in place
+            const uint32_t space = static_cast<uint32_t>(stream.carry.size()) - stream.carryLength;
+            const uint32_t take = (remaining < space) ? remaining : space;
+            if (take > 0U)
+            {
+                std::memcpy(&stream.carry[stream.carryLength], pData, take);
+                stream.carryLength = static_cast<uint8_t>(stream.carryLength + take);
+                pRequest->offset += take;
+                remaining -= take;
+            }
+
+            const bool endOfMessage = pRequest->final && (remaining == 0U);
+            if ((stream.carryLength == stream.carry.size()) || endOfMessage)
+            {
+                slice = {stream.carry.data(), stream.carryLength, endOfMessage, true};
+                return true;
+            }
+        }
+        else if (pRequest->final && (remaining <= SLICE_SIZE))
+        {
+            slice = {pData, remaining, true, false};
+            pRequest->offset += remaining;
+            return true;
+        }
+        else
+        {
+            uint32_t blocks = remaining & ~static_cast<uint32_t>(Sha256::BLOCK_SIZE - 1U);
+            blocks = (blocks < SLICE_SIZE) ? blocks : SLICE_SIZE;
+            if (blocks > 0U)
+            {
+                slice = {pData, blocks, false, false};
+                pRequest->offset += blocks;
+                return true;
+            }
+            if (remaining > 0U)
+            {
+                std::memcpy(stream.carry.data(), pData, remaining);
+                stream.carryLength = static_cast<uint8_t>(remaining);
+                pRequest->offset += remaining;
+            }
+        }
+
+        // the chunk ended in the carry, it is done without engine turn
+        HashRequest* pAbsorbed = PopHead(stream);
+        if (pDoneTail != nullptr)
+        {
+            pDoneTail->pNext = pAbsorbed;
+        }
+        else
+        {
+            pDone = pAbsorbed;
+        }
+        pDoneTail = pAbsorbed;
+    }
+}
+
+
+void HashService::OnFeedDone(HashStream& stream, Status status)
+{
+    HashRequest* pDone{nullptr};
+
+    if (status != Status::OK)
+    {
+        {
+            Utils::CriticalSection cs;
+            pDone = stream.pHead;
+            stream.pHead = nullptr;
+            stream.pTail = nullptr;
+        }
+        mEngine.Release(stream);
+        ResetMessage(stream);
+    }
+    else
+    {
+        if (mSlice.fromCarry)
+        {
+            stream.carryLength = 0U;
+        }
+
+        if (stream.phase == HashStream::Phase::OUTER_KEY)
+        {
+            stream.phase = HashStream::Phase::OUTER_DIGEST;
+            std::memcpy(stream.carry.data(), stream.digest.data(), stream.digest.size());
+            stream.carryLength = static_cast<uint8_t>(stream.digest.size());
+        }
+        else if (mSlice.last && (stream.algorithm == HashAlgorithm::HMAC_SHA256) && (stream.phase == HashStream::Phase::INNER))
+        {
+            stream.phase = HashStream::Phase::OUTER_KEY;
+            stream.engineStarted = false;
+            stream.carry = stream.outerPad;
+            stream.carryLength = static_cast<uint8_t>(stream.carry.size());
+        }
+        else if (mSlice.last)
+        {
+            pDone = PopHead(stream);
+            std::memcpy(pDone->pDigest, stream.digest.data(), stream.digest.size());
+            ResetMessage(stream);
+        }
+        else
+        {
+            HashRequest* pHead{nullptr};
+            {
+                Utils::CriticalSection cs;
+                pHead = stream.pHead;
+            }
+            if ((pHead != nullptr) && !pHead->final && (pHead->offset == pHead->length))
+            {
+                pDone = PopHead(stream);
+            }
+        }
+    }
+
+    {
+        Utils::CriticalSection cs;
+        mpActive = nullptr;
+    }
+
+    // keep the engine busy while the callbacks run
+    Reschedule(stream);
+    Dispatch();
+    Finish(pDone, status);
+}
+
+
+void HashService::Reschedule(HashStream& stream)
+{
+    Utils::CriticalSection cs;
+    if (stream.pHead == nullptr)
+    {
+        stream.scheduled = false;
+        return;
+    }
+
+    stream.pNextReady = nullptr;
+    if (mpReadyTail != nullptr)
+    {
+        mpReadyTail->pNextReady = &stream;
+    }
+    else
+    {
+        mpReadyHead = &stream;
+    }
+    mpReadyTail = &stream;
+}
+
+
+void HashService::ResetMessage(HashStream& stream)
+{
+    stream.engineStarted = false;
+    stream.phase = HashStream::Phase::INNER;
+    stream.carryLength = 0U;
+
+    if (stream.algorithm == HashAlgorithm::HMAC_SHA256)
+    {
+        // K ^ ipad == (K ^ opad) ^ (opad ^ ipad)
+        for (size_t i = 0U; i < stream.carry.size(); i++)
+        {
+            stream.carry[i] = static_cast<uint8_t>(stream.outerPad[i] ^ (OPAD ^ IPAD));
+        }
+        stream.carryLength = static_cast<uint8_t>(stream.carry.size());
+    }
+}
+
+
+HashRequest* HashService::PopHead(HashStream& stream)
+{
+    Utils::CriticalSection cs;
+    HashRequest* pRequest = stream.pHead;
+    stream.pHead = pRequest->pNext;
+    if (stream.pHead == nullptr)
+    {
+        stream.pTail = nullptr;
+    }
+    pRequest->pNext = nullptr;
+    return pRequest;
+}
+
+
+void HashService::Finish(HashRequest* pList, Status status)
+{
+    while (pList != nullptr)
+    {
+        HashRequest* pRequest = pList;
+        pList = pRequest->pNext;
+        pRequest->pNext = nullptr;
+        {
+            Utils::CriticalSection cs;
+            mCompleted = mCompleted + 1U;
+        }
+        pRequest->status = status;
+        if (pRequest->pCallback != nullptr)
+        {
+            pRequest->pCallback(*pRequest, pRequest->pContext);
+        }
+    }
+}
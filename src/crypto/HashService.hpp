@@ -0,0 +1,164 @@
+/**
+ ********************************************************************************
+ * @file        HashService.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, incremental multi-stream SHA-256/HMAC service in front of a hash engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IHashEngine.hpp"
+#include <cstdint>
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides incremental SHA-256 and HMAC-SHA256 for many concurrent streams on one engine.
+ * @details Each stream queues its requests intrusively. The engine time-slices between the streams
+ *          in round robin, one turn is at most @ref SLICE_SIZE bytes, so a long image hash does not
+ *          block a short HMAC of another user. The stream context is swapped at every turn border
+ *          (registers of the HASH peripheral or the software chaining state).\n
+ *          HMAC is built on the plain hash: K ^ ipad is fed as first block, the outer hash
+ *          H((K ^ opad) || inner) is two more short turns. The key is bound once per stream and
+ *          reused for every following message.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.\n
+ * Submit may be called from threads and ISR's, the completion path runs in the engine context.
+ * Open/Close of one stream must not race with Submit on the same stream.
+ *
+ */
+class HashService : private IHashEngine::IListener
+{
+    public:
+
+        /// @brief Maximum bytes of one engine turn (multiple of the block size).
+        static constexpr uint32_t SLICE_SIZE{4096U};
+
+        /**
+         * @brief   Constructs the service and binds it to the engine.
+         *
+         * @param   engine      The engine which executes the feeds.
+         */
+        explicit HashService(IHashEngine& engine);
+
+        /// @brief Destructor, unbinds the engine.
+        ~HashService();
+
+        HashService(HashService const &) = delete;             //!< Copy constructor
+        HashService& operator=(HashService const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Prepare a stream for SHA-256.
+         *
+         * @param   stream  The stream, owned by the caller.
+         *
+         * @return  OK, INVALID_PARAM if the stream has pending requests.
+         */
+        Status Open(HashStream& stream);
+
+        /**
+         * @brief   Prepare a stream for HMAC-SHA256 with a key.
+         *
+         * @param   stream  The stream, owned by the caller.
+         * @param   pKey    Key bytes, copied (as pads) into the stream.
+         * @param   keyLen  Key length, keys longer than 64 bytes are hashed first.
+         *
+         * @return  OK, INVALID_PARAM if the stream has pending requests or the key is missing.
+         */
+        Status OpenHmac(HashStream& stream, const uint8_t* pKey, size_t keyLen);
+
+        /**
+         * @brief   Detach an idle stream from the engine before its memory is reused.
+         *
+         * @param   stream  The stream.
+         *
+         * @return  OK, INVALID_PARAM if the stream has pending requests.
+         */
+        Status Close(HashStream& stream);
+
+        /**
+         * @brief   Queue a chunk of the current message of a stream.
+         *
+         * @param   stream  An opened stream.
+         * @param   request The request descriptor, owned by the caller until completion.
+         *
+         * @return  PENDING if queued, INVALID_PARAM if the descriptor was rejected.
+         */
+        Status Submit(HashStream& stream, HashRequest& request);
+
+        /// @brief True if no request is queued or running.
+        bool IsIdle() const;
+
+        /// @brief Count of finished requests since construction.
+        uint32_t GetCompletedCount() const {return mCompleted;};
+
+    private:
+
+        /// @brief One engine turn.
+        struct Slice
+        {
+            const uint8_t* pData{nullptr};  //!< Bytes to feed
+            uint32_t length{0U};            //!< Count of bytes
+            bool last{false};               //!< Last feed of the hash
+            bool fromCarry{false};          //!< The bytes are the stream carry
+        };
+
+        /// @brief Engine completion, see IHashEngine::IListener.
+        void OnFeedDone(HashStream& stream, Status status) override;
+
+        /// @brief Start turns while the engine is idle.
+        void Dispatch();
+
+        /**
+         * @brief   Determine the next turn of a stream.
+         * @details Chunks which end in the carry are completed without engine turn and returned in pDone.
+         * @return  true if slice holds a feed, false if the stream has no more work.
+         */
+        bool NextSlice(HashStream& stream, Slice& slice, HashRequest*& pDone);
+
+        /// @brief Append a stream to the ready list if it has requests, otherwise unschedule it.
+        void Reschedule(HashStream& stream);
+
+        /// @brief Prepare the stream for the next message (reload the HMAC inner pad).
+        static void ResetMessage(HashStream& stream);
+
+        /// @brief Unlink the first request of a stream.
+        static HashRequest* PopHead(HashStream& stream);
+
+        /// @brief Publish the result of a list of requests and call the user callbacks.
+        void Finish(HashRequest* pList, Status status);
+
+        /// @brief True if the stream has requests or is scheduled.
+        static bool IsBusy(const HashStream& stream);
+
+        /// @brief The executing engine.
+        IHashEngine& mEngine;
+
+        /// @brief First stream waiting for a turn.
+        HashStream* mpReadyHead{nullptr};
+
+        /// @brief Last stream waiting for a turn.
+        HashStream* mpReadyTail{nullptr};
+
+        /// @brief Stream owned by the engine.
+        HashStream* volatile mpActive{nullptr};
+
+        /// @brief The turn owned by the engine.
+        Slice mSlice{};
+
+        /// @brief Set while IHashEngine::Feed runs, turns synchronous completions into a loop.
+        volatile bool mDispatching{false};
+
+        /// @brief Finished requests.
+        volatile uint32_t mCompleted{0U};
+};
+
+} // end namespace Crypto
@@ -0,0 +1,109 @@
+/**
+ ********************************************************************************
+ * @file        HashTypes.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, common types of the hash service.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "CryptoTypes.hpp"
+namespace Crypto {
+
+
+/// @brief Supported hash functions.
+enum class HashAlgorithm : uint8_t
+{
+    SHA256=0,       //!< SHA-256
+    HMAC_SHA256=1   //!< HMAC with SHA-256, the key is bound when the stream is opened
+};
+
+
+/**
+ * @brief   Descriptor of one request on a hash stream (a message chunk, optionally the last one).
+ * @details The descriptor and the data buffer are owned by the caller and must stay valid
+ *          until the completion callback has been called (or @ref status left PENDING).
+ *          The service reads the data in place, only a partial block at a chunk border is copied.
+ * @note    For the DMA backend chunk lengths should be multiples of 64 bytes and the data word aligned
+ *          in a DMA accessible RAM (not DTCM), otherwise the CPU feeds the peripheral.
+ */
+struct HashRequest
+{
+    /// @brief Completion callback, called in the engine completion context (ISR on the target).
+    using Callback = void (*)(HashRequest& request, void* pContext);
+
+    const uint8_t* pData{nullptr};              //!< Message chunk
+    uint32_t length{0U};                        //!< Length of the chunk in bytes
+    bool final{false};                          //!< True for the last chunk of the message
+    uint8_t* pDigest{nullptr};                  //!< Final only: receives the 32 byte digest / MAC
+
+    Callback pCallback{nullptr};                //!< Optional completion callback
+    void* pContext{nullptr};                    //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or running.
+    volatile Status status{Status::OK};
+
+    /// @brief Consumed bytes of the chunk, owned by the service.
+    uint32_t offset{0U};
+
+    /// @brief Intrusive queue link, owned by the service.
+    HashRequest* pNext{nullptr};
+};
+
+
+/**
+ * @brief   One independent hash computation (a message or a sequence of messages with the same HMAC key).
+ * @details The stream holds everything needed to suspend the computation: the engine context
+ *          (SHA-256 chaining state or the saved HASH peripheral registers), a partial block and
+ *          the HMAC key pads. Any number of streams can share one engine, the service swaps the
+ *          contexts. All members are owned by the service after HashService::Open.
+ */
+struct HashStream
+{
+    /// @brief Words of the engine context: HASH_IMR, HASH_STR, HASH_CR and 54 HASH_CSR registers.
+    static constexpr size_t ENGINE_CONTEXT_WORDS{57U};
+
+    /// @brief Progress of the HMAC construction.
+    enum class Phase : uint8_t
+    {
+        INNER=0,        //!< H((K ^ ipad) || message), or the plain SHA-256
+        OUTER_KEY=1,    //!< Outer hash, feeding K ^ opad
+        OUTER_DIGEST=2  //!< Outer hash, feeding the inner digest
+    };
+
+    HashAlgorithm algorithm{HashAlgorithm::SHA256};     //!< Hash function
+
+    /// @brief Saved engine state, layout defined by the engine.
+    std::array<uint32_t, ENGINE_CONTEXT_WORDS> engineContext{};
+
+    /// @brief False until the engine received the first bytes of the current hash.
+    bool engineStarted{false};
+
+    /// @brief Partial block between two requests, also used for the HMAC pads.
+    alignas(4) std::array<uint8_t, 64> carry{};
+
+    /// @brief Valid bytes in @ref carry.
+    uint8_t carryLength{0U};
+
+    /// @brief HMAC construction step.
+    Phase phase{Phase::INNER};
+
+    /// @brief HMAC: K ^ opad, the ipad block is derived from it.
+    std::array<uint8_t, 64> outerPad{};
+
+    /// @brief Digest output of the engine (inner or final).
+    alignas(4) std::array<uint8_t, 32> digest{};
+
+    HashRequest* pHead{nullptr};                //!< First pending request
+    HashRequest* pTail{nullptr};                //!< Last pending request
+    HashStream* pNextReady{nullptr};            //!< Link of the service ready list
+    bool scheduled{false};                      //!< Stream is in the ready list or running
+};
+
+} // end namespace Crypto
@@ -0,0 +1,82 @@
+/**
+ ********************************************************************************
+ * @file        ICryptoEngine.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, interface of an AES engine (hardware or software backend).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "CryptoTypes.hpp"
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides the interface of an AES engine which processes one job at a time.
+ * @details The engine starts a job with @ref Start and reports the completion to its listener.
+ *          A hardware engine reports from the interrupt context, a software engine may report
+ *          synchronously from inside @ref Start.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to start a job only when the previous one has been reported.
+ *
+ */
+class ICryptoEngine
+{
+    public:
+
+        /// @brief Receiver of the job completion.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief Called exactly once per started job.
+                 * @param job       The finished job.
+                 * @param status    Result of the job.
+                 */
+                virtual void OnJobDone(CryptoJob& job, Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~ICryptoEngine() = default;
+
+        /**
+         * @brief Register the completion listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start a job.
+         * @param job   A validated job descriptor.
+         * @return OK if the job was started (completion follows via the listener),
+         *         otherwise the job was not started and the listener is not called.
+         */
+        virtual Status Start(CryptoJob& job) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        ICryptoEngine() = default;
+
+        ICryptoEngine(ICryptoEngine const &) = default;             //!< Copy constructor
+        ICryptoEngine(ICryptoEngine &&) = default;                  //!< Move constructor
+
+        ICryptoEngine& operator=(ICryptoEngine const &) = default;  //!< Copy assignment
+        ICryptoEngine& operator=(ICryptoEngine &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Crypto
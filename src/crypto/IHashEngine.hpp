@@ -0,0 +1,93 @@
+/**
+ ********************************************************************************
+ * @file        IHashEngine.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, interface of a SHA-256 engine (hardware or software backend).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "HashTypes.hpp"
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides the interface of a SHA-256 engine which is shared by many streams.
+ * @details The engine processes one feed at a time. The state of a stream lives in
+ *          HashStream::engineContext, so the engine can switch between streams at every feed border.
+ *          A hardware engine reports from the interrupt context, a software engine may report
+ *          synchronously from inside @ref Feed.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to feed only when the previous feed has been reported.
+ *
+ */
+class IHashEngine
+{
+    public:
+
+        /// @brief Receiver of the feed completion.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief Called exactly once per started feed.
+                 * @param stream    The stream of the feed, HashStream::digest is valid after the last feed.
+                 * @param status    Result of the feed.
+                 */
+                virtual void OnFeedDone(HashStream& stream, Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IHashEngine() = default;
+
+        /**
+         * @brief Register the completion listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Feed message bytes into a stream.
+         * @details A stream with HashStream::engineStarted == false starts a new hash.
+         * @param stream    The stream.
+         * @param pData     Message bytes.
+         * @param len       Length, a multiple of 64 unless last is set.
+         * @param last      Pad the message and write HashStream::digest.
+         * @return OK if the feed was started (completion follows via the listener),
+         *         otherwise the feed was not started and the listener is not called.
+         */
+        virtual Status Feed(HashStream& stream, const uint8_t* pData, uint32_t len, bool last) = 0;
+
+        /**
+         * @brief Forget a stream, e.g. before its memory is reused.
+         * @param stream    The stream.
+         */
+        virtual void Release(HashStream& stream) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IHashEngine() = default;
+
+        IHashEngine(IHashEngine const &) = default;             //!< Copy constructor
+        IHashEngine(IHashEngine &&) = default;                  //!< Move constructor
+
+        IHashEngine& operator=(IHashEngine const &) = default;  //!< Copy assignment
+        IHashEngine& operator=(IHashEngine &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Crypto
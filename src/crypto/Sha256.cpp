@@ -0,0 +1,347 @@
+/**
+ ********************************************************************************
+ * @file        Sha256.cpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, portable SHA-256 implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "Sha256.hpp"
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRYPTO_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Crypto;
+
+namespace {
+
+alignas(16) constexpr std::array<uint32_t, 64> kRoundConstants{
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+    0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+    0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+    0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+    0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+    0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+    0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+inline uint32_t Ror(uint32_t x, unsigned int n)
+{
+    return (x >> n) | (x << (32U - n));
+}
+
+inline uint32_t Load32Be(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24U) | (static_cast<uint32_t>(p[1]) << 16U)
+         | (static_cast<uint32_t>(p[2]) << 8U) | static_cast<uint32_t>(p[3]);
+}
+
+inline void Store32Be(uint8_t* p, uint32_t v)
+{
+    p[0] = static_cast<uint8_t>(v >> 24U);
+    p[1] = static_cast<uint8_t>(v >> 16U);
+    p[2] = static_cast<uint8_t>(v >> 8U);
+    p[3] = static_cast<uint8_t>(v);
+}
+
+void CompressPortable(Sha256::State& state, const uint8_t* pBlocks, size_t blockCount)
+{
+    std::array<uint32_t, 64> w{};
+
+    while (blockCount > 0U)
+    {
+        for (size_t i = 0U; i < 16U; i++)
+        {
+            w[i] = Load32Be(&pBlocks[4U * i]);
+        }
+        for (size_t i = 16U; i < 64U; i++)
+        {
+            const uint32_t s0 = Ror(w[i - 15U], 7U) ^ Ror(w[i - 15U], 18U) ^ (w[i - 15U] >> 3U);
+            const uint32_t s1 = Ror(w[i - 2U], 17U) ^ Ror(w[i - 2U], 19U) ^ (w[i - 2U] >> 10U);
+            w[i] = w[i - 16U] + s0 + w[i - 7U] + s1;
+        }
+
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+
+        for (size_t i = 0U; i < 64U; i++)
+        {
+            const uint32_t s1 = Ror(e, 6U) ^ Ror(e, 11U) ^ Ror(e, 25U);
+            const uint32_t ch = (e & f) ^ (~e & g);
+            const uint32_t t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+            const uint32_t s0 = Ror(a, 2U) ^ Ror(a, 13U) ^ Ror(a, 22U);
+            const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t t2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        pBlocks += Sha256::BLOCK_SIZE;
+        blockCount--;
+    }
+}
+
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+
+bool CpuHasShaNi()
+{
+    __builtin_cpu_init();
+    uint32_t eax = 0U;
+    uint32_t ebx = 0U;
+    uint32_t ecx = 0U;
+    uint32_t edx = 0U;
+    // CPUID leaf 7 / EBX bit 29 is SHA, __builtin_cpu_supports does not know it on older compilers
+    __asm__ volatile ("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (7U), "c" (0U));
+    return ((ebx & (1U << 29U)) != 0U) && (__builtin_cpu_supports("sse4.1") != 0);
+}
+
+/// @brief SHA-256 block function with the SHA extensions, four rounds per message register.
+__attribute__((target("sha,sse4.1")))
+void CompressShaNi(Sha256::State& state, const uint8_t* pBlocks, size_t blockCount)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    const __m128i* k = reinterpret_cast<const __m128i*>(kRoundConstants.data());
+
+    // ABCD/EFGH -> ABEF/CDGH register layout of sha256rnds2
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (blockCount > 0U)
+    {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i msg[4];
+
+        for (size_t g = 0U; g < 16U; g++)
+        {
+            if (g < 4U)
+            {
+                msg[g] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pBlocks[16U * g])), byteSwap);
+            }
+
+            __m128i m = _mm_add_epi32(msg[g % 4U], _mm_load_si128(&k[g]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, m);
+
+            if ((g >= 3U) && (g <= 14U))
+            {
+                const __m128i t = _mm_alignr_epi8(msg[g % 4U], msg[(g + 3U) % 4U], 4);
+                msg[(g + 1U) % 4U] = _mm_sha256msg2_epu32(_mm_add_epi32(msg[(g + 1U) % 4U], t), msg[g % 4U]);
+            }
+
+            m = _mm_shuffle_epi32(m, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, m);
+
+            if ((g >= 1U) && (g <= 12U))
+            {
+                msg[(g + 3U) % 4U] = _mm_sha256msg1_epu32(msg[(g + 3U) % 4U], msg[g % 4U]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+
+        pBlocks += Sha256::BLOCK_SIZE;
+        blockCount--;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+void Sha256::InitState(State& state)
+{
+    state = {0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU, 0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U};
+}
+
+
+bool Sha256::IsAccelerated()
+{
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+    static const bool hasShaNi = CpuHasShaNi();
+    return hasShaNi;
+#else
+    return false;
+#endif
+}
+
+
+void Sha256::Compress(State& state, const uint8_t* pBlocks, size_t blockCount)
+{
+#if defined(CRYPTO_HAS_X86_INTRINSICS)
+    if (IsAccelerated())
+    {
+        CompressShaNi(state, pBlocks, blockCount);
+        return;
+    }
+#endif
+    CompressPortable(state, pBlocks, blockCount);
+}
+
+
+void Sha256::Finalize(State& state, uint64_t prefixLen, const uint8_t* pTail, size_t tailLen, Digest& digest)
+{
+    const size_t fullBlocks = tailLen / BLOCK_SIZE;
+    if (fullBlocks > 0U)
+    {
+        Compress(state, pTail, fullBlocks);
+    }
+
+    const size_t rest = tailLen - (fullBlocks * BLOCK_SIZE);
+    std::array<uint8_t, 2U * BLOCK_SIZE> pad{};
+    if (rest > 0U)
+    {
+        std::memcpy(pad.data(), &pTail[fullBlocks * BLOCK_SIZE], rest);
+    }
+    pad[rest] = 0x80U;
+
+    const size_t padBlocks = ((rest + 1U + 8U) > BLOCK_SIZE) ? 2U : 1U;
+    const uint64_t bitLen = (prefixLen + tailLen) * 8U;
+    Store32Be(&pad[(padBlocks * BLOCK_SIZE) - 8U], static_cast<uint32_t>(bitLen >> 32U));
+    Store32Be(&pad[(padBlocks * BLOCK_SIZE) - 4U], static_cast<uint32_t>(bitLen));
+    Compress(state, pad.data(), padBlocks);
+
+    for (size_t i = 0U; i < state.size(); i++)
+    {
+        Store32Be(&digest[4U * i], state[i]);
+    }
+}
+
+
+Sha256::Digest Sha256::Hash(const uint8_t* pData, size_t len)
+{
+    State state{};
+    InitState(state);
+    Digest digest{};
+    Finalize(state, 0U, pData, len, digest);
+    return digest;
+}
+
+
+Sha256::Digest Sha256::Hmac(const uint8_t* pKey, size_t keyLen, const uint8_t* pData, size_t len)
+{
+    std::array<uint8_t, BLOCK_SIZE> k0{};
+    if (keyLen > BLOCK_SIZE)
+    {
+        const Digest kh = Hash(pKey, keyLen);
+        std::memcpy(k0.data(), kh.data(), kh.size());
+    }
+    else if (keyLen > 0U)
+    {
+        std::memcpy(k0.data(), pKey, keyLen);
+    }
+
+    std::array<uint8_t, BLOCK_SIZE> pad{};
+    for (size_t i = 0U; i < BLOCK_SIZE; i++)
+    {
+        pad[i] = static_cast<uint8_t>(k0[i] ^ 0x36U);
+    }
+    Sha256 inner;
+    inner.Init();
+    inner.Update(pad.data(), pad.size());
+    inner.Update(pData, len);
+    Digest innerDigest{};
+    inner.Final(innerDigest);
+
+    for (size_t i = 0U; i < BLOCK_SIZE; i++)
+    {
+        pad[i] = static_cast<uint8_t>(k0[i] ^ 0x5CU);
+    }
+    Sha256 outer;
+    outer.Init();
+    outer.Update(pad.data(), pad.size());
+    outer.Update(innerDigest.data(), innerDigest.size());
+    Digest mac{};
+    outer.Final(mac);
+    return mac;
+}
+
+
+void Sha256::Init()
+{
+    InitState(mState);
+    mBuffered = 0U;
+    mCompressed = 0U;
+}
+
+
+void Sha256::Update(const uint8_t* pData, size_t len)
+{
+    if (mBuffered > 0U)
+    {
+        const size_t take = ((BLOCK_SIZE - mBuffered) < len) ? (BLOCK_SIZE - mBuffered) : len;
+        std::memcpy(&mBuffer[mBuffered], pData, take);
+        mBuffered += take;
+        pData += take;
+        len -= take;
+        if (mBuffered < BLOCK_SIZE)
+        {
+            return;
+        }
+        Compress(mState, mBuffer.data(), 1U);
+        mCompressed += BLOCK_SIZE;
+        mBuffered = 0U;
+    }
+
+    const size_t blocks = len / BLOCK_SIZE;
+    if (blocks > 0U)
+    {
+        Compress(mState, pData, blocks);
+        mCompressed += blocks * BLOCK_SIZE;
+        pData += blocks * BLOCK_SIZE;
+        len -= blocks * BLOCK_SIZE;
+    }
+
+    if (len > 0U)
+    {
+        std::memcpy(mBuffer.data(), pData, len);
+        mBuffered = len;
+    }
+}
+
+
+void Sha256::Final(Digest& digest)
+{
+    Finalize(mState, mCompressed, mBuffer.data(), mBuffered, digest);
+}
@@ -0,0 +1,132 @@
+/**
+ ********************************************************************************
+ * @file        Sha256.hpp
+ *
+ * @namespace   Crypto
+ *
+ * @brief       Crypto, portable SHA-256 and HMAC-SHA256.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+namespace Crypto {
+
+
+/**
+ * @brief   This class provides SHA-256 (FIPS 180-4) and HMAC-SHA256 (RFC 2104).
+ * @details The block function is the portable C++ implementation, on x86-64 hosts the
+ *          SHA extensions (SHA-NI) are used when the CPU supports them (runtime check).
+ *          The static block level functions are the building blocks of HashEngineSoft,
+ *          the streaming member functions are meant for short data (keys, tests).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class Sha256
+{
+    public:
+
+        /// @brief Block size in bytes.
+        static constexpr size_t BLOCK_SIZE{64U};
+
+        /// @brief Digest size in bytes.
+        static constexpr size_t DIGEST_SIZE{32U};
+
+        /// @brief Chaining state H0..H7.
+        using State = std::array<uint32_t, 8>;
+
+        /// @brief Digest bytes.
+        using Digest = std::array<uint8_t, DIGEST_SIZE>;
+
+        /// @brief Set the initial hash value.
+        static void InitState(State& state);
+
+        /**
+         * @brief   Process complete blocks.
+         *
+         * @param   state       Chaining state.
+         * @param   pBlocks     Input, blockCount * 64 bytes.
+         * @param   blockCount  Count of blocks.
+         */
+        static void Compress(State& state, const uint8_t* pBlocks, size_t blockCount);
+
+        /**
+         * @brief   Process the last bytes of a message, pad and output the digest.
+         *
+         * @param   state       Chaining state after prefixLen bytes.
+         * @param   prefixLen   Bytes already compressed, must be a multiple of 64.
+         * @param   pTail       Remaining message bytes.
+         * @param   tailLen     Count of remaining bytes (any length).
+         * @param   digest      The digest.
+         */
+        static void Finalize(State& state, uint64_t prefixLen, const uint8_t* pTail, size_t tailLen, Digest& digest);
+
+        /// @brief True if the SHA-NI path is used.
+        static bool IsAccelerated();
+
+        /**
+         * @brief   One shot SHA-256.
+         *
+         * @param   pData   Message.
+         * @param   len     Length in bytes.
+         *
+         * @return  The digest.
+         */
+        static Digest Hash(const uint8_t* pData, size_t len);
+
+        /**
+         * @brief   One shot HMAC-SHA256.
+         *
+         * @param   pKey    Key.
+         * @param   keyLen  Key length in bytes, keys longer than 64 bytes are hashed first.
+         * @param   pData   Message.
+         * @param   len     Length in bytes.
+         *
+         * @return  The MAC.
+         */
+        static Digest Hmac(const uint8_t* pKey, size_t keyLen, const uint8_t* pData, size_t len);
+
+        /// @brief Start a new message.
+        void Init();
+
+        /**
+         * @brief   Absorb message bytes.
+         *
+         * @param   pData   Message bytes.
+         * @param   len     Length in bytes.
+         */
+        void Update(const uint8_t* pData, size_t len);
+
+        /**
+         * @brief   Finish the message.
+         *
+         * @param   digest  The digest.
+         */
+        void Final(Digest& digest);
+
+    private:
+
+        /// @brief Chaining state.
+        State mState{};
+
+        /// @brief Partial block.
+        std::array<uint8_t, BLOCK_SIZE> mBuffer{};
+
+        /// @brief Bytes in the partial block.
+        size_t mBuffered{0U};
+
+        /// @brief Bytes compressed so far.
+        uint64_t mCompressed{0U};
+};
+
+} // end namespace Crypto
@@ -0,0 +1,126 @@
+/**
+ ********************************************************************************
+ * @file        DacEngine.cpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, waveform engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DacEngine.hpp"
+#include <algorithm>
+
+using namespace Dac;
+
+DacEngine::DacEngine(IDacPort& port)
+: mPort(port)
+{
+    mPort.SetListener(this);
+}
+
+
+DacEngine::~DacEngine()
+{
+    Stop();
+    mPort.SetListener(nullptr);
+}
+
+
+Status DacEngine::Start(const StreamConfig& config)
+{
+    if (IsRunning())
+    {
+        return Status::BUSY;
+    }
+    if (!config.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (uint8_t channel = 0U; channel < config.channels; channel++)
+    {
+        if (mSynths[channel].Restart(config.sampleRate) != Status::OK)
+        {
+            return Status::INVALID_PARAM;
+        }
+    }
+
+    // the interrupt is idle, the ring holds the first two halves
+    mConfig = config;
+    mClips.store(0U, std::memory_order_relaxed);
+    Fill(0U);
+    Fill(1U);
+    mNextHalf = 0U;
+    mHalves.store(0U, std::memory_order_relaxed);
+    mUnderruns.store(0U, std::memory_order_relaxed);
+    mRunning.store(true, std::memory_order_release);
+
+    const Status status = mPort.Start(config);
+    if (status != Status::OK)
+    {
+        mRunning.store(false, std::memory_order_release);
+    }
+    return status;
+}
+
+
+void DacEngine::Stop()
+{
+    if (IsRunning())
+    {
+        mPort.Stop();
+        mRunning.store(false, std::memory_order_release);
+    }
+}
+
+
+void DacEngine::OnHalf(uint8_t half)
+{
+    if (half != mNextHalf)
+    {
+        // a whole half was missed, the DMA replayed it
+        mUnderruns.fetch_add(1U, std::memory_order_relaxed);
+    }
+    mNextHalf = half ^ 1U;
+    Fill(half);
+    mHalves.fetch_add(1U, std::memory_order_release);
+}
+
+
+void DacEngine::OnError(Status status)
+{
+    (void)status;
+    // the port has stopped
+    mUnderruns.fetch_add(1U, std::memory_order_relaxed);
+    mRunning.store(false, std::memory_order_release);
+}
+
+
+void DacEngine::Fill(uint8_t half)
+{
+    uint32_t* pWords = mConfig.pBuffer + (static_cast<size_t>(half) * mConfig.halfFrames);
+    uint32_t clipped = 0U;
+    for (uint32_t offset = 0U; offset < mConfig.halfFrames; offset += DdsSynth::CHUNK)
+    {
+        const uint32_t frames = std::min(DdsSynth::CHUNK, mConfig.halfFrames - offset);
+        clipped += mSynths[0].Render({mCodes[0].data(), frames});
+        if (mConfig.channels == 1U)
+        {
+            std::copy_n(mCodes[0].begin(), frames, &pWords[offset]);
+            continue;
+        }
+        // DHR12RD: channel 2 in the upper half word
+        clipped += mSynths[1].Render({mCodes[1].data(), frames});
+        for (uint32_t n = 0U; n < frames; n++)
+        {
+            pWords[offset + n] = static_cast<uint32_t>(mCodes[0][n]) | (static_cast<uint32_t>(mCodes[1][n]) << 16U);
+        }
+    }
+    if (clipped != 0U)
+    {
+        mClips.fetch_add(clipped, std::memory_order_relaxed);
+    }
+}
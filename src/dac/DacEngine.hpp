@@ -0,0 +1,120 @@
+/**
+ ********************************************************************************
+ * @file        DacEngine.hpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, waveform engine with DMA double buffering.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DdsSynth.hpp"
+#include "IDacPort.hpp"
+#include <array>
+#include <atomic>
+namespace Dac {
+
+
+/**
+ * @brief   This class provides a continuous waveform stream, one DdsSynth per DAC channel.
+ * @details @ref Start restarts the synthesis at the sample rate and renders both halves of the ring before
+ *          the port starts. When the DMA has read half h the engine renders the next frames into it in the
+ *          interrupt, channel 1 into the lower and channel 2 into the upper half words, so the ring always
+ *          holds one half of look ahead (half frames / sample rate, 1 ms for 2 x 1000 frames at 1 MSPS).\n
+ *          A half which arrives out of turn (the interrupt was late for a whole half, the DMA replayed old
+ *          frames) and an underrun of the port are counted as underrun, clipped samples of the sums are
+ *          counted separately.
+ * @note    Rendering a half must finish within one half time. @ref Start, @ref Stop and the tones of the
+ *          synthesis belong to the control thread while the engine is stopped.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe for one control thread and the port interrupt.
+ *
+ */
+class DacEngine : private IDacPort::IListener
+{
+    public:
+
+        /**
+         * @brief   Constructs the engine on a port.
+         *
+         * @param   port    The DAC port.
+         */
+        explicit DacEngine(IDacPort& port);
+
+        /// @brief Destructor, stops the stream.
+        ~DacEngine();
+
+        DacEngine(DacEngine const &) = delete;             //!< Copy constructor
+        DacEngine& operator=(DacEngine const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Restart the synthesis, fill the ring and start the stream, the counters restart.
+         *
+         * @param   config  The stream, the ring must outlive it.
+         *
+         * @return  OK, BUSY, INVALID_PARAM (also a tone beyond the half of the rate) or the error of the port.
+         */
+        Status Start(const StreamConfig& config);
+
+        /// @brief Stop the stream.
+        void Stop();
+
+        /**
+         * @brief   The synthesis of a channel.
+         *
+         * @param   channel     0 for channel 1, 1 for channel 2.
+         */
+        DdsSynth& GetSynth(uint8_t channel) {return mSynths[channel % MAX_CHANNELS];};
+
+        /// @brief The stream runs.
+        bool IsRunning() const {return mRunning.load(std::memory_order_acquire);};
+
+        /// @brief Halves rendered since the start, without the two of the start.
+        uint32_t GetHalves() const {return mHalves.load(std::memory_order_acquire);};
+
+        /// @brief Late halves and port underruns since the start.
+        uint32_t GetUnderruns() const {return mUnderruns.load(std::memory_order_acquire);};
+
+        /// @brief Clipped samples since the start.
+        uint32_t GetClips() const {return mClips.load(std::memory_order_acquire);};
+
+    private:
+
+        /// @copydoc IDacPort::IListener::OnHalf
+        void OnHalf(uint8_t half) override;
+
+        /// @copydoc IDacPort::IListener::OnError
+        void OnError(Status status) override;
+
+        /// @brief Render the next frames into a half of the ring.
+        void Fill(uint8_t half);
+
+        /// @brief The DAC port.
+        IDacPort& mPort;
+
+        /// @brief The running configuration.
+        StreamConfig mConfig{0U, 0U, 0U, nullptr};
+
+        /// @brief The synthesis of the channels.
+        std::array<DdsSynth, MAX_CHANNELS> mSynths{};
+
+        /// @brief Codes of a chunk per channel.
+        alignas(32) std::array<std::array<uint16_t, DdsSynth::CHUNK>, MAX_CHANNELS> mCodes{};
+
+        /// @brief The next expected half.
+        uint8_t mNextHalf{0U};
+
+        std::atomic<bool> mRunning{false};      //!< The stream runs
+        std::atomic<uint32_t> mHalves{0U};      //!< Rendered halves, written by the interrupt
+        std::atomic<uint32_t> mUnderruns{0U};   //!< Underruns, written by the interrupt
+        std::atomic<uint32_t> mClips{0U};       //!< Clipped samples, written by the interrupt
+};
+
+} // end namespace Dac
@@ -0,0 +1,239 @@
+/**
+ ********************************************************************************
+ * @file        DacPortHal.cpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, DAC port implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DacPortHal.hpp"
+#include "DCache.hpp"
+
+using namespace Dac;
+
+DacPortHal* DacPortHal::spInstance = nullptr;
+
+namespace {
+
+/// @brief Counts of the 16 bit prescaler and auto reload registers.
+constexpr uint32_t TIMER_RANGE{65536U};
+
+} // end anonymous namespace
+
+
+DacPortHal::DacPortHal(DAC_HandleTypeDef& hdac, TIM_HandleTypeDef& trigger, uint32_t triggerSource,
+                       uint32_t timerClock)
+: mHdac(hdac), mTrigger(trigger), mTriggerSource(triggerSource), mTimerClock(timerClock)
+{
+    spInstance = this;
+}
+
+
+DacPortHal::~DacPortHal()
+{
+    Stop();
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+DacPortHal* DacPortHal::GetInstance(const DAC_HandleTypeDef* hdac)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHdac == hdac))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status DacPortHal::Start(const StreamConfig& config)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if (!config.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+    const Status status = SetRate(config.sampleRate);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    HAL_StatusTypeDef result = ConfigChannel(DAC_CHANNEL_1);
+    if ((result == HAL_OK) && (config.channels == 2U))
+    {
+        result = ConfigChannel(DAC_CHANNEL_2);
+    }
+    if (result != HAL_OK)
+    {
+        return ToStatus(result);
+    }
+
+    // the first two halves go out
+    Utils::DCache::Clean(config.pBuffer, config.RingWords() * sizeof(uint32_t));
+    mConfig = config;
+    mRunning = true;
+    if (config.channels == 2U)
+    {
+        result = HAL_DACEx_DualStart_DMA(&mHdac, DAC_CHANNEL_1, config.pBuffer, config.RingWords(), DAC_ALIGN_12B_R);
+    }
+    else
+    {
+        result = HAL_DAC_Start_DMA(&mHdac, DAC_CHANNEL_1, config.pBuffer, config.RingWords(), DAC_ALIGN_12B_R);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_TIM_Base_Start(&mTrigger);
+    }
+    if (result != HAL_OK)
+    {
+        Stop();
+    }
+    return ToStatus(result);
+}
+
+
+void DacPortHal::Stop()
+{
+    (void)HAL_TIM_Base_Stop(&mTrigger);
+    if (mRunning)
+    {
+        if (mConfig.channels == 2U)
+        {
+            (void)HAL_DACEx_DualStop_DMA(&mHdac, DAC_CHANNEL_1);
+        }
+        else
+        {
+            (void)HAL_DAC_Stop_DMA(&mHdac, DAC_CHANNEL_1);
+        }
+        mRunning = false;
+    }
+}
+
+
+void DacPortHal::OnHalf(uint8_t half)
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    if (mpListener != nullptr)
+    {
+        mpListener->OnHalf(half);
+    }
+    // the DMA reaches this half after the other one
+    const uint32_t offset = half * static_cast<uint32_t>(mConfig.halfFrames);
+    Utils::DCache::Clean(&mConfig.pBuffer[offset], mConfig.halfFrames * sizeof(uint32_t));
+}
+
+
+void DacPortHal::OnError(Status status)
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    // the DMA request of the channel is disabled
+    Stop();
+    if (mpListener != nullptr)
+    {
+        mpListener->OnError(status);
+    }
+}
+
+
+Status DacPortHal::SetRate(uint32_t sampleRate)
+{
+    if ((sampleRate == 0U) || ((mTimerClock % sampleRate) != 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const uint32_t ticks = mTimerClock / sampleRate;
+    const uint32_t prescaler = ((ticks - 1U) / TIMER_RANGE) + 1U;
+    if ((ticks < 2U) || ((ticks % prescaler) != 0U) || (prescaler > TIMER_RANGE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    __HAL_TIM_SET_PRESCALER(&mTrigger, prescaler - 1U);
+    __HAL_TIM_SET_AUTORELOAD(&mTrigger, (ticks / prescaler) - 1U);
+    // load the prescaler now, not at the next update
+    mTrigger.Instance->EGR = TIM_EGR_UG;
+    return Status::OK;
+}
+
+
+HAL_StatusTypeDef DacPortHal::ConfigChannel(uint32_t channel)
+{
+    DAC_ChannelConfTypeDef config{};
+    config.DAC_SampleAndHold = DAC_SAMPLEANDHOLD_DISABLE;
+    config.DAC_Trigger = mTriggerSource;
+    config.DAC_OutputBuffer = DAC_OUTPUTBUFFER_ENABLE;
+    config.DAC_ConnectOnChipPeripheral = DAC_CHIPCONNECT_EXTERNAL;
+    config.DAC_UserTrimming = DAC_TRIMMING_FACTORY;
+    return HAL_DAC_ConfigChannel(&mHdac, &config, channel);
+}
+
+
+Status DacPortHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef* hdac)
+{
+    DacPortHal* pPort = DacPortHal::GetInstance(hdac);
+    if (pPort != nullptr)
+    {
+        pPort->OnHalf(0U);
+    }
+}
+
+
+extern "C" void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef* hdac)
+{
+    DacPortHal* pPort = DacPortHal::GetInstance(hdac);
+    if (pPort != nullptr)
+    {
+        pPort->OnHalf(1U);
+    }
+}
+
+
+extern "C" void HAL_DAC_DMAUnderrunCallbackCh1(DAC_HandleTypeDef* hdac)
+{
+    DacPortHal* pPort = DacPortHal::GetInstance(hdac);
+    if (pPort != nullptr)
+    {
+        pPort->OnError(Status::UNDERRUN);
+    }
+}
+
+
+extern "C" void HAL_DAC_ErrorCallbackCh1(DAC_HandleTypeDef* hdac)
+{
+    DacPortHal* pPort = DacPortHal::GetInstance(hdac);
+    if (pPort != nullptr)
+    {
+        pPort->OnError(Status::HW_ERROR);
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ ********************************************************************************
+ * @file        DacPortHal.hpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, timer triggered DAC port on the DAC1.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IDacPort.hpp"
+#include "stm32h7xx_hal.h"
+namespace Dac {
+
+
+/**
+ * @brief   This class provides the IDacPort on the DAC1 of the STM32H7 with a timer as trigger.
+ * @details @ref Start sets the trigger timer to the sample rate, configures the used channels for the
+ *          trigger (HAL_DAC_ConfigChannel, output buffer on, factory trimming), cleans the D-Cache lines of the
+ *          ring and starts the DMA of channel 1: HAL_DAC_Start_DMA into DHR12R1 for one channel,
+ *          HAL_DACEx_DualStart_DMA into DHR12RD for both, so one word feeds both channels at the same
+ *          trigger. The timer starts last.\n
+ *          The half and full transfer callbacks of channel 1 report the half and clean the lines the listener
+ *          has just written. A DMA underrun (the DMA missed a trigger, HAL_DAC_DMAUnderrunCallbackCh1) stops
+ *          the stream and is reported as UNDERRUN, a transfer error as HW_ERROR.
+ * @note    The application initialises the DAC handle (HAL_DAC_Init), the timer (TRGO on update) and the
+ *          circular DMA of channel 1 with word transfers on both sides (HAL_DAC_MspInit), and calls
+ *          HAL_DAC_IRQHandler and the DMA handler. The timer clock must be a multiple of the sample rate,
+ *          the buffered output settles up to about 1 MSPS. The ring must be located in a DMA accessible RAM
+ *          (not DTCM) and 32 byte aligned. One instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one DacEngine.
+ *
+ */
+class DacPortHal : public IDacPort
+{
+    public:
+
+        /**
+         * @brief   Constructs the port for initialised handles.
+         *
+         * @param   hdac            Handle of the DAC1.
+         * @param   trigger         Handle of the trigger timer.
+         * @param   triggerSource   DAC_TRIGGER_x of the timer, e.g. DAC_TRIGGER_T6_TRGO.
+         * @param   timerClock      Kernel clock of the timer in Hz.
+         */
+        DacPortHal(DAC_HandleTypeDef& hdac, TIM_HandleTypeDef& trigger, uint32_t triggerSource, uint32_t timerClock);
+
+        /// @brief Destructor.
+        ~DacPortHal() override;
+
+        DacPortHal(DacPortHal const &) = delete;             //!< Copy constructor
+        DacPortHal& operator=(DacPortHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc IDacPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IDacPort::Start
+        Status Start(const StreamConfig& config) override;
+
+        /// @copydoc IDacPort::Stop
+        void Stop() override;
+
+        /**
+         * @brief   A half of the ring is read, called by the transfer callbacks of channel 1.
+         *
+         * @param   half    0 for the first, 1 for the second half.
+         */
+        void OnHalf(uint8_t half);
+
+        /**
+         * @brief   The stream failed, called by the underrun and error callbacks of channel 1.
+         *
+         * @param   status  UNDERRUN or HW_ERROR.
+         */
+        void OnError(Status status);
+
+        /// @brief Port which uses a DAC handle or nullptr.
+        static DacPortHal* GetInstance(const DAC_HandleTypeDef* hdac);
+
+    private:
+
+        /// @brief Set the trigger timer to the sample rate.
+        Status SetRate(uint32_t sampleRate);
+
+        /// @brief Configure a channel for the trigger.
+        HAL_StatusTypeDef ConfigChannel(uint32_t channel);
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        DAC_HandleTypeDef& mHdac;           //!< The DAC
+        TIM_HandleTypeDef& mTrigger;        //!< Trigger timer
+        uint32_t mTriggerSource;            //!< DAC_TRIGGER_x of the timer
+        uint32_t mTimerClock;               //!< Kernel clock of the timer
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        StreamConfig mConfig{0U, 0U, 0U, nullptr};  //!< The running stream
+        volatile bool mRunning{false};              //!< The stream runs
+
+        /// @brief The single port instance.
+        static DacPortHal* spInstance;
+};
+
+} // end namespace Dac
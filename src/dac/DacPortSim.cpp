@@ -0,0 +1,166 @@
+/**
+ ********************************************************************************
+ * @file        DacPortSim.cpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, simulated DAC port implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DacPortSim.hpp"
+#include <cstdio>
+
+using namespace Dac;
+
+namespace {
+
+/// @brief Append a little endian 16 bit value.
+void Put16(std::vector<uint8_t>& out, uint32_t value)
+{
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8U));
+}
+
+/// @brief Append a little endian 32 bit value.
+void Put32(std::vector<uint8_t>& out, uint32_t value)
+{
+    Put16(out, value & 0xFFFFU);
+    Put16(out, value >> 16U);
+}
+
+/// @brief Append a tag.
+void PutTag(std::vector<uint8_t>& out, const char* pTag)
+{
+    out.insert(out.end(), pTag, pTag + 4);
+}
+
+/// @brief The 12 bit code as 16 bit PCM.
+uint32_t ToPcm(uint32_t code)
+{
+    return static_cast<uint32_t>(static_cast<int32_t>(code & 0xFFFU) - static_cast<int32_t>(MID_CODE)) << 4U;
+}
+
+} // end anonymous namespace
+
+
+uint32_t DacPortSim::Tick(uint32_t halves)
+{
+    uint32_t ticked = 0U;
+    while (mRunning && (ticked < halves))
+    {
+        const uint32_t* pHalf = mConfig.pBuffer + (static_cast<size_t>(mHalf) * mConfig.halfFrames);
+        if (mRecording)
+        {
+            mOutput.insert(mOutput.end(), pHalf, pHalf + mConfig.halfFrames);
+        }
+        const uint8_t half = mHalf;
+        mHalf ^= 1U;
+        ticked++;
+        if (mLate)
+        {
+            mLate = false;
+        }
+        else if (mpListener != nullptr)
+        {
+            mpListener->OnHalf(half);
+        }
+    }
+    return ticked;
+}
+
+
+Status DacPortSim::Start(const StreamConfig& config)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if (!config.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+    mConfig = config;
+    mOutput.clear();
+    mHalf = 0U;
+    mLate = false;
+    mRunning = true;
+    return Status::OK;
+}
+
+
+std::vector<uint16_t> DacPortSim::GetCodes(uint8_t channel) const
+{
+    std::vector<uint16_t> codes;
+    codes.reserve(mOutput.size());
+    const uint32_t shift = (channel == 0U) ? 0U : 16U;
+    for (const uint32_t word : mOutput)
+    {
+        codes.push_back(static_cast<uint16_t>((word >> shift) & 0xFFFU));
+    }
+    return codes;
+}
+
+
+void DacPortSim::EncodeWav(std::span<const uint32_t> words, uint8_t channels, uint32_t sampleRate,
+                           std::vector<uint8_t>& wav)
+{
+    const auto dataBytes = static_cast<uint32_t>(words.size() * channels * 2U);
+    wav.clear();
+    wav.reserve(44U + dataBytes);
+    PutTag(wav, "RIFF");
+    Put32(wav, 36U + dataBytes);
+    PutTag(wav, "WAVE");
+
+    // PCM, 16 bit
+    PutTag(wav, "fmt ");
+    Put32(wav, 16U);
+    Put16(wav, 1U);
+    Put16(wav, channels);
+    Put32(wav, sampleRate);
+    Put32(wav, sampleRate * channels * 2U);
+    Put16(wav, channels * 2U);
+    Put16(wav, 16U);
+
+    PutTag(wav, "data");
+    Put32(wav, dataBytes);
+    for (const uint32_t word : words)
+    {
+        Put16(wav, ToPcm(word) & 0xFFFFU);
+        if (channels == 2U)
+        {
+            Put16(wav, ToPcm(word >> 16U) & 0xFFFFU);
+        }
+    }
+}
+
+
+Status DacPortSim::DumpWav(const char* pPath) const
+{
+    std::vector<uint8_t> wav;
+    EncodeWav(mOutput, mConfig.channels, mConfig.sampleRate, wav);
+    std::FILE* pFile = std::fopen(pPath, "wb");
+    if (pFile == nullptr)
+    {
+        return Status::HW_ERROR;
+    }
+    const size_t written = std::fwrite(wav.data(), 1U, wav.size(), pFile);
+    const bool closed = (std::fclose(pFile) == 0);
+    return ((written == wav.size()) && closed) ? Status::OK : Status::HW_ERROR;
+}
+
+
+void DacPortSim::Fail(Status status)
+{
+    if (mRunning)
+    {
+        mRunning = false;
+        if (mpListener != nullptr)
+        {
+            mpListener->OnError(status);
+        }
+    }
+}
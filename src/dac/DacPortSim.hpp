@@ -0,0 +1,131 @@
+/**
+ ********************************************************************************
+ * @file        DacPortSim.hpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, simulated DAC port with a WAV recording.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IDacPort.hpp"
+#include <span>
+#include <vector>
+namespace Dac {
+
+
+/**
+ * @brief   This class provides the IDacPort on the host as a recording device.
+ * @details The trigger side (@ref Tick) runs half by half like the DMA: the words of half h are converted
+ *          (appended to the output), then the half is reported. The listener is called synchronously like
+ *          the interrupt.\n
+ *          @ref InjectLateHalf drops the report of the next half (the DMA continues), @ref InjectUnderrun and
+ *          @ref InjectFault model the error interrupts, both stop the stream. The recording can be written
+ *          as WAV (16 bit PCM, one channel per DAC channel, the 12 bit codes around the mid scale shifted
+ *          left by 4) for a check with any audio or analysis tool.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * @ref Tick may run in another thread (the simulated interrupt context) while no Start or Stop is called.
+ *
+ */
+class DacPortSim : public IDacPort
+{
+    public:
+
+        /// @brief Constructor.
+        DacPortSim() = default;
+
+        DacPortSim(DacPortSim const &) = delete;             //!< Copy constructor
+        DacPortSim& operator=(DacPortSim const &) = delete;  //!< Copy assignment
+
+        /// @brief Record the converted words into the output.
+        void SetRecording(bool record) {mRecording = record;};
+
+        /**
+         * @brief   Trigger side: convert halves.
+         *
+         * @param   halves  Count of halves.
+         *
+         * @return  Count of halves converted, 0 if stopped.
+         */
+        uint32_t Tick(uint32_t halves);
+
+        /// @brief The report of the next half is lost.
+        void InjectLateHalf() {mLate = true;};
+
+        /// @brief Report a DMA underrun, the stream stops.
+        void InjectUnderrun() {Fail(Status::UNDERRUN);};
+
+        /// @brief Report a DMA error, the stream stops.
+        void InjectFault() {Fail(Status::HW_ERROR);};
+
+        /// @copydoc IDacPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IDacPort::Start
+        Status Start(const StreamConfig& config) override;
+
+        /// @copydoc IDacPort::Stop
+        void Stop() override {mRunning = false;};
+
+        /// @brief The stream runs.
+        bool IsRunning() const {return mRunning;};
+
+        /// @brief The converted words while recording.
+        const std::vector<uint32_t>& GetOutput() const {return mOutput;};
+
+        /// @brief Drop the recording.
+        void ClearOutput() {mOutput.clear();};
+
+        /**
+         * @brief   The codes of a channel in the recording.
+         *
+         * @param   channel     0 for channel 1, 1 for channel 2.
+         */
+        std::vector<uint16_t> GetCodes(uint8_t channel) const;
+
+        /**
+         * @brief   Encode DAC words as WAV.
+         *
+         * @param   words       The words, channel 1 in the lower and channel 2 in the upper half word.
+         * @param   channels    1 or 2.
+         * @param   sampleRate  Frames per second.
+         * @param   wav         Returns the WAV file.
+         */
+        static void EncodeWav(std::span<const uint32_t> words, uint8_t channels, uint32_t sampleRate,
+                              std::vector<uint8_t>& wav);
+
+        /**
+         * @brief   Write the recording of the last stream to a WAV file.
+         *
+         * @param   pPath   The file.
+         *
+         * @return  OK, HW_ERROR if the file can't be written.
+         */
+        Status DumpWav(const char* pPath) const;
+
+    private:
+
+        /// @brief Stop the stream and report an error.
+        void Fail(Status status);
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        StreamConfig mConfig{0U, 0U, 0U, nullptr};  //!< The running stream
+        std::vector<uint32_t> mOutput{};            //!< Converted words
+        bool mRecording{true};                      //!< Record the output
+        uint8_t mHalf{0U};                          //!< Next half
+        bool mLate{false};                          //!< Drop the next report
+        bool mRunning{false};                       //!< The stream runs
+};
+
+} // end namespace Dac
@@ -0,0 +1,66 @@
+/**
+ ********************************************************************************
+ * @file        DacTypes.hpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, types of the waveform synthesis.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+namespace Dac {
+
+
+/// @brief Result of a waveform operation or event.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The stream runs
+    INVALID_PARAM=2,  //!< Parameter or configuration is inconsistent
+    HW_ERROR=3,       //!< The peripheral or its DMA failed, the stream stopped
+    UNDERRUN=4        //!< The DMA missed a trigger of the DAC, the stream stopped
+};
+
+/// @brief Channels of the DAC.
+constexpr uint8_t MAX_CHANNELS{2U};
+
+/// @brief Largest code of the 12 bit data register.
+constexpr uint16_t MAX_CODE{4095U};
+
+/// @brief Code of the mid scale, the zero of the waveforms.
+constexpr uint16_t MID_CODE{2048U};
+
+/// @brief Maximum words of the DMA ring, the limit of the DMA counter.
+constexpr uint32_t MAX_RING_WORDS{65535U};
+
+/**
+ * @brief Configuration of a waveform stream.
+ * @details The ring holds two halves (ping-pong) of one 32 bit word per frame: the code of channel 1 in
+ *          bits 0 .. 11, the code of channel 2 in bits 16 .. 27 (the layout of DHR12RD). A single channel
+ *          stream leaves the upper half word zero.
+ */
+struct StreamConfig
+{
+    uint32_t sampleRate;    //!< Conversions per second and channel
+    uint8_t channels;       //!< 1 or 2 (dual mode)
+    uint16_t halfFrames;    //!< Frames per half, a multiple of 8
+    uint32_t* pBuffer;      //!< The ring of 2 * halfFrames words, 32 byte aligned, in a DMA accessible RAM
+
+    /// @brief The words of the ring.
+    uint32_t RingWords() const {return 2U * static_cast<uint32_t>(halfFrames);};
+
+    /// @brief Parameters in range.
+    bool IsValid() const
+    {
+        return (sampleRate > 0U) && (channels >= 1U) && (channels <= MAX_CHANNELS) && (halfFrames > 0U)
+            && ((halfFrames % 8U) == 0U) && (RingWords() <= MAX_RING_WORDS) && (pBuffer != nullptr);
+    }
+};
+
+} // end namespace Dac
@@ -0,0 +1,310 @@
+/**
+ ********************************************************************************
+ * @file        DdsSynth.cpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, direct digital synthesis implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DdsSynth.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace Dac;
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+/// @brief Full scale of the tables and the mix.
+constexpr double FULL_SCALE{32767.0};
+
+/// @brief 2^64, the phase cycle of an increment in 32.32.
+constexpr double CYCLE{18446744073709551616.0};
+
+/// @brief Longest sweep in samples.
+constexpr double MAX_SWEEP{4294967295.0};
+
+/// @brief Shift of the table index from the phase.
+constexpr uint32_t INDEX_SHIFT{32U - DdsSynth::TABLE_BITS};
+
+/// @brief Shift of the 15 bit interpolation weight from the phase.
+constexpr uint32_t WEIGHT_SHIFT{INDEX_SHIFT - 15U};
+
+/// @brief Sine of |x| <= pi / 2, Taylor polynomial of degree 23.
+constexpr double Sine(double x)
+{
+    double term = x;
+    double sum = x;
+    for (int32_t n = 1; n <= 11; n++)
+    {
+        term *= -(x * x) / static_cast<double>((2 * n) * ((2 * n) + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/// @brief The sine cycle with the guard sample.
+constexpr std::array<int16_t, DdsSynth::TABLE_SIZE + 1U> MakeSine()
+{
+    std::array<int16_t, DdsSynth::TABLE_SIZE + 1U> table{};
+    constexpr uint32_t QUARTER{DdsSynth::TABLE_SIZE / 4U};
+    for (uint32_t i = 0U; i <= DdsSynth::TABLE_SIZE; i++)
+    {
+        // fold the angle into +-pi/2
+        const double angle = 2.0 * PI * static_cast<double>(i) / DdsSynth::TABLE_SIZE;
+        double x = angle;
+        if ((i > QUARTER) && (i < (3U * QUARTER)))
+        {
+            x = PI - angle;
+        }
+        else if (i >= (3U * QUARTER))
+        {
+            x = angle - (2.0 * PI);
+        }
+        const double value = Sine(x) * FULL_SCALE;
+        table[i] = static_cast<int16_t>((value >= 0.0) ? (value + 0.5) : (value - 0.5));
+    }
+    return table;
+}
+
+constexpr std::array<int16_t, DdsSynth::TABLE_SIZE + 1U> SINE{MakeSine()};
+
+} // end anonymous namespace
+
+
+Status DdsSynth::SetTone(uint8_t index, const Tone& tone)
+{
+    if ((index >= MAX_TONES) || !IsValidFrequency(tone.frequency) || !(tone.amplitude >= 0.0F)
+        || (tone.amplitude > 1.0F) || !(tone.phase >= 0.0F) || (tone.phase >= 1.0F)
+        || (!tone.table.empty() && (tone.table.size() != (TABLE_SIZE + 1U))))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mSettings[index].tone = tone;
+    mSettings[index].enabled = true;
+    mSettings[index].sweeping = false;
+    Load(index);
+    return Status::OK;
+}
+
+
+Status DdsSynth::SetSweep(uint8_t index, const Sweep& sweep)
+{
+    if ((index >= MAX_TONES) || !mSettings[index].enabled || !IsValidFrequency(sweep.stopFrequency)
+        || !((sweep.seconds * static_cast<double>(mSampleRate)) >= 1.0)
+        || ((sweep.seconds * static_cast<double>(mSampleRate)) > MAX_SWEEP) || (sweep.mode > SweepMode::BOUNCE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mSettings[index].sweep = sweep;
+    mSettings[index].sweeping = true;
+
+    // from the running phase at the frequency of the tone
+    Voice& voice = mVoices[index];
+    const uint32_t phase = voice.phase;
+    Load(index);
+    voice.phase = phase;
+    return Status::OK;
+}
+
+
+Status DdsSynth::DisableTone(uint8_t index)
+{
+    if (index >= MAX_TONES)
+    {
+        return Status::INVALID_PARAM;
+    }
+    mSettings[index].enabled = false;
+    mSettings[index].sweeping = false;
+    return Status::OK;
+}
+
+
+Status DdsSynth::Restart(uint32_t sampleRate)
+{
+    if (sampleRate == 0U)
+    {
+        return Status::INVALID_PARAM;
+    }
+    mSampleRate = sampleRate;
+    Status status = Status::OK;
+    for (uint8_t i = 0U; i < MAX_TONES; i++)
+    {
+        Setting& setting = mSettings[i];
+        if (!setting.enabled)
+        {
+            continue;
+        }
+        const double length = setting.sweep.seconds * static_cast<double>(sampleRate);
+        if (!IsValidFrequency(setting.tone.frequency)
+            || (setting.sweeping && (!IsValidFrequency(setting.sweep.stopFrequency) || (length < 1.0)
+                                     || (length > MAX_SWEEP))))
+        {
+            setting.enabled = false;
+            status = Status::INVALID_PARAM;
+            continue;
+        }
+        Load(i);
+    }
+    return status;
+}
+
+
+uint32_t DdsSynth::Render(std::span<uint16_t> codes)
+{
+    uint32_t clipped = 0U;
+    for (size_t offset = 0U; offset < codes.size(); offset += CHUNK)
+    {
+        const auto frames = static_cast<uint32_t>(std::min<size_t>(CHUNK, codes.size() - offset));
+        std::fill_n(mMix.begin(), frames, 0);
+        for (uint8_t i = 0U; i < MAX_TONES; i++)
+        {
+            if (!mSettings[i].enabled)
+            {
+                continue;
+            }
+            Voice& voice = mVoices[i];
+            uint32_t done = 0U;
+            while (voice.sweeping && (done < frames))
+            {
+                const uint32_t count = std::min(frames - done, voice.remaining);
+                MixSweep(voice, &mMix[done], count);
+                voice.remaining -= count;
+                done += count;
+                if (voice.remaining == 0U)
+                {
+                    Turn(voice, mSettings[i].sweep.mode);
+                }
+            }
+            MixTone(voice, &mMix[done], frames - done);
+        }
+
+        // q15 to 12 bit around the mid scale
+        uint16_t* pCodes = &codes[offset];
+        for (uint32_t n = 0U; n < frames; n++)
+        {
+            const int32_t code = static_cast<int32_t>(MID_CODE) + (((mMix[n] * 2047) + 16384) >> 15);
+            if ((code < 0) || (code > static_cast<int32_t>(MAX_CODE)))
+            {
+                clipped++;
+            }
+            pCodes[n] = static_cast<uint16_t>(std::clamp(code, 0, static_cast<int32_t>(MAX_CODE)));
+        }
+    }
+    return clipped;
+}
+
+
+uint8_t DdsSynth::GetActiveTones() const
+{
+    return static_cast<uint8_t>(std::count_if(mSettings.begin(), mSettings.end(),
+                                              [](const Setting& setting) {return setting.enabled;}));
+}
+
+
+bool DdsSynth::IsValidFrequency(float frequency) const
+{
+    return (frequency >= 0.0F) && ((2.0 * frequency) <= static_cast<double>(mSampleRate));
+}
+
+
+void DdsSynth::Load(uint8_t index)
+{
+    const Setting& setting = mSettings[index];
+    Voice& voice = mVoices[index];
+    voice.pTable = setting.tone.table.empty() ? SINE.data() : setting.tone.table.data();
+    voice.phase = static_cast<uint32_t>(std::llround(static_cast<double>(setting.tone.phase) * 4294967296.0));
+    voice.gain = static_cast<int32_t>(std::lround(static_cast<double>(setting.tone.amplitude) * FULL_SCALE));
+    voice.startStep = ToStep(setting.tone.frequency);
+    voice.sweepStep = voice.startStep;
+    voice.step = static_cast<uint32_t>((voice.startStep + 0x80000000U) >> 32U);
+    voice.sweeping = setting.sweeping;
+    voice.rising = true;
+    if (setting.sweeping)
+    {
+        voice.stopStep = ToStep(setting.sweep.stopFrequency);
+        voice.length = static_cast<uint32_t>(std::llround(setting.sweep.seconds * static_cast<double>(mSampleRate)));
+        voice.length = std::max(voice.length, 1U);
+        voice.remaining = voice.length;
+        voice.slope = static_cast<int64_t>((static_cast<double>(voice.stopStep) - static_cast<double>(voice.startStep))
+                                           / static_cast<double>(voice.length));
+    }
+}
+
+
+uint64_t DdsSynth::ToStep(float frequency) const
+{
+    // below 2^63 up to the Nyquist limit
+    return static_cast<uint64_t>(static_cast<double>(frequency) / static_cast<double>(mSampleRate) * CYCLE);
+}
+
+
+void DdsSynth::MixTone(Voice& voice, int32_t* pMix, uint32_t frames)
+{
+    const int16_t* pTable = voice.pTable;
+    const uint32_t step = voice.step;
+    const int32_t gain = voice.gain;
+    uint32_t phase = voice.phase;
+    for (uint32_t n = 0U; n < frames; n++)
+    {
+        const uint32_t index = phase >> INDEX_SHIFT;
+        const auto weight = static_cast<int32_t>((phase >> WEIGHT_SHIFT) & 0x7FFFU);
+        const int32_t a = pTable[index];
+        const int32_t sample = a + (((pTable[index + 1U] - a) * weight) >> 15);
+        pMix[n] += (sample * gain) >> 15;
+        phase += step;
+    }
+    voice.phase = phase;
+}
+
+
+void DdsSynth::MixSweep(Voice& voice, int32_t* pMix, uint32_t frames)
+{
+    const int16_t* pTable = voice.pTable;
+    const int32_t gain = voice.gain;
+    const auto slope = static_cast<uint64_t>(voice.slope);
+    uint64_t step = voice.sweepStep;
+    uint32_t phase = voice.phase;
+    for (uint32_t n = 0U; n < frames; n++)
+    {
+        const uint32_t index = phase >> INDEX_SHIFT;
+        const auto weight = static_cast<int32_t>((phase >> WEIGHT_SHIFT) & 0x7FFFU);
+        const int32_t a = pTable[index];
+        const int32_t sample = a + (((pTable[index + 1U] - a) * weight) >> 15);
+        pMix[n] += (sample * gain) >> 15;
+        phase += static_cast<uint32_t>(step >> 32U);
+        // two's complement, the slope may be negative
+        step += slope;
+    }
+    voice.phase = phase;
+    voice.sweepStep = step;
+}
+
+
+void DdsSynth::Turn(Voice& voice, SweepMode mode)
+{
+    switch (mode)
+    {
+        case SweepMode::ONCE:
+            voice.sweeping = false;
+            voice.sweepStep = voice.stopStep;
+            voice.step = static_cast<uint32_t>((voice.stopStep + 0x80000000U) >> 32U);
+            break;
+        case SweepMode::REPEAT:
+            voice.sweepStep = voice.startStep;
+            voice.remaining = voice.length;
+            break;
+        default:
+            voice.rising = !voice.rising;
+            voice.sweepStep = voice.rising ? voice.startStep : voice.stopStep;
+            voice.slope = -voice.slope;
+            voice.remaining = voice.length;
+            break;
+    }
+}
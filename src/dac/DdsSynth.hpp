@@ -0,0 +1,207 @@
+/**
+ ********************************************************************************
+ * @file        DdsSynth.hpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, table driven direct digital synthesis of tones and sweeps.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DacTypes.hpp"
+#include <array>
+#include <span>
+namespace Dac {
+
+
+/// @brief Course of a frequency sweep.
+enum class SweepMode : uint8_t
+{
+    ONCE=0,     //!< Up to the stop frequency and stay there
+    REPEAT=1,   //!< Jump back to the start frequency (saw tooth)
+    BOUNCE=2    //!< Back down to the start frequency and up again (triangle)
+};
+
+/**
+ * @brief A tone of the synthesis.
+ * @details An arbitrary waveform is a table of one cycle with @ref DdsSynth::TABLE_SIZE samples plus a guard
+ *          sample equal to the first one, full scale +-32767. It's used in place, it must outlive the tone.
+ */
+struct Tone
+{
+    float frequency;                    //!< Frequency in Hz, up to half of the sample rate
+    float amplitude;                    //!< Amplitude 0 .. 1 of the full scale
+    float phase;                        //!< Start phase 0 .. 1 in cycles
+    std::span<const int16_t> table;     //!< Arbitrary waveform, empty for the built in sine
+};
+
+/// @brief A linear frequency sweep of a tone, it starts at the frequency of the tone.
+struct Sweep
+{
+    float stopFrequency;    //!< Frequency at the end in Hz, up to half of the sample rate
+    float seconds;          //!< Duration of a sweep, at least one sample
+    SweepMode mode;         //!< Course at the end
+};
+
+/**
+ * @brief   This class provides a direct digital synthesis of up to @ref MAX_TONES simultaneous tones.
+ * @details Every tone has a 32 bit phase accumulator which advances by frequency / rate * 2^32 per sample.
+ *          The upper @ref TABLE_BITS bits address the table (the built in sine or an arbitrary waveform),
+ *          the next 15 bits interpolate linearly to the following sample. The sine error of the
+ *          interpolation is below -100 dBFS, far below the quantisation of the 12 bit DAC.\n
+ *          A sweep keeps the increment in 32.32 fixed point and adds a constant slope per sample, the phase
+ *          stays continuous at the turns. The tones are summed in q15 (scaled by their amplitudes) and
+ *          converted to the 12 bit codes around @ref MID_CODE, sums beyond the full scale are clipped.\n
+ *          @ref Render works in chunks of @ref CHUNK frames, a tone costs a table lookup, an interpolation
+ *          and a multiply accumulate per sample.
+ * @note    @ref Restart, @ref SetTone, @ref SetSweep and @ref DisableTone belong to the control thread while
+ *          the stream is stopped.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to make sure a clean access in one context.
+ *
+ */
+class DdsSynth
+{
+    public:
+
+        /// @brief Maximum simultaneous tones.
+        static constexpr uint8_t MAX_TONES{8U};
+
+        /// @brief Address bits of the waveform tables.
+        static constexpr uint32_t TABLE_BITS{10U};
+
+        /// @brief Samples per cycle of a waveform table (plus one guard sample).
+        static constexpr uint32_t TABLE_SIZE{1U << TABLE_BITS};
+
+        /// @brief Frames per internal mix step.
+        static constexpr uint32_t CHUNK{128U};
+
+        /// @brief Constructor at 1 MSPS, all tones are off.
+        DdsSynth() : DdsSynth(1000000U) {};
+
+        /**
+         * @brief   Constructs the synthesis, all tones are off.
+         *
+         * @param   sampleRate  Samples per second.
+         */
+        explicit DdsSynth(uint32_t sampleRate) : mSampleRate(sampleRate) {};
+
+        DdsSynth(DdsSynth const &) = delete;             //!< Copy constructor
+        DdsSynth& operator=(DdsSynth const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Set a tone, it starts at its phase, a sweep of the tone ends.
+         *
+         * @param   index   Tone 0 .. @ref MAX_TONES - 1.
+         * @param   tone    The tone.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status SetTone(uint8_t index, const Tone& tone);
+
+        /**
+         * @brief   Sweep a tone from its frequency, the phase stays continuous.
+         *
+         * @param   index   An enabled tone.
+         * @param   sweep   The sweep.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status SetSweep(uint8_t index, const Sweep& sweep);
+
+        /**
+         * @brief   Switch a tone off.
+         *
+         * @param   index   Tone 0 .. @ref MAX_TONES - 1.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status DisableTone(uint8_t index);
+
+        /**
+         * @brief   Set the sample rate and restart all tones at their phase and sweeps at their start.
+         *
+         * @param   sampleRate  Samples per second.
+         *
+         * @return  OK or INVALID_PARAM (a frequency is beyond the half of the rate, the tone is off).
+         */
+        Status Restart(uint32_t sampleRate);
+
+        /**
+         * @brief   Synthesise the next samples.
+         *
+         * @param   codes   The 12 bit codes.
+         *
+         * @return  Clipped samples.
+         */
+        uint32_t Render(std::span<uint16_t> codes);
+
+        /// @brief The sample rate.
+        uint32_t GetSampleRate() const {return mSampleRate;};
+
+        /// @brief Tones switched on.
+        uint8_t GetActiveTones() const;
+
+    private:
+
+        /// @brief Settings of a tone slot.
+        struct Setting
+        {
+            Tone tone;          //!< The tone
+            Sweep sweep;        //!< The sweep
+            bool enabled;       //!< The tone sounds
+            bool sweeping;      //!< The sweep is set
+        };
+
+        /// @brief State of the oscillator of a tone slot.
+        struct Voice
+        {
+            const int16_t* pTable;  //!< The waveform
+            uint32_t phase;         //!< Phase accumulator
+            uint32_t step;          //!< Phase increment of a constant tone
+            int32_t gain;           //!< Amplitude in q15
+            uint64_t sweepStep;     //!< Phase increment of a sweep in 32.32
+            int64_t slope;          //!< Increment change per sample in 32.32
+            uint64_t startStep;     //!< Increment at the start of the sweep
+            uint64_t stopStep;      //!< Increment at the end of the sweep
+            uint32_t length;        //!< Samples of a sweep
+            uint32_t remaining;     //!< Samples until the turn
+            bool sweeping;          //!< The increment changes
+            bool rising;            //!< Direction of a bouncing sweep
+        };
+
+        /// @brief Frequency within the Nyquist limit.
+        bool IsValidFrequency(float frequency) const;
+
+        /// @brief Start the oscillator of a slot from its settings.
+        void Load(uint8_t index);
+
+        /// @brief Increment of a frequency in 32.32.
+        uint64_t ToStep(float frequency) const;
+
+        /// @brief Add a constant tone to the mix.
+        static void MixTone(Voice& voice, int32_t* pMix, uint32_t frames);
+
+        /// @brief Add a sweeping tone to the mix.
+        static void MixSweep(Voice& voice, int32_t* pMix, uint32_t frames);
+
+        /// @brief Turn or finish a sweep.
+        static void Turn(Voice& voice, SweepMode mode);
+
+        uint32_t mSampleRate;                           //!< Samples per second
+        std::array<Setting, MAX_TONES> mSettings{};     //!< The tones as set
+        std::array<Voice, MAX_TONES> mVoices{};         //!< The running oscillators
+
+        /// @brief Sum of the tones of a chunk in q15.
+        alignas(32) std::array<int32_t, CHUNK> mMix{};
+};
+
+} // end namespace Dac
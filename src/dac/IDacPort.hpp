@@ -0,0 +1,88 @@
+/**
+ ********************************************************************************
+ * @file        IDacPort.hpp
+ *
+ * @namespace   Dac
+ *
+ * @brief       Dac, interface of a timer triggered DAC with circular DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DacTypes.hpp"
+namespace Dac {
+
+
+/**
+ * @brief   This class provides a DAC which converts a ping-pong ring (hardware or host device).
+ * @details @ref Start converts the ring at the sample rate, one word per trigger, and wraps around. When
+ *          the DMA has read a half the port reports it, the listener refills it while the other half plays.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one DacEngine.
+ *
+ */
+class IDacPort
+{
+    public:
+
+        /// @brief Receiver of the ring events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A half was read and may be refilled, called from the interrupt context.
+                 * @param half      0 for the first, 1 for the second half of the ring.
+                 */
+                virtual void OnHalf(uint8_t half) = 0;
+
+                /**
+                 * @brief The stream stopped, called from the interrupt context.
+                 * @param status    UNDERRUN (the DMA missed a trigger) or HW_ERROR (transfer error).
+                 */
+                virtual void OnError(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IDacPort() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start the conversions.
+         * @param config    The stream, the ring holds the first two halves.
+         * @return OK, BUSY, INVALID_PARAM (rate or channels not supported), HW_ERROR.
+         */
+        virtual Status Start(const StreamConfig& config) = 0;
+
+        /// @brief Stop the conversions.
+        virtual void Stop() = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IDacPort() = default;
+
+        IDacPort(IDacPort const &) = default;             //!< Copy constructor
+        IDacPort(IDacPort &&) = default;                  //!< Move constructor
+
+        IDacPort& operator=(IDacPort const &) = default;  //!< Copy assignment
+        IDacPort& operator=(IDacPort &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Dac
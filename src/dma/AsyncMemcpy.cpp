@@ -0,0 +1,86 @@
+/**
+ ********************************************************************************
+ * @file        AsyncMemcpy.cpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, memcpy by the MDMA implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "AsyncMemcpy.hpp"
+#include <cstring>
+
+using namespace Dma;
+
+
+AsyncMemcpy::AsyncMemcpy(IMdmaEngine& engine, uint32_t cpuThreshold)
+: mEngine(engine)
+, mCpuThreshold(cpuThreshold)
+{
+    mEngine.SetListener(this);
+}
+
+
+AsyncMemcpy::~AsyncMemcpy()
+{
+    if (mBusy)
+    {
+        mEngine.Abort();
+    }
+    mEngine.SetListener(nullptr);
+}
+
+
+Status AsyncMemcpy::Copy(void* pDst, const void* pSrc, uint32_t bytes, Callback callback, void* pContext)
+{
+    if ((bytes > 0U) && ((pDst == nullptr) || (pSrc == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mBusy)
+    {
+        return Status::BUSY;
+    }
+    if (bytes < mCpuThreshold)
+    {
+        if (bytes > 0U)
+        {
+            std::memcpy(pDst, pSrc, bytes);
+        }
+        mCpuCopies++;
+        return Status::OK;
+    }
+
+    mChain.Clear();
+    Status status = mChain.Copy(pSrc, pDst, bytes);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    // the completion may interrupt before the start returns
+    mCallback = callback;
+    mpContext = pContext;
+    mBusy = true;
+    status = mEngine.Start(mChain.GetNodes());
+    if (status != Status::OK)
+    {
+        mBusy = false;
+        return status;
+    }
+    mDmaCopies++;
+    return Status::PENDING;
+}
+
+
+void AsyncMemcpy::OnComplete(Status status)
+{
+    mBusy = false;
+    if (mCallback != nullptr)
+    {
+        mCallback(mpContext, status);
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ ********************************************************************************
+ * @file        AsyncMemcpy.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, memcpy by the MDMA with a CPU fallback for small sizes.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IMdmaEngine.hpp"
+#include "MdmaComposer.hpp"
+namespace Dma {
+
+
+/**
+ * @brief   This class provides a memcpy which runs in the background on a MDMA channel.
+ * @details A copy below the CPU threshold is done at once by std::memcpy, the setup of a chain and its
+ *          interrupt cost more than the copy. A larger copy is composed into a chain (the widest beats the
+ *          addresses allow, repeated blocks of 64 KiB) and started, the callback reports its completion from
+ *          the interrupt context. One copy runs at a time.\n
+ *          The typical use are the large copies between the D1, D2 and SDRAM memories which stall the core
+ *          on wait states.
+ * @note    The regions must not overlap. The cache maintenance is done by the engine (MdmaEngineHal), the
+ *          CPU must not touch the destination until the completion.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class AsyncMemcpy : private IMdmaEngine::IListener
+{
+    public:
+
+        /// @brief Default size from which the MDMA copies.
+        static constexpr uint32_t DEFAULT_CPU_THRESHOLD{1024U};
+
+        /**
+         * @brief   Completion of a copy, called from the interrupt context.
+         *
+         * @param   pContext    The context of the copy.
+         * @param   status      OK or HW_ERROR.
+         */
+        using Callback = void (*)(void* pContext, Status status);
+
+        /**
+         * @brief   Constructs the copier on an engine and registers as its listener.
+         *
+         * @param   engine          The MDMA channel.
+         * @param   cpuThreshold    Copies below this size are done by the CPU.
+         */
+        explicit AsyncMemcpy(IMdmaEngine& engine, uint32_t cpuThreshold = DEFAULT_CPU_THRESHOLD);
+
+        /// @brief Destructor, aborts a running copy.
+        ~AsyncMemcpy();
+
+        AsyncMemcpy(AsyncMemcpy const &) = delete;             //!< Copy constructor
+        AsyncMemcpy& operator=(AsyncMemcpy const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Copy a region.
+         *
+         * @param   pDst        Destination.
+         * @param   pSrc        Source.
+         * @param   bytes       Size in bytes.
+         * @param   callback    Completion of a MDMA copy, may be nullptr.
+         * @param   pContext    Passed to the callback.
+         *
+         * @return  OK (copied by the CPU, no callback), PENDING (the callback follows), BUSY, INVALID_PARAM or
+         *          the error of the engine.
+         */
+        Status Copy(void* pDst, const void* pSrc, uint32_t bytes, Callback callback, void* pContext);
+
+        /// @brief A MDMA copy runs.
+        bool IsBusy() const {return mBusy;};
+
+        /// @brief Copies done by the CPU.
+        uint32_t GetCpuCopies() const {return mCpuCopies;};
+
+        /// @brief Copies done by the MDMA.
+        uint32_t GetDmaCopies() const {return mDmaCopies;};
+
+    private:
+
+        /// @copydoc IMdmaEngine::IListener::OnComplete
+        void OnComplete(Status status) override;
+
+        /// @brief The MDMA channel.
+        IMdmaEngine& mEngine;
+
+        /// @brief Copies below this size are done by the CPU.
+        uint32_t mCpuThreshold;
+
+        /// @brief Chain of the running copy, the nodes of the largest copy.
+        MdmaChain<MdmaComposer::CopyNodes(UINT32_MAX)> mChain{};
+
+        /// @brief Completion of the running copy.
+        Callback mCallback{nullptr};
+
+        /// @brief Context of the running copy.
+        void* mpContext{nullptr};
+
+        /// @brief Set while a MDMA copy runs.
+        volatile bool mBusy{false};
+
+        /// @brief Copies done by the CPU.
+        uint32_t mCpuCopies{0U};
+
+        /// @brief Copies done by the MDMA.
+        uint32_t mDmaCopies{0U};
+};
+
+} // end namespace Dma
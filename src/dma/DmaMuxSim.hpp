@@ -0,0 +1,335 @@
+/**
+ ********************************************************************************
+ * @file        DmaMuxSim.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, host simulation of the DMAMUX with paced DMA streams.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISequencePort.hpp"
+#include <array>
+#include <vector>
+namespace Dma {
+
+
+/**
+ * @brief   This class provides a DMAMUX with its signals, peripheral requests and DMA streams on a tick clock
+ *          and records the timeline of the register writes.
+ * @details The signals are square waves (rising at phase + k * period, falling half a period later), the
+ *          peripheral requests are pulses (at phase + k * period). @ref Advance runs the clock tick by tick,
+ *          per tick the signal edges come first, then the peripheral requests, then the streams serve their
+ *          pending requests, one transfer takes @ref SetTransferTime ticks (0: all at once).
+ *          - Pacing::GENERATOR: an event sets the pending requests of the stream to the requests per event.
+ *          - Pacing::SYNCHRONIZED: an event lets the next requests per event requests of the peripheral pass,
+ *            the others are blocked.
+ *
+ *          An event which comes while the requests of the previous one are pending (generator) or not passed
+ *          (synchronization) is lost and reported as OVERRUN, like the overrun flags of the DMAMUX.
+ *          Every write goes into the target and into the timeline. The listeners are called synchronously
+ *          like the interrupts, @ref InjectFault models a transfer error.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to make sure a clean access in one context.
+ *
+ */
+class DmaMuxSim
+{
+    public:
+
+        /// @brief Streams of the simulation.
+        static constexpr uint8_t CHANNELS{4U};
+
+        /// @brief A register write.
+        struct Write
+        {
+            uint64_t time;      //!< Tick
+            uint8_t channel;    //!< The stream
+            Address target;     //!< The register
+            uint32_t value;     //!< The value
+        };
+
+        /// @brief A DMA stream behind a DMAMUX channel.
+        class Channel : public ISequencePort
+        {
+            public:
+
+                /// @copydoc ISequencePort::SetListener
+                void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+                /// @copydoc ISequencePort::Start
+                Status Start(const Track& track) override
+                {
+                    if (mRunning)
+                    {
+                        return Status::BUSY;
+                    }
+                    if (!track.IsValid())
+                    {
+                        return Status::INVALID_PARAM;
+                    }
+                    mTrack = track;
+                    mIndex = 0U;
+                    mPending = 0U;
+                    mGate = 0U;
+                    mBusyUntil = 0U;
+                    mRunning = true;
+                    return Status::OK;
+                }
+
+                /// @copydoc ISequencePort::Stop
+                void Stop() override {mRunning = false;};
+
+                /// @brief The stream runs.
+                bool IsRunning() const {return mRunning;};
+
+            private:
+
+                friend class DmaMuxSim;
+
+                /// @brief A signal edge.
+                void OnEdge(uint8_t signal, bool rising)
+                {
+                    const bool match = (signal == mTrack.signal) && ((mTrack.edge == Edge::BOTH)
+                        || ((mTrack.edge == Edge::RISING) == rising));
+                    if (!mRunning || !match)
+                    {
+                        return;
+                    }
+                    uint32_t& counter = (mTrack.pacing == Pacing::GENERATOR) ? mPending : mGate;
+                    if (counter > 0U)
+                    {
+                        Report(Status::OVERRUN);
+                        return;
+                    }
+                    counter = mTrack.requestsPerEvent;
+                }
+
+                /// @brief A peripheral request.
+                void OnRequest(uint8_t request)
+                {
+                    if (mRunning && (mTrack.pacing == Pacing::SYNCHRONIZED) && (request == mTrack.request)
+                        && (mGate > 0U))
+                    {
+                        mGate--;
+                        mPending++;
+                    }
+                }
+
+                /// @brief Serve the pending requests of a tick.
+                void Serve(DmaMuxSim& mux, uint8_t channel)
+                {
+                    while (mRunning && (mPending > 0U) && (mux.mTime >= mBusyUntil))
+                    {
+                        if (mFault)
+                        {
+                            mFault = false;
+                            mRunning = false;
+                            Report(Status::HW_ERROR);
+                            return;
+                        }
+                        const uint32_t value = mTrack.words[mIndex];
+                        *mTrack.pTarget = value;
+                        mux.mTimeline.push_back({mux.mTime, channel, reinterpret_cast<Address>(mTrack.pTarget), value});
+                        mPending--;
+                        mBusyUntil = mux.mTime + mux.mTransferTime;
+                        Advance();
+                        if (mux.mTransferTime > 0U)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                /// @brief Next word, the half and the end events.
+                void Advance()
+                {
+                    mIndex++;
+                    const size_t size = mTrack.words.size();
+                    if (mTrack.loop && (mIndex == (size / 2U)))
+                    {
+                        Notify(0U);
+                    }
+                    else if (mIndex == size)
+                    {
+                        mIndex = 0U;
+                        if (mTrack.loop)
+                        {
+                            Notify(1U);
+                        }
+                        else
+                        {
+                            mRunning = false;
+                            if (mpListener != nullptr)
+                            {
+                                mpListener->OnDone();
+                            }
+                        }
+                    }
+                }
+
+                void Notify(uint8_t half)
+                {
+                    if (mpListener != nullptr)
+                    {
+                        mpListener->OnHalf(half);
+                    }
+                }
+
+                void Report(Status status)
+                {
+                    if (mpListener != nullptr)
+                    {
+                        mpListener->OnError(status);
+                    }
+                }
+
+                IListener* mpListener{nullptr};     //!< Receiver of the events
+                Track mTrack{};                     //!< The running track
+                size_t mIndex{0U};                  //!< Next word
+                uint32_t mPending{0U};              //!< Requests to serve
+                uint32_t mGate{0U};                 //!< Peripheral requests which may pass
+                uint64_t mBusyUntil{0U};            //!< End of the running transfer
+                bool mRunning{false};               //!< Armed
+                bool mFault{false};                 //!< The next transfer fails
+        };
+
+        /// @brief Constructor, no signals and requests.
+        DmaMuxSim() = default;
+
+        DmaMuxSim(DmaMuxSim const &) = delete;             //!< Copy constructor
+        DmaMuxSim& operator=(DmaMuxSim const &) = delete;  //!< Copy assignment
+
+        /// @brief A stream, 0 .. @ref CHANNELS - 1.
+        Channel& GetChannel(uint8_t channel) {return mChannels[channel];};
+
+        /**
+         * @brief   Set a square wave signal.
+         *
+         * @param   signal  The signal, 0 .. @ref MAX_SIGNAL.
+         * @param   period  Period in ticks, at least 2, 0 turns it off.
+         * @param   phase   Tick of the first rising edge.
+         */
+        void SetSignal(uint8_t signal, uint64_t period, uint64_t phase) {mSignals.at(signal) = {period, phase};};
+
+        /**
+         * @brief   Set periodic requests of a peripheral.
+         *
+         * @param   request The request (DMA_REQUEST_x).
+         * @param   period  Period in ticks, 0 turns it off.
+         * @param   phase   Tick of the first request.
+         */
+        void SetPeripheralRequest(uint8_t request, uint64_t period, uint64_t phase)
+        {
+            mRequests.push_back({request, {period, phase}});
+        }
+
+        /// @brief Ticks per DMA transfer.
+        void SetTransferTime(uint64_t ticks) {mTransferTime = ticks;};
+
+        /// @brief The next transfer of a stream fails.
+        void InjectFault(uint8_t channel) {mChannels[channel].mFault = true;};
+
+        /**
+         * @brief   Run the clock.
+         *
+         * @param   ticks   Count of ticks.
+         */
+        void Advance(uint64_t ticks)
+        {
+            for (uint64_t end = mTime + ticks; mTime < end; mTime++)
+            {
+                for (uint8_t signal = 0U; signal <= MAX_SIGNAL; signal++)
+                {
+                    const Periodic& wave = mSignals[signal];
+                    if (wave.At(mTime))
+                    {
+                        PassEdge(signal, true);
+                    }
+                    if ((wave.period > 0U) && (mTime >= (wave.period / 2U)) && wave.At(mTime - (wave.period / 2U)))
+                    {
+                        PassEdge(signal, false);
+                    }
+                }
+                for (const PeripheralRequest& request : mRequests)
+                {
+                    if (request.pulses.At(mTime))
+                    {
+                        for (Channel& channel : mChannels)
+                        {
+                            channel.OnRequest(request.request);
+                        }
+                    }
+                }
+                for (uint8_t channel = 0U; channel < CHANNELS; channel++)
+                {
+                    mChannels[channel].Serve(*this, channel);
+                }
+            }
+        }
+
+        /// @brief The current tick.
+        uint64_t GetTime() const {return mTime;};
+
+        /// @brief The writes since the start or the last clear.
+        const std::vector<Write>& GetTimeline() const {return mTimeline;};
+
+        /// @brief Clear the timeline.
+        void ClearTimeline() {mTimeline.clear();};
+
+    private:
+
+        /// @brief Events at phase + k * period.
+        struct Periodic
+        {
+            uint64_t period{0U};    //!< Period in ticks, 0 is off
+            uint64_t phase{0U};     //!< First event
+
+            /// @brief An event at the tick.
+            bool At(uint64_t time) const {return (period > 0U) && (time >= phase) && (((time - phase) % period) == 0U);};
+        };
+
+        /// @brief Periodic requests of a peripheral.
+        struct PeripheralRequest
+        {
+            uint8_t request;        //!< The request
+            Periodic pulses;        //!< Its timing
+        };
+
+        /// @brief Pass an edge to the streams.
+        void PassEdge(uint8_t signal, bool rising)
+        {
+            for (Channel& channel : mChannels)
+            {
+                channel.OnEdge(signal, rising);
+            }
+        }
+
+        /// @brief The streams.
+        std::array<Channel, CHANNELS> mChannels{};
+
+        /// @brief The signals.
+        std::array<Periodic, MAX_SIGNAL + 1U> mSignals{};
+
+        /// @brief The peripheral requests.
+        std::vector<PeripheralRequest> mRequests{};
+
+        /// @brief The writes.
+        std::vector<Write> mTimeline{};
+
+        /// @brief Ticks per transfer.
+        uint64_t mTransferTime{0U};
+
+        /// @brief The current tick.
+        uint64_t mTime{0U};
+};
+
+} // end namespace Dma
@@ -0,0 +1,227 @@
+/**
+ ********************************************************************************
+ * @file        DmaSequencer.cpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, hardware timed register write sequences implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DmaSequencer.hpp"
+#include <algorithm>
+
+using namespace Dma;
+
+namespace {
+
+/// @brief Full scale of the 12 bit DAC.
+constexpr uint16_t DAC12_MAX{4095U};
+
+} // end anonymous namespace
+
+
+DmaSequencer::DmaSequencer(std::span<ISequencePort* const> ports)
+: mPortCount(static_cast<uint8_t>(std::min<size_t>(ports.size(), MAX_TRACKS)))
+{
+    for (uint8_t i = 0U; i < mPortCount; i++)
+    {
+        mPorts[i] = ports[i];
+        mPortListeners[i].Bind(this, i);
+        mPorts[i]->SetListener(&mPortListeners[i]);
+    }
+}
+
+
+DmaSequencer::~DmaSequencer()
+{
+    Stop();
+    for (uint8_t i = 0U; i < mPortCount; i++)
+    {
+        mPorts[i]->SetListener(nullptr);
+    }
+}
+
+
+Status DmaSequencer::SetTrack(uint8_t index, const Track& track)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if ((index >= mPortCount) || !track.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+    mTracks[index] = track;
+    mUsed[index] = true;
+    return Status::OK;
+}
+
+
+void DmaSequencer::ClearTracks()
+{
+    if (!mRunning)
+    {
+        mUsed.fill(false);
+    }
+}
+
+
+Status DmaSequencer::Start()
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    uint8_t pending = 0U;
+    bool any = false;
+    for (uint8_t i = 0U; i < mPortCount; i++)
+    {
+        any = any || mUsed[i];
+        pending += (mUsed[i] && !mTracks[i].loop) ? 1U : 0U;
+    }
+    if (!any)
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    // armed before the first event, a fast track may finish before the start returns
+    mPending = pending;
+    mRunning = true;
+    for (uint8_t i = 0U; i < mPortCount; i++)
+    {
+        if (!mUsed[i])
+        {
+            continue;
+        }
+        const Status status = mPorts[i]->Start(mTracks[i]);
+        if (status != Status::OK)
+        {
+            Stop();
+            return status;
+        }
+    }
+    return Status::OK;
+}
+
+
+void DmaSequencer::Stop()
+{
+    if (mRunning)
+    {
+        mRunning = false;
+        StopPorts();
+    }
+}
+
+
+void DmaSequencer::StopPorts()
+{
+    for (uint8_t i = 0U; i < mPortCount; i++)
+    {
+        if (mUsed[i])
+        {
+            mPorts[i]->Stop();
+        }
+    }
+}
+
+
+void DmaSequencer::OnHalf(uint8_t index, uint8_t half)
+{
+    if (mRunning && (mpListener != nullptr))
+    {
+        mpListener->OnTrackHalf(index, half);
+    }
+}
+
+
+void DmaSequencer::OnDone()
+{
+    if (!mRunning || (mPending == 0U))
+    {
+        return;
+    }
+    mPending = mPending - 1U;
+    // a sequence with a looping track ends by Stop only
+    bool loops = false;
+    for (uint8_t i = 0U; i < mPortCount; i++)
+    {
+        loops = loops || (mUsed[i] && mTracks[i].loop);
+    }
+    if ((mPending == 0U) && !loops)
+    {
+        mRunning = false;
+        StopPorts();
+        if (mpListener != nullptr)
+        {
+            mpListener->OnSequenceDone();
+        }
+    }
+}
+
+
+void DmaSequencer::OnError(uint8_t index, Status status)
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    if (status == Status::OVERRUN)
+    {
+        mOverruns = mOverruns + 1U;
+    }
+    else
+    {
+        // the tracks would drift apart
+        Stop();
+    }
+    if (mpListener != nullptr)
+    {
+        mpListener->OnSequenceError(index, status);
+    }
+}
+
+
+Status DmaSequencer::EncodeGpio(uint16_t pinMask, std::span<const uint16_t> levels, std::span<uint32_t> words)
+{
+    if (words.size() != levels.size())
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (size_t i = 0U; i < levels.size(); i++)
+    {
+        // BS in the lower half, BR in the upper half
+        const uint32_t set = levels[i] & pinMask;
+        const uint32_t reset = static_cast<uint16_t>(~levels[i]) & pinMask;
+        words[i] = set | (reset << 16U);
+    }
+    return Status::OK;
+}
+
+
+Status DmaSequencer::EncodeDac12(std::span<const uint16_t> samples, std::span<uint32_t> words)
+{
+    if (words.size() != samples.size())
+    {
+        return Status::INVALID_PARAM;
+    }
+    std::transform(samples.begin(), samples.end(), words.begin(),
+                   [](uint16_t sample) {return static_cast<uint32_t>(std::min(sample, DAC12_MAX));});
+    return Status::OK;
+}
+
+
+Status DmaSequencer::EncodeTimerPeriods(std::span<const uint32_t> periods, std::span<uint32_t> words)
+{
+    if ((words.size() != periods.size()) || std::ranges::any_of(periods, [](uint32_t period) {return period == 0U;}))
+    {
+        return Status::INVALID_PARAM;
+    }
+    std::transform(periods.begin(), periods.end(), words.begin(), [](uint32_t period) {return period - 1U;});
+    return Status::OK;
+}
@@ -0,0 +1,214 @@
+/**
+ ********************************************************************************
+ * @file        DmaSequencer.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, hardware timed register write sequences on DMAMUX paced streams.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISequencePort.hpp"
+#include <array>
+#include <span>
+namespace Dma {
+
+
+/**
+ * @brief   This class provides sequences of register writes which are timed by the hardware instead of an
+ *          interrupt: GPIO bit patterns, DAC waveforms, timer reloads.
+ * @details A sequence has up to @ref MAX_TRACKS tracks, each one runs on its own DMA stream (ISequencePort).
+ *          A track writes its words into one register, a request generator of the DMAMUX issues the requests
+ *          on the events of a timer or EXTI signal (Pacing::GENERATOR), or the DMAMUX lets some requests of
+ *          a peripheral pass after each event (Pacing::SYNCHRONIZED). Tracks on the same signal write on the
+ *          same events, so e.g. a GPIO pattern and a timer reload stay aligned without jitter.\n
+ *          @ref Start arms all tracks, the application starts the pacing signal (LPTIM, TIM12) afterwards,
+ *          so every track sees the first event. A sequence of single tracks ends with the last write of the
+ *          last track. Looping tracks run until @ref Stop, their halves are reported for a refill.
+ *          An overrun is counted and reported, a stream error stops the sequence.\n
+ *          The encoders fill the words of the common targets.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * The listener is called from the interrupt context, @ref Start and @ref Stop must not interrupt each other.
+ *
+ */
+class DmaSequencer
+{
+    public:
+
+        /// @brief Maximum tracks of a sequence.
+        static constexpr uint8_t MAX_TRACKS{4U};
+
+        /// @brief Receiver of the sequence events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A half of a looping track is written and may be refilled, called from the interrupt context.
+                 * @param track     The track index.
+                 * @param half      0 for the first, 1 for the second half.
+                 */
+                virtual void OnTrackHalf(uint8_t track, uint8_t half) = 0;
+
+                /// @brief The last single track is written, called from the interrupt context.
+                virtual void OnSequenceDone() = 0;
+
+                /**
+                 * @brief A track lost an event or failed, called from the interrupt context.
+                 * @param track     The track index.
+                 * @param status    OVERRUN (the sequence continues) or HW_ERROR (the sequence stopped).
+                 */
+                virtual void OnSequenceError(uint8_t track, Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /**
+         * @brief   Constructs the sequencer on streams and registers as their listener.
+         *
+         * @param   ports   The streams of the tracks, track n runs on port n, up to @ref MAX_TRACKS.
+         */
+        explicit DmaSequencer(std::span<ISequencePort* const> ports);
+
+        /// @brief Destructor, stops the sequence.
+        ~DmaSequencer();
+
+        DmaSequencer(DmaSequencer const &) = delete;             //!< Copy constructor
+        DmaSequencer& operator=(DmaSequencer const &) = delete;  //!< Copy assignment
+
+        /// @brief Register the listener, nullptr to unregister.
+        void SetListener(IListener* pListener) {mpListener = pListener;};
+
+        /**
+         * @brief   Set a track of the sequence.
+         *
+         * @param   index   The track, less than the count of ports.
+         * @param   track   The track, its words must stay valid while the sequence runs.
+         *
+         * @return  OK, BUSY, INVALID_PARAM.
+         */
+        Status SetTrack(uint8_t index, const Track& track);
+
+        /// @brief Remove all tracks, only while stopped.
+        void ClearTracks();
+
+        /**
+         * @brief   Arm all tracks.
+         *
+         * @return  OK, BUSY, INVALID_PARAM (no track) or the error of a port (all tracks stopped).
+         */
+        Status Start();
+
+        /// @brief Stop all tracks.
+        void Stop();
+
+        /// @brief The sequence runs.
+        bool IsRunning() const {return mRunning;};
+
+        /// @brief Events lost by the tracks since the construction.
+        uint32_t GetOverruns() const {return mOverruns;};
+
+        /**
+         * @brief   GPIO bit pattern as BSRR words, set and reset of the pins in one write.
+         *
+         * @param   pinMask     The pins driven by the pattern, the others stay.
+         * @param   levels      Pin levels per step.
+         * @param   words       BSRR words, the size of the levels.
+         *
+         * @return  OK, INVALID_PARAM.
+         */
+        static Status EncodeGpio(uint16_t pinMask, std::span<const uint16_t> levels, std::span<uint32_t> words);
+
+        /**
+         * @brief   DAC samples as DHR12R words, saturated to 12 bit.
+         *
+         * @param   samples     Samples.
+         * @param   words       DHR12R words, the size of the samples.
+         *
+         * @return  OK, INVALID_PARAM.
+         */
+        static Status EncodeDac12(std::span<const uint16_t> samples, std::span<uint32_t> words);
+
+        /**
+         * @brief   Timer periods as ARR words (period - 1), for a preloaded ARR on the timer update request.
+         *
+         * @param   periods     Periods in timer counts, at least 1.
+         * @param   words       ARR words, the size of the periods.
+         *
+         * @return  OK, INVALID_PARAM.
+         */
+        static Status EncodeTimerPeriods(std::span<const uint32_t> periods, std::span<uint32_t> words);
+
+    private:
+
+        /// @brief Listener of one port, adds the track index.
+        class PortListener : public ISequencePort::IListener
+        {
+            public:
+                /// @brief Binds the listener to a track.
+                void Bind(DmaSequencer* pOwner, uint8_t index) {mpOwner = pOwner; mIndex = index;};
+
+                /// @copydoc ISequencePort::IListener::OnHalf
+                void OnHalf(uint8_t half) override {mpOwner->OnHalf(mIndex, half);};
+
+                /// @copydoc ISequencePort::IListener::OnDone
+                void OnDone() override {mpOwner->OnDone();};
+
+                /// @copydoc ISequencePort::IListener::OnError
+                void OnError(Status status) override {mpOwner->OnError(mIndex, status);};
+
+            private:
+                DmaSequencer* mpOwner{nullptr};     //!< The sequencer
+                uint8_t mIndex{0U};                 //!< The track index
+        };
+
+        /// @brief A half of a looping track is written.
+        void OnHalf(uint8_t index, uint8_t half);
+
+        /// @brief A single track is done.
+        void OnDone();
+
+        /// @brief A track lost an event or failed.
+        void OnError(uint8_t index, Status status);
+
+        /// @brief Stop the ports of the set tracks.
+        void StopPorts();
+
+        /// @brief The streams of the tracks.
+        std::array<ISequencePort*, MAX_TRACKS> mPorts{};
+
+        /// @brief The listeners of the streams.
+        std::array<PortListener, MAX_TRACKS> mPortListeners{};
+
+        /// @brief The tracks.
+        std::array<Track, MAX_TRACKS> mTracks{};
+
+        /// @brief The tracks which are set.
+        std::array<bool, MAX_TRACKS> mUsed{};
+
+        /// @brief Count of ports.
+        uint8_t mPortCount{0U};
+
+        /// @brief Receiver of the sequence events.
+        IListener* mpListener{nullptr};
+
+        /// @brief Single tracks which are not done.
+        volatile uint8_t mPending{0U};
+
+        /// @brief Set while the sequence runs.
+        volatile bool mRunning{false};
+
+        /// @brief Lost events.
+        volatile uint32_t mOverruns{0U};
+};
+
+} // end namespace Dma
@@ -0,0 +1,128 @@
+/**
+ ********************************************************************************
+ * @file        DmaTypes.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, types of the transfer composers and engines.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+namespace Dma {
+
+
+/// @brief A bus address, 32 bit on the target, a host pointer in the simulation.
+using Address = uintptr_t;
+
+/// @brief Result of a DMA operation or event.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< A transfer runs, retry after its completion
+    INVALID_PARAM=2,  //!< Parameter is inconsistent (null pointer, alignment, limits of the hardware)
+    HW_ERROR=3,       //!< The DMA reported a transfer error, the transfer stopped
+    PENDING=4,        //!< Transfer is started, the completion follows
+    NO_SPACE=5,       //!< The node storage is full
+    OVERRUN=6         //!< An event came while the requests of the previous one were pending, it was lost
+};
+
+/// @brief A source range of a transfer.
+struct ConstRegion
+{
+    const void* pData;  //!< First byte
+    uint32_t bytes;     //!< Size in bytes
+};
+
+/// @brief A destination range of a transfer.
+struct Region
+{
+    void* pData;        //!< First byte
+    uint32_t bytes;     //!< Size in bytes
+};
+
+/// @brief One linear copy.
+struct CopyItem
+{
+    const void* pSrc;   //!< Source
+    void* pDst;         //!< Destination
+    uint32_t bytes;     //!< Size in bytes
+};
+
+/**
+ * @brief A strided copy of lines (a rectangle of an image, a column of a table).
+ * @details Line n is copied from pSrc + n * srcStride to pDst + n * dstStride.
+ */
+struct Copy2DItem
+{
+    const void* pSrc;   //!< First line of the source
+    uint32_t srcStride; //!< Bytes from line to line in the source
+    void* pDst;         //!< First line of the destination
+    uint32_t dstStride; //!< Bytes from line to line in the destination
+    uint32_t lineBytes; //!< Bytes per line
+    uint32_t lines;     //!< Count of lines
+};
+
+/// @brief Edge of a pacing signal which counts as an event.
+enum class Edge : uint8_t
+{
+    RISING=0,   //!< Rising edge
+    FALLING=1,  //!< Falling edge
+    BOTH=2      //!< Both edges
+};
+
+/// @brief Source of the DMA requests of a track.
+enum class Pacing : uint8_t
+{
+    GENERATOR=0,    //!< A request generator of the DMAMUX issues the requests on the signal events
+    SYNCHRONIZED=1  //!< The requests of a peripheral pass the DMAMUX after each signal event
+};
+
+/// @brief Highest DMAMUX1 signal of the request generators and the synchronization (TIM12_TRGO).
+constexpr uint8_t MAX_SIGNAL{7U};
+
+/// @brief Request generators of the DMAMUX1.
+constexpr uint8_t GENERATORS{8U};
+
+/// @brief Maximum requests per event (GNBREQ, NBREQ).
+constexpr uint8_t MAX_REQUESTS_PER_EVENT{32U};
+
+/// @brief Maximum words of a track, the limit of the DMA counter.
+constexpr uint32_t MAX_TRACK_WORDS{65535U};
+
+/**
+ * @brief A stream of register writes paced by the DMAMUX.
+ * @details Every request writes the next word into the target register. The signal is the DMAMUX1 input of
+ *          the request generators and the synchronization (0 .. 2 the events of DMAMUX channels 0 .. 2,
+ *          3 .. 5 LPTIM1 .. LPTIM3 OUT, 6 EXTI0, 7 TIM12 TRGO).
+ */
+struct Track
+{
+    volatile uint32_t* pTarget;         //!< Register (GPIO BSRR, DAC DHR, TIM ARR, ...)
+    std::span<const uint32_t> words;    //!< Values, in a DMA accessible RAM (not DTCM)
+    bool loop;                          //!< Repeat the words until stopped, else write them once
+    Pacing pacing;                      //!< Source of the requests
+    uint8_t signal;                     //!< Pacing signal, 0 .. @ref MAX_SIGNAL
+    Edge edge;                          //!< Edge of the events
+    uint8_t requestsPerEvent;           //!< Requests per event, 1 .. @ref MAX_REQUESTS_PER_EVENT
+    uint8_t request;                    //!< GENERATOR: the generator 0 .. 7, SYNCHRONIZED: the peripheral request (DMA_REQUEST_x)
+
+    /// @brief Parameters in range, a loop has two halves.
+    bool IsValid() const
+    {
+        return (pTarget != nullptr) && !words.empty() && (words.size() <= MAX_TRACK_WORDS)
+            && (!loop || ((words.size() >= 2U) && ((words.size() % 2U) == 0U)))
+            && (signal <= MAX_SIGNAL) && (edge <= Edge::BOTH)
+            && (requestsPerEvent >= 1U) && (requestsPerEvent <= MAX_REQUESTS_PER_EVENT)
+            && (((pacing == Pacing::GENERATOR) && (request < GENERATORS))
+                || ((pacing == Pacing::SYNCHRONIZED) && (request > 0U)));
+    }
+};
+
+} // end namespace Dma
@@ -0,0 +1,86 @@
+/**
+ ********************************************************************************
+ * @file        IMdmaEngine.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, interface of a MDMA channel which runs node chains.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "MdmaNode.hpp"
+#include <span>
+namespace Dma {
+
+
+/**
+ * @brief   This class provides a MDMA channel (hardware or simulation) which runs a chain of nodes.
+ * @details @ref Start loads the first node into the channel, the channel follows the links (CLAR) to the end
+ *          of the chain and reports the completion. A circular chain runs until @ref Abort.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to make sure a clean access in one context.
+ *
+ */
+class IMdmaEngine
+{
+    public:
+
+        /// @brief Receiver of the completion.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief The chain is done, called from the interrupt context.
+                 * @param status    OK or HW_ERROR (the transfer stopped).
+                 */
+                virtual void OnComplete(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IMdmaEngine() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start a chain.
+         * @param nodes     The storage of the chain, the first node starts, it must stay valid until the completion.
+         * @return OK, BUSY, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status Start(std::span<const MdmaNode> nodes) = 0;
+
+        /// @brief Stop the running chain, no completion is reported.
+        virtual void Abort() = 0;
+
+        /// @brief A chain runs.
+        virtual bool IsBusy() const = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IMdmaEngine() = default;
+
+        IMdmaEngine(IMdmaEngine const &) = default;             //!< Copy constructor
+        IMdmaEngine(IMdmaEngine &&) = default;                  //!< Move constructor
+
+        IMdmaEngine& operator=(IMdmaEngine const &) = default;  //!< Copy assignment
+        IMdmaEngine& operator=(IMdmaEngine &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Dma
@@ -0,0 +1,92 @@
+/**
+ ********************************************************************************
+ * @file        ISequencePort.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, interface of a DMA stream paced by the DMAMUX.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DmaTypes.hpp"
+namespace Dma {
+
+
+/**
+ * @brief   This class provides a DMA stream behind a DMAMUX channel (hardware or simulation) which writes the
+ *          words of a track into a register, one per request.
+ * @details A looping track runs circular and reports each written half, a single track reports its last
+ *          write.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one DmaSequencer.
+ *
+ */
+class ISequencePort
+{
+    public:
+
+        /// @brief Receiver of the stream events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A half of the words of a looping track is written, called from the interrupt context.
+                 * @param half      0 for the first, 1 for the second half.
+                 */
+                virtual void OnHalf(uint8_t half) = 0;
+
+                /// @brief The last word of a single track is written, called from the interrupt context.
+                virtual void OnDone() = 0;
+
+                /**
+                 * @brief An event was lost or the stream failed, called from the interrupt context.
+                 * @param status    OVERRUN (the track continues) or HW_ERROR (the stream stopped).
+                 */
+                virtual void OnError(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~ISequencePort() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Arm the stream, the writes follow the requests.
+         * @param track     The track, valid until the stream stops.
+         * @return OK, BUSY, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status Start(const Track& track) = 0;
+
+        /// @brief Stop the stream.
+        virtual void Stop() = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        ISequencePort() = default;
+
+        ISequencePort(ISequencePort const &) = default;             //!< Copy constructor
+        ISequencePort(ISequencePort &&) = default;                  //!< Move constructor
+
+        ISequencePort& operator=(ISequencePort const &) = default;  //!< Copy assignment
+        ISequencePort& operator=(ISequencePort &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Dma
@@ -0,0 +1,348 @@
+/**
+ ********************************************************************************
+ * @file        MdmaComposer.cpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, builder of MDMA node chains implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "MdmaComposer.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace Dma;
+
+namespace {
+
+/// @brief Widest beat which divides all bits.
+DataSize Widest(uint64_t bits)
+{
+    if ((bits % 8U) == 0U)
+    {
+        return DataSize::DOUBLE_WORD;
+    }
+    if ((bits % 4U) == 0U)
+    {
+        return DataSize::WORD;
+    }
+    return ((bits % 2U) == 0U) ? DataSize::HALF_WORD : DataSize::BYTE;
+}
+
+/// @brief Bytes of a beat.
+uint32_t Bytes(DataSize size)
+{
+    return 1U << static_cast<uint32_t>(size);
+}
+
+/// @brief The address is in the ITCM or DTCM, the MDMA reaches it by the AHB.
+bool IsTcm(Address address)
+{
+    return (address < 0x00010000U) || ((address >= 0x20000000U) && (address < 0x20020000U));
+}
+
+Address ToAddress(const volatile void* p)
+{
+    return reinterpret_cast<Address>(p);
+}
+
+} // end anonymous namespace
+
+
+void MdmaComposer::Clear()
+{
+    mCount = 0U;
+}
+
+
+void MdmaComposer::SetSoftwareRequest()
+{
+    mRequest = 0U;
+    mMode = TriggerMode::LINKED_LIST;
+    mSoftware = true;
+}
+
+
+Status MdmaComposer::SetHardwareRequest(uint8_t request, TriggerMode mode)
+{
+    if ((request > MdmaNode::MAX_REQUEST) || (mode > TriggerMode::LINKED_LIST))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mRequest = request;
+    mMode = mode;
+    mSoftware = false;
+    return Status::OK;
+}
+
+
+Status MdmaComposer::Copy(const void* pSrc, void* pDst, uint32_t bytes)
+{
+    if ((bytes > 0U) && ((pSrc == nullptr) || (pDst == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const size_t count = mCount;
+    return Rollback(count, AddCopy(ToAddress(pSrc), ToAddress(pDst), bytes));
+}
+
+
+Status MdmaComposer::Copy(std::span<const CopyItem> items)
+{
+    const size_t count = mCount;
+    Status status = Status::OK;
+    for (const CopyItem& item : items)
+    {
+        if ((item.bytes > 0U) && ((item.pSrc == nullptr) || (item.pDst == nullptr)))
+        {
+            status = Status::INVALID_PARAM;
+        }
+        else
+        {
+            status = AddCopy(ToAddress(item.pSrc), ToAddress(item.pDst), item.bytes);
+        }
+        if (status != Status::OK)
+        {
+            break;
+        }
+    }
+    return Rollback(count, status);
+}
+
+
+Status MdmaComposer::Copy2D(const Copy2DItem& item)
+{
+    if ((item.pSrc == nullptr) || (item.pDst == nullptr) || (item.lineBytes == 0U)
+        || (item.lineBytes > MdmaNode::MAX_BLOCK_BYTES) || (item.lines == 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    const Address src = ToAddress(item.pSrc);
+    const Address dst = ToAddress(item.pDst);
+    const uint64_t strides = (item.lines > 1U) ? (item.srcStride | item.dstStride) : 0U;
+    const DataSize size = Widest(src | dst | item.lineBytes | strides);
+    const int64_t srcUpdate = static_cast<int64_t>(item.srcStride) - item.lineBytes;
+    const int64_t dstUpdate = static_cast<int64_t>(item.dstStride) - item.lineBytes;
+    const bool updates = (std::abs(srcUpdate) <= MdmaNode::MAX_UPDATE) && (std::abs(dstUpdate) <= MdmaNode::MAX_UPDATE);
+
+    const size_t count = mCount;
+    Status status = Status::OK;
+    uint32_t line = 0U;
+    while ((status == Status::OK) && (line < item.lines))
+    {
+        const Address lineSrc = src + (static_cast<Address>(line) * item.srcStride);
+        const Address lineDst = dst + (static_cast<Address>(line) * item.dstStride);
+        if (updates)
+        {
+            // the block update skips the gap to the next line
+            const uint32_t repeats = std::min(item.lines - line, MdmaNode::MAX_REPEATS);
+            status = AddNode(lineSrc, true, lineDst, true, size, item.lineBytes, repeats,
+                             static_cast<int32_t>(srcUpdate), static_cast<int32_t>(dstUpdate));
+            line += repeats;
+        }
+        else
+        {
+            status = AddLinear(lineSrc, true, lineDst, true, item.lineBytes, size);
+            line++;
+        }
+    }
+    return Rollback(count, status);
+}
+
+
+Status MdmaComposer::Gather(std::span<const ConstRegion> sources, void* pDst)
+{
+    if (pDst == nullptr)
+    {
+        return Status::INVALID_PARAM;
+    }
+    const size_t count = mCount;
+    Status status = Status::OK;
+    Address dst = ToAddress(pDst);
+    for (const ConstRegion& source : sources)
+    {
+        if ((source.bytes > 0U) && (source.pData == nullptr))
+        {
+            status = Status::INVALID_PARAM;
+        }
+        else
+        {
+            status = AddCopy(ToAddress(source.pData), dst, source.bytes);
+        }
+        if (status != Status::OK)
+        {
+            break;
+        }
+        dst += source.bytes;
+    }
+    return Rollback(count, status);
+}
+
+
+Status MdmaComposer::Scatter(const void* pSrc, std::span<const Region> destinations)
+{
+    if (pSrc == nullptr)
+    {
+        return Status::INVALID_PARAM;
+    }
+    const size_t count = mCount;
+    Status status = Status::OK;
+    Address src = ToAddress(pSrc);
+    for (const Region& destination : destinations)
+    {
+        if ((destination.bytes > 0U) && (destination.pData == nullptr))
+        {
+            status = Status::INVALID_PARAM;
+        }
+        else
+        {
+            status = AddCopy(src, ToAddress(destination.pData), destination.bytes);
+        }
+        if (status != Status::OK)
+        {
+            break;
+        }
+        src += destination.bytes;
+    }
+    return Rollback(count, status);
+}
+
+
+Status MdmaComposer::WriteRegister(const void* pSrc, volatile void* pRegister, uint32_t bytes, DataSize size)
+{
+    const Address src = ToAddress(pSrc);
+    const Address reg = ToAddress(pRegister);
+    if ((pSrc == nullptr) || (pRegister == nullptr) || (size > DataSize::DOUBLE_WORD) || (bytes == 0U)
+        || (((src | reg | bytes) % Bytes(size)) != 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const size_t count = mCount;
+    return Rollback(count, AddLinear(src, true, reg, false, bytes, size));
+}
+
+
+Status MdmaComposer::ReadRegister(const volatile void* pRegister, void* pDst, uint32_t bytes, DataSize size)
+{
+    const Address reg = ToAddress(pRegister);
+    const Address dst = ToAddress(pDst);
+    if ((pRegister == nullptr) || (pDst == nullptr) || (size > DataSize::DOUBLE_WORD) || (bytes == 0U)
+        || (((reg | dst | bytes) % Bytes(size)) != 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const size_t count = mCount;
+    return Rollback(count, AddLinear(reg, false, dst, true, bytes, size));
+}
+
+
+void MdmaComposer::SetCircular(bool circular)
+{
+    mCircular = circular;
+    if (mCount > 0U)
+    {
+        mNodes[mCount - 1U].clar = EndLink();
+    }
+}
+
+
+Status MdmaComposer::AddCopy(Address src, Address dst, uint32_t bytes)
+{
+    // a head of bytes aligns both addresses if they have the same offset, a tail of bytes ends the copy
+    const DataSize size = Widest(src ^ dst);
+    const uint32_t beat = Bytes(size);
+    const uint32_t head = std::min(static_cast<uint32_t>((beat - (src % beat)) % beat), bytes);
+    const uint32_t body = (bytes - head) & ~(beat - 1U);
+    const uint32_t tail = bytes - head - body;
+
+    Status status = AddLinear(src, true, dst, true, head, DataSize::BYTE);
+    if (status == Status::OK)
+    {
+        status = AddLinear(src + head, true, dst + head, true, body, size);
+    }
+    if (status == Status::OK)
+    {
+        status = AddLinear(src + head + body, true, dst + head + body, true, tail, DataSize::BYTE);
+    }
+    return status;
+}
+
+
+Status MdmaComposer::AddLinear(Address src, bool srcIncrement, Address dst, bool dstIncrement, uint32_t bytes,
+                               DataSize size)
+{
+    Status status = Status::OK;
+    uint32_t remaining = bytes;
+    while ((status == Status::OK) && (remaining > 0U))
+    {
+        uint32_t moved = remaining;
+        if (remaining >= MdmaNode::MAX_BLOCK_BYTES)
+        {
+            // contiguous blocks, the addresses continue behind each block
+            const uint32_t repeats = std::min(remaining / MdmaNode::MAX_BLOCK_BYTES, MdmaNode::MAX_REPEATS);
+            moved = repeats * MdmaNode::MAX_BLOCK_BYTES;
+            status = AddNode(src, srcIncrement, dst, dstIncrement, size, MdmaNode::MAX_BLOCK_BYTES, repeats, 0, 0);
+        }
+        else
+        {
+            status = AddNode(src, srcIncrement, dst, dstIncrement, size, remaining, 1U, 0, 0);
+        }
+        src += srcIncrement ? moved : 0U;
+        dst += dstIncrement ? moved : 0U;
+        remaining -= moved;
+    }
+    return status;
+}
+
+
+Status MdmaComposer::AddNode(Address src, bool srcIncrement, Address dst, bool dstIncrement, DataSize size,
+                             uint32_t blockBytes, uint32_t repeats, int32_t srcUpdate, int32_t dstUpdate)
+{
+    if (mCount >= mNodes.size())
+    {
+        return Status::NO_SPACE;
+    }
+
+    MdmaNode& node = mNodes[mCount];
+    node = MdmaNode{};
+    node.ctcr = MdmaNode::Ctcr(size, srcIncrement, dstIncrement, mMode, mSoftware);
+    node.cbndtr = MdmaNode::Cbndtr(blockBytes, repeats, srcUpdate, dstUpdate);
+    node.csar = src;
+    node.cdar = dst;
+    node.cbrur = MdmaNode::Cbrur(srcUpdate, dstUpdate);
+    node.clar = EndLink();
+    node.ctbr = mRequest | (IsTcm(src) ? (1U << MdmaNode::CTBR_SBUS_POS) : 0U)
+              | (IsTcm(dst) ? (1U << MdmaNode::CTBR_DBUS_POS) : 0U);
+
+    if (mCount > 0U)
+    {
+        mNodes[mCount - 1U].clar = ToAddress(&node);
+    }
+    mCount++;
+    return Status::OK;
+}
+
+
+Status MdmaComposer::Rollback(size_t count, Status status)
+{
+    if (status != Status::OK)
+    {
+        mCount = count;
+        if (mCount > 0U)
+        {
+            mNodes[mCount - 1U].clar = EndLink();
+        }
+    }
+    return status;
+}
+
+
+Address MdmaComposer::EndLink() const
+{
+    return (mCircular && !mNodes.empty()) ? ToAddress(mNodes.data()) : 0U;
+}
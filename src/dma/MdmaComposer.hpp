@@ -0,0 +1,237 @@
+/**
+ ********************************************************************************
+ * @file        MdmaComposer.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, builder of MDMA node chains from scatter/gather descriptors.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "MdmaNode.hpp"
+#include <array>
+#include <span>
+namespace Dma {
+
+
+/**
+ * @brief   This class provides the composition of MDMA node chains (the replacement of
+ *          HAL_MDMA_LinkedList_CreateNode and HAL_MDMA_LinkedList_AddNode).
+ * @details Every operation appends nodes to the chain and links them (CLAR), @ref SetCircular links the last
+ *          node back to the first one (like HAL_MDMA_LinkedList_EnableCircularMode).
+ *          - Linear copies use the widest beat the common offset of the addresses allows, byte nodes copy
+ *            the head up to the alignment and the tail. More than @ref MdmaNode::MAX_BLOCK_BYTES are repeated blocks of a
+ *            node, @ref CopyNodes gives the worst case count at compile time.
+ *          - A 2D copy is one node per @ref MdmaNode::MAX_REPEATS lines, the block updates skip the gaps
+ *            of the strides. Gaps beyond @ref MdmaNode::MAX_UPDATE bytes need a node per line.
+ *          - Gather and scatter are a linear copy per region.
+ *          - Register transfers keep the peripheral address fixed and run on a hardware request
+ *            (@ref SetHardwareRequest).
+ *
+ *          The nodes run on the software request by default, one request moves the whole chain. The bus of
+ *          a TCM address is the AHB (SBUS, DBUS). An operation which fails leaves the chain as it was.
+ * @note    The node storage must be located in a RAM the MDMA reads (AXI SRAM, D2 SRAM, DTCM) and must not
+ *          change while a chain runs.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class MdmaComposer
+{
+    public:
+
+        /**
+         * @brief   Constructs an empty chain.
+         *
+         * @param   nodes   The node storage.
+         */
+        explicit MdmaComposer(std::span<MdmaNode> nodes) : mNodes(nodes) {};
+
+        MdmaComposer(MdmaComposer const &) = delete;             //!< Copy constructor
+        MdmaComposer& operator=(MdmaComposer const &) = delete;  //!< Copy assignment
+
+        /// @brief Worst case nodes of a linear copy.
+        static constexpr size_t CopyNodes(uint32_t bytes)
+        {
+            return (bytes / (MdmaNode::MAX_BLOCK_BYTES * MdmaNode::MAX_REPEATS)) + 4U;
+        }
+
+        /// @brief Nodes of a 2D copy whose gaps are within @ref MdmaNode::MAX_UPDATE.
+        static constexpr size_t Copy2DNodes(uint32_t lines)
+        {
+            return (lines + MdmaNode::MAX_REPEATS - 1U) / MdmaNode::MAX_REPEATS;
+        }
+
+        /// @brief Remove all nodes, the request settings stay.
+        void Clear();
+
+        /// @brief The following nodes run on the software request, one request moves the whole chain.
+        void SetSoftwareRequest();
+
+        /**
+         * @brief   The following nodes run on a hardware request.
+         *
+         * @param   request     The request line (TSEL), 0 .. @ref MdmaNode::MAX_REQUEST.
+         * @param   mode        Data per request.
+         *
+         * @return  OK, INVALID_PARAM.
+         */
+        Status SetHardwareRequest(uint8_t request, TriggerMode mode);
+
+        /**
+         * @brief   Append a linear copy.
+         *
+         * @param   pSrc    Source.
+         * @param   pDst    Destination.
+         * @param   bytes   Size in bytes, 0 appends nothing.
+         *
+         * @return  OK, INVALID_PARAM, NO_SPACE.
+         */
+        Status Copy(const void* pSrc, void* pDst, uint32_t bytes);
+
+        /**
+         * @brief   Append linear copies.
+         *
+         * @param   items   The copies.
+         *
+         * @return  OK, INVALID_PARAM, NO_SPACE.
+         */
+        Status Copy(std::span<const CopyItem> items);
+
+        /**
+         * @brief   Append a strided copy.
+         *
+         * @param   item    The copy, 1 .. @ref MdmaNode::MAX_BLOCK_BYTES per line.
+         *
+         * @return  OK, INVALID_PARAM, NO_SPACE.
+         */
+        Status Copy2D(const Copy2DItem& item);
+
+        /**
+         * @brief   Append the copies of regions into a contiguous buffer.
+         *
+         * @param   sources     The regions in order.
+         * @param   pDst        The buffer, the size of all regions.
+         *
+         * @return  OK, INVALID_PARAM, NO_SPACE.
+         */
+        Status Gather(std::span<const ConstRegion> sources, void* pDst);
+
+        /**
+         * @brief   Append the copies of a contiguous buffer into regions.
+         *
+         * @param   pSrc            The buffer, the size of all regions.
+         * @param   destinations    The regions in order.
+         *
+         * @return  OK, INVALID_PARAM, NO_SPACE.
+         */
+        Status Scatter(const void* pSrc, std::span<const Region> destinations);
+
+        /**
+         * @brief   Append the writes of a buffer into a peripheral register.
+         *
+         * @param   pSrc        The buffer, aligned to the size.
+         * @param   pRegister   The register, aligned to the size.
+         * @param   bytes       Size of the buffer, a multiple of the size.
+         * @param   size        Access size of the register.
+         *
+         * @return  OK, INVALID_PARAM, NO_SPACE.
+         */
+        Status WriteRegister(const void* pSrc, volatile void* pRegister, uint32_t bytes, DataSize size);
+
+        /**
+         * @brief   Append the reads of a peripheral register into a buffer.
+         *
+         * @param   pRegister   The register, aligned to the size.
+         * @param   pDst        The buffer, aligned to the size.
+         * @param   bytes       Size of the buffer, a multiple of the size.
+         * @param   size        Access size of the register.
+         *
+         * @return  OK, INVALID_PARAM, NO_SPACE.
+         */
+        Status ReadRegister(const volatile void* pRegister, void* pDst, uint32_t bytes, DataSize size);
+
+        /**
+         * @brief   Link the last node to the first one, the chain runs until it is aborted.
+         *
+         * @param   circular    Circular, else the chain ends with the last node.
+         */
+        void SetCircular(bool circular);
+
+        /// @brief The chain is circular.
+        bool IsCircular() const {return mCircular;};
+
+        /// @brief The nodes of the chain, the first one starts.
+        std::span<const MdmaNode> GetNodes() const {return mNodes.first(mCount);};
+
+    private:
+
+        /// @brief Append the nodes of a linear transfer with one beat size.
+        Status AddLinear(Address src, bool srcIncrement, Address dst, bool dstIncrement, uint32_t bytes, DataSize size);
+
+        /// @brief Append a linear copy between memories.
+        Status AddCopy(Address src, Address dst, uint32_t bytes);
+
+        /// @brief Append a node of repeated blocks and link it.
+        Status AddNode(Address src, bool srcIncrement, Address dst, bool dstIncrement, DataSize size,
+                       uint32_t blockBytes, uint32_t repeats, int32_t srcUpdate, int32_t dstUpdate);
+
+        /// @brief Drop the nodes behind count and close the chain again.
+        Status Rollback(size_t count, Status status);
+
+        /// @brief Link of the last node.
+        Address EndLink() const;
+
+        /// @brief The node storage.
+        std::span<MdmaNode> mNodes;
+
+        /// @brief Nodes in the chain.
+        size_t mCount{0U};
+
+        /// @brief The last node links to the first one.
+        bool mCircular{false};
+
+        /// @brief Request of the following nodes.
+        uint8_t mRequest{0U};
+
+        /// @brief Data per request of the following nodes.
+        TriggerMode mMode{TriggerMode::LINKED_LIST};
+
+        /// @brief Software request of the following nodes.
+        bool mSoftware{true};
+};
+
+
+/**
+ * @brief   This class provides a MdmaComposer with its node storage.
+ * @details Size it with @ref MdmaComposer::CopyNodes and @ref MdmaComposer::Copy2DNodes.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+template<size_t NODES>
+class MdmaChain : public MdmaComposer
+{
+    public:
+
+        /// @brief Constructor, the base only keeps the span of the storage.
+        MdmaChain() : MdmaComposer(mStorage) {};
+
+    private:
+
+        /// @brief The node storage.
+        std::array<MdmaNode, NODES> mStorage{};
+};
+
+} // end namespace Dma
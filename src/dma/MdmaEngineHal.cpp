@@ -0,0 +1,209 @@
+/**
+ ********************************************************************************
+ * @file        MdmaEngineHal.cpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, MDMA channel which runs node chains implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "MdmaEngineHal.hpp"
+#include "DCache.hpp"
+
+using namespace Dma;
+
+MdmaEngineHal* MdmaEngineHal::spInstance = nullptr;
+
+// the node must be the one the channel loads
+static_assert(sizeof(MdmaNode) == sizeof(MDMA_LinkNodeTypeDef), "MdmaNode differs from MDMA_LinkNodeTypeDef");
+static_assert(MdmaNode::CTCR_SINC_POS == MDMA_CTCR_SINC_Pos);
+static_assert(MdmaNode::CTCR_DINC_POS == MDMA_CTCR_DINC_Pos);
+static_assert(MdmaNode::CTCR_SSIZE_POS == MDMA_CTCR_SSIZE_Pos);
+static_assert(MdmaNode::CTCR_DSIZE_POS == MDMA_CTCR_DSIZE_Pos);
+static_assert(MdmaNode::CTCR_SINCOS_POS == MDMA_CTCR_SINCOS_Pos);
+static_assert(MdmaNode::CTCR_DINCOS_POS == MDMA_CTCR_DINCOS_Pos);
+static_assert(MdmaNode::CTCR_TLEN_POS == MDMA_CTCR_TLEN_Pos);
+static_assert(MdmaNode::CTCR_PKE_POS == MDMA_CTCR_PKE_Pos);
+static_assert(MdmaNode::CTCR_TRGM_POS == MDMA_CTCR_TRGM_Pos);
+static_assert(MdmaNode::CTCR_SWRM_POS == MDMA_CTCR_SWRM_Pos);
+static_assert(MdmaNode::CBNDTR_BNDT_MASK == MDMA_CBNDTR_BNDT_Msk);
+static_assert(MdmaNode::CBNDTR_BRSUM_POS == MDMA_CBNDTR_BRSUM_Pos);
+static_assert(MdmaNode::CBNDTR_BRDUM_POS == MDMA_CBNDTR_BRDUM_Pos);
+static_assert(MdmaNode::CBNDTR_BRC_POS == MDMA_CBNDTR_BRC_Pos);
+static_assert(MdmaNode::CBRUR_SUV_POS == MDMA_CBRUR_SUV_Pos);
+static_assert(MdmaNode::CBRUR_DUV_POS == MDMA_CBRUR_DUV_Pos);
+static_assert(MdmaNode::CTBR_TSEL_MASK == MDMA_CTBR_TSEL_Msk);
+static_assert(MdmaNode::CTBR_SBUS_POS == MDMA_CTBR_SBUS_Pos);
+static_assert(MdmaNode::CTBR_DBUS_POS == MDMA_CTBR_DBUS_Pos);
+
+namespace {
+
+/// @brief D-Cache operation on a range.
+using CacheOperation = void (*)(const void* p, uint32_t len);
+
+/// @brief Apply an operation to the source (else the destination) extents of the nodes in memory.
+void CacheNodes(std::span<const MdmaNode> nodes, bool source, CacheOperation operation)
+{
+    for (const MdmaNode& node : nodes)
+    {
+        if (node.GetAddressMode(source) != MdmaNode::FIXED)
+        {
+            Address begin = 0U;
+            Address end = 0U;
+            node.GetExtent(source, &begin, &end);
+            operation(reinterpret_cast<const void*>(begin), static_cast<uint32_t>(end - begin));
+        }
+    }
+}
+
+bool IsCircular(std::span<const MdmaNode> nodes)
+{
+    for (const MdmaNode& node : nodes)
+    {
+        if (node.clar == reinterpret_cast<Address>(nodes.data()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CompleteCallback(MDMA_HandleTypeDef* hmdma)
+{
+    MdmaEngineHal* pEngine = MdmaEngineHal::GetInstance(hmdma);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnComplete();
+    }
+}
+
+void ErrorCallback(MDMA_HandleTypeDef* hmdma)
+{
+    MdmaEngineHal* pEngine = MdmaEngineHal::GetInstance(hmdma);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnError();
+    }
+}
+
+} // end anonymous namespace
+
+
+MdmaEngineHal::MdmaEngineHal(MDMA_HandleTypeDef& hmdma)
+: mHmdma(hmdma)
+{
+    spInstance = this;
+}
+
+
+MdmaEngineHal::~MdmaEngineHal()
+{
+    Abort();
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+MdmaEngineHal* MdmaEngineHal::GetInstance(const MDMA_HandleTypeDef* hmdma)
+{
+    if ((spInstance != nullptr) && (hmdma == &spInstance->mHmdma))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status MdmaEngineHal::Start(std::span<const MdmaNode> nodes)
+{
+    if (nodes.empty())
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mBusy || (mHmdma.State != HAL_MDMA_STATE_READY))
+    {
+        return Status::BUSY;
+    }
+    if ((HAL_MDMA_RegisterCallback(&mHmdma, HAL_MDMA_XFER_CPLT_CB_ID, CompleteCallback) != HAL_OK)
+        || (HAL_MDMA_RegisterCallback(&mHmdma, HAL_MDMA_XFER_ERROR_CB_ID, ErrorCallback) != HAL_OK))
+    {
+        return Status::HW_ERROR;
+    }
+
+    // the channel reads the nodes and the sources from the memory
+    Utils::DCache::Clean(nodes.data(), static_cast<uint32_t>(nodes.size_bytes()));
+    CacheNodes(nodes, true, &Utils::DCache::Clean);
+    CacheNodes(nodes, false, &Utils::DCache::CleanInvalidate);
+    mNodes = IsCircular(nodes) ? std::span<const MdmaNode>{} : nodes;
+    mBusy = true;
+
+    // the first node goes into the registers, the channel loads the others
+    const MdmaNode& first = nodes.front();
+    MDMA_Channel_TypeDef* pChannel = mHmdma.Instance;
+    __HAL_MDMA_DISABLE(&mHmdma);
+    __HAL_MDMA_CLEAR_FLAG(&mHmdma, MDMA_FLAG_TE | MDMA_FLAG_CTC | MDMA_FLAG_BRT | MDMA_FLAG_BT | MDMA_FLAG_BFTC);
+    pChannel->CTCR = first.ctcr;
+    pChannel->CBNDTR = first.cbndtr;
+    pChannel->CSAR = first.csar;
+    pChannel->CDAR = first.cdar;
+    pChannel->CBRUR = first.cbrur;
+    pChannel->CLAR = first.clar;
+    pChannel->CTBR = first.ctbr;
+    pChannel->CMAR = first.cmar;
+    pChannel->CMDR = first.cmdr;
+
+    mHmdma.ErrorCode = HAL_MDMA_ERROR_NONE;
+    mHmdma.State = HAL_MDMA_STATE_BUSY;
+    __HAL_MDMA_ENABLE_IT(&mHmdma, MDMA_IT_TE | MDMA_IT_CTC);
+    __HAL_MDMA_ENABLE(&mHmdma);
+    if (first.IsSoftware())
+    {
+        SET_BIT(pChannel->CCR, MDMA_CCR_SWRQ);
+    }
+    return Status::OK;
+}
+
+
+void MdmaEngineHal::Abort()
+{
+    if (mBusy)
+    {
+        (void)HAL_MDMA_Abort(&mHmdma);
+        mBusy = false;
+    }
+}
+
+
+void MdmaEngineHal::OnComplete()
+{
+    InvalidateDestinations();
+    mBusy = false;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnComplete(Status::OK);
+    }
+}
+
+
+void MdmaEngineHal::OnError()
+{
+    InvalidateDestinations();
+    mBusy = false;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnComplete(Status::HW_ERROR);
+    }
+}
+
+
+void MdmaEngineHal::InvalidateDestinations() const
+{
+    // lines fetched by speculative reads while the channel wrote
+    CacheNodes(mNodes, false, &Utils::DCache::Invalidate);
+}
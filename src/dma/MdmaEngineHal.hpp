@@ -0,0 +1,101 @@
+/**
+ ********************************************************************************
+ * @file        MdmaEngineHal.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, MDMA channel which runs node chains.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IMdmaEngine.hpp"
+#include "stm32h7xx_hal.h"
+namespace Dma {
+
+
+/**
+ * @brief   This class provides the IMdmaEngine on a MDMA channel of the STM32H7.
+ * @details @ref Start writes the first node into the channel registers, the following nodes are loaded by
+ *          the channel from their links. This replaces HAL_MDMA_Start_IT, which takes the first transfer from
+ *          the Init fields of the handle, so the whole chain comes from the composer. The channel keeps the
+ *          priority and the endianness of HAL_MDMA_Init, the end of the chain (CTCIF) and the errors (TEIF)
+ *          are handled by HAL_MDMA_IRQHandler and reported through the registered callbacks.\n
+ *          Before the start the D-Cache lines of the nodes and of the sources are cleaned, the lines of the
+ *          destinations are cleaned and invalidated, after the completion they are invalidated again. The
+ *          extents of the nodes give the ranges, a fixed address (a register) is skipped. A circular chain
+ *          gets no invalidation, its user does it.
+ * @note    The application initialises the channel (HAL_MDMA_Init, the request and the transfer fields of
+ *          the Init are overwritten by the nodes), enables its interrupt and calls HAL_MDMA_IRQHandler.
+ *          One instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to make sure a clean access in one context.
+ *
+ */
+class MdmaEngineHal : public IMdmaEngine
+{
+    public:
+
+        /**
+         * @brief   Constructs the engine for an initialised handle.
+         *
+         * @param   hmdma       The MDMA channel.
+         */
+        explicit MdmaEngineHal(MDMA_HandleTypeDef& hmdma);
+
+        /// @brief Destructor.
+        ~MdmaEngineHal() override;
+
+        MdmaEngineHal(MdmaEngineHal const &) = delete;             //!< Copy constructor
+        MdmaEngineHal& operator=(MdmaEngineHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc IMdmaEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IMdmaEngine::Start
+        Status Start(std::span<const MdmaNode> nodes) override;
+
+        /// @copydoc IMdmaEngine::Abort
+        void Abort() override;
+
+        /// @copydoc IMdmaEngine::IsBusy
+        bool IsBusy() const override {return mBusy;};
+
+        /// @brief Chain done, called by the transfer complete callback.
+        void OnComplete();
+
+        /// @brief Transfer error, called by the error callback.
+        void OnError();
+
+        /// @brief Engine bound to a MDMA handle or nullptr.
+        static MdmaEngineHal* GetInstance(const MDMA_HandleTypeDef* hmdma);
+
+    private:
+
+        /// @brief Invalidate the D-Cache lines of the destinations of the running chain.
+        void InvalidateDestinations() const;
+
+        /// @brief The MDMA channel.
+        MDMA_HandleTypeDef& mHmdma;
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief The running chain.
+        std::span<const MdmaNode> mNodes{};
+
+        /// @brief Set while a chain runs.
+        volatile bool mBusy{false};
+
+        /// @brief The single engine instance.
+        static MdmaEngineHal* spInstance;
+};
+
+} // end namespace Dma
@@ -0,0 +1,227 @@
+/**
+ ********************************************************************************
+ * @file        MdmaNode.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, linked list node of the MDMA and its register fields.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DmaTypes.hpp"
+#include <algorithm>
+#include <cstdint>
+namespace Dma {
+
+
+/// @brief Size of a single transfer (a beat).
+enum class DataSize : uint8_t
+{
+    BYTE=0,         //!< 8 bit
+    HALF_WORD=1,    //!< 16 bit
+    WORD=2,         //!< 32 bit
+    DOUBLE_WORD=3   //!< 64 bit
+};
+
+/// @brief The amount of data moved per request (TRGM).
+enum class TriggerMode : uint8_t
+{
+    BUFFER=0,           //!< One buffer of @ref MdmaNode::BUFFER_BYTES
+    BLOCK=1,            //!< One block
+    REPEATED_BLOCK=2,   //!< All repeated blocks of a node
+    LINKED_LIST=3       //!< The whole chain
+};
+
+/**
+ * @brief   This struct provides a node of a MDMA linked list, the register values of the channel for one transfer.
+ * @details The layout is the one of MDMA_LinkNodeTypeDef (ten words on the target), the channel loads the
+ *          node from the address in CLAR when the previous transfer is done. A node moves @ref Repeats blocks
+ *          of @ref BlockBytes bytes, after each block the addresses move by the update values (CBRUR), a
+ *          fixed address (a peripheral register) stays.\n
+ *          The field positions are the ones of RM0433, MdmaEngineHal checks them against the CMSIS header.
+ *          On the host the address fields hold pointers, so the node is larger there.
+ *  - - -
+ *
+ * __Thread safety:__
+ * A node must not be changed while the MDMA may load it.
+ *
+ */
+struct alignas(8) MdmaNode
+{
+    uint32_t ctcr;      //!< Transfer configuration
+    uint32_t cbndtr;    //!< Block bytes, repeat count and update directions
+    Address csar;       //!< Source address
+    Address cdar;       //!< Destination address
+    uint32_t cbrur;     //!< Block repeat address update values
+    Address clar;       //!< Next node or 0 at the end of the chain
+    uint32_t ctbr;      //!< Trigger request and bus selection
+    uint32_t reserved;  //!< Reserved, 0
+    uint32_t cmar;      //!< Mask address, 0
+    uint32_t cmdr;      //!< Mask data, 0
+
+    /// @brief Maximum bytes of a block (BNDT).
+    static constexpr uint32_t MAX_BLOCK_BYTES{65536U};
+
+    /// @brief Maximum blocks of a node (BRC + 1).
+    static constexpr uint32_t MAX_REPEATS{4096U};
+
+    /// @brief Maximum magnitude of an address update after a block (SUV, DUV).
+    static constexpr uint32_t MAX_UPDATE{65535U};
+
+    /// @brief Bytes of a buffer transfer (TLEN + 1).
+    static constexpr uint32_t BUFFER_BYTES{128U};
+
+    /// @brief Highest trigger request (TSEL).
+    static constexpr uint8_t MAX_REQUEST{63U};
+
+    static constexpr uint32_t FIXED{0U};      //!< Address mode of SINC and DINC: fixed
+    static constexpr uint32_t INCREMENT{2U};  //!< Address mode of SINC and DINC: incremented
+    static constexpr uint32_t DECREMENT{3U};  //!< Address mode of SINC and DINC: decremented
+
+    /// @brief CTCR fields.
+    static constexpr uint32_t CTCR_SINC_POS{0U};
+    static constexpr uint32_t CTCR_DINC_POS{2U};
+    static constexpr uint32_t CTCR_SSIZE_POS{4U};
+    static constexpr uint32_t CTCR_DSIZE_POS{6U};
+    static constexpr uint32_t CTCR_SINCOS_POS{8U};
+    static constexpr uint32_t CTCR_DINCOS_POS{10U};
+    static constexpr uint32_t CTCR_TLEN_POS{18U};
+    static constexpr uint32_t CTCR_PKE_POS{25U};
+    static constexpr uint32_t CTCR_TRGM_POS{28U};
+    static constexpr uint32_t CTCR_SWRM_POS{30U};
+
+    /// @brief CBNDTR fields.
+    static constexpr uint32_t CBNDTR_BNDT_MASK{0x1FFFFU};
+    static constexpr uint32_t CBNDTR_BRSUM_POS{18U};
+    static constexpr uint32_t CBNDTR_BRDUM_POS{19U};
+    static constexpr uint32_t CBNDTR_BRC_POS{20U};
+
+    /// @brief CBRUR fields.
+    static constexpr uint32_t CBRUR_SUV_POS{0U};
+    static constexpr uint32_t CBRUR_DUV_POS{16U};
+
+    /// @brief CTBR fields.
+    static constexpr uint32_t CTBR_TSEL_MASK{0xFFU};
+    static constexpr uint32_t CTBR_SBUS_POS{16U};
+    static constexpr uint32_t CTBR_DBUS_POS{17U};
+
+    /**
+     * @brief   The transfer configuration.
+     *
+     * @param   size            Beat size of both sides, the addresses step by it.
+     * @param   srcIncrement    The source increments, else it is fixed.
+     * @param   dstIncrement    The destination increments, else it is fixed.
+     * @param   mode            Data per request.
+     * @param   software        Software request (SWRQ), else the request of CTBR.
+     *
+     * @return  The CTCR value.
+     */
+    static constexpr uint32_t Ctcr(DataSize size, bool srcIncrement, bool dstIncrement, TriggerMode mode, bool software)
+    {
+        const uint32_t bits = static_cast<uint32_t>(size);
+        return ((srcIncrement ? INCREMENT : FIXED) << CTCR_SINC_POS)
+             | ((dstIncrement ? INCREMENT : FIXED) << CTCR_DINC_POS)
+             | (bits << CTCR_SSIZE_POS) | (bits << CTCR_DSIZE_POS)
+             | (bits << CTCR_SINCOS_POS) | (bits << CTCR_DINCOS_POS)
+             | ((BUFFER_BYTES - 1U) << CTCR_TLEN_POS)
+             | (static_cast<uint32_t>(mode) << CTCR_TRGM_POS)
+             | ((software ? 1U : 0U) << CTCR_SWRM_POS);
+    }
+
+    /**
+     * @brief   The block configuration.
+     *
+     * @param   blockBytes  Bytes per block, 1 .. @ref MAX_BLOCK_BYTES.
+     * @param   repeats     Blocks, 1 .. @ref MAX_REPEATS.
+     * @param   srcUpdate   Source address move after a block, +-@ref MAX_UPDATE.
+     * @param   dstUpdate   Destination address move after a block, +-@ref MAX_UPDATE.
+     *
+     * @return  The CBNDTR value.
+     */
+    static constexpr uint32_t Cbndtr(uint32_t blockBytes, uint32_t repeats, int32_t srcUpdate, int32_t dstUpdate)
+    {
+        return (blockBytes & CBNDTR_BNDT_MASK)
+             | ((srcUpdate < 0) ? (1U << CBNDTR_BRSUM_POS) : 0U)
+             | ((dstUpdate < 0) ? (1U << CBNDTR_BRDUM_POS) : 0U)
+             | ((repeats - 1U) << CBNDTR_BRC_POS);
+    }
+
+    /// @brief The update values of @ref Cbndtr.
+    static constexpr uint32_t Cbrur(int32_t srcUpdate, int32_t dstUpdate)
+    {
+        const uint32_t src = static_cast<uint32_t>((srcUpdate < 0) ? -srcUpdate : srcUpdate);
+        const uint32_t dst = static_cast<uint32_t>((dstUpdate < 0) ? -dstUpdate : dstUpdate);
+        return (src << CBRUR_SUV_POS) | (dst << CBRUR_DUV_POS);
+    }
+
+    /// @brief Bytes per block.
+    uint32_t BlockBytes() const {return cbndtr & CBNDTR_BNDT_MASK;};
+
+    /// @brief Blocks of the node.
+    uint32_t Repeats() const {return (cbndtr >> CBNDTR_BRC_POS) + 1U;};
+
+    /// @brief Data per request.
+    TriggerMode GetTriggerMode() const {return static_cast<TriggerMode>((ctcr >> CTCR_TRGM_POS) & 3U);};
+
+    /// @brief Software request.
+    bool IsSoftware() const {return ((ctcr >> CTCR_SWRM_POS) & 1U) != 0U;};
+
+    /// @brief Trigger request.
+    uint8_t GetRequest() const {return static_cast<uint8_t>(ctbr & CTBR_TSEL_MASK);};
+
+    /// @brief Beat size of the source (else of the destination).
+    DataSize GetSize(bool source) const
+    {
+        return static_cast<DataSize>((ctcr >> (source ? CTCR_SSIZE_POS : CTCR_DSIZE_POS)) & 3U);
+    }
+
+    /// @brief Address mode of the source (else of the destination), @ref FIXED, @ref INCREMENT, @ref DECREMENT.
+    uint32_t GetAddressMode(bool source) const {return (ctcr >> (source ? CTCR_SINC_POS : CTCR_DINC_POS)) & 3U;};
+
+    /// @brief Signed address step per beat of the source (else of the destination).
+    int64_t GetStep(bool source) const
+    {
+        const int64_t offset = int64_t{1} << ((ctcr >> (source ? CTCR_SINCOS_POS : CTCR_DINCOS_POS)) & 3U);
+        const uint32_t mode = GetAddressMode(source);
+        return (mode == INCREMENT) ? offset : ((mode == DECREMENT) ? -offset : 0);
+    }
+
+    /// @brief Signed address move after a block of the source (else of the destination).
+    int64_t GetUpdate(bool source) const
+    {
+        const int64_t value = (cbrur >> (source ? CBRUR_SUV_POS : CBRUR_DUV_POS)) & 0xFFFFU;
+        const bool subtract = ((cbndtr >> (source ? CBNDTR_BRSUM_POS : CBNDTR_BRDUM_POS)) & 1U) != 0U;
+        return subtract ? -value : value;
+    }
+
+    /**
+     * @brief   The memory touched by the source (else by the destination), from the lowest to behind the
+     *          highest byte. The cache maintenance of the transfer covers it.
+     *
+     * @param   source      The source, else the destination.
+     * @param   pBegin      Lowest address.
+     * @param   pEnd        Behind the highest byte.
+     */
+    void GetExtent(bool source, Address* pBegin, Address* pEnd) const
+    {
+        const int64_t size = int64_t{1} << static_cast<uint32_t>(GetSize(source));
+        const int64_t step = GetStep(source);
+        const int64_t beats = BlockBytes() / size;
+        // the blocks move linearly, the first and the last one bound the extent
+        const int64_t blockMove = (beats * step) + GetUpdate(source);
+        const int64_t last = (Repeats() - 1) * blockMove;
+        const int64_t inBlock = (beats - 1) * step;
+        const int64_t low = std::min<int64_t>(0, inBlock) + std::min<int64_t>(0, last);
+        const int64_t high = std::max<int64_t>(0, inBlock) + std::max<int64_t>(0, last) + size;
+        const Address base = source ? csar : cdar;
+        *pBegin = static_cast<Address>(static_cast<int64_t>(base) + low);
+        *pEnd = static_cast<Address>(static_cast<int64_t>(base) + high);
+    }
+};
+
+} // end namespace Dma
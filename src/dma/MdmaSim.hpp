@@ -0,0 +1,180 @@
+/**
+ ********************************************************************************
+ * @file        MdmaSim.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, host simulation of a MDMA channel.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IMdmaEngine.hpp"
+#include <cstring>
+namespace Dma {
+
+
+/**
+ * @brief   This class provides an IMdmaEngine which executes the node chains on the host memory.
+ * @details @ref Execute interprets the register values of a node like the channel: beats of SSIZE from the
+ *          source to the destination, the addresses step by SINCOS and DINCOS (or stay fixed), after each
+ *          block they move by the update values. The checks of the hardware are errors: a block which is
+ *          no multiple of the beats, a misaligned address. Packing (different sizes) is not modelled.
+ *          Requests are not modelled, @ref Run executes the nodes one after another.\n
+ *          The engine side (@ref Run) reports the completion synchronously like the interrupt,
+ *          @ref InjectFault models a transfer error.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * @ref Run may run in another thread (the simulated interrupt context) while no Start or Abort is called.
+ *
+ */
+class MdmaSim : public IMdmaEngine
+{
+    public:
+
+        /// @brief Constructor.
+        MdmaSim() = default;
+
+        MdmaSim(MdmaSim const &) = delete;             //!< Copy constructor
+        MdmaSim& operator=(MdmaSim const &) = delete;  //!< Copy assignment
+
+        /// @copydoc IMdmaEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IMdmaEngine::Start
+        Status Start(std::span<const MdmaNode> nodes) override
+        {
+            if (mpNode != nullptr)
+            {
+                return Status::BUSY;
+            }
+            if (nodes.empty())
+            {
+                return Status::INVALID_PARAM;
+            }
+            mpNode = nodes.data();
+            mStarts++;
+            return Status::OK;
+        }
+
+        /// @copydoc IMdmaEngine::Abort
+        void Abort() override {mpNode = nullptr;};
+
+        /// @copydoc IMdmaEngine::IsBusy
+        bool IsBusy() const override {return mpNode != nullptr;};
+
+        /// @brief The next transfer fails.
+        void InjectFault() {mFault = true;};
+
+        /**
+         * @brief   Engine side: execute nodes of the running chain.
+         *
+         * @param   maxNodes    Maximum count of nodes, limits a circular chain.
+         *
+         * @return  Count of executed nodes.
+         */
+        size_t Run(size_t maxNodes = SIZE_MAX)
+        {
+            size_t executed = 0U;
+            while ((mpNode != nullptr) && (executed < maxNodes))
+            {
+                Status status = mFault ? Status::HW_ERROR : Execute(*mpNode);
+                mFault = false;
+                executed++;
+                mNodes++;
+                if (status == Status::OK)
+                {
+                    mBytes += static_cast<uint64_t>(mpNode->BlockBytes()) * mpNode->Repeats();
+                    mpNode = reinterpret_cast<const MdmaNode*>(mpNode->clar);
+                    if (mpNode != nullptr)
+                    {
+                        continue;
+                    }
+                }
+                mpNode = nullptr;
+                if (mpListener != nullptr)
+                {
+                    mpListener->OnComplete(status);
+                }
+            }
+            return executed;
+        }
+
+        /**
+         * @brief   Execute the transfer of one node.
+         *
+         * @param   node    The node.
+         *
+         * @return  OK, HW_ERROR (the channel would report a transfer error).
+         */
+        static Status Execute(const MdmaNode& node)
+        {
+            const DataSize size = node.GetSize(true);
+            const uint32_t beat = 1U << static_cast<uint32_t>(size);
+            const uint32_t blockBytes = node.BlockBytes();
+            if ((size != node.GetSize(false)) || (((node.ctcr >> MdmaNode::CTCR_PKE_POS) & 1U) != 0U)
+                || (blockBytes == 0U) || ((blockBytes % beat) != 0U)
+                || (node.GetAddressMode(true) == 1U) || (node.GetAddressMode(false) == 1U))
+            {
+                return Status::HW_ERROR;
+            }
+
+            Address src = node.csar;
+            Address dst = node.cdar;
+            const int64_t srcStep = node.GetStep(true);
+            const int64_t dstStep = node.GetStep(false);
+            for (uint32_t block = 0U; block < node.Repeats(); block++)
+            {
+                for (uint32_t i = 0U; i < (blockBytes / beat); i++)
+                {
+                    if (((src % beat) != 0U) || ((dst % beat) != 0U))
+                    {
+                        return Status::HW_ERROR;
+                    }
+                    std::memmove(reinterpret_cast<void*>(dst), reinterpret_cast<const void*>(src), beat);
+                    src = static_cast<Address>(static_cast<int64_t>(src) + srcStep);
+                    dst = static_cast<Address>(static_cast<int64_t>(dst) + dstStep);
+                }
+                src = static_cast<Address>(static_cast<int64_t>(src) + node.GetUpdate(true));
+                dst = static_cast<Address>(static_cast<int64_t>(dst) + node.GetUpdate(false));
+            }
+            return Status::OK;
+        }
+
+        /// @brief Started chains.
+        uint32_t GetStarts() const {return mStarts;};
+
+        /// @brief Executed nodes.
+        uint64_t GetNodes() const {return mNodes;};
+
+        /// @brief Moved bytes.
+        uint64_t GetBytes() const {return mBytes;};
+
+    private:
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief Next node of the running chain, nullptr if idle.
+        const MdmaNode* mpNode{nullptr};
+
+        /// @brief The next transfer fails.
+        bool mFault{false};
+
+        /// @brief Started chains.
+        uint32_t mStarts{0U};
+
+        /// @brief Executed nodes.
+        uint64_t mNodes{0U};
+
+        /// @brief Moved bytes.
+        uint64_t mBytes{0U};
+};
+
+} // end namespace Dma
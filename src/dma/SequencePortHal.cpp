@@ -0,0 +1,290 @@
+/**
+ ********************************************************************************
+ * @file        SequencePortHal.cpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, DMA stream paced by the DMAMUX1 implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SequencePortHal.hpp"
+#include "DCache.hpp"
+
+using namespace Dma;
+
+std::array<SequencePortHal*, SequencePortHal::MAX_PORTS> SequencePortHal::spInstances{};
+
+namespace {
+
+/// @brief Errors of the DMAMUX and the FIFO, the stream continues.
+constexpr uint32_t OVERRUN_ERRORS{HAL_DMA_ERROR_SYNC | HAL_DMA_ERROR_REQGEN | HAL_DMA_ERROR_FE};
+
+uint32_t GeneratorPolarity(Edge edge)
+{
+    switch (edge)
+    {
+        case Edge::FALLING:
+            return HAL_DMAMUX_REQ_GEN_FALLING;
+        case Edge::BOTH:
+            return HAL_DMAMUX_REQ_GEN_RISING_FALLING;
+        default:
+            return HAL_DMAMUX_REQ_GEN_RISING;
+    }
+}
+
+uint32_t SyncPolarity(Edge edge)
+{
+    switch (edge)
+    {
+        case Edge::FALLING:
+            return HAL_DMAMUX_SYNC_FALLING;
+        case Edge::BOTH:
+            return HAL_DMAMUX_SYNC_RISING_FALLING;
+        default:
+            return HAL_DMAMUX_SYNC_RISING;
+    }
+}
+
+void HalfCallback(DMA_HandleTypeDef* hdma)
+{
+    SequencePortHal* pPort = SequencePortHal::GetInstance(hdma);
+    if (pPort != nullptr)
+    {
+        pPort->OnHalf();
+    }
+}
+
+void CompleteCallback(DMA_HandleTypeDef* hdma)
+{
+    SequencePortHal* pPort = SequencePortHal::GetInstance(hdma);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+void ErrorCallback(DMA_HandleTypeDef* hdma)
+{
+    SequencePortHal* pPort = SequencePortHal::GetInstance(hdma);
+    if (pPort != nullptr)
+    {
+        pPort->OnError();
+    }
+}
+
+} // end anonymous namespace
+
+
+SequencePortHal::SequencePortHal(DMA_HandleTypeDef& hdma)
+: mHdma(hdma)
+{
+    for (SequencePortHal*& pInstance : spInstances)
+    {
+        if (pInstance == nullptr)
+        {
+            pInstance = this;
+            break;
+        }
+    }
+}
+
+
+SequencePortHal::~SequencePortHal()
+{
+    Stop();
+    for (SequencePortHal*& pInstance : spInstances)
+    {
+        if (pInstance == this)
+        {
+            pInstance = nullptr;
+        }
+    }
+}
+
+
+SequencePortHal* SequencePortHal::GetInstance(const DMA_HandleTypeDef* hdma)
+{
+    for (SequencePortHal* pInstance : spInstances)
+    {
+        if ((pInstance != nullptr) && (hdma == &pInstance->mHdma))
+        {
+            return pInstance;
+        }
+    }
+    return nullptr;
+}
+
+
+Status SequencePortHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+Status SequencePortHal::Start(const Track& track)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if (!track.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+    mTrack = track;
+
+    HAL_StatusTypeDef result = Configure(track);
+    if (result == HAL_OK)
+    {
+        // the stream reads the words from the memory
+        Utils::DCache::Clean(track.words.data(), static_cast<uint32_t>(track.words.size_bytes()));
+        mRunning = true;
+        result = HAL_DMA_Start_IT(&mHdma, reinterpret_cast<uint32_t>(track.words.data()),
+                                  reinterpret_cast<uint32_t>(track.pTarget), static_cast<uint32_t>(track.words.size()));
+    }
+    if ((result == HAL_OK) && (track.pacing == Pacing::GENERATOR))
+    {
+        result = HAL_DMAEx_EnableMuxRequestGenerator(&mHdma);
+    }
+    if (result != HAL_OK)
+    {
+        Stop();
+    }
+    return ToStatus(result);
+}
+
+
+HAL_StatusTypeDef SequencePortHal::Configure(const Track& track)
+{
+    mHdma.Init.Request = (track.pacing == Pacing::GENERATOR) ? (DMA_REQUEST_GENERATOR0 + track.request) : track.request;
+    mHdma.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    mHdma.Init.PeriphInc = DMA_PINC_DISABLE;
+    mHdma.Init.MemInc = DMA_MINC_ENABLE;
+    mHdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    mHdma.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    mHdma.Init.Mode = track.loop ? DMA_CIRCULAR : DMA_NORMAL;
+
+    HAL_StatusTypeDef result = HAL_DMA_DeInit(&mHdma);
+    if (result == HAL_OK)
+    {
+        result = HAL_DMA_Init(&mHdma);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_DMA_RegisterCallback(&mHdma, HAL_DMA_XFER_CPLT_CB_ID, CompleteCallback);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_DMA_RegisterCallback(&mHdma, HAL_DMA_XFER_ERROR_CB_ID, ErrorCallback);
+    }
+    if (result == HAL_OK)
+    {
+        // the half transfer interrupt is enabled for a registered callback only
+        result = track.loop ? HAL_DMA_RegisterCallback(&mHdma, HAL_DMA_XFER_HALFCPLT_CB_ID, HalfCallback)
+                            : HAL_DMA_UnRegisterCallback(&mHdma, HAL_DMA_XFER_HALFCPLT_CB_ID);
+    }
+    if (result == HAL_OK)
+    {
+        if (track.pacing == Pacing::GENERATOR)
+        {
+            HAL_DMA_MuxRequestGeneratorConfigTypeDef generator{};
+            generator.SignalID = track.signal;
+            generator.Polarity = GeneratorPolarity(track.edge);
+            generator.RequestNumber = track.requestsPerEvent;
+            result = HAL_DMAEx_ConfigMuxRequestGenerator(&mHdma, &generator);
+        }
+        else
+        {
+            HAL_DMA_MuxSyncConfigTypeDef sync{};
+            sync.SyncSignalID = track.signal;
+            sync.SyncPolarity = SyncPolarity(track.edge);
+            sync.SyncEnable = ENABLE;
+            sync.EventEnable = DISABLE;
+            sync.RequestNumber = track.requestsPerEvent;
+            result = HAL_DMAEx_ConfigMuxSync(&mHdma, &sync);
+        }
+    }
+    return result;
+}
+
+
+void SequencePortHal::Stop()
+{
+    if (mRunning)
+    {
+        mRunning = false;
+        if (mTrack.pacing == Pacing::GENERATOR)
+        {
+            (void)HAL_DMAEx_DisableMuxRequestGenerator(&mHdma);
+        }
+        (void)HAL_DMA_Abort(&mHdma);
+    }
+}
+
+
+void SequencePortHal::OnHalf()
+{
+    if (mRunning && (mpListener != nullptr))
+    {
+        mpListener->OnHalf(0U);
+    }
+}
+
+
+void SequencePortHal::OnComplete()
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    if (mTrack.loop)
+    {
+        if (mpListener != nullptr)
+        {
+            mpListener->OnHalf(1U);
+        }
+        return;
+    }
+    Stop();
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone();
+    }
+}
+
+
+void SequencePortHal::OnError()
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    const uint32_t errors = mHdma.ErrorCode;
+    if ((errors & ~OVERRUN_ERRORS) == 0U)
+    {
+        // the stream continues, the flags are reported once
+        mHdma.ErrorCode = HAL_DMA_ERROR_NONE;
+        if (mpListener != nullptr)
+        {
+            mpListener->OnError(Status::OVERRUN);
+        }
+        return;
+    }
+    Stop();
+    if (mpListener != nullptr)
+    {
+        mpListener->OnError(Status::HW_ERROR);
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ ********************************************************************************
+ * @file        SequencePortHal.hpp
+ *
+ * @namespace   Dma
+ *
+ * @brief       Dma, DMA stream paced by the DMAMUX1.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISequencePort.hpp"
+#include "stm32h7xx_hal.h"
+#include <array>
+namespace Dma {
+
+
+/**
+ * @brief   This class provides the ISequencePort on a DMA1/DMA2 stream of the STM32H7.
+ * @details @ref Start initialises the stream for word writes from memory into a fixed register, in circular
+ *          mode for a looping track, and routes its request through the DMAMUX1:
+ *          - Pacing::GENERATOR: the request of the stream is DMA_REQUEST_GENERATORn, the generator is set by
+ *            HAL_DMAEx_ConfigMuxRequestGenerator (signal, polarity, requests) and enabled.
+ *          - Pacing::SYNCHRONIZED: the request of the stream is the peripheral request, HAL_DMAEx_ConfigMuxSync
+ *            lets the requests per event pass after each signal event.
+ *
+ *          The D-Cache lines of the words are cleaned before the start, the refill of a looping track
+ *          must clean its half. The overrun flags of the DMAMUX come through HAL_DMAEx_MUX_IRQHandler and
+ *          are reported as OVERRUN, a transfer error stops the stream (HW_ERROR).
+ * @note    The application links the handle to a stream (Instance), sets the priority and the FIFO mode,
+ *          enables the stream and the DMAMUX1_OVR interrupts and calls HAL_DMA_IRQHandler and
+ *          HAL_DMAEx_MUX_IRQHandler for every port. The pacing signal (LPTIM, TIM12) is configured and
+ *          started by the application. Up to @ref MAX_PORTS instances are supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one DmaSequencer.
+ *
+ */
+class SequencePortHal : public ISequencePort
+{
+    public:
+
+        /// @brief Maximum instances, the streams of DMA1 and DMA2.
+        static constexpr uint8_t MAX_PORTS{16U};
+
+        /**
+         * @brief   Constructs the port for a DMA stream.
+         *
+         * @param   hdma    The DMA handle.
+         */
+        explicit SequencePortHal(DMA_HandleTypeDef& hdma);
+
+        /// @brief Destructor.
+        ~SequencePortHal() override;
+
+        SequencePortHal(SequencePortHal const &) = delete;             //!< Copy constructor
+        SequencePortHal& operator=(SequencePortHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc ISequencePort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ISequencePort::Start
+        Status Start(const Track& track) override;
+
+        /// @copydoc ISequencePort::Stop
+        void Stop() override;
+
+        /// @brief Half transfer, called by the half transfer callback.
+        void OnHalf();
+
+        /// @brief Transfer complete, called by the transfer complete callback.
+        void OnComplete();
+
+        /// @brief Stream or DMAMUX error, called by the error callback.
+        void OnError();
+
+        /// @brief Port bound to a DMA handle or nullptr.
+        static SequencePortHal* GetInstance(const DMA_HandleTypeDef* hdma);
+
+    private:
+
+        /// @brief Initialise the stream and the DMAMUX channel for a track.
+        HAL_StatusTypeDef Configure(const Track& track);
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The DMA handle.
+        DMA_HandleTypeDef& mHdma;
+
+        /// @brief Receiver of the stream events.
+        IListener* mpListener{nullptr};
+
+        /// @brief The running track.
+        Track mTrack{};
+
+        /// @brief Set while the stream runs.
+        volatile bool mRunning{false};
+
+        /// @brief The instances.
+        static std::array<SequencePortHal*, MAX_PORTS> spInstances;
+};
+
+} // end namespace Dma
@@ -0,0 +1,271 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../DmaSequencer.hpp"
+#include "../DmaMuxSim.hpp"
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Dma;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  PlaysAGpioPatternOnTheGenerator
+*   (0)  BurstsPerEventAndLoops
+*   (0)  SynchronizesPeripheralRequestsAndAlignsTracks
+*   (0)  ReportsOverrunsAndStopsOnFaults
+*   (0)  RejectsInvalidTracks
+*/
+
+namespace {
+
+/// @brief DMAMUX1 signal LPTIM1 OUT.
+constexpr uint8_t LPTIM1_OUT{3U};
+
+/// @brief DMAMUX1 signal TIM12 TRGO.
+constexpr uint8_t TIM12_TRGO{7U};
+
+/// @brief Request of the DAC channel 1 (DMA_REQUEST_DAC1).
+constexpr uint8_t DAC1_REQUEST{67U};
+
+/// @brief Listener which records the sequence events.
+class Events : public DmaSequencer::IListener
+{
+    public:
+        void OnTrackHalf(uint8_t track, uint8_t half) override {mHalves.push_back((track * 2U) + half);};
+        void OnSequenceDone() override {mDone++;};
+        void OnSequenceError(uint8_t track, Status status) override {mErrors.push_back({track, status});};
+
+        std::vector<uint32_t> mHalves{};
+        uint32_t mDone{0U};
+        std::vector<std::pair<uint8_t, Status>> mErrors{};
+};
+
+/// @brief Sequencer on the streams of a simulated DMAMUX.
+class Rig
+{
+    public:
+        Rig() : mPorts{&mMux.GetChannel(0U), &mMux.GetChannel(1U), &mMux.GetChannel(2U)}, mSequencer(mPorts)
+        {
+            mSequencer.SetListener(&mEvents);
+        }
+
+        DmaMuxSim mMux{};
+        std::array<ISequencePort*, 3U> mPorts;
+        DmaSequencer mSequencer;
+        Events mEvents{};
+};
+
+/// @brief The times of the writes of a stream.
+std::vector<uint64_t> Times(const DmaMuxSim& mux, uint8_t channel)
+{
+    std::vector<uint64_t> times;
+    for (const DmaMuxSim::Write& write : mux.GetTimeline())
+    {
+        if (write.channel == channel)
+        {
+            times.push_back(write.time);
+        }
+    }
+    return times;
+}
+
+/// @brief The values of the writes of a stream.
+std::vector<uint32_t> Values(const DmaMuxSim& mux, uint8_t channel)
+{
+    std::vector<uint32_t> values;
+    for (const DmaMuxSim::Write& write : mux.GetTimeline())
+    {
+        if (write.channel == channel)
+        {
+            values.push_back(write.value);
+        }
+    }
+    return values;
+}
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(DmaSequencer_Test, PlaysAGpioPatternOnTheGenerator)
+{
+    Rig rig;
+    volatile uint32_t bsrr = 0U;
+    const std::vector<uint16_t> levels{0x0001U, 0x0000U, 0x0101U, 0x0001U, 0x0100U};
+    std::vector<uint32_t> words(levels.size());
+    ASSERT_EQ(Status::OK, DmaSequencer::EncodeGpio(0x0101U, levels, words));
+    EXPECT_THAT(words, ::testing::ElementsAre(0x01000001U, 0x01010000U, 0x00000101U, 0x01000001U, 0x00010100U));
+
+    // one write per rising edge of LPTIM1, period 10 ticks
+    ASSERT_EQ(Status::OK, rig.mSequencer.SetTrack(0U, {&bsrr, words, false, Pacing::GENERATOR, LPTIM1_OUT,
+                                                       Edge::RISING, 1U, 0U}));
+    ASSERT_EQ(Status::OK, rig.mSequencer.Start());
+    rig.mMux.SetSignal(LPTIM1_OUT, 10U, 5U);
+    rig.mMux.Advance(100U);
+
+    EXPECT_EQ((std::vector<uint64_t>{5U, 15U, 25U, 35U, 45U}), Times(rig.mMux, 0U));
+    EXPECT_EQ(words, Values(rig.mMux, 0U));
+    EXPECT_EQ(reinterpret_cast<Address>(&bsrr), rig.mMux.GetTimeline()[0].target);
+    EXPECT_EQ(0x00010100U, bsrr);
+    EXPECT_EQ(1U, rig.mEvents.mDone);
+    EXPECT_FALSE(rig.mSequencer.IsRunning());
+    EXPECT_TRUE(rig.mEvents.mErrors.empty());
+}
+
+
+TEST(DmaSequencer_Test, BurstsPerEventAndLoops)
+{
+    Rig rig;
+    volatile uint32_t reg = 0U;
+    const std::vector<uint32_t> words{1U, 2U, 3U, 4U, 5U, 6U};
+
+    // three requests per edge, both edges, a transfer takes 2 ticks
+    ASSERT_EQ(Status::OK, rig.mSequencer.SetTrack(1U, {&reg, words, true, Pacing::GENERATOR, LPTIM1_OUT,
+                                                       Edge::BOTH, 3U, 2U}));
+    ASSERT_EQ(Status::OK, rig.mSequencer.Start());
+    rig.mMux.SetTransferTime(2U);
+    rig.mMux.SetSignal(LPTIM1_OUT, 20U, 0U);
+    rig.mMux.Advance(40U);
+
+    EXPECT_EQ((std::vector<uint64_t>{0U, 2U, 4U, 10U, 12U, 14U, 20U, 22U, 24U, 30U, 32U, 34U}), Times(rig.mMux, 1U));
+    EXPECT_EQ((std::vector<uint32_t>{1U, 2U, 3U, 4U, 5U, 6U, 1U, 2U, 3U, 4U, 5U, 6U}), Values(rig.mMux, 1U));
+    // the halves of track 1
+    EXPECT_EQ((std::vector<uint32_t>{2U, 3U, 2U, 3U}), rig.mEvents.mHalves);
+    EXPECT_TRUE(rig.mSequencer.IsRunning());
+    EXPECT_EQ(0U, rig.mEvents.mDone);
+
+    rig.mSequencer.Stop();
+    rig.mMux.ClearTimeline();
+    rig.mMux.Advance(40U);
+    EXPECT_TRUE(rig.mMux.GetTimeline().empty());
+    EXPECT_FALSE(rig.mMux.GetChannel(1U).IsRunning());
+}
+
+
+TEST(DmaSequencer_Test, SynchronizesPeripheralRequestsAndAlignsTracks)
+{
+    Rig rig;
+    volatile uint32_t dhr = 0U;
+    volatile uint32_t arr = 0U;
+    const std::vector<uint16_t> samples{0U, 1000U, 2000U, 5000U, 3000U, 2000U, 1000U, 0U};
+    std::vector<uint32_t> dac(samples.size());
+    ASSERT_EQ(Status::OK, DmaSequencer::EncodeDac12(samples, dac));
+    EXPECT_EQ(4095U, dac[3]);
+    const std::vector<uint32_t> periods{100U, 200U};
+    std::vector<uint32_t> reloads(periods.size());
+    ASSERT_EQ(Status::OK, DmaSequencer::EncodeTimerPeriods(periods, reloads));
+    EXPECT_THAT(reloads, ::testing::ElementsAre(99U, 199U));
+
+    // the DAC requests every 2 ticks, 4 of them pass per TIM12 event; the reloads on the same events
+    ASSERT_EQ(Status::OK, rig.mSequencer.SetTrack(0U, {&dhr, dac, false, Pacing::SYNCHRONIZED, TIM12_TRGO,
+                                                       Edge::RISING, 4U, DAC1_REQUEST}));
+    ASSERT_EQ(Status::OK, rig.mSequencer.SetTrack(2U, {&arr, reloads, false, Pacing::GENERATOR, TIM12_TRGO,
+                                                       Edge::RISING, 1U, 1U}));
+    ASSERT_EQ(Status::OK, rig.mSequencer.Start());
+    rig.mMux.SetPeripheralRequest(DAC1_REQUEST, 2U, 1U);
+    rig.mMux.SetSignal(TIM12_TRGO, 40U, 0U);
+    rig.mMux.Advance(200U);
+
+    EXPECT_EQ((std::vector<uint64_t>{1U, 3U, 5U, 7U, 41U, 43U, 45U, 47U}), Times(rig.mMux, 0U));
+    EXPECT_EQ(dac, Values(rig.mMux, 0U));
+    EXPECT_EQ((std::vector<uint64_t>{0U, 40U}), Times(rig.mMux, 2U));
+    EXPECT_EQ(199U, arr);
+    EXPECT_EQ(0U, dhr);
+    // the sequence ends with the last track
+    EXPECT_EQ(1U, rig.mEvents.mDone);
+    EXPECT_FALSE(rig.mSequencer.IsRunning());
+}
+
+
+TEST(DmaSequencer_Test, ReportsOverrunsAndStopsOnFaults)
+{
+    Rig rig;
+    volatile uint32_t reg = 0U;
+    std::vector<uint32_t> words(8U, 7U);
+
+    // two requests per event take 24 ticks, the event at 10 is lost
+    ASSERT_EQ(Status::OK, rig.mSequencer.SetTrack(0U, {&reg, words, true, Pacing::GENERATOR, LPTIM1_OUT,
+                                                       Edge::RISING, 2U, 0U}));
+    ASSERT_EQ(Status::OK, rig.mSequencer.SetTrack(1U, {&reg, words, true, Pacing::SYNCHRONIZED, LPTIM1_OUT,
+                                                       Edge::RISING, 2U, DAC1_REQUEST}));
+    ASSERT_EQ(Status::OK, rig.mSequencer.Start());
+    rig.mMux.SetTransferTime(12U);
+    rig.mMux.SetSignal(LPTIM1_OUT, 10U, 0U);
+    rig.mMux.SetPeripheralRequest(DAC1_REQUEST, 15U, 0U);
+    rig.mMux.Advance(20U);
+    EXPECT_EQ((std::vector<uint64_t>{0U, 12U}), Times(rig.mMux, 0U));
+    // the synchronization passed one request of two before the next event
+    EXPECT_EQ((std::vector<uint64_t>{0U, 15U}), Times(rig.mMux, 1U));
+    EXPECT_EQ(2U, rig.mSequencer.GetOverruns());
+    EXPECT_EQ((std::vector<std::pair<uint8_t, Status>>{{0U, Status::OVERRUN}, {1U, Status::OVERRUN}}),
+              rig.mEvents.mErrors);
+    EXPECT_TRUE(rig.mSequencer.IsRunning());
+
+    // a transfer error stops all tracks
+    rig.mMux.InjectFault(0U);
+    rig.mMux.Advance(20U);
+    ASSERT_EQ(3U, rig.mEvents.mErrors.size());
+    EXPECT_EQ(Status::HW_ERROR, rig.mEvents.mErrors[2].second);
+    EXPECT_FALSE(rig.mSequencer.IsRunning());
+    EXPECT_FALSE(rig.mMux.GetChannel(1U).IsRunning());
+}
+
+
+TEST(DmaSequencer_Test, RejectsInvalidTracks)
+{
+    Rig rig;
+    volatile uint32_t reg = 0U;
+    const std::vector<uint32_t> words{1U, 2U, 3U};
+    const Track valid{&reg, words, false, Pacing::GENERATOR, LPTIM1_OUT, Edge::RISING, 1U, 0U};
+
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.Start());
+    Track track = valid;
+    track.pTarget = nullptr;
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.SetTrack(0U, track));
+    track = valid;
+    track.loop = true;
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.SetTrack(0U, track));
+    track = valid;
+    track.requestsPerEvent = 33U;
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.SetTrack(0U, track));
+    track = valid;
+    track.signal = 8U;
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.SetTrack(0U, track));
+    track = valid;
+    track.request = GENERATORS;
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.SetTrack(0U, track));
+    track = valid;
+    track.words = {};
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.SetTrack(0U, track));
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.SetTrack(3U, valid));
+
+    ASSERT_EQ(Status::OK, rig.mSequencer.SetTrack(0U, valid));
+    ASSERT_EQ(Status::OK, rig.mSequencer.Start());
+    EXPECT_EQ(Status::BUSY, rig.mSequencer.Start());
+    EXPECT_EQ(Status::BUSY, rig.mSequencer.SetTrack(1U, valid));
+    rig.mSequencer.Stop();
+    rig.mSequencer.ClearTracks();
+    EXPECT_EQ(Status::INVALID_PARAM, rig.mSequencer.Start());
+
+    std::vector<uint32_t> small(2U);
+    const std::vector<uint16_t> levels{1U, 2U, 3U};
+    EXPECT_EQ(Status::INVALID_PARAM, DmaSequencer::EncodeGpio(0xFFFFU, levels, small));
+    EXPECT_EQ(Status::INVALID_PARAM, DmaSequencer::EncodeDac12(levels, small));
+    const std::vector<uint32_t> zero{10U, 0U};
+    EXPECT_EQ(Status::INVALID_PARAM, DmaSequencer::EncodeTimerPeriods(zero, small));
+}
+
+} // end namespace GTest
@@ -0,0 +1,378 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../MdmaComposer.hpp"
+#include "../MdmaSim.hpp"
+#include "../AsyncMemcpy.hpp"
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Dma;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  CopiesWithTheWidestBeats
+*   (0)  SplitsLargeCopiesIntoRepeatedBlocks
+*   (0)  Copies2DWithBlockUpdates
+*   (0)  GathersScattersAndWritesRegisters
+*   (0)  AsyncMemcpyFallsBackToTheCpu
+*/
+
+namespace {
+
+/// @brief A buffer with a pattern, 8 byte aligned.
+std::vector<uint64_t> Pattern(size_t bytes, uint8_t seed)
+{
+    std::vector<uint64_t> words((bytes + 7U) / 8U);
+    uint8_t* p = reinterpret_cast<uint8_t*>(words.data());
+    for (size_t i = 0U; i < bytes; i++)
+    {
+        p[i] = static_cast<uint8_t>((i * 7U) + (i >> 8U) + seed);
+    }
+    return words;
+}
+
+uint8_t* Bytes(std::vector<uint64_t>& words)
+{
+    return reinterpret_cast<uint8_t*>(words.data());
+}
+
+/// @brief Listener which records the completions.
+class Completions : public IMdmaEngine::IListener
+{
+    public:
+        void OnComplete(Status status) override {mStatus.push_back(status);};
+        std::vector<Status> mStatus{};
+};
+
+/// @brief Run a chain to its end on the simulated channel.
+Status RunChain(const MdmaComposer& chain)
+{
+    MdmaSim sim;
+    Completions completions;
+    sim.SetListener(&completions);
+    const Status status = sim.Start(chain.GetNodes());
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    sim.Run();
+    return (completions.mStatus.size() == 1U) ? completions.mStatus[0] : Status::BUSY;
+}
+
+/// @brief The nodes are linked in order and the last one ends the chain.
+void ExpectLinked(const MdmaComposer& chain)
+{
+    const std::span<const MdmaNode> nodes = chain.GetNodes();
+    for (size_t i = 0U; i < nodes.size(); i++)
+    {
+        const Address next = ((i + 1U) < nodes.size()) ? reinterpret_cast<Address>(&nodes[i + 1U]) : 0U;
+        EXPECT_EQ(next, nodes[i].clar) << i;
+    }
+}
+
+/// @brief The extent of a contiguous node side.
+void ExpectExtent(const MdmaNode& node, bool source)
+{
+    Address begin = 0U;
+    Address end = 0U;
+    node.GetExtent(source, &begin, &end);
+    const Address base = source ? node.csar : node.cdar;
+    EXPECT_EQ(base, begin);
+    EXPECT_EQ(base + (static_cast<Address>(node.BlockBytes()) * node.Repeats()), end);
+}
+
+struct CopyResult
+{
+    uint32_t calls{0U};
+    Status status{Status::BUSY};
+};
+
+void OnCopied(void* pContext, Status status)
+{
+    CopyResult* pResult = static_cast<CopyResult*>(pContext);
+    pResult->calls++;
+    pResult->status = status;
+}
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(MdmaComposer_Test, CopiesWithTheWidestBeats)
+{
+    std::vector<uint64_t> src = Pattern(4096U, 1U);
+    std::vector<uint64_t> dst = Pattern(4096U, 2U);
+    std::vector<uint64_t> expected = dst;
+    MdmaChain<16U> chain;
+
+    // aligned: one node of double words, a software request moves the chain
+    ASSERT_EQ(Status::OK, chain.Copy(Bytes(src), Bytes(dst), 1000U));
+    ASSERT_EQ(1U, chain.GetNodes().size());
+    const MdmaNode& node = chain.GetNodes()[0];
+    EXPECT_EQ(DataSize::DOUBLE_WORD, node.GetSize(true));
+    EXPECT_EQ(DataSize::DOUBLE_WORD, node.GetSize(false));
+    EXPECT_EQ(1000U, node.BlockBytes());
+    EXPECT_EQ(1U, node.Repeats());
+    EXPECT_TRUE(node.IsSoftware());
+    EXPECT_EQ(TriggerMode::LINKED_LIST, node.GetTriggerMode());
+    std::copy_n(Bytes(src), 1000U, Bytes(expected));
+
+    // the same offset: a byte head up to the alignment, double words, a byte tail
+    ASSERT_EQ(Status::OK, chain.Copy(Bytes(src) + 1003U, Bytes(dst) + 1003U, 1001U));
+    ASSERT_EQ(4U, chain.GetNodes().size());
+    EXPECT_EQ(5U, chain.GetNodes()[1].BlockBytes());
+    EXPECT_EQ(DataSize::BYTE, chain.GetNodes()[1].GetSize(true));
+    EXPECT_EQ(992U, chain.GetNodes()[2].BlockBytes());
+    EXPECT_EQ(DataSize::DOUBLE_WORD, chain.GetNodes()[2].GetSize(true));
+    EXPECT_EQ(4U, chain.GetNodes()[3].BlockBytes());
+    std::copy_n(Bytes(src) + 1003U, 1001U, Bytes(expected) + 1003U);
+
+    // offsets which differ by two: a byte head, half words, a byte tail
+    ASSERT_EQ(Status::OK, chain.Copy(Bytes(src) + 2101U, Bytes(dst) + 3003U, 1000U));
+    ASSERT_EQ(7U, chain.GetNodes().size());
+    EXPECT_EQ(DataSize::HALF_WORD, chain.GetNodes()[5].GetSize(true));
+    std::copy_n(Bytes(src) + 2101U, 1000U, Bytes(expected) + 3003U);
+
+    // nothing to copy, nothing appended
+    ASSERT_EQ(Status::OK, chain.Copy(Bytes(src), Bytes(dst), 0U));
+    EXPECT_EQ(Status::INVALID_PARAM, chain.Copy(nullptr, Bytes(dst), 1U));
+    ASSERT_EQ(7U, chain.GetNodes().size());
+
+    ExpectLinked(chain);
+    for (const MdmaNode& n : chain.GetNodes())
+    {
+        ExpectExtent(n, true);
+        ExpectExtent(n, false);
+    }
+    ASSERT_EQ(Status::OK, RunChain(chain));
+    EXPECT_EQ(expected, dst);
+}
+
+
+TEST(MdmaComposer_Test, SplitsLargeCopiesIntoRepeatedBlocks)
+{
+    static_assert(MdmaComposer::CopyNodes(UINT32_MAX) == 19U);
+    constexpr uint32_t BYTES{(3U * MdmaNode::MAX_BLOCK_BYTES) + 1003U};
+    std::vector<uint64_t> src = Pattern(BYTES, 3U);
+    std::vector<uint64_t> dst = Pattern(BYTES, 4U);
+    MdmaChain<MdmaComposer::CopyNodes(BYTES)> chain;
+
+    ASSERT_EQ(Status::OK, chain.Copy(Bytes(src), Bytes(dst), BYTES));
+    ASSERT_EQ(3U, chain.GetNodes().size());
+    const std::span<const MdmaNode> nodes = chain.GetNodes();
+    EXPECT_EQ(MdmaNode::MAX_BLOCK_BYTES, nodes[0].BlockBytes());
+    EXPECT_EQ(3U, nodes[0].Repeats());
+    EXPECT_EQ(0, nodes[0].GetUpdate(true));
+    EXPECT_EQ(1000U, nodes[1].BlockBytes());
+    EXPECT_EQ(reinterpret_cast<Address>(Bytes(src) + (3U * MdmaNode::MAX_BLOCK_BYTES)), nodes[1].csar);
+    EXPECT_EQ(3U, nodes[2].BlockBytes());
+    ExpectExtent(nodes[0], true);
+    ExpectExtent(nodes[0], false);
+
+    MdmaSim sim;
+    Completions completions;
+    sim.SetListener(&completions);
+    ASSERT_EQ(Status::OK, sim.Start(chain.GetNodes()));
+    EXPECT_EQ(Status::BUSY, sim.Start(chain.GetNodes()));
+    EXPECT_EQ(1U, sim.Run(1U));
+    EXPECT_TRUE(sim.IsBusy());
+    EXPECT_EQ(2U, sim.Run());
+    EXPECT_FALSE(sim.IsBusy());
+    EXPECT_EQ(std::vector<Status>{Status::OK}, completions.mStatus);
+    EXPECT_EQ(BYTES, sim.GetBytes());
+    EXPECT_EQ(src, dst);
+
+    // a chain which does not fit stays as it was
+    MdmaChain<2U> small;
+    ASSERT_EQ(Status::OK, small.Copy(Bytes(src), Bytes(dst), 8U));
+    EXPECT_EQ(Status::NO_SPACE, small.Copy(Bytes(src), Bytes(dst), BYTES));
+    ASSERT_EQ(1U, small.GetNodes().size());
+    EXPECT_EQ(0U, small.GetNodes()[0].clar);
+    small.Clear();
+    EXPECT_TRUE(small.GetNodes().empty());
+}
+
+
+TEST(MdmaComposer_Test, Copies2DWithBlockUpdates)
+{
+    constexpr uint32_t WIDTH{100U};
+    constexpr uint32_t HEIGHT{20U};
+    std::vector<uint64_t> image = Pattern(WIDTH * HEIGHT, 5U);
+    std::vector<uint64_t> window(24U * 10U / 8U, 0U);
+    std::vector<uint64_t> copy(WIDTH * HEIGHT / 8U, 0U);
+    MdmaChain<8U> chain;
+
+    // a window of 24 x 10 bytes at (8, 4) into a packed buffer and back into an empty image
+    const Copy2DItem cut{Bytes(image) + (4U * WIDTH) + 8U, WIDTH, Bytes(window), 24U, 24U, 10U};
+    const Copy2DItem paste{Bytes(window), 24U, Bytes(copy) + (4U * WIDTH) + 8U, WIDTH, 24U, 10U};
+    ASSERT_EQ(Status::OK, chain.Copy2D(cut));
+    ASSERT_EQ(Status::OK, chain.Copy2D(paste));
+    ASSERT_EQ(2U, chain.GetNodes().size());
+    const MdmaNode& node = chain.GetNodes()[0];
+    EXPECT_EQ(DataSize::WORD, node.GetSize(true));
+    EXPECT_EQ(24U, node.BlockBytes());
+    EXPECT_EQ(10U, node.Repeats());
+    EXPECT_EQ(76, node.GetUpdate(true));
+    EXPECT_EQ(0, node.GetUpdate(false));
+    Address begin = 0U;
+    Address end = 0U;
+    node.GetExtent(true, &begin, &end);
+    EXPECT_EQ(reinterpret_cast<Address>(cut.pSrc), begin);
+    EXPECT_EQ(reinterpret_cast<Address>(cut.pSrc) + (9U * WIDTH) + 24U, end);
+    ASSERT_EQ(Status::OK, RunChain(chain));
+
+    for (uint32_t y = 0U; y < HEIGHT; y++)
+    {
+        for (uint32_t x = 0U; x < WIDTH; x++)
+        {
+            const bool inside = (y >= 4U) && (y < 14U) && (x >= 8U) && (x < 32U);
+            ASSERT_EQ(inside ? Bytes(image)[(y * WIDTH) + x] : 0U, Bytes(copy)[(y * WIDTH) + x]) << x << "," << y;
+        }
+    }
+
+    // more lines than repeats of a node
+    chain.Clear();
+    std::vector<uint64_t> columns = Pattern(5000U * 8U, 6U);
+    std::vector<uint64_t> column(5000U * 4U / 8U, 0U);
+    ASSERT_EQ(Status::OK, chain.Copy2D({Bytes(columns), 8U, Bytes(column), 4U, 4U, 5000U}));
+    ASSERT_EQ(MdmaComposer::Copy2DNodes(5000U), chain.GetNodes().size());
+    EXPECT_EQ(MdmaNode::MAX_REPEATS, chain.GetNodes()[0].Repeats());
+    EXPECT_EQ(5000U - MdmaNode::MAX_REPEATS, chain.GetNodes()[1].Repeats());
+    ASSERT_EQ(Status::OK, RunChain(chain));
+    for (uint32_t i = 0U; i < 5000U; i++)
+    {
+        ASSERT_EQ(reinterpret_cast<uint32_t*>(columns.data())[2U * i], reinterpret_cast<uint32_t*>(column.data())[i]);
+    }
+
+    // gaps beyond the update values need a node per line
+    chain.Clear();
+    std::vector<uint64_t> sparse = Pattern(3U * 70000U, 7U);
+    std::vector<uint64_t> packed(3U * 16U / 8U, 0U);
+    ASSERT_EQ(Status::OK, chain.Copy2D({Bytes(sparse), 70000U, Bytes(packed), 16U, 16U, 3U}));
+    ASSERT_EQ(3U, chain.GetNodes().size());
+    ASSERT_EQ(Status::OK, RunChain(chain));
+    for (uint32_t line = 0U; line < 3U; line++)
+    {
+        EXPECT_TRUE(std::equal(Bytes(packed) + (line * 16U), Bytes(packed) + ((line + 1U) * 16U),
+                               Bytes(sparse) + (line * 70000U)));
+    }
+
+    EXPECT_EQ(Status::INVALID_PARAM, chain.Copy2D({Bytes(sparse), 16U, Bytes(packed), 16U, 0U, 3U}));
+    EXPECT_EQ(Status::INVALID_PARAM, chain.Copy2D({Bytes(sparse), 16U, nullptr, 16U, 16U, 3U}));
+}
+
+
+TEST(MdmaComposer_Test, GathersScattersAndWritesRegisters)
+{
+    std::vector<uint64_t> a = Pattern(10U, 8U);
+    std::vector<uint64_t> b = Pattern(64U, 9U);
+    std::vector<uint64_t> c = Pattern(7U, 10U);
+    std::vector<uint64_t> gathered(81U / 8U + 1U, 0U);
+    std::vector<uint64_t> a2(2U, 0U);
+    std::vector<uint64_t> b2(8U, 0U);
+    std::vector<uint64_t> c2(1U, 0U);
+    MdmaChain<16U> chain;
+
+    const ConstRegion sources[]{{Bytes(a), 10U}, {Bytes(b), 64U}, {Bytes(c), 7U}};
+    const Region destinations[]{{Bytes(a2), 10U}, {Bytes(b2), 64U}, {Bytes(c2), 7U}};
+    ASSERT_EQ(Status::OK, chain.Gather(sources, Bytes(gathered)));
+    ASSERT_EQ(Status::OK, chain.Scatter(Bytes(gathered), destinations));
+    ExpectLinked(chain);
+    ASSERT_EQ(Status::OK, RunChain(chain));
+    EXPECT_TRUE(std::equal(Bytes(a), Bytes(a) + 10U, Bytes(gathered)));
+    EXPECT_TRUE(std::equal(Bytes(b), Bytes(b) + 64U, Bytes(gathered) + 10U));
+    EXPECT_TRUE(std::equal(Bytes(c), Bytes(c) + 7U, Bytes(gathered) + 74U));
+    EXPECT_TRUE(std::equal(Bytes(a), Bytes(a) + 10U, Bytes(a2)));
+    EXPECT_TRUE(std::equal(Bytes(b), Bytes(b) + 64U, Bytes(b2)));
+    EXPECT_TRUE(std::equal(Bytes(c), Bytes(c) + 7U, Bytes(c2)));
+
+    // a register on a hardware request: the address stays, each word lands in it
+    chain.Clear();
+    uint32_t words[5]{11U, 22U, 33U, 44U, 55U};
+    uint32_t read[3]{};
+    volatile uint32_t reg = 0U;
+    ASSERT_EQ(Status::OK, chain.SetHardwareRequest(17U, TriggerMode::BUFFER));
+    ASSERT_EQ(Status::OK, chain.WriteRegister(words, &reg, sizeof(words), DataSize::WORD));
+    ASSERT_EQ(Status::OK, chain.ReadRegister(&reg, read, sizeof(read), DataSize::WORD));
+    const MdmaNode& write = chain.GetNodes()[0];
+    EXPECT_FALSE(write.IsSoftware());
+    EXPECT_EQ(17U, write.GetRequest());
+    EXPECT_EQ(TriggerMode::BUFFER, write.GetTriggerMode());
+    EXPECT_EQ(MdmaNode::FIXED, write.GetAddressMode(false));
+    EXPECT_EQ(MdmaNode::FIXED, chain.GetNodes()[1].GetAddressMode(true));
+    ASSERT_EQ(Status::OK, RunChain(chain));
+    EXPECT_EQ(55U, reg);
+    EXPECT_THAT(read, ::testing::ElementsAre(55U, 55U, 55U));
+    EXPECT_EQ(Status::INVALID_PARAM, chain.SetHardwareRequest(64U, TriggerMode::BLOCK));
+    EXPECT_EQ(Status::INVALID_PARAM, chain.WriteRegister(words, &reg, 6U, DataSize::WORD));
+    EXPECT_EQ(Status::INVALID_PARAM, chain.ReadRegister(&reg, Bytes(b) + 2U, 8U, DataSize::WORD));
+
+    // circular: the last node links to the first one, a failed operation keeps the ring closed
+    chain.SetSoftwareRequest();
+    chain.SetCircular(true);
+    EXPECT_EQ(reinterpret_cast<Address>(&chain.GetNodes()[0]), chain.GetNodes()[1].clar);
+    const ConstRegion broken[]{{Bytes(a), 10U}, {nullptr, 4U}};
+    EXPECT_EQ(Status::INVALID_PARAM, chain.Gather(broken, Bytes(gathered)));
+    ASSERT_EQ(2U, chain.GetNodes().size());
+    EXPECT_EQ(reinterpret_cast<Address>(&chain.GetNodes()[0]), chain.GetNodes()[1].clar);
+    MdmaSim sim;
+    ASSERT_EQ(Status::OK, sim.Start(chain.GetNodes()));
+    EXPECT_EQ(5U, sim.Run(5U));
+    EXPECT_TRUE(sim.IsBusy());
+    sim.Abort();
+    EXPECT_FALSE(sim.IsBusy());
+}
+
+
+TEST(MdmaComposer_Test, AsyncMemcpyFallsBackToTheCpu)
+{
+    MdmaSim sim;
+    AsyncMemcpy copier(sim, 256U);
+    std::vector<uint64_t> src = Pattern(100000U, 11U);
+    std::vector<uint64_t> dst(src.size(), 0U);
+    CopyResult result;
+
+    // small: at once by the CPU, no callback
+    ASSERT_EQ(Status::OK, copier.Copy(Bytes(dst), Bytes(src), 255U, OnCopied, &result));
+    EXPECT_TRUE(std::equal(Bytes(src), Bytes(src) + 255U, Bytes(dst)));
+    EXPECT_EQ(0U, result.calls);
+    EXPECT_EQ(0U, sim.GetStarts());
+    EXPECT_EQ(1U, copier.GetCpuCopies());
+
+    // large: in the background, one at a time
+    ASSERT_EQ(Status::PENDING, copier.Copy(Bytes(dst) + 1U, Bytes(src) + 1U, 99999U, OnCopied, &result));
+    EXPECT_TRUE(copier.IsBusy());
+    EXPECT_EQ(Status::BUSY, copier.Copy(Bytes(dst), Bytes(src), 10U, OnCopied, &result));
+    sim.Run();
+    EXPECT_FALSE(copier.IsBusy());
+    EXPECT_EQ(1U, result.calls);
+    EXPECT_EQ(Status::OK, result.status);
+    EXPECT_EQ(src, dst);
+    EXPECT_EQ(1U, copier.GetDmaCopies());
+
+    // a transfer error is reported
+    sim.InjectFault();
+    ASSERT_EQ(Status::PENDING, copier.Copy(Bytes(dst), Bytes(src), 4096U, OnCopied, &result));
+    sim.Run();
+    EXPECT_EQ(2U, result.calls);
+    EXPECT_EQ(Status::HW_ERROR, result.status);
+    EXPECT_FALSE(copier.IsBusy());
+
+    EXPECT_EQ(Status::INVALID_PARAM, copier.Copy(nullptr, Bytes(src), 4096U, OnCopied, &result));
+    EXPECT_EQ(Status::OK, copier.Copy(nullptr, nullptr, 0U, OnCopied, &result));
+}
+
+} // end namespace GTest
@@ -0,0 +1,138 @@
+/**
+ ********************************************************************************
+ * @file        BiquadCascade.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float biquad cascade implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "BiquadCascade.hpp"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief b0 * x[n] + b1 * x[n - 1] + b2 * x[n - 2], pIn points to x[n - 2] of the first output.
+void ForwardScalar(const float* pIn, const float* pCoeff, float* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const float p0 = pCoeff[0] * pIn[i + 2U];
+        const float p1 = pCoeff[1] * pIn[i + 1U];
+        const float p2 = pCoeff[2] * pIn[i];
+        pOut[i] = (p0 + p1) + p2;
+    }
+}
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+
+__attribute__((target("avx2")))
+void ForwardAvx2(const float* pIn, const float* pCoeff, float* pOut, uint32_t count)
+{
+    const __m256 b0 = _mm256_set1_ps(pCoeff[0]);
+    const __m256 b1 = _mm256_set1_ps(pCoeff[1]);
+    const __m256 b2 = _mm256_set1_ps(pCoeff[2]);
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        const __m256 p0 = _mm256_mul_ps(b0, _mm256_loadu_ps(&pIn[i + 2U]));
+        const __m256 p1 = _mm256_mul_ps(b1, _mm256_loadu_ps(&pIn[i + 1U]));
+        const __m256 p2 = _mm256_mul_ps(b2, _mm256_loadu_ps(&pIn[i]));
+        _mm256_storeu_ps(&pOut[i], _mm256_add_ps(_mm256_add_ps(p0, p1), p2));
+    }
+    ForwardScalar(&pIn[i], pCoeff, &pOut[i], count - i);
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+BiquadCascade::BiquadCascade(SimdKernel kernel)
+: mKernel(std::min(kernel, GetBestSimdKernel()))
+{
+}
+
+
+Status BiquadCascade::Configure(std::span<const float> coefficients)
+{
+    if (coefficients.empty() || (coefficients.size() > mCoefficients.size())
+        || ((coefficients.size() % COEFFICIENTS) != 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mStages = static_cast<uint32_t>(coefficients.size() / COEFFICIENTS);
+    std::copy(coefficients.begin(), coefficients.end(), mCoefficients.begin());
+    Reset();
+    return Status::OK;
+}
+
+
+void BiquadCascade::Reset()
+{
+    mState.fill({0.0F, 0.0F, 0.0F, 0.0F});
+}
+
+
+Status BiquadCascade::Process(std::span<const float> in, std::span<float> out)
+{
+    if ((mStages == 0U) || (out.size() < in.size()))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    size_t done = 0U;
+    while (done < in.size())
+    {
+        const uint32_t count = static_cast<uint32_t>(std::min<size_t>(BLOCK, in.size() - done));
+        std::memcpy(&mInput[2], &in[done], count * sizeof(float));
+        for (uint32_t s = 0U; s < mStages; s++)
+        {
+            const float* pCoeff = &mCoefficients[s * COEFFICIENTS];
+            Stage& state = mState[s];
+            mInput[0] = state.x2;
+            mInput[1] = state.x1;
+#if defined(DSP_HAS_X86_INTRINSICS)
+            if (mKernel == SimdKernel::AVX2)
+            {
+                ForwardAvx2(mInput.data(), pCoeff, mForward.data(), count);
+            }
+            else
+#endif
+            {
+                ForwardScalar(mInput.data(), pCoeff, mForward.data(), count);
+            }
+            state.x2 = mInput[count];
+            state.x1 = mInput[count + 1U];
+
+            // the feedback, the output is the input of the next stage
+            float y1 = state.y1;
+            float y2 = state.y2;
+            for (uint32_t i = 0U; i < count; i++)
+            {
+                const float f1 = pCoeff[3] * y1;
+                const float f2 = pCoeff[4] * y2;
+                const float y = (mForward[i] + f1) + f2;
+                mInput[i + 2U] = y;
+                y2 = y1;
+                y1 = y;
+            }
+            state.y1 = y1;
+            state.y2 = y2;
+        }
+        std::memcpy(&out[done], &mInput[2], count * sizeof(float));
+        done += count;
+    }
+    return Status::OK;
+}
@@ -0,0 +1,112 @@
+/**
+ ********************************************************************************
+ * @file        BiquadCascade.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float biquad cascade in direct form I (arm_biquad_cascade_df1_f32).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "SimdKernel.hpp"
+#include <array>
+#include <span>
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides a cascade of second order sections in direct form I.
+ * @details Every stage has the coefficients {b0, b1, b2, a1, a2} in the sign convention of CMSIS-DSP:
+ *          y[n] = b0 * x[n] + b1 * x[n - 1] + b2 * x[n - 2] + a1 * y[n - 1] + a2 * y[n - 2]
+ *          (the feedback coefficients of a design tool are negated).\n
+ *          The stages run one after another over a block of @ref BLOCK samples. The feed forward part has
+ *          no dependency between the samples, the AVX2 kernel calculates it for 8 samples per step, the
+ *          feedback stays serial.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class BiquadCascade
+{
+    public:
+
+        /// @brief Maximum number of stages.
+        static constexpr uint32_t MAX_STAGES{8U};
+
+        /// @brief Coefficients per stage.
+        static constexpr uint32_t COEFFICIENTS{5U};
+
+        /// @brief Samples per internal block.
+        static constexpr uint32_t BLOCK{256U};
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit BiquadCascade(SimdKernel kernel = GetBestSimdKernel());
+
+        /**
+         * @brief   Set the coefficients and clear the state.
+         *
+         * @param   coefficients    {b0, b1, b2, a1, a2} per stage, 1 .. @ref MAX_STAGES stages.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Configure(std::span<const float> coefficients);
+
+        /// @brief Clear the state.
+        void Reset();
+
+        /**
+         * @brief   Filter a block, continues the stream of the previous one.
+         *
+         * @param   in      Input samples.
+         * @param   out     Output samples, at least the size of the input, may be the input.
+         *
+         * @return  OK or INVALID_PARAM (not configured, output too small).
+         */
+        Status Process(std::span<const float> in, std::span<float> out);
+
+        /// @brief The kernel set in use.
+        SimdKernel GetKernel() const {return mKernel;};
+
+    private:
+
+        /// @brief State of a stage.
+        struct Stage
+        {
+            float x1;   //!< x[n - 1]
+            float x2;   //!< x[n - 2]
+            float y1;   //!< y[n - 1]
+            float y2;   //!< y[n - 2]
+        };
+
+        /// @brief The kernel set.
+        SimdKernel mKernel;
+
+        /// @brief Number of stages, 0 if not configured.
+        uint32_t mStages{0U};
+
+        /// @brief The coefficients.
+        std::array<float, MAX_STAGES * COEFFICIENTS> mCoefficients{};
+
+        /// @brief The state of the stages.
+        std::array<Stage, MAX_STAGES> mState{};
+
+        /// @brief Two samples of history followed by the block of a stage.
+        alignas(32) std::array<float, 2U + BLOCK> mInput{};
+
+        /// @brief Feed forward sums of the block.
+        alignas(32) std::array<float, BLOCK> mForward{};
+};
+
+} // end namespace Dsp
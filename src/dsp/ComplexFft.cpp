@@ -0,0 +1,175 @@
+/**
+ ********************************************************************************
+ * @file        ComplexFft.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float complex FFT implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "ComplexFft.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Dsp;
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+/// @brief Butterflies of the stage with half points per group, starting at the butterfly first.
+void ButterfliesScalar(float* pData, const float* pTwiddle, uint32_t size, uint32_t half, uint32_t first)
+{
+    for (uint32_t group = 0U; group < size; group += 2U * half)
+    {
+        for (uint32_t k = first; k < half; k++)
+        {
+            float* pA = &pData[2U * (group + k)];
+            float* pB = &pData[2U * (group + k + half)];
+            const float wr = pTwiddle[2U * k];
+            const float wi = pTwiddle[(2U * k) + 1U];
+            const float tr = (pB[0] * wr) - (pB[1] * wi);
+            const float ti = (pB[1] * wr) + (pB[0] * wi);
+            pB[0] = pA[0] - tr;
+            pB[1] = pA[1] - ti;
+            pA[0] = pA[0] + tr;
+            pA[1] = pA[1] + ti;
+        }
+    }
+}
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+
+/// @brief 4 butterflies per step, the complex product is the one of the scalar kernel.
+__attribute__((target("avx2")))
+void ButterfliesAvx2(float* pData, const float* pTwiddle, uint32_t size, uint32_t half)
+{
+    const uint32_t vector = half & ~3U;
+    for (uint32_t group = 0U; group < size; group += 2U * half)
+    {
+        for (uint32_t k = 0U; k < vector; k += 4U)
+        {
+            float* pA = &pData[2U * (group + k)];
+            float* pB = &pData[2U * (group + k + half)];
+            const __m256 w = _mm256_loadu_ps(&pTwiddle[2U * k]);
+            const __m256 a = _mm256_loadu_ps(pA);
+            const __m256 b = _mm256_loadu_ps(pB);
+            // {br * wr, bi * wr} -+ {bi * wi, br * wi}
+            const __m256 p1 = _mm256_mul_ps(b, _mm256_moveldup_ps(w));
+            const __m256 p2 = _mm256_mul_ps(_mm256_permute_ps(b, 0xB1), _mm256_movehdup_ps(w));
+            const __m256 t = _mm256_addsub_ps(p1, p2);
+            _mm256_storeu_ps(pB, _mm256_sub_ps(a, t));
+            _mm256_storeu_ps(pA, _mm256_add_ps(a, t));
+        }
+    }
+    if (vector < half)
+    {
+        ButterfliesScalar(pData, pTwiddle, size, half, vector);
+    }
+}
+
+#endif
+
+/// @brief Negate the imaginary parts and scale.
+void Conjugate(float* pData, uint32_t size, float scale)
+{
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        pData[2U * i] = pData[2U * i] * scale;
+        pData[(2U * i) + 1U] = -pData[(2U * i) + 1U] * scale;
+    }
+}
+
+} // end anonymous namespace
+
+
+ComplexFft::ComplexFft(SimdKernel kernel)
+: mKernel(std::min(kernel, GetBestSimdKernel()))
+{
+}
+
+
+Status ComplexFft::Configure(uint32_t size)
+{
+    if ((size < 2U) || (size > MAX_SIZE) || ((size & (size - 1U)) != 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mSize = size;
+    for (uint32_t half = 1U; half < size; half *= 2U)
+    {
+        for (uint32_t k = 0U; k < half; k++)
+        {
+            const double angle = -PI * static_cast<double>(k) / static_cast<double>(half);
+            mTwiddle[2U * (half - 1U + k)] = static_cast<float>(std::cos(angle));
+            mTwiddle[(2U * (half - 1U + k)) + 1U] = static_cast<float>(std::sin(angle));
+        }
+    }
+    return Status::OK;
+}
+
+
+Status ComplexFft::Forward(std::span<float> data) const
+{
+    if ((mSize == 0U) || (data.size() != (2U * mSize)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    Transform(data.data());
+    return Status::OK;
+}
+
+
+Status ComplexFft::Inverse(std::span<float> data) const
+{
+    if ((mSize == 0U) || (data.size() != (2U * mSize)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    Conjugate(data.data(), mSize, 1.0F);
+    Transform(data.data());
+    Conjugate(data.data(), mSize, 1.0F / static_cast<float>(mSize));
+    return Status::OK;
+}
+
+
+void ComplexFft::Transform(float* pData) const
+{
+    // bit reversal
+    for (uint32_t i = 1U, j = 0U; i < mSize; i++)
+    {
+        uint32_t bit = mSize >> 1U;
+        for (; (j & bit) != 0U; bit >>= 1U)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(pData[2U * i], pData[2U * j]);
+            std::swap(pData[(2U * i) + 1U], pData[(2U * j) + 1U]);
+        }
+    }
+
+    for (uint32_t half = 1U; half < mSize; half *= 2U)
+    {
+        const float* pTwiddle = &mTwiddle[2U * (half - 1U)];
+#if defined(DSP_HAS_X86_INTRINSICS)
+        if ((mKernel == SimdKernel::AVX2) && (half >= 4U))
+        {
+            ButterfliesAvx2(pData, pTwiddle, mSize, half);
+            continue;
+        }
+#endif
+        ButterfliesScalar(pData, pTwiddle, mSize, half, 0U);
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ ********************************************************************************
+ * @file        ComplexFft.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float complex FFT (arm_cfft_f32).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "SimdKernel.hpp"
+#include <array>
+#include <span>
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides an in place radix-2 FFT of interleaved complex floats {re, im, re, im, ..}.
+ * @details Decimation in time: the bit reversal permutes the data, log2(size) stages of butterflies
+ *          follow. The twiddle factors of every stage are stored contiguously (1 + 2 + .. + size / 2), so
+ *          the AVX2 kernel loads 4 of them with the 4 butterflies it calculates per step. The first two
+ *          stages have less than 4 butterflies per group and run scalar in both kernel sets.\n
+ *          The inverse transforms the conjugate and scales the conjugated result by 1 / size, like
+ *          arm_cfft_f32 with ifftFlag set.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class ComplexFft
+{
+    public:
+
+        /// @brief Maximum number of complex points.
+        static constexpr uint32_t MAX_SIZE{4096U};
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit ComplexFft(SimdKernel kernel = GetBestSimdKernel());
+
+        /**
+         * @brief   Set the size and calculate the twiddle factors.
+         *
+         * @param   size    Number of complex points, a power of two 2 .. @ref MAX_SIZE.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Configure(uint32_t size);
+
+        /**
+         * @brief   Forward transform in place.
+         *
+         * @param   data    2 * size floats.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Forward(std::span<float> data) const;
+
+        /**
+         * @brief   Inverse transform in place, scaled by 1 / size.
+         *
+         * @param   data    2 * size floats.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Inverse(std::span<float> data) const;
+
+        /// @brief Number of complex points, 0 if not configured.
+        uint32_t GetSize() const {return mSize;};
+
+        /// @brief The kernel set in use.
+        SimdKernel GetKernel() const {return mKernel;};
+
+    private:
+
+        /// @brief Bit reversal and the butterflies.
+        void Transform(float* pData) const;
+
+        /// @brief The kernel set.
+        SimdKernel mKernel;
+
+        /// @brief Number of complex points.
+        uint32_t mSize{0U};
+
+        /// @brief exp(-j * pi * k / half) of every stage, interleaved, the stage with half points at half - 1.
+        alignas(32) std::array<float, 2U * MAX_SIZE> mTwiddle{};
+};
+
+} // end namespace Dsp
@@ -0,0 +1,30 @@
+/**
+ ********************************************************************************
+ * @file        DspTypes.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, types shared by the filter and math services.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+namespace Dsp {
+
+
+/// @brief Result of a dsp operation or request.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The engine is in use
+    INVALID_PARAM=2,  //!< Parameter or descriptor is inconsistent
+    HW_ERROR=3,       //!< The peripheral or its DMA reported an error
+    PENDING=4         //!< Block is queued or running
+};
+
+} // end namespace Dsp
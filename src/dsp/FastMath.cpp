@@ -0,0 +1,94 @@
+/**
+ ********************************************************************************
+ * @file        FastMath.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, batch math functions implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FastMath.hpp"
+#include <algorithm>
+
+using namespace Dsp;
+
+
+Status FastMath::SinCos(std::span<const int32_t> angles, std::span<int32_t> sin, std::span<int32_t> cos)
+{
+    if ((sin.size() < angles.size()) || (cos.size() < angles.size()))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    for (size_t done = 0U; done < angles.size(); done += CHUNK)
+    {
+        const uint32_t n = static_cast<uint32_t>(std::min<size_t>(CHUNK, angles.size() - done));
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            mArguments[2U * i] = angles[done + i];
+            mArguments[(2U * i) + 1U] = ONE;
+        }
+        const Status status = mEngine.Compute(MathFunction::COSINE, mArguments.data(), mResults.data(), n);
+        if (status != Status::OK)
+        {
+            return status;
+        }
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            cos[done + i] = mResults[2U * i];
+            sin[done + i] = mResults[(2U * i) + 1U];
+        }
+    }
+    return Status::OK;
+}
+
+
+Status FastMath::Atan2(std::span<const int32_t> y, std::span<const int32_t> x, std::span<int32_t> phase)
+{
+    if ((x.size() != y.size()) || (phase.size() < y.size()))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    for (size_t done = 0U; done < y.size(); done += CHUNK)
+    {
+        const uint32_t n = static_cast<uint32_t>(std::min<size_t>(CHUNK, y.size() - done));
+        for (uint32_t i = 0U; i < n; i++)
+        {
+            mArguments[2U * i] = x[done + i];
+            mArguments[(2U * i) + 1U] = y[done + i];
+        }
+        const Status status = mEngine.Compute(MathFunction::PHASE, mArguments.data(), &phase[done], n);
+        if (status != Status::OK)
+        {
+            return status;
+        }
+    }
+    return Status::OK;
+}
+
+
+Status FastMath::Magnitude(std::span<const Complex> values, std::span<int32_t> magnitude)
+{
+    if (magnitude.size() < values.size())
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    for (size_t done = 0U; done < values.size(); done += CHUNK)
+    {
+        const uint32_t n = static_cast<uint32_t>(std::min<size_t>(CHUNK, values.size() - done));
+        // a complex value is the pair (x, y)
+        const Status status = mEngine.Compute(MathFunction::MODULUS,
+                                              reinterpret_cast<const int32_t*>(&values[done]), &magnitude[done], n);
+        if (status != Status::OK)
+        {
+            return status;
+        }
+    }
+    return Status::OK;
+}
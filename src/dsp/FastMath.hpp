@@ -0,0 +1,103 @@
+/**
+ ********************************************************************************
+ * @file        FastMath.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, batch trigonometry, phase and magnitude in q1.31.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IMathEngine.hpp"
+#include <array>
+#include <span>
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the batch math functions of the control loops and the spectrum analysis.
+ * @details The spans are split into chunks of @ref CHUNK calculations. The arguments are interleaved into
+ *          a work buffer as the engine expects them and the results are written back to the spans.
+ *          @ref Magnitude passes the complex values unchanged, they are already interleaved.\n
+ *          On the target the engine is the CORDIC (MathEngineHal), on the host the polynomial
+ *          approximations (MathEngineSoft). Angles and phases are scaled by pi.
+ * @note    For MathEngineHal the object (its work buffers), the complex values and the phase and magnitude
+ *          outputs must be located in a DMA accessible RAM. The magnitude of the CORDIC is only valid below
+ *          one, scale the values (e.g. the FFT output) accordingly.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class FastMath
+{
+    public:
+
+        /// @brief Calculations per engine batch.
+        static constexpr uint32_t CHUNK{64U};
+
+        /// @brief Modulus of one for the sine and cosine.
+        static constexpr int32_t ONE{0x7FFFFFFF};
+
+        /**
+         * @brief   Constructs the math functions on an engine.
+         *
+         * @param   engine      The engine which calculates.
+         */
+        explicit FastMath(IMathEngine& engine) : mEngine(engine) {};
+
+        FastMath(FastMath const &) = delete;             //!< Copy constructor
+        FastMath& operator=(FastMath const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Sine and cosine of angles.
+         *
+         * @param   angles  Angles in q1.31 scaled by pi.
+         * @param   sin     Sines, at least the size of the angles.
+         * @param   cos     Cosines, at least the size of the angles.
+         *
+         * @return  OK, INVALID_PARAM or the error of the engine.
+         */
+        Status SinCos(std::span<const int32_t> angles, std::span<int32_t> sin, std::span<int32_t> cos);
+
+        /**
+         * @brief   Phase of points, atan2(y, x).
+         *
+         * @param   y       Y coordinates.
+         * @param   x       X coordinates, the size of the y coordinates.
+         * @param   phase   Phases in q1.31 scaled by pi, at least the size of the coordinates.
+         *
+         * @return  OK, INVALID_PARAM or the error of the engine.
+         */
+        Status Atan2(std::span<const int32_t> y, std::span<const int32_t> x, std::span<int32_t> phase);
+
+        /**
+         * @brief   Magnitude of complex values.
+         *
+         * @param   values      The values, their magnitude must be below one.
+         * @param   magnitude   Magnitudes, at least the size of the values.
+         *
+         * @return  OK, INVALID_PARAM or the error of the engine.
+         */
+        Status Magnitude(std::span<const Complex> values, std::span<int32_t> magnitude);
+
+    private:
+
+        /// @brief The calculating engine.
+        IMathEngine& mEngine;
+
+        /// @brief Interleaved arguments of a chunk.
+        alignas(32) std::array<int32_t, ARGUMENTS * CHUNK> mArguments{};
+
+        /// @brief Interleaved results of a chunk.
+        alignas(32) std::array<int32_t, 2U * CHUNK> mResults{};
+};
+
+} // end namespace Dsp
@@ -0,0 +1,224 @@
+/**
+ ********************************************************************************
+ * @file        FilterBank.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, filter bank implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FilterBank.hpp"
+#include "CriticalSection.hpp"
+#include <algorithm>
+
+using namespace Dsp;
+
+
+FilterBank::FilterBank(IFilterEngine& engine)
+: mEngine(engine)
+{
+    mEngine.SetListener(this);
+}
+
+
+FilterBank::~FilterBank()
+{
+    mEngine.SetListener(nullptr);
+}
+
+
+Status FilterBank::Configure(uint8_t channel, const FilterConfig& config, bool keepState)
+{
+    if ((channel >= MAX_CHANNELS) || !config.IsValid())
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    Utils::CriticalSection cs;
+    if (IsRunning(channel))
+    {
+        return Status::BUSY;
+    }
+    Channel& ch = mChannels[channel];
+    const bool sameTaps = (ch.config.type == config.type) && (ch.config.tapsB == config.tapsB)
+                          && (config.OutputHistory() == ch.config.OutputHistory());
+    std::copy_n(config.pB, config.tapsB, ch.b.begin());
+    std::copy_n(config.pA, config.OutputHistory(), ch.a.begin());
+    ch.config = config;
+    ch.config.pB = ch.b.data();
+    ch.config.pA = ch.a.data();
+    if (!keepState || !sameTaps)
+    {
+        ch.state.Clear();
+    }
+    if (mLoaded == channel)
+    {
+        mLoaded = NO_CHANNEL;
+    }
+    return Status::OK;
+}
+
+
+Status FilterBank::Reset(uint8_t channel)
+{
+    if (channel >= MAX_CHANNELS)
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    Utils::CriticalSection cs;
+    if (IsRunning(channel))
+    {
+        return Status::BUSY;
+    }
+    mChannels[channel].state.Clear();
+    return Status::OK;
+}
+
+
+Status FilterBank::Submit(FilterBlock& block)
+{
+    bool valid = (block.channel < MAX_CHANNELS) && (block.count > 0U) && (block.pInput != nullptr)
+                 && (block.pOutput != nullptr);
+    if (valid)
+    {
+        // the delay lines are advanced from the block, the input must survive the filter
+        const int16_t* pIn = block.pInput;
+        const int16_t* pOut = block.pOutput;
+        valid = mChannels[block.channel].config.IsValid()
+                && (((pOut + block.count) <= pIn) || ((pIn + block.count) <= pOut));
+    }
+    if (!valid)
+    {
+        block.status = Status::INVALID_PARAM;
+        return Status::INVALID_PARAM;
+    }
+
+    block.status = Status::PENDING;
+    block.pNext = nullptr;
+    {
+        Utils::CriticalSection cs;
+        if (mpTail != nullptr)
+        {
+            mpTail->pNext = &block;
+        }
+        else
+        {
+            mpHead = &block;
+        }
+        mpTail = &block;
+    }
+
+    StartNext();
+    return Status::PENDING;
+}
+
+
+bool FilterBank::IsIdle() const
+{
+    Utils::CriticalSection cs;
+    return (mpActive == nullptr) && (mpHead == nullptr);
+}
+
+
+bool FilterBank::IsRunning(uint8_t channel) const
+{
+    const FilterBlock* pActive = mpActive;
+    return (pActive != nullptr) && (pActive->channel == channel);
+}
+
+
+void FilterBank::StartNext()
+{
+    for (;;)
+    {
+        FilterBlock* pBlock{nullptr};
+        {
+            Utils::CriticalSection cs;
+            if ((mpActive != nullptr) || (mpHead == nullptr) || mStarting)
+            {
+                return;
+            }
+            pBlock = mpHead;
+            mpHead = pBlock->pNext;
+            if (mpHead == nullptr)
+            {
+                mpTail = nullptr;
+            }
+            pBlock->pNext = nullptr;
+            mpActive = pBlock;
+            mStarting = true;
+
+            const uint8_t channel = pBlock->channel;
+            mJob.pConfig = &mChannels[channel].config;
+            mJob.pState = &mChannels[channel].state;
+            mJob.pBlock = pBlock;
+            mJob.loadCoefficients = (mLoaded != channel);
+            if (mJob.loadCoefficients)
+            {
+                mLoaded = channel;
+                mLoads = mLoads + 1U;
+            }
+        }
+
+        const Status status = mEngine.Start(mJob);
+
+        {
+            Utils::CriticalSection cs;
+            mStarting = false;
+            if (status != Status::OK)
+            {
+                mpActive = nullptr;
+                mLoaded = NO_CHANNEL;
+            }
+        }
+
+        if (status != Status::OK)
+        {
+            Finish(*pBlock, status);
+        }
+    }
+}
+
+
+void FilterBank::OnJobDone(const FilterJob& job, Status status)
+{
+    // the job is reused by the next block
+    FilterBlock& block = *job.pBlock;
+    {
+        Utils::CriticalSection cs;
+        if (status == Status::OK)
+        {
+            Channel& ch = mChannels[block.channel];
+            ch.state.Advance(ch.config, block.pInput, block.pOutput, block.count);
+        }
+        else
+        {
+            // the engine state is unknown
+            mLoaded = NO_CHANNEL;
+        }
+        mpActive = nullptr;
+    }
+
+    // keep the engine busy while the callback of the finished block runs
+    StartNext();
+    Finish(block, status);
+}
+
+
+void FilterBank::Finish(FilterBlock& block, Status status)
+{
+    {
+        Utils::CriticalSection cs;
+        mCompleted = mCompleted + 1U;
+    }
+    block.status = status;
+    if (block.pCallback != nullptr)
+    {
+        block.pCallback(block, block.pContext);
+    }
+}
@@ -0,0 +1,158 @@
+/**
+ ********************************************************************************
+ * @file        FilterBank.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, multi channel filter bank on one filter engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IFilterEngine.hpp"
+#include <array>
+#include <cstdint>
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides up to @ref MAX_CHANNELS q1.15 filter channels which share one filter engine.
+ * @details Every channel owns a copy of its coefficients and its delay lines. Blocks are linked intrusively
+ *          into a FIFO and run one after the other, the delay lines of the channel are preloaded before and
+ *          advanced after each block, so the blocks of a channel form a continuous stream.\n
+ *          The coefficients are only loaded into the engine when the block belongs to another channel than
+ *          the previous one or the channel was reconfigured. Queue the blocks of a channel back to back
+ *          (e.g. all halves of one ADC buffer) to save the loads.\n
+ *          @ref Configure swaps the coefficients between two blocks, blocks already queued use the new
+ *          filter. As for CryptoService the next block is started before the callback of the finished one.
+ * @note    The input of a block may be an ADC DMA buffer half, configure the ADC for q1.15 (offset with
+ *          signed saturation and left alignment), the input and output of a block must not overlap.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.\n
+ * Submit may be called from threads and ISR's (e.g. the ADC half / complete callbacks), the completion
+ * path runs in the engine context.
+ *
+ */
+class FilterBank : private IFilterEngine::IListener
+{
+    public:
+
+        /// @brief Count of channels.
+        static constexpr uint8_t MAX_CHANNELS{8U};
+
+        /**
+         * @brief   Constructs the bank and binds it to the engine.
+         *
+         * @param   engine      The engine which filters the blocks.
+         */
+        explicit FilterBank(IFilterEngine& engine);
+
+        /// @brief Destructor, unbinds the engine.
+        ~FilterBank();
+
+        FilterBank(FilterBank const &) = delete;             //!< Copy constructor
+        FilterBank& operator=(FilterBank const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Set the filter of a channel, the coefficients are copied.
+         *
+         * @param   channel     The channel.
+         * @param   config      The filter.
+         * @param   keepState   Keep the delay lines if the tap counts did not change (smooth swap),
+         *                      otherwise they are cleared.
+         *
+         * @return  OK, INVALID_PARAM or BUSY while a block of the channel is running.
+         */
+        Status Configure(uint8_t channel, const FilterConfig& config, bool keepState = false);
+
+        /**
+         * @brief   Clear the delay lines of a channel.
+         *
+         * @param   channel     The channel.
+         *
+         * @return  OK, INVALID_PARAM or BUSY while a block of the channel is running.
+         */
+        Status Reset(uint8_t channel);
+
+        /**
+         * @brief   Validate and queue a block.
+         *
+         * @param   block   The block descriptor, owned by the caller until completion.
+         *
+         * @return  PENDING if queued, INVALID_PARAM if the descriptor was rejected.
+         */
+        Status Submit(FilterBlock& block);
+
+        /// @brief True if no block is queued or running.
+        bool IsIdle() const;
+
+        /// @brief Count of finished blocks since construction.
+        uint32_t GetCompletedCount() const {return mCompleted;};
+
+        /// @brief Count of coefficient loads into the engine since construction.
+        uint32_t GetCoefficientLoads() const {return mLoads;};
+
+    private:
+
+        /// @brief No channel holds the engine coefficients.
+        static constexpr uint8_t NO_CHANNEL{0xFFU};
+
+        /// @brief A configured channel.
+        struct Channel
+        {
+            FilterConfig config{};                  //!< Filter, the pointers refer to the arrays below
+            std::array<int16_t, MAX_TAPS_B> b{};    //!< Copy of the B coefficients
+            std::array<int16_t, MAX_TAPS_A> a{};    //!< Copy of the A coefficients
+            FilterState state{};                    //!< Delay lines
+        };
+
+        /// @brief Engine completion, see IFilterEngine::IListener.
+        void OnJobDone(const FilterJob& job, Status status) override;
+
+        /// @brief Start queued blocks while the engine is idle.
+        void StartNext();
+
+        /// @brief Publish the result and call the user callback.
+        void Finish(FilterBlock& block, Status status);
+
+        /// @brief True if a block of the channel runs.
+        bool IsRunning(uint8_t channel) const;
+
+        /// @brief The executing engine.
+        IFilterEngine& mEngine;
+
+        /// @brief The channels.
+        std::array<Channel, MAX_CHANNELS> mChannels{};
+
+        /// @brief The job owned by the engine.
+        FilterJob mJob{};
+
+        /// @brief Channel whose coefficients the engine holds.
+        volatile uint8_t mLoaded{NO_CHANNEL};
+
+        /// @brief First queued block.
+        FilterBlock* mpHead{nullptr};
+
+        /// @brief Last queued block.
+        FilterBlock* mpTail{nullptr};
+
+        /// @brief Block owned by the engine.
+        FilterBlock* volatile mpActive{nullptr};
+
+        /// @brief Set while IFilterEngine::Start runs, turns synchronous completions into a loop.
+        volatile bool mStarting{false};
+
+        /// @brief Finished blocks.
+        volatile uint32_t mCompleted{0U};
+
+        /// @brief Coefficient loads.
+        volatile uint32_t mLoads{0U};
+};
+
+} // end namespace Dsp
@@ -0,0 +1,254 @@
+/**
+ ********************************************************************************
+ * @file        FilterEngineHal.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, FMAC filter engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FilterEngineHal.hpp"
+#include "DCache.hpp"
+
+#if defined(FMAC)
+
+using namespace Dsp;
+
+FilterEngineHal* FilterEngineHal::spInstance{nullptr};
+
+namespace {
+
+/// @brief The HAL takes non const pointers for buffers it only reads.
+inline int16_t* Source(const int16_t* p)
+{
+    return const_cast<int16_t*>(p); // NOSONAR read by the DMA only
+}
+
+} // end anonymous namespace
+
+
+FilterEngineHal::FilterEngineHal(FMAC_HandleTypeDef& hfmac)
+: mHfmac(hfmac)
+{
+    spInstance = this;
+}
+
+
+FilterEngineHal::~FilterEngineHal()
+{
+    (void)HAL_FMAC_FilterStop(&mHfmac);
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+FilterEngineHal* FilterEngineHal::GetInstance(const FMAC_HandleTypeDef* hfmac)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHfmac == hfmac))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status FilterEngineHal::Start(const FilterJob& job)
+{
+    if (mBusy)
+    {
+        return Status::BUSY;
+    }
+    const FilterConfig& config = *job.pConfig;
+    if (!config.IsValid() || (job.pBlock == nullptr) || (job.pBlock->count == 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mJob = job;
+    mBusy = true;
+
+    const FilterBlock& block = *job.pBlock;
+    Utils::DCache::Clean(block.pInput, block.count * sizeof(int16_t));
+    Utils::DCache::Clean(job.pState, sizeof(FilterState));
+    // no dirty line may be evicted into the output while the DMA writes it
+    Utils::DCache::Clean(block.pOutput, block.count * sizeof(int16_t));
+
+    Status status = Status::OK;
+    if (job.loadCoefficients)
+    {
+        const uint8_t taps = config.tapsB;
+        const uint8_t feedback = static_cast<uint8_t>(config.OutputHistory());
+        FMAC_FilterConfigTypeDef cfg{};
+        cfg.InputBaseAddress = 0U;
+        cfg.InputBufferSize = taps + HEADROOM;
+        cfg.InputThreshold = FMAC_THRESHOLD_1;
+        cfg.CoeffBaseAddress = cfg.InputBufferSize;
+        cfg.CoeffBufferSize = taps + feedback;
+        cfg.OutputBaseAddress = cfg.CoeffBaseAddress + cfg.CoeffBufferSize;
+        cfg.OutputBufferSize = feedback + HEADROOM;
+        cfg.OutputThreshold = FMAC_THRESHOLD_1;
+        cfg.pCoeffB = Source(config.pB);
+        cfg.CoeffBSize = taps;
+        cfg.pCoeffA = (feedback > 0U) ? Source(config.pA) : nullptr;
+        cfg.CoeffASize = feedback;
+        cfg.InputAccess = FMAC_BUFFER_ACCESS_DMA;
+        cfg.OutputAccess = FMAC_BUFFER_ACCESS_DMA;
+        cfg.Clip = config.clip ? FMAC_CLIP_ENABLED : FMAC_CLIP_DISABLED;
+        cfg.Filter = (config.type == FilterType::IIR) ? FMAC_FUNC_IIR_DIRECT_FORM_1 : FMAC_FUNC_CONVO_FIR;
+        cfg.P = taps;
+        cfg.Q = feedback;
+        cfg.R = config.gain;
+        Utils::DCache::Clean(config.pB, taps * sizeof(int16_t));
+        if (feedback > 0U)
+        {
+            Utils::DCache::Clean(config.pA, feedback * sizeof(int16_t));
+        }
+        status = ToStatus(HAL_FMAC_FilterConfig_DMA(&mHfmac, &cfg));
+    }
+    else
+    {
+        status = Preload();
+    }
+
+    if (status != Status::OK)
+    {
+        mBusy = false;
+    }
+    return status;
+}
+
+
+Status FilterEngineHal::Preload()
+{
+    const FilterConfig& config = *mJob.pConfig;
+    const FilterState& state = *mJob.pState;
+    const uint8_t feedback = static_cast<uint8_t>(config.OutputHistory());
+    return ToStatus(HAL_FMAC_FilterPreload_DMA(&mHfmac, Source(state.x.data()),
+                                               static_cast<uint8_t>(config.InputHistory()),
+                                               (feedback > 0U) ? Source(state.y.data()) : nullptr, feedback));
+}
+
+
+Status FilterEngineHal::Stream()
+{
+    FilterBlock& block = *mJob.pBlock;
+    mOutputSize = block.count;
+    mInputSize = block.count;
+    Status status = ToStatus(HAL_FMAC_FilterStart(&mHfmac, block.pOutput, &mOutputSize));
+    if (status == Status::OK)
+    {
+        status = ToStatus(HAL_FMAC_AppendFilterData(&mHfmac, Source(block.pInput), &mInputSize));
+    }
+    return status;
+}
+
+
+void FilterEngineHal::OnConfigDone()
+{
+    const Status status = Preload();
+    if (status != Status::OK)
+    {
+        Complete(status);
+    }
+}
+
+
+void FilterEngineHal::OnPreloadDone()
+{
+    const Status status = Stream();
+    if (status != Status::OK)
+    {
+        Complete(status);
+    }
+}
+
+
+void FilterEngineHal::OnOutputDone()
+{
+    const FilterBlock& block = *mJob.pBlock;
+    Utils::DCache::Invalidate(block.pOutput, block.count * sizeof(int16_t));
+    Complete(Status::OK);
+}
+
+
+void FilterEngineHal::OnError()
+{
+    Complete(Status::HW_ERROR);
+}
+
+
+void FilterEngineHal::Complete(Status status)
+{
+    if (!mBusy)
+    {
+        return;
+    }
+    // resets the buffer pointers, the coefficients in X2 stay
+    (void)HAL_FMAC_FilterStop(&mHfmac);
+    mBusy = false;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnJobDone(mJob, status);
+    }
+}
+
+
+Status FilterEngineHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_FMAC_FilterConfigCallback(FMAC_HandleTypeDef* hfmac)
+{
+    FilterEngineHal* pEngine = FilterEngineHal::GetInstance(hfmac);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnConfigDone();
+    }
+}
+
+
+extern "C" void HAL_FMAC_FilterPreloadCallback(FMAC_HandleTypeDef* hfmac)
+{
+    FilterEngineHal* pEngine = FilterEngineHal::GetInstance(hfmac);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnPreloadDone();
+    }
+}
+
+
+extern "C" void HAL_FMAC_OutputDataReadyCallback(FMAC_HandleTypeDef* hfmac)
+{
+    FilterEngineHal* pEngine = FilterEngineHal::GetInstance(hfmac);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnOutputDone();
+    }
+}
+
+
+extern "C" void HAL_FMAC_ErrorCallback(FMAC_HandleTypeDef* hfmac)
+{
+    FilterEngineHal* pEngine = FilterEngineHal::GetInstance(hfmac);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnError();
+    }
+}
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ ********************************************************************************
+ * @file        FilterEngineHal.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, filter engine on the FMAC.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IFilterEngine.hpp"
+#include "stm32h7xx_hal.h"
+
+#if defined(FMAC)
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the IFilterEngine on the FMAC of the STM32H7, every transfer runs by DMA.
+ * @details A job is a chain of interrupts:
+ *          1. HAL_FMAC_FilterConfig_DMA loads the coefficients (only if the job requests it),
+ *             HAL_FMAC_FilterConfigCallback follows
+ *          2. HAL_FMAC_FilterPreload_DMA loads the delay lines of the channel into X1 and Y,
+ *             HAL_FMAC_FilterPreloadCallback follows
+ *          3. HAL_FMAC_FilterStart with the output buffer and HAL_FMAC_AppendFilterData with the input
+ *             buffer stream the block, HAL_FMAC_OutputDataReadyCallback follows the last output
+ *          4. HAL_FMAC_FilterStop, the job is reported.
+ *
+ *          The internal memory holds X1 (taps + headroom), X2 (the coefficients) and Y (feedback taps +
+ *          headroom) back to back. The stop resets the buffer pointers only, the coefficients in X2 stay
+ *          valid for the next block of the same channel. The D-Cache lines of the buffers are cleaned
+ *          before and the output lines invalidated after the transfer.
+ * @note    Only available on devices with FMAC (STM32H72x/H73x/H7Ax/H7Bx), the STM32H743 has none, use
+ *          FilterEngineSoft there.\n
+ *          The application initialises the handle with HAL_FMAC_Init, links the preload, input and
+ *          output DMA handles in HAL_FMAC_MspInit (memory to memory for the preload, FMAC_WR and
+ *          FMAC_RD requests for the streams) and calls HAL_FMAC_IRQHandler and the DMA handlers.
+ *          The buffers must be located in a DMA accessible RAM (not DTCM), the output buffer should be
+ *          32 byte aligned. One FMAC instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one FilterBank.
+ *
+ */
+class FilterEngineHal : public IFilterEngine
+{
+    public:
+
+        /// @brief Free words behind the taps in X1 and Y, lets the DMA run ahead of the filter.
+        static constexpr uint8_t HEADROOM{4U};
+
+        /**
+         * @brief   Constructs the engine for an initialised FMAC handle.
+         *
+         * @param   hfmac       The FMAC handle.
+         */
+        explicit FilterEngineHal(FMAC_HandleTypeDef& hfmac);
+
+        /// @brief Destructor.
+        ~FilterEngineHal() override;
+
+        /// @copydoc IFilterEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IFilterEngine::Start
+        Status Start(const FilterJob& job) override;
+
+        /// @brief Coefficients loaded, called by HAL_FMAC_FilterConfigCallback.
+        void OnConfigDone();
+
+        /// @brief Delay lines loaded, called by HAL_FMAC_FilterPreloadCallback.
+        void OnPreloadDone();
+
+        /// @brief Last output written, called by HAL_FMAC_OutputDataReadyCallback.
+        void OnOutputDone();
+
+        /// @brief Peripheral or DMA error, called by HAL_FMAC_ErrorCallback.
+        void OnError();
+
+        /// @brief Engine bound to a FMAC handle or nullptr.
+        static FilterEngineHal* GetInstance(const FMAC_HandleTypeDef* hfmac);
+
+    private:
+
+        /// @brief Load the delay lines.
+        Status Preload();
+
+        /// @brief Stream the block.
+        Status Stream();
+
+        /// @brief Stop the filter and report the job.
+        void Complete(Status status);
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The FMAC handle.
+        FMAC_HandleTypeDef& mHfmac;
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief The running job.
+        FilterJob mJob{};
+
+        /// @brief Set while a job runs.
+        volatile bool mBusy{false};
+
+        /// @brief Input count for HAL_FMAC_AppendFilterData.
+        uint16_t mInputSize{0U};
+
+        /// @brief Output count for HAL_FMAC_FilterStart.
+        uint16_t mOutputSize{0U};
+
+        /// @brief The single engine instance, the device has one FMAC.
+        static FilterEngineHal* spInstance;
+};
+
+} // end namespace Dsp
+#endif
@@ -0,0 +1,242 @@
+/**
+ ********************************************************************************
+ * @file        FilterEngineSoft.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, software filter engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FilterEngineSoft.hpp"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief Left shift which moves the 26 bit accumulator into the upper bits (sign extension).
+constexpr uint32_t ACC_ALIGN{6U};
+
+/// @brief Right shift from the aligned accumulator (q4.28) to q1.15 without gain.
+constexpr uint32_t OUTPUT_SHIFT{13U};
+
+/// @brief A truncated product q1.15 x q1.15 -> q2.22.
+inline int32_t Product(int16_t x, int16_t c)
+{
+    return (static_cast<int32_t>(x) * static_cast<int32_t>(c)) >> 8;
+}
+
+/// @brief Output stage of the FMAC: 26 bit wrap, gain, q1.15 and saturation or wrap.
+inline int16_t Output(int32_t acc, uint32_t gain, bool clip)
+{
+    const int32_t value = static_cast<int32_t>(static_cast<uint32_t>(acc) << ACC_ALIGN) >> (OUTPUT_SHIFT - gain);
+    if (clip)
+    {
+        return static_cast<int16_t>(std::clamp(value, -32768, 32767));
+    }
+    return static_cast<int16_t>(value);
+}
+
+void SumsScalar(const int16_t* pIn, const int16_t* pCoeff, uint32_t taps, int32_t* pSums, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        int32_t acc = 0;
+        for (uint32_t j = 0U; j < taps; j++)
+        {
+            acc += Product(pIn[i + j], pCoeff[j]);
+        }
+        pSums[i] = acc;
+    }
+}
+
+void OutputsScalar(const int32_t* pSums, int16_t* pOut, uint32_t count, uint32_t gain, bool clip)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        pOut[i] = Output(pSums[i], gain, clip);
+    }
+}
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+
+bool CpuHasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}
+
+/// @brief 16 windows per step, the 32 bit products are truncated like the scalar ones.
+__attribute__((target("avx2")))
+void SumsAvx2(const int16_t* pIn, const int16_t* pCoeff, uint32_t taps, int32_t* pSums, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        for (uint32_t j = 0U; j < taps; j++)
+        {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pIn[i + j]));
+            const __m256i c = _mm256_set1_epi16(pCoeff[j]);
+            const __m256i lo = _mm256_mullo_epi16(x, c);
+            const __m256i hi = _mm256_mulhi_epi16(x, c);
+            // acc0 holds the outputs 0..3 and 8..11, acc1 4..7 and 12..15
+            acc0 = _mm256_add_epi32(acc0, _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), 8));
+            acc1 = _mm256_add_epi32(acc1, _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), 8));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pSums[i]), _mm256_permute2x128_si256(acc0, acc1, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pSums[i + 8U]),
+                            _mm256_permute2x128_si256(acc0, acc1, 0x31));
+    }
+    SumsScalar(&pIn[i], pCoeff, taps, &pSums[i], count - i);
+}
+
+__attribute__((target("avx2")))
+void OutputsAvx2(const int32_t* pSums, int16_t* pOut, uint32_t count, uint32_t gain, bool clip)
+{
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(OUTPUT_SHIFT - gain));
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+    uint32_t i = 0U;
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pSums[i]));
+        __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pSums[i + 8U]));
+        v0 = _mm256_sra_epi32(_mm256_slli_epi32(v0, ACC_ALIGN), shift);
+        v1 = _mm256_sra_epi32(_mm256_slli_epi32(v1, ACC_ALIGN), shift);
+        __m256i packed{};
+        if (clip)
+        {
+            packed = _mm256_packs_epi32(v0, v1);
+        }
+        else
+        {
+            packed = _mm256_packus_epi32(_mm256_and_si256(v0, mask), _mm256_and_si256(v1, mask));
+        }
+        // the packs interleave the 128 bit lanes
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[i]), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    OutputsScalar(&pSums[i], &pOut[i], count - i, gain, clip);
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+FilterEngineSoft::FilterEngineSoft(Kernel kernel)
+: mKernel(std::min(kernel, GetBestKernel()))
+{
+}
+
+
+FilterEngineSoft::Kernel FilterEngineSoft::GetBestKernel()
+{
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (CpuHasAvx2())
+    {
+        return Kernel::AVX2;
+    }
+#endif
+    return Kernel::SCALAR;
+}
+
+
+Status FilterEngineSoft::Start(const FilterJob& job)
+{
+    mState = *job.pState;
+    const FilterBlock& block = *job.pBlock;
+    const Status status = Process(*job.pConfig, mState, block.pInput, block.pOutput, block.count);
+    if (mpListener != nullptr)
+    {
+        mpListener->OnJobDone(job, status);
+    }
+    return Status::OK;
+}
+
+
+Status FilterEngineSoft::Process(const FilterConfig& config, FilterState& state, const int16_t* pInput,
+                                 int16_t* pOutput, uint32_t count)
+{
+    if (!config.IsValid() || ((count > 0U) && ((pInput == nullptr) || (pOutput == nullptr))))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    const uint32_t inHistory = config.InputHistory();
+    const uint32_t outHistory = config.OutputHistory();
+    for (uint32_t j = 0U; j < config.tapsB; j++)
+    {
+        mCoeffB[j] = config.pB[inHistory - j];
+    }
+    (void)std::memcpy(mInput.data(), state.x.data(), inHistory * sizeof(int16_t));
+    (void)std::memcpy(mOutput.data(), state.y.data(), outHistory * sizeof(int16_t));
+
+    while (count > 0U)
+    {
+        const uint32_t n = std::min(count, CHUNK_SAMPLES);
+        (void)std::memcpy(&mInput[inHistory], pInput, n * sizeof(int16_t));
+        SumB(config, n);
+
+        if (config.type == FilterType::FIR)
+        {
+#if defined(DSP_HAS_X86_INTRINSICS)
+            if (mKernel == Kernel::AVX2)
+            {
+                OutputsAvx2(mSums.data(), pOutput, n, config.gain, config.clip);
+            }
+            else
+#endif
+            {
+                OutputsScalar(mSums.data(), pOutput, n, config.gain, config.clip);
+            }
+        }
+        else
+        {
+            // the feedback needs the previous output, this part is serial
+            int16_t* pY = &mOutput[outHistory];
+            for (uint32_t i = 0U; i < n; i++)
+            {
+                int32_t acc = mSums[i];
+                for (uint32_t k = 1U; k <= outHistory; k++)
+                {
+                    acc += Product(pY[static_cast<int32_t>(i) - static_cast<int32_t>(k)], config.pA[k - 1U]);
+                }
+                pY[i] = Output(acc, config.gain, config.clip);
+            }
+            (void)std::memcpy(pOutput, pY, n * sizeof(int16_t));
+            (void)std::memmove(mOutput.data(), &mOutput[n], outHistory * sizeof(int16_t));
+        }
+
+        (void)std::memmove(mInput.data(), &mInput[n], inHistory * sizeof(int16_t));
+        pInput = &pInput[n];
+        pOutput = &pOutput[n];
+        count -= n;
+    }
+
+    (void)std::memcpy(state.x.data(), mInput.data(), inHistory * sizeof(int16_t));
+    (void)std::memcpy(state.y.data(), mOutput.data(), outHistory * sizeof(int16_t));
+    return Status::OK;
+}
+
+
+void FilterEngineSoft::SumB(const FilterConfig& config, uint32_t count)
+{
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (mKernel == Kernel::AVX2)
+    {
+        SumsAvx2(mInput.data(), mCoeffB.data(), config.tapsB, mSums.data(), count);
+        return;
+    }
+#endif
+    SumsScalar(mInput.data(), mCoeffB.data(), config.tapsB, mSums.data(), count);
+}
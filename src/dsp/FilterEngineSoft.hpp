@@ -0,0 +1,122 @@
+/**
+ ********************************************************************************
+ * @file        FilterEngineSoft.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, bit-exact software model of the FMAC filters.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IFilterEngine.hpp"
+#include <array>
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides a software filter engine with the IFilterEngine interface.
+ * @details The job is processed synchronously inside @ref Start and reported to the listener before Start
+ *          returns. The arithmetic follows the FMAC of the STM32H7 (RM0433), so the outputs are bit identical
+ *          to the hardware:
+ *          - every q1.15 x q1.15 product is truncated to q2.22 (the 8 lsb are dropped)
+ *          - the products are summed in a 26 bit accumulator (q4.22) which wraps around
+ *          - the accumulator is shifted left by the gain and truncated to q1.15, then saturated (clip) or
+ *            wrapped to 16 bit
+ *          - the IIR feedback uses the stored q1.15 outputs.
+ *
+ *          The samples are processed in chunks behind a copy of the input delay line. On the host the FIR
+ *          sums (and the feed forward sums of an IIR) use AVX2 for 16 outputs per step, the IIR feedback is
+ *          serial. Both kernels give identical outputs, the scalar one is the reference.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class FilterEngineSoft : public IFilterEngine
+{
+    public:
+
+        /// @brief Kernel sets.
+        enum class Kernel : uint8_t
+        {
+            SCALAR=0,   //!< Portable C++
+            AVX2=1      //!< 16 outputs per step
+        };
+
+        /// @brief Constructor, uses the best kernel set of the CPU.
+        FilterEngineSoft() : FilterEngineSoft(GetBestKernel()) {};
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit FilterEngineSoft(Kernel kernel);
+
+        /// @brief Destructor.
+        ~FilterEngineSoft() override = default;
+
+        /// @copydoc IFilterEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IFilterEngine::Start
+        Status Start(const FilterJob& job) override;
+
+        /**
+         * @brief   Filter samples without listener (blocking) and advance the delay lines.
+         *
+         * @param   config      The filter.
+         * @param   state       Delay lines, updated to the end of the samples.
+         * @param   pInput      Input samples.
+         * @param   pOutput     Output samples, may be the input (in place).
+         * @param   count       Count of samples.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Process(const FilterConfig& config, FilterState& state, const int16_t* pInput, int16_t* pOutput,
+                       uint32_t count);
+
+        /// @brief The kernel set in use.
+        Kernel GetKernel() const {return mKernel;};
+
+        /// @brief The best kernel set of the CPU.
+        static Kernel GetBestKernel();
+
+    private:
+
+        /// @brief Samples per chunk, keeps the buffers in L1.
+        static constexpr uint32_t CHUNK_SAMPLES{256U};
+
+        /// @brief Feed forward sums (accumulator before the output stage) of a chunk.
+        void SumB(const FilterConfig& config, uint32_t count);
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief The kernel set.
+        Kernel mKernel;
+
+        /// @brief B coefficients in reverse order, so an output is a dot product with the input window.
+        alignas(32) std::array<int16_t, MAX_TAPS_B> mCoeffB{};
+
+        /// @brief Input delay line followed by the input chunk.
+        alignas(32) std::array<int16_t, (MAX_TAPS_B - 1U) + CHUNK_SAMPLES> mInput{};
+
+        /// @brief Output delay line followed by the output chunk (IIR).
+        std::array<int16_t, MAX_TAPS_A + CHUNK_SAMPLES> mOutput{};
+
+        /// @brief Accumulators of a chunk.
+        alignas(32) std::array<int32_t, CHUNK_SAMPLES> mSums{};
+
+        /// @brief Copy of the delay lines of a started job.
+        FilterState mState{};
+};
+
+} // end namespace Dsp
@@ -0,0 +1,158 @@
+/**
+ ********************************************************************************
+ * @file        FilterTypes.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, common types of the filter bank and its engines.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DspTypes.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+namespace Dsp {
+
+
+/// @brief Structure of a filter.
+enum class FilterType : uint8_t
+{
+    FIR=0,      //!< Convolution with the B coefficients
+    IIR=1       //!< Direct form 1 with B (feed forward) and A (feedback) coefficients
+};
+
+/// @brief Maximum of B coefficients (FIR taps).
+constexpr uint32_t MAX_TAPS_B{64U};
+
+/// @brief Maximum of A coefficients (IIR feedback taps).
+constexpr uint32_t MAX_TAPS_A{32U};
+
+/// @brief Maximum gain, the output is shifted left by 0..7 bits.
+constexpr uint8_t MAX_GAIN{7U};
+
+
+/**
+ * @brief   Configuration of a q1.15 filter channel, as the FMAC computes it.
+ * @details y[n] = (sum(b[k] * x[n - k], k = 0..tapsB-1) + sum(a[k - 1] * y[n - k], k = 1..tapsA)) * 2^gain\n
+ *          The feedback coefficients are added, so A holds the negated denominator a1..aQ of the usual
+ *          notation. Coefficients larger than one in magnitude are scaled down and the gain shifts the
+ *          result back.
+ */
+struct FilterConfig
+{
+    FilterType type{FilterType::FIR};   //!< FIR or IIR
+    const int16_t* pB{nullptr};         //!< Feed forward coefficients b0..b(tapsB-1), q1.15
+    uint8_t tapsB{0U};                  //!< Count of B coefficients, 2..MAX_TAPS_B
+    const int16_t* pA{nullptr};         //!< IIR: feedback coefficients a1..a(tapsA), q1.15
+    uint8_t tapsA{0U};                  //!< IIR: count of A coefficients, 1..MAX_TAPS_A
+    uint8_t gain{0U};                   //!< Output shift 0..MAX_GAIN
+    bool clip{true};                    //!< Saturate the output to q1.15, otherwise it wraps around
+
+    /// @brief Check the configuration.
+    constexpr bool IsValid() const
+    {
+        return (pB != nullptr) && (tapsB >= 2U) && (tapsB <= MAX_TAPS_B) && (gain <= MAX_GAIN)
+               && ((type == FilterType::FIR)
+                   || ((pA != nullptr) && (tapsA >= 1U) && (tapsA <= MAX_TAPS_A)));
+    };
+
+    /// @brief Count of inputs in the history.
+    constexpr uint32_t InputHistory() const {return tapsB - 1U;};
+
+    /// @brief Count of outputs in the history.
+    constexpr uint32_t OutputHistory() const {return (type == FilterType::IIR) ? tapsA : 0U;};
+};
+
+
+/**
+ * @brief   Delay lines of a filter channel, in time order (the newest sample last).
+ * @details The delay lines are what the FMAC X1 and Y buffers are preloaded with before a block, so
+ *          a channel continues seamlessly on a shared FMAC.
+ */
+struct FilterState
+{
+    std::array<int16_t, MAX_TAPS_B - 1U> x{};  //!< The last inputs (InputHistory)
+    std::array<int16_t, MAX_TAPS_A> y{};       //!< The last outputs (OutputHistory)
+
+    /// @brief Clear the delay lines.
+    void Clear()
+    {
+        x.fill(0);
+        y.fill(0);
+    };
+
+    /**
+     * @brief   Append a processed block to the delay lines.
+     *
+     * @param   config  The filter.
+     * @param   pInput  The inputs of the block.
+     * @param   pOutput The outputs of the block.
+     * @param   count   Samples of the block.
+     */
+    void Advance(const FilterConfig& config, const int16_t* pInput, const int16_t* pOutput, uint32_t count)
+    {
+        Shift(x.data(), config.InputHistory(), pInput, count);
+        Shift(y.data(), config.OutputHistory(), pOutput, count);
+    };
+
+    private:
+
+        /// @brief Keep the newest samples of a delay line and a block.
+        static void Shift(int16_t* pLine, uint32_t length, const int16_t* pBlock, uint32_t count)
+        {
+            if (count >= length)
+            {
+                (void)std::memcpy(pLine, &pBlock[count - length], length * sizeof(int16_t));
+            }
+            else
+            {
+                (void)std::memmove(pLine, &pLine[count], (length - count) * sizeof(int16_t));
+                (void)std::memcpy(&pLine[length - count], pBlock, count * sizeof(int16_t));
+            }
+        };
+};
+
+
+/**
+ * @brief   Descriptor of one block of a filter channel.
+ * @details The descriptor and the buffers are owned by the caller and must stay valid until the completion
+ *          callback has been called (or @ref status left PENDING). The input may be a half of an ADC DMA
+ *          buffer, the ADC delivers q1.15 with its offset and signed saturation (left aligned).
+ */
+struct FilterBlock
+{
+    /// @brief Completion callback, called from the engine context.
+    using Callback = void (*)(FilterBlock& block, void* pContext);
+
+    uint8_t channel{0U};                //!< Filter channel
+    const int16_t* pInput{nullptr};     //!< Input samples, q1.15
+    int16_t* pOutput{nullptr};          //!< Output samples, q1.15
+    uint16_t count{0U};                 //!< Samples of the block
+
+    Callback pCallback{nullptr};        //!< Optional completion callback
+    void* pContext{nullptr};            //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or running.
+    volatile Status status{Status::OK};
+
+    /// @brief Intrusive queue link, owned by the filter bank.
+    FilterBlock* pNext{nullptr};
+};
+
+
+/// @brief A block for an engine: the channel filter, its delay lines and the samples.
+struct FilterJob
+{
+    const FilterConfig* pConfig{nullptr};   //!< The filter
+    const FilterState* pState{nullptr};     //!< Delay lines before the block
+    FilterBlock* pBlock{nullptr};           //!< The samples
+    bool loadCoefficients{true};            //!< The engine holds another filter, load this one
+};
+
+} // end namespace Dsp
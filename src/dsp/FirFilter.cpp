@@ -0,0 +1,121 @@
+/**
+ ********************************************************************************
+ * @file        FirFilter.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float FIR filter implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FirFilter.hpp"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Dsp;
+
+namespace {
+
+void DotsScalar(const float* pWindow, const float* pReversed, uint32_t taps, float* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        float acc = 0.0F;
+        for (uint32_t j = 0U; j < taps; j++)
+        {
+            const float product = pReversed[j] * pWindow[i + j];
+            acc = acc + product;
+        }
+        pOut[i] = acc;
+    }
+}
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+
+/// @brief 16 outputs per step, every lane sums like the scalar kernel.
+__attribute__((target("avx2")))
+void DotsAvx2(const float* pWindow, const float* pReversed, uint32_t taps, float* pOut, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        for (uint32_t j = 0U; j < taps; j++)
+        {
+            const __m256 c = _mm256_set1_ps(pReversed[j]);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(c, _mm256_loadu_ps(&pWindow[i + j])));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(c, _mm256_loadu_ps(&pWindow[i + j + 8U])));
+        }
+        _mm256_storeu_ps(&pOut[i], acc0);
+        _mm256_storeu_ps(&pOut[i + 8U], acc1);
+    }
+    DotsScalar(&pWindow[i], pReversed, taps, &pOut[i], count - i);
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+FirFilter::FirFilter(SimdKernel kernel)
+: mKernel(std::min(kernel, GetBestSimdKernel()))
+{
+}
+
+
+Status FirFilter::Configure(std::span<const float> coefficients)
+{
+    if (coefficients.empty() || (coefficients.size() > MAX_TAPS))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mTaps = static_cast<uint32_t>(coefficients.size());
+    std::reverse_copy(coefficients.begin(), coefficients.end(), mReversed.begin());
+    Reset();
+    return Status::OK;
+}
+
+
+void FirFilter::Reset()
+{
+    mWindow.fill(0.0F);
+}
+
+
+Status FirFilter::Process(std::span<const float> in, std::span<float> out)
+{
+    if ((mTaps == 0U) || (out.size() < in.size()))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    const uint32_t history = mTaps - 1U;
+    size_t done = 0U;
+    while (done < in.size())
+    {
+        const uint32_t count = static_cast<uint32_t>(std::min<size_t>(BLOCK, in.size() - done));
+        // copy first, the output may be the input
+        std::memcpy(&mWindow[history], &in[done], count * sizeof(float));
+#if defined(DSP_HAS_X86_INTRINSICS)
+        if (mKernel == SimdKernel::AVX2)
+        {
+            DotsAvx2(mWindow.data(), mReversed.data(), mTaps, &out[done], count);
+        }
+        else
+#endif
+        {
+            DotsScalar(mWindow.data(), mReversed.data(), mTaps, &out[done], count);
+        }
+        std::memmove(mWindow.data(), &mWindow[count], history * sizeof(float));
+        done += count;
+    }
+    return Status::OK;
+}
@@ -0,0 +1,93 @@
+/**
+ ********************************************************************************
+ * @file        FirFilter.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float FIR filter (arm_fir_f32).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "SimdKernel.hpp"
+#include <array>
+#include <span>
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides a float FIR filter with the delay line of one stream.
+ * @details y[n] = b[0] * x[n] + b[1] * x[n - 1] + ... + b[taps - 1] * x[n - taps + 1], summed from the
+ *          oldest sample to the newest one. The input is copied behind the delay line in blocks of
+ *          @ref BLOCK samples, every output is a dot product of the reversed coefficients with a
+ *          contiguous window. The AVX2 kernel calculates 16 outputs per step.
+ * @note    Other than arm_fir_f32 the coefficients are in natural order (b[0] first).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class FirFilter
+{
+    public:
+
+        /// @brief Maximum number of coefficients.
+        static constexpr uint32_t MAX_TAPS{256U};
+
+        /// @brief Samples per internal block.
+        static constexpr uint32_t BLOCK{256U};
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit FirFilter(SimdKernel kernel = GetBestSimdKernel());
+
+        /**
+         * @brief   Set the coefficients and clear the delay line.
+         *
+         * @param   coefficients    b[0] .. b[taps - 1], 1 .. @ref MAX_TAPS.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Configure(std::span<const float> coefficients);
+
+        /// @brief Clear the delay line.
+        void Reset();
+
+        /**
+         * @brief   Filter a block, continues the stream of the previous one.
+         *
+         * @param   in      Input samples.
+         * @param   out     Output samples, at least the size of the input, may be the input.
+         *
+         * @return  OK or INVALID_PARAM (not configured, output too small).
+         */
+        Status Process(std::span<const float> in, std::span<float> out);
+
+        /// @brief The kernel set in use.
+        SimdKernel GetKernel() const {return mKernel;};
+
+    private:
+
+        /// @brief The kernel set.
+        SimdKernel mKernel;
+
+        /// @brief Number of coefficients, 0 if not configured.
+        uint32_t mTaps{0U};
+
+        /// @brief The coefficients in reversed order, b[taps - 1] first.
+        alignas(32) std::array<float, MAX_TAPS> mReversed{};
+
+        /// @brief Delay line (taps - 1 samples) followed by the input block.
+        alignas(32) std::array<float, MAX_TAPS - 1U + BLOCK> mWindow{};
+};
+
+} // end namespace Dsp
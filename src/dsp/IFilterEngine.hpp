@@ -0,0 +1,82 @@
+/**
+ ********************************************************************************
+ * @file        IFilterEngine.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, interface of a filter engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "FilterTypes.hpp"
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the interface of a filter engine which processes one block at a time.
+ * @details The engine loads the coefficients (if requested), the delay lines and filters the block, then
+ *          it reports the completion to its listener. A hardware engine reports from the interrupt context,
+ *          a software engine may report synchronously from inside @ref Start.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to start a job only when the previous one has been reported.
+ *
+ */
+class IFilterEngine
+{
+    public:
+
+        /// @brief Receiver of the job completion.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief Called exactly once per started job.
+                 * @param job       The finished job, the outputs are written.
+                 * @param status    Result of the job.
+                 */
+                virtual void OnJobDone(const FilterJob& job, Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IFilterEngine() = default;
+
+        /**
+         * @brief Register the completion listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start a job.
+         * @param job   A validated job, it stays valid until it has been reported.
+         * @return OK if the job was started (completion follows via the listener),
+         *         otherwise the job was not started and the listener is not called.
+         */
+        virtual Status Start(const FilterJob& job) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IFilterEngine() = default;
+
+        IFilterEngine(IFilterEngine const &) = default;             //!< Copy constructor
+        IFilterEngine(IFilterEngine &&) = default;                  //!< Move constructor
+
+        IFilterEngine& operator=(IFilterEngine const &) = default;  //!< Copy assignment
+        IFilterEngine& operator=(IFilterEngine &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Dsp
@@ -0,0 +1,64 @@
+/**
+ ********************************************************************************
+ * @file        IMathEngine.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, interface of a math engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "MathTypes.hpp"
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the interface of an engine which calculates a batch of one function.
+ * @details The arguments and the results are interleaved as the CORDIC reads and writes them: two
+ *          arguments per calculation and one or two results (see @ref Results). The call blocks until
+ *          the batch is done, a batch is short enough for the control loops that use it.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class IMathEngine
+{
+    public:
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IMathEngine() = default;
+
+        /**
+         * @brief   Calculate a batch.
+         *
+         * @param   function    The function.
+         * @param   pIn         count * ARGUMENTS arguments.
+         * @param   pOut        count * Results(function) results.
+         * @param   count       Count of calculations.
+         *
+         * @return  OK, INVALID_PARAM, BUSY or HW_ERROR.
+         */
+        virtual Status Compute(MathFunction function, const int32_t* pIn, int32_t* pOut, uint32_t count) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IMathEngine() = default;
+
+        IMathEngine(IMathEngine const &) = default;             //!< Copy constructor
+        IMathEngine(IMathEngine &&) = default;                  //!< Move constructor
+
+        IMathEngine& operator=(IMathEngine const &) = default;  //!< Copy assignment
+        IMathEngine& operator=(IMathEngine &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Dsp
@@ -0,0 +1,176 @@
+/**
+ ********************************************************************************
+ * @file        MathEngineHal.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, CORDIC math engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "MathEngineHal.hpp"
+#include "DCache.hpp"
+
+#if defined(CORDIC)
+
+using namespace Dsp;
+
+MathEngineHal* MathEngineHal::spInstance{nullptr};
+
+namespace {
+
+/// @brief CORDIC function of a math function.
+inline uint32_t CordicFunction(MathFunction function)
+{
+    switch (function)
+    {
+        case MathFunction::COSINE:
+            return CORDIC_FUNCTION_COSINE;
+        case MathFunction::PHASE:
+            return CORDIC_FUNCTION_PHASE;
+        default:
+            return CORDIC_FUNCTION_MODULUS;
+    }
+}
+
+} // end anonymous namespace
+
+
+MathEngineHal::MathEngineHal(CORDIC_HandleTypeDef& hcordic)
+: mHcordic(hcordic)
+{
+    spInstance = this;
+}
+
+
+MathEngineHal::~MathEngineHal()
+{
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+MathEngineHal* MathEngineHal::GetInstance(const CORDIC_HandleTypeDef* hcordic)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHcordic == hcordic))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status MathEngineHal::Configure(MathFunction function)
+{
+    if (mFunction == static_cast<uint8_t>(function))
+    {
+        return Status::OK;
+    }
+    CORDIC_ConfigTypeDef cfg{};
+    cfg.Function = CordicFunction(function);
+    cfg.Scale = CORDIC_SCALE_0;
+    cfg.InSize = CORDIC_INSIZE_32BITS;
+    cfg.OutSize = CORDIC_OUTSIZE_32BITS;
+    // the modulus is written with every angle, the CORDIC keeps the second argument otherwise
+    cfg.NbWrite = CORDIC_NBWRITE_2;
+    cfg.NbRead = (Results(function) == 2U) ? CORDIC_NBREAD_2 : CORDIC_NBREAD_1;
+    cfg.Precision = PRECISION;
+    const Status status = ToStatus(HAL_CORDIC_Configure(&mHcordic, &cfg));
+    mFunction = (status == Status::OK) ? static_cast<uint8_t>(function) : NO_FUNCTION;
+    return status;
+}
+
+
+Status MathEngineHal::Compute(MathFunction function, const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    if ((function > MathFunction::MODULUS) || ((count > 0U) && ((pIn == nullptr) || (pOut == nullptr))))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (count == 0U)
+    {
+        return Status::OK;
+    }
+    Status status = Configure(function);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    if (count <= ZO_LIMIT)
+    {
+        return ToStatus(HAL_CORDIC_CalculateZO(&mHcordic, pIn, pOut, count, TIMEOUT_MS));
+    }
+
+    const uint32_t outBytes = count * Results(function) * sizeof(int32_t);
+    Utils::DCache::Clean(pIn, count * ARGUMENTS * sizeof(int32_t));
+    // no dirty line may be evicted into the results while the DMA writes them
+    Utils::DCache::Clean(pOut, outBytes);
+    mDone = false;
+    mError = false;
+    status = ToStatus(HAL_CORDIC_Calculate_DMA(&mHcordic, pIn, pOut, count, CORDIC_DMA_DIR_IN_OUT));
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    const uint32_t start = HAL_GetTick();
+    while (!mDone && !mError)
+    {
+        if ((HAL_GetTick() - start) > TIMEOUT_MS)
+        {
+            (void)HAL_CORDIC_DeInit(&mHcordic);
+            (void)HAL_CORDIC_Init(&mHcordic);
+            mFunction = NO_FUNCTION;
+            return Status::HW_ERROR;
+        }
+    }
+    Utils::DCache::Invalidate(pOut, outBytes);
+    if (mError)
+    {
+        mFunction = NO_FUNCTION;
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+Status MathEngineHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_CORDIC_CalculateCpltCallback(CORDIC_HandleTypeDef* hcordic)
+{
+    MathEngineHal* pEngine = MathEngineHal::GetInstance(hcordic);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_CORDIC_ErrorCallback(CORDIC_HandleTypeDef* hcordic)
+{
+    MathEngineHal* pEngine = MathEngineHal::GetInstance(hcordic);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnError();
+    }
+}
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ ********************************************************************************
+ * @file        MathEngineHal.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, math engine on the CORDIC.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IMathEngine.hpp"
+#include "stm32h7xx_hal.h"
+
+#if defined(CORDIC)
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the IMathEngine on the CORDIC of the STM32H7.
+ * @details The CORDIC is reconfigured only when the function changes (q1.31, two arguments, scale 0,
+ *          @ref PRECISION). Short batches up to @ref ZO_LIMIT calculations run with
+ *          HAL_CORDIC_CalculateZO, the zero overhead mode writes the next arguments while the CORDIC
+ *          calculates. Longer batches run with HAL_CORDIC_Calculate_DMA in both directions, the call waits for
+ *          HAL_CORDIC_CalculateCpltCallback. The D-Cache lines of the buffers are cleaned before and the result
+ *          lines invalidated after the transfer.
+ * @note    Only available on devices with CORDIC (STM32H72x/H73x/H7Ax/H7Bx), the STM32H743 has none, use
+ *          MathEngineSoft there.\n
+ *          The application initialises the handle with HAL_CORDIC_Init, links the input and output DMA
+ *          handles (CORDIC_WRITE and CORDIC_READ requests) in HAL_CORDIC_MspInit and calls the DMA handlers.
+ *          The buffers must be located in a DMA accessible RAM (not DTCM). One CORDIC instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class MathEngineHal : public IMathEngine
+{
+    public:
+
+        /// @brief 4 iterations per cycle, 6 cycles (24 iterations) suit q1.31 arguments.
+        static constexpr uint32_t PRECISION{CORDIC_PRECISION_6CYCLES};
+
+        /// @brief Batches up to this size are calculated by the CPU in zero overhead mode.
+        static constexpr uint32_t ZO_LIMIT{8U};
+
+        /// @brief Timeout of a batch in ms.
+        static constexpr uint32_t TIMEOUT_MS{10U};
+
+        /**
+         * @brief   Constructs the engine for an initialised CORDIC handle.
+         *
+         * @param   hcordic     The CORDIC handle.
+         */
+        explicit MathEngineHal(CORDIC_HandleTypeDef& hcordic);
+
+        /// @brief Destructor.
+        ~MathEngineHal() override;
+
+        /// @copydoc IMathEngine::Compute
+        Status Compute(MathFunction function, const int32_t* pIn, int32_t* pOut, uint32_t count) override;
+
+        /// @brief Output DMA finished, called by HAL_CORDIC_CalculateCpltCallback.
+        void OnComplete() {mDone = true;};
+
+        /// @brief Peripheral or DMA error, called by HAL_CORDIC_ErrorCallback.
+        void OnError() {mError = true;};
+
+        /// @brief Engine bound to a CORDIC handle or nullptr.
+        static MathEngineHal* GetInstance(const CORDIC_HandleTypeDef* hcordic);
+
+    private:
+
+        /// @brief No function configured.
+        static constexpr uint8_t NO_FUNCTION{0xFFU};
+
+        /// @brief Configure the function if it changed.
+        Status Configure(MathFunction function);
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The CORDIC handle.
+        CORDIC_HandleTypeDef& mHcordic;
+
+        /// @brief The configured function.
+        uint8_t mFunction{NO_FUNCTION};
+
+        /// @brief Set by the completion of a DMA batch.
+        volatile bool mDone{false};
+
+        /// @brief Set by an error of a DMA batch.
+        volatile bool mError{false};
+
+        /// @brief The single engine instance, the device has one CORDIC.
+        static MathEngineHal* spInstance;
+};
+
+} // end namespace Dsp
+#endif
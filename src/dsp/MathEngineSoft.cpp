@@ -0,0 +1,345 @@
+/**
+ ********************************************************************************
+ * @file        MathEngineSoft.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, software math engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "MathEngineSoft.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief Radians of one q1.31 LSB of an angle.
+constexpr float RADIANS_PER_LSB{static_cast<float>(3.14159265358979323846 / 2147483648.0)};
+
+/// @brief Largest float below 2^31, results are saturated to it.
+constexpr float MAX_RESULT{2147483520.0F};
+
+/// @brief Smallest result, -2^31.
+constexpr float MIN_RESULT{-2147483648.0F};
+
+/// @brief Full scale of q1.31.
+constexpr float FULL_SCALE{2147483648.0F};
+
+/// @brief tan(pi/8), above it arctan is reduced by pi/4.
+constexpr float TAN_PI_8{0.414213562F};
+
+/// @brief 1/pi, phases are scaled by pi.
+constexpr float INV_PI{static_cast<float>(1.0 / 3.14159265358979323846)};
+
+/// @brief Taylor coefficients of sin(t)/t - 1, cos(t) - 1 and arctan(t)/t - 1 in z = t^2.
+constexpr float S3{-1.0F / 6.0F};
+constexpr float S5{1.0F / 120.0F};
+constexpr float S7{-1.0F / 5040.0F};
+constexpr float S9{1.0F / 362880.0F};
+constexpr float C2{-1.0F / 2.0F};
+constexpr float C4{1.0F / 24.0F};
+constexpr float C6{-1.0F / 720.0F};
+constexpr float C8{1.0F / 40320.0F};
+constexpr float A3{-1.0F / 3.0F};
+constexpr float A5{1.0F / 5.0F};
+constexpr float A7{-1.0F / 7.0F};
+constexpr float A9{1.0F / 9.0F};
+constexpr float A11{-1.0F / 11.0F};
+constexpr float A13{1.0F / 13.0F};
+constexpr float A15{-1.0F / 15.0F};
+
+/// @brief Saturate and truncate to q1.31.
+inline int32_t ToQ31(float value)
+{
+    return static_cast<int32_t>(std::min(std::max(value, MIN_RESULT), MAX_RESULT));
+}
+
+/// @brief Quadrant of an angle, the nearest multiple of pi/2 (-2..2).
+inline int32_t Quadrant(int32_t angle)
+{
+    return ((angle >> 29) + 1) >> 1;
+}
+
+void CosineScalar(const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const int32_t angle = pIn[2U * i];
+        const float modulus = static_cast<float>(pIn[(2U * i) + 1U]);
+        const int32_t q = Quadrant(angle);
+        const int32_t r = static_cast<int32_t>(static_cast<uint32_t>(angle) - (static_cast<uint32_t>(q) << 30U));
+        const float t = static_cast<float>(r) * RADIANS_PER_LSB;
+        const float z = t * t;
+        const float s = t + ((t * z) * (S3 + (z * (S5 + (z * (S7 + (z * S9)))))));
+        const float c = 1.0F + (z * (C2 + (z * (C4 + (z * (C6 + (z * C8)))))));
+        const bool swap = (q & 1) != 0;
+        float u = swap ? s : c;
+        float v = swap ? c : s;
+        if (((q + 1) & 2) != 0)
+        {
+            u = -u;
+        }
+        if ((q & 2) != 0)
+        {
+            v = -v;
+        }
+        pOut[2U * i] = ToQ31(u * modulus);
+        pOut[(2U * i) + 1U] = ToQ31(v * modulus);
+    }
+}
+
+void PhaseScalar(const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const float x = static_cast<float>(pIn[2U * i]);
+        const float y = static_cast<float>(pIn[(2U * i) + 1U]);
+        const float ax = std::fabs(x);
+        const float ay = std::fabs(y);
+        const float large = std::max(ax, ay);
+        const float small = std::min(ax, ay);
+        float t = (large > 0.0F) ? (small / large) : 0.0F;
+        float offset = 0.0F;
+        if (t > TAN_PI_8)
+        {
+            t = (t - 1.0F) / (t + 1.0F);
+            offset = 0.25F;
+        }
+        const float z = t * t;
+        const float p = z * (A3 + (z * (A5 + (z * (A7 + (z * (A9 + (z * (A11 + (z * (A13 + (z * A15))))))))))));
+        float phase = ((t + (t * p)) * INV_PI) + offset;
+        if (ay > ax)
+        {
+            phase = 0.5F - phase;
+        }
+        if (x < 0.0F)
+        {
+            phase = 1.0F - phase;
+        }
+        if (y < 0.0F)
+        {
+            phase = -phase;
+        }
+        pOut[i] = ToQ31(phase * FULL_SCALE);
+    }
+}
+
+void ModulusScalar(const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const float x = static_cast<float>(pIn[2U * i]);
+        const float y = static_cast<float>(pIn[(2U * i) + 1U]);
+        pOut[i] = ToQ31(std::sqrt((x * x) + (y * y)));
+    }
+}
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+
+bool CpuHasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}
+
+/// @brief Split 8 interleaved pairs into the first and the second values.
+__attribute__((target("avx2")))
+inline void LoadPairs(const int32_t* pIn, __m256i& first, __m256i& second)
+{
+    const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256i v0 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pIn)),
+                                                   order);
+    const __m256i v1 = _mm256_permutevar8x32_epi32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pIn[8])), order);
+    first = _mm256_permute2x128_si256(v0, v1, 0x20);
+    second = _mm256_permute2x128_si256(v0, v1, 0x31);
+}
+
+__attribute__((target("avx2")))
+inline __m256i ToQ31Avx2(__m256 value)
+{
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(MIN_RESULT)), _mm256_set1_ps(MAX_RESULT));
+    return _mm256_cvttps_epi32(value);
+}
+
+/// @brief a + b * c without contraction.
+__attribute__((target("avx2")))
+inline __m256 MulAdd(__m256 a, __m256 b, __m256 c)
+{
+    return _mm256_add_ps(a, _mm256_mul_ps(b, c));
+}
+
+__attribute__((target("avx2")))
+void CosineAvx2(const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0F);
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        __m256i angle{};
+        __m256i modulusQ31{};
+        LoadPairs(&pIn[2U * i], angle, modulusQ31);
+        const __m256 modulus = _mm256_cvtepi32_ps(modulusQ31);
+        const __m256i q = _mm256_srai_epi32(_mm256_add_epi32(_mm256_srai_epi32(angle, 29), _mm256_set1_epi32(1)), 1);
+        const __m256i r = _mm256_sub_epi32(angle, _mm256_slli_epi32(q, 30));
+        const __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(r), _mm256_set1_ps(RADIANS_PER_LSB));
+        const __m256 z = _mm256_mul_ps(t, t);
+        __m256 ps = MulAdd(_mm256_set1_ps(S7), z, _mm256_set1_ps(S9));
+        ps = MulAdd(_mm256_set1_ps(S5), z, ps);
+        ps = MulAdd(_mm256_set1_ps(S3), z, ps);
+        const __m256 s = _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(t, z), ps));
+        __m256 pc = MulAdd(_mm256_set1_ps(C6), z, _mm256_set1_ps(C8));
+        pc = MulAdd(_mm256_set1_ps(C4), z, pc);
+        pc = MulAdd(_mm256_set1_ps(C2), z, pc);
+        const __m256 c = MulAdd(_mm256_set1_ps(1.0F), z, pc);
+
+        const __m256 swap = _mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(_mm256_and_si256(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+        __m256 u = _mm256_blendv_ps(c, s, swap);
+        __m256 v = _mm256_blendv_ps(s, c, swap);
+        // the bit 1 of q + 1 (cosine) and q (sine) moved to the sign bit
+        u = _mm256_xor_ps(u, _mm256_and_ps(sign, _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_add_epi32(q, _mm256_set1_epi32(1)), 30))));
+        v = _mm256_xor_ps(v, _mm256_and_ps(sign, _mm256_castsi256_ps(_mm256_slli_epi32(q, 30))));
+
+        const __m256i cosine = ToQ31Avx2(_mm256_mul_ps(u, modulus));
+        const __m256i sine = ToQ31Avx2(_mm256_mul_ps(v, modulus));
+        const __m256i lo = _mm256_unpacklo_epi32(cosine, sine);
+        const __m256i hi = _mm256_unpackhi_epi32(cosine, sine);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[2U * i]), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[(2U * i) + 8U]),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    CosineScalar(&pIn[2U * i], &pOut[2U * i], count - i);
+}
+
+__attribute__((target("avx2")))
+void PhaseAvx2(const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    const __m256 abs = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0F);
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        __m256i xi{};
+        __m256i yi{};
+        LoadPairs(&pIn[2U * i], xi, yi);
+        const __m256 x = _mm256_cvtepi32_ps(xi);
+        const __m256 y = _mm256_cvtepi32_ps(yi);
+        const __m256 ax = _mm256_and_ps(x, abs);
+        const __m256 ay = _mm256_and_ps(y, abs);
+        const __m256 large = _mm256_max_ps(ax, ay);
+        const __m256 small = _mm256_min_ps(ax, ay);
+        __m256 t = _mm256_and_ps(_mm256_div_ps(small, large), _mm256_cmp_ps(large, zero, _CMP_GT_OQ));
+        const __m256 big = _mm256_cmp_ps(t, _mm256_set1_ps(TAN_PI_8), _CMP_GT_OQ);
+        t = _mm256_blendv_ps(t, _mm256_div_ps(_mm256_sub_ps(t, one), _mm256_add_ps(t, one)), big);
+        const __m256 offset = _mm256_and_ps(_mm256_set1_ps(0.25F), big);
+        const __m256 z = _mm256_mul_ps(t, t);
+        __m256 p = MulAdd(_mm256_set1_ps(A13), z, _mm256_set1_ps(A15));
+        p = MulAdd(_mm256_set1_ps(A11), z, p);
+        p = MulAdd(_mm256_set1_ps(A9), z, p);
+        p = MulAdd(_mm256_set1_ps(A7), z, p);
+        p = MulAdd(_mm256_set1_ps(A5), z, p);
+        p = MulAdd(_mm256_set1_ps(A3), z, p);
+        p = _mm256_mul_ps(z, p);
+        __m256 phase = _mm256_add_ps(_mm256_mul_ps(MulAdd(t, t, p), _mm256_set1_ps(INV_PI)), offset);
+        phase = _mm256_blendv_ps(phase, _mm256_sub_ps(_mm256_set1_ps(0.5F), phase),
+                                 _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+        phase = _mm256_blendv_ps(phase, _mm256_sub_ps(one, phase), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+        phase = _mm256_blendv_ps(phase, _mm256_sub_ps(zero, phase), _mm256_cmp_ps(y, zero, _CMP_LT_OQ));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[i]),
+                            ToQ31Avx2(_mm256_mul_ps(phase, _mm256_set1_ps(FULL_SCALE))));
+    }
+    PhaseScalar(&pIn[2U * i], &pOut[i], count - i);
+}
+
+__attribute__((target("avx2")))
+void ModulusAvx2(const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        __m256i xi{};
+        __m256i yi{};
+        LoadPairs(&pIn[2U * i], xi, yi);
+        const __m256 x = _mm256_cvtepi32_ps(xi);
+        const __m256 y = _mm256_cvtepi32_ps(yi);
+        const __m256 sum = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[i]), ToQ31Avx2(_mm256_sqrt_ps(sum)));
+    }
+    ModulusScalar(&pIn[2U * i], &pOut[i], count - i);
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+MathEngineSoft::MathEngineSoft(Kernel kernel)
+: mKernel(std::min(kernel, GetBestKernel()))
+{
+}
+
+
+MathEngineSoft::Kernel MathEngineSoft::GetBestKernel()
+{
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (CpuHasAvx2())
+    {
+        return Kernel::AVX2;
+    }
+#endif
+    return Kernel::SCALAR;
+}
+
+
+Status MathEngineSoft::Compute(MathFunction function, const int32_t* pIn, int32_t* pOut, uint32_t count)
+{
+    if ((function > MathFunction::MODULUS) || ((count > 0U) && ((pIn == nullptr) || (pOut == nullptr))))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (mKernel == Kernel::AVX2)
+    {
+        switch (function)
+        {
+            case MathFunction::COSINE:
+                CosineAvx2(pIn, pOut, count);
+                break;
+            case MathFunction::PHASE:
+                PhaseAvx2(pIn, pOut, count);
+                break;
+            default:
+                ModulusAvx2(pIn, pOut, count);
+                break;
+        }
+        return Status::OK;
+    }
+#endif
+    switch (function)
+    {
+        case MathFunction::COSINE:
+            CosineScalar(pIn, pOut, count);
+            break;
+        case MathFunction::PHASE:
+            PhaseScalar(pIn, pOut, count);
+            break;
+        default:
+            ModulusScalar(pIn, pOut, count);
+            break;
+    }
+    return Status::OK;
+}
@@ -0,0 +1,88 @@
+/**
+ ********************************************************************************
+ * @file        MathEngineSoft.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, software math engine with polynomial approximations.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IMathEngine.hpp"
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the IMathEngine functions with polynomial approximations in float.
+ * @details - COSINE: the angle is reduced exactly in integer to +-pi/4 around a multiple of pi/2, sine and
+ *            cosine are Taylor polynomials of degree 9 and 8 and the quadrant swaps and negates them
+ *          - PHASE: the ratio of the smaller and the larger coordinate is reduced to +-tan(pi/8), arctan is
+ *            the odd Taylor polynomial of degree 15, the octant maps it to the full circle
+ *          - MODULUS: correctly rounded float square root of the float sum of squares.
+ *
+ *          Measured against double precision over the full q1.31 range the absolute error is below
+ *          @ref MAX_ERROR_COSINE, @ref MAX_ERROR_PHASE and @ref MAX_ERROR_MODULUS LSB (MODULUS relative to
+ *          the result). Results which reach one are saturated to 0x7FFFFF80, atan2(0, 0) is 0.\n
+ *          On the host 8 calculations per step use AVX2, it executes the same float operations in the same
+ *          order (no FMA contraction), so both kernels give identical results.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class MathEngineSoft : public IMathEngine
+{
+    public:
+
+        /// @brief Error bound of COSINE in q1.31 LSB for a modulus of one.
+        static constexpr uint32_t MAX_ERROR_COSINE{384U};
+
+        /// @brief Error bound of PHASE in q1.31 LSB.
+        static constexpr uint32_t MAX_ERROR_PHASE{256U};
+
+        /// @brief Error bound of MODULUS in q1.31 LSB per unit of the result.
+        static constexpr uint32_t MAX_ERROR_MODULUS{512U};
+
+        /// @brief Kernel sets.
+        enum class Kernel : uint8_t
+        {
+            SCALAR=0,   //!< Portable C++
+            AVX2=1      //!< 8 calculations per step
+        };
+
+        /// @brief Constructor, uses the best kernel set of the CPU.
+        MathEngineSoft() : MathEngineSoft(GetBestKernel()) {};
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit MathEngineSoft(Kernel kernel);
+
+        /// @brief Destructor.
+        ~MathEngineSoft() override = default;
+
+        /// @copydoc IMathEngine::Compute
+        Status Compute(MathFunction function, const int32_t* pIn, int32_t* pOut, uint32_t count) override;
+
+        /// @brief The kernel set in use.
+        Kernel GetKernel() const {return mKernel;};
+
+        /// @brief The best kernel set of the CPU.
+        static Kernel GetBestKernel();
+
+    private:
+
+        /// @brief The kernel set.
+        Kernel mKernel;
+};
+
+} // end namespace Dsp
@@ -0,0 +1,48 @@
+/**
+ ********************************************************************************
+ * @file        MathTypes.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, types of the fast math functions.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DspTypes.hpp"
+#include <cstdint>
+namespace Dsp {
+
+
+/**
+ * @brief   Functions of a math engine, the CORDIC functions in q1.31.
+ * @details Every calculation takes two arguments, angles and phases are scaled by pi
+ *          (0x80000000 is -pi, 0x40000000 is pi/2).
+ */
+enum class MathFunction : uint8_t
+{
+    COSINE=0,   //!< (angle, modulus) -> (modulus * cos(angle), modulus * sin(angle))
+    PHASE=1,    //!< (x, y) -> atan2(y, x)
+    MODULUS=2   //!< (x, y) -> sqrt(x^2 + y^2), saturated if it exceeds one
+};
+
+/// @brief Count of results per calculation.
+constexpr uint32_t Results(MathFunction function) {return (function == MathFunction::COSINE) ? 2U : 1U;};
+
+/// @brief Count of arguments per calculation.
+constexpr uint32_t ARGUMENTS{2U};
+
+/// @brief A complex value in q1.31, the layout matches the CORDIC arguments (x, y).
+struct Complex
+{
+    int32_t re{0};  //!< Real part (x)
+    int32_t im{0};  //!< Imaginary part (y)
+};
+
+static_assert(sizeof(Complex) == (ARGUMENTS * sizeof(int32_t)), "Complex must be a pair of q1.31");
+
+} // end namespace Dsp
@@ -0,0 +1,183 @@
+/**
+ ********************************************************************************
+ * @file        MatrixMath.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float matrix operations implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "MatrixMath.hpp"
+#include <algorithm>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief pDst = pDst + a * pRow, pDst = a * pRow on the first row.
+void AccumulateScalar(float* pDst, const float* pRow, float a, uint32_t count, bool first)
+{
+    for (uint32_t j = 0U; j < count; j++)
+    {
+        const float product = a * pRow[j];
+        pDst[j] = first ? product : (pDst[j] + product);
+    }
+}
+
+void AddScalar(const float* pA, const float* pB, float* pDst, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        pDst[i] = pA[i] + pB[i];
+    }
+}
+
+void ScaleScalar(const float* pA, float scale, float* pDst, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        pDst[i] = pA[i] * scale;
+    }
+}
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+
+__attribute__((target("avx2")))
+void AccumulateAvx2(float* pDst, const float* pRow, float a, uint32_t count, bool first)
+{
+    const __m256 factor = _mm256_set1_ps(a);
+    uint32_t j = 0U;
+    for (; (j + 8U) <= count; j += 8U)
+    {
+        const __m256 product = _mm256_mul_ps(factor, _mm256_loadu_ps(&pRow[j]));
+        _mm256_storeu_ps(&pDst[j], first ? product : _mm256_add_ps(_mm256_loadu_ps(&pDst[j]), product));
+    }
+    AccumulateScalar(&pDst[j], &pRow[j], a, count - j, first);
+}
+
+__attribute__((target("avx2")))
+void AddAvx2(const float* pA, const float* pB, float* pDst, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        _mm256_storeu_ps(&pDst[i], _mm256_add_ps(_mm256_loadu_ps(&pA[i]), _mm256_loadu_ps(&pB[i])));
+    }
+    AddScalar(&pA[i], &pB[i], &pDst[i], count - i);
+}
+
+__attribute__((target("avx2")))
+void ScaleAvx2(const float* pA, float scale, float* pDst, uint32_t count)
+{
+    const __m256 factor = _mm256_set1_ps(scale);
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        _mm256_storeu_ps(&pDst[i], _mm256_mul_ps(_mm256_loadu_ps(&pA[i]), factor));
+    }
+    ScaleScalar(&pA[i], scale, &pDst[i], count - i);
+}
+
+#endif
+
+/// @brief Number of elements.
+inline uint32_t Elements(const Matrix& m)
+{
+    return static_cast<uint32_t>(m.rows) * m.cols;
+}
+
+} // end anonymous namespace
+
+
+MatrixMath::MatrixMath(SimdKernel kernel)
+: mKernel(std::min(kernel, GetBestSimdKernel()))
+{
+}
+
+
+Status MatrixMath::Multiply(const Matrix& a, const Matrix& b, Matrix& dst) const
+{
+    if ((a.cols != b.rows) || (dst.rows != a.rows) || (dst.cols != b.cols))
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (uint32_t i = 0U; i < a.rows; i++)
+    {
+        float* pDst = &dst.pData[i * dst.cols];
+        for (uint32_t k = 0U; k < a.cols; k++)
+        {
+            const float* pRow = &b.pData[k * b.cols];
+            const float factor = a.pData[(i * a.cols) + k];
+#if defined(DSP_HAS_X86_INTRINSICS)
+            if (mKernel == SimdKernel::AVX2)
+            {
+                AccumulateAvx2(pDst, pRow, factor, b.cols, k == 0U);
+                continue;
+            }
+#endif
+            AccumulateScalar(pDst, pRow, factor, b.cols, k == 0U);
+        }
+    }
+    return Status::OK;
+}
+
+
+Status MatrixMath::Add(const Matrix& a, const Matrix& b, Matrix& dst) const
+{
+    if ((a.rows != b.rows) || (a.cols != b.cols) || (dst.rows != a.rows) || (dst.cols != a.cols))
+    {
+        return Status::INVALID_PARAM;
+    }
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (mKernel == SimdKernel::AVX2)
+    {
+        AddAvx2(a.pData, b.pData, dst.pData, Elements(a));
+        return Status::OK;
+    }
+#endif
+    AddScalar(a.pData, b.pData, dst.pData, Elements(a));
+    return Status::OK;
+}
+
+
+Status MatrixMath::Transpose(const Matrix& a, Matrix& dst) const
+{
+    if ((dst.rows != a.cols) || (dst.cols != a.rows))
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (uint32_t i = 0U; i < a.rows; i++)
+    {
+        for (uint32_t j = 0U; j < a.cols; j++)
+        {
+            dst.pData[(j * dst.cols) + i] = a.pData[(i * a.cols) + j];
+        }
+    }
+    return Status::OK;
+}
+
+
+Status MatrixMath::Scale(const Matrix& a, float scale, Matrix& dst) const
+{
+    if ((dst.rows != a.rows) || (dst.cols != a.cols))
+    {
+        return Status::INVALID_PARAM;
+    }
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (mKernel == SimdKernel::AVX2)
+    {
+        ScaleAvx2(a.pData, scale, dst.pData, Elements(a));
+        return Status::OK;
+    }
+#endif
+    ScaleScalar(a.pData, scale, dst.pData, Elements(a));
+    return Status::OK;
+}
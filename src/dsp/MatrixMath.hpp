@@ -0,0 +1,76 @@
+/**
+ ********************************************************************************
+ * @file        MatrixMath.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float matrix operations (arm_mat_*_f32).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "SimdKernel.hpp"
+namespace Dsp {
+
+
+/// @brief A row major float matrix on a user buffer (arm_matrix_instance_f32).
+struct Matrix
+{
+    uint16_t rows;      //!< Number of rows
+    uint16_t cols;      //!< Number of columns
+    float* pData;       //!< rows * cols elements, row by row
+};
+
+
+/**
+ * @brief   This class provides the matrix operations of the state estimators and the coordinate transforms.
+ * @details The dimensions are checked like in CMSIS-DSP, a mismatch returns INVALID_PARAM (instead of
+ *          ARM_MATH_SIZE_MISMATCH) and leaves the destination untouched.\n
+ *          Multiply runs row by row: a row of the destination accumulates the rows of B weighted with the
+ *          elements of the row of A, the AVX2 kernel 8 columns per step.
+ * @note    The destination of Multiply and Transpose must not overlap a source, Add and Scale may work in
+ *          place.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class MatrixMath
+{
+    public:
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit MatrixMath(SimdKernel kernel = GetBestSimdKernel());
+
+        /// @brief dst = a * b.
+        Status Multiply(const Matrix& a, const Matrix& b, Matrix& dst) const;
+
+        /// @brief dst = a + b.
+        Status Add(const Matrix& a, const Matrix& b, Matrix& dst) const;
+
+        /// @brief dst = a^T.
+        Status Transpose(const Matrix& a, Matrix& dst) const;
+
+        /// @brief dst = a * scale.
+        Status Scale(const Matrix& a, float scale, Matrix& dst) const;
+
+        /// @brief The kernel set in use.
+        SimdKernel GetKernel() const {return mKernel;};
+
+    private:
+
+        /// @brief The kernel set.
+        SimdKernel mKernel;
+};
+
+} // end namespace Dsp
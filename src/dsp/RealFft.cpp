@@ -0,0 +1,129 @@
+/**
+ ********************************************************************************
+ * @file        RealFft.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float real FFT implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "RealFft.hpp"
+#include <cmath>
+#include <cstring>
+
+using namespace Dsp;
+
+namespace {
+
+constexpr double PI{3.14159265358979323846};
+
+} // end anonymous namespace
+
+
+Status RealFft::Configure(uint32_t size)
+{
+    if ((size < 4U) || (size > MAX_SIZE) || (mFft.Configure(size / 2U) != Status::OK))
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (uint32_t k = 0U; k <= (size / 4U); k++)
+    {
+        const double angle = -2.0 * PI * static_cast<double>(k) / static_cast<double>(size);
+        mSplit[2U * k] = static_cast<float>(std::cos(angle));
+        mSplit[(2U * k) + 1U] = static_cast<float>(std::sin(angle));
+    }
+    return Status::OK;
+}
+
+
+Status RealFft::Forward(std::span<const float> in, std::span<float> out) const
+{
+    const uint32_t size = GetSize();
+    if ((size == 0U) || (in.size() != size) || (out.size() < size))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (out.data() != in.data())
+    {
+        std::memmove(out.data(), in.data(), size * sizeof(float));
+    }
+    // the even samples are the real, the odd ones the imaginary parts
+    (void)mFft.Forward(out.first(size));
+
+    float* pX = out.data();
+    const float r0 = pX[0];
+    pX[0] = r0 + pX[1];
+    pX[1] = r0 - pX[1];
+    for (uint32_t k = 1U; k <= (size / 4U); k++)
+    {
+        const uint32_t m = (size / 2U) - k;
+        const float ar = pX[2U * k];
+        const float ai = pX[(2U * k) + 1U];
+        const float br = pX[2U * m];
+        const float bi = pX[(2U * m) + 1U];
+        // spectra of the even and the odd samples
+        const float er = (ar + br) * 0.5F;
+        const float ei = (ai - bi) * 0.5F;
+        const float or_ = (ai + bi) * 0.5F;
+        const float oi = (br - ar) * 0.5F;
+        const float wr = mSplit[2U * k];
+        const float wi = mSplit[(2U * k) + 1U];
+        const float tr = (or_ * wr) - (oi * wi);
+        const float ti = (oi * wr) + (or_ * wi);
+        if (m != k)
+        {
+            pX[2U * m] = er - tr;
+            pX[(2U * m) + 1U] = ti - ei;
+        }
+        pX[2U * k] = er + tr;
+        pX[(2U * k) + 1U] = ei + ti;
+    }
+    return Status::OK;
+}
+
+
+Status RealFft::Inverse(std::span<const float> in, std::span<float> out) const
+{
+    const uint32_t size = GetSize();
+    if ((size == 0U) || (in.size() != size) || (out.size() < size))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    const float* pX = in.data();
+    float* pZ = out.data();
+    const float x0 = pX[0];
+    const float xh = pX[1];
+    pZ[0] = (x0 + xh) * 0.5F;
+    pZ[1] = (x0 - xh) * 0.5F;
+    for (uint32_t k = 1U; k <= (size / 4U); k++)
+    {
+        const uint32_t m = (size / 2U) - k;
+        const float pr = pX[2U * k];
+        const float pi = pX[(2U * k) + 1U];
+        const float qr = pX[2U * m];
+        const float qi = pX[(2U * m) + 1U];
+        const float er = (pr + qr) * 0.5F;
+        const float ei = (pi - qi) * 0.5F;
+        const float tr = (pr - qr) * 0.5F;
+        const float ti = (pi + qi) * 0.5F;
+        // the odd spectrum is t / W^k
+        const float wr = mSplit[2U * k];
+        const float wi = mSplit[(2U * k) + 1U];
+        const float or_ = (tr * wr) + (ti * wi);
+        const float oi = (ti * wr) - (tr * wi);
+        if (m != k)
+        {
+            pZ[2U * m] = er + oi;
+            pZ[(2U * m) + 1U] = or_ - ei;
+        }
+        pZ[2U * k] = er - oi;
+        pZ[(2U * k) + 1U] = ei + or_;
+    }
+    (void)mFft.Inverse(out.first(size));
+    return Status::OK;
+}
@@ -0,0 +1,93 @@
+/**
+ ********************************************************************************
+ * @file        RealFft.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float real FFT (arm_rfft_fast_f32).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ComplexFft.hpp"
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the FFT of real floats in the packed format of arm_rfft_fast_f32.
+ * @details The even and odd samples form a complex sequence of half the size, the ComplexFft of it is
+ *          split into the spectrum with the twiddle factors exp(-j * 2 * pi * k / size). The spectrum is
+ *          {X[0], X[size / 2], re X[1], im X[1], .. re X[size / 2 - 1], im X[size / 2 - 1]}, the two real
+ *          bins share the first complex slot. The inverse merges the spectrum and transforms it back, it
+ *          reproduces the samples (scaled by 1 / size like arm_rfft_fast_f32).\n
+ *          The split runs scalar, the vector kernels are the ones of the ComplexFft.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class RealFft
+{
+    public:
+
+        /// @brief Maximum number of real samples.
+        static constexpr uint32_t MAX_SIZE{2U * ComplexFft::MAX_SIZE};
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit RealFft(SimdKernel kernel = GetBestSimdKernel()) : mFft(kernel) {};
+
+        /**
+         * @brief   Set the size and calculate the twiddle factors.
+         *
+         * @param   size    Number of real samples, a power of two 4 .. @ref MAX_SIZE.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Configure(uint32_t size);
+
+        /**
+         * @brief   Forward transform.
+         *
+         * @param   in      size samples.
+         * @param   out     size floats, the packed spectrum, may be the input.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Forward(std::span<const float> in, std::span<float> out) const;
+
+        /**
+         * @brief   Inverse transform.
+         *
+         * @param   in      size floats, the packed spectrum.
+         * @param   out     size samples, may be the input.
+         *
+         * @return  OK or INVALID_PARAM.
+         */
+        Status Inverse(std::span<const float> in, std::span<float> out) const;
+
+        /// @brief Number of real samples, 0 if not configured.
+        uint32_t GetSize() const {return 2U * mFft.GetSize();};
+
+        /// @brief The kernel set in use.
+        SimdKernel GetKernel() const {return mFft.GetKernel();};
+
+    private:
+
+        /// @brief The transform of half the size.
+        ComplexFft mFft;
+
+        /// @brief exp(-j * 2 * pi * k / size) for k <= size / 4, interleaved.
+        std::array<float, (MAX_SIZE / 2U) + 2U> mSplit{};
+};
+
+} // end namespace Dsp
@@ -0,0 +1,27 @@
+/**
+ ********************************************************************************
+ * @file        SimdKernel.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, kernel set selection implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SimdKernel.hpp"
+
+
+Dsp::SimdKernel Dsp::GetBestSimdKernel()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") != 0)
+    {
+        return SimdKernel::AVX2;
+    }
+#endif
+    return SimdKernel::SCALAR;
+}
@@ -0,0 +1,36 @@
+/**
+ ********************************************************************************
+ * @file        SimdKernel.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, kernel set selection of the float kernels.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DspTypes.hpp"
+namespace Dsp {
+
+
+/**
+ * @brief   Kernel sets of the float kernels (FirFilter, BiquadCascade, ComplexFft, RealFft, MatrixMath,
+ *          Statistics).
+ * @details Every vector kernel executes the float operations of the scalar one in the same order (no FMA
+ *          contraction), so both give bit identical results. On the Cortex-M7 the scalar kernels run on the
+ *          single precision FPU.
+ */
+enum class SimdKernel : uint8_t
+{
+    SCALAR=0,   //!< Portable C++
+    AVX2=1      //!< 8 floats per step
+};
+
+/// @brief The best kernel set of the CPU.
+SimdKernel GetBestSimdKernel();
+
+} // end namespace Dsp
@@ -0,0 +1,235 @@
+/**
+ ********************************************************************************
+ * @file        Statistics.cpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float statistics implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "Statistics.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DSP_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Dsp;
+
+namespace {
+
+/// @brief Number of lanes of the sums.
+constexpr uint32_t LANES{8U};
+
+inline float Term(float value, float offset, bool square)
+{
+    const float difference = value - offset;
+    return square ? (difference * difference) : difference;
+}
+
+/// @brief The remaining elements behind the lanes.
+float Tail(const float* pValues, uint32_t begin, uint32_t count, float offset, bool square, float sum)
+{
+    for (uint32_t i = begin; i < count; i++)
+    {
+        sum = sum + Term(pValues[i], offset, square);
+    }
+    return sum;
+}
+
+float SumScalar(const float* pValues, uint32_t count, float offset, bool square)
+{
+    std::array<float, LANES> lanes{};
+    uint32_t i = 0U;
+    for (; (i + LANES) <= count; i += LANES)
+    {
+        for (uint32_t l = 0U; l < LANES; l++)
+        {
+            lanes[l] = lanes[l] + Term(pValues[i + l], offset, square);
+        }
+    }
+    for (uint32_t l = 0U; l < 4U; l++)
+    {
+        lanes[l] = lanes[l] + lanes[l + 4U];
+    }
+    lanes[0] = lanes[0] + lanes[2];
+    lanes[1] = lanes[1] + lanes[3];
+    return Tail(pValues, i, count, offset, square, lanes[0] + lanes[1]);
+}
+
+float MaxScalar(const float* pValues, uint32_t count, float sign)
+{
+    float result = sign * pValues[0];
+    for (uint32_t i = 1U; i < count; i++)
+    {
+        result = std::max(result, sign * pValues[i]);
+    }
+    return result;
+}
+
+#if defined(DSP_HAS_X86_INTRINSICS)
+
+__attribute__((target("avx2")))
+float SumAvx2(const float* pValues, uint32_t count, float offset, bool square)
+{
+    const __m256 shift = _mm256_set1_ps(offset);
+    __m256 lanes = _mm256_setzero_ps();
+    uint32_t i = 0U;
+    for (; (i + LANES) <= count; i += LANES)
+    {
+        __m256 term = _mm256_sub_ps(_mm256_loadu_ps(&pValues[i]), shift);
+        if (square)
+        {
+            term = _mm256_mul_ps(term, term);
+        }
+        lanes = _mm256_add_ps(lanes, term);
+    }
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(lanes), _mm256_extractf128_ps(lanes, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    const float sum = _mm_cvtss_f32(_mm_add_ss(half, _mm_shuffle_ps(half, half, 0x55)));
+    return Tail(pValues, i, count, offset, square, sum);
+}
+
+__attribute__((target("avx2")))
+float MaxAvx2(const float* pValues, uint32_t count, float sign)
+{
+    if (count < LANES)
+    {
+        return MaxScalar(pValues, count, sign);
+    }
+    const __m256 factor = _mm256_set1_ps(sign);
+    __m256 result = _mm256_mul_ps(factor, _mm256_loadu_ps(pValues));
+    uint32_t i = LANES;
+    for (; (i + LANES) <= count; i += LANES)
+    {
+        result = _mm256_max_ps(result, _mm256_mul_ps(factor, _mm256_loadu_ps(&pValues[i])));
+    }
+    std::array<float, LANES> lanes{};
+    _mm256_storeu_ps(lanes.data(), result);
+    float extreme = *std::max_element(lanes.begin(), lanes.end());
+    for (; i < count; i++)
+    {
+        extreme = std::max(extreme, sign * pValues[i]);
+    }
+    return extreme;
+}
+
+#endif
+
+} // end anonymous namespace
+
+
+Statistics::Statistics(SimdKernel kernel)
+: mKernel(std::min(kernel, GetBestSimdKernel()))
+{
+}
+
+
+Status Statistics::Mean(std::span<const float> values, float& result) const
+{
+    if (values.empty())
+    {
+        return Status::INVALID_PARAM;
+    }
+    result = Sum(values, 0.0F, false) / static_cast<float>(values.size());
+    return Status::OK;
+}
+
+
+Status Statistics::Power(std::span<const float> values, float& result) const
+{
+    if (values.empty())
+    {
+        return Status::INVALID_PARAM;
+    }
+    result = Sum(values, 0.0F, true);
+    return Status::OK;
+}
+
+
+Status Statistics::Rms(std::span<const float> values, float& result) const
+{
+    if (values.empty())
+    {
+        return Status::INVALID_PARAM;
+    }
+    result = std::sqrt(Sum(values, 0.0F, true) / static_cast<float>(values.size()));
+    return Status::OK;
+}
+
+
+Status Statistics::Variance(std::span<const float> values, float& result) const
+{
+    if (values.size() < 2U)
+    {
+        return Status::INVALID_PARAM;
+    }
+    const float mean = Sum(values, 0.0F, false) / static_cast<float>(values.size());
+    result = Sum(values, mean, true) / static_cast<float>(values.size() - 1U);
+    return Status::OK;
+}
+
+
+Status Statistics::StandardDeviation(std::span<const float> values, float& result) const
+{
+    const Status status = Variance(values, result);
+    result = (status == Status::OK) ? std::sqrt(result) : result;
+    return status;
+}
+
+
+Status Statistics::Max(std::span<const float> values, float& result, uint32_t& index) const
+{
+    if (values.empty())
+    {
+        return Status::INVALID_PARAM;
+    }
+    result = Extreme(values, false);
+    index = static_cast<uint32_t>(std::find(values.begin(), values.end(), result) - values.begin());
+    return Status::OK;
+}
+
+
+Status Statistics::Min(std::span<const float> values, float& result, uint32_t& index) const
+{
+    if (values.empty())
+    {
+        return Status::INVALID_PARAM;
+    }
+    result = -Extreme(values, true);
+    index = static_cast<uint32_t>(std::find(values.begin(), values.end(), result) - values.begin());
+    return Status::OK;
+}
+
+
+float Statistics::Sum(std::span<const float> values, float offset, bool square) const
+{
+    const uint32_t count = static_cast<uint32_t>(values.size());
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (mKernel == SimdKernel::AVX2)
+    {
+        return SumAvx2(values.data(), count, offset, square);
+    }
+#endif
+    return SumScalar(values.data(), count, offset, square);
+}
+
+
+float Statistics::Extreme(std::span<const float> values, bool minimum) const
+{
+    const uint32_t count = static_cast<uint32_t>(values.size());
+    const float sign = minimum ? -1.0F : 1.0F;
+#if defined(DSP_HAS_X86_INTRINSICS)
+    if (mKernel == SimdKernel::AVX2)
+    {
+        return MaxAvx2(values.data(), count, sign);
+    }
+#endif
+    return MaxScalar(values.data(), count, sign);
+}
@@ -0,0 +1,85 @@
+/**
+ ********************************************************************************
+ * @file        Statistics.hpp
+ *
+ * @namespace   Dsp
+ *
+ * @brief       Dsp, float statistics (arm_mean_f32, arm_var_f32, ..).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "SimdKernel.hpp"
+#include <span>
+namespace Dsp {
+
+
+/**
+ * @brief   This class provides the statistics of a block of floats.
+ * @details The sums run in 8 lanes (element i in lane i % 8), the lanes are added pairwise (0 + 4, 1 + 5, ..,
+ *          then 0 + 2, 1 + 3, then 0 + 1) and the remaining elements one after another. The scalar kernel
+ *          follows the same order, so the AVX2 kernel gives identical results and both lose less precision
+ *          than one running sum.\n
+ *          Variance is the sample variance (divided by count - 1) like arm_var_f32, calculated in two passes
+ *          around the mean instead of from the sum of squares, that avoids the cancellation of a large
+ *          offset.
+ * @note    The values must not be NaN. Max and Min report the first index of the extreme.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class Statistics
+{
+    public:
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit Statistics(SimdKernel kernel = GetBestSimdKernel());
+
+        /// @brief Mean, INVALID_PARAM on no values.
+        Status Mean(std::span<const float> values, float& result) const;
+
+        /// @brief Sum of the squares, INVALID_PARAM on no values.
+        Status Power(std::span<const float> values, float& result) const;
+
+        /// @brief Root mean square, INVALID_PARAM on no values.
+        Status Rms(std::span<const float> values, float& result) const;
+
+        /// @brief Sample variance, INVALID_PARAM on less than two values.
+        Status Variance(std::span<const float> values, float& result) const;
+
+        /// @brief Sample standard deviation, INVALID_PARAM on less than two values.
+        Status StandardDeviation(std::span<const float> values, float& result) const;
+
+        /// @brief Maximum and its index, INVALID_PARAM on no values.
+        Status Max(std::span<const float> values, float& result, uint32_t& index) const;
+
+        /// @brief Minimum and its index, INVALID_PARAM on no values.
+        Status Min(std::span<const float> values, float& result, uint32_t& index) const;
+
+        /// @brief The kernel set in use.
+        SimdKernel GetKernel() const {return mKernel;};
+
+    private:
+
+        /// @brief Sum of (value - offset) or (value - offset)^2.
+        float Sum(std::span<const float> values, float offset, bool square) const;
+
+        /// @brief The largest value, of the negated values for the minimum.
+        float Extreme(std::span<const float> values, bool minimum) const;
+
+        /// @brief The kernel set.
+        SimdKernel mKernel;
+};
+
+} // end namespace Dsp
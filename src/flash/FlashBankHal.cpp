@@ -0,0 +1,107 @@
+/**
+ ********************************************************************************
+ * @file        FlashBankHal.cpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, internal flash implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FlashBankHal.hpp"
+#include "DCache.hpp"
+#include <array>
+
+using namespace Flash;
+
+const uint8_t* FlashBankHal::GetSector(uint8_t sector) const
+{
+    if (sector >= SECTORS)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint8_t*>(AddressOf(sector));
+}
+
+
+Status FlashBankHal::ProgramWord(uint8_t sector, uint32_t offset, const uint8_t* pWord)
+{
+    if ((sector >= SECTORS) || (pWord == nullptr) || ((offset % FLASH_WORD_SIZE) != 0U) ||
+        (offset >= FLASH_SECTOR_SIZE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    // the HAL reads the flash word as 32 bit words
+    std::array<uint32_t, FLASH_WORD_SIZE / 4U> word{};
+    for (size_t i = 0U; i < word.size(); i++)
+    {
+        word[i] = static_cast<uint32_t>(pWord[4U * i]) | (static_cast<uint32_t>(pWord[(4U * i) + 1U]) << 8U) |
+                  (static_cast<uint32_t>(pWord[(4U * i) + 2U]) << 16U) |
+                  (static_cast<uint32_t>(pWord[(4U * i) + 3U]) << 24U);
+    }
+    const uint32_t address = AddressOf(sector) + offset;
+    (void)HAL_FLASH_Unlock();
+    const HAL_StatusTypeDef result = HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, address,
+                                                       static_cast<uint32_t>(reinterpret_cast<uintptr_t>(word.data())));
+    (void)HAL_FLASH_Lock();
+    // the flash is read through the AXI cache
+    Utils::DCache::Invalidate(reinterpret_cast<const void*>(address), FLASH_WORD_SIZE);
+    return (result == HAL_OK) ? Status::OK : Status::HW_ERROR;
+}
+
+
+Status FlashBankHal::EraseSector(uint8_t sector)
+{
+    if (sector >= SECTORS)
+    {
+        return Status::INVALID_PARAM;
+    }
+    FLASH_EraseInitTypeDef erase{};
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Banks = BankOf(sector);
+    erase.Sector = sector % FLASH_SECTOR_TOTAL;
+    erase.NbSectors = 1U;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    uint32_t error = 0U;
+    (void)HAL_FLASH_Unlock();
+    const HAL_StatusTypeDef result = HAL_FLASHEx_Erase(&erase, &error);
+    (void)HAL_FLASH_Lock();
+    Utils::DCache::Invalidate(reinterpret_cast<const void*>(AddressOf(sector)), FLASH_SECTOR_SIZE);
+    return (result == HAL_OK) ? Status::OK : Status::HW_ERROR;
+}
+
+
+Status FlashBankHal::ComputeCrc(uint8_t sector, uint32_t offset, uint32_t length, uint32_t& crc)
+{
+    if ((sector >= SECTORS) || (length == 0U) || ((offset % CRC_BURST_SIZE) != 0U) ||
+        ((length % CRC_BURST_SIZE) != 0U) || (offset > FLASH_SECTOR_SIZE) || (length > (FLASH_SECTOR_SIZE - offset)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    FLASH_CRCInitTypeDef init{};
+    init.TypeCRC = FLASH_CRC_ADDR;
+    init.BurstSize = FLASH_CRC_BURST_SIZE_4;
+    init.Bank = BankOf(sector);
+    init.CRCStartAddr = AddressOf(sector) + offset;
+    // the end address is the last 32 bit word of the range
+    init.CRCEndAddr = init.CRCStartAddr + length - 4U;
+    (void)HAL_FLASH_Unlock();
+    const HAL_StatusTypeDef result = HAL_FLASHEx_ComputeCRC(&init, &crc);
+    (void)HAL_FLASH_Lock();
+    return (result == HAL_OK) ? Status::OK : Status::HW_ERROR;
+}
+
+
+uint32_t FlashBankHal::AddressOf(uint8_t sector)
+{
+    return FLASH_BANK1_BASE + (static_cast<uint32_t>(sector) * FLASH_SECTOR_SIZE);
+}
+
+
+uint32_t FlashBankHal::BankOf(uint8_t sector)
+{
+    return (sector < FLASH_SECTOR_TOTAL) ? FLASH_BANK_1 : FLASH_BANK_2;
+}
@@ -0,0 +1,71 @@
+/**
+ ********************************************************************************
+ * @file        FlashBankHal.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, IFlashBank on the internal flash through HAL_FLASH.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IFlashBank.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace Flash {
+
+
+/**
+ * @brief   This class provides the IFlashBank on the internal flash of the STM32H743 (2 x 8 sectors of 128 KB).
+ * @details The sectors are numbered over both banks: 0 to 7 in bank 1, 8 to 15 in bank 2. ProgramWord runs
+ *          HAL_FLASH_Program with FLASH_TYPEPROGRAM_FLASHWORD, EraseSector runs HAL_FLASHEx_Erase for one
+ *          sector, ComputeCrc runs HAL_FLASHEx_ComputeCRC by address with bursts of four flash words. The
+ *          flash is unlocked for each operation only, the D-Cache lines of a changed range are invalidated.
+ * @note    The sectors are reserved by the linker script (region KVSTORE, the last two sectors of bank 2: 14 and
+ *          15 for the KvStore configuration), so the code in bank 1 is fetched while bank 2 is written.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class FlashBankHal : public IFlashBank
+{
+    public:
+
+        /// @brief Constructor.
+        FlashBankHal() = default;
+
+        /// @copydoc IFlashBank::GetSectorSize
+        uint32_t GetSectorSize() const override {return FLASH_SECTOR_SIZE;};
+
+        /// @copydoc IFlashBank::GetSector
+        const uint8_t* GetSector(uint8_t sector) const override;
+
+        /// @copydoc IFlashBank::ProgramWord
+        Status ProgramWord(uint8_t sector, uint32_t offset, const uint8_t* pWord) override;
+
+        /// @copydoc IFlashBank::EraseSector
+        Status EraseSector(uint8_t sector) override;
+
+        /// @copydoc IFlashBank::ComputeCrc
+        Status ComputeCrc(uint8_t sector, uint32_t offset, uint32_t length, uint32_t& crc) override;
+
+    private:
+
+        /// @brief Sectors of both banks.
+        static constexpr uint8_t SECTORS{2U * FLASH_SECTOR_TOTAL};
+
+        /// @brief Address of a sector.
+        static uint32_t AddressOf(uint8_t sector);
+
+        /// @brief Bank of a sector.
+        static uint32_t BankOf(uint8_t sector);
+};
+
+} // end namespace Flash
@@ -0,0 +1,163 @@
+/**
+ ********************************************************************************
+ * @file        FlashBankSim.cpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, host emulator of the internal flash implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "FlashBankSim.hpp"
+
+using namespace Flash;
+
+namespace {
+
+/// @brief Polynomial of the CRC unit.
+constexpr uint32_t CRC_POLYNOMIAL{0x04C11DB7U};
+
+} // end anonymous namespace
+
+
+FlashBankSim::FlashBankSim(const Config& config)
+: mConfig(config)
+, mMemory(static_cast<size_t>(config.sectorSize) * config.sectors, 0xFFU)
+{
+    for (uint32_t i = 0U; i < mCrcTable.size(); i++)
+    {
+        uint32_t crc = i << 24U;
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x80000000U) != 0U) ? ((crc << 1U) ^ CRC_POLYNOMIAL) : (crc << 1U);
+        }
+        mCrcTable[i] = crc;
+    }
+}
+
+
+void FlashBankSim::CutPowerAfter(uint32_t operations, uint32_t seed)
+{
+    mCutIn = operations;
+    mRandom = (seed != 0U) ? seed : 1U;
+}
+
+
+void FlashBankSim::PowerOn()
+{
+    mPowered = true;
+    mCutIn = 0U;
+}
+
+
+const uint8_t* FlashBankSim::GetSector(uint8_t sector) const
+{
+    if (sector >= mConfig.sectors)
+    {
+        return nullptr;
+    }
+    return &mMemory[static_cast<size_t>(sector) * mConfig.sectorSize];
+}
+
+
+Status FlashBankSim::ProgramWord(uint8_t sector, uint32_t offset, const uint8_t* pWord)
+{
+    if ((sector >= mConfig.sectors) || (pWord == nullptr) || ((offset % FLASH_WORD_SIZE) != 0U) ||
+        (offset >= mConfig.sectorSize))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (!mPowered)
+    {
+        return Status::HW_ERROR;
+    }
+    uint8_t* pTarget = &mMemory[(static_cast<size_t>(sector) * mConfig.sectorSize) + offset];
+    for (size_t i = 0U; i < FLASH_WORD_SIZE; i++)
+    {
+        if (pTarget[i] != 0xFFU)
+        {
+            mOverwrites++;
+            return Status::HW_ERROR;
+        }
+    }
+    const bool cut = IsCut();
+    for (size_t i = 0U; i < FLASH_WORD_SIZE; i++)
+    {
+        // a torn program has cleared only a part of the bits
+        pTarget[i] = cut ? static_cast<uint8_t>(pWord[i] | NextRandom()) : pWord[i];
+    }
+    mPrograms++;
+    return cut ? Status::HW_ERROR : Status::OK;
+}
+
+
+Status FlashBankSim::EraseSector(uint8_t sector)
+{
+    if (sector >= mConfig.sectors)
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (!mPowered)
+    {
+        return Status::HW_ERROR;
+    }
+    const bool cut = IsCut();
+    uint8_t* pTarget = &mMemory[static_cast<size_t>(sector) * mConfig.sectorSize];
+    for (size_t i = 0U; i < mConfig.sectorSize; i++)
+    {
+        // a torn erase has set only a part of the bits
+        pTarget[i] = cut ? static_cast<uint8_t>(pTarget[i] | NextRandom()) : 0xFFU;
+    }
+    mErases++;
+    return cut ? Status::HW_ERROR : Status::OK;
+}
+
+
+Status FlashBankSim::ComputeCrc(uint8_t sector, uint32_t offset, uint32_t length, uint32_t& crc)
+{
+    if ((sector >= mConfig.sectors) || ((offset % CRC_BURST_SIZE) != 0U) || ((length % CRC_BURST_SIZE) != 0U) ||
+        (offset > mConfig.sectorSize) || (length > (mConfig.sectorSize - offset)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (!mPowered)
+    {
+        return Status::HW_ERROR;
+    }
+    const uint8_t* pData = &mMemory[(static_cast<size_t>(sector) * mConfig.sectorSize) + offset];
+    uint32_t value = 0xFFFFFFFFU;
+    for (size_t i = 0U; i < length; i++)
+    {
+        value = (value << 8U) ^ mCrcTable[(value >> 24U) ^ pData[i]];
+    }
+    crc = value;
+    return Status::OK;
+}
+
+
+bool FlashBankSim::IsCut()
+{
+    if (mCutIn == 0U)
+    {
+        return false;
+    }
+    mCutIn--;
+    if (mCutIn != 0U)
+    {
+        return false;
+    }
+    mPowered = false;
+    return true;
+}
+
+
+uint32_t FlashBankSim::NextRandom()
+{
+    mRandom ^= mRandom << 13U;
+    mRandom ^= mRandom >> 17U;
+    mRandom ^= mRandom << 5U;
+    return mRandom;
+}
@@ -0,0 +1,123 @@
+/**
+ ********************************************************************************
+ * @file        FlashBankSim.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, host emulator of the internal flash sectors with power cuts.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IFlashBank.hpp"
+#include <vector>
+namespace Flash {
+
+
+/**
+ * @brief   This class provides an IFlashBank in host memory which can lose the power in an operation.
+ * @details The emulator keeps the rules of the STM32H7 flash: a flash word is programmed once after the
+ *          erase, programming a word which is not erased is an error (and counted).\n
+ *          @ref CutPowerAfter arms a power cut in a later program or erase. The interrupted operation is
+ *          torn: a program leaves the word partially programmed (bits of the new value still 1), an erase
+ *          leaves the sector partially erased (bits of the old content already 1). All operations after the
+ *          cut fail with HW_ERROR until @ref PowerOn, the content survives. The torn bits come from a seeded
+ *          generator, so a fuzz run can be repeated.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class FlashBankSim : public IFlashBank
+{
+    public:
+
+        /// @brief Emulated sectors.
+        struct Config
+        {
+            uint32_t sectorSize{128U * 1024U};  //!< Bytes, a multiple of the flash word
+            uint8_t sectors{2U};                //!< Count of sectors
+        };
+
+        /**
+         * @brief   Constructs the erased sectors.
+         *
+         * @param   config  The sectors.
+         */
+        explicit FlashBankSim(const Config& config);
+
+        /// @brief Constructs two erased 128 KB sectors.
+        FlashBankSim() : FlashBankSim(Config{}) {};
+
+        /**
+         * @brief   Arm a power cut.
+         *
+         * @param   operations  The cut tears the n-th program or erase from now (1: the next one), 0 disarms.
+         * @param   seed        Seed of the torn bits.
+         */
+        void CutPowerAfter(uint32_t operations, uint32_t seed);
+
+        /// @brief Restore the power after a cut, a pending cut is disarmed.
+        void PowerOn();
+
+        /// @brief The power has not been cut.
+        bool IsPowered() const {return mPowered;};
+
+        /// @brief Programmed flash words.
+        uint32_t GetPrograms() const {return mPrograms;};
+
+        /// @brief Erased sectors.
+        uint32_t GetErases() const {return mErases;};
+
+        /// @brief Programs of a word which was not erased.
+        uint32_t GetOverwrites() const {return mOverwrites;};
+
+        /// @copydoc IFlashBank::GetSectorSize
+        uint32_t GetSectorSize() const override {return mConfig.sectorSize;};
+
+        /// @copydoc IFlashBank::GetSector
+        const uint8_t* GetSector(uint8_t sector) const override;
+
+        /// @copydoc IFlashBank::ProgramWord
+        Status ProgramWord(uint8_t sector, uint32_t offset, const uint8_t* pWord) override;
+
+        /// @copydoc IFlashBank::EraseSector
+        Status EraseSector(uint8_t sector) override;
+
+        /// @copydoc IFlashBank::ComputeCrc
+        Status ComputeCrc(uint8_t sector, uint32_t offset, uint32_t length, uint32_t& crc) override;
+
+    private:
+
+        /// @brief Count an operation, true if the power is cut in it.
+        bool IsCut();
+
+        /// @brief Next value of the generator (xorshift32).
+        uint32_t NextRandom();
+
+        /// @brief The sectors.
+        Config mConfig;
+
+        /// @brief Content of all sectors.
+        std::vector<uint8_t> mMemory;
+
+        /// @brief Table of the byte wise CRC.
+        std::array<uint32_t, 256> mCrcTable{};
+
+        bool mPowered{true};                //!< Operations are accepted
+        uint32_t mCutIn{0U};                //!< Operations until the cut, 0 if disarmed
+        uint32_t mRandom{1U};               //!< State of the generator
+
+        uint32_t mPrograms{0U};             //!< Programmed words
+        uint32_t mErases{0U};               //!< Erased sectors
+        uint32_t mOverwrites{0U};           //!< Programs of a word which was not erased
+};
+
+} // end namespace Flash
@@ -0,0 +1,154 @@
+/**
+ ********************************************************************************
+ * @file        FlashTypes.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, common types of the external NOR flash and the internal flash.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Placement in the memory-mapped external flash (section .extflash of the linker script).
+ * EXTFLASH_RODATA is meant for large constant tables and assets, EXTFLASH_TEXT for code which is
+ * executed in place. Neither may be accessed while a program or erase job runs (memory-mapped
+ * mode is suspended), so code on that path and the interrupt handlers stay in internal flash.
+ */
+#if defined(__arm__)
+#define EXTFLASH_RODATA     __attribute__((section(".extflash.rodata")))
+#define EXTFLASH_TEXT       __attribute__((section(".extflash.text"), noinline))
+#else
+#define EXTFLASH_RODATA
+#define EXTFLASH_TEXT
+#endif
+
+namespace Flash {
+
+
+/// @brief Address of the memory-mapped QUADSPI region.
+constexpr uint32_t QSPI_MAPPED_BASE{0x90000000U};
+
+/// @brief Erase types of the SFDP basic parameter table.
+constexpr size_t MAX_ERASE_TYPES{4U};
+
+/// @brief Program unit of the internal flash (256 bit flash word with ECC).
+constexpr size_t FLASH_WORD_SIZE{32U};
+
+/// @brief Smallest burst of the flash CRC unit (four flash words).
+constexpr uint32_t CRC_BURST_SIZE{4U * FLASH_WORD_SIZE};
+
+
+/// @brief Result of a flash operation.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The flash is busy, retry later
+    INVALID_PARAM=2,  //!< Inconsistent parameter
+    HW_ERROR=3,       //!< The controller reported an error or the device did not respond
+    PENDING=4,        //!< Job is queued or running
+    NOT_SUPPORTED=5,  //!< The device has no usable SFDP table
+    NOT_FOUND=6,      //!< The key is not stored
+    NO_SPACE=7        //!< The live data does not fit, or the index is full
+};
+
+
+/// @brief Bus lines of a command phase.
+enum class Lines : uint8_t
+{
+    NONE=0,           //!< The phase is omitted
+    SINGLE=1,         //!< One line (IO0 out, IO1 in)
+    DUAL=2,           //!< Two lines
+    QUAD=4            //!< Four lines
+};
+
+
+/**
+ * @brief   One command of the indirect or memory-mapped mode.
+ * @details The instruction is always sent on one line. Mode cycles follow the address on the address
+ *          lines, they are driven high (no continuous read mode), dummy cycles follow the mode cycles.
+ */
+struct NorCommand
+{
+    uint8_t instruction{0U};            //!< Instruction byte
+    Lines addressLines{Lines::NONE};    //!< Address phase, NONE without address
+    uint8_t addressBytes{3U};           //!< 3 or 4
+    uint32_t address{0U};               //!< Address in the device
+    uint8_t modeCycles{0U};             //!< Mode clocks after the address
+    uint8_t dummyCycles{0U};            //!< Dummy clocks before the data
+    Lines dataLines{Lines::NONE};       //!< Data phase, NONE without data
+    uint32_t length{0U};                //!< Data bytes
+};
+
+
+/// @brief One erase granularity of the device.
+struct EraseType
+{
+    uint32_t size{0U};                  //!< Bytes, 0 if unused
+    uint8_t opcode{0U};                 //!< Erase instruction
+};
+
+
+/**
+ * @brief   Organisation of the device, taken from the SFDP basic flash parameter table (JESD216).
+ * @details The erase types are sorted by size, the unused ones at the end. The read command is the
+ *          fastest read mode of the table, used for the memory-mapped mode.
+ */
+struct NorGeometry
+{
+    uint32_t size{0U};                  //!< Bytes
+    uint32_t pageSize{256U};            //!< Program page in bytes
+    uint8_t addressBytes{3U};           //!< Address bytes in use
+    uint8_t addressModes{0U};           //!< 0: 3 byte, 1: 3 or 4 byte, 2: 4 byte only
+    uint8_t enter4Byte{0U};             //!< Entry methods into the 4 byte mode (DWORD16 31:24)
+    uint8_t quadEnable{0U};             //!< Quad enable requirement (QER, DWORD15 22:20)
+    std::array<EraseType, MAX_ERASE_TYPES> erase{};     //!< Erase types, ascending
+    NorCommand read{};                  //!< Fastest read command, without address and length
+};
+
+
+/// @brief Operation of a job.
+enum class NorOperation : uint8_t
+{
+    PROGRAM=0,        //!< Program data, the bits can only change from 1 to 0
+    ERASE=1           //!< Erase a range to 0xFF
+};
+
+
+/**
+ * @brief   Descriptor of one program or erase job.
+ * @details The descriptor and the data are owned by the caller and must stay valid until the completion
+ *          callback has been called (or @ref status left PENDING). A program job may cross pages, it is
+ *          split at the page boundaries. An erase job must be aligned to the smallest erase type, it is
+ *          covered by the largest aligned erase types.
+ * @note    The data must be located in a DMA accessible RAM (not DTCM) for the MDMA on the target.
+ */
+struct NorJob
+{
+    /// @brief Completion callback, called in the completion context (ISR on the target).
+    using Callback = void (*)(NorJob& job, void* pContext);
+
+    NorOperation operation{NorOperation::PROGRAM};  //!< Program or erase
+    uint32_t address{0U};               //!< Offset in the device
+    const uint8_t* pData{nullptr};      //!< Program data, unused for erase
+    uint32_t length{0U};                //!< Bytes
+
+    Callback pCallback{nullptr};        //!< Optional completion callback
+    void* pContext{nullptr};            //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or running.
+    volatile Status status{Status::OK};
+
+    /// @brief Intrusive queue link, owned by the flash.
+    NorJob* pNext{nullptr};
+};
+
+} // end namespace Flash
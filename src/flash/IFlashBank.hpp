@@ -0,0 +1,91 @@
+/**
+ ********************************************************************************
+ * @file        IFlashBank.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, interface of the sectors of the internal flash.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "FlashTypes.hpp"
+namespace Flash {
+
+
+/**
+ * @brief   This class provides the sectors of an internal flash (hardware or host emulator).
+ * @details The sectors are readable through memory. A flash word (@ref FLASH_WORD_SIZE bytes) is programmed
+ *          once after the erase of its sector, programming it twice is an error because of the ECC. All
+ *          operations block until they have ended.\n
+ *          @ref ComputeCrc runs the CRC unit of the flash over a range which has been programmed, so the
+ *          result covers the data as it has been stored and not as it has been sent. The CRC unit reads whole
+ *          bursts, a range is therefore aligned to @ref CRC_BURST_SIZE.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class IFlashBank
+{
+    public:
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IFlashBank() = default;
+
+        /// @brief Bytes of one sector.
+        virtual uint32_t GetSectorSize() const = 0;
+
+        /**
+         * @brief Readable content of a sector.
+         * @param sector    The sector.
+         * @return Start of the sector, nullptr for an unknown sector.
+         */
+        virtual const uint8_t* GetSector(uint8_t sector) const = 0;
+
+        /**
+         * @brief Program one flash word.
+         * @param sector    The sector.
+         * @param offset    Offset in the sector, aligned to the flash word.
+         * @param pWord     @ref FLASH_WORD_SIZE bytes.
+         * @return OK, INVALID_PARAM, HW_ERROR if the word is not erased or the flash failed.
+         */
+        virtual Status ProgramWord(uint8_t sector, uint32_t offset, const uint8_t* pWord) = 0;
+
+        /**
+         * @brief Erase one sector to 0xFF.
+         * @param sector    The sector.
+         * @return OK, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status EraseSector(uint8_t sector) = 0;
+
+        /**
+         * @brief CRC-32 (polynomial 0x04C11DB7, initial value 0xFFFFFFFF) of a range of a sector.
+         * @param sector    The sector.
+         * @param offset    Offset in the sector, aligned to @ref CRC_BURST_SIZE.
+         * @param length    Bytes, a multiple of @ref CRC_BURST_SIZE.
+         * @param crc       The result.
+         * @return OK, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status ComputeCrc(uint8_t sector, uint32_t offset, uint32_t length, uint32_t& crc) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IFlashBank() = default;
+
+        IFlashBank(IFlashBank const &) = default;             //!< Copy constructor
+        IFlashBank(IFlashBank &&) = default;                  //!< Move constructor
+
+        IFlashBank& operator=(IFlashBank const &) = default;  //!< Copy assignment
+        IFlashBank& operator=(IFlashBank &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Flash
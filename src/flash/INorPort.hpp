@@ -0,0 +1,122 @@
+/**
+ ********************************************************************************
+ * @file        INorPort.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, interface of a quad SPI controller with a NOR flash.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "FlashTypes.hpp"
+namespace Flash {
+
+
+/**
+ * @brief   This class provides the command phases of one quad SPI controller (hardware or host model).
+ * @details @ref Read and @ref Write run short commands in the indirect mode and block until they have ended.
+ *          @ref WriteDma and @ref PollStatus start a command and report its end by the listener: the data of a
+ *          page program is moved by DMA, the status register is polled by the controller until the masked
+ *          value matches.\n
+ *          In the memory-mapped mode the controller serves reads of the mapped region with the read command,
+ *          no other command can be run until @ref ExitMemoryMapped.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class INorPort
+{
+    public:
+
+        /// @brief Receiver of the command events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A DMA write or a status poll has ended, called from the interrupt context.
+                 * @param status    OK or HW_ERROR.
+                 */
+                virtual void OnDone(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~INorPort() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Run a command with a read data phase.
+         * @param command   The command, length bytes are read.
+         * @param pData     Receive buffer.
+         * @return OK, BUSY in memory-mapped mode or while a command runs, HW_ERROR.
+         */
+        virtual Status Read(const NorCommand& command, uint8_t* pData) = 0;
+
+        /**
+         * @brief Run a command with an optional write data phase.
+         * @param command   The command, length bytes are written.
+         * @param pData     Transmit data, nullptr without data phase.
+         * @return OK, BUSY in memory-mapped mode or while a command runs, HW_ERROR.
+         */
+        virtual Status Write(const NorCommand& command, const uint8_t* pData) = 0;
+
+        /**
+         * @brief Start a command with a write data phase by DMA, the end is reported by the listener.
+         * @param command   The command, length bytes are written.
+         * @param pData     Transmit data, valid until the end.
+         * @return OK, BUSY, HW_ERROR.
+         */
+        virtual Status WriteDma(const NorCommand& command, const uint8_t* pData) = 0;
+
+        /**
+         * @brief Start polling a one byte status until (status & mask) == match, reported by the listener.
+         * @param command   The status read command.
+         * @param mask      Tested bits.
+         * @param match     Expected value of the tested bits.
+         * @return OK, BUSY, HW_ERROR.
+         */
+        virtual Status PollStatus(const NorCommand& command, uint8_t mask, uint8_t match) = 0;
+
+        /**
+         * @brief Enter the memory-mapped mode, the caches of the mapped region are invalidated.
+         * @param command   The read command, without address and length.
+         * @return OK, BUSY while a command runs, HW_ERROR.
+         */
+        virtual Status EnterMemoryMapped(const NorCommand& command) = 0;
+
+        /// @brief Leave the memory-mapped mode, no effect in the indirect mode.
+        virtual void ExitMemoryMapped() = 0;
+
+        /// @brief Start of the mapped region, nullptr in the indirect mode.
+        virtual const uint8_t* GetMapped() const = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        INorPort() = default;
+
+        INorPort(INorPort const &) = default;             //!< Copy constructor
+        INorPort(INorPort &&) = default;                  //!< Move constructor
+
+        INorPort& operator=(INorPort const &) = default;  //!< Copy assignment
+        INorPort& operator=(INorPort &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Flash
@@ -0,0 +1,698 @@
+/**
+ ********************************************************************************
+ * @file        KvStore.cpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, key/value store implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "KvStore.hpp"
+#include <cstring>
+#include <limits>
+
+using namespace Flash;
+
+namespace {
+
+/// @brief "KVS1", first word of a sector header.
+constexpr uint32_t SECTOR_MAGIC{0x3153564BU};
+
+/// @brief "SEAL", the sector holds all live records, the other sector is obsolete.
+constexpr uint32_t SEAL_MAGIC{0x4C414553U};
+
+/// @brief "KVR1", first word of a record header.
+constexpr uint32_t RECORD_MAGIC{0x3152564BU};
+
+/// @brief "KVC1", first word of a commit word.
+constexpr uint32_t COMMIT_MAGIC{0x3143564BU};
+
+/// @brief Record types.
+constexpr uint32_t TYPE_VALUE{1U};
+constexpr uint32_t TYPE_TOMBSTONE{2U};
+
+/// @brief The seal word follows the header word, the first record follows the header burst.
+constexpr uint32_t SEAL_OFFSET{FLASH_WORD_SIZE};
+constexpr uint32_t FIRST_RECORD{KvStore::RECORD_ALIGN};
+
+/// @brief One flash word.
+using Word = std::array<uint8_t, FLASH_WORD_SIZE>;
+
+/// @brief Little endian word at a byte offset.
+uint32_t Load32(const uint8_t* pData)
+{
+    return static_cast<uint32_t>(pData[0]) | (static_cast<uint32_t>(pData[1]) << 8U) |
+           (static_cast<uint32_t>(pData[2]) << 16U) | (static_cast<uint32_t>(pData[3]) << 24U);
+}
+
+/// @brief Store a little endian word at a byte offset.
+void Store32(uint8_t* pData, uint32_t value)
+{
+    pData[0] = static_cast<uint8_t>(value);
+    pData[1] = static_cast<uint8_t>(value >> 8U);
+    pData[2] = static_cast<uint8_t>(value >> 16U);
+    pData[3] = static_cast<uint8_t>(value >> 24U);
+}
+
+/// @brief Round up to a power of two.
+uint32_t Align(size_t value, uint32_t alignment)
+{
+    return static_cast<uint32_t>((value + alignment - 1U) & ~static_cast<size_t>(alignment - 1U));
+}
+
+/// @brief Bytes of the data words of a record.
+uint32_t DataSize(size_t keyLength, size_t valueLength)
+{
+    return Align(keyLength + valueLength, FLASH_WORD_SIZE);
+}
+
+/// @brief Bytes of the bursts of the header word and the data words, covered by the CRC.
+uint32_t BodySize(size_t keyLength, size_t valueLength)
+{
+    return Align(FLASH_WORD_SIZE + DataSize(keyLength, valueLength), KvStore::RECORD_ALIGN);
+}
+
+/// @brief Bytes of a record in the flash: body and the burst of the commit word.
+uint32_t RecordSize(size_t keyLength, size_t valueLength)
+{
+    return BodySize(keyLength, valueLength) + KvStore::RECORD_ALIGN;
+}
+
+/// @brief Check word of a record header.
+uint32_t HeaderCheck(uint32_t hash, uint32_t lengths, uint32_t type)
+{
+    return ~(RECORD_MAGIC ^ hash ^ lengths ^ type);
+}
+
+/// @brief FNV-1a hash of a key.
+uint32_t HashOf(const uint8_t* pKey, size_t length)
+{
+    uint32_t hash = 0x811C9DC5U;
+    for (size_t i = 0U; i < length; i++)
+    {
+        hash = (hash ^ pKey[i]) * 0x01000193U;
+    }
+    return hash;
+}
+
+/// @brief Key of the record at an offset of a sector.
+const uint8_t* KeyAt(const uint8_t* pSector, uint32_t offset)
+{
+    return &pSector[offset + FLASH_WORD_SIZE];
+}
+
+} // end anonymous namespace
+
+
+KvStore::KvStore(IFlashBank& bank, const Config& config)
+: mBank(bank)
+, mConfig(config)
+{
+}
+
+
+Status KvStore::Mount()
+{
+    const uint32_t sectorSize = mBank.GetSectorSize();
+    if ((mConfig.sectorA == mConfig.sectorB) || (mBank.GetSector(mConfig.sectorA) == nullptr) ||
+        (mBank.GetSector(mConfig.sectorB) == nullptr) || ((sectorSize % RECORD_ALIGN) != 0U) ||
+        (sectorSize < (FIRST_RECORD + RecordSize(MAX_KEY_LENGTH, MAX_VALUE_LENGTH))) ||
+        (sectorSize > std::numeric_limits<uint32_t>::max() / 2U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mMounted = false;
+    mCompacting = false;
+    mIndex.fill(Slot{});
+    mFree.fill(0U);
+    mLive.fill(0U);
+    mDirty.fill(false);
+    mCount = 0U;
+    mCompactions = 0U;
+    mScanned = 0U;
+
+    std::array<bool, 2> valid{};
+    std::array<bool, 2> sealed{};
+    std::array<uint32_t, 2> generation{};
+    for (uint8_t side = 0U; side < 2U; side++)
+    {
+        const uint8_t* pSector = mBank.GetSector(SectorOf(side));
+        valid[side] = (Load32(pSector) == SECTOR_MAGIC) && (Load32(&pSector[4]) == ~Load32(&pSector[8]));
+        generation[side] = Load32(&pSector[4]);
+        // a torn seal is only written after the last move, any programmed bit counts
+        sealed[side] = false;
+        for (size_t i = 0U; i < FLASH_WORD_SIZE; i++)
+        {
+            sealed[side] = sealed[side] || (pSector[SEAL_OFFSET + i] != 0xFFU);
+        }
+    }
+
+    if (!valid[0] && !valid[1])
+    {
+        // a new store: format the first sector, the second one is erased in the background
+        if ((FindEnd(0U) != 0U) && (mBank.EraseSector(mConfig.sectorA) != Status::OK))
+        {
+            return Status::HW_ERROR;
+        }
+        Status status = WriteHeader(0U, 1U, false);
+        if (status == Status::OK)
+        {
+            status = WriteHeader(0U, 1U, true);
+        }
+        if (status != Status::OK)
+        {
+            return status;
+        }
+        mActive = 0U;
+        mGeneration = 1U;
+        mFree[0] = FIRST_RECORD;
+        mDirty[1] = (FindEnd(1U) != 0U);
+    }
+    else if (valid[0] != valid[1])
+    {
+        mActive = valid[0] ? 0U : 1U;
+        mGeneration = generation[mActive];
+        mDirty[1U - mActive] = (FindEnd(static_cast<uint8_t>(1U - mActive)) != 0U);
+        Scan(mActive);
+    }
+    else
+    {
+        mActive = (static_cast<int32_t>(generation[1] - generation[0]) > 0) ? 1U : 0U;
+        mGeneration = generation[mActive];
+        const uint8_t old = static_cast<uint8_t>(1U - mActive);
+        if (sealed[mActive])
+        {
+            mDirty[old] = true;
+            Scan(mActive);
+        }
+        else
+        {
+            // interrupted compaction: the newer records override the older ones, the moves are resumed
+            Scan(old);
+            Scan(mActive);
+            mCompacting = true;
+            mCursor = FIRST_RECORD;
+        }
+    }
+    mMounted = true;
+    return Status::OK;
+}
+
+
+Status KvStore::Set(const char* pKey, const void* pValue, size_t length)
+{
+    if (!mMounted)
+    {
+        return Status::BUSY;
+    }
+    size_t keyLength = 0U;
+    if (!CheckKey(pKey, keyLength) || (length > MAX_VALUE_LENGTH) || ((length != 0U) && (pValue == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const uint32_t hash = HashOf(reinterpret_cast<const uint8_t*>(pKey), keyLength);
+    if ((Find(pKey, keyLength, hash) == INDEX_SLOTS) && (mCount >= MAX_KEYS))
+    {
+        return Status::NO_SPACE;
+    }
+    return Append(pKey, keyLength, pValue, length, false);
+}
+
+
+Status KvStore::Get(const char* pKey, void* pValue, size_t capacity, size_t& length) const
+{
+    if (!mMounted)
+    {
+        return Status::BUSY;
+    }
+    size_t keyLength = 0U;
+    if (!CheckKey(pKey, keyLength))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const size_t slot = Find(pKey, keyLength, HashOf(reinterpret_cast<const uint8_t*>(pKey), keyLength));
+    if (slot == INDEX_SLOTS)
+    {
+        return Status::NOT_FOUND;
+    }
+    const uint8_t* pSector = mBank.GetSector(SectorOf(mIndex[slot].side));
+    const uint32_t offset = mIndex[slot].offset;
+    length = Load32(&pSector[offset + 8U]) >> 16U;
+    if ((length > capacity) || ((length != 0U) && (pValue == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (length != 0U)
+    {
+        (void)std::memcpy(pValue, &KeyAt(pSector, offset)[keyLength], length);
+    }
+    return Status::OK;
+}
+
+
+Status KvStore::Remove(const char* pKey)
+{
+    if (!mMounted)
+    {
+        return Status::BUSY;
+    }
+    size_t keyLength = 0U;
+    if (!CheckKey(pKey, keyLength))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (Find(pKey, keyLength, HashOf(reinterpret_cast<const uint8_t*>(pKey), keyLength)) == INDEX_SLOTS)
+    {
+        return Status::NOT_FOUND;
+    }
+    return Append(pKey, keyLength, nullptr, 0U, true);
+}
+
+
+bool KvStore::Service()
+{
+    if (!mMounted)
+    {
+        return false;
+    }
+    const uint8_t spare = static_cast<uint8_t>(1U - mActive);
+    Status status = Status::OK;
+    if (mCompacting)
+    {
+        status = Compact(mConfig.copyBatch);
+    }
+    else if (mDirty[spare])
+    {
+        status = mBank.EraseSector(SectorOf(spare));
+        mDirty[spare] = (status != Status::OK);
+    }
+    else
+    {
+        // the compaction has to free at least the threshold, otherwise it would run again right away
+        const uint32_t dead = mFree[mActive] - FIRST_RECORD - mLive[mActive];
+        if ((GetFree() >= mConfig.compactThreshold) || (dead < mConfig.compactThreshold))
+        {
+            return false;
+        }
+        status = StartCompaction();
+    }
+    return (status == Status::OK);
+}
+
+
+uint32_t KvStore::GetFree() const
+{
+    if (!mMounted)
+    {
+        return 0U;
+    }
+    return mBank.GetSectorSize() - mFree[mActive];
+}
+
+
+bool KvStore::CheckKey(const char* pKey, size_t& length)
+{
+    if (pKey == nullptr)
+    {
+        return false;
+    }
+    length = 0U;
+    while ((length <= MAX_KEY_LENGTH) && (pKey[length] != '\0'))
+    {
+        length++;
+    }
+    return (length != 0U) && (length <= MAX_KEY_LENGTH);
+}
+
+
+size_t KvStore::Find(const char* pKey, size_t length, uint32_t hash) const
+{
+    size_t slot = hash & (INDEX_SLOTS - 1U);
+    for (size_t probe = 0U; probe < INDEX_SLOTS; probe++)
+    {
+        const Slot& entry = mIndex[slot];
+        if (entry.offset == 0U)
+        {
+            break;
+        }
+        if (entry.hash == hash)
+        {
+            const uint8_t* pSector = mBank.GetSector(SectorOf(entry.side));
+            if (((Load32(&pSector[entry.offset + 8U]) & 0xFFFFU) == length) &&
+                (std::memcmp(KeyAt(pSector, entry.offset), pKey, length) == 0))
+            {
+                return slot;
+            }
+        }
+        slot = (slot + 1U) & (INDEX_SLOTS - 1U);
+    }
+    return INDEX_SLOTS;
+}
+
+
+Status KvStore::Apply(uint8_t side, uint32_t offset, const Record& record)
+{
+    const uint8_t* pKey = KeyAt(mBank.GetSector(SectorOf(side)), offset);
+    size_t slot = Find(reinterpret_cast<const char*>(pKey), record.keyLength, record.hash);
+    if (slot != INDEX_SLOTS)
+    {
+        mLive[mIndex[slot].side] -= mIndex[slot].size;
+        if (record.tombstone)
+        {
+            Erase(slot);
+            mCount--;
+            return Status::OK;
+        }
+    }
+    else if (record.tombstone)
+    {
+        return Status::OK;
+    }
+    else if (mCount >= MAX_KEYS)
+    {
+        return Status::NO_SPACE;
+    }
+    else
+    {
+        slot = record.hash & (INDEX_SLOTS - 1U);
+        while (mIndex[slot].offset != 0U)
+        {
+            slot = (slot + 1U) & (INDEX_SLOTS - 1U);
+        }
+        mCount++;
+    }
+    mIndex[slot] = Slot{record.hash, offset, static_cast<uint16_t>(record.size), side};
+    mLive[side] += record.size;
+    return Status::OK;
+}
+
+
+void KvStore::Erase(size_t slot)
+{
+    size_t hole = slot;
+    size_t next = slot;
+    mIndex[hole] = Slot{};
+    for (;;)
+    {
+        next = (next + 1U) & (INDEX_SLOTS - 1U);
+        if (mIndex[next].offset == 0U)
+        {
+            break;
+        }
+        // an entry moves into the hole unless its home lies cyclically in (hole, next]
+        const size_t home = mIndex[next].hash & (INDEX_SLOTS - 1U);
+        const bool stays = (hole <= next) ? ((hole < home) && (home <= next)) : ((hole < home) || (home <= next));
+        if (!stays)
+        {
+            mIndex[hole] = mIndex[next];
+            mIndex[next] = Slot{};
+            hole = next;
+        }
+    }
+}
+
+
+KvStore::Record KvStore::Parse(uint8_t side, uint32_t offset) const
+{
+    Record record{};
+    const uint32_t sectorSize = mBank.GetSectorSize();
+    const uint8_t* pHeader = &mBank.GetSector(SectorOf(side))[offset];
+    const uint32_t lengths = Load32(&pHeader[8]);
+    const uint32_t type = Load32(&pHeader[12]);
+    record.hash = Load32(&pHeader[4]);
+    record.keyLength = static_cast<uint16_t>(lengths);
+    record.valueLength = static_cast<uint16_t>(lengths >> 16U);
+    if ((Load32(pHeader) != RECORD_MAGIC) || (Load32(&pHeader[16]) != HeaderCheck(record.hash, lengths, type)) ||
+        ((type != TYPE_VALUE) && (type != TYPE_TOMBSTONE)) || (record.keyLength == 0U) ||
+        (record.keyLength > MAX_KEY_LENGTH) || (record.valueLength > MAX_VALUE_LENGTH))
+    {
+        return record;
+    }
+    record.size = RecordSize(record.keyLength, record.valueLength);
+    if (record.size > (sectorSize - offset))
+    {
+        return record;
+    }
+    const uint32_t committed = BodySize(record.keyLength, record.valueLength);
+    uint32_t crc = 0U;
+    record.tombstone = (type == TYPE_TOMBSTONE);
+    record.valid = (Load32(&pHeader[committed]) == COMMIT_MAGIC) &&
+                   (mBank.ComputeCrc(SectorOf(side), offset, committed, crc) == Status::OK) &&
+                   (Load32(&pHeader[committed + 4U]) == crc);
+    return record;
+}
+
+
+void KvStore::Scan(uint8_t side)
+{
+    const uint32_t end = FindEnd(side);
+    mFree[side] = (end > FIRST_RECORD) ? end : FIRST_RECORD;
+    uint32_t offset = FIRST_RECORD;
+    while (offset < end)
+    {
+        const Record record = Parse(side, offset);
+        mScanned++;
+        if (record.valid)
+        {
+            (void)Apply(side, offset, record);
+            offset += record.size;
+        }
+        else
+        {
+            // a torn record, the next record starts at one of the following alignments
+            offset += RECORD_ALIGN;
+        }
+    }
+}
+
+
+uint32_t KvStore::FindEnd(uint8_t side) const
+{
+    const uint8_t* pSector = mBank.GetSector(SectorOf(side));
+    uint32_t end = mBank.GetSectorSize();
+    while ((end > 0U) && (pSector[end - 1U] == 0xFFU))
+    {
+        end--;
+    }
+    return Align(end, RECORD_ALIGN);
+}
+
+
+Status KvStore::Write(uint8_t side, uint32_t offset, const uint8_t* pHeader, const uint8_t* pFirst,
+                      size_t firstLength, const uint8_t* pSecond, size_t secondLength)
+{
+    const uint8_t sector = SectorOf(side);
+    Status status = mBank.ProgramWord(sector, offset, pHeader);
+    const size_t length = firstLength + secondLength;
+    uint32_t position = offset + FLASH_WORD_SIZE;
+    for (size_t done = 0U; (status == Status::OK) && (done < length); done += FLASH_WORD_SIZE)
+    {
+        Word word{};
+        word.fill(0xFFU);
+        for (size_t i = 0U; (i < FLASH_WORD_SIZE) && ((done + i) < length); i++)
+        {
+            const size_t index = done + i;
+            word[i] = (index < firstLength) ? pFirst[index] : pSecond[index - firstLength];
+        }
+        status = mBank.ProgramWord(sector, position, word.data());
+        position += FLASH_WORD_SIZE;
+    }
+    // the erased words up to the end of the burst are covered as well, they stay erased
+    position = offset + Align(position - offset, RECORD_ALIGN);
+    uint32_t crc = 0U;
+    if (status == Status::OK)
+    {
+        status = mBank.ComputeCrc(sector, offset, position - offset, crc);
+    }
+    if (status == Status::OK)
+    {
+        Word commit{};
+        Store32(&commit[0], COMMIT_MAGIC);
+        Store32(&commit[4], crc);
+        status = mBank.ProgramWord(sector, position, commit.data());
+    }
+    return status;
+}
+
+
+Status KvStore::Append(const char* pKey, size_t keyLength, const void* pValue, size_t length, bool tombstone)
+{
+    Record record{};
+    record.tombstone = tombstone;
+    record.hash = HashOf(reinterpret_cast<const uint8_t*>(pKey), keyLength);
+    record.keyLength = static_cast<uint16_t>(keyLength);
+    record.valueLength = static_cast<uint16_t>(length);
+    record.size = RecordSize(keyLength, length);
+    Status status = Reserve(record.size);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    // the space is taken before the write, a failed record is skipped like a torn one
+    const uint8_t side = mActive;
+    const uint32_t offset = mFree[side];
+    mFree[side] += record.size;
+    Word header{};
+    const uint32_t lengths = static_cast<uint32_t>(keyLength) | (static_cast<uint32_t>(length) << 16U);
+    const uint32_t type = tombstone ? TYPE_TOMBSTONE : TYPE_VALUE;
+    Store32(&header[0], RECORD_MAGIC);
+    Store32(&header[4], record.hash);
+    Store32(&header[8], lengths);
+    Store32(&header[12], type);
+    Store32(&header[16], HeaderCheck(record.hash, lengths, type));
+    status = Write(side, offset, header.data(), reinterpret_cast<const uint8_t*>(pKey), keyLength,
+                   static_cast<const uint8_t*>(pValue), length);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    record.valid = true;
+    return Apply(side, offset, record);
+}
+
+
+Status KvStore::Reserve(uint32_t size)
+{
+    const uint32_t sectorSize = mBank.GetSectorSize();
+    if ((mLive[0] + mLive[1] + size) > (sectorSize - FIRST_RECORD))
+    {
+        return Status::NO_SPACE;
+    }
+    for (uint32_t attempt = 0U; attempt < 2U; attempt++)
+    {
+        if (!mCompacting)
+        {
+            if (size <= (sectorSize - mFree[mActive]))
+            {
+                return Status::OK;
+            }
+            const Status status = StartCompaction();
+            if (status != Status::OK)
+            {
+                return status;
+            }
+        }
+        // the records which are still to be moved keep their room
+        if ((size + mLive[1U - mActive]) <= (sectorSize - mFree[mActive]))
+        {
+            return Status::OK;
+        }
+        const Status status = Compact(std::numeric_limits<uint32_t>::max());
+        if (status != Status::OK)
+        {
+            return status;
+        }
+    }
+    return Status::NO_SPACE;
+}
+
+
+Status KvStore::StartCompaction()
+{
+    const uint8_t spare = static_cast<uint8_t>(1U - mActive);
+    if (mDirty[spare])
+    {
+        if (mBank.EraseSector(SectorOf(spare)) != Status::OK)
+        {
+            return Status::HW_ERROR;
+        }
+        mDirty[spare] = false;
+    }
+    const Status status = WriteHeader(spare, mGeneration + 1U, false);
+    if (status != Status::OK)
+    {
+        mDirty[spare] = true;
+        return status;
+    }
+    mFree[spare] = FIRST_RECORD;
+    mLive[spare] = 0U;
+    mActive = spare;
+    mGeneration++;
+    mCompacting = true;
+    mCursor = FIRST_RECORD;
+    return Status::OK;
+}
+
+
+Status KvStore::Compact(uint32_t count)
+{
+    const uint8_t old = static_cast<uint8_t>(1U - mActive);
+    const uint8_t* pOld = mBank.GetSector(SectorOf(old));
+    while ((count > 0U) && (mCursor < mFree[old]))
+    {
+        const uint32_t offset = mCursor;
+        const Record record = Parse(old, offset);
+        if (!record.valid)
+        {
+            mCursor += RECORD_ALIGN;
+            continue;
+        }
+        mCursor += record.size;
+        count--;
+        if (record.tombstone)
+        {
+            continue;
+        }
+        // only the record the index points to is live
+        const size_t slot = Find(reinterpret_cast<const char*>(KeyAt(pOld, offset)), record.keyLength, record.hash);
+        if ((slot == INDEX_SLOTS) || (mIndex[slot].side != old) || (mIndex[slot].offset != offset))
+        {
+            continue;
+        }
+        const uint32_t target = mFree[mActive];
+        if (record.size > (mBank.GetSectorSize() - target))
+        {
+            return Status::NO_SPACE;
+        }
+        mFree[mActive] += record.size;
+        const Status status = Write(mActive, target, &pOld[offset], KeyAt(pOld, offset),
+                                    static_cast<size_t>(record.keyLength) + record.valueLength, nullptr, 0U);
+        if (status != Status::OK)
+        {
+            mCursor = offset;
+            return status;
+        }
+        mLive[old] -= record.size;
+        mLive[mActive] += record.size;
+        mIndex[slot].side = mActive;
+        mIndex[slot].offset = target;
+    }
+    if (mCursor < mFree[old])
+    {
+        return Status::OK;
+    }
+
+    // all live records moved: seal the new generation, then the old one may go
+    Status status = WriteHeader(mActive, mGeneration, true);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    mCompacting = false;
+    mCompactions++;
+    status = mBank.EraseSector(SectorOf(old));
+    mDirty[old] = (status != Status::OK);
+    mFree[old] = 0U;
+    return status;
+}
+
+
+Status KvStore::WriteHeader(uint8_t side, uint32_t generation, bool seal)
+{
+    Word word{};
+    if (seal)
+    {
+        Store32(&word[0], SEAL_MAGIC);
+        Store32(&word[4], generation);
+        return mBank.ProgramWord(SectorOf(side), SEAL_OFFSET, word.data());
+    }
+    Store32(&word[0], SECTOR_MAGIC);
+    Store32(&word[4], generation);
+    Store32(&word[8], ~generation);
+    return mBank.ProgramWord(SectorOf(side), 0U, word.data());
+}
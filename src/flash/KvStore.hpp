@@ -0,0 +1,244 @@
+/**
+ ********************************************************************************
+ * @file        KvStore.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, log-structured key/value store on two sectors of the internal flash.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IFlashBank.hpp"
+namespace Flash {
+
+
+/**
+ * @brief   This class provides a wear-leveled key/value store which appends its records to a flash sector.
+ * @details A write appends a record (header word, key and value words, commit word) behind the last one, a
+ *          remove appends a tombstone. Nothing is rewritten in place, a sector is only erased when its live
+ *          records have been moved. Records are aligned to @ref RECORD_ALIGN (one burst of the flash CRC
+ *          unit).\n
+ *          Commit: the commit word is programmed last and holds the CRC of the bursts of the header and data
+ *          words, computed by the flash over the stored words. It starts a burst of its own, since the CRC
+ *          unit reads whole bursts. A record without a matching commit word (power cut in the write) is
+ *          skipped, the previous value of the key stays valid.\n
+ *          Index: @ref Mount scans the sectors and rebuilds a hash index (open addressing, linear probing)
+ *          of key hash to record location in RAM, the keys are compared in the flash.\n
+ *          Compaction: when the free space of the active sector falls below the threshold, @ref Service
+ *          starts a new generation in the other sector and moves a batch of live records per call. Writes
+ *          go to the new sector meanwhile. When all live records have been moved, the new sector is sealed
+ *          and the old one erased. A compaction interrupted by a power cut is resumed by @ref Mount (both
+ *          sectors valid, the newer one not sealed). If a write does not fit, the compaction is finished
+ *          by the write.
+ * @note    The erase blocks for the erase time of a sector (up to seconds), @ref Service is meant for a low
+ *          priority context. The store sectors should be in the other bank than the code, so the code is
+ *          fetched while the flash writes.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class KvStore
+{
+    public:
+
+        /// @brief Longest key in bytes.
+        static constexpr size_t MAX_KEY_LENGTH{32U};
+
+        /// @brief Longest value in bytes.
+        static constexpr size_t MAX_VALUE_LENGTH{1024U};
+
+        /// @brief Stored keys.
+        static constexpr size_t MAX_KEYS{256U};
+
+        /// @brief Alignment of the records and the sector header.
+        static constexpr uint32_t RECORD_ALIGN{CRC_BURST_SIZE};
+
+        /// @brief Store parameters.
+        struct Config
+        {
+            uint8_t sectorA{0U};                //!< First sector of the bank
+            uint8_t sectorB{1U};                //!< Second sector of the bank
+            uint32_t compactThreshold{16384U};  //!< Free bytes of the active sector which start a compaction
+            uint32_t copyBatch{8U};             //!< Records of the old sector checked per Service call
+        };
+
+        /**
+         * @brief   Constructs the store, the sectors are read by @ref Mount.
+         *
+         * @param   bank    The flash.
+         * @param   config  The store parameters.
+         */
+        KvStore(IFlashBank& bank, const Config& config);
+
+        /// @brief Constructs the store on the sectors 0 and 1 of the bank.
+        explicit KvStore(IFlashBank& bank) : KvStore(bank, Config{}) {};
+
+        KvStore(KvStore const &) = delete;             //!< Copy constructor
+        KvStore& operator=(KvStore const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Rebuild the index from the sectors, format them if none is valid.
+         *
+         * @return  OK, INVALID_PARAM for an unusable configuration, HW_ERROR.
+         */
+        Status Mount();
+
+        /**
+         * @brief   Store a value.
+         *
+         * @param   pKey    Zero terminated key, 1 to MAX_KEY_LENGTH bytes.
+         * @param   pValue  The value, nullptr for an empty value.
+         * @param   length  Bytes of the value.
+         *
+         * @return  OK when committed, BUSY before Mount, INVALID_PARAM, HW_ERROR, NO_SPACE if the index is full
+         *          or the live records and the new one exceed a sector.
+         */
+        Status Set(const char* pKey, const void* pValue, size_t length);
+
+        /**
+         * @brief   Read a value.
+         *
+         * @param   pKey        Zero terminated key.
+         * @param   pValue      Receive buffer.
+         * @param   capacity    Bytes of the buffer.
+         * @param   length      Bytes of the value.
+         *
+         * @return  OK, BUSY before Mount, NOT_FOUND, INVALID_PARAM if the value doesn't fit.
+         */
+        Status Get(const char* pKey, void* pValue, size_t capacity, size_t& length) const;
+
+        /**
+         * @brief   Remove a value.
+         *
+         * @param   pKey    Zero terminated key.
+         *
+         * @return  OK when committed, BUSY before Mount, NOT_FOUND, NO_SPACE, HW_ERROR.
+         */
+        Status Remove(const char* pKey);
+
+        /**
+         * @brief   Background work: erase the spare sector, start or continue a compaction.
+         *
+         * @return  true while work is left, false when idle or after a flash error.
+         */
+        bool Service();
+
+        /// @brief Stored keys.
+        size_t GetCount() const {return mCount;};
+
+        /// @brief Free bytes of the sector which takes the writes.
+        uint32_t GetFree() const;
+
+        /// @brief Generation of the active sector.
+        uint32_t GetGeneration() const {return mGeneration;};
+
+        /// @brief A compaction is running.
+        bool IsCompacting() const {return mCompacting;};
+
+        /// @brief Finished compactions since Mount.
+        uint32_t GetCompactions() const {return mCompactions;};
+
+        /// @brief Records checked by the last Mount.
+        uint32_t GetScanned() const {return mScanned;};
+
+    private:
+
+        /// @brief Slots of the index, twice the keys.
+        static constexpr size_t INDEX_SLOTS{2U * MAX_KEYS};
+
+        /// @brief One slot of the index.
+        struct Slot
+        {
+            uint32_t hash{0U};                  //!< Hash of the key
+            uint32_t offset{0U};                //!< Offset of the record in the sector, 0 if empty
+            uint16_t size{0U};                  //!< Bytes of the record in the flash
+            uint8_t side{0U};                   //!< 0: sector A, 1: sector B
+        };
+
+        /// @brief A record found in the flash.
+        struct Record
+        {
+            bool valid{false};                  //!< The record is committed
+            bool tombstone{false};              //!< The record removes its key
+            uint32_t hash{0U};                  //!< Hash of the key
+            uint16_t keyLength{0U};             //!< Bytes of the key
+            uint16_t valueLength{0U};           //!< Bytes of the value
+            uint32_t size{0U};                  //!< Bytes in the flash
+        };
+
+        /// @brief Sector of a side.
+        uint8_t SectorOf(uint8_t side) const {return (side == 0U) ? mConfig.sectorA : mConfig.sectorB;};
+
+        /// @brief Validate a key, its length in length.
+        static bool CheckKey(const char* pKey, size_t& length);
+
+        /// @brief Slot of a key or INDEX_SLOTS.
+        size_t Find(const char* pKey, size_t length, uint32_t hash) const;
+
+        /// @brief Point the key of a record to it, a tombstone removes the key.
+        Status Apply(uint8_t side, uint32_t offset, const Record& record);
+
+        /// @brief Remove a slot, the following slots of the probe run are shifted back.
+        void Erase(size_t slot);
+
+        /// @brief Read the record at an offset.
+        Record Parse(uint8_t side, uint32_t offset) const;
+
+        /// @brief Apply all committed records of a side.
+        void Scan(uint8_t side);
+
+        /// @brief End of the programmed area of a side, aligned to RECORD_ALIGN, 0 if erased.
+        uint32_t FindEnd(uint8_t side) const;
+
+        /// @brief Program the header word, the data words (first and second part) and the commit word of a record.
+        Status Write(uint8_t side, uint32_t offset, const uint8_t* pHeader, const uint8_t* pFirst, size_t firstLength,
+                     const uint8_t* pSecond, size_t secondLength);
+
+        /// @brief Append a record to the side which takes the writes and apply it.
+        Status Append(const char* pKey, size_t keyLength, const void* pValue, size_t length, bool tombstone);
+
+        /// @brief Make room for a record, runs a compaction if needed.
+        Status Reserve(uint32_t size);
+
+        /// @brief Erase the spare side and write the header of the next generation.
+        Status StartCompaction();
+
+        /// @brief Move up to count records, finish the compaction after the last one.
+        Status Compact(uint32_t count);
+
+        /// @brief Program the header word or the seal word of a side.
+        Status WriteHeader(uint8_t side, uint32_t generation, bool seal);
+
+        /// @brief The flash.
+        IFlashBank& mBank;
+
+        /// @brief Store parameters.
+        Config mConfig;
+
+        /// @brief The index.
+        std::array<Slot, INDEX_SLOTS> mIndex{};
+
+        std::array<uint32_t, 2> mFree{};    //!< Offset of the next record per side
+        std::array<uint32_t, 2> mLive{};    //!< Bytes of the indexed records per side
+        std::array<bool, 2> mDirty{};       //!< The side must be erased before use
+
+        bool mMounted{false};               //!< Mount has succeeded
+        bool mCompacting{false};            //!< Live records of the other side are moved
+        uint8_t mActive{0U};                //!< Side which takes the writes
+        uint32_t mCursor{0U};               //!< Next record of the compaction in the old side
+        uint32_t mGeneration{0U};           //!< Generation of the active side
+        size_t mCount{0U};                  //!< Stored keys
+
+        uint32_t mCompactions{0U};          //!< Finished compactions
+        uint32_t mScanned{0U};              //!< Records checked by Mount
+};
+
+} // end namespace Flash
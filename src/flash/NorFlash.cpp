@@ -0,0 +1,526 @@
+/**
+ ********************************************************************************
+ * @file        NorFlash.cpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, external NOR flash implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "NorFlash.hpp"
+#include "Sfdp.hpp"
+#include "CriticalSection.hpp"
+#include <cstring>
+
+using namespace Flash;
+
+namespace {
+
+constexpr uint8_t READ_ID{0x9FU};           //!< RDID
+constexpr uint8_t WRITE_ENABLE{0x06U};      //!< WREN
+constexpr uint8_t READ_STATUS1{0x05U};      //!< RDSR
+constexpr uint8_t READ_STATUS2{0x35U};      //!< RDSR2
+constexpr uint8_t WRITE_STATUS{0x01U};      //!< WRSR, status register 1 and 2
+constexpr uint8_t WRITE_STATUS2{0x31U};     //!< WRSR2
+constexpr uint8_t READ_STATUS2_B7{0x3FU};   //!< Status register 2 of QER 3
+constexpr uint8_t WRITE_STATUS2_B7{0x3EU};  //!< Status register 2 of QER 3
+constexpr uint8_t ENTER_4BYTE{0xB7U};       //!< EN4B
+constexpr uint8_t PAGE_PROGRAM{0x02U};      //!< PP
+
+constexpr uint8_t STATUS_BUSY{0x01U};       //!< Write in progress
+
+/// @brief Status reads of a register write during Init.
+constexpr uint32_t MAX_READY_POLLS{1000000U};
+
+/// @brief Bytes copied from the mapped region in one critical section.
+constexpr uint32_t READ_CHUNK{256U};
+
+/// @brief A command without address and data.
+NorCommand Instruction(uint8_t instruction)
+{
+    NorCommand command{};
+    command.instruction = instruction;
+    return command;
+}
+
+/// @brief A command without address with a single line data phase.
+NorCommand DataCommand(uint8_t instruction, uint32_t length)
+{
+    NorCommand command = Instruction(instruction);
+    command.dataLines = Lines::SINGLE;
+    command.length = length;
+    return command;
+}
+
+} // end anonymous namespace
+
+
+NorFlash::NorFlash(INorPort& port)
+: mPort(port)
+{
+    mPort.SetListener(this);
+}
+
+
+NorFlash::~NorFlash()
+{
+    mPort.SetListener(nullptr);
+}
+
+
+Status NorFlash::Init()
+{
+    if (!IsIdle())
+    {
+        return Status::BUSY;
+    }
+    mReady = false;
+    mPort.ExitMemoryMapped();
+
+    std::array<uint8_t, 3> id{};
+    if (mPort.Read(DataCommand(READ_ID, 3U), id.data()) != Status::OK)
+    {
+        return Status::HW_ERROR;
+    }
+    mJedecId = (static_cast<uint32_t>(id[0]) << 16U) | (static_cast<uint32_t>(id[1]) << 8U) | id[2];
+
+    NorCommand sfdp = DataCommand(Sfdp::READ_SFDP, Sfdp::HEADER_SIZE);
+    sfdp.addressLines = Lines::SINGLE;
+    sfdp.dummyCycles = Sfdp::READ_SFDP_DUMMY;
+    std::array<uint8_t, Sfdp::HEADER_SIZE> header{};
+    if (mPort.Read(sfdp, header.data()) != Status::OK)
+    {
+        return Status::HW_ERROR;
+    }
+    size_t dwords = 0U;
+    if (Sfdp::ParseHeader(header.data(), sfdp.address, dwords) != Status::OK)
+    {
+        return Status::NOT_SUPPORTED;
+    }
+    std::array<uint8_t, Sfdp::BASIC_TABLE_DWORDS * 4U> table{};
+    sfdp.length = static_cast<uint32_t>(dwords * 4U);
+    if (mPort.Read(sfdp, table.data()) != Status::OK)
+    {
+        return Status::HW_ERROR;
+    }
+    const Status status = Sfdp::ParseBasicTable(table.data(), dwords, mGeometry);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    Status result = Enter4Byte();
+    if (result == Status::OK)
+    {
+        result = EnableQuad();
+    }
+    if (result != Status::OK)
+    {
+        return result;
+    }
+    if (mPort.EnterMemoryMapped(mGeometry.read) != Status::OK)
+    {
+        return Status::HW_ERROR;
+    }
+    mReady = true;
+    return Status::OK;
+}
+
+
+const uint8_t* NorFlash::Map(uint32_t address) const
+{
+    const uint8_t* pMapped = mPort.GetMapped();
+    if ((pMapped == nullptr) || (address >= mGeometry.size))
+    {
+        return nullptr;
+    }
+    return &pMapped[address];
+}
+
+
+Status NorFlash::Read(uint32_t address, uint8_t* pData, uint32_t length) const
+{
+    if ((pData == nullptr) || (address >= mGeometry.size) || (length > (mGeometry.size - address)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    // a job may suspend the mapped mode in between, so it's checked for every chunk
+    uint32_t done = 0U;
+    while (done < length)
+    {
+        const uint32_t chunk = ((length - done) < READ_CHUNK) ? (length - done) : READ_CHUNK;
+        Utils::CriticalSection lock;
+        if (mpActive != nullptr)
+        {
+            return Status::BUSY;
+        }
+        const uint8_t* pMapped = Map(address + done);
+        if (pMapped == nullptr)
+        {
+            return mReady ? Status::HW_ERROR : Status::BUSY;
+        }
+        (void)std::memcpy(&pData[done], pMapped, chunk);
+        done += chunk;
+    }
+    return Status::OK;
+}
+
+
+Status NorFlash::Submit(NorJob& job)
+{
+    if (!mReady)
+    {
+        return Status::BUSY;
+    }
+    const uint32_t granule = mGeometry.erase[0].size;
+    if ((job.status == Status::PENDING) || (job.length == 0U) || (job.address >= mGeometry.size) ||
+        (job.length > (mGeometry.size - job.address)) ||
+        ((job.operation == NorOperation::PROGRAM) && (job.pData == nullptr)) ||
+        ((job.operation == NorOperation::ERASE) && (((job.address % granule) != 0U) || ((job.length % granule) != 0U))))
+    {
+        return Status::INVALID_PARAM;
+    }
+    job.pNext = nullptr;
+    job.status = Status::PENDING;
+
+    NorJob* pFailed = nullptr;
+    {
+        Utils::CriticalSection lock;
+        if (mpTail == nullptr)
+        {
+            mpHead = &job;
+        }
+        else
+        {
+            mpTail->pNext = &job;
+        }
+        mpTail = &job;
+        if (mpActive == nullptr)
+        {
+            pFailed = StartNext();
+        }
+    }
+    Finish(pFailed, Status::HW_ERROR);
+    return Status::OK;
+}
+
+
+bool NorFlash::IsIdle() const
+{
+    Utils::CriticalSection lock;
+    return (mpActive == nullptr) && (mpHead == nullptr);
+}
+
+
+void NorFlash::OnDone(Status status)
+{
+    NorJob* pDone = nullptr;
+    NorJob* pFailed = nullptr;
+    Status result = status;
+    {
+        Utils::CriticalSection lock;
+        if (mpActive == nullptr)
+        {
+            return;
+        }
+        if (status != Status::OK)
+        {
+            pDone = mpActive;
+        }
+        else if (mStep == Step::PROGRAM)
+        {
+            // the page is in the device buffer, the program runs until WIP is cleared
+            mStep = Step::WAIT_READY;
+            if (PollReady() != Status::OK)
+            {
+                pDone = mpActive;
+                result = Status::HW_ERROR;
+            }
+        }
+        else
+        {
+            mOffset += mChunk;
+            if (mOffset >= mpActive->length)
+            {
+                pDone = mpActive;
+            }
+            else if (StartStep() != Status::OK)
+            {
+                pDone = mpActive;
+                result = Status::HW_ERROR;
+            }
+        }
+        if (pDone != nullptr)
+        {
+            mpActive = nullptr;
+            mStep = Step::IDLE;
+            pFailed = StartNext();
+        }
+    }
+    Finish(pDone, result);
+    Finish(pFailed, Status::HW_ERROR);
+}
+
+
+NorJob* NorFlash::StartNext()
+{
+    NorJob* pFailed = nullptr;
+    while ((mpActive == nullptr) && (mpHead != nullptr))
+    {
+        if (mPort.GetMapped() != nullptr)
+        {
+            mPort.ExitMemoryMapped();
+            mSuspends = mSuspends + 1U;
+        }
+        mpActive = Pop();
+        mOffset = 0U;
+        if (StartStep() != Status::OK)
+        {
+            mpActive->pNext = pFailed;
+            pFailed = mpActive;
+            mpActive = nullptr;
+            mStep = Step::IDLE;
+        }
+    }
+    if ((mpActive == nullptr) && (mPort.GetMapped() == nullptr))
+    {
+        // a failed resume is reported by Read as HW_ERROR, the next job tries again
+        (void)mPort.EnterMemoryMapped(mGeometry.read);
+    }
+    return pFailed;
+}
+
+
+Status NorFlash::StartStep()
+{
+    const uint32_t address = mpActive->address + mOffset;
+    const uint32_t remaining = mpActive->length - mOffset;
+    if (WriteEnable() != Status::OK)
+    {
+        return Status::HW_ERROR;
+    }
+    if (mpActive->operation == NorOperation::PROGRAM)
+    {
+        // a page program wraps at the page end, so it's split at the boundary
+        const uint32_t pageLeft = mGeometry.pageSize - (address % mGeometry.pageSize);
+        mChunk = (remaining < pageLeft) ? remaining : pageLeft;
+        NorCommand command = AddressCommand(PAGE_PROGRAM, address);
+        command.dataLines = Lines::SINGLE;
+        command.length = mChunk;
+        mStep = Step::PROGRAM;
+        const Status status = mPort.WriteDma(command, &mpActive->pData[mOffset]);
+        if (status == Status::OK)
+        {
+            mPages = mPages + 1U;
+        }
+        return status;
+    }
+
+    // the largest erase type which is aligned and fits, the smallest one always does
+    EraseType type = mGeometry.erase[0];
+    for (const EraseType& candidate : mGeometry.erase)
+    {
+        if ((candidate.size != 0U) && (candidate.size <= remaining) && ((address % candidate.size) == 0U))
+        {
+            type = candidate;
+        }
+    }
+    mChunk = type.size;
+    if (mPort.Write(AddressCommand(type.opcode, address), nullptr) != Status::OK)
+    {
+        return Status::HW_ERROR;
+    }
+    mErases = mErases + 1U;
+    mStep = Step::WAIT_READY;
+    return PollReady();
+}
+
+
+Status NorFlash::WriteEnable()
+{
+    return mPort.Write(Instruction(WRITE_ENABLE), nullptr);
+}
+
+
+Status NorFlash::PollReady()
+{
+    return mPort.PollStatus(DataCommand(READ_STATUS1, 1U), STATUS_BUSY, 0U);
+}
+
+
+Status NorFlash::ReadRegister(uint8_t instruction, uint8_t& value)
+{
+    return mPort.Read(DataCommand(instruction, 1U), &value);
+}
+
+
+Status NorFlash::WriteRegister(uint8_t instruction, const uint8_t* pValue, uint32_t length)
+{
+    if ((WriteEnable() != Status::OK) || (mPort.Write(DataCommand(instruction, length), pValue) != Status::OK))
+    {
+        return Status::HW_ERROR;
+    }
+    return WaitReady();
+}
+
+
+Status NorFlash::WaitReady()
+{
+    for (uint32_t i = 0U; i < MAX_READY_POLLS; i++)
+    {
+        uint8_t status = STATUS_BUSY;
+        if (ReadRegister(READ_STATUS1, status) != Status::OK)
+        {
+            return Status::HW_ERROR;
+        }
+        if ((status & STATUS_BUSY) == 0U)
+        {
+            return Status::OK;
+        }
+    }
+    return Status::HW_ERROR;
+}
+
+
+Status NorFlash::Enter4Byte()
+{
+    // 4 byte only devices need no switch
+    if ((mGeometry.addressBytes == 3U) || (mGeometry.addressModes == 2U))
+    {
+        return Status::OK;
+    }
+    // DWORD16 bit 0: EN4B, bit 1: WREN and EN4B, a table without DWORD16 gets EN4B
+    if ((mGeometry.enter4Byte == 0U) || ((mGeometry.enter4Byte & 0x01U) != 0U))
+    {
+        return mPort.Write(Instruction(ENTER_4BYTE), nullptr);
+    }
+    if ((mGeometry.enter4Byte & 0x02U) != 0U)
+    {
+        return (WriteEnable() == Status::OK) ? mPort.Write(Instruction(ENTER_4BYTE), nullptr) : Status::HW_ERROR;
+    }
+    return Status::NOT_SUPPORTED;
+}
+
+
+Status NorFlash::EnableQuad()
+{
+    if ((mGeometry.read.addressLines != Lines::QUAD) && (mGeometry.read.dataLines != Lines::QUAD))
+    {
+        return Status::OK;
+    }
+    std::array<uint8_t, 2> value{};
+    switch (mGeometry.quadEnable)
+    {
+        case 0U:
+            // no quad enable bit, or IO2 / IO3 are quad lines without it
+            return Status::OK;
+
+        case 2U:
+            // bit 6 of status register 1
+            if (ReadRegister(READ_STATUS1, value[0]) != Status::OK)
+            {
+                return Status::HW_ERROR;
+            }
+            if ((value[0] & 0x40U) != 0U)
+            {
+                return Status::OK;
+            }
+            value[0] = static_cast<uint8_t>(value[0] | 0x40U);
+            return WriteRegister(WRITE_STATUS, value.data(), 1U);
+
+        case 1U:
+        case 4U:
+        case 5U:
+            // bit 1 of status register 2, written together with status register 1
+            if ((ReadRegister(READ_STATUS1, value[0]) != Status::OK) ||
+                (ReadRegister(READ_STATUS2, value[1]) != Status::OK))
+            {
+                return Status::HW_ERROR;
+            }
+            if ((value[1] & 0x02U) != 0U)
+            {
+                return Status::OK;
+            }
+            value[1] = static_cast<uint8_t>(value[1] | 0x02U);
+            return WriteRegister(WRITE_STATUS, value.data(), 2U);
+
+        case 6U:
+            // bit 1 of status register 2, written alone
+            if (ReadRegister(READ_STATUS2, value[0]) != Status::OK)
+            {
+                return Status::HW_ERROR;
+            }
+            if ((value[0] & 0x02U) != 0U)
+            {
+                return Status::OK;
+            }
+            value[0] = static_cast<uint8_t>(value[0] | 0x02U);
+            return WriteRegister(WRITE_STATUS2, value.data(), 1U);
+
+        case 3U:
+            // bit 7 of status register 2 with its own instructions
+            if (ReadRegister(READ_STATUS2_B7, value[0]) != Status::OK)
+            {
+                return Status::HW_ERROR;
+            }
+            if ((value[0] & 0x80U) != 0U)
+            {
+                return Status::OK;
+            }
+            value[0] = static_cast<uint8_t>(value[0] | 0x80U);
+            return WriteRegister(WRITE_STATUS2_B7, value.data(), 1U);
+
+        default:
+            return Status::NOT_SUPPORTED;
+    }
+}
+
+
+NorCommand NorFlash::AddressCommand(uint8_t instruction, uint32_t address) const
+{
+    NorCommand command = Instruction(instruction);
+    command.addressLines = Lines::SINGLE;
+    command.addressBytes = mGeometry.addressBytes;
+    command.address = address;
+    return command;
+}
+
+
+NorJob* NorFlash::Pop()
+{
+    NorJob* pJob = mpHead;
+    mpHead = pJob->pNext;
+    if (mpHead == nullptr)
+    {
+        mpTail = nullptr;
+    }
+    pJob->pNext = nullptr;
+    return pJob;
+}
+
+
+void NorFlash::Finish(NorJob* pList, Status status)
+{
+    while (pList != nullptr)
+    {
+        NorJob* pJob = pList;
+        pList = pList->pNext;
+        pJob->pNext = nullptr;
+        // the callback may submit the same descriptor again
+        const NorJob::Callback pCallback = pJob->pCallback;
+        void* const pContext = pJob->pContext;
+        if (status == Status::OK)
+        {
+            mCompleted = mCompleted + 1U;
+        }
+        pJob->status = status;
+        if (pCallback != nullptr)
+        {
+            pCallback(*pJob, pContext);
+        }
+    }
+}
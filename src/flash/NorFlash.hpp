@@ -0,0 +1,185 @@
+/**
+ ********************************************************************************
+ * @file        NorFlash.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, external NOR flash with memory-mapped reads and a DMA program / erase queue.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "INorPort.hpp"
+namespace Flash {
+
+
+/**
+ * @brief   This class runs an external NOR flash: read in place, program and erase in the background.
+ * @details @ref Init reads the SFDP table, switches to 4 byte addresses and sets the quad enable bit if the
+ *          device needs it, and enters the memory-mapped mode with the fastest read mode. Reads are served
+ *          by the controller then: @ref Map returns the address of a location, @ref Read copies from there.\n
+ *          Program and erase jobs are queued. The first job suspends the memory-mapped mode, the jobs run in
+ *          the completion path without the CPU: write enable, page program by DMA or erase command, then the
+ *          controller polls the status register until the write in progress bit is cleared. When the queue
+ *          is empty the memory-mapped mode is resumed.
+ * @note    While a job runs, nothing may access the mapped region: no data of EXTFLASH_RODATA, no code of
+ *          EXTFLASH_TEXT. Map returns nullptr and Read returns BUSY meanwhile.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe except Init.\n
+ * Submit may be called from threads and ISR's, the completion path runs in the QUADSPI interrupt.
+ *
+ */
+class NorFlash : private INorPort::IListener
+{
+    public:
+
+        /**
+         * @brief   Constructs the flash and binds it to the port.
+         *
+         * @param   port    The quad SPI controller.
+         */
+        explicit NorFlash(INorPort& port);
+
+        /// @brief Destructor, unbinds the port.
+        ~NorFlash();
+
+        NorFlash(NorFlash const &) = delete;             //!< Copy constructor
+        NorFlash& operator=(NorFlash const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Configure the device from its SFDP table and enter the memory-mapped mode.
+         *
+         * @return  OK, NOT_SUPPORTED without usable SFDP table, BUSY while jobs run, HW_ERROR.
+         */
+        Status Init();
+
+        /// @brief The geometry of the device, valid after Init.
+        const NorGeometry& GetGeometry() const {return mGeometry;};
+
+        /// @brief Manufacturer and device ID (RDID 0x9F), valid after Init.
+        uint32_t GetJedecId() const {return mJedecId;};
+
+        /**
+         * @brief   Address of a location in the mapped region.
+         *
+         * @param   address     Offset in the device.
+         *
+         * @return  The address, nullptr while a job runs or out of range.
+         */
+        const uint8_t* Map(uint32_t address) const;
+
+        /**
+         * @brief   Copy from the device.
+         *
+         * @param   address     Offset in the device.
+         * @param   pData       Destination.
+         * @param   length      Bytes.
+         *
+         * @return  OK, BUSY while a job runs, INVALID_PARAM out of range, HW_ERROR.
+         */
+        Status Read(uint32_t address, uint8_t* pData, uint32_t length) const;
+
+        /**
+         * @brief   Queue a program or erase job.
+         *
+         * @param   job     The job, status PENDING until completion.
+         *
+         * @return  OK, INVALID_PARAM for a job out of range, an unaligned erase or a pending descriptor,
+         *          BUSY before Init.
+         */
+        Status Submit(NorJob& job);
+
+        /// @brief No job runs and none is queued.
+        bool IsIdle() const;
+
+        /// @brief Suspensions of the memory-mapped mode.
+        uint32_t GetSuspends() const {return mSuspends;};
+
+        /// @brief Programmed pages.
+        uint32_t GetPages() const {return mPages;};
+
+        /// @brief Erase commands.
+        uint32_t GetErases() const {return mErases;};
+
+        /// @brief Completed jobs.
+        uint32_t GetCompleted() const {return mCompleted;};
+
+    private:
+
+        /// @brief Step of the running job.
+        enum class Step : uint8_t
+        {
+            IDLE=0,           //!< No job runs
+            PROGRAM=1,        //!< Page data is moved by DMA
+            WAIT_READY=2      //!< The status register is polled
+        };
+
+        /// @brief Port event, see INorPort::IListener.
+        void OnDone(Status status) override;
+
+        /// @brief Start the next step of the running job or the next job, returns the failed ones (critical section).
+        NorJob* StartNext();
+
+        /// @brief Start a page program or an erase at the job offset (critical section).
+        Status StartStep();
+
+        /// @brief Set the write enable latch.
+        Status WriteEnable();
+
+        /// @brief Start polling the write in progress bit (critical section).
+        Status PollReady();
+
+        /// @brief Read a one byte register (Init only).
+        Status ReadRegister(uint8_t instruction, uint8_t& value);
+
+        /// @brief Write a register with write enable and wait for the end (Init only).
+        Status WriteRegister(uint8_t instruction, const uint8_t* pValue, uint32_t length);
+
+        /// @brief Wait for the end of a write by reading the status register (Init only).
+        Status WaitReady();
+
+        /// @brief Enter the 4 byte address mode if the device needs it (Init only).
+        Status Enter4Byte();
+
+        /// @brief Set the quad enable bit if the read mode needs it (Init only).
+        Status EnableQuad();
+
+        /// @brief A command with address in the current address mode.
+        NorCommand AddressCommand(uint8_t instruction, uint32_t address) const;
+
+        /// @brief Remove the oldest job from the queue (critical section).
+        NorJob* Pop();
+
+        /// @brief Complete a list of jobs with a status, outside of the critical section.
+        void Finish(NorJob* pList, Status status);
+
+        /// @brief The quad SPI controller.
+        INorPort& mPort;
+
+        /// @brief Geometry of the device.
+        NorGeometry mGeometry{};
+
+        /// @brief Manufacturer and device ID.
+        uint32_t mJedecId{0U};
+
+        NorJob* mpHead{nullptr};            //!< Oldest queued job
+        NorJob* mpTail{nullptr};            //!< Newest queued job
+        NorJob* mpActive{nullptr};          //!< Running job
+        uint32_t mOffset{0U};               //!< Done bytes of the running job
+        uint32_t mChunk{0U};                //!< Bytes of the running step
+        Step mStep{Step::IDLE};             //!< Step of the running job
+        bool mReady{false};                 //!< Init has succeeded
+
+        volatile uint32_t mSuspends{0U};    //!< Suspensions of the memory-mapped mode
+        volatile uint32_t mPages{0U};       //!< Page programs
+        volatile uint32_t mErases{0U};      //!< Erase commands
+        volatile uint32_t mCompleted{0U};   //!< Completed jobs
+};
+
+} // end namespace Flash
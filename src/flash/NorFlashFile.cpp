@@ -0,0 +1,515 @@
+/**
+ ********************************************************************************
+ * @file        NorFlashFile.cpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, host NOR flash model implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "NorFlashFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+using namespace Flash;
+
+namespace {
+
+/// @brief Program page of the model.
+constexpr uint32_t PAGE_SIZE{256U};
+
+/// @brief Start of the basic table in the SFDP area.
+constexpr uint32_t TABLE_ADDRESS{0x30U};
+
+/// @brief DWORDs of the basic table (JESD216B).
+constexpr uint32_t TABLE_DWORDS{16U};
+
+constexpr uint8_t STATUS_BUSY{0x01U};       //!< WIP
+constexpr uint8_t STATUS_WEL{0x02U};        //!< Write enable latch
+
+/// @brief Store a little endian word.
+void Store32(uint8_t* pData, uint32_t value)
+{
+    pData[0] = static_cast<uint8_t>(value);
+    pData[1] = static_cast<uint8_t>(value >> 8U);
+    pData[2] = static_cast<uint8_t>(value >> 16U);
+    pData[3] = static_cast<uint8_t>(value >> 24U);
+}
+
+/// @brief Exponent of a power of two.
+uint32_t Log2(uint32_t value)
+{
+    uint32_t exponent = 0U;
+    while ((value >> (exponent + 1U)) != 0U)
+    {
+        exponent++;
+    }
+    return exponent;
+}
+
+} // end anonymous namespace
+
+
+NorFlashFile::NorFlashFile(const Config& config)
+: mConfig(config)
+{
+    BuildSfdp();
+}
+
+
+NorFlashFile::~NorFlashFile()
+{
+    Close();
+}
+
+
+Status NorFlashFile::Open(const char* pPath)
+{
+    Close();
+    mFile = open(pPath, O_RDWR | O_CREAT, 0644);
+    struct stat info{};
+    if ((mFile < 0) || (fstat(mFile, &info) != 0))
+    {
+        Close();
+        return Status::HW_ERROR;
+    }
+    const size_t existing = static_cast<size_t>(info.st_size);
+    if ((existing < mConfig.size) && (ftruncate(mFile, static_cast<off_t>(mConfig.size)) != 0))
+    {
+        Close();
+        return Status::HW_ERROR;
+    }
+    void* pMap = mmap(nullptr, mConfig.size, PROT_READ | PROT_WRITE, MAP_SHARED, mFile, 0);
+    if (pMap == MAP_FAILED)
+    {
+        Close();
+        return Status::HW_ERROR;
+    }
+    mpArray = static_cast<uint8_t*>(pMap);
+    if (existing < mConfig.size)
+    {
+        (void)std::memset(&mpArray[existing], 0xFF, mConfig.size - existing);
+    }
+    return Status::OK;
+}
+
+
+void NorFlashFile::Close()
+{
+    if (mpArray != nullptr)
+    {
+        (void)msync(mpArray, mConfig.size, MS_SYNC);
+        (void)munmap(mpArray, mConfig.size);
+        mpArray = nullptr;
+    }
+    if (mFile >= 0)
+    {
+        (void)close(mFile);
+        mFile = -1;
+    }
+    // power cycle: the volatile state is lost
+    mPending = Pending::NONE;
+    mStatus1 = 0U;
+    mStatus2 = 0U;
+    mBusy = 0U;
+    mFourByte = false;
+    mMapped = false;
+}
+
+
+size_t NorFlashFile::RunToIdle()
+{
+    size_t events = 0U;
+    while (mPending != Pending::NONE)
+    {
+        const Pending pending = mPending;
+        mPending = Pending::NONE;
+        if (pending == Pending::DMA)
+        {
+            Execute(mCommand, nullptr, mpData);
+        }
+        else
+        {
+            uint8_t status = 0U;
+            do
+            {
+                Execute(mCommand, &status, nullptr);
+                mPolls++;
+            } while ((status & mMask) != mMatch);
+        }
+        events++;
+        if (mpListener != nullptr)
+        {
+            mpListener->OnDone(Status::OK);
+        }
+    }
+    return events;
+}
+
+
+Status NorFlashFile::Read(const NorCommand& command, uint8_t* pData)
+{
+    if ((mpArray == nullptr) || (pData == nullptr) || (command.dataLines == Lines::NONE))
+    {
+        return (mpArray == nullptr) ? Status::HW_ERROR : Status::INVALID_PARAM;
+    }
+    if (mMapped || (mPending != Pending::NONE))
+    {
+        return Status::BUSY;
+    }
+    Execute(command, pData, nullptr);
+    return Status::OK;
+}
+
+
+Status NorFlashFile::Write(const NorCommand& command, const uint8_t* pData)
+{
+    if (mpArray == nullptr)
+    {
+        return Status::HW_ERROR;
+    }
+    if ((command.length != 0U) && (pData == nullptr))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mMapped || (mPending != Pending::NONE))
+    {
+        return Status::BUSY;
+    }
+    Execute(command, nullptr, pData);
+    return Status::OK;
+}
+
+
+Status NorFlashFile::WriteDma(const NorCommand& command, const uint8_t* pData)
+{
+    if (mpArray == nullptr)
+    {
+        return Status::HW_ERROR;
+    }
+    if ((pData == nullptr) || (command.length == 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mMapped || (mPending != Pending::NONE))
+    {
+        return Status::BUSY;
+    }
+    mPending = Pending::DMA;
+    mCommand = command;
+    mpData = pData;
+    return Status::OK;
+}
+
+
+Status NorFlashFile::PollStatus(const NorCommand& command, uint8_t mask, uint8_t match)
+{
+    if (mpArray == nullptr)
+    {
+        return Status::HW_ERROR;
+    }
+    if (mMapped || (mPending != Pending::NONE))
+    {
+        return Status::BUSY;
+    }
+    mPending = Pending::POLL;
+    mCommand = command;
+    mCommand.length = 1U;
+    mMask = mask;
+    mMatch = match;
+    return Status::OK;
+}
+
+
+Status NorFlashFile::EnterMemoryMapped(const NorCommand& command)
+{
+    if (mpArray == nullptr)
+    {
+        return Status::HW_ERROR;
+    }
+    if (mPending != Pending::NONE)
+    {
+        return Status::BUSY;
+    }
+    if (!IsValidRead(command) || !IsValidAddress(command) || (mBusy != 0U))
+    {
+        mProtocolErrors++;
+        return Status::HW_ERROR;
+    }
+    mMapped = true;
+    return Status::OK;
+}
+
+
+bool NorFlashFile::IsQuadEnabled() const
+{
+    switch (mConfig.quadEnable)
+    {
+        case 0U:
+            return true;
+        case 2U:
+            return (mStatus1 & 0x40U) != 0U;
+        default:
+            return (mStatus2 & 0x02U) != 0U;
+    }
+}
+
+
+void NorFlashFile::BuildSfdp()
+{
+    mSfdp.fill(0xFFU);
+    const bool large = mConfig.size > (16U * 1024U * 1024U);
+
+    // SFDP header rev 1.6 with one parameter header, the basic table rev 1.6 of 16 DWORDs
+    const std::array<uint8_t, 16> header{'S', 'F', 'D', 'P', 6U, 1U, 0U, 0xFFU,
+                                         0x00U, 6U, 1U, TABLE_DWORDS, TABLE_ADDRESS, 0U, 0U, 0xFFU};
+    if (!mConfig.sfdp)
+    {
+        return;
+    }
+    (void)std::memcpy(mSfdp.data(), header.data(), header.size());
+
+    std::array<uint32_t, TABLE_DWORDS> table{};
+    // 4 KB erase 0x20, 1-4-4 and 1-1-4 reads, 3 or 4 byte addresses above 16 MB
+    table[0] = 0x01U | 0x04U | (0x20U << 8U) | (1UL << 21U) | (1UL << 22U) | ((large ? 1UL : 0UL) << 17U);
+    table[1] = (mConfig.size * 8U) - 1U;
+    // 1-1-4: 0x6B, 8 dummy; 1-4-4: 0xEB, 2 mode, 4 dummy
+    table[2] = (0x6BUL << 24U) | (8UL << 16U) | (0xEBUL << 8U) | (2UL << 5U) | 4UL;
+    // erase types in the order of a real table: 4 KB, 32 KB, 64 KB
+    table[7] = 12UL | (0x20UL << 8U) | (15UL << 16U) | (0x52UL << 24U);
+    table[8] = 16UL | (0xD8UL << 8U);
+    table[10] = Log2(PAGE_SIZE) << 4U;
+    table[14] = static_cast<uint32_t>(mConfig.quadEnable & 0x7U) << 20U;
+    table[15] = 0x01UL << 24U;
+    for (size_t i = 0U; i < table.size(); i++)
+    {
+        Store32(&mSfdp[TABLE_ADDRESS + (i * 4U)], table[i]);
+    }
+}
+
+
+void NorFlashFile::Execute(const NorCommand& command, uint8_t* pRead, const uint8_t* pWrite)
+{
+    if ((mBusy != 0U) && (command.instruction != 0x05U))
+    {
+        // a busy device only answers the status read
+        mProtocolErrors++;
+        return;
+    }
+    switch (command.instruction)
+    {
+        case 0x9FU:
+        {
+            const std::array<uint8_t, 3> id{0xC2U, 0x20U, static_cast<uint8_t>(Log2(mConfig.size))};
+            for (uint32_t i = 0U; (pRead != nullptr) && (i < command.length); i++)
+            {
+                pRead[i] = (i < id.size()) ? id[i] : 0xFFU;
+            }
+            break;
+        }
+
+        case 0x5AU:
+            if ((command.addressLines != Lines::SINGLE) || (command.addressBytes != 3U) || (command.dummyCycles != 8U))
+            {
+                mProtocolErrors++;
+            }
+            for (uint32_t i = 0U; (pRead != nullptr) && (i < command.length); i++)
+            {
+                const uint32_t address = command.address + i;
+                pRead[i] = (address < mSfdp.size()) ? mSfdp[address] : 0xFFU;
+            }
+            break;
+
+        case 0x05U:
+        {
+            const uint8_t status = static_cast<uint8_t>(mStatus1 | ((mBusy != 0U) ? STATUS_BUSY : 0U));
+            mBusy = (mBusy != 0U) ? (mBusy - 1U) : 0U;
+            if ((pRead != nullptr) && (command.length != 0U))
+            {
+                (void)std::memset(pRead, status, command.length);
+            }
+            break;
+        }
+
+        case 0x35U:
+        case 0x3FU:
+            if ((pRead != nullptr) && (command.length != 0U))
+            {
+                (void)std::memset(pRead, mStatus2, command.length);
+            }
+            break;
+
+        case 0x06U:
+            mStatus1 = static_cast<uint8_t>(mStatus1 | STATUS_WEL);
+            break;
+
+        case 0x04U:
+            mStatus1 = static_cast<uint8_t>(mStatus1 & ~STATUS_WEL);
+            break;
+
+        case 0x01U:
+        case 0x31U:
+        case 0x3EU:
+            if (TakeWriteEnable() && (pWrite != nullptr) && (command.length != 0U))
+            {
+                if (command.instruction == 0x01U)
+                {
+                    mStatus1 = static_cast<uint8_t>((mStatus1 & STATUS_WEL) | (pWrite[0] & 0x40U));
+                    mStatus2 = (command.length > 1U) ? pWrite[1] : mStatus2;
+                }
+                else
+                {
+                    mStatus2 = pWrite[0];
+                }
+                mBusy = 1U;
+            }
+            break;
+
+        case 0xB7U:
+            mFourByte = true;
+            break;
+
+        case 0xE9U:
+            mFourByte = false;
+            break;
+
+        case 0x03U:
+        case 0x0BU:
+        case 0x6BU:
+        case 0xEBU:
+            ReadArray(command, pRead);
+            break;
+
+        case 0x02U:
+            Program(command, pWrite);
+            break;
+
+        case 0x20U:
+            Erase(command, 4U * 1024U);
+            break;
+
+        case 0x52U:
+            Erase(command, 32U * 1024U);
+            break;
+
+        case 0xD8U:
+            Erase(command, 64U * 1024U);
+            break;
+
+        case 0x60U:
+        case 0xC7U:
+            if (TakeWriteEnable())
+            {
+                (void)std::memset(mpArray, 0xFF, mConfig.size);
+                mErases++;
+                mBusy = mConfig.erasePolls;
+            }
+            break;
+
+        default:
+            mProtocolErrors++;
+            break;
+    }
+}
+
+
+void NorFlashFile::ReadArray(const NorCommand& command, uint8_t* pRead)
+{
+    if (!IsValidRead(command) || !IsValidAddress(command))
+    {
+        mProtocolErrors++;
+    }
+    for (uint32_t i = 0U; (pRead != nullptr) && (i < command.length); i++)
+    {
+        pRead[i] = mpArray[(command.address + i) % mConfig.size];
+    }
+}
+
+
+void NorFlashFile::Program(const NorCommand& command, const uint8_t* pWrite)
+{
+    if (!IsValidAddress(command) || (command.addressLines != Lines::SINGLE) || (command.dataLines != Lines::SINGLE) ||
+        (pWrite == nullptr))
+    {
+        mProtocolErrors++;
+        return;
+    }
+    if (!TakeWriteEnable())
+    {
+        return;
+    }
+    const uint32_t address = command.address % mConfig.size;
+    const uint32_t page = address - (address % PAGE_SIZE);
+    for (uint32_t i = 0U; i < command.length; i++)
+    {
+        uint8_t& cell = mpArray[page + (((address - page) + i) % PAGE_SIZE)];
+        cell = static_cast<uint8_t>(cell & pWrite[i]);
+    }
+    mPrograms++;
+    mBusy = mConfig.programPolls;
+}
+
+
+void NorFlashFile::Erase(const NorCommand& command, uint32_t size)
+{
+    if (!IsValidAddress(command) || (command.addressLines != Lines::SINGLE))
+    {
+        mProtocolErrors++;
+        return;
+    }
+    if (!TakeWriteEnable())
+    {
+        return;
+    }
+    const uint32_t address = command.address % mConfig.size;
+    (void)std::memset(&mpArray[address - (address % size)], 0xFF, size);
+    mErases++;
+    mBusy = mConfig.erasePolls;
+}
+
+
+bool NorFlashFile::IsValidRead(const NorCommand& command) const
+{
+    switch (command.instruction)
+    {
+        case 0x03U:
+            return (command.addressLines == Lines::SINGLE) && (command.dataLines == Lines::SINGLE) &&
+                   (command.modeCycles == 0U) && (command.dummyCycles == 0U);
+        case 0x0BU:
+            return (command.addressLines == Lines::SINGLE) && (command.dataLines == Lines::SINGLE) &&
+                   ((command.modeCycles + command.dummyCycles) == 8U);
+        case 0x6BU:
+            return (command.addressLines == Lines::SINGLE) && (command.dataLines == Lines::QUAD) &&
+                   ((command.modeCycles + command.dummyCycles) == 8U) && IsQuadEnabled();
+        case 0xEBU:
+            return (command.addressLines == Lines::QUAD) && (command.dataLines == Lines::QUAD) &&
+                   (command.modeCycles == 2U) && (command.dummyCycles == 4U) && IsQuadEnabled();
+        default:
+            return false;
+    }
+}
+
+
+bool NorFlashFile::IsValidAddress(const NorCommand& command) const
+{
+    return command.addressBytes == (mFourByte ? 4U : 3U);
+}
+
+
+bool NorFlashFile::TakeWriteEnable()
+{
+    if ((mStatus1 & STATUS_WEL) == 0U)
+    {
+        mProtocolErrors++;
+        return false;
+    }
+    mStatus1 = static_cast<uint8_t>(mStatus1 & ~STATUS_WEL);
+    return true;
+}
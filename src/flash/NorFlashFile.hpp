@@ -0,0 +1,202 @@
+/**
+ ********************************************************************************
+ * @file        NorFlashFile.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, host model of a quad SPI controller with a NOR flash stored in a file.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "INorPort.hpp"
+namespace Flash {
+
+
+/**
+ * @brief   This class provides an INorPort with a NOR flash whose array is a file on the host.
+ * @details The file is mapped into memory, it keeps the content between runs and serves as the memory-mapped
+ *          region. The device decodes the commands like a serial NOR flash: a program clears bits within one
+ *          page (the address wraps at the page end), an erase sets a block to 0xFF, both need the write enable
+ *          latch and keep the write in progress bit set for a configured count of status reads. The device
+ *          answers RDID and the SFDP read with a JESD216B table (4/32/64 KB erase, 256 byte page, 1-1-4 and
+ *          1-4-4 reads, EN4B above 16 MB).\n
+ *          Commands which the device would misinterpret (wrong address size or dummy cycles, quad lines
+ *          without quad enable, a write without write enable, a command while busy) are counted as protocol
+ *          errors.\n
+ *          DMA writes and status polls are deferred until @ref RunToIdle, which calls the listener
+ *          synchronously like the interrupt.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class NorFlashFile : public INorPort
+{
+    public:
+
+        /// @brief Device parameters.
+        struct Config
+        {
+            uint32_t size{1024U * 1024U};   //!< Bytes, a power of two from 64 KB
+            uint8_t quadEnable{2U};         //!< QER of the table: 0, 2 (SR1 bit 6) or 5 (SR2 bit 1)
+            uint32_t programPolls{2U};      //!< Busy status reads of a page program
+            uint32_t erasePolls{8U};        //!< Busy status reads of an erase
+            bool sfdp{true};                //!< The device has an SFDP table
+        };
+
+        /**
+         * @brief   Constructs the device.
+         *
+         * @param   config  The device parameters.
+         */
+        explicit NorFlashFile(const Config& config);
+
+        /// @brief Constructs the device with the default parameters.
+        NorFlashFile() : NorFlashFile(Config{}) {};
+
+        /// @brief Destructor, closes the file.
+        ~NorFlashFile() override;
+
+        NorFlashFile(NorFlashFile const &) = delete;             //!< Copy constructor
+        NorFlashFile& operator=(NorFlashFile const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Open the array file, a new or shorter file is extended with erased bytes.
+         *
+         * @param   pPath   The file.
+         *
+         * @return  OK or HW_ERROR if the file can't be opened or mapped.
+         */
+        Status Open(const char* pPath);
+
+        /// @brief Close the array file, the device is reset.
+        void Close();
+
+        /**
+         * @brief   Run the deferred DMA writes and status polls, the listener may start new ones.
+         *
+         * @return  Count of reported ends.
+         */
+        size_t RunToIdle();
+
+        /// @copydoc INorPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc INorPort::Read
+        Status Read(const NorCommand& command, uint8_t* pData) override;
+
+        /// @copydoc INorPort::Write
+        Status Write(const NorCommand& command, const uint8_t* pData) override;
+
+        /// @copydoc INorPort::WriteDma
+        Status WriteDma(const NorCommand& command, const uint8_t* pData) override;
+
+        /// @copydoc INorPort::PollStatus
+        Status PollStatus(const NorCommand& command, uint8_t mask, uint8_t match) override;
+
+        /// @copydoc INorPort::EnterMemoryMapped
+        Status EnterMemoryMapped(const NorCommand& command) override;
+
+        /// @copydoc INorPort::ExitMemoryMapped
+        void ExitMemoryMapped() override {mMapped = false;};
+
+        /// @copydoc INorPort::GetMapped
+        const uint8_t* GetMapped() const override {return mMapped ? mpArray : nullptr;};
+
+        /// @brief The quad enable bit is set.
+        bool IsQuadEnabled() const;
+
+        /// @brief The device is in the 4 byte address mode.
+        bool IsFourByte() const {return mFourByte;};
+
+        /// @brief Page program commands.
+        uint32_t GetPrograms() const {return mPrograms;};
+
+        /// @brief Erase commands.
+        uint32_t GetErases() const {return mErases;};
+
+        /// @brief Status reads of the polls.
+        uint32_t GetPolls() const {return mPolls;};
+
+        /// @brief Commands the device would misinterpret.
+        uint32_t GetProtocolErrors() const {return mProtocolErrors;};
+
+    private:
+
+        /// @brief Deferred operation.
+        enum class Pending : uint8_t
+        {
+            NONE=0,           //!< Nothing deferred
+            DMA=1,            //!< Write data phase by DMA
+            POLL=2            //!< Status poll
+        };
+
+        /// @brief Size of the SFDP area.
+        static constexpr size_t SFDP_SIZE{0x70U};
+
+        /// @brief Fill the SFDP area.
+        void BuildSfdp();
+
+        /// @brief Decode one command.
+        void Execute(const NorCommand& command, uint8_t* pRead, const uint8_t* pWrite);
+
+        /// @brief Read the array with a read instruction.
+        void ReadArray(const NorCommand& command, uint8_t* pRead);
+
+        /// @brief Program within one page.
+        void Program(const NorCommand& command, const uint8_t* pWrite);
+
+        /// @brief Erase the block of an address.
+        void Erase(const NorCommand& command, uint32_t size);
+
+        /// @brief Shape of a read command (lines, mode and dummy cycles) and the quad enable bit.
+        bool IsValidRead(const NorCommand& command) const;
+
+        /// @brief Address bytes match the address mode.
+        bool IsValidAddress(const NorCommand& command) const;
+
+        /// @brief Write enable latch is set, counts a protocol error otherwise.
+        bool TakeWriteEnable();
+
+        /// @brief Device parameters.
+        Config mConfig;
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        /// @brief Mapped array file.
+        uint8_t* mpArray{nullptr};
+
+        /// @brief File descriptor of the array file.
+        int mFile{-1};
+
+        /// @brief The SFDP area.
+        std::array<uint8_t, SFDP_SIZE> mSfdp{};
+
+        Pending mPending{Pending::NONE};    //!< Deferred operation
+        NorCommand mCommand{};              //!< Command of the deferred operation
+        const uint8_t* mpData{nullptr};     //!< Data of the deferred DMA write
+        uint8_t mMask{0U};                  //!< Mask of the deferred poll
+        uint8_t mMatch{0U};                 //!< Match of the deferred poll
+
+        uint8_t mStatus1{0U};               //!< Status register 1 without WIP
+        uint8_t mStatus2{0U};               //!< Status register 2
+        uint32_t mBusy{0U};                 //!< Status reads until the write has ended
+        bool mFourByte{false};              //!< 4 byte address mode
+        bool mMapped{false};                //!< Memory-mapped mode
+
+        uint32_t mPrograms{0U};             //!< Page programs
+        uint32_t mErases{0U};               //!< Erases
+        uint32_t mPolls{0U};                //!< Status reads of the polls
+        uint32_t mProtocolErrors{0U};       //!< Misinterpreted commands
+};
+
+} // end namespace Flash
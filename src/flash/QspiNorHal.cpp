@@ -0,0 +1,318 @@
+/**
+ ********************************************************************************
+ * @file        QspiNorHal.cpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, QUADSPI port implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "QspiNorHal.hpp"
+#include "DCache.hpp"
+
+using namespace Flash;
+
+QspiNorHal* QspiNorHal::spInstance{nullptr};
+
+namespace {
+
+/// @brief Chip select release after this count of idle clocks in the memory-mapped mode.
+constexpr uint32_t MAPPED_TIMEOUT{0x20U};
+
+/// @brief Clocks between two status reads of the automatic polling.
+constexpr uint32_t POLL_INTERVAL{0x10U};
+
+/// @brief Lines of an address phase.
+uint32_t AddressMode(Lines lines)
+{
+    switch (lines)
+    {
+        case Lines::SINGLE:
+            return QSPI_ADDRESS_1_LINE;
+        case Lines::DUAL:
+            return QSPI_ADDRESS_2_LINES;
+        case Lines::QUAD:
+            return QSPI_ADDRESS_4_LINES;
+        default:
+            return QSPI_ADDRESS_NONE;
+    }
+}
+
+/// @brief Lines of an alternate byte phase.
+uint32_t AlternateMode(Lines lines)
+{
+    switch (lines)
+    {
+        case Lines::SINGLE:
+            return QSPI_ALTERNATE_BYTES_1_LINE;
+        case Lines::DUAL:
+            return QSPI_ALTERNATE_BYTES_2_LINES;
+        case Lines::QUAD:
+            return QSPI_ALTERNATE_BYTES_4_LINES;
+        default:
+            return QSPI_ALTERNATE_BYTES_NONE;
+    }
+}
+
+/// @brief Lines of a data phase.
+uint32_t DataMode(Lines lines)
+{
+    switch (lines)
+    {
+        case Lines::SINGLE:
+            return QSPI_DATA_1_LINE;
+        case Lines::DUAL:
+            return QSPI_DATA_2_LINES;
+        case Lines::QUAD:
+            return QSPI_DATA_4_LINES;
+        default:
+            return QSPI_DATA_NONE;
+    }
+}
+
+} // end anonymous namespace
+
+
+QspiNorHal::QspiNorHal(QSPI_HandleTypeDef& hqspi)
+: mHqspi(hqspi)
+{
+    spInstance = this;
+}
+
+
+QspiNorHal::~QspiNorHal()
+{
+    (void)HAL_QSPI_Abort(&mHqspi);
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+Status QspiNorHal::Read(const NorCommand& command, uint8_t* pData)
+{
+    if ((pData == nullptr) || (command.length == 0U) || (command.dataLines == Lines::NONE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mHqspi.State != HAL_QSPI_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    QSPI_CommandTypeDef hal = ToHal(command);
+    const HAL_StatusTypeDef result = HAL_QSPI_Command(&mHqspi, &hal, HAL_QSPI_TIMEOUT_DEFAULT_VALUE);
+    if (result != HAL_OK)
+    {
+        return ToStatus(result);
+    }
+    return ToStatus(HAL_QSPI_Receive(&mHqspi, pData, HAL_QSPI_TIMEOUT_DEFAULT_VALUE));
+}
+
+
+Status QspiNorHal::Write(const NorCommand& command, const uint8_t* pData)
+{
+    if ((command.length != 0U) && ((pData == nullptr) || (command.dataLines == Lines::NONE)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mHqspi.State != HAL_QSPI_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    QSPI_CommandTypeDef hal = ToHal(command);
+    const HAL_StatusTypeDef result = HAL_QSPI_Command(&mHqspi, &hal, HAL_QSPI_TIMEOUT_DEFAULT_VALUE);
+    if ((result != HAL_OK) || (command.length == 0U))
+    {
+        return ToStatus(result);
+    }
+    // the HAL does not write through the pointer
+    return ToStatus(HAL_QSPI_Transmit(&mHqspi, const_cast<uint8_t*>(pData), HAL_QSPI_TIMEOUT_DEFAULT_VALUE));
+}
+
+
+Status QspiNorHal::WriteDma(const NorCommand& command, const uint8_t* pData)
+{
+    if ((pData == nullptr) || (command.length == 0U) || (command.dataLines == Lines::NONE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mHqspi.State != HAL_QSPI_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    // the MDMA reads the data from memory, it must be cleaned from the D-Cache
+    Utils::DCache::Clean(pData, command.length);
+    QSPI_CommandTypeDef hal = ToHal(command);
+    const HAL_StatusTypeDef result = HAL_QSPI_Command(&mHqspi, &hal, HAL_QSPI_TIMEOUT_DEFAULT_VALUE);
+    if (result != HAL_OK)
+    {
+        return ToStatus(result);
+    }
+    return ToStatus(HAL_QSPI_Transmit_DMA(&mHqspi, const_cast<uint8_t*>(pData)));
+}
+
+
+Status QspiNorHal::PollStatus(const NorCommand& command, uint8_t mask, uint8_t match)
+{
+    if (mHqspi.State != HAL_QSPI_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    NorCommand status = command;
+    status.length = 1U;
+    QSPI_CommandTypeDef hal = ToHal(status);
+    QSPI_AutoPollingTypeDef config{};
+    config.Match = match;
+    config.Mask = mask;
+    config.Interval = POLL_INTERVAL;
+    config.StatusBytesSize = 1U;
+    config.MatchMode = QSPI_MATCH_MODE_AND;
+    config.AutomaticStop = QSPI_AUTOMATIC_STOP_ENABLE;
+    return ToStatus(HAL_QSPI_AutoPolling_IT(&mHqspi, &hal, &config));
+}
+
+
+Status QspiNorHal::EnterMemoryMapped(const NorCommand& command)
+{
+    if (mHqspi.State != HAL_QSPI_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    // lines and code of the region may be older than the last program or erase
+    SCB_CleanInvalidateDCache();
+    SCB_InvalidateICache();
+    NorCommand read = command;
+    read.length = 0U;
+    QSPI_CommandTypeDef hal = ToHal(read);
+    QSPI_MemoryMappedTypeDef config{};
+    config.TimeOutActivation = QSPI_TIMEOUT_COUNTER_ENABLE;
+    config.TimeOutPeriod = MAPPED_TIMEOUT;
+    return ToStatus(HAL_QSPI_MemoryMapped(&mHqspi, &hal, &config));
+}
+
+
+void QspiNorHal::ExitMemoryMapped()
+{
+    if (mHqspi.State == HAL_QSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        (void)HAL_QSPI_Abort(&mHqspi);
+    }
+}
+
+
+const uint8_t* QspiNorHal::GetMapped() const
+{
+    if (mHqspi.State != HAL_QSPI_STATE_BUSY_MEM_MAPPED)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint8_t*>(QSPI_MAPPED_BASE);
+}
+
+
+void QspiNorHal::OnComplete()
+{
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(Status::OK);
+    }
+}
+
+
+void QspiNorHal::OnError()
+{
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(Status::HW_ERROR);
+    }
+}
+
+
+QspiNorHal* QspiNorHal::GetInstance(const QSPI_HandleTypeDef* hqspi)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHqspi == hqspi))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+QSPI_CommandTypeDef QspiNorHal::ToHal(const NorCommand& command)
+{
+    QSPI_CommandTypeDef hal{};
+    hal.Instruction = command.instruction;
+    hal.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+    hal.Address = command.address;
+    hal.AddressMode = AddressMode(command.addressLines);
+    hal.AddressSize = (command.addressBytes == 4U) ? QSPI_ADDRESS_32_BITS : QSPI_ADDRESS_24_BITS;
+    hal.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+    hal.DummyCycles = command.dummyCycles;
+    const uint32_t modeBits = static_cast<uint32_t>(command.modeCycles) * static_cast<uint32_t>(command.addressLines);
+    if (modeBits == 8U)
+    {
+        // one mode byte, all bits high
+        hal.AlternateByteMode = AlternateMode(command.addressLines);
+        hal.AlternateBytesSize = QSPI_ALTERNATE_BYTES_8_BITS;
+        hal.AlternateBytes = 0xFFU;
+    }
+    else
+    {
+        hal.DummyCycles += command.modeCycles;
+    }
+    hal.DataMode = DataMode(command.dataLines);
+    hal.NbData = command.length;
+    hal.DdrMode = QSPI_DDR_MODE_DISABLE;
+    hal.DdrHoldHalfCycle = QSPI_DDR_HHC_ANALOG_DELAY;
+    hal.SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+    return hal;
+}
+
+
+Status QspiNorHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_QSPI_TxCpltCallback(QSPI_HandleTypeDef* hqspi)
+{
+    QspiNorHal* pPort = QspiNorHal::GetInstance(hqspi);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_QSPI_StatusMatchCallback(QSPI_HandleTypeDef* hqspi)
+{
+    QspiNorHal* pPort = QspiNorHal::GetInstance(hqspi);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_QSPI_ErrorCallback(QSPI_HandleTypeDef* hqspi)
+{
+    QspiNorHal* pPort = QspiNorHal::GetInstance(hqspi);
+    if (pPort != nullptr)
+    {
+        pPort->OnError();
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ ********************************************************************************
+ * @file        QspiNorHal.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, INorPort on the QUADSPI through HAL_QSPI and the MDMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "INorPort.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace Flash {
+
+
+/**
+ * @brief   This class provides the INorPort on the QUADSPI of the STM32H7.
+ * @details Read and Write run HAL_QSPI_Command with HAL_QSPI_Receive / HAL_QSPI_Transmit. WriteDma moves
+ *          the data phase with HAL_QSPI_Transmit_DMA (MDMA) and ends in HAL_QSPI_TxCpltCallback, PollStatus
+ *          runs HAL_QSPI_AutoPolling_IT with automatic stop and ends in HAL_QSPI_StatusMatchCallback.\n
+ *          EnterMemoryMapped runs HAL_QSPI_MemoryMapped with the timeout counter, which releases the chip
+ *          select after an idle time, and cleans / invalidates the caches first, so no line of the region
+ *          from before a program or erase remains. ExitMemoryMapped aborts the mode with HAL_QSPI_Abort.\n
+ *          Mode cycles which form one byte on the address lines (2 cycles on four lines) are sent as
+ *          alternate byte 0xFF, which keeps the device out of the continuous read mode, other mode cycles
+ *          are added to the dummy cycles.
+ * @note    The application initialises the handle (ClockPrescaler, FlashSize, ChipSelectHighTime) and links
+ *          the MDMA handle. QUADSPI_IRQHandler and MDMA_IRQHandler call the HAL handlers. The mapped region
+ *          should be configured by the MPU as normal, cacheable memory. The memory-mapped QUADSPI is a
+ *          single instance.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class QspiNorHal : public INorPort
+{
+    public:
+
+        /**
+         * @brief   Constructs the port.
+         *
+         * @param   hqspi   The initialised QUADSPI handle with linked MDMA handle.
+         */
+        explicit QspiNorHal(QSPI_HandleTypeDef& hqspi);
+
+        /// @brief Destructor.
+        ~QspiNorHal() override;
+
+        QspiNorHal(QspiNorHal const &) = delete;             //!< Copy constructor
+        QspiNorHal& operator=(QspiNorHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc INorPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc INorPort::Read
+        Status Read(const NorCommand& command, uint8_t* pData) override;
+
+        /// @copydoc INorPort::Write
+        Status Write(const NorCommand& command, const uint8_t* pData) override;
+
+        /// @copydoc INorPort::WriteDma
+        Status WriteDma(const NorCommand& command, const uint8_t* pData) override;
+
+        /// @copydoc INorPort::PollStatus
+        Status PollStatus(const NorCommand& command, uint8_t mask, uint8_t match) override;
+
+        /// @copydoc INorPort::EnterMemoryMapped
+        Status EnterMemoryMapped(const NorCommand& command) override;
+
+        /// @copydoc INorPort::ExitMemoryMapped
+        void ExitMemoryMapped() override;
+
+        /// @copydoc INorPort::GetMapped
+        const uint8_t* GetMapped() const override;
+
+        /// @brief HAL_QSPI_TxCpltCallback / HAL_QSPI_StatusMatchCallback.
+        void OnComplete();
+
+        /// @brief HAL_QSPI_ErrorCallback.
+        void OnError();
+
+        /// @brief The instance of a handle or nullptr.
+        static QspiNorHal* GetInstance(const QSPI_HandleTypeDef* hqspi);
+
+    private:
+
+        /// @brief Translate a command into the HAL command.
+        static QSPI_CommandTypeDef ToHal(const NorCommand& command);
+
+        /// @brief Map a HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The QUADSPI handle.
+        QSPI_HandleTypeDef& mHqspi;
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        /// @brief The instance of the QUADSPI.
+        static QspiNorHal* spInstance;
+};
+
+} // end namespace Flash
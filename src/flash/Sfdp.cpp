@@ -0,0 +1,161 @@
+/**
+ ********************************************************************************
+ * @file        Sfdp.cpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, SFDP parser implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "Sfdp.hpp"
+
+using namespace Flash;
+
+namespace {
+
+/// @brief "SFDP" read as little endian word.
+constexpr uint32_t SIGNATURE{0x50444653U};
+
+/// @brief DWORDs of the JESD216 table.
+constexpr size_t MIN_TABLE_DWORDS{9U};
+
+/// @brief Largest device, the memory-mapped region of the QUADSPI is 256 MB.
+constexpr uint64_t MAX_SIZE{256U * 1024U * 1024U};
+
+/// @brief Devices above 16 MB need 4 byte addresses.
+constexpr uint64_t MAX_3BYTE_SIZE{16U * 1024U * 1024U};
+
+/// @brief Little endian word at a byte offset.
+uint32_t Load32(const uint8_t* pData)
+{
+    return static_cast<uint32_t>(pData[0]) | (static_cast<uint32_t>(pData[1]) << 8U) |
+           (static_cast<uint32_t>(pData[2]) << 16U) | (static_cast<uint32_t>(pData[3]) << 24U);
+}
+
+/// @brief DWORD n (1 based like the standard) of the table.
+uint32_t Dword(const uint8_t* pTable, size_t n)
+{
+    return Load32(&pTable[(n - 1U) * 4U]);
+}
+
+/// @brief Read command of a fast read field: opcode bits 15:8, mode clocks 7:5, dummy clocks 4:0.
+NorCommand ReadCommand(uint32_t field, Lines addressLines, Lines dataLines)
+{
+    NorCommand command{};
+    command.instruction = static_cast<uint8_t>(field >> 8U);
+    command.addressLines = addressLines;
+    command.modeCycles = static_cast<uint8_t>((field >> 5U) & 0x7U);
+    command.dummyCycles = static_cast<uint8_t>(field & 0x1FU);
+    command.dataLines = dataLines;
+    return command;
+}
+
+} // end anonymous namespace
+
+
+Status Sfdp::ParseHeader(const uint8_t* pHeader, uint32_t& address, size_t& dwords)
+{
+    // major revision 1, first parameter header with ID 0xFF00 (basic table, major revision 1)
+    if ((pHeader == nullptr) || (Load32(pHeader) != SIGNATURE) || (pHeader[5] != 1U) || (pHeader[8] != 0x00U) ||
+        (pHeader[10] != 1U) || (pHeader[15] != 0xFFU) || (pHeader[11] < MIN_TABLE_DWORDS))
+    {
+        return Status::NOT_SUPPORTED;
+    }
+    address = Load32(&pHeader[12]) & 0x00FFFFFFU;
+    dwords = (pHeader[11] < BASIC_TABLE_DWORDS) ? pHeader[11] : BASIC_TABLE_DWORDS;
+    return Status::OK;
+}
+
+
+Status Sfdp::ParseBasicTable(const uint8_t* pTable, size_t dwords, NorGeometry& geometry)
+{
+    if ((pTable == nullptr) || (dwords < MIN_TABLE_DWORDS))
+    {
+        return Status::NOT_SUPPORTED;
+    }
+    const uint32_t dword1 = Dword(pTable, 1U);
+    const uint32_t density = Dword(pTable, 2U);
+    uint64_t bits = 0U;
+    if ((density & 0x80000000U) != 0U)
+    {
+        const uint32_t exponent = density & 0x7FFFFFFFU;
+        bits = (exponent < 40U) ? (static_cast<uint64_t>(1U) << exponent) : (MAX_SIZE * 16U);
+    }
+    else
+    {
+        bits = static_cast<uint64_t>(density) + 1U;
+    }
+    const uint64_t size = bits / 8U;
+    const uint8_t addressModes = static_cast<uint8_t>((dword1 >> 17U) & 0x3U);
+    if ((size == 0U) || (size > MAX_SIZE) || (addressModes == 3U) ||
+        ((size > MAX_3BYTE_SIZE) && (addressModes == 0U)))
+    {
+        return Status::NOT_SUPPORTED;
+    }
+
+    NorGeometry result{};
+    result.size = static_cast<uint32_t>(size);
+    result.addressModes = addressModes;
+    result.addressBytes = ((addressModes == 2U) || (size > MAX_3BYTE_SIZE)) ? 4U : 3U;
+    if (dwords >= 11U)
+    {
+        result.pageSize = 1UL << ((Dword(pTable, 11U) >> 4U) & 0xFU);
+    }
+    if (dwords >= 15U)
+    {
+        result.quadEnable = static_cast<uint8_t>((Dword(pTable, 15U) >> 20U) & 0x7U);
+    }
+    if (dwords >= 16U)
+    {
+        result.enter4Byte = static_cast<uint8_t>(Dword(pTable, 16U) >> 24U);
+    }
+
+    // erase types of DWORD8 and DWORD9: size exponent and opcode, sorted by insertion
+    size_t count = 0U;
+    for (size_t i = 0U; i < MAX_ERASE_TYPES; i++)
+    {
+        const uint32_t field = Dword(pTable, 8U + (i / 2U)) >> (16U * (i % 2U));
+        const uint32_t exponent = field & 0xFFU;
+        if ((exponent == 0U) || (exponent > 31U))
+        {
+            continue;
+        }
+        const EraseType type{static_cast<uint32_t>(1UL << exponent), static_cast<uint8_t>(field >> 8U)};
+        size_t pos = count;
+        while ((pos > 0U) && (result.erase[pos - 1U].size > type.size))
+        {
+            result.erase[pos] = result.erase[pos - 1U];
+            pos--;
+        }
+        result.erase[pos] = type;
+        count++;
+    }
+    if (count == 0U)
+    {
+        return Status::NOT_SUPPORTED;
+    }
+
+    const uint32_t dword3 = Dword(pTable, 3U);
+    if ((dword1 & (1UL << 21U)) != 0U)
+    {
+        result.read = ReadCommand(dword3 & 0xFFFFU, Lines::QUAD, Lines::QUAD);
+    }
+    else if ((dword1 & (1UL << 22U)) != 0U)
+    {
+        result.read = ReadCommand(dword3 >> 16U, Lines::SINGLE, Lines::QUAD);
+    }
+    else
+    {
+        result.read.instruction = 0x0BU;
+        result.read.addressLines = Lines::SINGLE;
+        result.read.dummyCycles = 8U;
+        result.read.dataLines = Lines::SINGLE;
+    }
+    result.read.addressBytes = result.addressBytes;
+    geometry = result;
+    return Status::OK;
+}
@@ -0,0 +1,76 @@
+/**
+ ********************************************************************************
+ * @file        Sfdp.hpp
+ *
+ * @namespace   Flash
+ *
+ * @brief       Flash, parser of the serial flash discoverable parameters (JESD216).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "FlashTypes.hpp"
+namespace Flash {
+
+
+/**
+ * @brief   This class decodes the SFDP header and the basic flash parameter table into a NorGeometry.
+ * @details The SFDP area is read with instruction 0x5A, 3 address bytes and 8 dummy cycles. Its header
+ *          is followed by the parameter headers, the first one points to the basic flash parameter table
+ *          (BFPT). The table gives the density, the address modes, the erase types, the fast read modes,
+ *          the page size (DWORD11), the quad enable requirement (DWORD15) and the 4 byte entry methods
+ *          (DWORD16). The first 9 DWORDs are mandatory since JESD216, the later ones are used if the
+ *          table has them (JESD216A and newer).\n
+ *          The read command of the geometry is the fastest single transfer rate mode: 1-4-4, 1-1-4 or
+ *          FAST_READ (0x0B) on one line.
+ *  - - -
+ *
+ * __Thread safety:__
+ * All functions are reentrant.
+ *
+ */
+class Sfdp
+{
+    public:
+
+        /// @brief Instruction of the SFDP read.
+        static constexpr uint8_t READ_SFDP{0x5AU};
+
+        /// @brief Dummy cycles of the SFDP read.
+        static constexpr uint8_t READ_SFDP_DUMMY{8U};
+
+        /// @brief Bytes of the SFDP header and the first parameter header.
+        static constexpr uint32_t HEADER_SIZE{16U};
+
+        /// @brief DWORDs of the basic table which are used.
+        static constexpr size_t BASIC_TABLE_DWORDS{16U};
+
+        /**
+         * @brief   Decode the SFDP header and locate the basic flash parameter table.
+         *
+         * @param   pHeader     HEADER_SIZE bytes from SFDP address 0.
+         * @param   address     Returns the SFDP address of the table.
+         * @param   dwords      Returns the DWORDs of the table, at most BASIC_TABLE_DWORDS.
+         *
+         * @return  OK, NOT_SUPPORTED without valid signature or basic table.
+         */
+        static Status ParseHeader(const uint8_t* pHeader, uint32_t& address, size_t& dwords);
+
+        /**
+         * @brief   Decode the basic flash parameter table.
+         *
+         * @param   pTable      The table as little endian bytes.
+         * @param   dwords      DWORDs of the table, at least 9.
+         * @param   geometry    Returns the geometry.
+         *
+         * @return  OK, NOT_SUPPORTED for a short table, a reserved address mode or a device larger than
+         *          the memory-mapped region.
+         */
+        static Status ParseBasicTable(const uint8_t* pTable, size_t dwords, NorGeometry& geometry);
+};
+
+} // end namespace Flash
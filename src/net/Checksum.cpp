@@ -0,0 +1,128 @@
+/**
+ ********************************************************************************
+ * @file        Checksum.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, internet checksum implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "Checksum.hpp"
+#include "Protocol.hpp"
+#include <cstring>
+
+using namespace Net;
+
+
+uint32_t Checksum::Add(uint32_t sum, const uint8_t* pData, size_t len)
+{
+    // 32 bit words summed into 64 bit, the carries are folded once at the end
+    uint64_t acc = sum;
+    while (len >= 8U)
+    {
+        uint64_t word = 0U;
+        std::memcpy(&word, pData, sizeof(word));
+        acc += (word & 0xFFFFFFFFU) + (word >> 32U);
+        pData += 8U;
+        len -= 8U;
+    }
+    if (len >= 4U)
+    {
+        uint32_t word = 0U;
+        std::memcpy(&word, pData, sizeof(word));
+        acc += word;
+        pData += 4U;
+        len -= 4U;
+    }
+    if (len >= 2U)
+    {
+        uint16_t word = 0U;
+        std::memcpy(&word, pData, sizeof(word));
+        acc += word;
+        pData += 2U;
+        len -= 2U;
+    }
+    if (len > 0U)
+    {
+        // the odd byte is the first byte of a zero padded word
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        acc += pData[0];
+#else
+        acc += static_cast<uint32_t>(pData[0]) << 8U;
+#endif
+    }
+
+    acc = (acc & 0xFFFFFFFFU) + (acc >> 32U);
+    acc = (acc & 0xFFFFFFFFU) + (acc >> 32U);
+    return Fold(static_cast<uint32_t>(acc));
+}
+
+
+uint32_t Checksum::AddChain(uint32_t sum, const PacketBuffer& frame, size_t offset, size_t len)
+{
+    bool odd = false;
+    for (const PacketBuffer* pBuffer = &frame; (pBuffer != nullptr) && (len > 0U); pBuffer = pBuffer->pNext)
+    {
+        if (offset >= pBuffer->length)
+        {
+            offset -= pBuffer->length;
+            continue;
+        }
+        const size_t chunk = ((pBuffer->length - offset) < len) ? (pBuffer->length - offset) : len;
+        uint32_t part = Add(0U, &pBuffer->pPayload[offset], chunk);
+        if (odd)
+        {
+            // the chunk starts in the middle of a word, its bytes sit in the other half
+            part = ((part << 8U) | (part >> 8U)) & 0xFFFFU;
+        }
+        sum = Fold(sum + part);
+        odd = (odd != ((chunk & 1U) != 0U));
+        len -= chunk;
+        offset = 0U;
+    }
+    return sum;
+}
+
+
+void Checksum::InsertIpv4Udp(PacketBuffer& frame)
+{
+    uint8_t* pFrame = frame.pPayload;
+    if ((frame.length < (ETH_HEADER_SIZE + IPV4_HEADER_SIZE)) || (Load16(&pFrame[ETH_TYPE_OFFSET]) != ETH_TYPE_IPV4))
+    {
+        return;
+    }
+
+    uint8_t* pIp = &pFrame[ETH_HEADER_SIZE];
+    const size_t ipHeaderSize = static_cast<size_t>(pIp[0] & 0x0FU) * 4U;
+    if ((ipHeaderSize < IPV4_HEADER_SIZE) || (frame.length < (ETH_HEADER_SIZE + ipHeaderSize)))
+    {
+        return;
+    }
+    Store16(&pIp[IPV4_CHECKSUM_OFFSET], 0U);
+    Store16(&pIp[IPV4_CHECKSUM_OFFSET], Finish(Add(0U, pIp, ipHeaderSize)));
+
+    const size_t udpOffset = ETH_HEADER_SIZE + ipHeaderSize;
+    if ((pIp[IPV4_PROTOCOL_OFFSET] != IPV4_PROTOCOL_UDP) || (frame.length < (udpOffset + UDP_HEADER_SIZE)))
+    {
+        return;
+    }
+    uint8_t* pUdp = &pFrame[udpOffset];
+    const uint16_t udpLength = Load16(&pUdp[UDP_LENGTH_OFFSET]);
+    if ((udpLength < UDP_HEADER_SIZE) || ((udpOffset + udpLength) > frame.totalLength))
+    {
+        return;
+    }
+
+    Store16(&pUdp[UDP_CHECKSUM_OFFSET], 0U);
+    uint32_t sum = Add(0U, &pIp[IPV4_SRC_OFFSET], 8U);
+    sum = AddValue(sum, IPV4_PROTOCOL_UDP);
+    sum = AddValue(sum, udpLength);
+    sum = AddChain(sum, frame, udpOffset, udpLength);
+    const uint16_t checksum = Finish(sum);
+    // a computed 0 is sent as 0xFFFF, 0 means no checksum
+    Store16(&pUdp[UDP_CHECKSUM_OFFSET], (checksum == 0U) ? 0xFFFFU : checksum);
+}
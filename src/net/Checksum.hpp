@@ -0,0 +1,115 @@
+/**
+ ********************************************************************************
+ * @file        Checksum.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, internet checksum (RFC 1071) with partial sums.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "PacketBuffer.hpp"
+namespace Net {
+
+
+/**
+ * @brief   This class provides the ones' complement sum of the IP, UDP and ICMP headers.
+ * @details A sum is built from partial sums (RFC 1071: the ones' complement sum is associative,
+ *          commutative and byte order independent), so the constant part of a header can be summed
+ *          once per flow and only the changing fields are added per packet.\n
+ *          Partial sums are kept in the CPU byte order and folded to 16 bit, @ref Finish converts
+ *          the result to the value which is stored with Store16. The data is summed in 64 bit steps
+ *          with deferred carries.
+ *  - - -
+ *
+ * __Thread safety:__
+ * All functions are reentrant.
+ *
+ */
+class Checksum
+{
+    public:
+
+        /**
+         * @brief   Add bytes to a partial sum.
+         *
+         * @param   sum     Partial sum of the preceding bytes (0 to start), the preceding byte count must be even.
+         * @param   pData   The bytes, no alignment needed.
+         * @param   len     Count of bytes.
+         *
+         * @return  The partial sum, folded to 16 bit.
+         */
+        static uint32_t Add(uint32_t sum, const uint8_t* pData, size_t len);
+
+        /**
+         * @brief   Add bytes of a buffer chain to a partial sum, buffers of odd length are handled.
+         *
+         * @param   sum     Partial sum of the preceding bytes, the preceding byte count must be even.
+         * @param   frame   Head of the chain.
+         * @param   offset  First byte, counted from the payload start of the head.
+         * @param   len     Count of bytes.
+         *
+         * @return  The partial sum, folded to 16 bit.
+         */
+        static uint32_t AddChain(uint32_t sum, const PacketBuffer& frame, size_t offset, size_t len);
+
+        /**
+         * @brief   Add a 16 bit header field to a partial sum.
+         *
+         * @param   sum     Partial sum.
+         * @param   value   The field value in host order.
+         *
+         * @return  The partial sum, folded to 16 bit.
+         */
+        static uint32_t AddValue(uint32_t sum, uint16_t value)
+        {
+            return Fold(sum + ToSumOrder(value));
+        };
+
+        /**
+         * @brief   Complete a sum.
+         *
+         * @param   sum     Partial sum over all covered bytes.
+         *
+         * @return  The checksum in host order, written with Store16. A received header with a
+         *          correct checksum results in 0.
+         */
+        static uint16_t Finish(uint32_t sum)
+        {
+            return ToSumOrder(static_cast<uint16_t>(~Fold(sum)));
+        };
+
+        /**
+         * @brief   Fill the IPv4 header and UDP checksums of an ethernet frame, like the MAC does
+         *          with checksum insertion enabled. Other frames are not changed.
+         *
+         * @param   frame   The frame, the headers must be in the head buffer.
+         */
+        static void InsertIpv4Udp(PacketBuffer& frame);
+
+    private:
+
+        /// @brief Fold carries into the lower 16 bit.
+        static uint32_t Fold(uint32_t sum)
+        {
+            sum = (sum & 0xFFFFU) + (sum >> 16U);
+            return (sum & 0xFFFFU) + (sum >> 16U);
+        };
+
+        /// @brief Swap a host order value into the order of the summed memory words.
+        static uint16_t ToSumOrder(uint16_t value)
+        {
+#if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+            return static_cast<uint16_t>((value << 8U) | (value >> 8U));
+#else
+            return value;
+#endif
+        };
+};
+
+} // end namespace Net
@@ -0,0 +1,242 @@
+/**
+ ********************************************************************************
+ * @file        EthDeviceHal.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, HAL_ETH device implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "EthDeviceHal.hpp"
+#include "DCache.hpp"
+
+using namespace Net;
+
+EthDeviceHal* EthDeviceHal::spInstance{nullptr};
+
+namespace {
+
+/// @brief DMA descriptors of both rings, the HAL keeps only the pointers.
+ETH_DMADescTypeDef sRxDescriptors[ETH_RX_DESC_CNT] NET_DMA_SECTION;
+ETH_DMADescTypeDef sTxDescriptors[ETH_TX_DESC_CNT] NET_DMA_SECTION;
+
+/// @brief Timestamp words (seconds, nanoseconds in digital rollover) to nanoseconds.
+inline uint64_t ToNanoseconds(uint32_t seconds, uint32_t nanoseconds)
+{
+    return (static_cast<uint64_t>(seconds) * 1000000000U) + nanoseconds;
+}
+
+} // end anonymous namespace
+
+
+EthDeviceHal::EthDeviceHal(ETH_HandleTypeDef& heth, PacketPool& pool)
+: mHeth(heth)
+, mPool(pool)
+{
+    spInstance = this;
+}
+
+
+EthDeviceHal::~EthDeviceHal()
+{
+    spInstance = nullptr;
+}
+
+
+Status EthDeviceHal::Start()
+{
+    mHeth.Init.TxDesc = sTxDescriptors;
+    mHeth.Init.RxDesc = sRxDescriptors;
+    mHeth.Init.RxBuffLen = PBUF_DATA_SIZE;
+
+    if (HAL_ETH_Init(&mHeth) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+    // HAL_ETH_Start_IT fills the RX ring through HAL_ETH_RxAllocateCallback
+    if (HAL_ETH_Start_IT(&mHeth) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+Status EthDeviceHal::Transmit(PacketBuffer& frame)
+{
+    size_t count = 0U;
+    for (PacketBuffer* pBuffer = &frame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+    {
+        if (count >= mTxBuffers.size())
+        {
+            return Status::INVALID_PARAM;
+        }
+        mTxBuffers[count].buffer = pBuffer->pPayload;
+        mTxBuffers[count].len = pBuffer->length;
+        mTxBuffers[count].next = nullptr;
+        if (count > 0U)
+        {
+            mTxBuffers[count - 1U].next = &mTxBuffers[count];
+        }
+        Utils::DCache::Clean(pBuffer->pPayload, pBuffer->length);
+        count++;
+    }
+
+    ETH_TxPacketConfigTypeDef config{};
+    config.Attributes = ETH_TX_PACKETS_FEATURES_CRCPAD;
+    config.CRCPadCtrl = ETH_CRC_PAD_INSERT;
+    config.ChecksumCtrl = ETH_CHECKSUM_DISABLE;
+    if (mChecksumOffload)
+    {
+        config.Attributes |= ETH_TX_PACKETS_FEATURES_CSUM;
+        config.ChecksumCtrl = ETH_CHECKSUM_IPHDR_PAYLOAD_INSERT_PHDR_CALC;
+    }
+    config.Length = frame.totalLength;
+    config.TxBuffer = mTxBuffers.data();
+    config.pData = &frame;
+
+    if (frame.txTimestamp)
+    {
+        // snapshot in the first descriptor, HAL_ETH_TxPtpCallback hands it over on the release
+        (void)HAL_ETH_PTP_InsertTxTimestamp(&mHeth);
+    }
+
+    // the descriptors own the frame until HAL_ETH_TxFreeCallback
+    mPool.Ref(frame);
+    if (HAL_ETH_Transmit_IT(&mHeth, &config) != HAL_OK)
+    {
+        (void)mPool.Free(&frame);
+        return ((mHeth.ErrorCode & HAL_ETH_ERROR_BUSY) != 0U) ? Status::BUSY : Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+PacketBuffer* EthDeviceHal::Receive()
+{
+    void* pFrame{nullptr};
+    if (HAL_ETH_ReadData(&mHeth, &pFrame) != HAL_OK)
+    {
+        return nullptr;
+    }
+
+    // The snapshot is in a context descriptor behind the last one of the frame. HAL_ETH_ReadData
+    // reads it only on the next call (HAL_ETH_PTP_GetRxTimestamp would return the previous frame),
+    // so it is taken here, the HAL skips the descriptor later on.
+    PacketBuffer* pBuffer = static_cast<PacketBuffer*>(pFrame);
+    const ETH_DMADescTypeDef* pContext =
+        reinterpret_cast<const ETH_DMADescTypeDef*>(mHeth.RxDescList.RxDesc[mHeth.RxDescList.RxDescIdx]);
+    if ((READ_BIT(pContext->DESC3, ETH_DMARXNDESCWBF_OWN) == 0U) &&
+        (READ_BIT(pContext->DESC3, ETH_DMARXNDESCWBF_CTXT) != 0U))
+    {
+        pBuffer->timestamp = ToNanoseconds(pContext->DESC1, pContext->DESC0);
+    }
+    return pBuffer;
+}
+
+
+void EthDeviceHal::ReleaseTx()
+{
+    (void)HAL_ETH_ReleaseTxPacket(&mHeth);
+}
+
+
+void EthDeviceHal::OnRxAllocate(uint8_t** ppBuffer)
+{
+    PacketBuffer* pBuffer = mPool.Alloc();
+    if (pBuffer == nullptr)
+    {
+        mRxAllocFailures++;
+        *ppBuffer = nullptr;
+        return;
+    }
+    // no dirty line may be evicted over the DMA data later on
+    Utils::DCache::Invalidate(pBuffer->data.data(), PBUF_DATA_SIZE);
+    *ppBuffer = pBuffer->data.data();
+}
+
+
+void EthDeviceHal::OnRxLink(void** ppStart, void** ppEnd, uint8_t* pData, uint16_t length)
+{
+    PacketBuffer* pBuffer = mPool.FromData(pData);
+    if (pBuffer == nullptr)
+    {
+        return;
+    }
+
+    Utils::DCache::Invalidate(pData, length);
+    pBuffer->pPayload = pData;
+    pBuffer->length = length;
+    pBuffer->totalLength = length;
+    pBuffer->pNext = nullptr;
+
+    if (*ppStart == nullptr)
+    {
+        *ppStart = pBuffer;
+    }
+    else
+    {
+        PacketPool::Chain(*static_cast<PacketBuffer*>(*ppStart), *pBuffer);
+    }
+    *ppEnd = pBuffer;
+}
+
+
+void EthDeviceHal::OnTxFree(uint32_t* pPacket)
+{
+    (void)mPool.Free(reinterpret_cast<PacketBuffer*>(pPacket));
+}
+
+
+void EthDeviceHal::OnTxTimestamp(uint32_t* pPacket, const ETH_TimeStampTypeDef& timestamp)
+{
+    reinterpret_cast<PacketBuffer*>(pPacket)->timestamp = ToNanoseconds(timestamp.TimeStampHigh, timestamp.TimeStampLow);
+}
+
+
+extern "C" void HAL_ETH_RxAllocateCallback(uint8_t** buff)
+{
+    EthDeviceHal* pDevice = EthDeviceHal::GetInstance();
+    if (pDevice != nullptr)
+    {
+        pDevice->OnRxAllocate(buff);
+    }
+    else
+    {
+        *buff = nullptr;
+    }
+}
+
+
+extern "C" void HAL_ETH_RxLinkCallback(void** pStart, void** pEnd, uint8_t* buff, uint16_t Length)
+{
+    EthDeviceHal* pDevice = EthDeviceHal::GetInstance();
+    if (pDevice != nullptr)
+    {
+        pDevice->OnRxLink(pStart, pEnd, buff, Length);
+    }
+}
+
+
+extern "C" void HAL_ETH_TxFreeCallback(uint32_t* buff)
+{
+    EthDeviceHal* pDevice = EthDeviceHal::GetInstance();
+    if (pDevice != nullptr)
+    {
+        pDevice->OnTxFree(buff);
+    }
+}
+
+
+extern "C" void HAL_ETH_TxPtpCallback(uint32_t* buff, ETH_TimeStampTypeDef* timestamp)
+{
+    EthDeviceHal* pDevice = EthDeviceHal::GetInstance();
+    if (pDevice != nullptr)
+    {
+        pDevice->OnTxTimestamp(buff, *timestamp);
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ ********************************************************************************
+ * @file        EthDeviceHal.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, zero-copy ethernet device on the HAL_ETH descriptor rings.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IEthDevice.hpp"
+#include "PacketPool.hpp"
+#include "stm32h7xx_hal.h"
+#include <array>
+
+namespace Net {
+
+
+/**
+ * @brief   This class provides the IEthDevice on the ETH peripheral through HAL_ETH.
+ * @details The RX descriptors are filled from the packet pool (HAL_ETH_RxAllocateCallback), the
+ *          DMA writes directly into the packet buffers and HAL_ETH_RxLinkCallback chains the buffers
+ *          of a frame. No byte is copied. TX frames are passed as buffer list to HAL_ETH_Transmit_IT,
+ *          HAL_ETH_ReleaseTxPacket gives them back through HAL_ETH_TxFreeCallback.\n
+ *          The ring depths are ETH_RX_DESC_CNT / ETH_TX_DESC_CNT (CMake variables).\n
+ *          Once PtpClockHal configured the time stamping, PTP event frames carry their RX time and
+ *          frames with PacketBuffer::txTimestamp get their TX time before they are released.
+ * @note    The descriptors are placed in RAM_D2. The application configures the MPU so that the
+ *          descriptors are not cacheable, the buffers get cache maintenance and work in both cases.
+ *          The application sets heth.Instance, Init.MACAddr and Init.MediaInterface, the descriptors
+ *          and the buffer length are set by @ref Start.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call Receive, Transmit and ReleaseTx from one context.
+ *
+ */
+class EthDeviceHal : public IEthDevice
+{
+    public:
+
+        /**
+         * @brief   Constructs the device.
+         *
+         * @param   heth    The ETH handle.
+         * @param   pool    The pool of the RX buffers, TX frames must come from the same pool.
+         */
+        EthDeviceHal(ETH_HandleTypeDef& heth, PacketPool& pool);
+
+        /// @brief Destructor.
+        ~EthDeviceHal() override;
+
+        /**
+         * @brief   Initialise the MAC with the descriptor rings and start it in interrupt mode.
+         *
+         * @return  OK or HW_ERROR.
+         */
+        Status Start();
+
+        /// @copydoc IEthDevice::Transmit
+        Status Transmit(PacketBuffer& frame) override;
+
+        /// @copydoc IEthDevice::Receive
+        PacketBuffer* Receive() override;
+
+        /// @copydoc IEthDevice::ReleaseTx
+        void ReleaseTx() override;
+
+        /// @copydoc IEthDevice::SetChecksumOffload
+        void SetChecksumOffload(bool enable) override {mChecksumOffload = enable;};
+
+        /// @copydoc IEthDevice::IsChecksumOffload
+        bool IsChecksumOffload() const override {return mChecksumOffload;};
+
+        /// @brief Count of RX refills which found the pool empty.
+        uint32_t GetRxAllocFailures() const {return mRxAllocFailures;};
+
+        /// @brief HAL_ETH_RxAllocateCallback.
+        void OnRxAllocate(uint8_t** ppBuffer);
+
+        /// @brief HAL_ETH_RxLinkCallback.
+        void OnRxLink(void** ppStart, void** ppEnd, uint8_t* pBuffer, uint16_t length);
+
+        /// @brief HAL_ETH_TxFreeCallback.
+        void OnTxFree(uint32_t* pPacket);
+
+        /// @brief HAL_ETH_TxPtpCallback, called before the release of a frame with TX timestamp.
+        void OnTxTimestamp(uint32_t* pPacket, const ETH_TimeStampTypeDef& timestamp);
+
+        /// @brief The device instance or nullptr.
+        static EthDeviceHal* GetInstance() {return spInstance;};
+
+    private:
+
+        /// @brief The ETH handle.
+        ETH_HandleTypeDef& mHeth;
+
+        /// @brief Pool of all buffers.
+        PacketPool& mPool;
+
+        /// @brief Buffer list of the frame in HAL_ETH_Transmit_IT, the HAL copies it into the descriptors.
+        std::array<ETH_BufferTypeDef, TX_DESC_COUNT> mTxBuffers{};
+
+        /// @brief Failed RX refills.
+        uint32_t mRxAllocFailures{0U};
+
+        /// @brief Checksum insertion of TX frames, the pseudo header is calculated by the MAC.
+        bool mChecksumOffload{true};
+
+        /// @brief The single device instance, the device has one ETH MAC.
+        static EthDeviceHal* spInstance;
+};
+
+} // end namespace Net
@@ -0,0 +1,348 @@
+/**
+ ********************************************************************************
+ * @file        EthDeviceSim.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, host simulation of the ETH DMA descriptor rings.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "Checksum.hpp"
+#include "IEthDevice.hpp"
+#include "ITimeSource.hpp"
+#include "PacketPool.hpp"
+#include <array>
+#include <cstring>
+namespace Net {
+
+
+/**
+ * @brief   This class provides an IEthDevice which models the descriptor rings of HAL_ETH on the host.
+ * @details The application side follows HAL_ETH_ReadData / ETH_UpdateDescriptor / HAL_ETH_ReleaseTxPacket:
+ *          descriptors given back by the DMA are linked into a frame chain and refilled from the pool,
+ *          a refill which finds the pool empty leaves the descriptor to the application until the next
+ *          Receive. The wire side (@ref InjectFrame, @ref TransmitPending) plays the DMA: a frame which
+ *          finds no owned descriptor is dropped like on a RX FIFO overflow.\n
+ *          The ring depths are template parameters, the defaults are the configured ones, so unit
+ *          tests and benchmarks can compare depths in one build.\n
+ *          With a clock (@ref SetClock) the simulated MAC stamps every received frame and the sent
+ *          frames which request it, at the time the DMA moves them.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+template <size_t RX_DEPTH = RX_DESC_COUNT, size_t TX_DEPTH = TX_DESC_COUNT>
+class EthDeviceSim : public IEthDevice
+{
+    public:
+
+        /// @brief Receiver of the frames the simulated DMA sends.
+        using Sink = void (*)(const PacketBuffer& frame, void* pContext);
+
+        /**
+         * @brief   Constructs the device.
+         *
+         * @param   pool    The pool of the RX buffers, TX frames must come from the same pool.
+         */
+        explicit EthDeviceSim(PacketPool& pool)
+        : mPool(pool)
+        {
+        }
+
+        /// @brief Destructor, returns all ring buffers to the pool.
+        ~EthDeviceSim() override
+        {
+            for (RxDescriptor& descriptor : mRx)
+            {
+                (void)mPool.Free(descriptor.pBuffer);
+            }
+            (void)mPool.Free(mpRxStart);
+            for (TxDescriptor& descriptor : mTx)
+            {
+                (void)mPool.Free(descriptor.pFrame);
+            }
+        }
+
+        EthDeviceSim(EthDeviceSim const &) = delete;             //!< Copy constructor
+        EthDeviceSim& operator=(EthDeviceSim const &) = delete;  //!< Copy assignment
+
+        /// @brief Fill the RX ring (like HAL_ETH_Start).
+        void Start()
+        {
+            mRxBuildCount = RX_DEPTH;
+            Refill();
+        }
+
+        /**
+         * @brief   DMA side: a frame arrives from the wire.
+         *
+         * @param   pFrame  Frame bytes.
+         * @param   len     Frame length.
+         *
+         * @return  true if stored in the RX ring, false if dropped.
+         */
+        bool InjectFrame(const uint8_t* pFrame, size_t len)
+        {
+            const size_t needed = (len + PBUF_DATA_SIZE - 1U) / PBUF_DATA_SIZE;
+            if ((len == 0U) || (needed > RX_DEPTH))
+            {
+                mRxDropped++;
+                return false;
+            }
+            for (size_t i = 0U; i < needed; i++)
+            {
+                const RxDescriptor& descriptor = mRx[(mRxDma + i) % RX_DEPTH];
+                if (!descriptor.own)
+                {
+                    mRxDropped++;
+                    return false;
+                }
+            }
+
+            for (size_t i = 0U; i < needed; i++)
+            {
+                RxDescriptor& descriptor = mRx[mRxDma];
+                const size_t chunk = ((len - (i * PBUF_DATA_SIZE)) < PBUF_DATA_SIZE) ? (len - (i * PBUF_DATA_SIZE)) : PBUF_DATA_SIZE;
+                std::memcpy(descriptor.pBuffer->data.data(), &pFrame[i * PBUF_DATA_SIZE], chunk);
+                descriptor.length = static_cast<uint16_t>(chunk);
+                descriptor.first = (i == 0U);
+                descriptor.timestamp = (mpClock != nullptr) ? mpClock->GetTimeNs() : 0U;
+                descriptor.last = ((i + 1U) == needed);
+                descriptor.own = false;
+                mRxDma = (mRxDma + 1U) % RX_DEPTH;
+            }
+            return true;
+        }
+
+        /**
+         * @brief   DMA side: send all queued frames.
+         *
+         * @param   sink        Receiver of the frames, may be nullptr.
+         * @param   pContext    Context of the sink.
+         *
+         * @return  Count of sent frames.
+         */
+        size_t TransmitPending(Sink sink, void* pContext)
+        {
+            size_t frames = 0U;
+            while (mTx[mTxDma].own)
+            {
+                TxDescriptor& descriptor = mTx[mTxDma];
+                descriptor.own = false;
+                mTxDma = (mTxDma + 1U) % TX_DEPTH;
+                if (descriptor.pFrame != nullptr)
+                {
+                    if ((mpClock != nullptr) && descriptor.pFrame->txTimestamp)
+                    {
+                        descriptor.pFrame->timestamp = mpClock->GetTimeNs();
+                    }
+                    if (mChecksumOffload)
+                    {
+                        // the MAC inserts the checksums on the wire, the simulation into the buffer
+                        Checksum::InsertIpv4Udp(*descriptor.pFrame);
+                    }
+                    if (sink != nullptr)
+                    {
+                        sink(*descriptor.pFrame, pContext);
+                    }
+                    frames++;
+                    mTxFrames++;
+                }
+            }
+            return frames;
+        }
+
+        /// @copydoc IEthDevice::Transmit
+        Status Transmit(PacketBuffer& frame) override
+        {
+            size_t count = 0U;
+            for (const PacketBuffer* pBuffer = &frame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+            {
+                count++;
+            }
+            if (count > TX_DEPTH)
+            {
+                return Status::INVALID_PARAM;
+            }
+            if ((TX_DEPTH - mTxInUse) < count)
+            {
+                return Status::BUSY;
+            }
+
+            for (const PacketBuffer* pBuffer = &frame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+            {
+                TxDescriptor& descriptor = mTx[mTxCurrent];
+                // like the HAL the frame address is kept at the last descriptor
+                descriptor.pFrame = (pBuffer->pNext == nullptr) ? &frame : nullptr;
+                descriptor.own = true;
+                mTxCurrent = (mTxCurrent + 1U) % TX_DEPTH;
+            }
+            mTxInUse += count;
+            mPool.Ref(frame);
+            return Status::OK;
+        }
+
+        /// @copydoc IEthDevice::Receive
+        PacketBuffer* Receive() override
+        {
+            const size_t scanMax = RX_DEPTH - mRxBuildCount;
+            size_t scanned = 0U;
+            bool ready = false;
+
+            while ((scanned < scanMax) && !mRx[mRxRead].own && !ready)
+            {
+                RxDescriptor& descriptor = mRx[mRxRead];
+                if (descriptor.first || (mpRxStart != nullptr))
+                {
+                    PacketBuffer* pBuffer = descriptor.pBuffer;
+                    pBuffer->pPayload = pBuffer->data.data();
+                    pBuffer->length = descriptor.length;
+                    pBuffer->totalLength = descriptor.length;
+                    pBuffer->pNext = nullptr;
+                    if (mpRxStart == nullptr)
+                    {
+                        pBuffer->timestamp = descriptor.timestamp;
+                        mpRxStart = pBuffer;
+                    }
+                    else
+                    {
+                        PacketPool::Chain(*mpRxStart, *pBuffer);
+                    }
+                    ready = descriptor.last;
+                    descriptor.pBuffer = nullptr;
+                }
+                mRxRead = (mRxRead + 1U) % RX_DEPTH;
+                scanned++;
+            }
+
+            mRxBuildCount += scanned;
+            if (mRxBuildCount > 0U)
+            {
+                Refill();
+            }
+
+            if (!ready)
+            {
+                return nullptr;
+            }
+            PacketBuffer* pFrame = mpRxStart;
+            mpRxStart = nullptr;
+            mRxFrames++;
+            return pFrame;
+        }
+
+        /// @copydoc IEthDevice::ReleaseTx
+        void ReleaseTx() override
+        {
+            while ((mTxInUse > 0U) && !mTx[mTxRelease].own)
+            {
+                TxDescriptor& descriptor = mTx[mTxRelease];
+                (void)mPool.Free(descriptor.pFrame);
+                descriptor.pFrame = nullptr;
+                mTxRelease = (mTxRelease + 1U) % TX_DEPTH;
+                mTxInUse--;
+            }
+        }
+
+        /// @copydoc IEthDevice::SetChecksumOffload
+        void SetChecksumOffload(bool enable) override {mChecksumOffload = enable;};
+
+        /// @copydoc IEthDevice::IsChecksumOffload
+        bool IsChecksumOffload() const override {return mChecksumOffload;};
+
+        /**
+         * @brief   Set the clock of the IEEE 1588 timestamps.
+         *
+         * @param   pClock  The clock, nullptr to stop stamping.
+         */
+        void SetClock(const Utils::ITimeSource* pClock) {mpClock = pClock;};
+
+        /// @brief Frames dropped by the DMA for lack of descriptors.
+        uint32_t GetRxDropped() const {return mRxDropped;};
+
+        /// @brief Frames handed to the application.
+        uint32_t GetRxFrames() const {return mRxFrames;};
+
+        /// @brief Frames sent by the DMA.
+        uint32_t GetTxFrames() const {return mTxFrames;};
+
+        /// @brief Count of RX refills which found the pool empty.
+        uint32_t GetRxAllocFailures() const {return mRxAllocFailures;};
+
+    private:
+
+        /// @brief State of one RX descriptor.
+        struct RxDescriptor
+        {
+            PacketBuffer* pBuffer{nullptr};     //!< Attached buffer (BackupAddr0)
+            uint16_t length{0U};                //!< Written bytes
+            uint64_t timestamp{0U};             //!< Receive time of the frame
+            bool own{false};                    //!< Owned by the DMA
+            bool first{false};                  //!< First descriptor of a frame
+            bool last{false};                   //!< Last descriptor of a frame
+        };
+
+        /// @brief State of one TX descriptor.
+        struct TxDescriptor
+        {
+            PacketBuffer* pFrame{nullptr};      //!< Frame, set at the last descriptor (PacketAddress)
+            bool own{false};                    //!< Owned by the DMA
+        };
+
+        /// @brief Attach buffers to the descriptors given back by the application (ETH_UpdateDescriptor).
+        void Refill()
+        {
+            while (mRxBuildCount > 0U)
+            {
+                RxDescriptor& descriptor = mRx[mRxBuildIndex];
+                if (descriptor.pBuffer == nullptr)
+                {
+                    descriptor.pBuffer = mPool.Alloc();
+                    if (descriptor.pBuffer == nullptr)
+                    {
+                        mRxAllocFailures++;
+                        return;
+                    }
+                }
+                descriptor.own = true;
+                descriptor.first = false;
+                descriptor.last = false;
+                mRxBuildIndex = (mRxBuildIndex + 1U) % RX_DEPTH;
+                mRxBuildCount--;
+            }
+        }
+
+        /// @brief Pool of all buffers.
+        PacketPool& mPool;
+
+        std::array<RxDescriptor, RX_DEPTH> mRx{};   //!< RX ring
+        size_t mRxDma{0U};                          //!< Next descriptor the DMA writes
+        size_t mRxRead{0U};                         //!< Next descriptor the application reads
+        size_t mRxBuildIndex{0U};                   //!< First descriptor to refill
+        size_t mRxBuildCount{0U};                   //!< Descriptors to refill
+        PacketBuffer* mpRxStart{nullptr};           //!< Frame under construction
+
+        std::array<TxDescriptor, TX_DEPTH> mTx{};   //!< TX ring
+        size_t mTxCurrent{0U};                      //!< Next descriptor for Transmit
+        size_t mTxDma{0U};                          //!< Next descriptor the DMA sends
+        size_t mTxRelease{0U};                      //!< Next descriptor to release
+        size_t mTxInUse{0U};                        //!< Descriptors between release and current
+
+        uint32_t mRxDropped{0U};                    //!< Dropped frames
+        uint32_t mRxFrames{0U};                     //!< Received frames
+        uint32_t mTxFrames{0U};                     //!< Sent frames
+        uint32_t mRxAllocFailures{0U};              //!< Failed refills
+        bool mChecksumOffload{false};               //!< Emulated checksum insertion
+        const Utils::ITimeSource* mpClock{nullptr}; //!< Clock of the timestamps
+};
+
+} // end namespace Net
@@ -0,0 +1,125 @@
+/**
+ ********************************************************************************
+ * @file        EthDeviceSocket.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, loopback socket device implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "EthDeviceSocket.hpp"
+#include "Checksum.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+
+using namespace Net;
+
+namespace {
+
+sockaddr_in Loopback(uint16_t port)
+{
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+} // end anonymous namespace
+
+
+EthDeviceSocket::EthDeviceSocket(PacketPool& pool)
+: mPool(pool)
+{
+}
+
+
+EthDeviceSocket::~EthDeviceSocket()
+{
+    Close();
+}
+
+
+Status EthDeviceSocket::Open(uint16_t localPort, uint16_t peerPort)
+{
+    Close();
+    mSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (mSocket < 0)
+    {
+        return Status::HW_ERROR;
+    }
+
+    const sockaddr_in local = Loopback(localPort);
+    if (bind(mSocket, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0)
+    {
+        Close();
+        return Status::HW_ERROR;
+    }
+    mPeerPort = peerPort;
+    return Status::OK;
+}
+
+
+void EthDeviceSocket::Close()
+{
+    if (mSocket >= 0)
+    {
+        (void)close(mSocket);
+        mSocket = -1;
+    }
+}
+
+
+Status EthDeviceSocket::Transmit(PacketBuffer& frame)
+{
+    if ((mSocket < 0) || (frame.totalLength > mTxFrame.size()))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mChecksumOffload)
+    {
+        Checksum::InsertIpv4Udp(frame);
+    }
+
+    size_t length = 0U;
+    for (const PacketBuffer* pBuffer = &frame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+    {
+        std::memcpy(&mTxFrame[length], pBuffer->pPayload, pBuffer->length);
+        length += pBuffer->length;
+    }
+
+    const sockaddr_in peer = Loopback(mPeerPort);
+    const ssize_t sent = sendto(mSocket, mTxFrame.data(), length, 0, reinterpret_cast<const sockaddr*>(&peer), sizeof(peer));
+    return (sent == static_cast<ssize_t>(length)) ? Status::OK : Status::HW_ERROR;
+}
+
+
+PacketBuffer* EthDeviceSocket::Receive()
+{
+    if (mSocket < 0)
+    {
+        return nullptr;
+    }
+    PacketBuffer* pBuffer = mPool.Alloc();
+    if (pBuffer == nullptr)
+    {
+        return nullptr;
+    }
+
+    const ssize_t received = recv(mSocket, pBuffer->data.data(), pBuffer->data.size(), MSG_DONTWAIT);
+    if (received <= 0)
+    {
+        (void)mPool.Free(pBuffer);
+        return nullptr;
+    }
+    pBuffer->length = static_cast<uint16_t>(received);
+    pBuffer->totalLength = pBuffer->length;
+    return pBuffer;
+}
@@ -0,0 +1,100 @@
+/**
+ ********************************************************************************
+ * @file        EthDeviceSocket.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, host ethernet device which tunnels frames through a loopback UDP socket.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IEthDevice.hpp"
+#include "PacketPool.hpp"
+#include <array>
+
+namespace Net {
+
+
+/**
+ * @brief   This class provides an IEthDevice for host tests between processes or threads.
+ * @details Each ethernet frame is sent as one datagram from a socket bound to 127.0.0.1:localPort to
+ *          127.0.0.1:peerPort, so two stacks (two instances or two programs) form a point to point link
+ *          without a TAP device or privileges. Received frames are read into pool buffers without
+ *          blocking. The checksum offload is emulated before the frame leaves.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to make sure a clean access in one context.
+ *
+ */
+class EthDeviceSocket : public IEthDevice
+{
+    public:
+
+        /**
+         * @brief   Constructs the device.
+         *
+         * @param   pool    The pool of the RX buffers.
+         */
+        explicit EthDeviceSocket(PacketPool& pool);
+
+        /// @brief Destructor, closes the socket.
+        ~EthDeviceSocket() override;
+
+        EthDeviceSocket(EthDeviceSocket const &) = delete;             //!< Copy constructor
+        EthDeviceSocket& operator=(EthDeviceSocket const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Open the link.
+         *
+         * @param   localPort   Own loopback port.
+         * @param   peerPort    Loopback port of the other end.
+         *
+         * @return  OK or HW_ERROR if the socket can't be bound.
+         */
+        Status Open(uint16_t localPort, uint16_t peerPort);
+
+        /// @brief Close the link.
+        void Close();
+
+        /// @copydoc IEthDevice::Transmit
+        Status Transmit(PacketBuffer& frame) override;
+
+        /// @copydoc IEthDevice::Receive
+        PacketBuffer* Receive() override;
+
+        /// @copydoc IEthDevice::ReleaseTx
+        void ReleaseTx() override {};
+
+        /// @copydoc IEthDevice::SetChecksumOffload
+        void SetChecksumOffload(bool enable) override {mChecksumOffload = enable;};
+
+        /// @copydoc IEthDevice::IsChecksumOffload
+        bool IsChecksumOffload() const override {return mChecksumOffload;};
+
+    private:
+
+        /// @brief The pool of the RX buffers.
+        PacketPool& mPool;
+
+        /// @brief Socket descriptor, -1 if closed.
+        int mSocket{-1};
+
+        /// @brief Loopback port of the other end.
+        uint16_t mPeerPort{0U};
+
+        /// @brief Emulated checksum insertion.
+        bool mChecksumOffload{false};
+
+        /// @brief A frame is flattened here, the kernel copies it anyway.
+        std::array<uint8_t, PBUF_DATA_SIZE> mTxFrame{};
+};
+
+} // end namespace Net
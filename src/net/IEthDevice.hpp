@@ -0,0 +1,78 @@
+/**
+ ********************************************************************************
+ * @file        IEthDevice.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, interface of an ethernet MAC with zero-copy packet buffers.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "PacketBuffer.hpp"
+namespace Net {
+
+
+/**
+ * @brief   This class provides the frame interface of an ethernet MAC (hardware or simulation).
+ * @details Frames are packet buffer chains of one PacketPool. Received frames are handed over
+ *          with one reference, the receiver frees them. For transmission the device takes an own
+ *          reference which is dropped by @ref ReleaseTx after the DMA sent the frame, so the caller
+ *          may free its reference right after @ref Transmit.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to make sure a clean access in one context.
+ *
+ */
+class IEthDevice
+{
+    public:
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IEthDevice() = default;
+
+        /**
+         * @brief Queue a frame for transmission.
+         * @param frame     Chain with at most TX_DESC_COUNT buffers.
+         * @return OK if queued, BUSY if the TX ring is full, INVALID_PARAM for an oversized chain.
+         */
+        virtual Status Transmit(PacketBuffer& frame) = 0;
+
+        /**
+         * @brief Take the next received frame.
+         * @return The frame chain (owned by the caller) or nullptr.
+         */
+        virtual PacketBuffer* Receive() = 0;
+
+        /// @brief Return the buffers of sent frames to the pool.
+        virtual void ReleaseTx() = 0;
+
+        /**
+         * @brief Enable the insertion of the IPv4 header and UDP/TCP checksums by the MAC.
+         * @param enable    If true, the checksum fields of transmitted frames are left 0 by the stack.
+         */
+        virtual void SetChecksumOffload(bool enable) = 0;
+
+        /// @brief Checksum insertion of the MAC is enabled.
+        virtual bool IsChecksumOffload() const = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IEthDevice() = default;
+
+        IEthDevice(IEthDevice const &) = default;             //!< Copy constructor
+        IEthDevice(IEthDevice &&) = default;                  //!< Move constructor
+
+        IEthDevice& operator=(IEthDevice const &) = default;  //!< Copy assignment
+        IEthDevice& operator=(IEthDevice &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Net
@@ -0,0 +1,61 @@
+/**
+ ********************************************************************************
+ * @file        IPtpClock.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, interface of the adjustable IEEE 1588 clock of an ethernet MAC.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ITimeSource.hpp"
+namespace Net {
+
+
+/**
+ * @brief   This class provides the PTP hardware clock which stamps the frames of an IEthDevice.
+ * @details The clock is the time base of PacketBuffer::timestamp. A PTP servo disciplines it by
+ *          steps and by a frequency correction, in between it runs free. As a time source it hands
+ *          the synchronised time to log records and sampled data.
+ *  - - -
+ *
+ * __Thread safety:__
+ * GetTimeNs may be called from threads and ISR's.\n
+ * The adjustments must be called from one context.
+ *
+ */
+class IPtpClock : public Utils::ITimeSource
+{
+    public:
+
+        /**
+         * @brief Move the time by an offset.
+         * @param offsetNs  Signed offset in ns.
+         */
+        virtual void StepTime(int64_t offsetNs) = 0;
+
+        /**
+         * @brief Set the frequency correction.
+         * @param ppb   Correction against the nominal frequency in parts per billion (absolute, not additive).
+         */
+        virtual void SetFrequency(int32_t ppb) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IPtpClock() = default;
+
+        IPtpClock(IPtpClock const &) = default;             //!< Copy constructor
+        IPtpClock(IPtpClock &&) = default;                  //!< Move constructor
+
+        IPtpClock& operator=(IPtpClock const &) = default;  //!< Copy assignment
+        IPtpClock& operator=(IPtpClock &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Net
@@ -0,0 +1,69 @@
+/**
+ ********************************************************************************
+ * @file        NetTypes.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, common types and compile time configuration of the ethernet stack.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// The ring depths are set by CMake (ETH_RX_DESC_CNT / ETH_TX_DESC_CNT), the HAL uses the same defines.
+#if !defined(ETH_RX_DESC_CNT)
+#define ETH_RX_DESC_CNT     16
+#endif
+#if !defined(ETH_TX_DESC_CNT)
+#define ETH_TX_DESC_CNT     8
+#endif
+
+// Packet buffers: a full RX ring, the frames in flight on TX and some for the application.
+#if !defined(NET_PBUF_COUNT)
+#define NET_PBUF_COUNT      ((2 * ETH_RX_DESC_CNT) + ETH_TX_DESC_CNT)
+#endif
+
+// DMA memory of the ethernet MAC (descriptors and packet buffers), the AXI SRAM is not reachable in every case.
+#if defined(__arm__)
+#define NET_DMA_SECTION     __attribute__((section(".bss_RAM_D2")))
+#else
+#define NET_DMA_SECTION
+#endif
+
+namespace Net {
+
+
+/// @brief Count of RX DMA descriptors.
+constexpr size_t RX_DESC_COUNT{ETH_RX_DESC_CNT};
+
+/// @brief Count of TX DMA descriptors, also the maximum count of buffers per TX frame.
+constexpr size_t TX_DESC_COUNT{ETH_TX_DESC_CNT};
+
+/// @brief Count of packet buffers in the default pool.
+constexpr size_t PBUF_COUNT{NET_PBUF_COUNT};
+
+/// @brief Data bytes per packet buffer, a maximum frame (ETH_MAX_PACKET_SIZE 1528) in full cache lines.
+constexpr size_t PBUF_DATA_SIZE{1536U};
+
+static_assert((PBUF_DATA_SIZE % 32U) == 0U, "packet buffers must consist of full cache lines");
+static_assert(PBUF_COUNT > RX_DESC_COUNT, "the pool must be able to fill the RX ring and keep buffers for TX");
+
+
+/// @brief Result of a network operation.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< No free descriptor, retry after the TX release
+    NO_BUFFER=2,      //!< The packet pool is empty
+    INVALID_PARAM=3,  //!< Inconsistent parameter (too many buffers, length)
+    HW_ERROR=4,       //!< The MAC or DMA reported an error
+    UNRESOLVED=5      //!< The hardware address of the next hop is unknown, an ARP request is sent
+};
+
+} // end namespace Net
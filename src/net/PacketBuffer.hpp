@@ -0,0 +1,43 @@
+/**
+ ********************************************************************************
+ * @file        PacketBuffer.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, reference counted packet buffer (pbuf) which is directly used by the MAC DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "NetTypes.hpp"
+#include <array>
+namespace Net {
+
+
+/**
+ * @brief   One packet buffer: header and a cache line aligned data area for the DMA.
+ * @details A frame which does not fit into one buffer is a chain linked by @ref pNext.
+ *          Every buffer of a chain holds its own reference, the chain link counts as one.
+ *          The header and the data do not share a cache line, so the cache maintenance of
+ *          the data never touches the header.
+ */
+struct PacketBuffer
+{
+    PacketBuffer* pNext{nullptr};           //!< Next buffer of the same frame
+    uint8_t* pPayload{nullptr};             //!< First valid byte in @ref data
+    uint16_t length{0U};                    //!< Valid bytes in this buffer
+    uint16_t totalLength{0U};               //!< Valid bytes of this and all following buffers
+    volatile uint16_t refCount{0U};         //!< References, 0 if the buffer is in the pool
+    uint16_t index{0U};                     //!< Position in the pool
+    uint64_t timestamp{0U};                 //!< IEEE 1588 time of the frame head on the wire in ns, 0 if not stamped
+    bool txTimestamp{false};                //!< Request a TX timestamp, the device writes it into @ref timestamp
+
+    /// @brief Frame bytes, written and read by the DMA.
+    alignas(32) std::array<uint8_t, PBUF_DATA_SIZE> data{};
+};
+
+} // end namespace Net
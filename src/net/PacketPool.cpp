@@ -0,0 +1,139 @@
+/**
+ ********************************************************************************
+ * @file        PacketPool.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, packet buffer pool implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "PacketPool.hpp"
+#include "CriticalSection.hpp"
+#include <cstddef>
+
+using namespace Net;
+
+
+PacketPool::PacketPool(PacketBuffer* pBuffers, size_t count)
+: mpBuffers(pBuffers)
+, mCount(count)
+{
+    for (size_t i = count; i > 0U; i--)
+    {
+        PacketBuffer& buffer = mpBuffers[i - 1U];
+        buffer.index = static_cast<uint16_t>(i - 1U);
+        buffer.refCount = 0U;
+        buffer.pNext = mpFreeList;
+        mpFreeList = &buffer;
+    }
+    mFree = count;
+    mMinFree = count;
+}
+
+
+PacketBuffer* PacketPool::Alloc()
+{
+    PacketBuffer* pBuffer{nullptr};
+    {
+        Utils::CriticalSection cs;
+        pBuffer = mpFreeList;
+        if (pBuffer == nullptr)
+        {
+            mAllocFailures = mAllocFailures + 1U;
+            return nullptr;
+        }
+        mpFreeList = pBuffer->pNext;
+        mFree = mFree - 1U;
+        if (mFree < mMinFree)
+        {
+            mMinFree = mFree;
+        }
+    }
+
+    pBuffer->pNext = nullptr;
+    pBuffer->pPayload = pBuffer->data.data();
+    pBuffer->length = 0U;
+    pBuffer->totalLength = 0U;
+    pBuffer->timestamp = 0U;
+    pBuffer->txTimestamp = false;
+    pBuffer->refCount = 1U;
+    return pBuffer;
+}
+
+
+void PacketPool::Ref(PacketBuffer& buffer)
+{
+    Utils::CriticalSection cs;
+    buffer.refCount = static_cast<uint16_t>(buffer.refCount + 1U);
+}
+
+
+size_t PacketPool::Free(PacketBuffer* pBuffer)
+{
+    size_t released = 0U;
+
+    while (pBuffer != nullptr)
+    {
+        PacketBuffer* pNext{nullptr};
+        {
+            Utils::CriticalSection cs;
+            if (pBuffer->refCount == 0U)
+            {
+                // double free, leave the pool consistent
+                return released;
+            }
+            pBuffer->refCount = static_cast<uint16_t>(pBuffer->refCount - 1U);
+            if (pBuffer->refCount > 0U)
+            {
+                return released;
+            }
+            pNext = pBuffer->pNext;
+            pBuffer->pNext = mpFreeList;
+            mpFreeList = pBuffer;
+            mFree = mFree + 1U;
+        }
+        released++;
+        // the link held one reference of the next buffer
+        pBuffer = pNext;
+    }
+    return released;
+}
+
+
+void PacketPool::Chain(PacketBuffer& head, PacketBuffer& tail)
+{
+    PacketBuffer* pLast = &head;
+    for (;;)
+    {
+        pLast->totalLength = static_cast<uint16_t>(pLast->totalLength + tail.totalLength);
+        if (pLast->pNext == nullptr)
+        {
+            break;
+        }
+        pLast = pLast->pNext;
+    }
+    pLast->pNext = &tail;
+}
+
+
+PacketBuffer* PacketPool::FromData(const uint8_t* pData) const
+{
+    const uintptr_t first = reinterpret_cast<uintptr_t>(mpBuffers);
+    const uintptr_t address = reinterpret_cast<uintptr_t>(pData);
+    if ((address < first) || (address >= (first + (mCount * sizeof(PacketBuffer)))))
+    {
+        return nullptr;
+    }
+
+    const size_t index = (address - first) / sizeof(PacketBuffer);
+    const uintptr_t dataStart = reinterpret_cast<uintptr_t>(mpBuffers[index].data.data());
+    if ((address < dataStart) || (address >= (dataStart + PBUF_DATA_SIZE)))
+    {
+        return nullptr;
+    }
+    return &mpBuffers[index];
+}
@@ -0,0 +1,134 @@
+/**
+ ********************************************************************************
+ * @file        PacketPool.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, fixed size pool of reference counted packet buffers.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "PacketBuffer.hpp"
+namespace Net {
+
+
+/**
+ * @brief   This class provides a pool of packet buffers on caller provided storage.
+ * @details The buffers are kept in a LIFO free list (the last freed buffer is likely still cached).
+ *          Allocation and release take constant time and are ISR safe. A data pointer handed to the
+ *          DMA maps back to its buffer in constant time (@ref FromData), which is what makes the
+ *          RX path zero-copy: the DMA writes into the buffer which is later given to the application.
+ * @note    On the target the storage belongs into RAM_D2 (NET_DMA_SECTION), the ETH DMA can not
+ *          reach the DTCM.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.\n
+ * A buffer itself must only be modified by its current owner.
+ *
+ */
+class PacketPool
+{
+    public:
+
+        /**
+         * @brief   Constructs the pool and puts all buffers into the free list.
+         *
+         * @param   pBuffers    Storage of the buffers.
+         * @param   count       Count of buffers (at most 65535).
+         */
+        PacketPool(PacketBuffer* pBuffers, size_t count);
+
+        PacketPool(PacketPool const &) = delete;             //!< Copy constructor
+        PacketPool& operator=(PacketPool const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Take one buffer from the pool.
+         *
+         * @return  The buffer with one reference and an empty payload at the data start, nullptr if empty.
+         */
+        PacketBuffer* Alloc();
+
+        /**
+         * @brief   Add a reference to a buffer (the head of a chain keeps the whole chain alive).
+         *
+         * @param   buffer  The buffer.
+         */
+        void Ref(PacketBuffer& buffer);
+
+        /**
+         * @brief   Drop a reference, buffers which reach zero go back to the pool with their chain links.
+         *
+         * @param   pBuffer The buffer or nullptr.
+         *
+         * @return  Count of buffers returned to the pool.
+         */
+        size_t Free(PacketBuffer* pBuffer);
+
+        /**
+         * @brief   Append a chain to another one, the tail reference is taken over by the head.
+         *
+         * @param   head    The first chain.
+         * @param   tail    The appended chain.
+         */
+        static void Chain(PacketBuffer& head, PacketBuffer& tail);
+
+        /**
+         * @brief   Buffer which contains a data address.
+         *
+         * @param   pData   Address inside the data area of a buffer.
+         *
+         * @return  The buffer, nullptr if the address does not belong to the pool.
+         */
+        PacketBuffer* FromData(const uint8_t* pData) const;
+
+        /// @brief Count of buffers in the pool.
+        size_t GetCount() const {return mCount;};
+
+        /// @brief Count of free buffers.
+        size_t GetFreeCount() const {return mFree;};
+
+        /// @brief Lowest count of free buffers since construction.
+        size_t GetMinFreeCount() const {return mMinFree;};
+
+        /// @brief Count of failed allocations since construction.
+        uint32_t GetAllocFailures() const {return mAllocFailures;};
+
+    private:
+
+        /// @brief The buffer storage.
+        PacketBuffer* mpBuffers;
+
+        /// @brief Count of buffers.
+        size_t mCount;
+
+        /// @brief Free list, linked by PacketBuffer::pNext.
+        PacketBuffer* mpFreeList{nullptr};
+
+        /// @brief Free buffers.
+        volatile size_t mFree{0U};
+
+        /// @brief Low watermark of the free buffers.
+        volatile size_t mMinFree{0U};
+
+        /// @brief Failed allocations.
+        volatile uint32_t mAllocFailures{0U};
+};
+
+
+/**
+ * @brief   Static storage of a pool with a compile time size.
+ * @details Define it with NET_DMA_SECTION so the buffers are placed in the DMA RAM.
+ */
+template <size_t COUNT>
+struct PacketPoolStorage
+{
+    std::array<PacketBuffer, COUNT> buffers{};  //!< The buffers
+};
+
+} // end namespace Net
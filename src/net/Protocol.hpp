@@ -0,0 +1,102 @@
+/**
+ ********************************************************************************
+ * @file        Protocol.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, header layouts of ethernet, ARP, IPv4 and UDP.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+namespace Net {
+
+
+/// @brief Ethernet hardware address.
+using MacAddress = std::array<uint8_t, 6>;
+
+/// @brief Broadcast hardware address.
+constexpr MacAddress MAC_BROADCAST{0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU};
+
+// Ethernet II header
+constexpr size_t ETH_HEADER_SIZE{14U};
+constexpr size_t ETH_DST_OFFSET{0U};
+constexpr size_t ETH_SRC_OFFSET{6U};
+constexpr size_t ETH_TYPE_OFFSET{12U};
+constexpr uint16_t ETH_TYPE_IPV4{0x0800U};
+constexpr uint16_t ETH_TYPE_ARP{0x0806U};
+
+// ARP for IPv4 over ethernet, offsets from the start of the ARP packet
+constexpr size_t ARP_SIZE{28U};
+constexpr size_t ARP_OPERATION_OFFSET{6U};
+constexpr size_t ARP_SENDER_MAC_OFFSET{8U};
+constexpr size_t ARP_SENDER_IP_OFFSET{14U};
+constexpr size_t ARP_TARGET_MAC_OFFSET{18U};
+constexpr size_t ARP_TARGET_IP_OFFSET{24U};
+constexpr uint16_t ARP_REQUEST{1U};
+constexpr uint16_t ARP_REPLY{2U};
+
+// IPv4 header without options, offsets from the start of the IP header
+constexpr size_t IPV4_HEADER_SIZE{20U};
+constexpr size_t IPV4_LENGTH_OFFSET{2U};
+constexpr size_t IPV4_ID_OFFSET{4U};
+constexpr size_t IPV4_FRAGMENT_OFFSET{6U};
+constexpr size_t IPV4_PROTOCOL_OFFSET{9U};
+constexpr size_t IPV4_CHECKSUM_OFFSET{10U};
+constexpr size_t IPV4_SRC_OFFSET{12U};
+constexpr size_t IPV4_DST_OFFSET{16U};
+constexpr uint8_t IPV4_PROTOCOL_UDP{17U};
+constexpr uint16_t IPV4_DONT_FRAGMENT{0x4000U};
+constexpr uint8_t IPV4_DEFAULT_TTL{64U};
+
+// UDP header, offsets from the start of the UDP header
+constexpr size_t UDP_HEADER_SIZE{8U};
+constexpr size_t UDP_SRC_PORT_OFFSET{0U};
+constexpr size_t UDP_DST_PORT_OFFSET{2U};
+constexpr size_t UDP_LENGTH_OFFSET{4U};
+constexpr size_t UDP_CHECKSUM_OFFSET{6U};
+
+/// @brief Headers in front of the UDP payload.
+constexpr size_t UDP_FRAME_HEADER_SIZE{ETH_HEADER_SIZE + IPV4_HEADER_SIZE + UDP_HEADER_SIZE};
+
+/// @brief Largest UDP payload without IP fragmentation (MTU 1500).
+constexpr size_t UDP_MAX_PAYLOAD{1500U - IPV4_HEADER_SIZE - UDP_HEADER_SIZE};
+
+
+/// @brief Read a 16 bit value in network byte order.
+inline uint16_t Load16(const uint8_t* p)
+{
+    return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8U) | p[1]);
+}
+
+/// @brief Read a 32 bit value in network byte order.
+inline uint32_t Load32(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24U) | (static_cast<uint32_t>(p[1]) << 16U) |
+           (static_cast<uint32_t>(p[2]) << 8U) | p[3];
+}
+
+/// @brief Write a 16 bit value in network byte order.
+inline void Store16(uint8_t* p, uint16_t value)
+{
+    p[0] = static_cast<uint8_t>(value >> 8U);
+    p[1] = static_cast<uint8_t>(value);
+}
+
+/// @brief Write a 32 bit value in network byte order.
+inline void Store32(uint8_t* p, uint32_t value)
+{
+    p[0] = static_cast<uint8_t>(value >> 24U);
+    p[1] = static_cast<uint8_t>(value >> 16U);
+    p[2] = static_cast<uint8_t>(value >> 8U);
+    p[3] = static_cast<uint8_t>(value);
+}
+
+} // end namespace Net
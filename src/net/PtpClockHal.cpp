@@ -0,0 +1,139 @@
+/**
+ ********************************************************************************
+ * @file        PtpClockHal.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, ETH MAC system time implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "PtpClockHal.hpp"
+
+using namespace Net;
+
+namespace {
+
+constexpr uint64_t NS_PER_SECOND{1000000000U};
+
+/// @brief Register polls until an update request counts as lost.
+constexpr uint32_t UPDATE_POLLS{100000U};
+
+} // end anonymous namespace
+
+
+PtpClockHal::PtpClockHal(ETH_HandleTypeDef& heth)
+: mHeth(heth)
+{
+}
+
+
+Status PtpClockHal::Start(uint64_t startNs)
+{
+    const uint64_t updateRate = NS_PER_SECOND / SUBSECOND_INCREMENT_NS;
+    const uint64_t hclk = HAL_RCC_GetHCLKFreq();
+    if (hclk <= updateRate)
+    {
+        return Status::HW_ERROR;
+    }
+    mAddend = static_cast<uint32_t>((updateRate << 32U) / hclk);
+
+    ETH_PTP_ConfigTypeDef config{};
+    config.Timestamp = ENABLE;
+    config.TimestampUpdateMode = ENABLE;        // fine update, the addend sets the frequency
+    config.TimestampAddendUpdate = ENABLE;
+    config.TimestampRolloverMode = ENABLE;      // digital rollover, the sub seconds are ns
+    config.TimestampV2 = ENABLE;
+    config.TimestampIPv4 = ENABLE;
+    config.TimestampEvent = ENABLE;             // Sync and Delay_Req
+    config.TimestampChecksumCorrection = ENABLE;
+    config.TimestampAddend = mAddend;
+    config.TimestampSubsecondInc = SUBSECOND_INCREMENT_NS << ETH_MACMACSSIR_SSINC_Pos;
+    if (HAL_ETH_PTP_SetConfig(&mHeth, &config) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+
+    // HAL_ETH_PTP_SetTime adds instead of setting, the initial time is loaded by TSINIT
+    if (!WaitIdle(ETH_MACTSCR_TSINIT | ETH_MACTSCR_TSUPDT))
+    {
+        return Status::HW_ERROR;
+    }
+    WRITE_REG(mHeth.Instance->MACSTSUR, static_cast<uint32_t>(startNs / NS_PER_SECOND));
+    WRITE_REG(mHeth.Instance->MACSTNUR, static_cast<uint32_t>(startNs % NS_PER_SECOND));
+    SET_BIT(mHeth.Instance->MACTSCR, ETH_MACTSCR_TSINIT);
+
+    ETH_MACFilterConfigTypeDef filter{};
+    (void)HAL_ETH_GetMACFilterConfig(&mHeth, &filter);
+    filter.PassAllMulticast = ENABLE;
+    if (HAL_ETH_SetMACFilterConfig(&mHeth, &filter) != HAL_OK)
+    {
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+uint64_t PtpClockHal::GetTimeNs() const
+{
+    ETH_TimeTypeDef time{};
+    uint32_t seconds{0U};
+    do
+    {
+        // read again if the seconds rolled over between the registers
+        (void)HAL_ETH_PTP_GetTime(&mHeth, &time);
+        seconds = READ_REG(mHeth.Instance->MACSTSR);
+    } while (seconds != time.Seconds);
+    return (static_cast<uint64_t>(time.Seconds) * NS_PER_SECOND) + time.NanoSeconds;
+}
+
+
+void PtpClockHal::StepTime(int64_t offsetNs)
+{
+    if ((offsetNs == 0) || !WaitIdle(ETH_MACTSCR_TSINIT | ETH_MACTSCR_TSUPDT))
+    {
+        return;
+    }
+    const uint64_t magnitude = (offsetNs < 0) ? static_cast<uint64_t>(-offsetNs) : static_cast<uint64_t>(offsetNs);
+    ETH_TimeTypeDef offset{};
+    offset.Seconds = static_cast<uint32_t>(magnitude / NS_PER_SECOND);
+    offset.NanoSeconds = static_cast<uint32_t>(magnitude % NS_PER_SECOND);
+    (void)HAL_ETH_PTP_AddTimeOffset(&mHeth, (offsetNs < 0) ? HAL_ETH_PTP_NEGATIVE_UPDATE : HAL_ETH_PTP_POSITIVE_UPDATE,
+                                    &offset);
+}
+
+
+void PtpClockHal::SetFrequency(int32_t ppb)
+{
+    if (ppb > MAX_PPB)
+    {
+        ppb = MAX_PPB;
+    }
+    else if (ppb < -MAX_PPB)
+    {
+        ppb = -MAX_PPB;
+    }
+    const int64_t delta = (static_cast<int64_t>(mAddend) * ppb) / static_cast<int64_t>(NS_PER_SECOND);
+    if (!WaitIdle(ETH_MACTSCR_TSADDREG))
+    {
+        return;
+    }
+    WRITE_REG(mHeth.Instance->MACTSAR, static_cast<uint32_t>(static_cast<int64_t>(mAddend) + delta));
+    SET_BIT(mHeth.Instance->MACTSCR, ETH_MACTSCR_TSADDREG);
+}
+
+
+bool PtpClockHal::WaitIdle(uint32_t bits) const
+{
+    for (uint32_t i = 0U; i < UPDATE_POLLS; i++)
+    {
+        if (READ_BIT(mHeth.Instance->MACTSCR, bits) == 0U)
+        {
+            return true;
+        }
+    }
+    return false;
+}
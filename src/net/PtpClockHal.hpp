@@ -0,0 +1,94 @@
+/**
+ ********************************************************************************
+ * @file        PtpClockHal.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, IEEE 1588 system time of the ETH MAC through HAL_ETH_PTP.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IPtpClock.hpp"
+#include "NetTypes.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace Net {
+
+
+/**
+ * @brief   This class provides the IPtpClock on the time stamp unit of the ETH MAC.
+ * @details The system time runs in fine update mode: an accumulator adds @ref GetAddend on every
+ *          HCLK cycle and the time advances by @ref SUBSECOND_INCREMENT_NS on each overflow. The
+ *          nominal addend makes the overflows come at 1 / SUBSECOND_INCREMENT_NS, a frequency
+ *          correction scales it with a resolution of about 1 ppb. Steps use the update registers
+ *          (HAL_ETH_PTP_AddTimeOffset).\n
+ *          The MAC stamps PTPv2 event messages over UDP/IPv4, EthDeviceHal hands the stamps over
+ *          in PacketBuffer::timestamp.
+ * @note    Start it after EthDeviceHal::Start, HAL_ETH_Init resets the MAC. HCLK must be above
+ *          50 MHz. Multicast frames are passed by the MAC filter, PTP uses the group 224.0.1.129.
+ *  - - -
+ *
+ * __Thread safety:__
+ * GetTimeNs may be called from threads and ISR's.\n
+ * The adjustments must be called from one context.
+ *
+ */
+class PtpClockHal : public IPtpClock
+{
+    public:
+
+        /// @brief Time increment per accumulator overflow, 20 ns give a 50 MHz update rate.
+        static constexpr uint32_t SUBSECOND_INCREMENT_NS{20U};
+
+        /// @brief Limit of the frequency correction.
+        static constexpr int32_t MAX_PPB{500000};
+
+        /**
+         * @brief   Constructs the clock.
+         *
+         * @param   heth    The ETH handle of the started EthDeviceHal.
+         */
+        explicit PtpClockHal(ETH_HandleTypeDef& heth);
+
+        PtpClockHal(PtpClockHal const &) = delete;             //!< Copy constructor
+        PtpClockHal& operator=(PtpClockHal const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Configure the time stamping and initialise the time.
+         *
+         * @param   startNs Initial time.
+         *
+         * @return  OK or HW_ERROR.
+         */
+        Status Start(uint64_t startNs);
+
+        /// @copydoc Utils::ITimeSource::GetTimeNs
+        uint64_t GetTimeNs() const override;
+
+        /// @copydoc IPtpClock::StepTime
+        void StepTime(int64_t offsetNs) override;
+
+        /// @copydoc IPtpClock::SetFrequency
+        void SetFrequency(int32_t ppb) override;
+
+        /// @brief Nominal addend for the current HCLK.
+        uint32_t GetAddend() const {return mAddend;};
+
+    private:
+
+        /// @brief Wait until the MAC took over a previous update request.
+        bool WaitIdle(uint32_t bits) const;
+
+        /// @brief The ETH handle.
+        ETH_HandleTypeDef& mHeth;
+
+        /// @brief Nominal addend.
+        uint32_t mAddend{0U};
+};
+
+} // end namespace Net
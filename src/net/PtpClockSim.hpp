@@ -0,0 +1,98 @@
+/**
+ ********************************************************************************
+ * @file        PtpClockSim.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, host simulation of a drifting PTP hardware clock.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IPtpClock.hpp"
+namespace Net {
+
+
+/**
+ * @brief   This class provides an IPtpClock which runs on a shared simulated true time.
+ * @details The oscillator deviates from the true time by a constant drift, the frequency correction
+ *          of the servo is added to it. Several clocks on the same true time model the nodes of a
+ *          network, so offsets and path delays are exact and a test can compare the clocks directly.
+ *          The time is rebased on every adjustment, the integer math stays exact for long runs.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class PtpClockSim : public IPtpClock
+{
+    public:
+
+        /**
+         * @brief   Constructs the clock.
+         *
+         * @param   trueTimeNs  The simulated true time, advanced by the caller.
+         * @param   startNs     Clock time at the current true time.
+         * @param   driftPpb    Deviation of the oscillator in parts per billion.
+         */
+        PtpClockSim(const uint64_t& trueTimeNs, uint64_t startNs, int32_t driftPpb)
+        : mTrueTimeNs(trueTimeNs)
+        , mBaseTrueNs(trueTimeNs)
+        , mBaseNs(startNs)
+        , mDriftPpb(driftPpb)
+        {
+        }
+
+        /// @copydoc Utils::ITimeSource::GetTimeNs
+        uint64_t GetTimeNs() const override
+        {
+            const int64_t elapsed = static_cast<int64_t>(mTrueTimeNs - mBaseTrueNs);
+            const int64_t rate = static_cast<int64_t>(mDriftPpb) + mFrequencyPpb;
+            return mBaseNs + static_cast<uint64_t>(elapsed + ((elapsed * rate) / 1000000000));
+        }
+
+        /// @copydoc IPtpClock::StepTime
+        void StepTime(int64_t offsetNs) override
+        {
+            Rebase();
+            mBaseNs += static_cast<uint64_t>(offsetNs);
+            mStepCount++;
+        }
+
+        /// @copydoc IPtpClock::SetFrequency
+        void SetFrequency(int32_t ppb) override
+        {
+            Rebase();
+            mFrequencyPpb = ppb;
+        }
+
+        /// @brief Current frequency correction.
+        int32_t GetFrequency() const {return mFrequencyPpb;};
+
+        /// @brief Count of steps since construction.
+        uint32_t GetStepCount() const {return mStepCount;};
+
+    private:
+
+        /// @brief Take the current time as new base, so the next rate applies from now on.
+        void Rebase()
+        {
+            mBaseNs = GetTimeNs();
+            mBaseTrueNs = mTrueTimeNs;
+        }
+
+        const uint64_t& mTrueTimeNs;    //!< Shared true time
+        uint64_t mBaseTrueNs;           //!< True time of the base
+        uint64_t mBaseNs;               //!< Clock time at the base
+        int32_t mDriftPpb;              //!< Oscillator deviation
+        int32_t mFrequencyPpb{0};       //!< Correction of the servo
+        uint32_t mStepCount{0U};        //!< Steps
+};
+
+} // end namespace Net
@@ -0,0 +1,173 @@
+/**
+ ********************************************************************************
+ * @file        PtpMasterSim.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, PTP master simulation implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "PtpMasterSim.hpp"
+#include <cstring>
+
+using namespace Net;
+
+namespace {
+
+/// @brief logMessageInterval of messages without interval.
+constexpr uint8_t NO_INTERVAL{0x7FU};
+
+} // end anonymous namespace
+
+
+PtpMasterSim::PtpMasterSim(UdpStack& stack, PacketPool& pool, const Utils::ITimeSource& clock, const MacAddress& mac,
+                           uint32_t intervalMs, uint8_t domain)
+: mStack(stack)
+, mPool(pool)
+, mClock(clock)
+, mPortId(MakePtpPortId(mac, 1U))
+, mIntervalMs(intervalMs)
+, mDomain(domain)
+{
+}
+
+
+PtpMasterSim::~PtpMasterSim()
+{
+    Stop();
+}
+
+
+Status PtpMasterSim::Start()
+{
+    if (mStarted)
+    {
+        return Status::OK;
+    }
+    const Status status = mStack.Bind(PTP_EVENT_PORT, *this);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    (void)mStack.OpenFlow(mEventFlow, Utils::IpAddressV4(PTP_PRIMARY_GROUP), PTP_EVENT_PORT, PTP_EVENT_PORT);
+    (void)mStack.OpenFlow(mGeneralFlow, Utils::IpAddressV4(PTP_PRIMARY_GROUP), PTP_GENERAL_PORT, PTP_GENERAL_PORT);
+    mSyncDue = true;
+    mStarted = true;
+    return Status::OK;
+}
+
+
+void PtpMasterSim::Stop()
+{
+    if (!mStarted)
+    {
+        return;
+    }
+    mStack.Unbind(PTP_EVENT_PORT);
+    (void)mPool.Free(mpSync);
+    mpSync = nullptr;
+    mStarted = false;
+}
+
+
+void PtpMasterSim::Poll(uint32_t nowMs)
+{
+    if (!mStarted)
+    {
+        return;
+    }
+    if ((mpSync != nullptr) && (mpSync->timestamp != 0U))
+    {
+        const uint64_t t1 = mpSync->timestamp;
+        (void)mPool.Free(mpSync);
+        mpSync = nullptr;
+        SendFollowUp(t1);
+    }
+    if (mSyncDue || ((nowMs - mLastSyncMs) >= mIntervalMs))
+    {
+        mSyncDue = false;
+        mLastSyncMs = nowMs;
+        SendSync();
+    }
+}
+
+
+void PtpMasterSim::OnDatagram(const UdpEndpoint& from, uint16_t localPort, PacketBuffer& payload)
+{
+    (void)from;
+    (void)localPort;
+    const uint8_t* pRequest = payload.pPayload;
+    if ((payload.length < PTP_SYNC_SIZE) || ((pRequest[PTP_TYPE_OFFSET] & 0x0FU) != PTP_DELAY_REQ) ||
+        (pRequest[PTP_DOMAIN_OFFSET] != mDomain) || (payload.timestamp == 0U))
+    {
+        return;
+    }
+
+    PacketBuffer* pDatagram = mStack.AllocDatagram();
+    if (pDatagram == nullptr)
+    {
+        return;
+    }
+    uint8_t* pMessage = pDatagram->pPayload;
+    StorePtpHeader(pMessage, PTP_DELAY_RESP, PTP_DELAY_RESP_SIZE, mDomain, 0U, mPortId,
+                   Load16(&pRequest[PTP_SEQUENCE_OFFSET]), NO_INTERVAL);
+    StorePtpTimestamp(&pMessage[PTP_TIMESTAMP_OFFSET], payload.timestamp);
+    std::memcpy(&pMessage[PTP_REQUESTING_PORT_OFFSET], &pRequest[PTP_SOURCE_OFFSET], PTP_PORT_ID_SIZE);
+    pDatagram->length = PTP_DELAY_RESP_SIZE;
+    pDatagram->totalLength = PTP_DELAY_RESP_SIZE;
+    if (mStack.Send(mGeneralFlow, *pDatagram) == Status::OK)
+    {
+        mDelayRespCount++;
+    }
+    (void)mPool.Free(pDatagram);
+}
+
+
+void PtpMasterSim::SendSync()
+{
+    // a Sync whose timestamp never came gets no Follow_Up
+    (void)mPool.Free(mpSync);
+    mpSync = nullptr;
+
+    PacketBuffer* pDatagram = mStack.AllocDatagram();
+    if (pDatagram == nullptr)
+    {
+        return;
+    }
+    mSyncSequence++;
+    uint8_t* pMessage = pDatagram->pPayload;
+    StorePtpHeader(pMessage, PTP_SYNC, PTP_SYNC_SIZE, mDomain, PTP_FLAG_TWO_STEP, mPortId, mSyncSequence, 0U);
+    StorePtpTimestamp(&pMessage[PTP_TIMESTAMP_OFFSET], mClock.GetTimeNs());
+    pDatagram->length = PTP_SYNC_SIZE;
+    pDatagram->totalLength = PTP_SYNC_SIZE;
+    pDatagram->txTimestamp = true;
+
+    if (mStack.Send(mEventFlow, *pDatagram) != Status::OK)
+    {
+        (void)mPool.Free(pDatagram);
+        return;
+    }
+    mpSync = pDatagram;
+    mSyncCount++;
+}
+
+
+void PtpMasterSim::SendFollowUp(uint64_t t1)
+{
+    PacketBuffer* pDatagram = mStack.AllocDatagram();
+    if (pDatagram == nullptr)
+    {
+        return;
+    }
+    uint8_t* pMessage = pDatagram->pPayload;
+    StorePtpHeader(pMessage, PTP_FOLLOW_UP, PTP_SYNC_SIZE, mDomain, 0U, mPortId, mSyncSequence, 0U);
+    StorePtpTimestamp(&pMessage[PTP_TIMESTAMP_OFFSET], t1);
+    pDatagram->length = PTP_SYNC_SIZE;
+    pDatagram->totalLength = PTP_SYNC_SIZE;
+    (void)mStack.Send(mGeneralFlow, *pDatagram);
+    (void)mPool.Free(pDatagram);
+}
@@ -0,0 +1,109 @@
+/**
+ ********************************************************************************
+ * @file        PtpMasterSim.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, minimal two-step PTP master for host tests of the slave.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ITimeSource.hpp"
+#include "PtpProtocol.hpp"
+#include "UdpStack.hpp"
+namespace Net {
+
+
+/**
+ * @brief   This class provides the master side of the PTP end-to-end exchange.
+ * @details Sends a two-step Sync in each interval, the Follow_Up carries the TX timestamp of the
+ *          Sync as soon as the device delivered it. Delay_Req of any slave is answered with its RX
+ *          timestamp. Run it on an EthDeviceSim with a PtpClockSim against a PtpSlave to test the
+ *          servo on the host. There is no Announce, the slave does not need one.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * Poll must be called from the context which polls the UdpStack, right after UdpStack::Poll.
+ *
+ */
+class PtpMasterSim : private UdpStack::IListener
+{
+    public:
+
+        /**
+         * @brief   Constructs the master.
+         *
+         * @param   stack       The UDP stack on the timestamping device.
+         * @param   pool        The pool of the device.
+         * @param   clock       The clock of the device, used for the preliminary Sync timestamp.
+         * @param   mac         Own hardware address, the base of the clock identity.
+         * @param   intervalMs  Sync interval.
+         * @param   domain      PTP domain number.
+         */
+        PtpMasterSim(UdpStack& stack, PacketPool& pool, const Utils::ITimeSource& clock, const MacAddress& mac,
+                     uint32_t intervalMs = 1000U, uint8_t domain = 0U);
+
+        /// @brief Destructor, stops the master.
+        ~PtpMasterSim();
+
+        PtpMasterSim(PtpMasterSim const &) = delete;             //!< Copy constructor
+        PtpMasterSim& operator=(PtpMasterSim const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Bind the event port and open the multicast flows.
+         *
+         * @return  OK or the error of UdpStack::Bind.
+         */
+        Status Start();
+
+        /// @brief Unbind the port and drop a pending Sync.
+        void Stop();
+
+        /**
+         * @brief   Send the Follow_Up of a stamped Sync and the next Sync when the interval expired.
+         *
+         * @param   nowMs   Millisecond time base, the same as for UdpStack::Poll.
+         */
+        void Poll(uint32_t nowMs);
+
+        /// @brief Sent Sync messages.
+        uint32_t GetSyncCount() const {return mSyncCount;};
+
+        /// @brief Answered delay requests.
+        uint32_t GetDelayRespCount() const {return mDelayRespCount;};
+
+    private:
+
+        /// @copydoc UdpStack::IListener::OnDatagram
+        void OnDatagram(const UdpEndpoint& from, uint16_t localPort, PacketBuffer& payload) override;
+
+        void SendSync();
+
+        void SendFollowUp(uint64_t t1);
+
+        UdpStack& mStack;
+        PacketPool& mPool;
+        const Utils::ITimeSource& mClock;
+        PtpPortId mPortId;
+        uint32_t mIntervalMs;
+        uint8_t mDomain;
+        UdpFlow mEventFlow;                 //!< Sync to the event port of the group
+        UdpFlow mGeneralFlow;               //!< Follow_Up and Delay_Resp to the general port
+        bool mStarted{false};
+
+        PacketBuffer* mpSync{nullptr};      //!< Sent Sync until its TX timestamp arrives
+        uint16_t mSyncSequence{0U};
+        uint32_t mLastSyncMs{0U};
+        bool mSyncDue{true};
+
+        uint32_t mSyncCount{0U};
+        uint32_t mDelayRespCount{0U};
+};
+
+} // end namespace Net
@@ -0,0 +1,125 @@
+/**
+ ********************************************************************************
+ * @file        PtpProtocol.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, message layouts of IEEE 1588-2008 (PTPv2) over UDP/IPv4.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "Protocol.hpp"
+namespace Net {
+
+
+// UDP ports and the default multicast group (224.0.1.129)
+constexpr uint16_t PTP_EVENT_PORT{319U};
+constexpr uint16_t PTP_GENERAL_PORT{320U};
+constexpr uint32_t PTP_PRIMARY_GROUP{0xE0000181U};
+
+// message types (low nibble of the first byte)
+constexpr uint8_t PTP_SYNC{0x0U};
+constexpr uint8_t PTP_DELAY_REQ{0x1U};
+constexpr uint8_t PTP_FOLLOW_UP{0x8U};
+constexpr uint8_t PTP_DELAY_RESP{0x9U};
+
+// common header, offsets from the start of the message
+constexpr size_t PTP_HEADER_SIZE{34U};
+constexpr size_t PTP_TYPE_OFFSET{0U};
+constexpr size_t PTP_VERSION_OFFSET{1U};
+constexpr size_t PTP_LENGTH_OFFSET{2U};
+constexpr size_t PTP_DOMAIN_OFFSET{4U};
+constexpr size_t PTP_FLAGS_OFFSET{6U};
+constexpr size_t PTP_CORRECTION_OFFSET{8U};
+constexpr size_t PTP_SOURCE_OFFSET{20U};
+constexpr size_t PTP_SEQUENCE_OFFSET{30U};
+constexpr size_t PTP_CONTROL_OFFSET{32U};
+constexpr size_t PTP_INTERVAL_OFFSET{33U};
+constexpr uint8_t PTP_VERSION{2U};
+constexpr uint16_t PTP_FLAG_TWO_STEP{0x0200U};
+
+/// @brief Size of a port identity: clock identity (EUI-64) and port number.
+constexpr size_t PTP_PORT_ID_SIZE{10U};
+
+// bodies: one timestamp behind the header, Delay_Resp adds the requesting port
+constexpr size_t PTP_TIMESTAMP_OFFSET{PTP_HEADER_SIZE};
+constexpr size_t PTP_TIMESTAMP_SIZE{10U};
+constexpr size_t PTP_REQUESTING_PORT_OFFSET{PTP_TIMESTAMP_OFFSET + PTP_TIMESTAMP_SIZE};
+constexpr size_t PTP_SYNC_SIZE{PTP_HEADER_SIZE + PTP_TIMESTAMP_SIZE};
+constexpr size_t PTP_DELAY_RESP_SIZE{PTP_REQUESTING_PORT_OFFSET + PTP_PORT_ID_SIZE};
+
+/// @brief Port identity of a PTP port.
+using PtpPortId = std::array<uint8_t, PTP_PORT_ID_SIZE>;
+
+
+/// @brief Port identity from the hardware address (EUI-48 to EUI-64) and a port number.
+inline PtpPortId MakePtpPortId(const MacAddress& mac, uint16_t port)
+{
+    return PtpPortId{mac[0], mac[1], mac[2], 0xFFU, 0xFEU, mac[3], mac[4], mac[5],
+                     static_cast<uint8_t>(port >> 8U), static_cast<uint8_t>(port)};
+}
+
+/// @brief Read a PTP timestamp (48 bit seconds, 32 bit nanoseconds) as nanoseconds.
+inline uint64_t LoadPtpTimestamp(const uint8_t* p)
+{
+    const uint64_t seconds = (static_cast<uint64_t>(Load16(p)) << 32U) | Load32(&p[2]);
+    return (seconds * 1000000000U) + Load32(&p[6]);
+}
+
+/// @brief Write nanoseconds as PTP timestamp.
+inline void StorePtpTimestamp(uint8_t* p, uint64_t ns)
+{
+    const uint64_t seconds = ns / 1000000000U;
+    Store16(p, static_cast<uint16_t>(seconds >> 32U));
+    Store32(&p[2], static_cast<uint32_t>(seconds));
+    Store32(&p[6], static_cast<uint32_t>(ns % 1000000000U));
+}
+
+/**
+ * @brief   Write a common header with a zero correction.
+ *
+ * @param   p           Start of the message.
+ * @param   type        Message type.
+ * @param   length      Message length.
+ * @param   domain      Domain number.
+ * @param   flags       Flag field.
+ * @param   source      Port identity of the sender.
+ * @param   sequence    Sequence id.
+ * @param   interval    logMessageInterval, 0x7F if not applicable.
+ */
+inline void StorePtpHeader(uint8_t* p, uint8_t type, uint16_t length, uint8_t domain, uint16_t flags,
+                           const PtpPortId& source, uint16_t sequence, uint8_t interval)
+{
+    // controlField of PTPv1 for the known messages, 5 (other) for the rest
+    static constexpr uint8_t CONTROL[] = {0U, 1U, 5U, 5U, 5U, 5U, 5U, 5U, 2U, 3U};
+    for (size_t i = 0U; i < PTP_HEADER_SIZE; i++)
+    {
+        p[i] = 0U;
+    }
+    p[PTP_TYPE_OFFSET] = type;
+    p[PTP_VERSION_OFFSET] = PTP_VERSION;
+    Store16(&p[PTP_LENGTH_OFFSET], length);
+    p[PTP_DOMAIN_OFFSET] = domain;
+    Store16(&p[PTP_FLAGS_OFFSET], flags);
+    for (size_t i = 0U; i < PTP_PORT_ID_SIZE; i++)
+    {
+        p[PTP_SOURCE_OFFSET + i] = source[i];
+    }
+    Store16(&p[PTP_SEQUENCE_OFFSET], sequence);
+    p[PTP_CONTROL_OFFSET] = (type < sizeof(CONTROL)) ? CONTROL[type] : 5U;
+    p[PTP_INTERVAL_OFFSET] = interval;
+}
+
+/// @brief Read the correction field (ns scaled by 2^16) as nanoseconds.
+inline int64_t LoadPtpCorrection(const uint8_t* p)
+{
+    const uint64_t raw = (static_cast<uint64_t>(Load32(p)) << 32U) | Load32(&p[4]);
+    return static_cast<int64_t>(raw) / 65536;
+}
+
+} // end namespace Net
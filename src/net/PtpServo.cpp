@@ -0,0 +1,94 @@
+/**
+ ********************************************************************************
+ * @file        PtpServo.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, PI clock servo implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "PtpServo.hpp"
+#include <cmath>
+#include <cstdlib>
+
+using namespace Net;
+
+
+PtpServo::PtpServo(const Config& config)
+: mConfig(config)
+{
+}
+
+
+PtpServo::State PtpServo::Sample(int64_t offsetNs, uint64_t localNs, int32_t& ppb)
+{
+    const double offset = static_cast<double>(offsetNs);
+
+    if (mCount == 0U)
+    {
+        mLastOffsetNs = offsetNs;
+        mLastLocalNs = localNs;
+        mCount = 1U;
+        return State::UNLOCKED;
+    }
+
+    if (mCount == 1U)
+    {
+        if (localNs <= mLastLocalNs)
+        {
+            // a second sample of the same time says nothing about the frequency
+            mLastOffsetNs = offsetNs;
+            mLastLocalNs = localNs;
+            return State::UNLOCKED;
+        }
+        // the offset grows by the remaining frequency error of the oscillator
+        const double interval = static_cast<double>(localNs - mLastLocalNs);
+        mDrift = Clamp(mDrift + ((offset - static_cast<double>(mLastOffsetNs)) * 1.0e9 / interval));
+        mCount = 2U;
+        ppb = static_cast<int32_t>(std::lround(-mDrift));
+        return (std::llabs(offsetNs) > mConfig.stepThresholdNs) ? State::JUMP : State::LOCKED;
+    }
+
+    if (std::llabs(offsetNs) > mConfig.stepThresholdNs)
+    {
+        // lost the lock (master changed its time), estimate again
+        Reset();
+        return Sample(offsetNs, localNs, ppb);
+    }
+
+    const double kiTerm = static_cast<double>(mConfig.ki) * offset;
+    const double correction = (static_cast<double>(mConfig.kp) * offset) + mDrift + kiTerm;
+    const double limited = Clamp(correction);
+    if (limited == correction)
+    {
+        // anti windup: the integral only grows while the output is in range
+        mDrift += kiTerm;
+    }
+    ppb = static_cast<int32_t>(std::lround(-limited));
+    return State::LOCKED;
+}
+
+
+void PtpServo::Reset()
+{
+    mCount = 0U;
+}
+
+
+double PtpServo::Clamp(double ppb) const
+{
+    const double limit = static_cast<double>(mConfig.maxPpb);
+    if (ppb > limit)
+    {
+        return limit;
+    }
+    if (ppb < -limit)
+    {
+        return -limit;
+    }
+    return ppb;
+}
@@ -0,0 +1,97 @@
+/**
+ ********************************************************************************
+ * @file        PtpServo.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, PI servo which disciplines a clock to the offsets of a PTP master.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+namespace Net {
+
+
+/**
+ * @brief   This class provides the proportional-integral clock servo of a PTP slave.
+ * @details The first two samples estimate the frequency error of the oscillator, a large offset is
+ *          then removed by one step. From the third sample on the servo is locked and corrects the
+ *          offset by the frequency only: the proportional part removes the offset within the next
+ *          intervals, the integral part follows the slow drift of the oscillator (temperature).
+ *          The gains are those of linuxptp for hardware timestamps at 1 s sync interval
+ *          (kp + ki = 1 settles a constant drift after one sample). An offset above the step
+ *          threshold in locked state unlocks the servo and starts a new estimation.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.
+ *
+ */
+class PtpServo
+{
+    public:
+
+        /// @brief Tuning of the servo.
+        struct Config
+        {
+            float kp{0.7F};                     //!< Proportional gain, ppb per ns offset
+            float ki{0.3F};                     //!< Integral gain, ppb per ns offset and sample
+            int64_t stepThresholdNs{20000};     //!< Larger offsets are stepped
+            int32_t maxPpb{500000};             //!< Limit of the frequency correction
+        };
+
+        /// @brief Result of a sample.
+        enum class State : uint8_t
+        {
+            UNLOCKED=0,     //!< Estimation is running, the clock is not adjusted
+            JUMP=1,         //!< Step the clock by -offset and set the frequency
+            LOCKED=2        //!< Set the frequency
+        };
+
+        /**
+         * @brief   Constructs an unlocked servo.
+         *
+         * @param   config  The tuning.
+         */
+        explicit PtpServo(const Config& config);
+
+        /**
+         * @brief   Process one offset measurement.
+         *
+         * @param   offsetNs    Slave time minus master time.
+         * @param   localNs     Slave time of the measurement.
+         * @param   ppb         Out: frequency correction of the clock, valid for JUMP and LOCKED.
+         *
+         * @return  What the caller has to do with the clock.
+         */
+        State Sample(int64_t offsetNs, uint64_t localNs, int32_t& ppb);
+
+        /**
+         * @brief   Restart the estimation, the frequency estimate is kept.
+         */
+        void Reset();
+
+        /// @brief The servo is locked.
+        bool IsLocked() const {return mCount >= 2U;};
+
+        /// @brief Estimated frequency error of the oscillator in ppb.
+        double GetDrift() const {return mDrift;};
+
+    private:
+
+        /// @brief Limit a correction to the configured range.
+        double Clamp(double ppb) const;
+
+        Config mConfig;                 //!< Tuning
+        double mDrift{0.0};             //!< Integral part, the correction for the oscillator error
+        int64_t mLastOffsetNs{0};       //!< Offset of the first sample
+        uint64_t mLastLocalNs{0U};      //!< Time of the first sample
+        uint8_t mCount{0U};             //!< Samples since reset, saturating at 2
+};
+
+} // end namespace Net
@@ -0,0 +1,293 @@
+/**
+ ********************************************************************************
+ * @file        PtpSlave.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, PTP slave implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "PtpSlave.hpp"
+#include <cstring>
+
+using namespace Net;
+
+namespace {
+
+/// @brief logMessageInterval of messages without interval.
+constexpr uint8_t NO_INTERVAL{0x7FU};
+
+} // end anonymous namespace
+
+
+PtpSlave::PtpSlave(UdpStack& stack, PacketPool& pool, IPtpClock& clock, const MacAddress& mac, uint8_t domain,
+                   const PtpServo::Config& config)
+: mStack(stack)
+, mPool(pool)
+, mClock(clock)
+, mServo(config)
+, mPortId(MakePtpPortId(mac, 1U))
+, mDomain(domain)
+{
+}
+
+
+PtpSlave::~PtpSlave()
+{
+    Stop();
+}
+
+
+Status PtpSlave::Start()
+{
+    if (mStarted)
+    {
+        return Status::OK;
+    }
+    Status status = mStack.Bind(PTP_EVENT_PORT, *this);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    status = mStack.Bind(PTP_GENERAL_PORT, *this);
+    if (status != Status::OK)
+    {
+        mStack.Unbind(PTP_EVENT_PORT);
+        return status;
+    }
+    (void)mStack.OpenFlow(mFlow, Utils::IpAddressV4(PTP_PRIMARY_GROUP), PTP_EVENT_PORT, PTP_EVENT_PORT);
+    mStarted = true;
+    return Status::OK;
+}
+
+
+void PtpSlave::Stop()
+{
+    if (!mStarted)
+    {
+        return;
+    }
+    mStack.Unbind(PTP_EVENT_PORT);
+    mStack.Unbind(PTP_GENERAL_PORT);
+    (void)mPool.Free(mpDelayReq);
+    mpDelayReq = nullptr;
+    mHasMaster = false;
+    mStarted = false;
+}
+
+
+void PtpSlave::Poll(uint32_t nowMs)
+{
+    mNowMs = nowMs;
+    TakeTxTimestamp();
+
+    if (mHasMaster && ((nowMs - mLastSyncMs) > SYNC_TIMEOUT_MS))
+    {
+        // the clock runs free with the last frequency until a master shows up
+        mHasMaster = false;
+        mWaitFollowUp = false;
+        mPathDelayValid = false;
+        mServo.Reset();
+    }
+}
+
+
+void PtpSlave::OnDatagram(const UdpEndpoint& from, uint16_t localPort, PacketBuffer& payload)
+{
+    (void)from;
+    (void)localPort;
+    const uint8_t* pMessage = payload.pPayload;
+    if ((payload.length < PTP_HEADER_SIZE) || ((pMessage[PTP_VERSION_OFFSET] & 0x0FU) != PTP_VERSION) ||
+        (pMessage[PTP_DOMAIN_OFFSET] != mDomain) || (Load16(&pMessage[PTP_LENGTH_OFFSET]) > payload.length))
+    {
+        return;
+    }
+
+    const uint8_t type = pMessage[PTP_TYPE_OFFSET] & 0x0FU;
+    const size_t length = Load16(&pMessage[PTP_LENGTH_OFFSET]);
+    const bool fromMaster = mHasMaster &&
+                            (std::memcmp(&pMessage[PTP_SOURCE_OFFSET], mMasterId.data(), PTP_PORT_ID_SIZE) == 0);
+
+    if ((type == PTP_SYNC) && (length >= PTP_SYNC_SIZE))
+    {
+        if (!mHasMaster)
+        {
+            std::memcpy(mMasterId.data(), &pMessage[PTP_SOURCE_OFFSET], PTP_PORT_ID_SIZE);
+            mHasMaster = true;
+            mLastSyncMs = mNowMs;
+        }
+        else if (!fromMaster)
+        {
+            return;
+        }
+        HandleSync(pMessage, payload.timestamp);
+    }
+    else if ((type == PTP_FOLLOW_UP) && (length >= PTP_SYNC_SIZE) && fromMaster)
+    {
+        HandleFollowUp(pMessage);
+    }
+    else if ((type == PTP_DELAY_RESP) && (length >= PTP_DELAY_RESP_SIZE) && fromMaster)
+    {
+        HandleDelayResp(pMessage);
+    }
+    else
+    {
+        // Announce, Delay_Req of other slaves, other masters
+    }
+}
+
+
+void PtpSlave::HandleSync(const uint8_t* pMessage, uint64_t rxTimestamp)
+{
+    mWaitFollowUp = false;
+    if (rxTimestamp == 0U)
+    {
+        // the MAC missed the snapshot, no sample this interval
+        return;
+    }
+    const int64_t correction = LoadPtpCorrection(&pMessage[PTP_CORRECTION_OFFSET]);
+    if ((Load16(&pMessage[PTP_FLAGS_OFFSET]) & PTP_FLAG_TWO_STEP) != 0U)
+    {
+        mSyncSequence = Load16(&pMessage[PTP_SEQUENCE_OFFSET]);
+        mSyncRxNs = rxTimestamp;
+        mSyncCorrectionNs = correction;
+        mWaitFollowUp = true;
+        return;
+    }
+    const uint64_t t1 = LoadPtpTimestamp(&pMessage[PTP_TIMESTAMP_OFFSET]) + static_cast<uint64_t>(correction);
+    ProcessSync(t1, rxTimestamp);
+}
+
+
+void PtpSlave::HandleFollowUp(const uint8_t* pMessage)
+{
+    if (!mWaitFollowUp || (Load16(&pMessage[PTP_SEQUENCE_OFFSET]) != mSyncSequence))
+    {
+        return;
+    }
+    mWaitFollowUp = false;
+    const int64_t correction = mSyncCorrectionNs + LoadPtpCorrection(&pMessage[PTP_CORRECTION_OFFSET]);
+    const uint64_t t1 = LoadPtpTimestamp(&pMessage[PTP_TIMESTAMP_OFFSET]) + static_cast<uint64_t>(correction);
+    ProcessSync(t1, mSyncRxNs);
+}
+
+
+void PtpSlave::HandleDelayResp(const uint8_t* pMessage)
+{
+    if ((Load16(&pMessage[PTP_SEQUENCE_OFFSET]) != mDelayReqSequence) ||
+        (std::memcmp(&pMessage[PTP_REQUESTING_PORT_OFFSET], mPortId.data(), PTP_PORT_ID_SIZE) != 0))
+    {
+        return;
+    }
+    TakeTxTimestamp();
+    if ((mDelayReqT3 == 0U) || (mDelayReqSteps != mStepCount))
+    {
+        return;
+    }
+
+    const int64_t correction = LoadPtpCorrection(&pMessage[PTP_CORRECTION_OFFSET]);
+    const uint64_t t4 = LoadPtpTimestamp(&pMessage[PTP_TIMESTAMP_OFFSET]) - static_cast<uint64_t>(correction);
+    // the offset is in both differences with opposite sign and cancels out
+    const int64_t masterToSlave = static_cast<int64_t>(mDelayReqT2 - mDelayReqT1);
+    const int64_t slaveToMaster = static_cast<int64_t>(t4 - mDelayReqT3);
+    int64_t delay = (masterToSlave + slaveToMaster) / 2;
+    if (delay < 0)
+    {
+        delay = 0;
+    }
+    mDelayReqT3 = 0U;
+
+    if (!mPathDelayValid)
+    {
+        mPathDelayNs = delay;
+        mPathDelayValid = true;
+    }
+    else
+    {
+        mPathDelayNs += (delay - mPathDelayNs) / static_cast<int64_t>(1U << DELAY_FILTER_SHIFT);
+    }
+}
+
+
+void PtpSlave::ProcessSync(uint64_t t1, uint64_t t2)
+{
+    mLastSyncMs = mNowMs;
+    const uint32_t steps = mStepCount;
+
+    if (mPathDelayValid)
+    {
+        mOffsetNs = static_cast<int64_t>(t2 - t1) - mPathDelayNs;
+        mSampleCount++;
+        int32_t ppb = mFrequencyPpb;
+        switch (mServo.Sample(mOffsetNs, t2, ppb))
+        {
+            case PtpServo::State::JUMP:
+                mClock.StepTime(-mOffsetNs);
+                mStepCount++;
+                mClock.SetFrequency(ppb);
+                mFrequencyPpb = ppb;
+                break;
+            case PtpServo::State::LOCKED:
+                mClock.SetFrequency(ppb);
+                mFrequencyPpb = ppb;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (steps != mStepCount)
+    {
+        // t2 is on the old time base, the next Sync measures the delay
+        return;
+    }
+    mDelayReqT1 = t1;
+    mDelayReqT2 = t2;
+    SendDelayReq();
+}
+
+
+void PtpSlave::SendDelayReq()
+{
+    // a request without response is replaced
+    (void)mPool.Free(mpDelayReq);
+    mpDelayReq = nullptr;
+    mDelayReqT3 = 0U;
+
+    PacketBuffer* pDatagram = mStack.AllocDatagram();
+    if (pDatagram == nullptr)
+    {
+        return;
+    }
+    mDelayReqSequence++;
+    uint8_t* pMessage = pDatagram->pPayload;
+    StorePtpHeader(pMessage, PTP_DELAY_REQ, PTP_SYNC_SIZE, mDomain, 0U, mPortId, mDelayReqSequence, NO_INTERVAL);
+    StorePtpTimestamp(&pMessage[PTP_TIMESTAMP_OFFSET], mClock.GetTimeNs());
+    pDatagram->length = PTP_SYNC_SIZE;
+    pDatagram->totalLength = PTP_SYNC_SIZE;
+    pDatagram->txTimestamp = true;
+    mDelayReqSteps = mStepCount;
+
+    if (mStack.Send(mFlow, *pDatagram) != Status::OK)
+    {
+        (void)mPool.Free(pDatagram);
+        return;
+    }
+    // the reference is kept until the device wrote the TX timestamp
+    mpDelayReq = pDatagram;
+}
+
+
+void PtpSlave::TakeTxTimestamp()
+{
+    if ((mpDelayReq != nullptr) && (mpDelayReq->timestamp != 0U))
+    {
+        mDelayReqT3 = mpDelayReq->timestamp;
+        (void)mPool.Free(mpDelayReq);
+        mpDelayReq = nullptr;
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ ********************************************************************************
+ * @file        PtpSlave.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, IEEE 1588 ordinary clock in slave state over UDP/IPv4.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IPtpClock.hpp"
+#include "PtpProtocol.hpp"
+#include "PtpServo.hpp"
+#include "UdpStack.hpp"
+namespace Net {
+
+
+/**
+ * @brief   This class provides a PTP slave which disciplines the clock of the MAC to a master.
+ * @details Sync (one or two step) gives the master time t1 and the local receive time t2, the
+ *          Delay_Req sent after each Sync gives the local send time t3 and the master receive time
+ *          t4 (end-to-end delay mechanism). All times are hardware timestamps of the device
+ *          (PacketBuffer::timestamp), so the stack latency does not enter the result:\n
+ *          meanPathDelay = ((t2 - t1) + (t4 - t3)) / 2, offset = t2 - t1 - meanPathDelay.\n
+ *          The path delay is averaged, the offset drives the PtpServo which steps and trims the
+ *          clock. As time source the slave hands out the disciplined clock, give it to
+ *          Utils::Logger::SetTimeSource and to the sampling code to align the data of several nodes.
+ * @note    There is no best master clock algorithm: the slave follows the first master whose Sync
+ *          it receives in its domain and looks for a new one after @ref SYNC_TIMEOUT_MS without Sync.
+ *          Announce and management messages are ignored.
+ *  - - -
+ *
+ * __Thread safety:__
+ * GetTimeNs may be called from threads and ISR's.\n
+ * Poll must be called from the context which polls the UdpStack, right after UdpStack::Poll.
+ *
+ */
+class PtpSlave : public Utils::ITimeSource, private UdpStack::IListener
+{
+    public:
+
+        /// @brief Time without Sync after which the master is considered lost.
+        static constexpr uint32_t SYNC_TIMEOUT_MS{4000U};
+
+        /// @brief Weight of a new path delay measurement is 1 / 2^DELAY_FILTER_SHIFT.
+        static constexpr uint32_t DELAY_FILTER_SHIFT{3U};
+
+        /**
+         * @brief   Constructs the slave.
+         *
+         * @param   stack   The UDP stack on the timestamping device.
+         * @param   pool    The pool of the device.
+         * @param   clock   The clock which stamps the frames of the device.
+         * @param   mac     Own hardware address, the base of the clock identity.
+         * @param   domain  PTP domain number.
+         * @param   config  Tuning of the servo.
+         */
+        PtpSlave(UdpStack& stack, PacketPool& pool, IPtpClock& clock, const MacAddress& mac, uint8_t domain = 0U,
+                 const PtpServo::Config& config = PtpServo::Config{});
+
+        /// @brief Destructor, stops the slave.
+        ~PtpSlave() override;
+
+        PtpSlave(PtpSlave const &) = delete;             //!< Copy constructor
+        PtpSlave& operator=(PtpSlave const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Bind the PTP ports and open the multicast flow.
+         *
+         * @return  OK or the error of UdpStack::Bind.
+         */
+        Status Start();
+
+        /// @brief Unbind the ports and drop a pending delay request.
+        void Stop();
+
+        /**
+         * @brief   Collect the TX timestamp of the delay request and supervise the master.
+         *
+         * @param   nowMs   Millisecond time base, the same as for UdpStack::Poll.
+         */
+        void Poll(uint32_t nowMs);
+
+        /// @brief Time of the disciplined clock, the master time once locked.
+        uint64_t GetTimeNs() const override {return mClock.GetTimeNs();};
+
+        /// @brief The clock follows a master.
+        bool IsLocked() const {return mHasMaster && mServo.IsLocked();};
+
+        /// @brief Last measured offset to the master (slave minus master).
+        int64_t GetOffsetNs() const {return mOffsetNs;};
+
+        /// @brief Averaged mean path delay, 0 before the first measurement.
+        int64_t GetPathDelayNs() const {return mPathDelayNs;};
+
+        /// @brief Frequency correction of the clock.
+        int32_t GetFrequency() const {return mFrequencyPpb;};
+
+        /// @brief Offset samples given to the servo.
+        uint32_t GetSampleCount() const {return mSampleCount;};
+
+        /// @brief Own port identity.
+        const PtpPortId& GetPortId() const {return mPortId;};
+
+    private:
+
+        /// @copydoc UdpStack::IListener::OnDatagram
+        void OnDatagram(const UdpEndpoint& from, uint16_t localPort, PacketBuffer& payload) override;
+
+        void HandleSync(const uint8_t* pMessage, uint64_t rxTimestamp);
+
+        void HandleFollowUp(const uint8_t* pMessage);
+
+        void HandleDelayResp(const uint8_t* pMessage);
+
+        /// @brief A complete t1 / t2 pair: run the servo and measure the delay.
+        void ProcessSync(uint64_t t1, uint64_t t2);
+
+        void SendDelayReq();
+
+        /// @brief Take t3 from the sent delay request and release it.
+        void TakeTxTimestamp();
+
+        UdpStack& mStack;
+        PacketPool& mPool;
+        IPtpClock& mClock;
+        PtpServo mServo;
+        PtpPortId mPortId;
+        uint8_t mDomain;
+        UdpFlow mFlow;                      //!< Delay requests to the event port of the group
+        bool mStarted{false};
+
+        PtpPortId mMasterId{};              //!< Port identity of the followed master
+        bool mHasMaster{false};
+        uint32_t mNowMs{0U};
+        uint32_t mLastSyncMs{0U};
+
+        uint16_t mSyncSequence{0U};         //!< Sequence of the Sync which waits for its Follow_Up
+        bool mWaitFollowUp{false};
+        uint64_t mSyncRxNs{0U};             //!< t2 of the waiting Sync
+        int64_t mSyncCorrectionNs{0};       //!< Correction of the waiting Sync
+
+        PacketBuffer* mpDelayReq{nullptr};  //!< Sent delay request until its TX timestamp arrives
+        uint16_t mDelayReqSequence{0U};
+        uint64_t mDelayReqT1{0U};           //!< t1 / t2 of the Sync the request belongs to
+        uint64_t mDelayReqT2{0U};
+        uint64_t mDelayReqT3{0U};           //!< Send time, 0 until known
+        uint32_t mDelayReqSteps{0U};        //!< Step count at the request, a step in between spoils it
+
+        int64_t mPathDelayNs{0};
+        bool mPathDelayValid{false};
+        int64_t mOffsetNs{0};
+        int32_t mFrequencyPpb{0};
+        uint32_t mStepCount{0U};
+        uint32_t mSampleCount{0U};
+};
+
+} // end namespace Net
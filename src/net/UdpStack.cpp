@@ -0,0 +1,517 @@
+/**
+ ********************************************************************************
+ * @file        UdpStack.cpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, UDP/IPv4/ARP implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "UdpStack.hpp"
+#include "Checksum.hpp"
+#include <cstring>
+
+using namespace Net;
+
+namespace {
+
+constexpr uint32_t BROADCAST_ADDRESS{0xFFFFFFFFU};
+
+/// @brief Class D (224.0.0.0/4) addresses are multicast groups.
+constexpr bool IsMulticast(uint32_t address)
+{
+    return (address & 0xF0000000U) == 0xE0000000U;
+}
+
+/// @brief ARP header fields for IPv4 over ethernet: hardware type, protocol type, address sizes.
+constexpr uint16_t ARP_HARDWARE_ETHERNET{1U};
+constexpr uint8_t ARP_MAC_SIZE{6U};
+constexpr uint8_t ARP_IP_SIZE{4U};
+
+} // end anonymous namespace
+
+
+UdpStack::UdpStack(IEthDevice& device, PacketPool& pool, const MacAddress& mac, const Utils::IpAddressV4& address,
+                   const Utils::IpAddressV4& netmask, const Utils::IpAddressV4& gateway)
+: mDevice(device)
+, mPool(pool)
+, mMac(mac)
+, mAddress(address.GetValue())
+, mNetmask(netmask.GetValue())
+, mGateway(gateway.GetValue())
+{
+}
+
+
+Status UdpStack::OpenFlow(UdpFlow& flow, const Utils::IpAddressV4& remote, uint16_t remotePort, uint16_t localPort)
+{
+    flow = UdpFlow{};
+    const uint32_t destination = remote.GetValue();
+    if (destination == 0U)
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    const bool onLink = ((destination ^ mAddress) & mNetmask) == 0U;
+    const bool broadcast = (destination == BROADCAST_ADDRESS) || (onLink && ((destination | mNetmask) == BROADCAST_ADDRESS));
+    const bool multicast = IsMulticast(destination);
+    flow.nextHop = onLink ? destination : mGateway;
+    if (!broadcast && !multicast && (flow.nextHop == 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    uint8_t* pEth = flow.header.data();
+    std::memcpy(&pEth[ETH_SRC_OFFSET], mMac.data(), mMac.size());
+    Store16(&pEth[ETH_TYPE_OFFSET], ETH_TYPE_IPV4);
+
+    uint8_t* pIp = &pEth[ETH_HEADER_SIZE];
+    pIp[0] = 0x45U;     // version 4, 5 words
+    Store16(&pIp[IPV4_FRAGMENT_OFFSET], IPV4_DONT_FRAGMENT);
+    pIp[8] = IPV4_DEFAULT_TTL;
+    pIp[IPV4_PROTOCOL_OFFSET] = IPV4_PROTOCOL_UDP;
+    Store32(&pIp[IPV4_SRC_OFFSET], mAddress);
+    Store32(&pIp[IPV4_DST_OFFSET], destination);
+
+    uint8_t* pUdp = &pIp[IPV4_HEADER_SIZE];
+    Store16(&pUdp[UDP_SRC_PORT_OFFSET], localPort);
+    Store16(&pUdp[UDP_DST_PORT_OFFSET], remotePort);
+
+    // everything but length, identification and checksum is constant
+    flow.ipSum = Checksum::Add(0U, pIp, IPV4_HEADER_SIZE);
+    flow.udpSum = Checksum::Add(0U, &pIp[IPV4_SRC_OFFSET], 8U);
+    flow.udpSum = Checksum::AddValue(flow.udpSum, IPV4_PROTOCOL_UDP);
+    flow.udpSum = Checksum::Add(flow.udpSum, pUdp, 4U);
+    flow.open = true;
+
+    if (broadcast)
+    {
+        std::memcpy(&pEth[ETH_DST_OFFSET], MAC_BROADCAST.data(), MAC_BROADCAST.size());
+        flow.resolved = true;
+        return Status::OK;
+    }
+    if (multicast)
+    {
+        // RFC 1112: 01:00:5e and the low 23 bits of the group
+        const uint8_t group[] = {0x01U, 0x00U, 0x5EU, static_cast<uint8_t>((destination >> 16U) & 0x7FU),
+                                 static_cast<uint8_t>(destination >> 8U), static_cast<uint8_t>(destination)};
+        std::memcpy(&pEth[ETH_DST_OFFSET], group, sizeof(group));
+        flow.resolved = true;
+        return Status::OK;
+    }
+    if (Resolve(flow))
+    {
+        return Status::OK;
+    }
+
+    ArpEntry* pEntry = FindArp(flow.nextHop);
+    if (pEntry == nullptr)
+    {
+        LearnArp(flow.nextHop, nullptr, true);
+        pEntry = FindArp(flow.nextHop);
+    }
+    SendArpRequest(*pEntry, mNowMs);
+    return Status::UNRESOLVED;
+}
+
+
+PacketBuffer* UdpStack::AllocDatagram()
+{
+    PacketBuffer* pBuffer = mPool.Alloc();
+    if (pBuffer != nullptr)
+    {
+        pBuffer->pPayload = &pBuffer->data[HEADROOM];
+    }
+    return pBuffer;
+}
+
+
+Status UdpStack::Send(UdpFlow& flow, PacketBuffer& datagram)
+{
+    if (!flow.open)
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (!flow.resolved && !Resolve(flow))
+    {
+        return Status::UNRESOLVED;
+    }
+
+    Status status = Prepare(flow, datagram);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    status = mDevice.Transmit(datagram);
+    if (status == Status::BUSY)
+    {
+        mDevice.ReleaseTx();
+        status = mDevice.Transmit(datagram);
+    }
+    if (status != Status::OK)
+    {
+        Unprepare(datagram);
+        return status;
+    }
+    mTxCount++;
+    return Status::OK;
+}
+
+
+size_t UdpStack::SendBatch(UdpFlow& flow, PacketBuffer* const* ppDatagrams, size_t count)
+{
+    if (!flow.open || (!flow.resolved && !Resolve(flow)))
+    {
+        return 0U;
+    }
+
+    mDevice.ReleaseTx();
+    size_t sent = 0U;
+    while (sent < count)
+    {
+        PacketBuffer& datagram = *ppDatagrams[sent];
+        if (Prepare(flow, datagram) != Status::OK)
+        {
+            break;
+        }
+        if (mDevice.Transmit(datagram) != Status::OK)
+        {
+            Unprepare(datagram);
+            break;
+        }
+        sent++;
+    }
+    mTxCount += static_cast<uint32_t>(sent);
+    return sent;
+}
+
+
+Status UdpStack::Prepare(UdpFlow& flow, PacketBuffer& datagram)
+{
+    const size_t headroom = static_cast<size_t>(datagram.pPayload - datagram.data.data());
+    const size_t payloadLength = datagram.totalLength;
+    if ((headroom < UDP_FRAME_HEADER_SIZE) || (payloadLength > UDP_MAX_PAYLOAD))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    const uint16_t udpLength = static_cast<uint16_t>(UDP_HEADER_SIZE + payloadLength);
+    const uint16_t ipLength = static_cast<uint16_t>(IPV4_HEADER_SIZE + udpLength);
+    const uint16_t id = mIpId++;
+
+    uint8_t* pFrame = datagram.pPayload - UDP_FRAME_HEADER_SIZE;
+    std::memcpy(pFrame, flow.header.data(), UDP_FRAME_HEADER_SIZE);
+    uint8_t* pIp = &pFrame[ETH_HEADER_SIZE];
+    uint8_t* pUdp = &pIp[IPV4_HEADER_SIZE];
+    Store16(&pIp[IPV4_LENGTH_OFFSET], ipLength);
+    Store16(&pIp[IPV4_ID_OFFSET], id);
+    Store16(&pUdp[UDP_LENGTH_OFFSET], udpLength);
+
+    if (!mDevice.IsChecksumOffload())
+    {
+        // incremental: the flow sums plus the fields of this datagram plus the payload
+        const uint32_t ipSum = Checksum::AddValue(Checksum::AddValue(flow.ipSum, ipLength), id);
+        Store16(&pIp[IPV4_CHECKSUM_OFFSET], Checksum::Finish(ipSum));
+
+        // the UDP length is part of the pseudo header and of the UDP header
+        uint32_t udpSum = Checksum::AddValue(Checksum::AddValue(flow.udpSum, udpLength), udpLength);
+        udpSum = Checksum::AddChain(udpSum, datagram, 0U, payloadLength);
+        const uint16_t checksum = Checksum::Finish(udpSum);
+        Store16(&pUdp[UDP_CHECKSUM_OFFSET], (checksum == 0U) ? 0xFFFFU : checksum);
+    }
+
+    datagram.pPayload = pFrame;
+    datagram.length = static_cast<uint16_t>(datagram.length + UDP_FRAME_HEADER_SIZE);
+    datagram.totalLength = static_cast<uint16_t>(datagram.totalLength + UDP_FRAME_HEADER_SIZE);
+    return Status::OK;
+}
+
+
+void UdpStack::Unprepare(PacketBuffer& frame)
+{
+    frame.pPayload += UDP_FRAME_HEADER_SIZE;
+    frame.length = static_cast<uint16_t>(frame.length - UDP_FRAME_HEADER_SIZE);
+    frame.totalLength = static_cast<uint16_t>(frame.totalLength - UDP_FRAME_HEADER_SIZE);
+}
+
+
+bool UdpStack::Resolve(UdpFlow& flow)
+{
+    const ArpEntry* pEntry = FindArp(flow.nextHop);
+    if ((pEntry == nullptr) || !pEntry->resolved)
+    {
+        return false;
+    }
+    std::memcpy(&flow.header[ETH_DST_OFFSET], pEntry->mac.data(), pEntry->mac.size());
+    flow.resolved = true;
+    return true;
+}
+
+
+Status UdpStack::Bind(uint16_t port, IListener& listener)
+{
+    if (port == 0U)
+    {
+        return Status::INVALID_PARAM;
+    }
+    Binding* pFree{nullptr};
+    for (Binding& binding : mBindings)
+    {
+        if (binding.port == port)
+        {
+            return Status::INVALID_PARAM;
+        }
+        if ((binding.port == 0U) && (pFree == nullptr))
+        {
+            pFree = &binding;
+        }
+    }
+    if (pFree == nullptr)
+    {
+        return Status::BUSY;
+    }
+    pFree->port = port;
+    pFree->pListener = &listener;
+    return Status::OK;
+}
+
+
+void UdpStack::Unbind(uint16_t port)
+{
+    for (Binding& binding : mBindings)
+    {
+        if (binding.port == port)
+        {
+            binding = Binding{};
+        }
+    }
+}
+
+
+void UdpStack::Poll(uint32_t nowMs)
+{
+    mNowMs = nowMs;
+
+    PacketBuffer* pFrame{nullptr};
+    while ((pFrame = mDevice.Receive()) != nullptr)
+    {
+        const uint16_t type = (pFrame->length >= ETH_HEADER_SIZE) ? Load16(&pFrame->pPayload[ETH_TYPE_OFFSET]) : 0U;
+        if (type == ETH_TYPE_IPV4)
+        {
+            HandleIpv4(*pFrame);
+        }
+        else if (type == ETH_TYPE_ARP)
+        {
+            HandleArp(*pFrame);
+        }
+        else
+        {
+            mRxDropCount++;
+        }
+        (void)mPool.Free(pFrame);
+    }
+
+    mDevice.ReleaseTx();
+
+    for (ArpEntry& entry : mArpTable)
+    {
+        if ((entry.address != 0U) && !entry.resolved && ((nowMs - entry.requestMs) >= ARP_RETRY_MS))
+        {
+            SendArpRequest(entry, nowMs);
+        }
+    }
+}
+
+
+UdpStack::ArpEntry* UdpStack::FindArp(uint32_t address)
+{
+    for (ArpEntry& entry : mArpTable)
+    {
+        if (entry.address == address)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+
+void UdpStack::LearnArp(uint32_t address, const uint8_t* pMac, bool insert)
+{
+    if (address == 0U)
+    {
+        return;
+    }
+
+    ArpEntry* pEntry = FindArp(address);
+    if (pEntry == nullptr)
+    {
+        if (!insert)
+        {
+            return;
+        }
+        pEntry = FindArp(0U);
+        if (pEntry == nullptr)
+        {
+            pEntry = &mArpTable[mArpReplace];
+            mArpReplace = (mArpReplace + 1U) % mArpTable.size();
+        }
+        *pEntry = ArpEntry{};
+        pEntry->address = address;
+    }
+
+    if (pMac != nullptr)
+    {
+        std::memcpy(pEntry->mac.data(), pMac, pEntry->mac.size());
+        pEntry->resolved = true;
+    }
+}
+
+
+void UdpStack::SendArpRequest(ArpEntry& entry, uint32_t nowMs)
+{
+    entry.requestMs = nowMs;
+    PacketBuffer* pFrame = mPool.Alloc();
+    if (pFrame == nullptr)
+    {
+        return;
+    }
+
+    uint8_t* pEth = pFrame->pPayload;
+    std::memcpy(&pEth[ETH_DST_OFFSET], MAC_BROADCAST.data(), MAC_BROADCAST.size());
+    std::memcpy(&pEth[ETH_SRC_OFFSET], mMac.data(), mMac.size());
+    Store16(&pEth[ETH_TYPE_OFFSET], ETH_TYPE_ARP);
+
+    uint8_t* pArp = &pEth[ETH_HEADER_SIZE];
+    Store16(&pArp[0], ARP_HARDWARE_ETHERNET);
+    Store16(&pArp[2], ETH_TYPE_IPV4);
+    pArp[4] = ARP_MAC_SIZE;
+    pArp[5] = ARP_IP_SIZE;
+    Store16(&pArp[ARP_OPERATION_OFFSET], ARP_REQUEST);
+    std::memcpy(&pArp[ARP_SENDER_MAC_OFFSET], mMac.data(), mMac.size());
+    Store32(&pArp[ARP_SENDER_IP_OFFSET], mAddress);
+    std::memset(&pArp[ARP_TARGET_MAC_OFFSET], 0, ARP_MAC_SIZE);
+    Store32(&pArp[ARP_TARGET_IP_OFFSET], entry.address);
+
+    pFrame->length = static_cast<uint16_t>(ETH_HEADER_SIZE + ARP_SIZE);
+    pFrame->totalLength = pFrame->length;
+    if (mDevice.Transmit(*pFrame) == Status::OK)
+    {
+        mArpRequestCount++;
+    }
+    (void)mPool.Free(pFrame);
+}
+
+
+void UdpStack::HandleArp(PacketBuffer& frame)
+{
+    uint8_t* pEth = frame.pPayload;
+    uint8_t* pArp = &pEth[ETH_HEADER_SIZE];
+    if ((frame.length < (ETH_HEADER_SIZE + ARP_SIZE)) || (Load16(&pArp[0]) != ARP_HARDWARE_ETHERNET) ||
+        (Load16(&pArp[2]) != ETH_TYPE_IPV4) || (pArp[4] != ARP_MAC_SIZE) || (pArp[5] != ARP_IP_SIZE))
+    {
+        mRxDropCount++;
+        return;
+    }
+
+    const uint16_t operation = Load16(&pArp[ARP_OPERATION_OFFSET]);
+    const uint32_t sender = Load32(&pArp[ARP_SENDER_IP_OFFSET]);
+    const bool forUs = (Load32(&pArp[ARP_TARGET_IP_OFFSET]) == mAddress);
+
+    // RFC 826: update a known sender always, add it if the packet is for this host
+    LearnArp(sender, &pArp[ARP_SENDER_MAC_OFFSET], forUs);
+
+    if (!forUs || (operation != ARP_REQUEST) || (frame.pNext != nullptr))
+    {
+        return;
+    }
+
+    // answer in the received buffer
+    std::memcpy(&pArp[ARP_TARGET_MAC_OFFSET], &pArp[ARP_SENDER_MAC_OFFSET], ARP_MAC_SIZE);
+    Store32(&pArp[ARP_TARGET_IP_OFFSET], sender);
+    std::memcpy(&pArp[ARP_SENDER_MAC_OFFSET], mMac.data(), mMac.size());
+    Store32(&pArp[ARP_SENDER_IP_OFFSET], mAddress);
+    Store16(&pArp[ARP_OPERATION_OFFSET], ARP_REPLY);
+    std::memcpy(&pEth[ETH_DST_OFFSET], &pArp[ARP_TARGET_MAC_OFFSET], ARP_MAC_SIZE);
+    std::memcpy(&pEth[ETH_SRC_OFFSET], mMac.data(), mMac.size());
+
+    frame.length = static_cast<uint16_t>(ETH_HEADER_SIZE + ARP_SIZE);
+    frame.totalLength = frame.length;
+    (void)mDevice.Transmit(frame);
+}
+
+
+void UdpStack::HandleIpv4(PacketBuffer& frame)
+{
+    // a frame up to the MTU fits into one buffer, the headers are checked in place
+    if ((frame.pNext != nullptr) || (frame.length < (ETH_HEADER_SIZE + IPV4_HEADER_SIZE)))
+    {
+        mRxDropCount++;
+        return;
+    }
+
+    uint8_t* pIp = &frame.pPayload[ETH_HEADER_SIZE];
+    const size_t headerSize = static_cast<size_t>(pIp[0] & 0x0FU) * 4U;
+    const size_t ipLength = Load16(&pIp[IPV4_LENGTH_OFFSET]);
+    const uint32_t destination = Load32(&pIp[IPV4_DST_OFFSET]);
+    const bool forUs = (destination == mAddress) || (destination == BROADCAST_ADDRESS) ||
+                       (destination == (mAddress | ~mNetmask)) || IsMulticast(destination);
+
+    if (((pIp[0] >> 4U) != 4U) || (headerSize < IPV4_HEADER_SIZE) || (ipLength < (headerSize + UDP_HEADER_SIZE)) ||
+        ((ETH_HEADER_SIZE + ipLength) > frame.length) || !forUs || (pIp[IPV4_PROTOCOL_OFFSET] != IPV4_PROTOCOL_UDP) ||
+        ((Load16(&pIp[IPV4_FRAGMENT_OFFSET]) & 0x3FFFU) != 0U) ||
+        (Checksum::Finish(Checksum::Add(0U, pIp, headerSize)) != 0U))
+    {
+        mRxDropCount++;
+        return;
+    }
+
+    uint8_t* pUdp = &pIp[headerSize];
+    const uint16_t udpLength = Load16(&pUdp[UDP_LENGTH_OFFSET]);
+    if ((udpLength < UDP_HEADER_SIZE) || (udpLength > (ipLength - headerSize)))
+    {
+        mRxDropCount++;
+        return;
+    }
+    if (Load16(&pUdp[UDP_CHECKSUM_OFFSET]) != 0U)
+    {
+        uint32_t sum = Checksum::Add(0U, &pIp[IPV4_SRC_OFFSET], 8U);
+        sum = Checksum::AddValue(sum, IPV4_PROTOCOL_UDP);
+        sum = Checksum::AddValue(sum, udpLength);
+        if (Checksum::Finish(Checksum::Add(sum, pUdp, udpLength)) != 0U)
+        {
+            mRxDropCount++;
+            return;
+        }
+    }
+
+    const uint16_t port = Load16(&pUdp[UDP_DST_PORT_OFFSET]);
+    IListener* pListener{nullptr};
+    for (const Binding& binding : mBindings)
+    {
+        if (binding.port == port)
+        {
+            pListener = binding.pListener;
+        }
+    }
+    if (pListener == nullptr)
+    {
+        mRxDropCount++;
+        return;
+    }
+
+    UdpEndpoint from;
+    from.address = Load32(&pIp[IPV4_SRC_OFFSET]);
+    from.port = Load16(&pUdp[UDP_SRC_PORT_OFFSET]);
+    // the payload without the headers and the ethernet padding
+    frame.pPayload = &pUdp[UDP_HEADER_SIZE];
+    frame.length = static_cast<uint16_t>(udpLength - UDP_HEADER_SIZE);
+    frame.totalLength = frame.length;
+    mRxCount++;
+    pListener->OnDatagram(from, port, frame);
+}
@@ -0,0 +1,251 @@
+/**
+ ********************************************************************************
+ * @file        UdpStack.hpp
+ *
+ * @namespace   Net
+ *
+ * @brief       Net, allocation free UDP/IPv4/ARP fast path.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IEthDevice.hpp"
+#include "IpAddressV4.hpp"
+#include "PacketPool.hpp"
+#include "Protocol.hpp"
+#include <array>
+namespace Net {
+
+
+/// @brief Address and port of a UDP peer, both in host order.
+struct UdpEndpoint
+{
+    uint32_t address{0U};   //!< IPv4 address
+    uint16_t port{0U};      //!< UDP port
+};
+
+
+/**
+ * @brief   Precomputed headers of one UDP destination, filled by UdpStack::OpenFlow.
+ * @details The header template holds every constant field of the ethernet, IP and UDP headers,
+ *          the checksum sums of the constant fields are kept next to it. A datagram only needs the
+ *          lengths, the IP identification and the checksums.
+ */
+struct UdpFlow
+{
+    std::array<uint8_t, UDP_FRAME_HEADER_SIZE> header{};    //!< Header template, lengths, id and checksums are 0
+    uint32_t ipSum{0U};                                     //!< Partial sum of the constant IP header fields
+    uint32_t udpSum{0U};                                    //!< Partial sum of the pseudo header without length and the ports
+    uint32_t nextHop{0U};                                   //!< Address whose hardware address is the destination
+    bool resolved{false};                                   //!< The destination hardware address is in the template
+    bool open{false};                                       //!< The flow has been opened
+};
+
+
+/**
+ * @brief   This class provides a minimal UDP/IPv4 stack for high rate datagram streams.
+ * @details No dynamic memory, no copies: a datagram is a packet buffer from @ref AllocDatagram with
+ *          @ref HEADROOM bytes in front of the payload. @ref Send writes the precomputed headers of the
+ *          flow into the headroom and hands the buffer chain to the device, the checksums are summed
+ *          incrementally from the flow sums, or left to the MAC if the device has checksum offload.
+ *          @ref SendBatch queues several datagrams of one flow with a single TX release.\n
+ *          Received frames are dispatched in @ref Poll: ARP requests for the own address are answered
+ *          in the received buffer, ARP replies fill the table, UDP datagrams are handed to the listener
+ *          bound to the destination port with the payload start moved behind the headers.
+ * @note    There is no IP fragmentation and no IP option on TX, fragments are dropped on RX.
+ *          Multicast groups are sent to their mapped hardware address and received without IGMP,
+ *          the MAC filter decides which groups reach the stack.
+ *          Datagrams are limited to @ref UDP_MAX_PAYLOAD bytes. ARP entries do not expire, the
+ *          application opens a flow again to refresh a changed hardware address.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call Send and Poll from the context which owns the device.
+ *
+ */
+class UdpStack
+{
+    public:
+
+        /// @brief Entries of the ARP table.
+        static constexpr size_t ARP_TABLE_SIZE{8U};
+
+        /// @brief Count of bound ports.
+        static constexpr size_t MAX_BINDINGS{4U};
+
+        /// @brief Interval of ARP request repetitions for unresolved addresses.
+        static constexpr uint32_t ARP_RETRY_MS{1000U};
+
+        /// @brief Bytes in front of the payload, 2 bytes pad keep the IP header and the payload word aligned.
+        static constexpr size_t HEADROOM{UDP_FRAME_HEADER_SIZE + 2U};
+
+        /// @brief Receiver of datagrams of a bound port.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief Called from Poll for each valid datagram.
+                 * @param from      Sender of the datagram.
+                 * @param localPort The bound port.
+                 * @param payload   The payload, pPayload and totalLength describe the UDP data. The stack
+                 *                  frees the frame after the call, take a reference with PacketPool::Ref to keep it.
+                 */
+                virtual void OnDatagram(const UdpEndpoint& from, uint16_t localPort, PacketBuffer& payload) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /**
+         * @brief   Constructs the stack on a started device.
+         *
+         * @param   device      The ethernet device.
+         * @param   pool        The pool of the device.
+         * @param   mac         Own hardware address.
+         * @param   address     Own IPv4 address.
+         * @param   netmask     Network mask.
+         * @param   gateway     Router for destinations outside the network, 0 if there is none.
+         */
+        UdpStack(IEthDevice& device, PacketPool& pool, const MacAddress& mac, const Utils::IpAddressV4& address,
+                 const Utils::IpAddressV4& netmask, const Utils::IpAddressV4& gateway);
+
+        UdpStack(UdpStack const &) = delete;             //!< Copy constructor
+        UdpStack& operator=(UdpStack const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Prepare the headers of a destination and start the address resolution.
+         *
+         * @param   flow        The flow, owned by the caller.
+         * @param   remote      Destination address, 255.255.255.255 for a broadcast or a multicast group.
+         * @param   remotePort  Destination port.
+         * @param   localPort   Source port.
+         *
+         * @return  OK if the flow can send, UNRESOLVED if an ARP request is on the way, INVALID_PARAM
+         *          for a destination without route.
+         */
+        Status OpenFlow(UdpFlow& flow, const Utils::IpAddressV4& remote, uint16_t remotePort, uint16_t localPort);
+
+        /**
+         * @brief   Take a buffer for a datagram.
+         *
+         * @return  A buffer with the payload start behind the headroom and length 0, nullptr if the pool is empty.
+         */
+        PacketBuffer* AllocDatagram();
+
+        /**
+         * @brief   Send a datagram. The caller keeps its reference and frees it after the call.
+         *
+         * @param   flow        An open flow.
+         * @param   datagram    Payload chain, the head has @ref HEADROOM bytes in front of the payload.
+         *
+         * @return  OK, UNRESOLVED while the ARP request is open, BUSY if the TX ring is full,
+         *          INVALID_PARAM for a closed flow, a missing headroom or an oversized payload.
+         */
+        Status Send(UdpFlow& flow, PacketBuffer& datagram);
+
+        /**
+         * @brief   Send datagrams of one flow in a row, the TX ring is released once in front.
+         *
+         * @param   flow        An open flow.
+         * @param   ppDatagrams The datagrams like for @ref Send.
+         * @param   count       Count of datagrams.
+         *
+         * @return  Count of sent datagrams from the start of the list, the rest is unchanged.
+         */
+        size_t SendBatch(UdpFlow& flow, PacketBuffer* const* ppDatagrams, size_t count);
+
+        /**
+         * @brief   Receive the datagrams of a local port.
+         *
+         * @param   port        Local port.
+         * @param   listener    The receiver.
+         *
+         * @return  OK, BUSY if all bindings are used, INVALID_PARAM if the port is bound already.
+         */
+        Status Bind(uint16_t port, IListener& listener);
+
+        /// @brief Stop receiving a port.
+        void Unbind(uint16_t port);
+
+        /**
+         * @brief   Dispatch all received frames, release sent frames and repeat open ARP requests.
+         *
+         * @param   nowMs   Millisecond time base for the ARP repetitions.
+         */
+        void Poll(uint32_t nowMs);
+
+        /// @brief Sent datagrams.
+        uint32_t GetTxCount() const {return mTxCount;};
+
+        /// @brief Datagrams handed to listeners.
+        uint32_t GetRxCount() const {return mRxCount;};
+
+        /// @brief Received frames which were not for this host, damaged or for an unbound port.
+        uint32_t GetRxDropCount() const {return mRxDropCount;};
+
+        /// @brief Sent ARP requests.
+        uint32_t GetArpRequestCount() const {return mArpRequestCount;};
+
+    private:
+
+        struct ArpEntry
+        {
+            uint32_t address{0U};       //!< IPv4 address, 0 for a free entry
+            MacAddress mac{};           //!< Hardware address
+            bool resolved{false};       //!< The hardware address is valid
+            uint32_t requestMs{0U};     //!< Time of the last request
+        };
+
+        struct Binding
+        {
+            uint16_t port{0U};              //!< Local port, 0 for a free binding
+            IListener* pListener{nullptr};  //!< Receiver
+        };
+
+        /// @brief Write the headers into the headroom and complete them, the frame is the chain from the headers on.
+        Status Prepare(UdpFlow& flow, PacketBuffer& datagram);
+
+        /// @brief Undo @ref Prepare for a datagram which was not sent.
+        static void Unprepare(PacketBuffer& frame);
+
+        /// @brief Copy the resolved destination into the flow template.
+        bool Resolve(UdpFlow& flow);
+
+        ArpEntry* FindArp(uint32_t address);
+
+        /// @brief Update an existing entry or, if insert is set, take a new one.
+        void LearnArp(uint32_t address, const uint8_t* pMac, bool insert);
+
+        void SendArpRequest(ArpEntry& entry, uint32_t nowMs);
+
+        void HandleArp(PacketBuffer& frame);
+
+        void HandleIpv4(PacketBuffer& frame);
+
+        IEthDevice& mDevice;
+        PacketPool& mPool;
+        MacAddress mMac;
+        uint32_t mAddress;
+        uint32_t mNetmask;
+        uint32_t mGateway;
+
+        std::array<ArpEntry, ARP_TABLE_SIZE> mArpTable{};
+        size_t mArpReplace{0U};                 //!< Next entry to replace if the table is full
+        std::array<Binding, MAX_BINDINGS> mBindings{};
+
+        uint16_t mIpId{0U};                     //!< IP identification of the next datagram
+        uint32_t mNowMs{0U};                    //!< Time of the last Poll
+
+        uint32_t mTxCount{0U};
+        uint32_t mRxCount{0U};
+        uint32_t mRxDropCount{0U};
+        uint32_t mArpRequestCount{0U};
+};
+
+} // end namespace Net
@@ -0,0 +1,313 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../PacketPool.hpp"
+#include "../EthDeviceSim.hpp"
+#include <memory>
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Net;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  PoolAllocFree
+*   (0)  PoolRefCountAndChain
+*   (0)  PoolFromData
+*   (0)  RxZeroCopyFrame
+*   (0)  RxMultiBufferChain
+*   (0)  RxRingFullDrops
+*   (0)  RxRefillAfterPoolEmpty
+*   (0)  TxReleaseAfterSend
+*   (0)  TxRingLimits
+*/
+
+namespace {
+
+std::vector<uint8_t> Frame(size_t len, uint8_t seed)
+{
+    std::vector<uint8_t> frame(len);
+    for (size_t i = 0U; i < len; i++)
+    {
+        frame[i] = static_cast<uint8_t>(seed + i);
+    }
+    return frame;
+}
+
+std::vector<uint8_t> Flatten(const PacketBuffer& frame)
+{
+    std::vector<uint8_t> bytes;
+    for (const PacketBuffer* pBuffer = &frame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+    {
+        bytes.insert(bytes.end(), pBuffer->pPayload, pBuffer->pPayload + pBuffer->length);
+    }
+    return bytes;
+}
+
+/// @brief Pool storage on the heap, the buffers are too large for the test stack.
+template <size_t COUNT>
+struct TestPool
+{
+    std::unique_ptr<PacketPoolStorage<COUNT>> storage{std::make_unique<PacketPoolStorage<COUNT>>()};
+    PacketPool pool{storage->buffers.data(), COUNT};
+};
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(EthDevice_Test, PoolAllocFree)
+{
+    TestPool<3> test;
+    PacketPool& pool = test.pool;
+
+    std::vector<PacketBuffer*> buffers;
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        buffers.push_back(pool.Alloc());
+        ASSERT_NE(buffers.back(), nullptr);
+        EXPECT_EQ(buffers.back()->refCount, 1U);
+        EXPECT_EQ(buffers.back()->pPayload, buffers.back()->data.data());
+    }
+    EXPECT_EQ(pool.Alloc(), nullptr);
+    EXPECT_EQ(pool.GetAllocFailures(), 1U);
+    EXPECT_EQ(pool.GetFreeCount(), 0U);
+
+    EXPECT_EQ(pool.Free(buffers[1]), 1U);
+    EXPECT_EQ(pool.Free(buffers[1]), 0U);   // double free is ignored
+    EXPECT_EQ(pool.GetFreeCount(), 1U);
+
+    // LIFO, the last freed buffer comes back first
+    EXPECT_EQ(pool.Alloc(), buffers[1]);
+    EXPECT_EQ(pool.GetMinFreeCount(), 0U);
+}
+
+TEST(EthDevice_Test, PoolRefCountAndChain)
+{
+    TestPool<4> test;
+    PacketPool& pool = test.pool;
+
+    PacketBuffer* pHead = pool.Alloc();
+    PacketBuffer* pTail = pool.Alloc();
+    pHead->length = 100U;
+    pHead->totalLength = 100U;
+    pTail->length = 20U;
+    pTail->totalLength = 20U;
+    PacketPool::Chain(*pHead, *pTail);
+    EXPECT_EQ(pHead->totalLength, 120U);
+    EXPECT_EQ(pHead->pNext, pTail);
+
+    pool.Ref(*pHead);
+    EXPECT_EQ(pool.Free(pHead), 0U);
+    EXPECT_EQ(pool.GetFreeCount(), 2U);
+
+    // the last reference of the head releases the chain
+    EXPECT_EQ(pool.Free(pHead), 2U);
+    EXPECT_EQ(pool.GetFreeCount(), 4U);
+}
+
+TEST(EthDevice_Test, PoolFromData)
+{
+    TestPool<4> test;
+    PacketPool& pool = test.pool;
+    PacketBuffer& second = test.storage->buffers[2];
+
+    EXPECT_EQ(pool.FromData(second.data.data()), &second);
+    EXPECT_EQ(pool.FromData(&second.data[PBUF_DATA_SIZE - 1U]), &second);
+    EXPECT_EQ(pool.FromData(reinterpret_cast<const uint8_t*>(&second)), nullptr);
+
+    const uint8_t outside = 0U;
+    EXPECT_EQ(pool.FromData(&outside), nullptr);
+}
+
+TEST(EthDevice_Test, RxZeroCopyFrame)
+{
+    TestPool<8> test;
+    EthDeviceSim<4, 4> device(test.pool);
+    device.Start();
+    EXPECT_EQ(test.pool.GetFreeCount(), 4U);
+    EXPECT_EQ(device.Receive(), nullptr);
+
+    const std::vector<uint8_t> frame = Frame(60U, 1U);
+    ASSERT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+
+    PacketBuffer* pFrame = device.Receive();
+    ASSERT_NE(pFrame, nullptr);
+    EXPECT_EQ(pFrame->totalLength, 60U);
+    EXPECT_EQ(pFrame->pNext, nullptr);
+    EXPECT_EQ(Flatten(*pFrame), frame);
+    // the application gets the buffer the DMA has written, the ring was refilled from the pool
+    EXPECT_EQ(test.pool.FromData(pFrame->pPayload), pFrame);
+    EXPECT_EQ(test.pool.GetFreeCount(), 3U);
+
+    EXPECT_EQ(test.pool.Free(pFrame), 1U);
+    EXPECT_EQ(test.pool.GetFreeCount(), 4U);
+    EXPECT_EQ(device.GetRxFrames(), 1U);
+}
+
+TEST(EthDevice_Test, RxMultiBufferChain)
+{
+    TestPool<8> test;
+    EthDeviceSim<4, 4> device(test.pool);
+    device.Start();
+
+    const std::vector<uint8_t> frame = Frame(PBUF_DATA_SIZE + 500U, 7U);
+    ASSERT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+
+    PacketBuffer* pFrame = device.Receive();
+    ASSERT_NE(pFrame, nullptr);
+    ASSERT_NE(pFrame->pNext, nullptr);
+    EXPECT_EQ(pFrame->length, PBUF_DATA_SIZE);
+    EXPECT_EQ(pFrame->totalLength, frame.size());
+    EXPECT_EQ(pFrame->pNext->length, 500U);
+    EXPECT_EQ(Flatten(*pFrame), frame);
+    EXPECT_EQ(test.pool.Free(pFrame), 2U);
+}
+
+TEST(EthDevice_Test, RxRingFullDrops)
+{
+    TestPool<16> test;
+    EthDeviceSim<4, 4> device(test.pool);
+    device.Start();
+
+    const std::vector<uint8_t> frame = Frame(1514U, 3U);
+    for (size_t i = 0U; i < 4U; i++)
+    {
+        EXPECT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+    }
+    EXPECT_FALSE(device.InjectFrame(frame.data(), frame.size()));
+    EXPECT_EQ(device.GetRxDropped(), 1U);
+
+    // every Receive gives a descriptor back to the DMA
+    PacketBuffer* pFrame = device.Receive();
+    ASSERT_NE(pFrame, nullptr);
+    (void)test.pool.Free(pFrame);
+    EXPECT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+
+    size_t received = 0U;
+    while ((pFrame = device.Receive()) != nullptr)
+    {
+        (void)test.pool.Free(pFrame);
+        received++;
+    }
+    EXPECT_EQ(received, 4U);
+}
+
+TEST(EthDevice_Test, RxRefillAfterPoolEmpty)
+{
+    TestPool<5> test;
+    EthDeviceSim<4, 4> device(test.pool);
+    device.Start();
+
+    const std::vector<uint8_t> frame = Frame(100U, 9U);
+    std::vector<PacketBuffer*> held;
+    for (size_t i = 0U; i < 3U; i++)
+    {
+        ASSERT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+        held.push_back(device.Receive());
+        ASSERT_NE(held.back(), nullptr);
+    }
+    // one spare buffer, two refills failed, the DMA has two descriptors
+    EXPECT_EQ(device.GetRxAllocFailures(), 2U);
+    EXPECT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+    EXPECT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+    EXPECT_FALSE(device.InjectFrame(frame.data(), frame.size()));
+
+    for (PacketBuffer* pFrame : held)
+    {
+        (void)test.pool.Free(pFrame);
+    }
+    PacketBuffer* pFrame = device.Receive();
+    ASSERT_NE(pFrame, nullptr);
+    (void)test.pool.Free(pFrame);
+    pFrame = device.Receive();
+    ASSERT_NE(pFrame, nullptr);
+    (void)test.pool.Free(pFrame);
+
+    // the free buffers refilled the whole ring
+    for (size_t i = 0U; i < 4U; i++)
+    {
+        EXPECT_TRUE(device.InjectFrame(frame.data(), frame.size()));
+    }
+}
+
+TEST(EthDevice_Test, TxReleaseAfterSend)
+{
+    TestPool<8> test;
+    PacketPool& pool = test.pool;
+    EthDeviceSim<4, 4> device(pool);
+
+    PacketBuffer* pHead = pool.Alloc();
+    PacketBuffer* pTail = pool.Alloc();
+    const std::vector<uint8_t> header = Frame(42U, 0x10U);
+    const std::vector<uint8_t> payload = Frame(1000U, 0x80U);
+    std::copy(header.begin(), header.end(), pHead->pPayload);
+    pHead->length = static_cast<uint16_t>(header.size());
+    pHead->totalLength = pHead->length;
+    std::copy(payload.begin(), payload.end(), pTail->pPayload);
+    pTail->length = static_cast<uint16_t>(payload.size());
+    pTail->totalLength = pTail->length;
+    PacketPool::Chain(*pHead, *pTail);
+
+    ASSERT_EQ(device.Transmit(*pHead), Status::OK);
+    // the caller may drop its reference right away
+    EXPECT_EQ(pool.Free(pHead), 0U);
+    EXPECT_EQ(pool.GetFreeCount(), 6U);
+
+    device.ReleaseTx();
+    EXPECT_EQ(pool.GetFreeCount(), 6U);
+
+    static std::vector<uint8_t> sWire;
+    sWire.clear();
+    EXPECT_EQ(device.TransmitPending([](const PacketBuffer& frame, void*) {sWire = Flatten(frame);}, nullptr), 1U);
+    std::vector<uint8_t> expected = header;
+    expected.insert(expected.end(), payload.begin(), payload.end());
+    EXPECT_EQ(sWire, expected);
+
+    device.ReleaseTx();
+    EXPECT_EQ(pool.GetFreeCount(), 8U);
+    EXPECT_EQ(device.GetTxFrames(), 1U);
+}
+
+TEST(EthDevice_Test, TxRingLimits)
+{
+    TestPool<8> test;
+    PacketPool& pool = test.pool;
+    EthDeviceSim<4, 2> device(pool);
+
+    PacketBuffer* pChain = pool.Alloc();
+    PacketPool::Chain(*pChain, *pool.Alloc());
+    PacketPool::Chain(*pChain, *pool.Alloc());
+    EXPECT_EQ(device.Transmit(*pChain), Status::INVALID_PARAM);
+    EXPECT_EQ(pool.Free(pChain), 3U);
+
+    PacketBuffer* pFirst = pool.Alloc();
+    PacketBuffer* pSecond = pool.Alloc();
+    PacketBuffer* pThird = pool.Alloc();
+    EXPECT_EQ(device.Transmit(*pFirst), Status::OK);
+    EXPECT_EQ(device.Transmit(*pSecond), Status::OK);
+    EXPECT_EQ(device.Transmit(*pThird), Status::BUSY);
+
+    EXPECT_EQ(device.TransmitPending(nullptr, nullptr), 2U);
+    device.ReleaseTx();
+    EXPECT_EQ(device.Transmit(*pThird), Status::OK);
+
+    (void)pool.Free(pFirst);
+    (void)pool.Free(pSecond);
+    (void)pool.Free(pThird);
+}
+
+
+}  // end namespace GTest
@@ -0,0 +1,297 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../EthDeviceSim.hpp"
+#include "../PtpClockSim.hpp"
+#include "../PtpMasterSim.hpp"
+#include "../PtpServo.hpp"
+#include "../PtpSlave.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Net;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  ServoEstimatesAndSteps
+*   (0)  DeviceTimestamps
+*   (0)  SlaveConvergesWithDrift
+*   (0)  SlaveFollowsMasterStep
+*   (0)  SlaveLosesSilentMaster
+*/
+
+namespace {
+
+const MacAddress MAC_MASTER{0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x0AU};
+const MacAddress MAC_SLAVE{0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x0BU};
+
+/// @brief Start of the master time.
+constexpr uint64_t EPOCH_NS{1700000000000000000U};
+
+/// @brief Propagation delay of the wire, both directions.
+constexpr uint64_t WIRE_DELAY_NS{3700U};
+
+/// @brief One node: clock, pool, simulated MAC stamping with the clock and stack.
+struct Node
+{
+    Node(const uint64_t& trueNs, uint64_t startNs, int32_t driftPpb, const MacAddress& mac, const char* pAddress)
+    : clock(trueNs, startNs, driftPpb)
+    , device(pool)
+    , stack(device, pool, mac, Utils::IpAddressV4(pAddress), Utils::IpAddressV4("255.255.255.0"),
+            Utils::IpAddressV4("192.168.1.1"))
+    {
+        device.Start();
+        device.SetClock(&clock);
+    }
+
+    PtpClockSim clock;
+    std::unique_ptr<PacketPoolStorage<PBUF_COUNT>> storage{std::make_unique<PacketPoolStorage<PBUF_COUNT>>()};
+    PacketPool pool{storage->buffers.data(), PBUF_COUNT};
+    EthDeviceSim<> device;
+    UdpStack stack;
+};
+
+/// @brief Master and slave on a wire with a fixed delay, the true time advances in 1 ms ticks.
+class Network
+{
+    public:
+        Network(int32_t slaveDriftPpb, int64_t slaveOffsetNs)
+        : master(mTrueNs, EPOCH_NS, 0, MAC_MASTER, "192.168.1.10")
+        , slave(mTrueNs, EPOCH_NS + static_cast<uint64_t>(slaveOffsetNs), slaveDriftPpb, MAC_SLAVE, "192.168.1.20")
+        , ptpMaster(master.stack, master.pool, master.clock, MAC_MASTER)
+        , ptpSlave(slave.stack, slave.pool, slave.clock, MAC_SLAVE)
+        {
+            EXPECT_EQ(ptpMaster.Start(), Status::OK);
+            EXPECT_EQ(ptpSlave.Start(), Status::OK);
+        }
+
+        /// @brief Simulate some milliseconds, frames arrive at their exact time.
+        void Run(uint32_t ms)
+        {
+            for (uint32_t i = 0U; i < ms; i++)
+            {
+                master.stack.Poll(mNowMs);
+                ptpMaster.Poll(mNowMs);
+                slave.stack.Poll(mNowMs);
+                ptpSlave.Poll(mNowMs);
+                Transmit(master.device, slave.device);
+                Transmit(slave.device, master.device);
+
+                const uint64_t tickEnd = mTrueNs + 1000000U;
+                std::sort(mInFlight.begin(), mInFlight.end(), [](const InFlight& a, const InFlight& b)
+                {
+                    return a.arrivalNs < b.arrivalNs;
+                });
+                size_t delivered = 0U;
+                while ((delivered < mInFlight.size()) && (mInFlight[delivered].arrivalNs <= tickEnd))
+                {
+                    InFlight& frame = mInFlight[delivered];
+                    mTrueNs = frame.arrivalNs;
+                    (void)frame.pTarget->InjectFrame(frame.bytes.data(), frame.bytes.size());
+                    delivered++;
+                }
+                mInFlight.erase(mInFlight.begin(), mInFlight.begin() + static_cast<std::ptrdiff_t>(delivered));
+                mTrueNs = tickEnd;
+                mNowMs++;
+            }
+        }
+
+        /// @brief Slave time minus master time at the same true time.
+        int64_t ClockError() const
+        {
+            return static_cast<int64_t>(slave.clock.GetTimeNs() - master.clock.GetTimeNs());
+        }
+
+    private:
+
+        struct InFlight
+        {
+            uint64_t arrivalNs;
+            EthDeviceSim<>* pTarget;
+            std::vector<uint8_t> bytes;
+        };
+
+        struct Link
+        {
+            Network* pNetwork;
+            EthDeviceSim<>* pTarget;
+        };
+
+        void Transmit(EthDeviceSim<>& from, EthDeviceSim<>& to)
+        {
+            Link link{this, &to};
+            (void)from.TransmitPending([](const PacketBuffer& frame, void* pContext)
+            {
+                Link* pLink = static_cast<Link*>(pContext);
+                InFlight inFlight{pLink->pNetwork->mTrueNs + WIRE_DELAY_NS, pLink->pTarget, {}};
+                for (const PacketBuffer* pBuffer = &frame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+                {
+                    inFlight.bytes.insert(inFlight.bytes.end(), pBuffer->pPayload, pBuffer->pPayload + pBuffer->length);
+                }
+                pLink->pNetwork->mInFlight.push_back(inFlight);
+            }, &link);
+        }
+
+        uint64_t mTrueNs{0U};
+        uint32_t mNowMs{0U};
+        std::vector<InFlight> mInFlight;
+
+    public:
+
+        Node master;
+        Node slave;
+        PtpMasterSim ptpMaster;
+        PtpSlave ptpSlave;
+};
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(Ptp_Test,ServoEstimatesAndSteps)
+{
+    PtpServo servo{PtpServo::Config{}};
+    int32_t ppb{0};
+    const uint64_t t0{EPOCH_NS};
+
+    // 1 ms ahead and 50 ppm fast
+    ASSERT_EQ(servo.Sample(1000000, t0, ppb), PtpServo::State::UNLOCKED);
+    ASSERT_FALSE(servo.IsLocked());
+    ASSERT_EQ(servo.Sample(1050000, t0 + 1000000000U, ppb), PtpServo::State::JUMP);
+    ASSERT_EQ(ppb, -50000);
+    ASSERT_TRUE(servo.IsLocked());
+    ASSERT_NEAR(servo.GetDrift(), 50000.0, 0.001);
+
+    // proportional and integral part on top of the drift
+    ASSERT_EQ(servo.Sample(100, t0 + 2000000000U, ppb), PtpServo::State::LOCKED);
+    ASSERT_EQ(ppb, -50100);
+    ASSERT_NEAR(servo.GetDrift(), 50030.0, 0.001);
+
+    // the limit holds and does not wind up the integral
+    PtpServo::Config config;
+    config.maxPpb = 50050;
+    PtpServo limited{config};
+    (void)limited.Sample(0, t0, ppb);
+    (void)limited.Sample(50000, t0 + 1000000000U, ppb);
+    ASSERT_EQ(limited.Sample(1000, t0 + 2000000000U, ppb), PtpServo::State::LOCKED);
+    ASSERT_EQ(ppb, -50050);
+    ASSERT_NEAR(limited.GetDrift(), 50000.0, 0.001);
+
+    // beyond the step threshold the estimation starts again
+    ASSERT_EQ(servo.Sample(1000000, t0 + 3000000000U, ppb), PtpServo::State::UNLOCKED);
+    ASSERT_FALSE(servo.IsLocked());
+}
+
+
+TEST(Ptp_Test,DeviceTimestamps)
+{
+    uint64_t trueNs{0U};
+    Node node(trueNs, EPOCH_NS, 100000, MAC_MASTER, "192.168.1.10");
+
+    PacketBuffer* pStamped = node.pool.Alloc();
+    PacketBuffer* pPlain = node.pool.Alloc();
+    ASSERT_NE(pStamped, nullptr);
+    ASSERT_NE(pPlain, nullptr);
+    pStamped->length = 60U;
+    pStamped->totalLength = 60U;
+    pStamped->txTimestamp = true;
+    pPlain->length = 60U;
+    pPlain->totalLength = 60U;
+    ASSERT_EQ(node.device.Transmit(*pStamped), Status::OK);
+    ASSERT_EQ(node.device.Transmit(*pPlain), Status::OK);
+
+    trueNs = 1000000000U;
+    ASSERT_EQ(node.device.TransmitPending(nullptr, nullptr), 2U);
+    ASSERT_EQ(pStamped->timestamp, EPOCH_NS + 1000100000U);
+    ASSERT_EQ(pPlain->timestamp, 0U);
+    node.device.ReleaseTx();
+    (void)node.pool.Free(pStamped);
+    (void)node.pool.Free(pPlain);
+
+    // RX: the time of the DMA, not of the application
+    const std::vector<uint8_t> bytes(60U, 0x55U);
+    ASSERT_TRUE(node.device.InjectFrame(bytes.data(), bytes.size()));
+    const uint64_t rxTime = node.clock.GetTimeNs();
+    trueNs += 5000U;
+    PacketBuffer* pFrame = node.device.Receive();
+    ASSERT_NE(pFrame, nullptr);
+    ASSERT_EQ(pFrame->timestamp, rxTime);
+    (void)node.pool.Free(pFrame);
+
+    // a freshly allocated buffer carries no old stamp
+    PacketBuffer* pReused = node.pool.Alloc();
+    ASSERT_EQ(pReused->timestamp, 0U);
+    ASSERT_FALSE(pReused->txTimestamp);
+    (void)node.pool.Free(pReused);
+}
+
+
+TEST(Ptp_Test,SlaveConvergesWithDrift)
+{
+    std::unique_ptr<Network> spNet = std::make_unique<Network>(50000, 250000000);
+    ASSERT_GT(spNet->ClockError(), 249000000);
+
+    spNet->Run(20000U);
+    ASSERT_TRUE(spNet->ptpSlave.IsLocked());
+    ASSERT_EQ(spNet->slave.clock.GetStepCount(), 1U);
+    ASSERT_LT(std::llabs(spNet->ClockError()), 1000);
+    ASSERT_NEAR(static_cast<double>(spNet->ptpSlave.GetPathDelayNs()), static_cast<double>(WIRE_DELAY_NS), 50.0);
+    ASSERT_NEAR(static_cast<double>(spNet->ptpSlave.GetFrequency()), -50000.0, 100.0);
+    ASSERT_GT(spNet->ptpMaster.GetDelayRespCount(), 15U);
+
+    // stays locked, the time source is the disciplined clock
+    int64_t worst{0};
+    for (int i = 0; i < 20; i++)
+    {
+        spNet->Run(500U);
+        worst = std::max(worst, static_cast<int64_t>(std::llabs(spNet->ClockError())));
+    }
+    ASSERT_LT(worst, 1000);
+    ASSERT_EQ(spNet->ptpSlave.GetTimeNs(), spNet->slave.clock.GetTimeNs());
+}
+
+
+TEST(Ptp_Test,SlaveFollowsMasterStep)
+{
+    std::unique_ptr<Network> spNet = std::make_unique<Network>(-20000, -3000000);
+    spNet->Run(15000U);
+    ASSERT_TRUE(spNet->ptpSlave.IsLocked());
+    ASSERT_LT(std::llabs(spNet->ClockError()), 1000);
+
+    spNet->master.clock.StepTime(2000000000);
+    spNet->Run(15000U);
+    ASSERT_TRUE(spNet->ptpSlave.IsLocked());
+    ASSERT_EQ(spNet->slave.clock.GetStepCount(), 2U);
+    ASSERT_LT(std::llabs(spNet->ClockError()), 1000);
+}
+
+
+TEST(Ptp_Test,SlaveLosesSilentMaster)
+{
+    std::unique_ptr<Network> spNet = std::make_unique<Network>(10000, 1000000);
+    spNet->Run(10000U);
+    ASSERT_TRUE(spNet->ptpSlave.IsLocked());
+
+    spNet->ptpMaster.Stop();
+    spNet->Run(PtpSlave::SYNC_TIMEOUT_MS + 1500U);
+    ASSERT_FALSE(spNet->ptpSlave.IsLocked());
+    // the clock keeps the learned frequency
+    ASSERT_NEAR(static_cast<double>(spNet->ptpSlave.GetFrequency()), -10000.0, 100.0);
+}
+
+} // end namespace GTest
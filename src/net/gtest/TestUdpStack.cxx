@@ -0,0 +1,454 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../Checksum.hpp"
+#include "../EthDeviceSim.hpp"
+#include "../EthDeviceSocket.hpp"
+#include "../UdpStack.hpp"
+#include <unistd.h>
+#include <memory>
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Net;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  ChecksumRfc1071
+*   (0)  ChecksumOddChain
+*   (0)  ArpResolveAndDeliver
+*   (0)  SoftwareChecksumsValid
+*   (0)  OffloadInsertsChecksums
+*   (0)  RxDropsDamagedAndUnbound
+*   (0)  OffLinkUsesGateway
+*   (0)  SendBatchStopsAtFullRing
+*   (0)  SocketLoopback
+*/
+
+namespace {
+
+const MacAddress MAC_A{0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x0AU};
+const MacAddress MAC_B{0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x0BU};
+
+/// @brief Reference checksum, big endian words one by one.
+uint16_t ReferenceChecksum(const uint8_t* pData, size_t len, uint32_t sum = 0U)
+{
+    for (size_t i = 0U; i < len; i += 2U)
+    {
+        sum += static_cast<uint32_t>(pData[i]) << 8U;
+        if ((i + 1U) < len)
+        {
+            sum += pData[i + 1U];
+        }
+    }
+    while ((sum >> 16U) != 0U)
+    {
+        sum = (sum & 0xFFFFU) + (sum >> 16U);
+    }
+    return static_cast<uint16_t>(~sum);
+}
+
+/// @brief True if the IP header and the UDP checksum of a frame are correct.
+bool ChecksumsValid(const std::vector<uint8_t>& frame)
+{
+    const uint8_t* pIp = &frame[ETH_HEADER_SIZE];
+    if (ReferenceChecksum(pIp, IPV4_HEADER_SIZE) != 0U)
+    {
+        return false;
+    }
+    const uint8_t* pUdp = &pIp[IPV4_HEADER_SIZE];
+    const uint16_t udpLength = Load16(&pUdp[UDP_LENGTH_OFFSET]);
+    uint32_t pseudo = IPV4_PROTOCOL_UDP + udpLength;
+    for (size_t i = 0U; i < 8U; i += 2U)
+    {
+        pseudo += Load16(&pIp[IPV4_SRC_OFFSET + i]);
+    }
+    return ReferenceChecksum(pUdp, udpLength, pseudo) == 0U;
+}
+
+std::vector<uint8_t> Flatten(const PacketBuffer& frame)
+{
+    std::vector<uint8_t> bytes;
+    for (const PacketBuffer* pBuffer = &frame; pBuffer != nullptr; pBuffer = pBuffer->pNext)
+    {
+        bytes.insert(bytes.end(), pBuffer->pPayload, pBuffer->pPayload + pBuffer->length);
+    }
+    return bytes;
+}
+
+/// @brief Stores the received datagrams.
+class Receiver : public UdpStack::IListener
+{
+    public:
+        void OnDatagram(const UdpEndpoint& from, uint16_t localPort, PacketBuffer& payload) override
+        {
+            mFrom = from;
+            mLocalPort = localPort;
+            mPayloads.push_back(Flatten(payload));
+        }
+
+        UdpEndpoint mFrom{};
+        uint16_t mLocalPort{0U};
+        std::vector<std::vector<uint8_t>> mPayloads;
+};
+
+/// @brief One host: pool, simulated MAC and stack.
+template <size_t TX_DEPTH = TX_DESC_COUNT>
+struct Host
+{
+    Host(const MacAddress& mac, const char* pAddress)
+    : device(pool)
+    , stack(device, pool, mac, Utils::IpAddressV4(pAddress), Utils::IpAddressV4("255.255.255.0"),
+            Utils::IpAddressV4("192.168.1.1"))
+    {
+        device.Start();
+    }
+
+    std::unique_ptr<PacketPoolStorage<PBUF_COUNT>> storage{std::make_unique<PacketPoolStorage<PBUF_COUNT>>()};
+    PacketPool pool{storage->buffers.data(), PBUF_COUNT};
+    EthDeviceSim<RX_DESC_COUNT, TX_DEPTH> device;
+    UdpStack stack;
+};
+
+/// @brief Wire of the simulation, the frames of one device go to the other one and to a capture.
+struct Wire
+{
+    EthDeviceSim<>* pPeer{nullptr};
+    std::vector<std::vector<uint8_t>> captured;
+
+    template <typename DEVICE>
+    void Send(DEVICE& device)
+    {
+        (void)device.TransmitPending([](const PacketBuffer& frame, void* pContext)
+        {
+            Wire* pWire = static_cast<Wire*>(pContext);
+            pWire->captured.push_back(Flatten(frame));
+            if (pWire->pPeer != nullptr)
+            {
+                const std::vector<uint8_t>& bytes = pWire->captured.back();
+                (void)pWire->pPeer->InjectFrame(bytes.data(), bytes.size());
+            }
+        }, this);
+    }
+};
+
+/// @brief Run both stacks until the link is quiet.
+void Exchange(Host<>& a, Host<>& b, Wire& aToB, Wire& bToA)
+{
+    for (uint32_t i = 0U; i < 4U; i++)
+    {
+        aToB.Send(a.device);
+        b.stack.Poll(0U);
+        bToA.Send(b.device);
+        a.stack.Poll(0U);
+    }
+}
+
+PacketBuffer* Datagram(UdpStack& stack, const std::vector<uint8_t>& payload)
+{
+    PacketBuffer* pDatagram = stack.AllocDatagram();
+    std::copy(payload.begin(), payload.end(), pDatagram->pPayload);
+    pDatagram->length = static_cast<uint16_t>(payload.size());
+    pDatagram->totalLength = pDatagram->length;
+    return pDatagram;
+}
+
+std::vector<uint8_t> Payload(size_t len, uint8_t seed)
+{
+    std::vector<uint8_t> payload(len);
+    for (size_t i = 0U; i < len; i++)
+    {
+        payload[i] = static_cast<uint8_t>((seed + (i * 7U)) ^ (i >> 3U));
+    }
+    return payload;
+}
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(UdpStack_Test, ChecksumRfc1071)
+{
+    // RFC 1071 chapter 3 example, sum 0xDDF2
+    const uint8_t data[] = {0x00U, 0x01U, 0xF2U, 0x03U, 0xF4U, 0xF5U, 0xF6U, 0xF7U};
+    EXPECT_EQ(Checksum::Finish(Checksum::Add(0U, data, sizeof(data))), 0x220DU);
+    EXPECT_EQ(Checksum::Finish(Checksum::Add(0U, data, sizeof(data))), ReferenceChecksum(data, sizeof(data)));
+
+    const std::vector<uint8_t> bytes = Payload(1001U, 0x33U);
+    EXPECT_EQ(Checksum::Finish(Checksum::Add(0U, bytes.data(), bytes.size())), ReferenceChecksum(bytes.data(), bytes.size()));
+    EXPECT_EQ(Checksum::Finish(Checksum::Add(0U, &bytes[1], 77U)), ReferenceChecksum(&bytes[1], 77U));
+
+    // a field added as value equals the field in memory
+    const uint8_t field[] = {0x12U, 0x34U};
+    EXPECT_EQ(Checksum::AddValue(0U, 0x1234U), Checksum::Add(0U, field, sizeof(field)));
+}
+
+TEST(UdpStack_Test, ChecksumOddChain)
+{
+    std::unique_ptr<PacketPoolStorage<3>> storage = std::make_unique<PacketPoolStorage<3>>();
+    PacketPool pool(storage->buffers.data(), 3U);
+    const std::vector<uint8_t> bytes = Payload(1001U, 0x5AU);
+    const size_t split[] = {333U, 1U, 667U};
+
+    PacketBuffer* pHead{nullptr};
+    size_t offset = 0U;
+    for (const size_t len : split)
+    {
+        PacketBuffer* pBuffer = pool.Alloc();
+        std::copy(&bytes[offset], &bytes[offset + len], pBuffer->pPayload);
+        pBuffer->length = static_cast<uint16_t>(len);
+        pBuffer->totalLength = pBuffer->length;
+        offset += len;
+        if (pHead == nullptr)
+        {
+            pHead = pBuffer;
+        }
+        else
+        {
+            PacketPool::Chain(*pHead, *pBuffer);
+        }
+    }
+
+    EXPECT_EQ(Checksum::Finish(Checksum::AddChain(0U, *pHead, 0U, bytes.size())), ReferenceChecksum(bytes.data(), bytes.size()));
+    EXPECT_EQ(Checksum::Finish(Checksum::AddChain(0U, *pHead, 100U, 500U)), ReferenceChecksum(&bytes[100], 500U));
+    (void)pool.Free(pHead);
+}
+
+TEST(UdpStack_Test, ArpResolveAndDeliver)
+{
+    Host<> a(MAC_A, "192.168.1.10");
+    Host<> b(MAC_B, "192.168.1.20");
+    Wire aToB;
+    Wire bToA;
+    aToB.pPeer = &b.device;
+    bToA.pPeer = &a.device;
+    Receiver receiver;
+    ASSERT_EQ(b.stack.Bind(5000U, receiver), Status::OK);
+
+    UdpFlow flow;
+    EXPECT_EQ(a.stack.OpenFlow(flow, Utils::IpAddressV4("192.168.1.20"), 5000U, 6000U), Status::UNRESOLVED);
+    PacketBuffer* pDatagram = Datagram(a.stack, Payload(100U, 1U));
+    EXPECT_EQ(a.stack.Send(flow, *pDatagram), Status::UNRESOLVED);
+    EXPECT_EQ(a.stack.GetArpRequestCount(), 1U);
+
+    Exchange(a, b, aToB, bToA);
+    EXPECT_EQ(a.stack.Send(flow, *pDatagram), Status::OK);
+    EXPECT_TRUE(flow.resolved);
+    (void)a.pool.Free(pDatagram);
+    Exchange(a, b, aToB, bToA);
+
+    ASSERT_EQ(receiver.mPayloads.size(), 1U);
+    EXPECT_EQ(receiver.mPayloads[0], Payload(100U, 1U));
+    EXPECT_EQ(receiver.mFrom.address, 0xC0A8010AU);
+    EXPECT_EQ(receiver.mFrom.port, 6000U);
+    EXPECT_EQ(receiver.mLocalPort, 5000U);
+    EXPECT_EQ(b.stack.GetRxCount(), 1U);
+    EXPECT_EQ(a.stack.GetTxCount(), 1U);
+
+    // every buffer is back, apart from the RX rings
+    EXPECT_EQ(a.pool.GetFreeCount(), PBUF_COUNT - RX_DESC_COUNT);
+    EXPECT_EQ(b.pool.GetFreeCount(), PBUF_COUNT - RX_DESC_COUNT);
+}
+
+TEST(UdpStack_Test, SoftwareChecksumsValid)
+{
+    Host<> a(MAC_A, "192.168.1.10");
+    Wire wire;
+    UdpFlow flow;
+    ASSERT_EQ(a.stack.OpenFlow(flow, Utils::IpAddressV4("255.255.255.255"), 7000U, 7001U), Status::OK);
+
+    const size_t lengths[] = {0U, 1U, 17U, 256U, 1471U, UDP_MAX_PAYLOAD};
+    for (const size_t len : lengths)
+    {
+        PacketBuffer* pDatagram = Datagram(a.stack, Payload(len, static_cast<uint8_t>(len)));
+        ASSERT_EQ(a.stack.Send(flow, *pDatagram), Status::OK);
+        (void)a.pool.Free(pDatagram);
+    }
+    wire.Send(a.device);
+
+    ASSERT_EQ(wire.captured.size(), 6U);
+    for (const std::vector<uint8_t>& frame : wire.captured)
+    {
+        EXPECT_TRUE(ChecksumsValid(frame));
+        EXPECT_EQ(std::vector<uint8_t>(frame.begin(), frame.begin() + 6), std::vector<uint8_t>(MAC_BROADCAST.begin(), MAC_BROADCAST.end()));
+    }
+    // the identification counts up
+    EXPECT_EQ(Load16(&wire.captured[1][ETH_HEADER_SIZE + IPV4_ID_OFFSET]),
+              Load16(&wire.captured[0][ETH_HEADER_SIZE + IPV4_ID_OFFSET]) + 1U);
+
+    PacketBuffer* pTooLarge = Datagram(a.stack, Payload(UDP_MAX_PAYLOAD, 0U));
+    pTooLarge->totalLength++;
+    EXPECT_EQ(a.stack.Send(flow, *pTooLarge), Status::INVALID_PARAM);
+    (void)a.pool.Free(pTooLarge);
+}
+
+TEST(UdpStack_Test, OffloadInsertsChecksums)
+{
+    Host<> a(MAC_A, "192.168.1.10");
+    a.device.SetChecksumOffload(true);
+    UdpFlow flow;
+    ASSERT_EQ(a.stack.OpenFlow(flow, Utils::IpAddressV4("255.255.255.255"), 7000U, 7001U), Status::OK);
+
+    PacketBuffer* pDatagram = Datagram(a.stack, Payload(333U, 9U));
+    ASSERT_EQ(a.stack.Send(flow, *pDatagram), Status::OK);
+    // the stack leaves the fields to the MAC
+    EXPECT_EQ(Load16(&pDatagram->pPayload[ETH_HEADER_SIZE + IPV4_CHECKSUM_OFFSET]), 0U);
+    EXPECT_EQ(Load16(&pDatagram->pPayload[ETH_HEADER_SIZE + IPV4_HEADER_SIZE + UDP_CHECKSUM_OFFSET]), 0U);
+    (void)a.pool.Free(pDatagram);
+
+    Wire wire;
+    wire.Send(a.device);
+    ASSERT_EQ(wire.captured.size(), 1U);
+    EXPECT_TRUE(ChecksumsValid(wire.captured[0]));
+}
+
+TEST(UdpStack_Test, RxDropsDamagedAndUnbound)
+{
+    Host<> a(MAC_A, "192.168.1.10");
+    Host<> b(MAC_B, "192.168.1.20");
+    Receiver receiver;
+    ASSERT_EQ(b.stack.Bind(5000U, receiver), Status::OK);
+    EXPECT_EQ(b.stack.Bind(5000U, receiver), Status::INVALID_PARAM);
+
+    UdpFlow toBound;
+    UdpFlow toUnbound;
+    ASSERT_EQ(a.stack.OpenFlow(toBound, Utils::IpAddressV4("192.168.1.255"), 5000U, 6000U), Status::OK);
+    ASSERT_EQ(a.stack.OpenFlow(toUnbound, Utils::IpAddressV4("192.168.1.255"), 5001U, 6000U), Status::OK);
+    for (UdpFlow* pFlow : {&toBound, &toUnbound, &toBound})
+    {
+        PacketBuffer* pDatagram = Datagram(a.stack, Payload(64U, 2U));
+        ASSERT_EQ(a.stack.Send(*pFlow, *pDatagram), Status::OK);
+        (void)a.pool.Free(pDatagram);
+    }
+    Wire wire;
+    wire.Send(a.device);
+    ASSERT_EQ(wire.captured.size(), 3U);
+
+    std::vector<uint8_t> damaged = wire.captured[2];
+    damaged.back() ^= 0x01U;
+    for (const std::vector<uint8_t>* pFrame : {&wire.captured[0], &wire.captured[1], &damaged})
+    {
+        ASSERT_TRUE(b.device.InjectFrame(pFrame->data(), pFrame->size()));
+    }
+    b.stack.Poll(0U);
+
+    EXPECT_EQ(receiver.mPayloads.size(), 1U);
+    EXPECT_EQ(b.stack.GetRxDropCount(), 2U);
+
+    // the same without a checksum is accepted
+    damaged[ETH_HEADER_SIZE + IPV4_HEADER_SIZE + UDP_CHECKSUM_OFFSET] = 0U;
+    damaged[ETH_HEADER_SIZE + IPV4_HEADER_SIZE + UDP_CHECKSUM_OFFSET + 1U] = 0U;
+    ASSERT_TRUE(b.device.InjectFrame(damaged.data(), damaged.size()));
+    b.stack.Poll(0U);
+    EXPECT_EQ(receiver.mPayloads.size(), 2U);
+}
+
+TEST(UdpStack_Test, OffLinkUsesGateway)
+{
+    Host<> a(MAC_A, "192.168.1.10");
+    UdpFlow flow;
+    EXPECT_EQ(a.stack.OpenFlow(flow, Utils::IpAddressV4("10.0.0.5"), 5000U, 6000U), Status::UNRESOLVED);
+
+    Wire wire;
+    wire.Send(a.device);
+    ASSERT_EQ(wire.captured.size(), 1U);
+    const std::vector<uint8_t>& request = wire.captured[0];
+    EXPECT_EQ(Load16(&request[ETH_TYPE_OFFSET]), ETH_TYPE_ARP);
+    EXPECT_EQ(Load32(&request[ETH_HEADER_SIZE + ARP_TARGET_IP_OFFSET]), 0xC0A80101U);
+
+    // repeated after the retry interval only
+    a.stack.Poll(UdpStack::ARP_RETRY_MS - 1U);
+    EXPECT_EQ(a.stack.GetArpRequestCount(), 1U);
+    a.stack.Poll(UdpStack::ARP_RETRY_MS);
+    EXPECT_EQ(a.stack.GetArpRequestCount(), 2U);
+}
+
+TEST(UdpStack_Test, SendBatchStopsAtFullRing)
+{
+    Host<4> a(MAC_A, "192.168.1.10");
+    UdpFlow flow;
+    ASSERT_EQ(a.stack.OpenFlow(flow, Utils::IpAddressV4("255.255.255.255"), 7000U, 7001U), Status::OK);
+
+    std::vector<PacketBuffer*> datagrams;
+    for (size_t i = 0U; i < 6U; i++)
+    {
+        datagrams.push_back(Datagram(a.stack, Payload(128U, static_cast<uint8_t>(i))));
+    }
+    EXPECT_EQ(a.stack.SendBatch(flow, datagrams.data(), datagrams.size()), 4U);
+    // the rest is untouched and can be sent after the release
+    EXPECT_EQ(datagrams[4]->pPayload, &datagrams[4]->data[UdpStack::HEADROOM]);
+    EXPECT_EQ(datagrams[4]->totalLength, 128U);
+
+    Wire wire;
+    wire.Send(a.device);
+    EXPECT_EQ(a.stack.SendBatch(flow, &datagrams[4], 2U), 2U);
+    wire.Send(a.device);
+    ASSERT_EQ(wire.captured.size(), 6U);
+    for (size_t i = 0U; i < 6U; i++)
+    {
+        const std::vector<uint8_t>& frame = wire.captured[i];
+        EXPECT_TRUE(ChecksumsValid(frame));
+        EXPECT_EQ(std::vector<uint8_t>(frame.begin() + UDP_FRAME_HEADER_SIZE, frame.end()), Payload(128U, static_cast<uint8_t>(i)));
+    }
+    for (PacketBuffer* pDatagram : datagrams)
+    {
+        (void)a.pool.Free(pDatagram);
+    }
+    EXPECT_EQ(a.stack.GetTxCount(), 6U);
+}
+
+TEST(UdpStack_Test, SocketLoopback)
+{
+    std::unique_ptr<PacketPoolStorage<8>> storageA = std::make_unique<PacketPoolStorage<8>>();
+    std::unique_ptr<PacketPoolStorage<8>> storageB = std::make_unique<PacketPoolStorage<8>>();
+    PacketPool poolA(storageA->buffers.data(), 8U);
+    PacketPool poolB(storageB->buffers.data(), 8U);
+    EthDeviceSocket deviceA(poolA);
+    EthDeviceSocket deviceB(poolB);
+    const uint16_t portA = static_cast<uint16_t>(40000U + (getpid() % 10000));
+    const uint16_t portB = static_cast<uint16_t>(portA + 1U);
+    if ((deviceA.Open(portA, portB) != Status::OK) || (deviceB.Open(portB, portA) != Status::OK))
+    {
+        GTEST_SKIP() << "no loopback socket available";
+    }
+    deviceA.SetChecksumOffload(true);
+
+    UdpStack a(deviceA, poolA, MAC_A, Utils::IpAddressV4("192.168.1.10"), Utils::IpAddressV4("255.255.255.0"), Utils::IpAddressV4(0U));
+    UdpStack b(deviceB, poolB, MAC_B, Utils::IpAddressV4("192.168.1.20"), Utils::IpAddressV4("255.255.255.0"), Utils::IpAddressV4(0U));
+    Receiver receiver;
+    ASSERT_EQ(b.Bind(5000U, receiver), Status::OK);
+
+    UdpFlow flow;
+    Status status = a.OpenFlow(flow, Utils::IpAddressV4("192.168.1.20"), 5000U, 6000U);
+    PacketBuffer* pDatagram = Datagram(a, Payload(1000U, 4U));
+    for (uint32_t i = 0U; (i < 1000U) && (receiver.mPayloads.empty()); i++)
+    {
+        if (status != Status::OK)
+        {
+            status = a.Send(flow, *pDatagram);
+        }
+        b.Poll(i);
+        a.Poll(i);
+        (void)usleep(100U);
+    }
+    (void)poolA.Free(pDatagram);
+
+    ASSERT_EQ(receiver.mPayloads.size(), 1U);
+    EXPECT_EQ(receiver.mPayloads[0], Payload(1000U, 4U));
+    EXPECT_EQ(poolB.GetFreeCount(), 8U);
+}
+
+
+}  // end namespace GTest
@@ -0,0 +1,119 @@
+/**
+ ********************************************************************************
+ * @file        ISpiPort.hpp
+ *
+ * @namespace   Spi
+ *
+ * @brief       Spi, interface of an SPI master with DMA, TSIZE reload and chip select lines.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "SpiTypes.hpp"
+namespace Spi {
+
+
+/**
+ * @brief   This class provides the DMA transfers of one SPI master (hardware or simulation).
+ * @details @ref Start runs one segment with a fresh setup. While it runs, @ref Reload may append one more
+ *          segment which the SPI continues without gap (TSER is reloaded into TSIZE, the DMA streams are
+ *          re-armed in their completion). Every segment reports its end by the listener in order.\n
+ *          @ref StartStream runs an endless transfer through a circular buffer of two halves, each filled
+ *          half is reported while the other one is transferred.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class ISpiPort
+{
+    public:
+
+        /// @brief Receiver of the transfer events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A segment has ended, called from the interrupt context.
+                 * @param status    OK or HW_ERROR.
+                 */
+                virtual void OnSegmentDone(Status status) = 0;
+
+                /**
+                 * @brief A half of the stream buffer is filled, called from the interrupt context.
+                 * @param half      0 for the first, 1 for the second half.
+                 */
+                virtual void OnStreamHalf(uint8_t half) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~ISpiPort() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Apply mode and clock of a device, only while no transfer runs.
+         * @param device    The device.
+         * @return OK, INVALID_PARAM, BUSY.
+         */
+        virtual Status Configure(const SpiDevice& device) = 0;
+
+        /**
+         * @brief Drive a chip select line.
+         * @param chipSelect    The line.
+         * @param active        true to select the device.
+         */
+        virtual void SetChipSelect(uint8_t chipSelect, bool active) = 0;
+
+        /**
+         * @brief Start a segment.
+         * @param segment   The segment.
+         * @return OK, BUSY while a transfer runs, HW_ERROR.
+         */
+        virtual Status Start(const SpiSegment& segment) = 0;
+
+        /**
+         * @brief Append a segment to the running one without gap.
+         * @param segment   The segment.
+         * @return true if appended, false if no reload is possible (idle, too late, one already pending).
+         */
+        virtual bool Reload(const SpiSegment& segment) = 0;
+
+        /**
+         * @brief Start the endless transfer through a circular buffer.
+         * @param buffer    Both halves, length is the sum of both.
+         * @return OK, BUSY while a transfer runs, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status StartStream(const SpiSegment& buffer) = 0;
+
+        /// @brief Stop the endless transfer.
+        virtual void StopStream() = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        ISpiPort() = default;
+
+        ISpiPort(ISpiPort const &) = default;             //!< Copy constructor
+        ISpiPort(ISpiPort &&) = default;                  //!< Move constructor
+
+        ISpiPort& operator=(ISpiPort const &) = default;  //!< Copy assignment
+        ISpiPort& operator=(ISpiPort &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Spi
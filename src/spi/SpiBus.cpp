@@ -0,0 +1,310 @@
+/**
+ ********************************************************************************
+ * @file        SpiBus.cpp
+ *
+ * @namespace   Spi
+ *
+ * @brief       Spi, transaction engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SpiBus.hpp"
+#include "CriticalSection.hpp"
+
+using namespace Spi;
+
+namespace {
+
+/// @brief Mode, clock and chip select of a device.
+bool IsValid(const SpiDevice& device)
+{
+    return (device.chipSelect < MAX_CHIP_SELECTS) && (device.mode <= 3U) && (device.clockDivider <= 7U);
+}
+
+/// @brief The DMA segment of a transfer.
+SpiSegment SegmentOf(const SpiTransfer& transfer)
+{
+    return SpiSegment{transfer.pTx, transfer.pRx, transfer.length};
+}
+
+} // end anonymous namespace
+
+
+SpiBus::SpiBus(ISpiPort& port)
+: mPort(port)
+{
+    mPort.SetListener(this);
+}
+
+
+SpiBus::~SpiBus()
+{
+    mPort.SetListener(nullptr);
+}
+
+
+Status SpiBus::Submit(SpiTransfer& transfer)
+{
+    if ((transfer.pDevice == nullptr) || !IsValid(*transfer.pDevice) || (transfer.pTx == nullptr) ||
+        (transfer.length == 0U) || (transfer.length > MAX_TRANSFER_FRAMES) || (transfer.status == Status::PENDING))
+    {
+        return Status::INVALID_PARAM;
+    }
+    transfer.pNext = nullptr;
+    transfer.status = Status::PENDING;
+
+    SpiTransfer* pFailed = nullptr;
+    {
+        Utils::CriticalSection lock;
+        if (mpTail == nullptr)
+        {
+            mpHead = &transfer;
+        }
+        else
+        {
+            mpTail->pNext = &transfer;
+        }
+        mpTail = &transfer;
+        mQueued = mQueued + 1U;
+
+        if (mpActive == nullptr)
+        {
+            pFailed = StartNext();
+        }
+        else
+        {
+            TryReload();
+        }
+    }
+    Finish(pFailed, Status::HW_ERROR);
+    return Status::OK;
+}
+
+
+Status SpiBus::StartStream(const SpiDevice& device, const uint8_t* pTx, uint8_t* pRx, uint32_t halfLength,
+                           IStreamHandler& handler)
+{
+    if (!IsValid(device) || (pTx == nullptr) || (pRx == nullptr) || (halfLength == 0U) ||
+        ((2U * halfLength) > MAX_TRANSFER_FRAMES))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    Utils::CriticalSection lock;
+    if ((mpActive != nullptr) || mStreaming)
+    {
+        return Status::BUSY;
+    }
+    if (!Select(device))
+    {
+        return Status::HW_ERROR;
+    }
+    mpStreamHandler = &handler;
+    mpStreamRx = pRx;
+    mStreamHalf = halfLength;
+    const Status status = mPort.StartStream(SpiSegment{pTx, pRx, 2U * halfLength});
+    if (status != Status::OK)
+    {
+        Release();
+        return status;
+    }
+    mStreaming = true;
+    return Status::OK;
+}
+
+
+void SpiBus::StopStream()
+{
+    SpiTransfer* pFailed = nullptr;
+    {
+        Utils::CriticalSection lock;
+        if (!mStreaming)
+        {
+            return;
+        }
+        mPort.StopStream();
+        mStreaming = false;
+        Release();
+        pFailed = StartNext();
+    }
+    Finish(pFailed, Status::HW_ERROR);
+}
+
+
+bool SpiBus::IsIdle() const
+{
+    Utils::CriticalSection lock;
+    return (mpActive == nullptr) && (mpHead == nullptr) && !mStreaming;
+}
+
+
+void SpiBus::OnSegmentDone(Status status)
+{
+    SpiTransfer* pDone = nullptr;
+    SpiTransfer* pFailed = nullptr;
+    {
+        Utils::CriticalSection lock;
+        pDone = mpActive;
+        if (pDone == nullptr)
+        {
+            return;
+        }
+        if (status != Status::OK)
+        {
+            // the error aborts the chain, the appended transfer did not run
+            pFailed = mpReloaded;
+            if (pFailed != nullptr)
+            {
+                pFailed->pNext = nullptr;
+            }
+            mpActive = nullptr;
+            mpReloaded = nullptr;
+            Release();
+        }
+        else
+        {
+            // a reloaded transfer is only appended to one which keeps the device selected
+            mpActive = mpReloaded;
+            mpReloaded = nullptr;
+            if (!pDone->keepSelected)
+            {
+                Release();
+            }
+        }
+
+        if (mpActive != nullptr)
+        {
+            TryReload();
+        }
+        else
+        {
+            SpiTransfer* pNextFailed = StartNext();
+            while (pNextFailed != nullptr)
+            {
+                SpiTransfer* pTransfer = pNextFailed;
+                pNextFailed = pNextFailed->pNext;
+                pTransfer->pNext = pFailed;
+                pFailed = pTransfer;
+            }
+        }
+    }
+    pDone->pNext = nullptr;
+    Finish(pDone, status);
+    Finish(pFailed, Status::HW_ERROR);
+}
+
+
+void SpiBus::OnStreamHalf(uint8_t half)
+{
+    if (!mStreaming || (mpStreamHandler == nullptr))
+    {
+        return;
+    }
+    mStreamHalves = mStreamHalves + 1U;
+    mpStreamHandler->OnStreamData(&mpStreamRx[static_cast<size_t>(half) * mStreamHalf], mStreamHalf);
+}
+
+
+SpiTransfer* SpiBus::StartNext()
+{
+    SpiTransfer* pFailed = nullptr;
+    while ((mpActive == nullptr) && !mStreaming && (mpHead != nullptr))
+    {
+        SpiTransfer* pTransfer = Pop();
+        if (Select(*pTransfer->pDevice) && (mPort.Start(SegmentOf(*pTransfer)) == Status::OK))
+        {
+            mpActive = pTransfer;
+            mSetups = mSetups + 1U;
+            TryReload();
+        }
+        else
+        {
+            Release();
+            pTransfer->pNext = pFailed;
+            pFailed = pTransfer;
+        }
+    }
+    return pFailed;
+}
+
+
+void SpiBus::TryReload()
+{
+    if ((mpActive == nullptr) || (mpReloaded != nullptr) || !mpActive->keepSelected || (mpHead == nullptr) ||
+        (mpHead->pDevice != mpActive->pDevice))
+    {
+        return;
+    }
+    if (mPort.Reload(SegmentOf(*mpHead)))
+    {
+        mpReloaded = Pop();
+        mChained = mChained + 1U;
+    }
+}
+
+
+bool SpiBus::Select(const SpiDevice& device)
+{
+    if (mpSelected == &device)
+    {
+        return true;
+    }
+    Release();
+    if (mPort.Configure(device) != Status::OK)
+    {
+        return false;
+    }
+    mPort.SetChipSelect(device.chipSelect, true);
+    mpSelected = &device;
+    return true;
+}
+
+
+void SpiBus::Release()
+{
+    if (mpSelected != nullptr)
+    {
+        mPort.SetChipSelect(mpSelected->chipSelect, false);
+        mpSelected = nullptr;
+    }
+}
+
+
+SpiTransfer* SpiBus::Pop()
+{
+    SpiTransfer* pTransfer = mpHead;
+    mpHead = pTransfer->pNext;
+    if (mpHead == nullptr)
+    {
+        mpTail = nullptr;
+    }
+    pTransfer->pNext = nullptr;
+    mQueued = mQueued - 1U;
+    return pTransfer;
+}
+
+
+void SpiBus::Finish(SpiTransfer* pList, Status status)
+{
+    while (pList != nullptr)
+    {
+        SpiTransfer* pTransfer = pList;
+        pList = pList->pNext;
+        pTransfer->pNext = nullptr;
+        // the callback may submit the same descriptor again
+        const SpiTransfer::Callback pCallback = pTransfer->pCallback;
+        void* const pContext = pTransfer->pContext;
+        if (status == Status::OK)
+        {
+            mCompleted = mCompleted + 1U;
+        }
+        pTransfer->status = status;
+        if (pCallback != nullptr)
+        {
+            pCallback(*pTransfer, pContext);
+        }
+    }
+}
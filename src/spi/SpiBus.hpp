@@ -0,0 +1,166 @@
+/**
+ ********************************************************************************
+ * @file        SpiBus.hpp
+ *
+ * @namespace   Spi
+ *
+ * @brief       Spi, transaction engine for several devices on one SPI master.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISpiPort.hpp"
+namespace Spi {
+
+
+/**
+ * @brief   This class queues the transfers of several devices on one SPI bus and runs them by DMA.
+ * @details The transfers are run in the order of Submit. The completion path of one transfer starts the
+ *          next one: it releases the chip select (unless the transfer keeps it), applies mode and clock of
+ *          the next device and selects it, so the CPU does not take part between the transfers.\n
+ *          A transfer with keepSelected chains the following transfer of the same device: while it runs,
+ *          the next one is handed to the port as TSIZE reload and follows without gap, e.g. a command and
+ *          its data phase or a sequence of register reads under one chip select.\n
+ *          The streaming mode runs an endless transfer through two buffer halves for converters which need
+ *          gapless clocking. The handler gets each filled half while the DMA fills the other one. Transfers
+ *          submitted meanwhile wait until @ref StopStream.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.\n
+ * Submit may be called from threads and ISR's, the completion path runs in the SPI/DMA interrupt.
+ *
+ */
+class SpiBus : private ISpiPort::IListener
+{
+    public:
+
+        /// @brief Receiver of the stream data.
+        class IStreamHandler
+        {
+            public:
+                /**
+                 * @brief A buffer half is filled, called from the interrupt context.
+                 * @param pData     The received frames, overwritten again after half a buffer time.
+                 * @param length    Frames of the half.
+                 */
+                virtual void OnStreamData(const uint8_t* pData, uint32_t length) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IStreamHandler() = default;
+        };
+
+        /**
+         * @brief   Constructs the bus and binds it to the port.
+         *
+         * @param   port    The SPI master.
+         */
+        explicit SpiBus(ISpiPort& port);
+
+        /// @brief Destructor, unbinds the port.
+        ~SpiBus();
+
+        SpiBus(SpiBus const &) = delete;             //!< Copy constructor
+        SpiBus& operator=(SpiBus const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Queue a transfer.
+         *
+         * @param   transfer    The transfer, status PENDING until completion.
+         *
+         * @return  OK, INVALID_PARAM for an invalid transfer or a pending descriptor.
+         */
+        Status Submit(SpiTransfer& transfer);
+
+        /**
+         * @brief   Start the gapless stream of a device.
+         *
+         * @param   device      The device, must stay valid until StopStream.
+         * @param   pTx         Transmit frames of both halves (e.g. the read command of the converter).
+         * @param   pRx         Receive buffer of both halves.
+         * @param   halfLength  Frames of one half.
+         * @param   handler     Receiver of the filled halves.
+         *
+         * @return  OK, BUSY while transfers run, INVALID_PARAM, HW_ERROR.
+         */
+        Status StartStream(const SpiDevice& device, const uint8_t* pTx, uint8_t* pRx, uint32_t halfLength,
+                           IStreamHandler& handler);
+
+        /// @brief Stop the stream, release the device and continue with the queued transfers.
+        void StopStream();
+
+        /// @brief No transfer runs and none is queued.
+        bool IsIdle() const;
+
+        /// @brief Transfers waiting in the queue.
+        uint32_t GetQueued() const {return mQueued;};
+
+        /// @brief Transfers started with a fresh setup.
+        uint32_t GetSetups() const {return mSetups;};
+
+        /// @brief Transfers chained without gap by TSIZE reload.
+        uint32_t GetChained() const {return mChained;};
+
+        /// @brief Completed transfers.
+        uint32_t GetCompleted() const {return mCompleted;};
+
+        /// @brief Delivered stream halves.
+        uint32_t GetStreamHalves() const {return mStreamHalves;};
+
+    private:
+
+        /// @brief Port event, see ISpiPort::IListener.
+        void OnSegmentDone(Status status) override;
+
+        /// @brief Port event, see ISpiPort::IListener.
+        void OnStreamHalf(uint8_t half) override;
+
+        /// @brief Start queued transfers while the bus is free, returns the failed ones (critical section).
+        SpiTransfer* StartNext();
+
+        /// @brief Hand the next transfer of the running device to the port as reload (critical section).
+        void TryReload();
+
+        /// @brief Release the selected device and select another one (critical section).
+        bool Select(const SpiDevice& device);
+
+        /// @brief Release the selected device (critical section).
+        void Release();
+
+        /// @brief Remove the oldest transfer from the queue (critical section).
+        SpiTransfer* Pop();
+
+        /// @brief Complete a list of transfers with a status, outside of the critical section.
+        void Finish(SpiTransfer* pList, Status status);
+
+        /// @brief The SPI master.
+        ISpiPort& mPort;
+
+        SpiTransfer* mpHead{nullptr};       //!< Oldest queued transfer
+        SpiTransfer* mpTail{nullptr};       //!< Newest queued transfer
+        SpiTransfer* mpActive{nullptr};     //!< Running transfer
+        SpiTransfer* mpReloaded{nullptr};   //!< Transfer appended by reload
+
+        /// @brief Device with active chip select.
+        const SpiDevice* mpSelected{nullptr};
+
+        /// @brief Receiver of the stream.
+        IStreamHandler* mpStreamHandler{nullptr};
+
+        uint8_t* mpStreamRx{nullptr};       //!< Stream receive buffer
+        uint32_t mStreamHalf{0U};           //!< Frames of one half
+        bool mStreaming{false};             //!< The stream runs
+
+        volatile uint32_t mQueued{0U};          //!< Queued transfers
+        volatile uint32_t mSetups{0U};          //!< Fresh setups
+        volatile uint32_t mChained{0U};         //!< Reloads
+        volatile uint32_t mCompleted{0U};       //!< Completed transfers
+        volatile uint32_t mStreamHalves{0U};    //!< Delivered halves
+};
+
+} // end namespace Spi
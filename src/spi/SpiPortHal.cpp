@@ -0,0 +1,333 @@
+/**
+ ********************************************************************************
+ * @file        SpiPortHal.cpp
+ *
+ * @namespace   Spi
+ *
+ * @brief       Spi, SPI port implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SpiPortHal.hpp"
+
+using namespace Spi;
+
+std::array<SpiPortHal*, SpiPortHal::INSTANCE_COUNT> SpiPortHal::sInstances{};
+
+namespace {
+
+/// @brief The port of a DMA handle linked to an SPI handle.
+SpiPortHal* PortOf(const DMA_HandleTypeDef* hdma)
+{
+    return SpiPortHal::GetInstance(static_cast<const SPI_HandleTypeDef*>(hdma->Parent));
+}
+
+/// @brief Completion of the TX stream while a reload is pending.
+void TxDmaComplete(DMA_HandleTypeDef* hdma)
+{
+    SpiPortHal* pPort = PortOf(hdma);
+    if (pPort != nullptr)
+    {
+        pPort->OnTxDma();
+    }
+}
+
+/// @brief Completion of the RX stream while a reload is pending.
+void RxDmaComplete(DMA_HandleTypeDef* hdma)
+{
+    SpiPortHal* pPort = PortOf(hdma);
+    if (pPort != nullptr)
+    {
+        pPort->OnRxDma();
+    }
+}
+
+} // end anonymous namespace
+
+
+SpiPortHal::SpiPortHal(SPI_HandleTypeDef& hspi, const ChipSelectPin* pPins, size_t count)
+: mHspi(hspi)
+{
+    mPinCount = (count < MAX_CHIP_SELECTS) ? count : MAX_CHIP_SELECTS;
+    for (size_t i = 0U; i < mPinCount; i++)
+    {
+        mPins[i] = pPins[i];
+        HAL_GPIO_WritePin(mPins[i].pPort, mPins[i].pin, GPIO_PIN_SET);
+    }
+    for (SpiPortHal*& pInstance : sInstances)
+    {
+        if (pInstance == nullptr)
+        {
+            pInstance = this;
+            break;
+        }
+    }
+}
+
+
+SpiPortHal::~SpiPortHal()
+{
+    (void)HAL_SPI_Abort(&mHspi);
+    for (SpiPortHal*& pInstance : sInstances)
+    {
+        if (pInstance == this)
+        {
+            pInstance = nullptr;
+        }
+    }
+}
+
+
+Status SpiPortHal::Configure(const SpiDevice& device)
+{
+    if ((device.mode > 3U) || (device.clockDivider > 7U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mHspi.State != HAL_SPI_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    // SPE is cleared at the end of every transfer, CFG1 and CFG2 are writable
+    mHspi.Init.CLKPolarity = ((device.mode & 2U) != 0U) ? SPI_POLARITY_HIGH : SPI_POLARITY_LOW;
+    mHspi.Init.CLKPhase = ((device.mode & 1U) != 0U) ? SPI_PHASE_2EDGE : SPI_PHASE_1EDGE;
+    mHspi.Init.BaudRatePrescaler = static_cast<uint32_t>(device.clockDivider) << SPI_CFG1_MBR_Pos;
+    MODIFY_REG(mHspi.Instance->CFG1, SPI_CFG1_MBR, mHspi.Init.BaudRatePrescaler);
+    MODIFY_REG(mHspi.Instance->CFG2, SPI_CFG2_CPOL | SPI_CFG2_CPHA, mHspi.Init.CLKPolarity | mHspi.Init.CLKPhase);
+    return Status::OK;
+}
+
+
+void SpiPortHal::SetChipSelect(uint8_t chipSelect, bool active)
+{
+    if (chipSelect < mPinCount)
+    {
+        HAL_GPIO_WritePin(mPins[chipSelect].pPort, mPins[chipSelect].pin, active ? GPIO_PIN_RESET : GPIO_PIN_SET);
+    }
+}
+
+
+Status SpiPortHal::Start(const SpiSegment& segment)
+{
+    if ((segment.pTx == nullptr) || (segment.length == 0U) || (segment.length > MAX_TRANSFER_FRAMES))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mTxRearm = false;
+    mRxRearm = false;
+    mFullDuplex = segment.pRx != nullptr;
+    const uint16_t size = static_cast<uint16_t>(segment.length);
+    const HAL_StatusTypeDef result = mFullDuplex ?
+        HAL_SPI_TransmitReceive_DMA(&mHspi, segment.pTx, segment.pRx, size) :
+        HAL_SPI_Transmit_DMA(&mHspi, segment.pTx, size);
+    if (result == HAL_BUSY)
+    {
+        return Status::BUSY;
+    }
+    return (result == HAL_OK) ? Status::OK : Status::HW_ERROR;
+}
+
+
+bool SpiPortHal::Reload(const SpiSegment& segment)
+{
+    // TSER must be free and the TX stream still running, else its completion has passed already
+    if (!mFullDuplex || mStreaming || mTxRearm || mRxRearm || (segment.pTx == nullptr) ||
+        (segment.pRx == nullptr) || (segment.length == 0U) || (segment.length > MAX_TRANSFER_FRAMES) ||
+        (mHspi.State != HAL_SPI_STATE_BUSY_TX_RX) || ((READ_REG(mHspi.Instance->CR2) & SPI_CR2_TSER) != 0U) ||
+        (__HAL_DMA_GET_COUNTER(mHspi.hdmatx) == 0U))
+    {
+        return false;
+    }
+    mNext = segment;
+    mTxRearm = true;
+    mRxRearm = true;
+    mHspi.hdmatx->XferCpltCallback = &TxDmaComplete;
+    mHspi.hdmarx->XferCpltCallback = &RxDmaComplete;
+    MODIFY_REG(mHspi.Instance->CR2, SPI_CR2_TSER, segment.length << SPI_CR2_TSER_Pos);
+    return true;
+}
+
+
+Status SpiPortHal::StartStream(const SpiSegment& buffer)
+{
+    if ((buffer.pTx == nullptr) || (buffer.pRx == nullptr) || (buffer.length < 2U) || ((buffer.length % 2U) != 0U) ||
+        (buffer.length > MAX_TRANSFER_FRAMES))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mHspi.State != HAL_SPI_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    if (!SetCircular(true))
+    {
+        return Status::HW_ERROR;
+    }
+    mStreaming = true;
+    if (HAL_SPI_TransmitReceive_DMA(&mHspi, buffer.pTx, buffer.pRx, static_cast<uint16_t>(buffer.length)) != HAL_OK)
+    {
+        mStreaming = false;
+        (void)SetCircular(false);
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+void SpiPortHal::StopStream()
+{
+    if (!mStreaming)
+    {
+        return;
+    }
+    (void)HAL_SPI_Abort(&mHspi);
+    mStreaming = false;
+    (void)SetCircular(false);
+}
+
+
+void SpiPortHal::OnComplete()
+{
+    if (mStreaming)
+    {
+        if (mpListener != nullptr)
+        {
+            mpListener->OnStreamHalf(1U);
+        }
+        return;
+    }
+    Notify(Status::OK);
+}
+
+
+void SpiPortHal::OnHalfComplete()
+{
+    if (mStreaming && (mpListener != nullptr))
+    {
+        mpListener->OnStreamHalf(0U);
+    }
+}
+
+
+void SpiPortHal::OnError()
+{
+    mTxRearm = false;
+    mRxRearm = false;
+    if (!mStreaming)
+    {
+        Notify(Status::HW_ERROR);
+    }
+}
+
+
+void SpiPortHal::OnTxDma()
+{
+    if (!mTxRearm)
+    {
+        return;
+    }
+    mTxRearm = false;
+    if (HAL_DMA_Start_IT(mHspi.hdmatx, reinterpret_cast<uint32_t>(mNext.pTx),
+                         reinterpret_cast<uint32_t>(&mHspi.Instance->TXDR), mNext.length) != HAL_OK)
+    {
+        (void)HAL_SPI_Abort(&mHspi);
+        mRxRearm = false;
+        Notify(Status::HW_ERROR);
+    }
+}
+
+
+void SpiPortHal::OnRxDma()
+{
+    if (!mRxRearm)
+    {
+        // the last segment ends with EOT like a transfer without reload
+        __HAL_SPI_ENABLE_IT(&mHspi, SPI_IT_EOT);
+        return;
+    }
+    mRxRearm = false;
+    SET_BIT(mHspi.Instance->IFCR, SPI_IFCR_TSERFC);
+    if (HAL_DMA_Start_IT(mHspi.hdmarx, reinterpret_cast<uint32_t>(&mHspi.Instance->RXDR),
+                         reinterpret_cast<uint32_t>(mNext.pRx), mNext.length) != HAL_OK)
+    {
+        (void)HAL_SPI_Abort(&mHspi);
+        Notify(Status::HW_ERROR);
+        return;
+    }
+    // the segment before the reload has ended, the reloaded one runs
+    Notify(Status::OK);
+}
+
+
+SpiPortHal* SpiPortHal::GetInstance(const SPI_HandleTypeDef* hspi)
+{
+    for (SpiPortHal* pInstance : sInstances)
+    {
+        if ((pInstance != nullptr) && (&pInstance->mHspi == hspi))
+        {
+            return pInstance;
+        }
+    }
+    return nullptr;
+}
+
+
+bool SpiPortHal::SetCircular(bool circular)
+{
+    const uint32_t mode = circular ? DMA_CIRCULAR : DMA_NORMAL;
+    mHspi.hdmatx->Init.Mode = mode;
+    mHspi.hdmarx->Init.Mode = mode;
+    return (HAL_DMA_Init(mHspi.hdmatx) == HAL_OK) && (HAL_DMA_Init(mHspi.hdmarx) == HAL_OK);
+}
+
+
+void SpiPortHal::Notify(Status status)
+{
+    if (mpListener != nullptr)
+    {
+        mpListener->OnSegmentDone(status);
+    }
+}
+
+
+extern "C" void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiPortHal* pPort = SpiPortHal::GetInstance(hspi);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiPortHal* pPort = SpiPortHal::GetInstance(hspi);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_SPI_TxRxHalfCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiPortHal* pPort = SpiPortHal::GetInstance(hspi);
+    if (pPort != nullptr)
+    {
+        pPort->OnHalfComplete();
+    }
+}
+
+
+extern "C" void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiPortHal* pPort = SpiPortHal::GetInstance(hspi);
+    if (pPort != nullptr)
+    {
+        pPort->OnError();
+    }
+}
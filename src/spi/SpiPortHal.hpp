@@ -0,0 +1,146 @@
+/**
+ ********************************************************************************
+ * @file        SpiPortHal.hpp
+ *
+ * @namespace   Spi
+ *
+ * @brief       Spi, ISpiPort on the SPI peripheral through HAL_SPI and HAL_DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISpiPort.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace Spi {
+
+
+/// @brief GPIO of a chip select line, active low.
+struct ChipSelectPin
+{
+    GPIO_TypeDef* pPort{nullptr};   //!< GPIO port
+    uint16_t pin{0U};               //!< GPIO_PIN_x
+};
+
+
+/**
+ * @brief   This class provides the ISpiPort on an SPI instance with DMA.
+ * @details A segment is started with HAL_SPI_TransmitReceive_DMA (HAL_SPI_Transmit_DMA without receive
+ *          buffer) and ends with HAL_SPI_TxRxCpltCallback on EOT.\n
+ *          Reload writes the next length into TSER, the SPI loads it into TSIZE when the running count ends
+ *          and continues without EOT. The DMA completion callbacks of the streams are replaced for this
+ *          segment: the TX stream is re-armed when it has pushed its last frame into the FIFO, the RX
+ *          stream when it has read its last frame, which also reports the segment end. The SPI FIFO
+ *          bridges the interrupt latency. HAL_SPI_Reload_TransmitReceive_IT is not used, it needs
+ *          USE_SPI_RELOAD_TRANSFER and moves every frame by interrupt.\n
+ *          The stream switches both DMA streams to circular mode, HAL_SPI_TransmitReceive_DMA then runs
+ *          with TSIZE = 0 (endless) and the half / complete callbacks report the halves.
+ * @note    The application initialises the handle (master, full duplex, DataSize, software NSS) and
+ *          links both DMA handles with HAL_SPI_Init. Reload needs full duplex segments. Converters which
+ *          sample on a chip select edge in stream mode use the hardware NSS with pulse mode (NSSPMode)
+ *          instead of a chip select line. SPI1 to SPI6 may have one instance each.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class SpiPortHal : public ISpiPort
+{
+    public:
+
+        /**
+         * @brief   Constructs the port.
+         *
+         * @param   hspi    The initialised SPI handle with linked DMA handles.
+         * @param   pPins   Chip select lines, index is SpiDevice::chipSelect, driven inactive (high).
+         * @param   count   Count of lines, at most MAX_CHIP_SELECTS.
+         */
+        SpiPortHal(SPI_HandleTypeDef& hspi, const ChipSelectPin* pPins, size_t count);
+
+        /// @brief Destructor.
+        ~SpiPortHal() override;
+
+        SpiPortHal(SpiPortHal const &) = delete;             //!< Copy constructor
+        SpiPortHal& operator=(SpiPortHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc ISpiPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ISpiPort::Configure
+        Status Configure(const SpiDevice& device) override;
+
+        /// @copydoc ISpiPort::SetChipSelect
+        void SetChipSelect(uint8_t chipSelect, bool active) override;
+
+        /// @copydoc ISpiPort::Start
+        Status Start(const SpiSegment& segment) override;
+
+        /// @copydoc ISpiPort::Reload
+        bool Reload(const SpiSegment& segment) override;
+
+        /// @copydoc ISpiPort::StartStream
+        Status StartStream(const SpiSegment& buffer) override;
+
+        /// @copydoc ISpiPort::StopStream
+        void StopStream() override;
+
+        /// @brief HAL_SPI_TxRxCpltCallback / HAL_SPI_TxCpltCallback.
+        void OnComplete();
+
+        /// @brief HAL_SPI_TxRxHalfCpltCallback.
+        void OnHalfComplete();
+
+        /// @brief HAL_SPI_ErrorCallback.
+        void OnError();
+
+        /// @brief TX DMA stream complete during a reload.
+        void OnTxDma();
+
+        /// @brief RX DMA stream complete during a reload.
+        void OnRxDma();
+
+        /// @brief The instance of a handle or nullptr.
+        static SpiPortHal* GetInstance(const SPI_HandleTypeDef* hspi);
+
+    private:
+
+        /// @brief Count of SPI peripherals.
+        static constexpr size_t INSTANCE_COUNT{6U};
+
+        /// @brief Switch both DMA streams between normal and circular mode.
+        bool SetCircular(bool circular);
+
+        /// @brief Report the end of a segment.
+        void Notify(Status status);
+
+        /// @brief The SPI handle.
+        SPI_HandleTypeDef& mHspi;
+
+        /// @brief Chip select lines.
+        std::array<ChipSelectPin, MAX_CHIP_SELECTS> mPins{};
+
+        /// @brief Count of chip select lines.
+        size_t mPinCount{0U};
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        /// @brief The reloaded segment.
+        SpiSegment mNext{};
+
+        volatile bool mTxRearm{false};      //!< TX stream waits for the reloaded segment
+        volatile bool mRxRearm{false};      //!< RX stream waits for the reloaded segment
+        bool mFullDuplex{false};            //!< The running segment receives
+        bool mStreaming{false};             //!< The stream runs
+
+        /// @brief The instances of SPI1 to SPI6.
+        static std::array<SpiPortHal*, INSTANCE_COUNT> sInstances;
+};
+
+} // end namespace Spi
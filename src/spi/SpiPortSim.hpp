@@ -0,0 +1,316 @@
+/**
+ ********************************************************************************
+ * @file        SpiPortSim.hpp
+ *
+ * @namespace   Spi
+ *
+ * @brief       Spi, host simulation of an SPI master with DMA and TSIZE reload.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ISpiPort.hpp"
+namespace Spi {
+
+
+/**
+ * @brief   This class provides an ISpiPort which clocks the frames on the host.
+ * @details The bus side (@ref Clock) exchanges one frame per step with the responder of the selected device
+ *          (loopback without responder, 0xFF without selected device). A segment ends after its last frame,
+ *          a reloaded segment continues in the next step like TSER is loaded into TSIZE. A reload is refused
+ *          if fewer than the reload margin frames remain, which models the interrupt latency of the target.\n
+ *          The stream runs through the circular buffer and signals each half, the listener is called
+ *          synchronously like the interrupt.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class SpiPortSim : public ISpiPort
+{
+    public:
+
+        /// @brief Device model: the received frame for a transmitted one.
+        using Responder = uint8_t (*)(uint8_t chipSelect, uint8_t tx, void* pContext);
+
+        /// @brief Constructor.
+        SpiPortSim() = default;
+
+        SpiPortSim(SpiPortSim const &) = delete;             //!< Copy constructor
+        SpiPortSim& operator=(SpiPortSim const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Set the device model.
+         *
+         * @param   pResponder  The responder, nullptr for loopback.
+         * @param   pContext    User context passed to the responder.
+         */
+        void SetResponder(Responder pResponder, void* pContext)
+        {
+            mpResponder = pResponder;
+            mpContext = pContext;
+        }
+
+        /// @brief A reload needs at least this count of frames left in the running segment.
+        void SetReloadMargin(uint32_t frames) {mReloadMargin = frames;};
+
+        /**
+         * @brief   Bus side: clock frames.
+         *
+         * @param   frames  Maximum count of frames.
+         *
+         * @return  Count of clocked frames, less if the bus became idle.
+         */
+        size_t Clock(size_t frames)
+        {
+            size_t clocked = 0U;
+            while (clocked < frames)
+            {
+                if (mStreaming)
+                {
+                    Exchange(mStream, mStreamPos);
+                    mStreamPos++;
+                    clocked++;
+                    const uint32_t half = mStream.length / 2U;
+                    if ((mStreamPos == half) || (mStreamPos == mStream.length))
+                    {
+                        const uint8_t filled = (mStreamPos == half) ? 0U : 1U;
+                        mStreamPos = (mStreamPos == mStream.length) ? 0U : mStreamPos;
+                        if (mpListener != nullptr)
+                        {
+                            mpListener->OnStreamHalf(filled);
+                        }
+                    }
+                    continue;
+                }
+                if (!mActive)
+                {
+                    break;
+                }
+                Exchange(mCurrent, mPos);
+                mPos++;
+                clocked++;
+                if (mPos == mCurrent.length)
+                {
+                    if (mReloadPending)
+                    {
+                        // TSER is loaded into TSIZE, the next frame follows without gap
+                        mCurrent = mNext;
+                        mReloadPending = false;
+                    }
+                    else
+                    {
+                        mActive = false;
+                    }
+                    mPos = 0U;
+                    if (mpListener != nullptr)
+                    {
+                        mpListener->OnSegmentDone(Status::OK);
+                    }
+                }
+            }
+            mFrames += clocked;
+            return clocked;
+        }
+
+        /// @brief Clock until the segments have ended, a running stream is not clocked.
+        size_t RunToIdle()
+        {
+            size_t clocked = 0U;
+            while (mActive && !mStreaming)
+            {
+                clocked += Clock(1U);
+            }
+            return clocked;
+        }
+
+        /// @copydoc ISpiPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ISpiPort::Configure
+        Status Configure(const SpiDevice& device) override
+        {
+            if (mActive || mStreaming)
+            {
+                return Status::BUSY;
+            }
+            if ((device.mode > 3U) || (device.clockDivider > 7U))
+            {
+                return Status::INVALID_PARAM;
+            }
+            mDevice = device;
+            mConfigures++;
+            return Status::OK;
+        }
+
+        /// @copydoc ISpiPort::SetChipSelect
+        void SetChipSelect(uint8_t chipSelect, bool active) override
+        {
+            if (chipSelect >= MAX_CHIP_SELECTS)
+            {
+                return;
+            }
+            if (active && !mSelected[chipSelect])
+            {
+                mSelects[chipSelect]++;
+            }
+            mSelected[chipSelect] = active;
+        }
+
+        /// @copydoc ISpiPort::Start
+        Status Start(const SpiSegment& segment) override
+        {
+            if (mActive || mStreaming)
+            {
+                return Status::BUSY;
+            }
+            if (!IsValid(segment))
+            {
+                return Status::INVALID_PARAM;
+            }
+            mCurrent = segment;
+            mPos = 0U;
+            mActive = true;
+            mStarts++;
+            return Status::OK;
+        }
+
+        /// @copydoc ISpiPort::Reload
+        bool Reload(const SpiSegment& segment) override
+        {
+            if (!mActive || mReloadPending || !IsValid(segment) || ((mCurrent.length - mPos) < mReloadMargin))
+            {
+                return false;
+            }
+            mNext = segment;
+            mReloadPending = true;
+            mReloads++;
+            return true;
+        }
+
+        /// @copydoc ISpiPort::StartStream
+        Status StartStream(const SpiSegment& buffer) override
+        {
+            if (mActive || mStreaming)
+            {
+                return Status::BUSY;
+            }
+            if (!IsValid(buffer) || (buffer.pRx == nullptr) || (buffer.length < 2U) || ((buffer.length % 2U) != 0U))
+            {
+                return Status::INVALID_PARAM;
+            }
+            mStream = buffer;
+            mStreamPos = 0U;
+            mStreaming = true;
+            return Status::OK;
+        }
+
+        /// @copydoc ISpiPort::StopStream
+        void StopStream() override {mStreaming = false;};
+
+        /// @brief A segment or the stream runs.
+        bool IsBusy() const {return mActive || mStreaming;};
+
+        /// @brief State of a chip select line.
+        bool IsSelected(uint8_t chipSelect) const {return (chipSelect < MAX_CHIP_SELECTS) && mSelected[chipSelect];};
+
+        /// @brief Count of activations of a chip select line.
+        uint32_t GetSelects(uint8_t chipSelect) const
+        {
+            return (chipSelect < MAX_CHIP_SELECTS) ? mSelects[chipSelect] : 0U;
+        };
+
+        /// @brief The last configuration.
+        const SpiDevice& GetDevice() const {return mDevice;};
+
+        /// @brief Segments started with a fresh setup.
+        uint32_t GetStarts() const {return mStarts;};
+
+        /// @brief Segments appended by reload.
+        uint32_t GetReloads() const {return mReloads;};
+
+        /// @brief Count of Configure calls.
+        uint32_t GetConfigures() const {return mConfigures;};
+
+        /// @brief Clocked frames.
+        size_t GetFrames() const {return mFrames;};
+
+    private:
+
+        /// @brief Length, transmit data and receive buffer of a segment.
+        static bool IsValid(const SpiSegment& segment)
+        {
+            return (segment.pTx != nullptr) && (segment.length > 0U) && (segment.length <= MAX_TRANSFER_FRAMES);
+        }
+
+        /// @brief Exchange one frame with the selected device.
+        void Exchange(const SpiSegment& segment, uint32_t pos)
+        {
+            uint8_t chipSelect = 0xFFU;
+            for (uint8_t i = 0U; i < MAX_CHIP_SELECTS; i++)
+            {
+                if (mSelected[i])
+                {
+                    chipSelect = i;
+                    break;
+                }
+            }
+            const uint8_t tx = segment.pTx[pos];
+            uint8_t rx = 0xFFU;
+            if (chipSelect != 0xFFU)
+            {
+                rx = (mpResponder != nullptr) ? mpResponder(chipSelect, tx, mpContext) : tx;
+            }
+            if (segment.pRx != nullptr)
+            {
+                segment.pRx[pos] = rx;
+            }
+        }
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        /// @brief Device model.
+        Responder mpResponder{nullptr};
+
+        /// @brief User context of the responder.
+        void* mpContext{nullptr};
+
+        /// @brief Running segment.
+        SpiSegment mCurrent{};
+
+        /// @brief Reloaded segment.
+        SpiSegment mNext{};
+
+        /// @brief Stream buffer.
+        SpiSegment mStream{};
+
+        /// @brief Last configuration.
+        SpiDevice mDevice{};
+
+        /// @brief Chip select states.
+        std::array<bool, MAX_CHIP_SELECTS> mSelected{};
+
+        /// @brief Chip select activations.
+        std::array<uint32_t, MAX_CHIP_SELECTS> mSelects{};
+
+        uint32_t mPos{0U};              //!< Next frame of the segment
+        uint32_t mStreamPos{0U};        //!< Next frame of the stream
+        uint32_t mReloadMargin{1U};     //!< Frames needed for a reload
+        bool mActive{false};            //!< A segment runs
+        bool mReloadPending{false};     //!< TSER is loaded
+        bool mStreaming{false};         //!< The stream runs
+
+        uint32_t mStarts{0U};           //!< Fresh setups
+        uint32_t mReloads{0U};          //!< Reloads
+        uint32_t mConfigures{0U};       //!< Configure calls
+        size_t mFrames{0U};             //!< Clocked frames
+};
+
+} // end namespace Spi
@@ -0,0 +1,92 @@
+/**
+ ********************************************************************************
+ * @file        SpiTypes.hpp
+ *
+ * @namespace   Spi
+ *
+ * @brief       Spi, common types of the SPI transaction engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+namespace Spi {
+
+
+/// @brief Chip select lines of one bus.
+constexpr size_t MAX_CHIP_SELECTS{8U};
+
+/// @brief Largest transfer in data frames (TSIZE, 0 is reserved for endless transfers).
+constexpr uint32_t MAX_TRANSFER_FRAMES{0xFFFFU};
+
+
+/// @brief Result of an SPI operation.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The bus is busy, retry later
+    INVALID_PARAM=2,  //!< Inconsistent parameter
+    HW_ERROR=3,       //!< The SPI or DMA reported an error
+    PENDING=4         //!< Transfer is queued or running
+};
+
+
+/**
+ * @brief   One device on the bus.
+ * @details The lengths of all transfers count data frames of the DataSize of the bus (bytes for 8 bit).
+ *          Mode and clock are applied when the bus changes to the device.
+ */
+struct SpiDevice
+{
+    uint8_t chipSelect{0U};     //!< Chip select line
+    uint8_t mode{0U};           //!< SPI mode 0..3 (CPOL << 1 | CPHA)
+    uint8_t clockDivider{0U};   //!< MBR: kernel clock / 2^(n+1), 0..7
+};
+
+
+/// @brief One DMA segment of the port.
+struct SpiSegment
+{
+    const uint8_t* pTx{nullptr};    //!< Transmit frames
+    uint8_t* pRx{nullptr};          //!< Receive frames, nullptr for transmit only
+    uint32_t length{0U};            //!< Data frames
+};
+
+
+/**
+ * @brief   Descriptor of one transfer.
+ * @details The descriptor and the buffers are owned by the caller and must stay valid until the completion
+ *          callback has been called (or @ref status left PENDING).\n
+ *          With keepSelected the chip select stays active after the transfer, a following transfer of the same
+ *          device is chained to it: it starts without gap by TSIZE reload if the port supports it. A transfer
+ *          of another device releases the chip select before it starts.
+ * @note    The buffers must be located in a DMA accessible RAM (not DTCM) and 32 byte aligned for the D-Cache.
+ */
+struct SpiTransfer
+{
+    /// @brief Completion callback, called in the bus completion context (ISR on the target).
+    using Callback = void (*)(SpiTransfer& transfer, void* pContext);
+
+    const SpiDevice* pDevice{nullptr};  //!< Device, must stay valid until completion
+    const uint8_t* pTx{nullptr};        //!< Transmit frames
+    uint8_t* pRx{nullptr};              //!< Receive frames, nullptr for transmit only
+    uint32_t length{0U};                //!< Data frames, 1 to MAX_TRANSFER_FRAMES
+    bool keepSelected{false};           //!< Chip select stays active into the next transfer
+
+    Callback pCallback{nullptr};        //!< Optional completion callback
+    void* pContext{nullptr};            //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or running.
+    volatile Status status{Status::OK};
+
+    /// @brief Intrusive queue link, owned by the bus.
+    SpiTransfer* pNext{nullptr};
+};
+
+} // end namespace Spi
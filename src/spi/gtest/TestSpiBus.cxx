@@ -0,0 +1,248 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../SpiBus.hpp"
+#include "../SpiPortSim.hpp"
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Spi;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  QueuesDevicesAndTogglesChipSelect
+*   (0)  ChainsTransfersByReload
+*   (0)  StreamsHalvesWithoutGap
+*   (0)  RejectsInvalidTransfers
+*/
+
+namespace {
+
+/// @brief Device model: records the bus and answers with tx ^ (0x11 * (chipSelect + 1)).
+struct Wire
+{
+    std::vector<uint8_t> chipSelects;
+    std::vector<uint8_t> frames;
+    uint8_t counter{0U};
+};
+
+uint8_t Respond(uint8_t chipSelect, uint8_t tx, void* pContext)
+{
+    Wire& wire = *static_cast<Wire*>(pContext);
+    wire.chipSelects.push_back(chipSelect);
+    wire.frames.push_back(tx);
+    return static_cast<uint8_t>(tx ^ (0x11U * (chipSelect + 1U)));
+}
+
+/// @brief Converter model: a running sample counter.
+uint8_t Sample(uint8_t chipSelect, uint8_t tx, void* pContext)
+{
+    (void)chipSelect;
+    (void)tx;
+    Wire& wire = *static_cast<Wire*>(pContext);
+    return wire.counter++;
+}
+
+/// @brief Status of a transfer, a copy of the volatile field.
+Status StatusOf(const SpiTransfer& transfer)
+{
+    return transfer.status;
+}
+
+/// @brief Counts the completions.
+void CountDone(SpiTransfer& transfer, void* pContext)
+{
+    (void)transfer;
+    (*static_cast<uint32_t*>(pContext))++;
+}
+
+/// @brief Collects the stream halves.
+class Collector : public SpiBus::IStreamHandler
+{
+    public:
+        void OnStreamData(const uint8_t* pData, uint32_t length) override
+        {
+            samples.insert(samples.end(), pData, pData + length);
+        }
+
+        std::vector<uint8_t> samples;
+};
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(SpiBus_Test, QueuesDevicesAndTogglesChipSelect)
+{
+    SpiPortSim port;
+    Wire wire;
+    port.SetResponder(&Respond, &wire);
+    SpiBus bus(port);
+
+    const SpiDevice flash{0U, 0U, 1U};
+    const SpiDevice sensor{1U, 3U, 3U};
+    const std::array<uint8_t, 4> command{0x9FU, 0x01U, 0x02U, 0x03U};
+    std::array<uint8_t, 4> rxA{};
+    std::array<uint8_t, 2> rxB{};
+    uint32_t done = 0U;
+
+    SpiTransfer a{&flash, command.data(), rxA.data(), 4U, false, &CountDone, &done};
+    SpiTransfer b{&sensor, command.data(), rxB.data(), 2U, false, &CountDone, &done};
+    SpiTransfer c{&flash, command.data(), nullptr, 3U, false, &CountDone, &done};
+    ASSERT_EQ(Status::OK, bus.Submit(a));
+    ASSERT_EQ(Status::OK, bus.Submit(b));
+    ASSERT_EQ(Status::OK, bus.Submit(c));
+
+    // the first transfer runs at once, the others wait
+    EXPECT_TRUE(port.IsSelected(0U));
+    EXPECT_EQ(2U, bus.GetQueued());
+    EXPECT_EQ(Status::PENDING, StatusOf(a));
+
+    EXPECT_EQ(9U, port.RunToIdle());
+    EXPECT_TRUE(bus.IsIdle());
+    EXPECT_EQ(3U, done);
+    EXPECT_EQ(Status::OK, StatusOf(c));
+    EXPECT_EQ(3U, bus.GetSetups());
+    EXPECT_EQ(3U, port.GetConfigures());
+    EXPECT_EQ(2U, port.GetSelects(0U));
+    EXPECT_EQ(1U, port.GetSelects(1U));
+    EXPECT_FALSE(port.IsSelected(0U));
+    EXPECT_FALSE(port.IsSelected(1U));
+    EXPECT_EQ(1U, port.GetDevice().clockDivider);
+
+    const std::vector<uint8_t> order{0U, 0U, 0U, 0U, 1U, 1U, 0U, 0U, 0U};
+    EXPECT_EQ(order, wire.chipSelects);
+    EXPECT_EQ(0x9FU ^ 0x11U, rxA[0]);
+    EXPECT_EQ(0x01U ^ 0x22U, rxB[1]);
+}
+
+
+TEST(SpiBus_Test, ChainsTransfersByReload)
+{
+    SpiPortSim port;
+    Wire wire;
+    port.SetResponder(&Respond, &wire);
+    SpiBus bus(port);
+
+    const SpiDevice flash{2U, 0U, 0U};
+    const std::array<uint8_t, 4> read{0x0BU, 0x00U, 0x10U, 0x00U};
+    const std::array<uint8_t, 8> dummy{};
+    std::array<uint8_t, 4> status{};
+    std::array<uint8_t, 8> page0{};
+    std::array<uint8_t, 8> page1{};
+
+    // command and two data phases under one chip select
+    SpiTransfer command{&flash, read.data(), status.data(), 4U, true};
+    SpiTransfer data0{&flash, dummy.data(), page0.data(), 8U, true};
+    SpiTransfer data1{&flash, dummy.data(), page1.data(), 8U, false};
+    ASSERT_EQ(Status::OK, bus.Submit(command));
+    ASSERT_EQ(Status::OK, bus.Submit(data0));
+    ASSERT_EQ(Status::OK, bus.Submit(data1));
+    EXPECT_EQ(20U, port.RunToIdle());
+
+    EXPECT_EQ(1U, port.GetStarts());
+    EXPECT_EQ(2U, port.GetReloads());
+    EXPECT_EQ(2U, bus.GetChained());
+    EXPECT_EQ(1U, port.GetSelects(2U));
+    EXPECT_FALSE(port.IsSelected(2U));
+    EXPECT_EQ(0x33U, page1[7]);
+    EXPECT_EQ(Status::OK, StatusOf(data1));
+
+    // a reload too close to the end falls back to a fresh setup, the chip select is still held
+    port.SetReloadMargin(100U);
+    data0.keepSelected = false;
+    ASSERT_EQ(Status::OK, bus.Submit(command));
+    ASSERT_EQ(Status::OK, bus.Submit(data0));
+    EXPECT_EQ(12U, port.RunToIdle());
+    EXPECT_EQ(3U, port.GetStarts());
+    EXPECT_EQ(2U, port.GetSelects(2U));
+    EXPECT_FALSE(port.IsSelected(2U));
+}
+
+
+TEST(SpiBus_Test, StreamsHalvesWithoutGap)
+{
+    SpiPortSim port;
+    Wire wire;
+    port.SetResponder(&Sample, &wire);
+    SpiBus bus(port);
+    Collector collector;
+
+    const SpiDevice adc{3U, 0U, 0U};
+    const std::array<uint8_t, 32> convert{};
+    std::array<uint8_t, 32> buffer{};
+    ASSERT_EQ(Status::OK, bus.StartStream(adc, convert.data(), buffer.data(), 16U, collector));
+    EXPECT_EQ(Status::BUSY, bus.StartStream(adc, convert.data(), buffer.data(), 16U, collector));
+
+    // a transfer submitted during the stream waits
+    const SpiDevice other{0U, 0U, 0U};
+    std::array<uint8_t, 2> rx{};
+    SpiTransfer transfer{&other, convert.data(), rx.data(), 2U};
+    ASSERT_EQ(Status::OK, bus.Submit(transfer));
+
+    EXPECT_EQ(96U, port.Clock(96U));
+    EXPECT_EQ(6U, bus.GetStreamHalves());
+    ASSERT_EQ(96U, collector.samples.size());
+    for (size_t i = 0U; i < collector.samples.size(); i++)
+    {
+        EXPECT_EQ(static_cast<uint8_t>(i), collector.samples[i]);
+    }
+    EXPECT_EQ(Status::PENDING, StatusOf(transfer));
+    EXPECT_EQ(1U, port.GetSelects(3U));
+
+    bus.StopStream();
+    EXPECT_FALSE(port.IsSelected(3U));
+    EXPECT_EQ(2U, port.RunToIdle());
+    EXPECT_EQ(Status::OK, StatusOf(transfer));
+    EXPECT_TRUE(bus.IsIdle());
+}
+
+
+TEST(SpiBus_Test, RejectsInvalidTransfers)
+{
+    SpiPortSim port;
+    SpiBus bus(port);
+    const std::array<uint8_t, 4> tx{};
+    const SpiDevice device{0U, 0U, 0U};
+    const SpiDevice badSelect{MAX_CHIP_SELECTS, 0U, 0U};
+    const SpiDevice badMode{0U, 4U, 0U};
+
+    SpiTransfer transfer{nullptr, tx.data(), nullptr, 4U};
+    EXPECT_EQ(Status::INVALID_PARAM, bus.Submit(transfer));
+    transfer.pDevice = &badSelect;
+    EXPECT_EQ(Status::INVALID_PARAM, bus.Submit(transfer));
+    transfer.pDevice = &badMode;
+    EXPECT_EQ(Status::INVALID_PARAM, bus.Submit(transfer));
+    transfer.pDevice = &device;
+    transfer.length = 0U;
+    EXPECT_EQ(Status::INVALID_PARAM, bus.Submit(transfer));
+    transfer.length = MAX_TRANSFER_FRAMES + 1U;
+    EXPECT_EQ(Status::INVALID_PARAM, bus.Submit(transfer));
+
+    transfer.length = 4U;
+    ASSERT_EQ(Status::OK, bus.Submit(transfer));
+    // a pending descriptor must not be queued twice
+    EXPECT_EQ(Status::INVALID_PARAM, bus.Submit(transfer));
+    EXPECT_EQ(Status::BUSY, port.Configure(device));
+
+    std::array<uint8_t, 4> rx{};
+    Collector collector;
+    EXPECT_EQ(Status::BUSY, bus.StartStream(device, tx.data(), rx.data(), 2U, collector));
+    EXPECT_EQ(Status::INVALID_PARAM, bus.StartStream(device, tx.data(), nullptr, 2U, collector));
+    EXPECT_EQ(4U, port.RunToIdle());
+    EXPECT_EQ(Status::OK, StatusOf(transfer));
+}
+
+} // end namespace GTest
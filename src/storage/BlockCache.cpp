@@ -0,0 +1,403 @@
+/**
+ ********************************************************************************
+ * @file        BlockCache.cpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, write-back block cache implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "BlockCache.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace Storage;
+
+
+BlockCache::BlockCache(IBlockDevice& device, const Config& config)
+: mDevice(device), mConfig(config)
+{
+    mConfig.maxTransfer = std::min(std::max(mConfig.maxTransfer, 1U), MAX_TRANSFER_BLOCKS);
+    mConfig.readAhead = std::min(mConfig.readAhead, mConfig.maxTransfer);
+    mConfig.writeBackThreshold = std::min(std::max(mConfig.writeBackThreshold, 1U), CACHE_BLOCKS);
+    mDevice.SetListener(this);
+}
+
+
+BlockCache::~BlockCache()
+{
+    mDevice.SetListener(nullptr);
+}
+
+
+Status BlockCache::Submit(BlockRequest& request)
+{
+    if (request.status == Status::PENDING)
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (request.operation != BlockOperation::FLUSH)
+    {
+        const uint32_t blocks = mDevice.GetBlockCount();
+        if ((request.pData == nullptr) || (request.count == 0U) || (request.block >= blocks) ||
+            (request.count > (blocks - request.block)))
+        {
+            return Status::INVALID_PARAM;
+        }
+    }
+    request.status = Status::PENDING;
+    request.pNext = nullptr;
+    if (mpTail == nullptr)
+    {
+        mpHead = &request;
+    }
+    else
+    {
+        mpTail->pNext = &request;
+    }
+    mpTail = &request;
+    return Status::OK;
+}
+
+
+bool BlockCache::Service()
+{
+    if ((mTransfer != Transfer::NONE) && mCompleted)
+    {
+        mCompleted = false;
+        EndTransfer(mDoneStatus);
+    }
+    while (mpHead != nullptr)
+    {
+        const Status status = Progress(*mpHead);
+        if (status == Status::PENDING)
+        {
+            break;
+        }
+        Finish(status);
+    }
+    if ((mTransfer == Transfer::NONE) && (mDirty >= mConfig.writeBackThreshold))
+    {
+        (void)StartWriteBack();
+    }
+    return !IsIdle();
+}
+
+
+void BlockCache::OnDone(Status status)
+{
+    // the copies run in the service context, the interrupt only hands over the result
+    mDoneStatus = status;
+    mCompleted = true;
+}
+
+
+Status BlockCache::Progress(BlockRequest& request)
+{
+    switch (request.operation)
+    {
+        case BlockOperation::READ:
+            return ProgressRead(request);
+        case BlockOperation::WRITE:
+            return ProgressWrite(request);
+        default:
+            return ProgressFlush();
+    }
+}
+
+
+Status BlockCache::ProgressRead(BlockRequest& request)
+{
+    while (mDone < request.count)
+    {
+        Line* pLine = Find(request.block + mDone);
+        if (pLine == nullptr)
+        {
+            // one transfer at a time, a miss waits for the running one
+            return (mTransfer == Transfer::NONE) ? StartFetch(request) : Status::PENDING;
+        }
+        (void)std::memcpy(&request.pData[static_cast<size_t>(mDone) * BLOCK_SIZE], DataOf(*pLine), BLOCK_SIZE);
+        Touch(*pLine);
+        mDone++;
+        mHits++;
+    }
+    mReadEnd = request.block + request.count;
+    return Status::OK;
+}
+
+
+Status BlockCache::ProgressWrite(BlockRequest& request)
+{
+    while (mDone < request.count)
+    {
+        const uint32_t block = request.block + mDone;
+        Line* pLine = Find(block);
+        if (pLine == nullptr)
+        {
+            pLine = Allocate(block);
+        }
+        if (pLine == nullptr)
+        {
+            // all lines are dirty, make room by a write-back, a failed one drops its lines
+            if (mTransfer != Transfer::NONE)
+            {
+                return Status::PENDING;
+            }
+            const Status status = StartWriteBack();
+            if ((status == Status::OK) || (status == Status::BUSY))
+            {
+                return Status::PENDING;
+            }
+            continue;
+        }
+        (void)std::memcpy(DataOf(*pLine), &request.pData[static_cast<size_t>(mDone) * BLOCK_SIZE], BLOCK_SIZE);
+        if (!pLine->dirty)
+        {
+            pLine->dirty = true;
+            mDirty++;
+        }
+        Touch(*pLine);
+        mDone++;
+    }
+    return Status::OK;
+}
+
+
+Status BlockCache::ProgressFlush()
+{
+    if (mTransfer != Transfer::NONE)
+    {
+        return Status::PENDING;
+    }
+    if (mDirty != 0U)
+    {
+        (void)StartWriteBack();
+        return Status::PENDING;
+    }
+    const Status status = mWriteError ? Status::HW_ERROR : Status::OK;
+    mWriteError = false;
+    return status;
+}
+
+
+Status BlockCache::StartFetch(const BlockRequest& request)
+{
+    const uint32_t start = request.block + mDone;
+    uint32_t limit = request.count - mDone;
+    if (request.block == mReadEnd)
+    {
+        // the request continues a stream
+        limit += mConfig.readAhead;
+    }
+    limit = std::min({limit, mConfig.maxTransfer, mDevice.GetBlockCount() - start});
+    // the run ends at the next cached block
+    uint32_t count = 1U;
+    while ((count < limit) && (Find(start + count) == nullptr))
+    {
+        count++;
+    }
+    const Status status = mDevice.StartRead(start, mStaging[0].data(), count);
+    if (status == Status::BUSY)
+    {
+        return Status::PENDING;
+    }
+    if (status != Status::OK)
+    {
+        mErrors++;
+        return Status::HW_ERROR;
+    }
+    mTransfer = Transfer::FETCH;
+    mTransferBlock = start;
+    mTransferCount = count;
+    mFetches++;
+    return Status::PENDING;
+}
+
+
+Status BlockCache::StartWriteBack()
+{
+    Line* pOldest = nullptr;
+    for (Line& line : mLines)
+    {
+        if (line.valid && line.dirty && ((pOldest == nullptr) || (line.lastUse < pOldest->lastUse)))
+        {
+            pOldest = &line;
+        }
+    }
+    if (pOldest == nullptr)
+    {
+        return Status::INVALID_PARAM;
+    }
+    // extend the run over the adjacent dirty blocks
+    uint32_t start = pOldest->block;
+    uint32_t count = 1U;
+    while ((count < mConfig.maxTransfer) && (start > 0U))
+    {
+        const Line* pLine = Find(start - 1U);
+        if ((pLine == nullptr) || !pLine->dirty)
+        {
+            break;
+        }
+        start--;
+        count++;
+    }
+    while (count < mConfig.maxTransfer)
+    {
+        const Line* pLine = Find(start + count);
+        if ((pLine == nullptr) || !pLine->dirty)
+        {
+            break;
+        }
+        count++;
+    }
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        (void)std::memcpy(mStaging[i].data(), DataOf(*Find(start + i)), BLOCK_SIZE);
+    }
+    const Status status = mDevice.StartWrite(start, mStaging[0].data(), count);
+    if (status == Status::BUSY)
+    {
+        return status;
+    }
+    // a block written again during the transfer becomes dirty again, a failed block is dropped
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        Line* pLine = Find(start + i);
+        pLine->dirty = false;
+        pLine->busy = (status == Status::OK);
+        pLine->valid = (status == Status::OK);
+    }
+    mDirty -= count;
+    if (status != Status::OK)
+    {
+        mErrors++;
+        mWriteError = true;
+        return Status::HW_ERROR;
+    }
+    mTransfer = Transfer::WRITE_BACK;
+    mTransferBlock = start;
+    mTransferCount = count;
+    mWriteBacks++;
+    mWriteBackBlocks += count;
+    return Status::OK;
+}
+
+
+void BlockCache::EndTransfer(Status status)
+{
+    const Transfer transfer = mTransfer;
+    mTransfer = Transfer::NONE;
+    if (transfer == Transfer::WRITE_BACK)
+    {
+        for (uint32_t i = 0U; i < mTransferCount; i++)
+        {
+            Line* pLine = Find(mTransferBlock + i);
+            if (pLine != nullptr)
+            {
+                pLine->busy = false;
+                // the card may hold anything, the next read fetches it, a newer write is written again
+                pLine->valid = (status == Status::OK) || pLine->dirty;
+            }
+        }
+        if (status != Status::OK)
+        {
+            mErrors++;
+            mWriteError = true;
+        }
+        return;
+    }
+    // a fetch belongs to the oldest request
+    if (status != Status::OK)
+    {
+        mErrors++;
+        Finish(Status::HW_ERROR);
+        return;
+    }
+    BlockRequest& request = *mpHead;
+    const uint32_t requested = std::min(mTransferCount, request.count - mDone);
+    for (uint32_t i = 0U; i < mTransferCount; i++)
+    {
+        const uint8_t* pBlock = mStaging[i].data();
+        if (i < requested)
+        {
+            (void)std::memcpy(&request.pData[static_cast<size_t>(mDone + i) * BLOCK_SIZE], pBlock, BLOCK_SIZE);
+        }
+        const uint32_t block = mTransferBlock + i;
+        Line* pLine = (Find(block) == nullptr) ? Allocate(block) : nullptr;
+        if (pLine != nullptr)
+        {
+            (void)std::memcpy(DataOf(*pLine), pBlock, BLOCK_SIZE);
+        }
+    }
+    mDone += requested;
+    mMisses += requested;
+    mReadAheadBlocks += mTransferCount - requested;
+}
+
+
+void BlockCache::Finish(Status status)
+{
+    BlockRequest& request = *mpHead;
+    mpHead = request.pNext;
+    if (mpHead == nullptr)
+    {
+        mpTail = nullptr;
+    }
+    mDone = 0U;
+    request.pNext = nullptr;
+    request.status = status;
+    if (request.pCallback != nullptr)
+    {
+        request.pCallback(request, request.pContext);
+    }
+}
+
+
+BlockCache::Line* BlockCache::Find(uint32_t block)
+{
+    for (Line& line : mLines)
+    {
+        if (line.valid && (line.block == block))
+        {
+            return &line;
+        }
+    }
+    return nullptr;
+}
+
+
+BlockCache::Line* BlockCache::Allocate(uint32_t block)
+{
+    Line* pVictim = nullptr;
+    for (Line& line : mLines)
+    {
+        if (!line.valid)
+        {
+            pVictim = &line;
+            break;
+        }
+        if (!line.dirty && !line.busy && ((pVictim == nullptr) || (line.lastUse < pVictim->lastUse)))
+        {
+            pVictim = &line;
+        }
+    }
+    if (pVictim != nullptr)
+    {
+        pVictim->block = block;
+        pVictim->valid = true;
+        pVictim->dirty = false;
+        pVictim->busy = false;
+        Touch(*pVictim);
+    }
+    return pVictim;
+}
+
+
+uint8_t* BlockCache::DataOf(const Line& line)
+{
+    return mData[static_cast<size_t>(&line - mLines.data())].data();
+}
@@ -0,0 +1,230 @@
+/**
+ ********************************************************************************
+ * @file        BlockCache.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, write-back block cache with merged multi-block transfers.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IBlockDevice.hpp"
+namespace Storage {
+
+
+/**
+ * @brief   This class caches the blocks of a card and merges the requests into multi-block transfers.
+ * @details Requests are queued by @ref Submit and processed in their order by @ref Service, which also calls
+ *          the completion callbacks. The interrupt of the card only signals the end of a transfer, the block
+ *          copies run in the service context.\n
+ *          Read: cached blocks are copied from the cache. A miss fetches the uncached run of the request with
+ *          one transfer (CMD18 for more than one block). A request which starts at the end of the previous
+ *          read continues a stream, its fetch is extended by the read-ahead blocks. The fetched blocks are
+ *          kept in the cache.\n
+ *          Write: the blocks are copied into the cache and marked dirty, the request is completed at once.
+ *          The write-back takes the least recently used dirty block and the dirty blocks adjacent to it and
+ *          writes them with one transfer (CMD25). It runs in the background when the dirty blocks reach the
+ *          threshold, or when a block has to be evicted and only dirty blocks are left.\n
+ *          Flush: completes when all dirty blocks are written, with HW_ERROR if a write-back has failed since
+ *          the last flush. The blocks of a failed write-back are dropped from the cache, the next read fetches
+ *          them from the card (a block written again meanwhile stays dirty).\n
+ *          The blocks are replaced least recently used, dirty blocks and blocks in a running write-back stay.
+ * @note    The cache and the transfer buffer are members (64 KB), a static instance is placed in RAM_D1
+ *          (section .bss), which the SDMMC1 IDMA reaches. Do not place it in the DTCM.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * Submit and Service must be called from one context, the device completion may run in an ISR.
+ *
+ */
+class BlockCache : private IBlockDevice::IListener
+{
+    public:
+
+        /// @brief Blocks in the cache.
+        static constexpr uint32_t CACHE_BLOCKS{64U};
+
+        /// @brief Upper limit of the blocks of one transfer.
+        static constexpr uint32_t MAX_TRANSFER_BLOCKS{64U};
+
+        /// @brief Cache parameters.
+        struct Config
+        {
+            uint32_t maxTransfer{MAX_TRANSFER_BLOCKS};  //!< Blocks of one transfer, 1 to MAX_TRANSFER_BLOCKS
+            uint32_t readAhead{16U};                    //!< Blocks fetched in advance of a stream, 0 disables
+            uint32_t writeBackThreshold{32U};           //!< Dirty blocks which start the background write-back
+        };
+
+        /**
+         * @brief   Constructs the cache and binds it to the device.
+         *
+         * @param   device  The card.
+         * @param   config  The cache parameters.
+         */
+        BlockCache(IBlockDevice& device, const Config& config);
+
+        /**
+         * @brief   Constructs the cache with the default parameters.
+         *
+         * @param   device  The card.
+         */
+        explicit BlockCache(IBlockDevice& device) : BlockCache(device, Config{}) {};
+
+        /// @brief Destructor, unbinds the device.
+        ~BlockCache();
+
+        BlockCache(BlockCache const &) = delete;             //!< Copy constructor
+        BlockCache& operator=(BlockCache const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Queue a request.
+         *
+         * @param   request     The request, status PENDING until completion.
+         *
+         * @return  OK, INVALID_PARAM for a request out of range or a pending descriptor.
+         */
+        Status Submit(BlockRequest& request);
+
+        /**
+         * @brief   Process the requests and the ended transfer, call it from the main loop or a task.
+         *
+         * @return  True while requests or a transfer are pending.
+         */
+        bool Service();
+
+        /// @brief No request is queued and no transfer runs.
+        bool IsIdle() const {return (mpHead == nullptr) && (mTransfer == Transfer::NONE);};
+
+        /// @brief Dirty blocks in the cache.
+        uint32_t GetDirty() const {return mDirty;};
+
+        /// @brief Blocks read from the cache.
+        uint32_t GetHits() const {return mHits;};
+
+        /// @brief Blocks of read requests which were fetched from the card.
+        uint32_t GetMisses() const {return mMisses;};
+
+        /// @brief Blocks fetched in advance.
+        uint32_t GetReadAheadBlocks() const {return mReadAheadBlocks;};
+
+        /// @brief Read transfers.
+        uint32_t GetFetches() const {return mFetches;};
+
+        /// @brief Write-back transfers.
+        uint32_t GetWriteBacks() const {return mWriteBacks;};
+
+        /// @brief Blocks written back.
+        uint32_t GetWriteBackBlocks() const {return mWriteBackBlocks;};
+
+        /// @brief Failed transfers.
+        uint32_t GetErrors() const {return mErrors;};
+
+    private:
+
+        /// @brief Running transfer.
+        enum class Transfer : uint8_t
+        {
+            NONE=0,           //!< No transfer runs
+            FETCH=1,          //!< Blocks of a read request are fetched
+            WRITE_BACK=2      //!< Dirty blocks are written
+        };
+
+        /// @brief Cache line of one block.
+        struct Line
+        {
+            uint32_t block{0U};     //!< Cached block
+            uint32_t lastUse{0U};   //!< Use stamp for the replacement
+            bool valid{false};      //!< Holds a block
+            bool dirty{false};      //!< Changed since the last write-back
+            bool busy{false};       //!< Part of the running write-back
+        };
+
+        /// @brief One block of data.
+        using Block = std::array<uint8_t, BLOCK_SIZE>;
+
+        /// @brief Device event, see IBlockDevice::IListener.
+        void OnDone(Status status) override;
+
+        /// @brief Process the oldest request, PENDING while it waits for the device.
+        Status Progress(BlockRequest& request);
+
+        /// @brief Process a read request.
+        Status ProgressRead(BlockRequest& request);
+
+        /// @brief Process a write request.
+        Status ProgressWrite(BlockRequest& request);
+
+        /// @brief Process a flush request.
+        Status ProgressFlush();
+
+        /// @brief Start the fetch of the next missing blocks of a read request.
+        Status StartFetch(const BlockRequest& request);
+
+        /// @brief Start the write-back of the oldest dirty run, INVALID_PARAM if nothing is dirty.
+        Status StartWriteBack();
+
+        /// @brief Take over the ended transfer.
+        void EndTransfer(Status status);
+
+        /// @brief Remove the oldest request and complete it.
+        void Finish(Status status);
+
+        /// @brief The line of a block or nullptr.
+        Line* Find(uint32_t block);
+
+        /// @brief Assign a free or the least recently used clean line to a block, nullptr if none is left.
+        Line* Allocate(uint32_t block);
+
+        /// @brief Mark a line as used.
+        void Touch(Line& line) {line.lastUse = ++mUseClock;};
+
+        /// @brief Data of a line.
+        uint8_t* DataOf(const Line& line);
+
+        /// @brief The card.
+        IBlockDevice& mDevice;
+
+        /// @brief Cache parameters.
+        Config mConfig;
+
+        /// @brief Cache lines.
+        std::array<Line, CACHE_BLOCKS> mLines{};
+
+        /// @brief Data of the cache lines.
+        alignas(32) std::array<Block, CACHE_BLOCKS> mData{};
+
+        /// @brief DMA buffer of the running transfer, aligned to the D-Cache lines.
+        alignas(32) std::array<Block, MAX_TRANSFER_BLOCKS> mStaging{};
+
+        BlockRequest* mpHead{nullptr};      //!< Oldest queued request
+        BlockRequest* mpTail{nullptr};      //!< Newest queued request
+        uint32_t mDone{0U};                 //!< Processed blocks of the oldest request
+
+        Transfer mTransfer{Transfer::NONE}; //!< Running transfer
+        uint32_t mTransferBlock{0U};        //!< First block of the running transfer
+        uint32_t mTransferCount{0U};        //!< Blocks of the running transfer
+
+        volatile bool mCompleted{false};            //!< The running transfer has ended
+        volatile Status mDoneStatus{Status::OK};    //!< Result of the ended transfer
+
+        uint32_t mReadEnd{UINT32_MAX};      //!< Block after the last read request
+        uint32_t mUseClock{0U};             //!< Use stamp counter
+        uint32_t mDirty{0U};                //!< Dirty lines
+        bool mWriteError{false};            //!< A write-back has failed since the last flush
+
+        uint32_t mHits{0U};                 //!< Blocks read from the cache
+        uint32_t mMisses{0U};               //!< Blocks fetched for requests
+        uint32_t mReadAheadBlocks{0U};      //!< Blocks fetched in advance
+        uint32_t mFetches{0U};              //!< Read transfers
+        uint32_t mWriteBacks{0U};           //!< Write transfers
+        uint32_t mWriteBackBlocks{0U};      //!< Blocks written
+        uint32_t mErrors{0U};               //!< Failed transfers
+};
+
+} // end namespace Storage
@@ -0,0 +1,170 @@
+/**
+ ********************************************************************************
+ * @file        BlockDeviceFile.cpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, host model of a card implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "BlockDeviceFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace Storage;
+
+
+BlockDeviceFile::BlockDeviceFile(const Config& config)
+: mConfig(config)
+{
+}
+
+
+BlockDeviceFile::~BlockDeviceFile()
+{
+    Close();
+}
+
+
+Status BlockDeviceFile::Open(const char* pPath)
+{
+    Close();
+    const size_t size = static_cast<size_t>(mConfig.blocks) * BLOCK_SIZE;
+    mFile = open(pPath, O_RDWR | O_CREAT, 0644);
+    struct stat info{};
+    if ((mFile < 0) || (fstat(mFile, &info) != 0))
+    {
+        Close();
+        return Status::HW_ERROR;
+    }
+    // the extension of a file reads as zeros
+    if ((static_cast<size_t>(info.st_size) < size) && (ftruncate(mFile, static_cast<off_t>(size)) != 0))
+    {
+        Close();
+        return Status::HW_ERROR;
+    }
+    void* pMap = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFile, 0);
+    if (pMap == MAP_FAILED)
+    {
+        Close();
+        return Status::HW_ERROR;
+    }
+    mpImage = static_cast<uint8_t*>(pMap);
+    return Status::OK;
+}
+
+
+void BlockDeviceFile::Close()
+{
+    if (mpImage != nullptr)
+    {
+        const size_t size = static_cast<size_t>(mConfig.blocks) * BLOCK_SIZE;
+        (void)msync(mpImage, size, MS_SYNC);
+        (void)munmap(mpImage, size);
+        mpImage = nullptr;
+    }
+    if (mFile >= 0)
+    {
+        (void)close(mFile);
+        mFile = -1;
+    }
+    mPending = Pending::NONE;
+}
+
+
+size_t BlockDeviceFile::RunToIdle()
+{
+    size_t events = 0U;
+    while (mPending != Pending::NONE)
+    {
+        const Pending pending = mPending;
+        mPending = Pending::NONE;
+        uint8_t* pImage = &mpImage[static_cast<size_t>(mBlock) * BLOCK_SIZE];
+        const size_t length = static_cast<size_t>(mCount) * BLOCK_SIZE;
+        bool fail = false;
+        if (mFailIn != 0U)
+        {
+            mFailIn--;
+            fail = (mFailIn == 0U);
+        }
+        if (pending == Pending::READ)
+        {
+            mReads++;
+            mBusyUs += mConfig.readCommandUs;
+            const size_t moved = fail ? (static_cast<size_t>(std::min(mFailBlocks, mCount)) * BLOCK_SIZE) : length;
+            (void)std::memcpy(mpRead, pImage, moved);
+            mBlocksRead += moved / BLOCK_SIZE;
+        }
+        else
+        {
+            mWrites++;
+            mBusyUs += mConfig.writeCommandUs;
+            const size_t moved = fail ? (static_cast<size_t>(std::min(mFailBlocks, mCount)) * BLOCK_SIZE) : length;
+            (void)std::memcpy(pImage, mpWrite, moved);
+            mBlocksWritten += moved / BLOCK_SIZE;
+        }
+        mSingle += (mCount == 1U) ? 1U : 0U;
+        mBusyUs += static_cast<uint64_t>(mCount) * mConfig.blockUs;
+        events++;
+        if (mpListener != nullptr)
+        {
+            mpListener->OnDone(fail ? Status::HW_ERROR : Status::OK);
+        }
+    }
+    return events;
+}
+
+
+Status BlockDeviceFile::StartRead(uint32_t block, uint8_t* pData, uint32_t count)
+{
+    if (pData == nullptr)
+    {
+        return Status::INVALID_PARAM;
+    }
+    const Status status = Start(Pending::READ, block, count);
+    if (status == Status::OK)
+    {
+        mpRead = pData;
+    }
+    return status;
+}
+
+
+Status BlockDeviceFile::StartWrite(uint32_t block, const uint8_t* pData, uint32_t count)
+{
+    if (pData == nullptr)
+    {
+        return Status::INVALID_PARAM;
+    }
+    const Status status = Start(Pending::WRITE, block, count);
+    if (status == Status::OK)
+    {
+        mpWrite = pData;
+    }
+    return status;
+}
+
+
+Status BlockDeviceFile::Start(Pending pending, uint32_t block, uint32_t count)
+{
+    if ((mpImage == nullptr) || (count == 0U) || (block >= mConfig.blocks) || (count > (mConfig.blocks - block)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mPending != Pending::NONE)
+    {
+        return Status::BUSY;
+    }
+    mPending = pending;
+    mBlock = block;
+    mCount = count;
+    return Status::OK;
+}
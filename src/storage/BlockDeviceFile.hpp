@@ -0,0 +1,169 @@
+/**
+ ********************************************************************************
+ * @file        BlockDeviceFile.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, host model of a card whose blocks are stored in an image file.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IBlockDevice.hpp"
+namespace Storage {
+
+
+/**
+ * @brief   This class provides an IBlockDevice whose blocks are an image file on the host.
+ * @details The image is mapped into memory, it keeps the content between runs (a new image reads as zeros).
+ *          A started transfer is deferred until @ref RunToIdle (or Poll), which moves the data and calls the
+ *          listener synchronously like the interrupt.\n
+ *          The card time is modeled per transfer: a command overhead (for a write the programming busy time
+ *          of the card as well) and a time per block on the bus. The sum is the busy time of the card, the
+ *          base of the throughput benchmarks. @ref FailTransfer injects a failing or torn transfer.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class BlockDeviceFile : public IBlockDevice
+{
+    public:
+
+        /// @brief Card parameters.
+        struct Config
+        {
+            uint32_t blocks{65536U};            //!< Blocks of the image (32 MB)
+            uint32_t readCommandUs{100U};       //!< Overhead of a read command
+            uint32_t writeCommandUs{1500U};     //!< Overhead and programming busy time of a write command
+            uint32_t blockUs{20U};              //!< One block on the bus (25 MB/s)
+        };
+
+        /**
+         * @brief   Constructs the card.
+         *
+         * @param   config  The card parameters.
+         */
+        explicit BlockDeviceFile(const Config& config);
+
+        /// @brief Constructs the card with the default parameters.
+        BlockDeviceFile() : BlockDeviceFile(Config{}) {};
+
+        /// @brief Destructor, closes the image.
+        ~BlockDeviceFile() override;
+
+        BlockDeviceFile(BlockDeviceFile const &) = delete;             //!< Copy constructor
+        BlockDeviceFile& operator=(BlockDeviceFile const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Open the image file, a new or shorter file is extended with zeros.
+         *
+         * @param   pPath   The file.
+         *
+         * @return  OK or HW_ERROR if the file can't be opened or mapped.
+         */
+        Status Open(const char* pPath);
+
+        /// @brief Close the image file, a deferred transfer is dropped.
+        void Close();
+
+        /**
+         * @brief   Run the deferred transfers, the listener may start new ones.
+         *
+         * @return  Count of ended transfers.
+         */
+        size_t RunToIdle();
+
+        /**
+         * @brief   Let a later transfer fail with HW_ERROR, e.g. a power loss during the transfer.
+         *
+         * @param   transfers   The n-th transfer from now fails (1: the next one), 0 disarms.
+         * @param   blocks      Leading blocks which are still moved (a torn write), the others are not.
+         */
+        void FailTransfer(uint32_t transfers, uint32_t blocks = 0U) {mFailIn = transfers; mFailBlocks = blocks;};
+
+        /// @brief The image content, nullptr if closed.
+        const uint8_t* GetImage() const {return mpImage;};
+
+        /// @copydoc IBlockDevice::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IBlockDevice::GetBlockCount
+        uint32_t GetBlockCount() const override {return (mpImage != nullptr) ? mConfig.blocks : 0U;};
+
+        /// @copydoc IBlockDevice::StartRead
+        Status StartRead(uint32_t block, uint8_t* pData, uint32_t count) override;
+
+        /// @copydoc IBlockDevice::StartWrite
+        Status StartWrite(uint32_t block, const uint8_t* pData, uint32_t count) override;
+
+        /// @brief Runs the deferred transfers, see @ref RunToIdle.
+        void Poll() override {(void)RunToIdle();};
+
+        /// @brief Read commands.
+        uint32_t GetReads() const {return mReads;};
+
+        /// @brief Write commands.
+        uint32_t GetWrites() const {return mWrites;};
+
+        /// @brief Commands which moved a single block (CMD17 / CMD24).
+        uint32_t GetSingleBlockCommands() const {return mSingle;};
+
+        /// @brief Blocks read.
+        uint64_t GetBlocksRead() const {return mBlocksRead;};
+
+        /// @brief Blocks written.
+        uint64_t GetBlocksWritten() const {return mBlocksWritten;};
+
+        /// @brief Modeled busy time of the card in microseconds.
+        uint64_t GetBusyUs() const {return mBusyUs;};
+
+    private:
+
+        /// @brief Deferred transfer.
+        enum class Pending : uint8_t
+        {
+            NONE=0,           //!< Nothing deferred
+            READ=1,           //!< Read blocks
+            WRITE=2           //!< Write blocks
+        };
+
+        /// @brief Check a transfer and defer it.
+        Status Start(Pending pending, uint32_t block, uint32_t count);
+
+        /// @brief Card parameters.
+        Config mConfig;
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        /// @brief Mapped image file.
+        uint8_t* mpImage{nullptr};
+
+        /// @brief File descriptor of the image file.
+        int mFile{-1};
+
+        Pending mPending{Pending::NONE};    //!< Deferred transfer
+        uint32_t mBlock{0U};                //!< First block of the deferred transfer
+        uint32_t mCount{0U};                //!< Blocks of the deferred transfer
+        uint8_t* mpRead{nullptr};           //!< Receive buffer of the deferred read
+        const uint8_t* mpWrite{nullptr};    //!< Transmit data of the deferred write
+        uint32_t mFailIn{0U};               //!< Transfers until the injected failure
+        uint32_t mFailBlocks{0U};           //!< Blocks moved by the failing transfer
+
+        uint32_t mReads{0U};                //!< Read commands
+        uint32_t mWrites{0U};               //!< Write commands
+        uint32_t mSingle{0U};               //!< Single block commands
+        uint64_t mBlocksRead{0U};           //!< Blocks read
+        uint64_t mBlocksWritten{0U};        //!< Blocks written
+        uint64_t mBusyUs{0U};               //!< Modeled busy time
+};
+
+} // end namespace Storage
@@ -0,0 +1,98 @@
+/**
+ ********************************************************************************
+ * @file        IBlockDevice.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, interface of a SD card or eMMC with DMA transfers.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "StorageTypes.hpp"
+namespace Storage {
+
+
+/**
+ * @brief   This class provides the block transfers of one card (hardware or host model).
+ * @details A transfer of one block runs the single block command (CMD17 / CMD24), a transfer of more blocks
+ *          the multiple block command (CMD18 / CMD25), the data is moved by DMA. The end of a transfer is
+ *          reported by the listener. One transfer runs at a time, a card which is still programming the
+ *          last write is busy.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class IBlockDevice
+{
+    public:
+
+        /// @brief Receiver of the transfer events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A transfer has ended, called from the interrupt context.
+                 * @param status    OK or HW_ERROR.
+                 */
+                virtual void OnDone(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IBlockDevice() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /// @brief Blocks of the card.
+        virtual uint32_t GetBlockCount() const = 0;
+
+        /**
+         * @brief Start a read, the end is reported by the listener.
+         * @param block     First block.
+         * @param pData     Receive buffer of count blocks, valid until the end.
+         * @param count     Blocks.
+         * @return OK, BUSY while a transfer runs or the card is programming, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status StartRead(uint32_t block, uint8_t* pData, uint32_t count) = 0;
+
+        /**
+         * @brief Start a write, the end is reported by the listener.
+         * @param block     First block.
+         * @param pData     Transmit data of count blocks, valid until the end.
+         * @param count     Blocks.
+         * @return OK, BUSY while a transfer runs or the card is programming, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status StartWrite(uint32_t block, const uint8_t* pData, uint32_t count) = 0;
+
+        /// @brief Drive the end of a transfer without interrupt (host model), empty for interrupt driven devices.
+        virtual void Poll() {};
+
+    protected:
+
+        /// @brief Constructor.
+        IBlockDevice() = default;
+
+        IBlockDevice(IBlockDevice const &) = default;             //!< Copy constructor
+        IBlockDevice(IBlockDevice &&) = default;                  //!< Move constructor
+
+        IBlockDevice& operator=(IBlockDevice const &) = default;  //!< Copy assignment
+        IBlockDevice& operator=(IBlockDevice &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Storage
@@ -0,0 +1,304 @@
+/**
+ ********************************************************************************
+ * @file        LogFormat.cpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, on-card format of the recording files implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "LogFormat.hpp"
+#include <cstring>
+
+using namespace Storage;
+
+namespace {
+
+/// @brief "SLV1", first word of a volume header.
+constexpr uint32_t VOLUME_MAGIC{0x31564C53U};
+
+/// @brief "SLC1", first word of a checkpoint.
+constexpr uint32_t CHECKPOINT_MAGIC{0x31434C53U};
+
+/// @brief "SLD1", first word of a data chunk.
+constexpr uint32_t CHUNK_MAGIC{0x31444C53U};
+
+/// @brief Version of the volume layout.
+constexpr uint32_t VOLUME_VERSION{1U};
+
+/// @brief Offset of the file table and bytes of an entry.
+constexpr uint32_t FILE_TABLE{32U};
+constexpr uint32_t FILE_ENTRY_SIZE{LOG_NAME_SIZE + 12U};
+
+/// @brief Offset of the CRC of the volume header, the last word of the block.
+constexpr uint32_t VOLUME_CRC{BLOCK_SIZE - 4U};
+
+/// @brief Offset of the CRC of a checkpoint.
+constexpr uint32_t CHECKPOINT_CRC{24U};
+
+/// @brief Offset of the CRC of a chunk header.
+constexpr uint32_t CHUNK_CRC{28U};
+
+static_assert((FILE_TABLE + (LOG_MAX_FILES * FILE_ENTRY_SIZE)) <= VOLUME_CRC, "file table exceeds the block");
+
+/// @brief Table of the reflected CRC-32, polynomial 0xEDB88320.
+constexpr std::array<uint32_t, 256U> CRC_TABLE = []()
+{
+    std::array<uint32_t, 256U> table{};
+    for (uint32_t i = 0U; i < table.size(); i++)
+    {
+        uint32_t crc = i;
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 1U) != 0U) ? ((crc >> 1U) ^ 0xEDB88320U) : (crc >> 1U);
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+/// @brief Little endian word at a byte offset.
+uint32_t Load32(const uint8_t* pData)
+{
+    return static_cast<uint32_t>(pData[0]) | (static_cast<uint32_t>(pData[1]) << 8U) |
+           (static_cast<uint32_t>(pData[2]) << 16U) | (static_cast<uint32_t>(pData[3]) << 24U);
+}
+
+/// @brief Store a little endian word at a byte offset.
+void Store32(uint8_t* pData, uint32_t value)
+{
+    pData[0] = static_cast<uint8_t>(value);
+    pData[1] = static_cast<uint8_t>(value >> 8U);
+    pData[2] = static_cast<uint8_t>(value >> 16U);
+    pData[3] = static_cast<uint8_t>(value >> 24U);
+}
+
+/// @brief Little endian half word at a byte offset.
+uint16_t Load16(const uint8_t* pData)
+{
+    return static_cast<uint16_t>(static_cast<uint32_t>(pData[0]) | (static_cast<uint32_t>(pData[1]) << 8U));
+}
+
+/// @brief Store a little endian half word at a byte offset.
+void Store16(uint8_t* pData, uint16_t value)
+{
+    pData[0] = static_cast<uint8_t>(value);
+    pData[1] = static_cast<uint8_t>(value >> 8U);
+}
+
+} // end anonymous namespace
+
+
+uint32_t LogFormat::Crc(const uint8_t* pData, size_t length, uint32_t crc)
+{
+    uint32_t value = ~crc;
+    for (size_t i = 0U; i < length; i++)
+    {
+        value = (value >> 8U) ^ CRC_TABLE[(value ^ pData[i]) & 0xFFU];
+    }
+    return ~value;
+}
+
+
+void LogFormat::EncodeVolume(const LogVolume& volume, uint8_t* pBlock)
+{
+    (void)std::memset(pBlock, 0, BLOCK_SIZE);
+    Store32(&pBlock[0], VOLUME_MAGIC);
+    Store32(&pBlock[4], VOLUME_VERSION);
+    Store32(&pBlock[8], volume.sequence);
+    Store32(&pBlock[12], volume.chunkBlocks);
+    Store32(&pBlock[16], volume.eraseBlocks);
+    Store32(&pBlock[20], volume.blocks);
+    Store32(&pBlock[24], volume.nextGeneration);
+    Store32(&pBlock[28], volume.files);
+    for (uint32_t i = 0U; i < volume.files; i++)
+    {
+        uint8_t* pEntry = &pBlock[FILE_TABLE + (i * FILE_ENTRY_SIZE)];
+        const LogFileEntry& entry = volume.file[i];
+        (void)std::memcpy(pEntry, entry.name.data(), LOG_NAME_SIZE - 1U);
+        Store32(&pEntry[LOG_NAME_SIZE], entry.start);
+        Store32(&pEntry[LOG_NAME_SIZE + 4U], entry.blocks);
+        Store32(&pEntry[LOG_NAME_SIZE + 8U], entry.generation);
+    }
+    Store32(&pBlock[VOLUME_CRC], Crc(pBlock, VOLUME_CRC));
+}
+
+
+bool LogFormat::DecodeVolume(const uint8_t* pBlock, LogVolume& volume)
+{
+    if ((Load32(&pBlock[0]) != VOLUME_MAGIC) || (Load32(&pBlock[4]) != VOLUME_VERSION) ||
+        (Load32(&pBlock[VOLUME_CRC]) != Crc(pBlock, VOLUME_CRC)))
+    {
+        return false;
+    }
+    LogVolume decoded{};
+    decoded.sequence = Load32(&pBlock[8]);
+    decoded.chunkBlocks = Load32(&pBlock[12]);
+    decoded.eraseBlocks = Load32(&pBlock[16]);
+    decoded.blocks = Load32(&pBlock[20]);
+    decoded.nextGeneration = Load32(&pBlock[24]);
+    decoded.files = Load32(&pBlock[28]);
+    if ((decoded.files > LOG_MAX_FILES) || (decoded.chunkBlocks == 0U) ||
+        (decoded.chunkBlocks > LOG_MAX_CHUNK_BLOCKS) || (decoded.eraseBlocks < (2U * decoded.chunkBlocks)) ||
+        ((decoded.eraseBlocks % decoded.chunkBlocks) != 0U))
+    {
+        return false;
+    }
+    for (uint32_t i = 0U; i < decoded.files; i++)
+    {
+        const uint8_t* pEntry = &pBlock[FILE_TABLE + (i * FILE_ENTRY_SIZE)];
+        LogFileEntry& entry = decoded.file[i];
+        (void)std::memcpy(entry.name.data(), pEntry, LOG_NAME_SIZE - 1U);
+        entry.start = Load32(&pEntry[LOG_NAME_SIZE]);
+        entry.blocks = Load32(&pEntry[LOG_NAME_SIZE + 4U]);
+        entry.generation = Load32(&pEntry[LOG_NAME_SIZE + 8U]);
+        if ((entry.blocks < (2U * decoded.chunkBlocks)) || (entry.start > decoded.blocks) ||
+            (entry.blocks > (decoded.blocks - entry.start)))
+        {
+            return false;
+        }
+    }
+    volume = decoded;
+    return true;
+}
+
+
+bool LogFormat::SelectVolume(const uint8_t* pBlocks, LogVolume& volume)
+{
+    LogVolume copy[2];
+    const bool valid0 = DecodeVolume(pBlocks, copy[0]);
+    const bool valid1 = DecodeVolume(&pBlocks[BLOCK_SIZE], copy[1]);
+    if (valid0 && (!valid1 || (copy[0].sequence > copy[1].sequence)))
+    {
+        volume = copy[0];
+        return true;
+    }
+    if (valid1)
+    {
+        volume = copy[1];
+        return true;
+    }
+    return false;
+}
+
+
+void LogFormat::EncodeCheckpoint(const LogCheckpoint& checkpoint, uint8_t* pBlock)
+{
+    (void)std::memset(pBlock, 0, BLOCK_SIZE);
+    Store32(&pBlock[0], CHECKPOINT_MAGIC);
+    Store32(&pBlock[4], checkpoint.generation);
+    Store32(&pBlock[8], checkpoint.sequence);
+    Store32(&pBlock[12], checkpoint.chunks);
+    Store32(&pBlock[16], static_cast<uint32_t>(checkpoint.records));
+    Store32(&pBlock[20], static_cast<uint32_t>(checkpoint.records >> 32U));
+    Store32(&pBlock[CHECKPOINT_CRC], Crc(pBlock, CHECKPOINT_CRC));
+}
+
+
+bool LogFormat::SelectCheckpoint(const uint8_t* pRing, uint32_t slots, uint32_t generation,
+                                 LogCheckpoint& checkpoint)
+{
+    bool found = false;
+    checkpoint = LogCheckpoint{};
+    checkpoint.generation = generation;
+    for (uint32_t slot = 0U; slot < slots; slot++)
+    {
+        const uint8_t* pBlock = &pRing[static_cast<size_t>(slot) * BLOCK_SIZE];
+        if ((Load32(&pBlock[0]) != CHECKPOINT_MAGIC) || (Load32(&pBlock[4]) != generation) ||
+            (Load32(&pBlock[CHECKPOINT_CRC]) != Crc(pBlock, CHECKPOINT_CRC)))
+        {
+            continue;
+        }
+        const uint32_t sequence = Load32(&pBlock[8]);
+        if (!found || (sequence > checkpoint.sequence))
+        {
+            checkpoint.sequence = sequence;
+            checkpoint.chunks = Load32(&pBlock[12]);
+            checkpoint.records = static_cast<uint64_t>(Load32(&pBlock[16])) |
+                                 (static_cast<uint64_t>(Load32(&pBlock[20])) << 32U);
+            found = true;
+        }
+    }
+    return found;
+}
+
+
+void LogFormat::SealChunk(const LogChunkHeader& header, uint8_t* pChunk)
+{
+    Store32(&pChunk[0], CHUNK_MAGIC);
+    Store32(&pChunk[4], header.generation);
+    Store32(&pChunk[8], header.index);
+    Store32(&pChunk[12], header.payload);
+    Store32(&pChunk[16], header.records);
+    Store32(&pChunk[20], header.firstTimestamp);
+    Store32(&pChunk[24], header.lastTimestamp);
+    const uint32_t crc = Crc(pChunk, CHUNK_CRC);
+    Store32(&pChunk[CHUNK_CRC], Crc(&pChunk[LOG_CHUNK_HEADER_SIZE], header.payload, crc));
+}
+
+
+bool LogFormat::CheckChunk(const uint8_t* pChunk, uint32_t capacity, uint32_t generation, uint32_t index,
+                           LogChunkHeader& header)
+{
+    const uint32_t payload = Load32(&pChunk[12]);
+    if ((Load32(&pChunk[0]) != CHUNK_MAGIC) || (Load32(&pChunk[4]) != generation) ||
+        (Load32(&pChunk[8]) != index) || (payload > (capacity - LOG_CHUNK_HEADER_SIZE)))
+    {
+        return false;
+    }
+    const uint32_t crc = Crc(pChunk, CHUNK_CRC);
+    if (Load32(&pChunk[CHUNK_CRC]) != Crc(&pChunk[LOG_CHUNK_HEADER_SIZE], payload, crc))
+    {
+        return false;
+    }
+    header.generation = generation;
+    header.index = index;
+    header.payload = payload;
+    header.records = Load32(&pChunk[16]);
+    header.firstTimestamp = Load32(&pChunk[20]);
+    header.lastTimestamp = Load32(&pChunk[24]);
+    return true;
+}
+
+
+void LogFormat::EncodeRecord(uint16_t tag, uint32_t timestamp, const uint8_t* pData, uint16_t length,
+                             uint8_t* pPosition)
+{
+    Store16(&pPosition[0], length);
+    Store16(&pPosition[2], tag);
+    Store32(&pPosition[4], timestamp);
+    if (length != 0U)
+    {
+        (void)std::memcpy(&pPosition[LOG_RECORD_HEADER_SIZE], pData, length);
+    }
+    // the padding is part of the CRC, keep it defined
+    const uint32_t padding = RecordSize(length) - LOG_RECORD_HEADER_SIZE - length;
+    (void)std::memset(&pPosition[LOG_RECORD_HEADER_SIZE + length], 0, padding);
+}
+
+
+bool LogFormat::DecodeRecord(const uint8_t* pChunk, uint32_t payload, uint32_t& offset, LogRecord& record)
+{
+    const uint32_t end = LOG_CHUNK_HEADER_SIZE + payload;
+    if ((offset + LOG_RECORD_HEADER_SIZE) > end)
+    {
+        return false;
+    }
+    const uint8_t* pPosition = &pChunk[offset];
+    const uint16_t length = Load16(&pPosition[0]);
+    const uint32_t size = RecordSize(length);
+    if (size > (end - offset))
+    {
+        return false;
+    }
+    record.length = length;
+    record.tag = Load16(&pPosition[2]);
+    record.timestamp = Load32(&pPosition[4]);
+    record.pData = &pPosition[LOG_RECORD_HEADER_SIZE];
+    offset += size;
+    return true;
+}
@@ -0,0 +1,224 @@
+/**
+ ********************************************************************************
+ * @file        LogFormat.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, on-card format of the append-only recording files.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "StorageTypes.hpp"
+namespace Storage {
+
+
+/// @brief Files of a log volume.
+constexpr uint32_t LOG_MAX_FILES{16U};
+
+/// @brief Bytes of a file name including the terminator.
+constexpr uint32_t LOG_NAME_SIZE{16U};
+
+/// @brief Upper limit of the blocks of one chunk.
+constexpr uint32_t LOG_MAX_CHUNK_BLOCKS{64U};
+
+/// @brief Bytes of the chunk header.
+constexpr uint32_t LOG_CHUNK_HEADER_SIZE{32U};
+
+/// @brief Bytes of the record header.
+constexpr uint32_t LOG_RECORD_HEADER_SIZE{8U};
+
+
+/// @brief File entry of the volume header.
+struct LogFileEntry
+{
+    std::array<char, LOG_NAME_SIZE> name{};     //!< Zero terminated name
+    uint32_t start{0U};                         //!< First block of the extent
+    uint32_t blocks{0U};                        //!< Blocks of the extent
+    uint32_t generation{0U};                    //!< Generation of the content, new on truncation
+};
+
+
+/// @brief Volume header, stored in block 0 and 1.
+struct LogVolume
+{
+    uint32_t sequence{0U};          //!< Incremented per write, the newer copy is valid
+    uint32_t chunkBlocks{0U};       //!< Blocks of a chunk
+    uint32_t eraseBlocks{0U};       //!< Alignment of the extents
+    uint32_t blocks{0U};            //!< Blocks of the card
+    uint32_t nextGeneration{1U};    //!< Generation of the next created or truncated file
+    uint32_t files{0U};             //!< Used file entries
+    std::array<LogFileEntry, LOG_MAX_FILES> file{};     //!< File entries
+};
+
+
+/// @brief Checkpoint of a file, stored in the ring at the start of its extent.
+struct LogCheckpoint
+{
+    uint32_t generation{0U};        //!< Generation of the file
+    uint32_t sequence{0U};          //!< Incremented per checkpoint, the newest is valid
+    uint32_t chunks{0U};            //!< Chunks written completely
+    uint64_t records{0U};           //!< Records in these chunks
+};
+
+
+/// @brief Header of a data chunk.
+struct LogChunkHeader
+{
+    uint32_t generation{0U};        //!< Generation of the file
+    uint32_t index{0U};             //!< Position in the file
+    uint32_t payload{0U};           //!< Bytes of the records
+    uint32_t records{0U};           //!< Records in the chunk
+    uint32_t firstTimestamp{0U};    //!< Timestamp of the first record
+    uint32_t lastTimestamp{0U};     //!< Timestamp of the last record
+};
+
+
+/// @brief One record, the data points into the chunk.
+struct LogRecord
+{
+    uint16_t tag{0U};               //!< Application defined type or channel
+    uint16_t length{0U};            //!< Bytes of the data
+    uint32_t timestamp{0U};         //!< Application defined, monotonic within a file
+    const uint8_t* pData{nullptr};  //!< The data
+};
+
+
+/**
+ * @brief   This class encodes and checks the structures of a log volume.
+ * @details Layout of a volume:
+ *          - Block 0 and 1: two copies of the volume header with the file table, written alternately, the
+ *            valid copy with the higher sequence counts. A torn header write leaves the other copy.
+ *          - The first erase unit holds the headers only, the extents of the files follow. Each extent is
+ *            preallocated and aligned to the erase unit (eraseBlocks, e.g. the 4 MB allocation unit of a
+ *            SD card), the card never moves or allocates anything while recording.
+ *          - The first chunk of an extent is the checkpoint ring, one checkpoint per block in turn. The data
+ *            chunks follow, chunk n at start + (n + 1) * chunkBlocks, so each chunk write is one aligned
+ *            multi-block transfer.
+ *
+ *          A chunk starts with its header (LOG_CHUNK_HEADER_SIZE bytes), then the records follow, each with
+ *          length, tag and timestamp (LOG_RECORD_HEADER_SIZE bytes) and its data padded to 4 bytes. Records
+ *          do not cross chunks. The CRC-32 of the header covers the header and the records.\n
+ *          Recovery: the newest valid checkpoint of the file generation gives the chunks which were complete
+ *          at that time. The chunks after it are accepted while their header is valid, has the generation and
+ *          the expected index. Chunks of an older generation (a truncated file) or a torn chunk end the file.
+ *          All values are little endian.
+ *  - - -
+ *
+ * __Thread safety:__
+ * All functions are reentrant.
+ *
+ */
+class LogFormat
+{
+    public:
+
+        /**
+         * @brief   CRC-32 (IEEE 802.3, reflected) over a range.
+         *
+         * @param   pData   The data.
+         * @param   length  Bytes.
+         * @param   crc     Result of a previous range or 0.
+         *
+         * @return  The CRC.
+         */
+        static uint32_t Crc(const uint8_t* pData, size_t length, uint32_t crc = 0U);
+
+        /// @brief Encode the volume header into one block.
+        static void EncodeVolume(const LogVolume& volume, uint8_t* pBlock);
+
+        /**
+         * @brief   Decode one copy of the volume header.
+         *
+         * @param   pBlock  The block.
+         * @param   volume  Returns the header.
+         *
+         * @return  True for a valid header.
+         */
+        static bool DecodeVolume(const uint8_t* pBlock, LogVolume& volume);
+
+        /**
+         * @brief   Select the valid copy of the volume header.
+         *
+         * @param   pBlocks The blocks 0 and 1.
+         * @param   volume  Returns the header.
+         *
+         * @return  True if a copy is valid.
+         */
+        static bool SelectVolume(const uint8_t* pBlocks, LogVolume& volume);
+
+        /// @brief Encode a checkpoint into one block.
+        static void EncodeCheckpoint(const LogCheckpoint& checkpoint, uint8_t* pBlock);
+
+        /**
+         * @brief   Select the newest valid checkpoint of a generation in the ring.
+         *
+         * @param   pRing       The blocks of the ring.
+         * @param   slots       Blocks of the ring.
+         * @param   generation  Generation of the file.
+         * @param   checkpoint  Returns the checkpoint, an empty one of the generation if none is valid.
+         *
+         * @return  True if a checkpoint is valid.
+         */
+        static bool SelectCheckpoint(const uint8_t* pRing, uint32_t slots, uint32_t generation,
+                                     LogCheckpoint& checkpoint);
+
+        /**
+         * @brief   Write the header of a filled chunk.
+         *
+         * @param   header  The header, the records follow at LOG_CHUNK_HEADER_SIZE.
+         * @param   pChunk  The chunk.
+         */
+        static void SealChunk(const LogChunkHeader& header, uint8_t* pChunk);
+
+        /**
+         * @brief   Check a chunk of a file.
+         *
+         * @param   pChunk      The chunk, at least the header and the payload.
+         * @param   capacity    Bytes of a chunk.
+         * @param   generation  Generation of the file.
+         * @param   index       Expected position.
+         * @param   header      Returns the header.
+         *
+         * @return  True for a valid chunk of the file at this position.
+         */
+        static bool CheckChunk(const uint8_t* pChunk, uint32_t capacity, uint32_t generation, uint32_t index,
+                               LogChunkHeader& header);
+
+        /// @brief Bytes of a record in the chunk.
+        static uint32_t RecordSize(uint32_t length) {return LOG_RECORD_HEADER_SIZE + ((length + 3U) & ~3U);};
+
+        /// @brief Encode a record at pPosition.
+        static void EncodeRecord(uint16_t tag, uint32_t timestamp, const uint8_t* pData, uint16_t length,
+                                 uint8_t* pPosition);
+
+        /**
+         * @brief   Decode the record at an offset of a checked chunk.
+         *
+         * @param   pChunk  The chunk.
+         * @param   payload Bytes of the records.
+         * @param   offset  Offset of the record from the chunk start, advanced to the next record.
+         * @param   record  Returns the record.
+         *
+         * @return  False at the end of the records or for an inconsistent length.
+         */
+        static bool DecodeRecord(const uint8_t* pChunk, uint32_t payload, uint32_t& offset, LogRecord& record);
+
+        /// @brief First block of data chunk n of a file.
+        static uint32_t ChunkBlock(const LogFileEntry& entry, uint32_t chunkBlocks, uint32_t index)
+        {
+            return entry.start + ((index + 1U) * chunkBlocks);
+        };
+
+        /// @brief Data chunks of a file.
+        static uint32_t ChunkCount(const LogFileEntry& entry, uint32_t chunkBlocks)
+        {
+            return (entry.blocks / chunkBlocks) - 1U;
+        };
+};
+
+} // end namespace Storage
@@ -0,0 +1,194 @@
+/**
+ ********************************************************************************
+ * @file        LogReader.cpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, host reader of the recording files implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "LogReader.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace Storage;
+
+
+LogReader::~LogReader()
+{
+    Close();
+}
+
+
+Status LogReader::Open(const char* pPath)
+{
+    Close();
+    const int file = open(pPath, O_RDONLY);
+    if (file < 0)
+    {
+        return Status::HW_ERROR;
+    }
+    struct stat info{};
+    void* pMap = MAP_FAILED;
+    if ((fstat(file, &info) == 0) && (static_cast<size_t>(info.st_size) >= (2U * BLOCK_SIZE)))
+    {
+        pMap = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+    }
+    // the mapping stays valid without the descriptor
+    (void)close(file);
+    if (pMap == MAP_FAILED)
+    {
+        return Status::HW_ERROR;
+    }
+    mpImage = static_cast<const uint8_t*>(pMap);
+    mSize = static_cast<size_t>(info.st_size);
+    if (!LogFormat::SelectVolume(mpImage, mVolume))
+    {
+        Close();
+        return Status::NOT_FOUND;
+    }
+    return Status::OK;
+}
+
+
+void LogReader::Close()
+{
+    if (mpImage != nullptr)
+    {
+        (void)munmap(const_cast<uint8_t*>(mpImage), mSize);
+        mpImage = nullptr;
+    }
+    mSize = 0U;
+    mpFile = nullptr;
+    mChunkCount = 0U;
+    mRecords = 0U;
+    mRecovered = 0U;
+}
+
+
+Status LogReader::OpenFile(const char* pName)
+{
+    mpFile = nullptr;
+    const LogFileEntry* pEntry = nullptr;
+    for (uint32_t i = 0U; (mpImage != nullptr) && (i < mVolume.files); i++)
+    {
+        if (std::strncmp(mVolume.file[i].name.data(), pName, LOG_NAME_SIZE) == 0)
+        {
+            pEntry = &mVolume.file[i];
+        }
+    }
+    if (pEntry == nullptr)
+    {
+        return Status::NOT_FOUND;
+    }
+    if ((static_cast<uint64_t>(pEntry->start) + pEntry->blocks) > (mSize / BLOCK_SIZE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mpFile = pEntry;
+
+    // the same recovery as the writer: newest checkpoint, then the chunks written after it
+    const uint32_t count = LogFormat::ChunkCount(*pEntry, mVolume.chunkBlocks);
+    LogCheckpoint checkpoint{};
+    (void)LogFormat::SelectCheckpoint(&mpImage[static_cast<size_t>(pEntry->start) * BLOCK_SIZE],
+                                      mVolume.chunkBlocks, pEntry->generation, checkpoint);
+    uint32_t chunk = std::min(checkpoint.chunks, count);
+    mRecords = checkpoint.records;
+    LogChunkHeader header{};
+    while ((chunk < count) &&
+           LogFormat::CheckChunk(ChunkAt(chunk), mVolume.chunkBlocks * BLOCK_SIZE, pEntry->generation, chunk, header))
+    {
+        mRecords += header.records;
+        chunk++;
+    }
+    mRecovered = chunk - std::min(checkpoint.chunks, count);
+    mChunkCount = chunk;
+    Rewind(0U);
+    return Status::OK;
+}
+
+
+bool LogReader::Next(LogRecord& record)
+{
+    while (mChunk < mChunkCount)
+    {
+        if (LogFormat::DecodeRecord(ChunkAt(mChunk), mHeader.payload, mOffset, record))
+        {
+            return true;
+        }
+        Rewind(mChunk + 1U);
+    }
+    return false;
+}
+
+
+bool LogReader::Seek(uint32_t timestamp)
+{
+    if (mpFile == nullptr)
+    {
+        return false;
+    }
+    // the last chunk which starts before the timestamp, the chunks were checked by OpenFile
+    uint32_t low = 0U;
+    uint32_t high = mChunkCount;
+    LogChunkHeader header{};
+    while ((high - low) > 1U)
+    {
+        const uint32_t middle = low + ((high - low) / 2U);
+        (void)LogFormat::CheckChunk(ChunkAt(middle), mVolume.chunkBlocks * BLOCK_SIZE, mpFile->generation, middle,
+                                    header);
+        if (header.firstTimestamp < timestamp)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    Rewind(low);
+    LogRecord record{};
+    while (true)
+    {
+        const uint32_t chunk = mChunk;
+        const uint32_t offset = mOffset;
+        if (!Next(record))
+        {
+            return false;
+        }
+        if (record.timestamp >= timestamp)
+        {
+            // back to the found record
+            Rewind(chunk);
+            mOffset = offset;
+            return true;
+        }
+    }
+}
+
+
+const uint8_t* LogReader::ChunkAt(uint32_t index) const
+{
+    return &mpImage[static_cast<size_t>(LogFormat::ChunkBlock(*mpFile, mVolume.chunkBlocks, index)) * BLOCK_SIZE];
+}
+
+
+void LogReader::Rewind(uint32_t index)
+{
+    mChunk = index;
+    mOffset = LOG_CHUNK_HEADER_SIZE;
+    mHeader = LogChunkHeader{};
+    if (index < mChunkCount)
+    {
+        (void)LogFormat::CheckChunk(ChunkAt(index), mVolume.chunkBlocks * BLOCK_SIZE, mpFile->generation, index,
+                                    mHeader);
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ ********************************************************************************
+ * @file        LogReader.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, host reader of the recording files in a card image.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "LogFormat.hpp"
+namespace Storage {
+
+
+/**
+ * @brief   This class reads the recording files of a log volume from a card image (see @ref LogFormat).
+ * @details The image (a dump of the card or the card device itself) is mapped read only, the records are
+ *          returned in place without copy. @ref OpenFile recovers the end of a file like the writer after a
+ *          power loss, so an image taken from an interrupted recording reads up to its last complete chunk.
+ *          @ref Seek finds a timestamp by binary search over the chunk headers.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class LogReader
+{
+    public:
+
+        /// @brief Constructor.
+        LogReader() = default;
+
+        /// @brief Destructor, closes the image.
+        ~LogReader();
+
+        LogReader(LogReader const &) = delete;             //!< Copy constructor
+        LogReader& operator=(LogReader const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Map an image and read its volume header.
+         *
+         * @param   pPath   The image file.
+         *
+         * @return  OK, HW_ERROR if the file can't be mapped, NOT_FOUND without valid volume.
+         */
+        Status Open(const char* pPath);
+
+        /// @brief Unmap the image.
+        void Close();
+
+        /// @brief The volume header, valid after Open.
+        const LogVolume& GetVolume() const {return mVolume;};
+
+        /**
+         * @brief   Select a file and recover its end, the position is its first record.
+         *
+         * @param   pName   The name.
+         *
+         * @return  OK, NOT_FOUND, INVALID_PARAM if the extent exceeds the image.
+         */
+        Status OpenFile(const char* pName);
+
+        /**
+         * @brief   The record at the position, advances the position.
+         *
+         * @param   record  Returns the record, its data points into the image.
+         *
+         * @return  False at the end of the file.
+         */
+        bool Next(LogRecord& record);
+
+        /**
+         * @brief   Move the position to the first record with a timestamp not below a value.
+         *
+         * @param   timestamp   The timestamp.
+         *
+         * @return  False if no such record exists (the position is the end then).
+         */
+        bool Seek(uint32_t timestamp);
+
+        /// @brief Complete chunks of the selected file.
+        uint32_t GetChunks() const {return mChunkCount;};
+
+        /// @brief Records of the selected file.
+        uint64_t GetRecords() const {return mRecords;};
+
+        /// @brief Chunks found after the newest checkpoint.
+        uint32_t GetRecoveredChunks() const {return mRecovered;};
+
+    private:
+
+        /// @brief Start of data chunk n of the selected file.
+        const uint8_t* ChunkAt(uint32_t index) const;
+
+        /// @brief Move the position to the start of a chunk.
+        void Rewind(uint32_t index);
+
+        /// @brief Mapped image.
+        const uint8_t* mpImage{nullptr};
+
+        /// @brief Bytes of the image.
+        size_t mSize{0U};
+
+        /// @brief The volume header.
+        LogVolume mVolume{};
+
+        /// @brief The selected file.
+        const LogFileEntry* mpFile{nullptr};
+
+        uint32_t mChunkCount{0U};       //!< Complete chunks of the file
+        uint64_t mRecords{0U};          //!< Records of the file
+        uint32_t mRecovered{0U};        //!< Chunks after the checkpoint
+
+        uint32_t mChunk{0U};            //!< Chunk of the position
+        uint32_t mOffset{0U};           //!< Offset of the position in the chunk
+        LogChunkHeader mHeader{};       //!< Header of the chunk of the position
+};
+
+} // end namespace Storage
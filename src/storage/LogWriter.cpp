@@ -0,0 +1,486 @@
+/**
+ ********************************************************************************
+ * @file        LogWriter.cpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, append-only recording files implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "LogWriter.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace Storage;
+
+
+LogWriter::LogWriter(IBlockDevice& device, const Config& config)
+: mDevice(device), mConfig(config)
+{
+    mConfig.checkpointChunks = std::max(mConfig.checkpointChunks, 1U);
+    mDevice.SetListener(this);
+}
+
+
+LogWriter::~LogWriter()
+{
+    mDevice.SetListener(nullptr);
+}
+
+
+Status LogWriter::Format()
+{
+    if (mpFile != nullptr)
+    {
+        return Status::BUSY;
+    }
+    const uint32_t blocks = mDevice.GetBlockCount();
+    if ((mConfig.chunkBlocks == 0U) || (mConfig.chunkBlocks > LOG_MAX_CHUNK_BLOCKS) ||
+        (mConfig.eraseBlocks < (2U * mConfig.chunkBlocks)) || ((mConfig.eraseBlocks % mConfig.chunkBlocks) != 0U) ||
+        (blocks < (2U * mConfig.eraseBlocks)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    // the generations continue, so no chunk of the old volume matches a new file
+    LogVolume volume{};
+    LogVolume previous{};
+    if ((Run(false, 0U, mBlock.data(), 2U) == Status::OK) && LogFormat::SelectVolume(mBlock.data(), previous))
+    {
+        volume.sequence = previous.sequence;
+        volume.nextGeneration = previous.nextGeneration;
+    }
+    volume.chunkBlocks = mConfig.chunkBlocks;
+    volume.eraseBlocks = mConfig.eraseBlocks;
+    volume.blocks = blocks;
+    mVolume = volume;
+    mMounted = false;
+    // both copies, none of the old volume remains
+    Status status = WriteVolume();
+    if (status == Status::OK)
+    {
+        status = WriteVolume();
+    }
+    mMounted = (status == Status::OK);
+    return status;
+}
+
+
+Status LogWriter::Mount()
+{
+    if (mpFile != nullptr)
+    {
+        return Status::BUSY;
+    }
+    mMounted = false;
+    const Status status = Run(false, 0U, mBlock.data(), 2U);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    if (!LogFormat::SelectVolume(mBlock.data(), mVolume))
+    {
+        return Status::NOT_FOUND;
+    }
+    mMounted = true;
+    return Status::OK;
+}
+
+
+Status LogWriter::Create(const char* pName, uint32_t blocks)
+{
+    if ((mpFile != nullptr) || !mMounted)
+    {
+        return Status::BUSY;
+    }
+    const size_t length = (pName != nullptr) ? strnlen(pName, LOG_NAME_SIZE) : 0U;
+    if ((length == 0U) || (length >= LOG_NAME_SIZE) || (blocks == 0U) || (Find(pName) != nullptr))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mVolume.files >= LOG_MAX_FILES)
+    {
+        return Status::NO_SPACE;
+    }
+    // the first erase unit holds the volume header, the extents follow without gap
+    uint32_t start = mVolume.eraseBlocks;
+    if (mVolume.files != 0U)
+    {
+        const LogFileEntry& last = mVolume.file[mVolume.files - 1U];
+        start = last.start + last.blocks;
+    }
+    const uint64_t size = ((static_cast<uint64_t>(blocks) + mVolume.chunkBlocks + mVolume.eraseBlocks - 1U) /
+                           mVolume.eraseBlocks) * mVolume.eraseBlocks;
+    if (size > (static_cast<uint64_t>(mVolume.blocks) - start))
+    {
+        return Status::NO_SPACE;
+    }
+    LogFileEntry& entry = mVolume.file[mVolume.files];
+    entry = LogFileEntry{};
+    (void)std::memcpy(entry.name.data(), pName, length);
+    entry.start = start;
+    entry.blocks = static_cast<uint32_t>(size);
+    entry.generation = mVolume.nextGeneration++;
+    mVolume.files++;
+    return WriteVolume();
+}
+
+
+Status LogWriter::Open(const char* pName, bool truncate)
+{
+    if ((mpFile != nullptr) || !mMounted)
+    {
+        return Status::BUSY;
+    }
+    LogFileEntry* pEntry = Find(pName);
+    if (pEntry == nullptr)
+    {
+        return Status::NOT_FOUND;
+    }
+    mpFile = pEntry;
+    mChunkCount = LogFormat::ChunkCount(*pEntry, mVolume.chunkBlocks);
+    mChunks.fill(Chunk{});
+    mFill = BUFFERS;
+    mNextChunk = 0U;
+    mCommitted = 0U;
+    mRecords = 0U;
+    mCheckpointed = 0U;
+    mSequence = 0U;
+    mSyncRequested = false;
+    mRecovered = 0U;
+    Status status = Status::OK;
+    if (truncate)
+    {
+        // the chunks and checkpoints of the old generation are ignored from now on
+        pEntry->generation = mVolume.nextGeneration++;
+        status = WriteVolume();
+    }
+    else
+    {
+        status = Recover();
+    }
+    if (status != Status::OK)
+    {
+        mpFile = nullptr;
+    }
+    return status;
+}
+
+
+Status LogWriter::Append(uint16_t tag, uint32_t timestamp, const uint8_t* pData, uint16_t length)
+{
+    if ((mpFile == nullptr) || ((pData == nullptr) && (length != 0U)) || (length > GetMaxRecord()))
+    {
+        return Status::INVALID_PARAM;
+    }
+    const uint32_t size = LogFormat::RecordSize(length);
+    if ((mFill < BUFFERS) && ((LOG_CHUNK_HEADER_SIZE + mChunks[mFill].header.payload + size) > ChunkBytes()))
+    {
+        Seal();
+    }
+    if (mFill == BUFFERS)
+    {
+        if (mNextChunk >= mChunkCount)
+        {
+            return Status::NO_SPACE;
+        }
+        uint32_t free = 0U;
+        while ((free < BUFFERS) && (mChunks[free].state != Buffer::FREE))
+        {
+            free++;
+        }
+        if (free == BUFFERS)
+        {
+            mDropped++;
+            return Status::BUSY;
+        }
+        mFill = free;
+        mChunks[free].state = Buffer::FILLING;
+        mChunks[free].header = LogChunkHeader{};
+        mChunks[free].header.generation = mpFile->generation;
+        mChunks[free].header.firstTimestamp = timestamp;
+    }
+    LogChunkHeader& header = mChunks[mFill].header;
+    LogFormat::EncodeRecord(tag, timestamp, pData, length, &mData[mFill][LOG_CHUNK_HEADER_SIZE + header.payload]);
+    header.payload += size;
+    header.records++;
+    header.lastTimestamp = timestamp;
+    return Status::OK;
+}
+
+
+Status LogWriter::Sync()
+{
+    if (mpFile == nullptr)
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mFill < BUFFERS)
+    {
+        Seal();
+    }
+    mSyncRequested = true;
+    return Status::OK;
+}
+
+
+Status LogWriter::Close()
+{
+    const Status status = Sync();
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    const uint32_t errors = mErrors;
+    while (Service())
+    {
+        mDevice.Poll();
+        if (mErrors != errors)
+        {
+            return Status::HW_ERROR;
+        }
+    }
+    mpFile = nullptr;
+    return Status::OK;
+}
+
+
+bool LogWriter::Service()
+{
+    if ((mTransfer != Transfer::NONE) && mCompleted)
+    {
+        mCompleted = false;
+        const Transfer transfer = mTransfer;
+        mTransfer = Transfer::NONE;
+        if (mDoneStatus != Status::OK)
+        {
+            // the chunk stays sealed and is written again, a checkpoint is repeated
+            mErrors++;
+            mSyncRequested = mSyncRequested || (transfer == Transfer::CHECKPOINT);
+        }
+        else if (transfer == Transfer::CHUNK)
+        {
+            Chunk& chunk = mChunks[mTransferBuffer];
+            mCommitted = chunk.header.index + 1U;
+            mRecords += chunk.header.records;
+            chunk.state = Buffer::FREE;
+        }
+        else
+        {
+            mCheckpointed = mTransferChunks;
+            mSequence++;
+            mCheckpoints++;
+        }
+    }
+    if ((mTransfer == Transfer::NONE) && (mpFile != nullptr))
+    {
+        StartNext();
+    }
+    return !IsIdle();
+}
+
+
+bool LogWriter::IsIdle() const
+{
+    if (mTransfer != Transfer::NONE)
+    {
+        return false;
+    }
+    for (const Chunk& chunk : mChunks)
+    {
+        if (chunk.state == Buffer::SEALED)
+        {
+            return false;
+        }
+    }
+    return !CheckpointDue();
+}
+
+
+uint32_t LogWriter::GetMaxRecord() const
+{
+    if (!mMounted)
+    {
+        return 0U;
+    }
+    return (ChunkBytes() - LOG_CHUNK_HEADER_SIZE - LOG_RECORD_HEADER_SIZE) & ~3U;
+}
+
+
+void LogWriter::OnDone(Status status)
+{
+    mDoneStatus = status;
+    mCompleted = true;
+}
+
+
+Status LogWriter::Run(bool write, uint32_t block, uint8_t* pData, uint32_t count)
+{
+    mCompleted = false;
+    Status status = Status::BUSY;
+    while (status == Status::BUSY)
+    {
+        // the card may still program the last write
+        status = write ? mDevice.StartWrite(block, pData, count) : mDevice.StartRead(block, pData, count);
+        if (status == Status::BUSY)
+        {
+            mDevice.Poll();
+        }
+    }
+    if (status != Status::OK)
+    {
+        mErrors++;
+        return status;
+    }
+    while (!mCompleted)
+    {
+        mDevice.Poll();
+    }
+    mCompleted = false;
+    if (mDoneStatus != Status::OK)
+    {
+        mErrors++;
+        return Status::HW_ERROR;
+    }
+    return Status::OK;
+}
+
+
+Status LogWriter::WriteVolume()
+{
+    mVolume.sequence++;
+    LogFormat::EncodeVolume(mVolume, mBlock.data());
+    return Run(true, mVolume.sequence % 2U, mBlock.data(), 1U);
+}
+
+
+Status LogWriter::Recover()
+{
+    const uint32_t chunkBlocks = mVolume.chunkBlocks;
+    uint8_t* pBuffer = mData[0].data();
+    Status status = Run(false, mpFile->start, pBuffer, chunkBlocks);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    LogCheckpoint checkpoint{};
+    if (LogFormat::SelectCheckpoint(pBuffer, chunkBlocks, mpFile->generation, checkpoint))
+    {
+        mSequence = checkpoint.sequence + 1U;
+    }
+    uint32_t chunk = std::min(checkpoint.chunks, mChunkCount);
+    mCheckpointed = chunk;
+    mRecords = checkpoint.records;
+    // the chunks written after the checkpoint
+    LogChunkHeader header{};
+    while (chunk < mChunkCount)
+    {
+        status = Run(false, LogFormat::ChunkBlock(*mpFile, chunkBlocks, chunk), pBuffer, chunkBlocks);
+        if (status != Status::OK)
+        {
+            return status;
+        }
+        if (!LogFormat::CheckChunk(pBuffer, ChunkBytes(), mpFile->generation, chunk, header))
+        {
+            break;
+        }
+        mRecords += header.records;
+        chunk++;
+    }
+    mRecovered = chunk - mCheckpointed;
+    mCommitted = chunk;
+    mNextChunk = chunk;
+    // a new checkpoint saves the next recovery the scan
+    mSyncRequested = (mRecovered != 0U);
+    return Status::OK;
+}
+
+
+void LogWriter::Seal()
+{
+    Chunk& chunk = mChunks[mFill];
+    chunk.header.index = mNextChunk++;
+    LogFormat::SealChunk(chunk.header, mData[mFill].data());
+    chunk.state = Buffer::SEALED;
+    mFill = BUFFERS;
+}
+
+
+void LogWriter::StartNext()
+{
+    // the chunks in their order, before a checkpoint which counts them
+    uint32_t next = BUFFERS;
+    for (uint32_t i = 0U; i < BUFFERS; i++)
+    {
+        if ((mChunks[i].state == Buffer::SEALED) &&
+            ((next == BUFFERS) || (mChunks[i].header.index < mChunks[next].header.index)))
+        {
+            next = i;
+        }
+    }
+    Status status = Status::OK;
+    if (next < BUFFERS)
+    {
+        const LogChunkHeader& header = mChunks[next].header;
+        // a synced chunk is partly filled, only its used blocks are written
+        const uint32_t blocks = (LOG_CHUNK_HEADER_SIZE + header.payload + BLOCK_SIZE - 1U) / BLOCK_SIZE;
+        status = mDevice.StartWrite(LogFormat::ChunkBlock(*mpFile, mVolume.chunkBlocks, header.index),
+                                    mData[next].data(), blocks);
+        if (status == Status::OK)
+        {
+            mTransfer = Transfer::CHUNK;
+            mTransferBuffer = next;
+        }
+    }
+    else if (CheckpointDue())
+    {
+        const LogCheckpoint checkpoint{mpFile->generation, mSequence, mCommitted, mRecords};
+        LogFormat::EncodeCheckpoint(checkpoint, mBlock.data());
+        status = mDevice.StartWrite(mpFile->start + (mSequence % mVolume.chunkBlocks), mBlock.data(), 1U);
+        if (status == Status::OK)
+        {
+            mTransfer = Transfer::CHECKPOINT;
+            mTransferChunks = mCommitted;
+            mSyncRequested = false;
+        }
+    }
+    else
+    {
+        // nothing new since the last checkpoint
+        mSyncRequested = false;
+    }
+    if ((status != Status::OK) && (status != Status::BUSY))
+    {
+        mErrors++;
+    }
+}
+
+
+bool LogWriter::CheckpointDue() const
+{
+    if (mCommitted == mCheckpointed)
+    {
+        return false;
+    }
+    return mSyncRequested || ((mCommitted - mCheckpointed) >= mConfig.checkpointChunks);
+}
+
+
+LogFileEntry* LogWriter::Find(const char* pName)
+{
+    if (pName == nullptr)
+    {
+        return nullptr;
+    }
+    for (uint32_t i = 0U; i < mVolume.files; i++)
+    {
+        if (std::strncmp(mVolume.file[i].name.data(), pName, LOG_NAME_SIZE) == 0)
+        {
+            return &mVolume.file[i];
+        }
+    }
+    return nullptr;
+}
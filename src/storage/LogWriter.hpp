@@ -0,0 +1,272 @@
+/**
+ ********************************************************************************
+ * @file        LogWriter.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, append-only recording files on a SD card or eMMC.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IBlockDevice.hpp"
+#include "LogFormat.hpp"
+namespace Storage {
+
+
+/**
+ * @brief   This class records into preallocated files of a log volume (see @ref LogFormat).
+ * @details @ref Format writes an empty volume, @ref Create preallocates a file as contiguous extent. Nothing
+ *          is allocated while recording, so no write has to wait for a file system update.\n
+ *          @ref Append copies a record into the filling chunk buffer. A full chunk is sealed (header and
+ *          CRC) and written by @ref Service with one aligned multi-block transfer while the next buffer is
+ *          filled. A checkpoint is written after checkpointChunks chunks and on @ref Sync, which also seals
+ *          a partly filled chunk (the next records start in a new chunk, a synced chunk is never
+ *          rewritten). A failed chunk write is repeated, the chunks stay in order.\n
+ *          @ref Open recovers the end of a file after a power loss: the newest checkpoint and then the chunks
+ *          written after it, at most checkpointChunks chunk reads. The records of all completely written
+ *          chunks survive, the records of a torn or unwritten chunk are lost.
+ * @note    The writer needs the device for itself, do not share it with a BlockCache. The chunk buffers are
+ *          members (2 x 32 KB), a static instance is placed in RAM_D1 (section .bss) which the SDMMC1 IDMA
+ *          reaches. Format, Mount, Create, Open and Close wait for their transfers.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * All functions must be called from one context, the device completion may run in an ISR.
+ *
+ */
+class LogWriter : private IBlockDevice::IListener
+{
+    public:
+
+        /// @brief Chunk buffers, one is filled while the other is written.
+        static constexpr uint32_t BUFFERS{2U};
+
+        /// @brief Volume geometry for Format and the checkpoint interval.
+        struct Config
+        {
+            uint32_t chunkBlocks{LOG_MAX_CHUNK_BLOCKS};     //!< Blocks of a chunk, divides eraseBlocks
+            uint32_t eraseBlocks{8192U};                    //!< Extent alignment, the 4 MB allocation unit
+            uint32_t checkpointChunks{32U};                 //!< Chunks between two checkpoints
+        };
+
+        /**
+         * @brief   Constructs the writer and binds it to the device.
+         *
+         * @param   device  The card.
+         * @param   config  Geometry and checkpoint interval.
+         */
+        LogWriter(IBlockDevice& device, const Config& config);
+
+        /**
+         * @brief   Constructs the writer with the default geometry.
+         *
+         * @param   device  The card.
+         */
+        explicit LogWriter(IBlockDevice& device) : LogWriter(device, Config{}) {};
+
+        /// @brief Destructor, unbinds the device without Close (like a power loss).
+        ~LogWriter();
+
+        LogWriter(LogWriter const &) = delete;             //!< Copy constructor
+        LogWriter& operator=(LogWriter const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Write an empty volume with the configured geometry, the generations continue.
+         *
+         * @return  OK, BUSY while a file is open, INVALID_PARAM for an unusable geometry, HW_ERROR.
+         */
+        Status Format();
+
+        /**
+         * @brief   Read the volume header.
+         *
+         * @return  OK, BUSY while a file is open, NOT_FOUND without valid volume, HW_ERROR.
+         */
+        Status Mount();
+
+        /**
+         * @brief   Preallocate a file.
+         *
+         * @param   pName   Zero terminated name, 1 to LOG_NAME_SIZE - 1 characters.
+         * @param   blocks  Data blocks, the extent is rounded up to the erase unit.
+         *
+         * @return  OK, BUSY while a file is open or before Mount, INVALID_PARAM for an invalid or used name,
+         *          NO_SPACE, HW_ERROR.
+         */
+        Status Create(const char* pName, uint32_t blocks);
+
+        /**
+         * @brief   Open a file for appending.
+         *
+         * @param   pName       The name.
+         * @param   truncate    Start with an empty file (new generation), else recover and continue.
+         *
+         * @return  OK, BUSY while a file is open or before Mount, NOT_FOUND, HW_ERROR.
+         */
+        Status Open(const char* pName, bool truncate);
+
+        /**
+         * @brief   Append a record.
+         *
+         * @param   tag         Application defined type or channel.
+         * @param   timestamp   Application defined, monotonic within the file.
+         * @param   pData       The data, nullptr for an empty record.
+         * @param   length      Bytes of the data, at most GetMaxRecord.
+         *
+         * @return  OK, BUSY if no chunk buffer is free (the record is dropped), NO_SPACE at the end of the
+         *          file, INVALID_PARAM without open file or for a long record.
+         */
+        Status Append(uint16_t tag, uint32_t timestamp, const uint8_t* pData, uint16_t length);
+
+        /**
+         * @brief   Seal the filling chunk and request a checkpoint, done when @ref IsIdle.
+         *
+         * @return  OK, INVALID_PARAM without open file.
+         */
+        Status Sync();
+
+        /**
+         * @brief   Sync and wait until all chunks and the checkpoint are written.
+         *
+         * @return  OK, INVALID_PARAM without open file, HW_ERROR if a write fails (the file stays open).
+         */
+        Status Close();
+
+        /**
+         * @brief   Start the writes of the sealed chunks and the checkpoints, call it from the main loop.
+         *
+         * @return  True while writes are pending.
+         */
+        bool Service();
+
+        /// @brief No chunk or checkpoint waits or is written.
+        bool IsIdle() const;
+
+        /// @brief The mounted volume header.
+        const LogVolume& GetVolume() const {return mVolume;};
+
+        /// @brief Bytes of the longest record.
+        uint32_t GetMaxRecord() const;
+
+        /// @brief Chunks written completely in the open file, including the recovered ones.
+        uint32_t GetChunks() const {return mCommitted;};
+
+        /// @brief Records in the written chunks.
+        uint64_t GetRecords() const {return mRecords;};
+
+        /// @brief Chunks found after the checkpoint by the last Open.
+        uint32_t GetRecoveredChunks() const {return mRecovered;};
+
+        /// @brief Written checkpoints.
+        uint32_t GetCheckpoints() const {return mCheckpoints;};
+
+        /// @brief Records refused because no chunk buffer was free.
+        uint32_t GetDropped() const {return mDropped;};
+
+        /// @brief Failed transfers.
+        uint32_t GetErrors() const {return mErrors;};
+
+    private:
+
+        /// @brief State of a chunk buffer.
+        enum class Buffer : uint8_t
+        {
+            FREE=0,           //!< Unused
+            FILLING=1,        //!< Records are appended
+            SEALED=2          //!< Waits for or runs its write
+        };
+
+        /// @brief Running transfer.
+        enum class Transfer : uint8_t
+        {
+            NONE=0,           //!< No transfer runs
+            CHUNK=1,          //!< A chunk is written
+            CHECKPOINT=2      //!< A checkpoint is written
+        };
+
+        /// @brief A chunk buffer.
+        struct Chunk
+        {
+            Buffer state{Buffer::FREE};     //!< State
+            LogChunkHeader header{};        //!< Header, filled while appending
+        };
+
+        /// @brief One chunk of data.
+        using ChunkData = std::array<uint8_t, LOG_MAX_CHUNK_BLOCKS * BLOCK_SIZE>;
+
+        /// @brief Device event, see IBlockDevice::IListener.
+        void OnDone(Status status) override;
+
+        /// @brief Start a blocking read or write and wait for its end.
+        Status Run(bool write, uint32_t block, uint8_t* pData, uint32_t count);
+
+        /// @brief Write the volume header into the older copy.
+        Status WriteVolume();
+
+        /// @brief Recover the end of the open file.
+        Status Recover();
+
+        /// @brief Seal the filling chunk.
+        void Seal();
+
+        /// @brief Start the next chunk or checkpoint write.
+        void StartNext();
+
+        /// @brief A checkpoint is due.
+        bool CheckpointDue() const;
+
+        /// @brief Bytes of a chunk.
+        uint32_t ChunkBytes() const {return mVolume.chunkBlocks * BLOCK_SIZE;};
+
+        /// @brief The file entry of a name or nullptr.
+        LogFileEntry* Find(const char* pName);
+
+        /// @brief The card.
+        IBlockDevice& mDevice;
+
+        /// @brief Geometry and checkpoint interval.
+        Config mConfig;
+
+        /// @brief The volume header.
+        LogVolume mVolume{};
+
+        /// @brief Chunk buffers, aligned to the D-Cache lines.
+        alignas(32) std::array<ChunkData, BUFFERS> mData{};
+
+        /// @brief Checkpoint and header block, aligned to the D-Cache lines.
+        alignas(32) std::array<uint8_t, 2U * BLOCK_SIZE> mBlock{};
+
+        std::array<Chunk, BUFFERS> mChunks{};   //!< State of the buffers
+        uint32_t mFill{BUFFERS};                //!< Filling buffer, BUFFERS if none
+
+        bool mMounted{false};                   //!< The volume header is valid
+        LogFileEntry* mpFile{nullptr};          //!< The open file
+
+        uint32_t mChunkCount{0U};               //!< Data chunks of the open file
+        uint32_t mNextChunk{0U};                //!< Index of the next sealed chunk
+        uint32_t mCommitted{0U};                //!< Chunks written
+        uint64_t mRecords{0U};                  //!< Records in the written chunks
+        uint32_t mCheckpointed{0U};             //!< Chunks of the last checkpoint
+        uint32_t mSequence{0U};                 //!< Sequence of the next checkpoint
+        bool mSyncRequested{false};             //!< A checkpoint of all chunks is requested
+
+        Transfer mTransfer{Transfer::NONE};     //!< Running transfer
+        uint32_t mTransferBuffer{0U};           //!< Buffer of the running chunk write
+        uint32_t mTransferChunks{0U};           //!< Chunks of the running checkpoint
+
+        volatile bool mCompleted{false};            //!< The running transfer has ended
+        volatile Status mDoneStatus{Status::OK};    //!< Result of the ended transfer
+
+        uint32_t mRecovered{0U};                //!< Chunks found after the checkpoint
+        uint32_t mCheckpoints{0U};              //!< Written checkpoints
+        uint32_t mDropped{0U};                  //!< Refused records
+        uint32_t mErrors{0U};                   //!< Failed transfers
+};
+
+} // end namespace Storage
@@ -0,0 +1,158 @@
+/**
+ ********************************************************************************
+ * @file        MmcBlockHal.cpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, eMMC implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "MmcBlockHal.hpp"
+#include "DCache.hpp"
+
+using namespace Storage;
+
+MmcBlockHal* MmcBlockHal::spInstance{nullptr};
+
+
+MmcBlockHal::MmcBlockHal(MMC_HandleTypeDef& hmmc)
+: mHmmc(hmmc)
+{
+    spInstance = this;
+}
+
+
+MmcBlockHal::~MmcBlockHal()
+{
+    (void)HAL_MMC_Abort(&mHmmc);
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+Status MmcBlockHal::StartRead(uint32_t block, uint8_t* pData, uint32_t count)
+{
+    const Status status = Check(block, pData, count);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    mpRead = pData;
+    mReadLength = count * BLOCK_SIZE;
+    // no dirty line may be evicted into the buffer during the transfer
+    Utils::DCache::CleanInvalidate(pData, mReadLength);
+    return ToStatus(HAL_MMC_ReadBlocks_DMA(&mHmmc, pData, block, count));
+}
+
+
+Status MmcBlockHal::StartWrite(uint32_t block, const uint8_t* pData, uint32_t count)
+{
+    const Status status = Check(block, pData, count);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    mpRead = nullptr;
+    Utils::DCache::Clean(pData, count * BLOCK_SIZE);
+    return ToStatus(HAL_MMC_WriteBlocks_DMA(&mHmmc, pData, block, count));
+}
+
+
+void MmcBlockHal::OnComplete()
+{
+    if (mpRead != nullptr)
+    {
+        // lines fetched speculatively during the transfer are stale
+        Utils::DCache::Invalidate(mpRead, mReadLength);
+        mpRead = nullptr;
+    }
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(Status::OK);
+    }
+}
+
+
+void MmcBlockHal::OnError()
+{
+    mpRead = nullptr;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(Status::HW_ERROR);
+    }
+}
+
+
+MmcBlockHal* MmcBlockHal::GetInstance(const MMC_HandleTypeDef* hmmc)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHmmc == hmmc))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status MmcBlockHal::Check(uint32_t block, const uint8_t* pData, uint32_t count)
+{
+    if ((pData == nullptr) || (count == 0U) || (block >= GetBlockCount()) || (count > (GetBlockCount() - block)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mHmmc.State != HAL_MMC_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    // after a write the device stays in the programming state for a while
+    return (HAL_MMC_GetCardState(&mHmmc) == HAL_MMC_CARD_TRANSFER) ? Status::OK : Status::BUSY;
+}
+
+
+Status MmcBlockHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_MMC_RxCpltCallback(MMC_HandleTypeDef* hmmc)
+{
+    MmcBlockHal* pPort = MmcBlockHal::GetInstance(hmmc);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_MMC_TxCpltCallback(MMC_HandleTypeDef* hmmc)
+{
+    MmcBlockHal* pPort = MmcBlockHal::GetInstance(hmmc);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_MMC_ErrorCallback(MMC_HandleTypeDef* hmmc)
+{
+    MmcBlockHal* pPort = MmcBlockHal::GetInstance(hmmc);
+    if (pPort != nullptr)
+    {
+        pPort->OnError();
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ ********************************************************************************
+ * @file        MmcBlockHal.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, eMMC on the SDMMC of the STM32H7.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IBlockDevice.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace Storage {
+
+
+/**
+ * @brief   This class provides the IBlockDevice on an eMMC at the SDMMC of the STM32H7.
+ * @details StartRead and StartWrite run HAL_MMC_ReadBlocks_DMA / HAL_MMC_WriteBlocks_DMA, the HAL sends the
+ *          single or multiple block command by the count of blocks. The end is reported from
+ *          HAL_MMC_RxCpltCallback, HAL_MMC_TxCpltCallback and HAL_MMC_ErrorCallback. A transfer is only started
+ *          in the transfer state of the card, while the card programs a written block it is BUSY.\n
+ *          The D-Cache lines of a transmit buffer are cleaned before the transfer, the lines of a receive
+ *          buffer are cleaned and invalidated before and invalidated again after the transfer.
+ * @note    The application initialises the handle with HAL_MMC_Init (bus width, block size 512), the IRQ
+ *          handler of the SDMMC calls HAL_MMC_IRQHandler. The buffers must be aligned to 32 bytes (D-Cache
+ *          lines) and reachable by the IDMA: SDMMC1 reaches AXI SRAM (RAM_D1) and the flash, SDMMC2 the D2
+ *          SRAM as well, none of them the DTCM. One eMMC instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class MmcBlockHal : public IBlockDevice
+{
+    public:
+
+        /**
+         * @brief   Constructs the port.
+         *
+         * @param   hmmc    The initialised MMC handle.
+         */
+        explicit MmcBlockHal(MMC_HandleTypeDef& hmmc);
+
+        /// @brief Destructor.
+        ~MmcBlockHal() override;
+
+        MmcBlockHal(MmcBlockHal const &) = delete;             //!< Copy constructor
+        MmcBlockHal& operator=(MmcBlockHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc IBlockDevice::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IBlockDevice::GetBlockCount
+        uint32_t GetBlockCount() const override {return mHmmc.MmcCard.LogBlockNbr;};
+
+        /// @copydoc IBlockDevice::StartRead
+        Status StartRead(uint32_t block, uint8_t* pData, uint32_t count) override;
+
+        /// @copydoc IBlockDevice::StartWrite
+        Status StartWrite(uint32_t block, const uint8_t* pData, uint32_t count) override;
+
+        /// @brief HAL_MMC_RxCpltCallback / HAL_MMC_TxCpltCallback.
+        void OnComplete();
+
+        /// @brief HAL_MMC_ErrorCallback.
+        void OnError();
+
+        /// @brief The instance of a handle or nullptr.
+        static MmcBlockHal* GetInstance(const MMC_HandleTypeDef* hmmc);
+
+    private:
+
+        /// @brief Check a transfer and the state of the card.
+        Status Check(uint32_t block, const uint8_t* pData, uint32_t count);
+
+        /// @brief Map a HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The MMC handle.
+        MMC_HandleTypeDef& mHmmc;
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        uint8_t* mpRead{nullptr};   //!< Receive buffer of the running read
+        uint32_t mReadLength{0U};   //!< Bytes of the running read
+
+        /// @brief The instance of the eMMC.
+        static MmcBlockHal* spInstance;
+};
+
+} // end namespace Storage
@@ -0,0 +1,158 @@
+/**
+ ********************************************************************************
+ * @file        SdBlockHal.cpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, SD card implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SdBlockHal.hpp"
+#include "DCache.hpp"
+
+using namespace Storage;
+
+SdBlockHal* SdBlockHal::spInstance{nullptr};
+
+
+SdBlockHal::SdBlockHal(SD_HandleTypeDef& hsd)
+: mHsd(hsd)
+{
+    spInstance = this;
+}
+
+
+SdBlockHal::~SdBlockHal()
+{
+    (void)HAL_SD_Abort(&mHsd);
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+Status SdBlockHal::StartRead(uint32_t block, uint8_t* pData, uint32_t count)
+{
+    const Status status = Check(block, pData, count);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    mpRead = pData;
+    mReadLength = count * BLOCK_SIZE;
+    // no dirty line may be evicted into the buffer during the transfer
+    Utils::DCache::CleanInvalidate(pData, mReadLength);
+    return ToStatus(HAL_SD_ReadBlocks_DMA(&mHsd, pData, block, count));
+}
+
+
+Status SdBlockHal::StartWrite(uint32_t block, const uint8_t* pData, uint32_t count)
+{
+    const Status status = Check(block, pData, count);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+    mpRead = nullptr;
+    Utils::DCache::Clean(pData, count * BLOCK_SIZE);
+    return ToStatus(HAL_SD_WriteBlocks_DMA(&mHsd, pData, block, count));
+}
+
+
+void SdBlockHal::OnComplete()
+{
+    if (mpRead != nullptr)
+    {
+        // lines fetched speculatively during the transfer are stale
+        Utils::DCache::Invalidate(mpRead, mReadLength);
+        mpRead = nullptr;
+    }
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(Status::OK);
+    }
+}
+
+
+void SdBlockHal::OnError()
+{
+    mpRead = nullptr;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(Status::HW_ERROR);
+    }
+}
+
+
+SdBlockHal* SdBlockHal::GetInstance(const SD_HandleTypeDef* hsd)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHsd == hsd))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status SdBlockHal::Check(uint32_t block, const uint8_t* pData, uint32_t count)
+{
+    if ((pData == nullptr) || (count == 0U) || (block >= GetBlockCount()) || (count > (GetBlockCount() - block)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (mHsd.State != HAL_SD_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    // after a write the card stays in the programming state for a while
+    return (HAL_SD_GetCardState(&mHsd) == HAL_SD_CARD_TRANSFER) ? Status::OK : Status::BUSY;
+}
+
+
+Status SdBlockHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_SD_RxCpltCallback(SD_HandleTypeDef* hsd)
+{
+    SdBlockHal* pPort = SdBlockHal::GetInstance(hsd);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_SD_TxCpltCallback(SD_HandleTypeDef* hsd)
+{
+    SdBlockHal* pPort = SdBlockHal::GetInstance(hsd);
+    if (pPort != nullptr)
+    {
+        pPort->OnComplete();
+    }
+}
+
+
+extern "C" void HAL_SD_ErrorCallback(SD_HandleTypeDef* hsd)
+{
+    SdBlockHal* pPort = SdBlockHal::GetInstance(hsd);
+    if (pPort != nullptr)
+    {
+        pPort->OnError();
+    }
+}
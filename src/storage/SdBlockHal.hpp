@@ -0,0 +1,99 @@
+/**
+ ********************************************************************************
+ * @file        SdBlockHal.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, SD card on the SDMMC of the STM32H7.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IBlockDevice.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace Storage {
+
+
+/**
+ * @brief   This class provides the IBlockDevice on a SD card at the SDMMC of the STM32H7.
+ * @details StartRead and StartWrite run HAL_SD_ReadBlocks_DMA / HAL_SD_WriteBlocks_DMA, the HAL sends the
+ *          single or multiple block command by the count of blocks. The end is reported from
+ *          HAL_SD_RxCpltCallback, HAL_SD_TxCpltCallback and HAL_SD_ErrorCallback. A transfer is only started
+ *          in the transfer state of the card, while the card programs a written block it is BUSY.\n
+ *          The D-Cache lines of a transmit buffer are cleaned before the transfer, the lines of a receive
+ *          buffer are cleaned and invalidated before and invalidated again after the transfer.
+ * @note    The application initialises the handle with HAL_SD_Init, SDMMC1_IRQHandler calls HAL_SD_IRQHandler.
+ *          The buffers must be aligned to 32 bytes (D-Cache lines) and reachable by the IDMA: SDMMC1 reaches
+ *          AXI SRAM (RAM_D1) and the flash, not the DTCM. One SD card instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to call it from one context or in a critical section.
+ *
+ */
+class SdBlockHal : public IBlockDevice
+{
+    public:
+
+        /**
+         * @brief   Constructs the port.
+         *
+         * @param   hsd     The initialised SD handle.
+         */
+        explicit SdBlockHal(SD_HandleTypeDef& hsd);
+
+        /// @brief Destructor.
+        ~SdBlockHal() override;
+
+        SdBlockHal(SdBlockHal const &) = delete;             //!< Copy constructor
+        SdBlockHal& operator=(SdBlockHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc IBlockDevice::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IBlockDevice::GetBlockCount
+        uint32_t GetBlockCount() const override {return mHsd.SdCard.LogBlockNbr;};
+
+        /// @copydoc IBlockDevice::StartRead
+        Status StartRead(uint32_t block, uint8_t* pData, uint32_t count) override;
+
+        /// @copydoc IBlockDevice::StartWrite
+        Status StartWrite(uint32_t block, const uint8_t* pData, uint32_t count) override;
+
+        /// @brief HAL_SD_RxCpltCallback / HAL_SD_TxCpltCallback.
+        void OnComplete();
+
+        /// @brief HAL_SD_ErrorCallback.
+        void OnError();
+
+        /// @brief The instance of a handle or nullptr.
+        static SdBlockHal* GetInstance(const SD_HandleTypeDef* hsd);
+
+    private:
+
+        /// @brief Check a transfer and the state of the card.
+        Status Check(uint32_t block, const uint8_t* pData, uint32_t count);
+
+        /// @brief Map a HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The SD handle.
+        SD_HandleTypeDef& mHsd;
+
+        /// @brief The listener.
+        IListener* mpListener{nullptr};
+
+        uint8_t* mpRead{nullptr};   //!< Receive buffer of the running read
+        uint32_t mReadLength{0U};   //!< Bytes of the running read
+
+        /// @brief The instance of the SD card.
+        static SdBlockHal* spInstance;
+};
+
+} // end namespace Storage
@@ -0,0 +1,74 @@
+/**
+ ********************************************************************************
+ * @file        StorageTypes.hpp
+ *
+ * @namespace   Storage
+ *
+ * @brief       Storage, common types of the SD/MMC block devices.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace Storage {
+
+
+/// @brief Bytes of one block of a SD card or eMMC.
+constexpr uint32_t BLOCK_SIZE{512U};
+
+
+/// @brief Result of a storage operation.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The device is busy, retry later
+    INVALID_PARAM=2,  //!< Inconsistent parameter
+    HW_ERROR=3,       //!< The SDMMC reported an error or the card did not respond
+    PENDING=4,        //!< Request is queued or running
+    NOT_FOUND=5,      //!< No valid volume or no file with this name
+    NO_SPACE=6        //!< The volume or the file is full
+};
+
+
+/// @brief Operation of a request.
+enum class BlockOperation : uint8_t
+{
+    READ=0,           //!< Read blocks into the buffer
+    WRITE=1,          //!< Write blocks from the buffer
+    FLUSH=2           //!< Write all cached blocks to the device
+};
+
+
+/**
+ * @brief   Descriptor of one block request.
+ * @details The descriptor and the buffer are owned by the caller and must stay valid until the completion
+ *          callback has been called (or @ref status left PENDING). The buffer of a write is not changed.
+ */
+struct BlockRequest
+{
+    /// @brief Completion callback, called in the context of the service call.
+    using Callback = void (*)(BlockRequest& request, void* pContext);
+
+    BlockOperation operation{BlockOperation::READ}; //!< Read, write or flush
+    uint32_t block{0U};                 //!< First block, unused for flush
+    uint32_t count{0U};                 //!< Blocks, unused for flush
+    uint8_t* pData{nullptr};            //!< count * BLOCK_SIZE bytes, unused for flush
+
+    Callback pCallback{nullptr};        //!< Optional completion callback
+    void* pContext{nullptr};            //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or running.
+    volatile Status status{Status::OK};
+
+    /// @brief Intrusive queue link, owned by the cache.
+    BlockRequest* pNext{nullptr};
+};
+
+} // end namespace Storage
@@ -0,0 +1,81 @@
+/**
+ ********************************************************************************
+ * @file        CriticalSection.hpp
+ *
+ * @namespace   Utils
+ *
+ * @brief       Utils, scoped critical section for thread and ISR shared data.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#if !defined(__arm__)
+#include <mutex>
+#endif
+namespace Utils {
+
+
+/**
+ * @brief   This class provides a scoped (RAII) critical section.
+ * @details On the target the interrupts are masked by PRIMASK and restored to the previous
+ *          state on leaving the scope, so nested sections are allowed.\n
+ *          On the host a global recursive mutex stands in for the interrupt mask, which
+ *          makes simulated ISR contexts (worker threads) behave the same way.
+ * @note    Keep the guarded code short, it blocks every interrupt on the target.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.
+ *
+ */
+class CriticalSection
+{
+    public:
+
+        /// @brief Enter the critical section.
+        CriticalSection()
+        {
+#if defined(__arm__)
+            __asm volatile ("mrs %0, primask" : "=r" (mPrimask) :: "memory");
+            __asm volatile ("cpsid i" ::: "memory");
+#else
+            Mutex().lock();
+#endif
+        };
+
+        /// @brief Leave the critical section and restore the previous state.
+        ~CriticalSection()
+        {
+#if defined(__arm__)
+            __asm volatile ("msr primask, %0" :: "r" (mPrimask) : "memory");
+#else
+            Mutex().unlock();
+#endif
+        };
+
+        CriticalSection(CriticalSection const &) = delete;             //!< Copy constructor
+        CriticalSection(CriticalSection &&) = delete;                  //!< Move constructor
+        CriticalSection& operator=(CriticalSection const &) = delete;  //!< Copy assignment
+        CriticalSection& operator=(CriticalSection &&) = delete;       //!< Move assignment
+
+    private:
+
+#if defined(__arm__)
+        /// @brief PRIMASK value on entry.
+        uint32_t mPrimask{0U};
+#else
+        /// @brief Global lock which emulates the interrupt mask on the host.
+        static std::recursive_mutex& Mutex()
+        {
+            static std::recursive_mutex mutex;
+            return mutex;
+        }
+#endif
+};
+
+} // end namespace Utils
@@ -0,0 +1,79 @@
+/**
+ ********************************************************************************
+ * @file        DCache.hpp
+ *
+ * @namespace   Utils
+ *
+ * @brief       Utils, D-Cache maintenance of DMA buffers.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "stm32h7xx.h"
+#include <cstdint>
+namespace Utils {
+
+
+/**
+ * @brief   This class provides the D-Cache maintenance of the Cortex-M7 for buffers shared with a DMA.
+ * @details The maintenance works on lines of @ref LINE bytes, every range is widened to full lines:
+ *          - Clean: the CPU has written, the DMA reads next
+ *          - Invalidate: the DMA has written, the CPU reads next
+ *          - CleanInvalidate: the DMA writes next, no dirty line may be evicted into the buffer meanwhile.
+ *
+ * @note    Only available on the target (PLATFORM Baremetal). Buffers which are invalidated should start
+ *          and end on line boundaries, the widened lines of neighbouring data are discarded as well.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe.
+ *
+ */
+class DCache
+{
+    public:
+
+        /// @brief Bytes of a cache line.
+        static constexpr uintptr_t LINE{32U};
+
+        DCache() = delete;  //!< Constructor, static functions only
+
+        /// @brief Write the dirty lines of a range back to the memory.
+        static void Clean(const void* p, uint32_t len)
+        {
+            SCB_CleanDCache_by_Addr(Start(p), Size(p, len));
+        }
+
+        /// @brief Discard the lines of a range, the next read loads them from the memory.
+        static void Invalidate(const void* p, uint32_t len)
+        {
+            SCB_InvalidateDCache_by_Addr(Start(p), Size(p, len));
+        }
+
+        /// @brief Write back and discard the lines of a range.
+        static void CleanInvalidate(const void* p, uint32_t len)
+        {
+            SCB_CleanInvalidateDCache_by_Addr(Start(p), Size(p, len));
+        }
+
+    private:
+
+        /// @brief The first line of a range.
+        static uint32_t* Start(const void* p)
+        {
+            return reinterpret_cast<uint32_t*>(reinterpret_cast<uintptr_t>(p) & ~(LINE - 1U));
+        }
+
+        /// @brief The bytes from the first line to the end of a range.
+        static int32_t Size(const void* p, uint32_t len)
+        {
+            const uintptr_t start = reinterpret_cast<uintptr_t>(p) & ~(LINE - 1U);
+            return static_cast<int32_t>((reinterpret_cast<uintptr_t>(p) + len) - start);
+        }
+};
+
+} // end namespace Utils
@@ -60,8 +60,8 @@ class ILogger
         /// @brief Capacity of the internal ringbuffer in bytes.
         static constexpr size_t BUFFER_CAPACITY = 4096;
 
-        /// @brief Size of the header for each log entry in bytes.
-        static constexpr size_t HEADER_SIZE = sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint8_t);
+        /// @brief Size of the header for each log entry in bytes: length, timestamp in ns, level.
+        static constexpr size_t HEADER_SIZE = sizeof(uint16_t) + sizeof(uint64_t) + sizeof(uint8_t);
 
         /**
          * @brief Log a message with a specific log level.
@@ -72,8 +72,8 @@ class ILogger
 
     protected:
 
-        /// @brief Virtual constructor.
-        virtual ILogger() = default;
+        /// @brief Constructor.
+        ILogger() = default;
 
         /// @brief Virtual destructor for proper cleanup in derived classes.
         virtual ~ILogger() = default;
@@ -0,0 +1,56 @@
+/**
+ ********************************************************************************
+ * @file        ITimeSource.hpp
+ *
+ * @namespace   Utils
+ *
+ * @brief       Utils, interface of a time base for timestamps.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+namespace Utils {
+
+
+/**
+ * @brief   This class provides the time base of log records and sampled data.
+ * @details The default is the local clock, a synchronised clock (e.g. the PTP slave) replaces it
+ *          so that records of several nodes can be aligned.
+ *  - - -
+ *
+ * __Thread safety:__
+ * Implementations must be callable from threads and ISR's.
+ *
+ */
+class ITimeSource
+{
+    public:
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~ITimeSource() = default;
+
+        /**
+         * @brief Current time.
+         * @return Nanoseconds since the epoch of the time base.
+         */
+        virtual uint64_t GetTimeNs() const = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        ITimeSource() = default;
+
+        ITimeSource(ITimeSource const &) = default;             //!< Copy constructor
+        ITimeSource(ITimeSource &&) = default;                  //!< Move constructor
+
+        ITimeSource& operator=(ITimeSource const &) = default;  //!< Copy assignment
+        ITimeSource& operator=(ITimeSource &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Utils
@@ -1,143 +1,204 @@
 /**
  ********************************************************************************
  * @file        Logger.cpp
- * 
+ *
  * @namespace   Utils
- * 
+ *
  * @brief       Utils, Logsystem implementation.
- * 
+ *
  * @author      toberg
- * 
+ *
  * @date        2024/12/07
 ********************************************************************************/
 
 #include "Logger.hpp"
+#include "CriticalSection.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace Utils;
 
-void Logger::writeBytes(size_t index, const uint8_t* data, size_t len)
+namespace {
+
+/// @brief Longest printed message, longer ones are cut.
+constexpr size_t MAX_PRINT_LENGTH{255U};
+
+/// @brief Poll interval of the output thread.
+constexpr useconds_t OUTPUT_INTERVAL_US{2000U};
+
+} // end anonymous namespace
+
+
+Logger::Logger(LogLevel suppLevel, int outputFd)
+: mSuppLevel(suppLevel)
 {
-    size_t firstPart = std::min(len, BUFFER_CAPACITY - index);
-    std::memcpy(&buffer[index], data, firstPart);
-    if (len > firstPart)
+    if (outputFd >= 0)
     {
-        std::memcpy(&buffer[0], data + firstPart, len - firstPart);
+        mConsoleFd = outputFd;
     }
-}
-
-explicit Logger::Logger(LogLevel suppLevel)
-: head(0) 
-, tail(0)
-, running(true)
-, mSuppLevel(suppLevel)
-{
-    consoleFd = open("/dev/console", O_RDWR);
-    if (consoleFd < 0) consoleFd = 1; // fallback stdout
-    pthread_create(&thread, nullptr, &Logger::ThreadEntry, this);
+    else
+    {
+        mConsoleFd = open("/dev/console", O_WRONLY);
+        mOwnsFd = (mConsoleFd >= 0);
+        if (!mOwnsFd)
+        {
+            mConsoleFd = 1; // fallback stdout
+        }
+    }
+    mRunning = (pthread_create(&mThread, nullptr, &Logger::ThreadEntry, this) == 0);
 }
 
 
 Logger::~Logger()
 {
-    running = false;
-    pthread_join(thread, nullptr);
-    if (consoleFd > 2) close(consoleFd);
+    if (mRunning)
+    {
+        mRunning = false;
+        pthread_join(mThread, nullptr);
+    }
+    (void)Flush();
+    if (mOwnsFd)
+    {
+        close(mConsoleFd);
+    }
 }
 
+
 void Logger::Log(LogLevel level, const char *msg)
 {
-    if (level < minLevel) 
+    if ((msg == nullptr) || (level < mSuppLevel.load()))
     {
         return;
     }
-    const uint16_t len = strlen(msg);
-    const uint32_t ts = getTimestamp();
+    const uint16_t len = static_cast<uint16_t>(std::min(strlen(msg), MAX_PRINT_LENGTH));
+    const uint64_t ts = GetTimestamp();
     const uint8_t lvl = static_cast<uint8_t>(level);
     const size_t total = HEADER_SIZE + len;
-    if (total >= BUFFER_CAPACITY - 1) return;
-    size_t h = head.load(std::memory_order_relaxed);
-    size_t t = tail.load(std::memory_order_acquire);
-    // Überlaufbehandlung
-    while (freeSpace(h, t) <= total)
+
+    CriticalSection cs;
+    size_t h = mHead.load(std::memory_order_relaxed);
+    size_t t = mTail.load(std::memory_order_relaxed);
+
+    // overflow, drop the oldest records
+    while (FreeSpace(h, t) <= total)
     {
-        uint16_t oldLen;
-        readBytes(t, reinterpret_cast<uint8_t*>(&oldLen), sizeof(uint16_t));
+        uint16_t oldLen{0U};
+        ReadBytes(t, reinterpret_cast<uint8_t*>(&oldLen), sizeof(uint16_t));
         t = (t + HEADER_SIZE + oldLen) % BUFFER_CAPACITY;
     }
-    writeBytes(h, reinterpret_cast<const uint8_t*>(&len), sizeof(uint16_t));
+
+    WriteBytes(h, reinterpret_cast<const uint8_t*>(&len), sizeof(uint16_t));
     h = (h + sizeof(uint16_t)) % BUFFER_CAPACITY;
-    writeBytes(h, reinterpret_cast<const uint8_t*>(&ts), sizeof(uint32_t));
-    h = (h + sizeof(uint32_t)) % BUFFER_CAPACITY;
-    writeBytes(h, &lvl, sizeof(uint8_t));
+    WriteBytes(h, reinterpret_cast<const uint8_t*>(&ts), sizeof(uint64_t));
+    h = (h + sizeof(uint64_t)) % BUFFER_CAPACITY;
+    WriteBytes(h, &lvl, sizeof(uint8_t));
     h = (h + sizeof(uint8_t)) % BUFFER_CAPACITY;
-    writeBytes(h, reinterpret_cast<const uint8_t*>(msg), len);
+    WriteBytes(h, reinterpret_cast<const uint8_t*>(msg), len);
     h = (h + len) % BUFFER_CAPACITY;
-    head.store(h, std::memory_order_release);
-    tail.store(t, std::memory_order_release);
-}
 
+    mHead.store(h, std::memory_order_release);
+    mTail.store(t, std::memory_order_release);
+}
 
 
-    static void *threadEntry(void *arg)
+size_t Logger::Flush()
+{
+    size_t count = 0U;
+    while (PrintNext())
     {
-        static_cast<Logger*>(arg)->process();
-        return nullptr;
+        count++;
     }
+    return count;
+}
+
 
-    void process()
+void* Logger::ThreadEntry(void *arg)
+{
+    Logger* pLogger = static_cast<Logger*>(arg);
+    while (pLogger->mRunning)
     {
-        while (running)
+        while (pLogger->PrintNext())
         {
-            printNext();
-            usleep(2000);
         }
+        usleep(OUTPUT_INTERVAL_US);
     }
+    return nullptr;
+}
 
-    void printNext()
-    {
-        size_t t = tail.load(std::memory_order_relaxed);
-        size_t h = head.load(std::memory_order_acquire);
-        if (t == h) return;
 
-        uint16_t len;
-        uint32_t ts;
-        uint8_t lvl;
-        char msg[256];
+bool Logger::PrintNext()
+{
+    uint16_t len{0U};
+    uint64_t ts{0U};
+    uint8_t lvl{0U};
+    char msg[MAX_PRINT_LENGTH + 1U];
 
-        readBytes(t, reinterpret_cast<uint8_t*>(&len), sizeof(uint16_t));
+    {
+        // the record is copied out, a writer may drop it on overflow meanwhile
+        CriticalSection cs;
+        size_t t = mTail.load(std::memory_order_relaxed);
+        if (t == mHead.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        ReadBytes(t, reinterpret_cast<uint8_t*>(&len), sizeof(uint16_t));
         t = (t + sizeof(uint16_t)) % BUFFER_CAPACITY;
-        readBytes(t, reinterpret_cast<uint8_t*>(&ts), sizeof(uint32_t));
-        t = (t + sizeof(uint32_t)) % BUFFER_CAPACITY;
-        readBytes(t, &lvl, sizeof(uint8_t));
+        ReadBytes(t, reinterpret_cast<uint8_t*>(&ts), sizeof(uint64_t));
+        t = (t + sizeof(uint64_t)) % BUFFER_CAPACITY;
+        ReadBytes(t, &lvl, sizeof(uint8_t));
         t = (t + sizeof(uint8_t)) % BUFFER_CAPACITY;
-        if (len >= sizeof(msg)) len = sizeof(msg) - 1;
-        readBytes(t, reinterpret_cast<uint8_t*>(msg), len);
-        msg[len] = '\0';
+        ReadBytes(t, reinterpret_cast<uint8_t*>(msg), len);
         t = (t + len) % BUFFER_CAPACITY;
-
-        dprintf(consoleFd, "[%010u][%s] %s\n", ts, levelToString(static_cast<Level>(lvl)), msg);
-        tail.store(t, std::memory_order_release);
+        mTail.store(t, std::memory_order_release);
     }
+    msg[len] = '\0';
+
+    dprintf(mConsoleFd, "[%llu.%09llu][%s] %s\n", static_cast<unsigned long long>(ts / 1000000000U),
+            static_cast<unsigned long long>(ts % 1000000000U), ToString(static_cast<LogLevel>(lvl)), msg);
+    return true;
+}
 
-    static uint32_t getTimestamp()
-    {
-        struct timespec ts;
-        clock_gettime(CLOCK_REALTIME, &ts);
-        return (ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
-    }
 
-    size_t freeSpace(size_t h, size_t t) const
+uint64_t Logger::GetTimestamp() const
+{
+    const ITimeSource* pTimeSource = mpTimeSource.load();
+    if (pTimeSource != nullptr)
     {
-        return (h >= t) ? BUFFER_CAPACITY - (h - t) : t - h;
+        return pTimeSource->GetTimeNs();
     }
+    struct timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000000U) + static_cast<uint64_t>(now.tv_nsec);
+}
+
 
-    void writeBytes(size_t pos, const uint8_t *data, size_t len)
+size_t Logger::FreeSpace(size_t head, size_t tail)
+{
+    return (head >= tail) ? BUFFER_CAPACITY - (head - tail) : tail - head;
+}
+
+
+void Logger::WriteBytes(size_t index, const uint8_t* data, size_t len)
+{
+    size_t firstPart = std::min(len, BUFFER_CAPACITY - index);
+    std::memcpy(&mBuffer[index], data, firstPart);
+    if (len > firstPart)
     {
-        for (size_t i = 0; i < len; i++) { buffer[pos] = data[i]; pos = (pos + 1) % BUFFER_CAPACITY; }
+        std::memcpy(&mBuffer[0], data + firstPart, len - firstPart);
     }
+}
+
 
-    void readBytes(size_t pos, uint8_t *data, size_t len)
+void Logger::ReadBytes(size_t index, uint8_t* data, size_t len) const
+{
+    size_t firstPart = std::min(len, BUFFER_CAPACITY - index);
+    std::memcpy(data, &mBuffer[index], firstPart);
+    if (len > firstPart)
     {
-        for (size_t i = 0; i < len; i++) { data[i] = buffer[pos]; pos = (pos + 1) % BUFFER_CAPACITY; }
+        std::memcpy(data + firstPart, &mBuffer[0], len - firstPart);
     }
-};
+}
@@ -0,0 +1,106 @@
+/**
+ ********************************************************************************
+ * @file        SpscQueue.hpp
+ *
+ * @namespace   Utils
+ *
+ * @brief       Utils, lock-free single producer single consumer queue.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+namespace Utils {
+
+
+/**
+ * @brief   This class provides a bounded queue between one producer and one consumer context.
+ * @details Head and tail are free running counters, the slot is the counter modulo the capacity. The producer
+ *          writes the slot and publishes it with a release store of the tail, the consumer acquires the tail,
+ *          reads the slot and frees it with a release store of the head. Neither side waits or masks
+ *          interrupts, so the producer may be an ISR. On the Cortex-M7 the aligned word loads and stores of
+ *          the counters are atomic, the barriers order the slot accesses.
+ * @note    CAPACITY must be a power of two.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe for one producer and one consumer context.\n
+ * @ref Clear belongs to the consumer and requires an idle producer.
+ *
+ */
+template<typename T, size_t CAPACITY>
+class SpscQueue
+{
+    static_assert((CAPACITY > 0U) && ((CAPACITY & (CAPACITY - 1U)) == 0U), "CAPACITY must be a power of two");
+
+    public:
+
+        /**
+         * @brief   Producer: append an element.
+         *
+         * @param   value   The element.
+         *
+         * @return  true if appended, false if the queue is full.
+         */
+        bool Push(const T& value)
+        {
+            const size_t tail = mTail.load(std::memory_order_relaxed);
+            if ((tail - mHead.load(std::memory_order_acquire)) == CAPACITY)
+            {
+                return false;
+            }
+            mSlots[tail & (CAPACITY - 1U)] = value;
+            mTail.store(tail + 1U, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief   Consumer: remove the oldest element.
+         *
+         * @param   value   Receives the element.
+         *
+         * @return  true if removed, false if the queue is empty.
+         */
+        bool Pop(T& value)
+        {
+            const size_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mTail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            value = mSlots[head & (CAPACITY - 1U)];
+            mHead.store(head + 1U, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Count of queued elements, a snapshot.
+        size_t Size() const
+        {
+            return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+        }
+
+        /// @brief Consumer: drop all elements.
+        void Clear() {mHead.store(mTail.load(std::memory_order_acquire), std::memory_order_release);};
+
+        /// @brief The capacity.
+        static constexpr size_t Capacity() {return CAPACITY;};
+
+    private:
+
+        /// @brief The elements.
+        std::array<T, CAPACITY> mSlots{};
+
+        /// @brief Next element to remove, written by the consumer.
+        alignas(32) std::atomic<size_t> mHead{0U};
+
+        /// @brief Next free slot, written by the producer.
+        alignas(32) std::atomic<size_t> mTail{0U};
+};
+
+} // end namespace Utils
@@ -0,0 +1,124 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../Logger.hpp"
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Utils;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  PrintWithTimeSource
+*   (0)  SuppressLowerLevels
+*   (0)  OverflowDropsOldest
+*/
+
+//################################### Test helpers #######################################
+
+/// @brief Time source with a fixed time.
+class FixedTime : public ITimeSource
+{
+    public:
+        explicit FixedTime(uint64_t ns) : mNs(ns) {};
+        uint64_t GetTimeNs() const override {return mNs;};
+
+    private:
+        uint64_t mNs;
+};
+
+/// @brief Non blocking pipe which collects the logger output.
+class Output
+{
+    public:
+        Output()
+        {
+            (void)pipe(mFds);
+            (void)fcntl(mFds[0], F_SETFL, O_NONBLOCK);
+            (void)fcntl(mFds[1], F_SETFL, O_NONBLOCK);
+        };
+        ~Output()
+        {
+            close(mFds[0]);
+            close(mFds[1]);
+        };
+        int GetFd() const {return mFds[1];};
+        std::string Read()
+        {
+            std::string text;
+            char chunk[256];
+            ssize_t len;
+            while ((len = read(mFds[0], chunk, sizeof(chunk))) > 0)
+            {
+                text.append(chunk, static_cast<size_t>(len));
+            }
+            return text;
+        };
+
+    private:
+        int mFds[2]{-1, -1};
+};
+
+//################################### Tests start here #######################################
+
+
+TEST(Logger_Test,PrintWithTimeSource)
+{
+    Output output;
+    FixedTime time(1234567890123U);
+    {
+        Logger logger(ILogger::LogLevel::DEBUG, output.GetFd());
+        logger.SetTimeSource(&time);
+        logger.Log(ILogger::LogLevel::INFO, "hello");
+    }
+    ASSERT_EQ(output.Read(), "[1234.567890123][INF] hello\n");
+}
+
+
+TEST(Logger_Test,SuppressLowerLevels)
+{
+    Output output;
+    FixedTime time(5U);
+    {
+        Logger logger(ILogger::LogLevel::WARN, output.GetFd());
+        logger.SetTimeSource(&time);
+        logger.Log(ILogger::LogLevel::INFO, "hidden");
+        logger.Log(ILogger::LogLevel::ERROR, "shown");
+        ASSERT_EQ(logger.GetLevel(), ILogger::LogLevel::WARN);
+    }
+    ASSERT_EQ(output.Read(), "[0.000000005][ERR] shown\n");
+}
+
+
+TEST(Logger_Test,OverflowDropsOldest)
+{
+    Output output;
+    std::unique_ptr<Logger> spUUT = std::make_unique<Logger>(ILogger::LogLevel::DEBUG, output.GetFd());
+    const std::string msg(100U, 'x');
+    for (size_t i = 0U; i < 300U; i++)
+    {
+        spUUT->Log(ILogger::LogLevel::DEBUG, msg.c_str());
+    }
+    spUUT->Log(ILogger::LogLevel::ERROR, "last");
+    spUUT.reset();
+
+    const std::string text = output.Read();
+    ASSERT_GT(text.size(), 0U);
+    ASSERT_NE(text.find("[ERR] last\n"), std::string::npos);
+}
+
+} // end namespace GTest
@@ -0,0 +1,349 @@
+/**
+ ********************************************************************************
+ * @file        CameraPortHal.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, DCMI camera port implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CameraPortHal.hpp"
+#include "DCache.hpp"
+#include <algorithm>
+
+using namespace Video;
+
+CameraPortHal* CameraPortHal::spInstance = nullptr;
+
+namespace {
+
+void DmaHalfCallback(DMA_HandleTypeDef* hdma)
+{
+    CameraPortHal* pPort = CameraPortHal::GetInstance(static_cast<DCMI_HandleTypeDef*>(hdma->Parent));
+    if (pPort != nullptr)
+    {
+        pPort->OnHalf(0U);
+    }
+}
+
+void DmaCompleteCallback(DMA_HandleTypeDef* hdma)
+{
+    CameraPortHal* pPort = CameraPortHal::GetInstance(static_cast<DCMI_HandleTypeDef*>(hdma->Parent));
+    if (pPort != nullptr)
+    {
+        pPort->OnHalf(1U);
+    }
+}
+
+void DmaErrorCallback(DMA_HandleTypeDef* hdma)
+{
+    CameraPortHal* pPort = CameraPortHal::GetInstance(static_cast<DCMI_HandleTypeDef*>(hdma->Parent));
+    if (pPort != nullptr)
+    {
+        pPort->OnFault();
+    }
+}
+
+void CopyDoneCallback(MDMA_HandleTypeDef* hmdma)
+{
+    CameraPortHal* pPort = CameraPortHal::GetInstance(hmdma);
+    if (pPort != nullptr)
+    {
+        pPort->OnCopyDone();
+    }
+}
+
+void CopyErrorCallback(MDMA_HandleTypeDef* hmdma)
+{
+    CameraPortHal* pPort = CameraPortHal::GetInstance(hmdma);
+    if (pPort != nullptr)
+    {
+        pPort->OnFault();
+    }
+}
+
+} // end anonymous namespace
+
+
+CameraPortHal::CameraPortHal(DCMI_HandleTypeDef& hdcmi, MDMA_HandleTypeDef& hmdma, std::span<uint32_t> lineRing)
+: mHdcmi(hdcmi)
+, mHmdma(hmdma)
+, mLineRing(lineRing)
+{
+    spInstance = this;
+}
+
+
+CameraPortHal::~CameraPortHal()
+{
+    Stop();
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+CameraPortHal* CameraPortHal::GetInstance(const DCMI_HandleTypeDef* hdcmi)
+{
+    if ((spInstance != nullptr) && (hdcmi == &spInstance->mHdcmi))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+CameraPortHal* CameraPortHal::GetInstance(const MDMA_HandleTypeDef* hmdma)
+{
+    if ((spInstance != nullptr) && (hmdma == &spInstance->mHmdma))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status CameraPortHal::Start(const CaptureConfig& config, uint8_t* pFrame)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    const uint32_t lineBytes = config.LineBytes();
+    if (config.window.IsEmpty() || (config.stride < lineBytes) || ((lineBytes % 4U) != 0U)
+        || ((config.stride % 4U) != 0U) || ((reinterpret_cast<uintptr_t>(pFrame) % 4U) != 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    // the most lines per half which divide the frame
+    uint32_t lines = std::min<uint32_t>((mLineRing.size() * sizeof(uint32_t)) / (2U * lineBytes),
+                                        config.window.height);
+    while ((lines > 0U) && ((config.window.height % lines) != 0U))
+    {
+        lines--;
+    }
+    if (lines == 0U)
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    // the window in pixel clocks (8 bit data)
+    const uint32_t clocks = BytesPerPixel(config.format);
+    HAL_StatusTypeDef result = HAL_DCMI_ConfigCrop(&mHdcmi, config.window.x * clocks, config.window.y,
+                                                   lineBytes - 1U, config.window.height - 1U);
+    if (result == HAL_OK)
+    {
+        result = HAL_DCMI_EnableCrop(&mHdcmi);
+    }
+
+    // a block per line, the destination steps to the next line of the frame
+    mHmdma.Init.SourceBlockAddressOffset = 0;
+    mHmdma.Init.DestBlockAddressOffset = static_cast<int32_t>(config.stride - lineBytes);
+    mHmdma.Init.TransferTriggerMode = MDMA_REPEAT_BLOCK_TRANSFER;
+    if (result == HAL_OK)
+    {
+        result = HAL_MDMA_DeInit(&mHmdma);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_MDMA_Init(&mHmdma);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_MDMA_RegisterCallback(&mHmdma, HAL_MDMA_XFER_CPLT_CB_ID, CopyDoneCallback);
+    }
+    if (result == HAL_OK)
+    {
+        result = HAL_MDMA_RegisterCallback(&mHmdma, HAL_MDMA_XFER_ERROR_CB_ID, CopyErrorCallback);
+    }
+    if (result != HAL_OK)
+    {
+        return ToStatus(result);
+    }
+
+    mConfig = config;
+    mLinesPerHalf = lines;
+    mpFrame = pFrame;
+    mLine = 0U;
+    mStatus = Status::OK;
+    mCopying = false;
+    mEndPending = false;
+    mRunning = true;
+    result = StartDma();
+    if (result != HAL_OK)
+    {
+        Stop();
+    }
+    return ToStatus(result);
+}
+
+
+void CameraPortHal::Stop()
+{
+    if (mRunning)
+    {
+        mRunning = false;
+        (void)HAL_DCMI_Stop(&mHdcmi);
+        (void)HAL_MDMA_Abort(&mHmdma);
+        mCopying = false;
+    }
+}
+
+
+HAL_StatusTypeDef CameraPortHal::StartDma()
+{
+    // the half transfer interrupt is enabled by the start if its callback is set
+    DMA_HandleTypeDef* hdma = mHdcmi.DMA_Handle;
+    hdma->XferHalfCpltCallback = DmaHalfCallback;
+    const uint32_t words = (2U * mLinesPerHalf * mConfig.LineBytes()) / sizeof(uint32_t);
+    const HAL_StatusTypeDef result = HAL_DCMI_Start_DMA(&mHdcmi, DCMI_MODE_CONTINUOUS,
+                                                        reinterpret_cast<uint32_t>(mLineRing.data()), words);
+    // the ring is shorter than a DMA transfer, the halves replace the frame handling of the HAL
+    hdma->XferCpltCallback = DmaCompleteCallback;
+    hdma->XferErrorCallback = DmaErrorCallback;
+    return result;
+}
+
+
+void CameraPortHal::OnHalf(uint8_t half)
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    if (mEndPending)
+    {
+        // the last copy of the previous frame did not finish within a half
+        (void)HAL_MDMA_Abort(&mHmdma);
+        mCopying = false;
+        FinishFrame(Status::OVERRUN);
+    }
+
+    const uint32_t lineBytes = mConfig.LineBytes();
+    if (mpFrame != nullptr)
+    {
+        if (mCopying)
+        {
+            mStatus = Status::OVERRUN;
+        }
+        else
+        {
+            const uint8_t* pSource = reinterpret_cast<const uint8_t*>(mLineRing.data())
+                                   + (static_cast<size_t>(half) * mLinesPerHalf * lineBytes);
+            uint8_t* pDestination = mpFrame + (static_cast<size_t>(mLine) * mConfig.stride);
+            mCopying = true;
+            if (HAL_MDMA_Start_IT(&mHmdma, reinterpret_cast<uint32_t>(pSource),
+                                  reinterpret_cast<uint32_t>(pDestination), lineBytes, mLinesPerHalf) != HAL_OK)
+            {
+                mCopying = false;
+                mStatus = Status::OVERRUN;
+            }
+        }
+    }
+
+    mLine += mLinesPerHalf;
+    if (mLine >= mConfig.window.height)
+    {
+        mLine = 0U;
+        if (mCopying)
+        {
+            mEndPending = true;
+        }
+        else
+        {
+            FinishFrame(mStatus);
+        }
+    }
+}
+
+
+void CameraPortHal::OnCopyDone()
+{
+    mCopying = false;
+    if (mRunning && mEndPending)
+    {
+        FinishFrame(mStatus);
+    }
+}
+
+
+void CameraPortHal::OnError()
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    if ((HAL_DCMI_GetError(&mHdcmi) & HAL_DCMI_ERROR_DMA) != 0U)
+    {
+        OnFault();
+        return;
+    }
+    // the HAL has aborted the DMA, the capture restarts with the next frame
+    (void)HAL_DCMI_Stop(&mHdcmi);
+    (void)HAL_MDMA_Abort(&mHmdma);
+    mCopying = false;
+    mLine = 0U;
+    FinishFrame(Status::OVERRUN);
+    if (StartDma() != HAL_OK)
+    {
+        OnFault();
+    }
+}
+
+
+void CameraPortHal::OnFault()
+{
+    if (!mRunning)
+    {
+        return;
+    }
+    Stop();
+    uint8_t* pFrame = mpFrame;
+    mpFrame = nullptr;
+    if (mpListener != nullptr)
+    {
+        (void)mpListener->OnFrame(pFrame, Status::HW_ERROR);
+    }
+}
+
+
+void CameraPortHal::FinishFrame(Status status)
+{
+    uint8_t* pDone = mpFrame;
+    mEndPending = false;
+    mStatus = Status::OK;
+    if (pDone != nullptr)
+    {
+        Utils::DCache::Invalidate(pDone, mConfig.FrameBytes());
+    }
+    mpFrame = (mpListener != nullptr) ? mpListener->OnFrame(pDone, status) : nullptr;
+}
+
+
+Status CameraPortHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_DCMI_ErrorCallback(DCMI_HandleTypeDef* hdcmi)
+{
+    CameraPortHal* pPort = CameraPortHal::GetInstance(hdcmi);
+    if (pPort != nullptr)
+    {
+        pPort->OnError();
+    }
+}
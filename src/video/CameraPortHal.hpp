@@ -0,0 +1,137 @@
+/**
+ ********************************************************************************
+ * @file        CameraPortHal.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, camera port on the DCMI with line by line transfer to the SDRAM.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICameraPort.hpp"
+#include "stm32h7xx_hal.h"
+#include <span>
+namespace Video {
+
+
+/**
+ * @brief   This class provides the ICameraPort on the DCMI of the STM32H7, the frames go by MDMA into the
+ *          buffers (SDRAM).
+ * @details The DCMI crops the window (HAL_DCMI_ConfigCrop) and streams in continuous mode by its DMA
+ *          (HAL_DCMI_Start_DMA) into a circular line ring in the internal RAM. The ring holds two halves of
+ *          some lines each, the count divides the window height, so every frame fills whole halves and the
+ *          ring stays aligned with the frames. A DMA transfer never covers a frame, so the size of a frame
+ *          is not limited by the 65535 items of a DMA transfer and the next frame needs no new start.\n
+ *          The half and full transfer callbacks start one MDMA block transfer per half: one block per line,
+ *          the destination steps by the stride (DestBlockAddressOffset). When the last half of a frame is
+ *          copied, the D-Cache lines of the buffer are invalidated and the frame is reported, the listener
+ *          returns the buffer of the next frame, which starts behind the vertical blanking.\n
+ *          A copy which is not done before the next half, a DCMI overrun or a synchronisation error marks
+ *          the frame as OVERRUN, after a DCMI error the capture restarts with the next frame. A DMA or MDMA
+ *          error stops the capture (HW_ERROR).
+ * @note    The application initialises the DCMI (HAL_DCMI_Init with the sensor polarities, 8 bit data),
+ *          links its DMA in circular mode with word transfers (HAL_DCMI_MspInit), initialises a MDMA
+ *          channel (software request, word size) and the SDRAM (HAL_SDRAM_Init and the mode register
+ *          sequence) and calls HAL_DCMI_IRQHandler, the DMA and the MDMA handlers. The line ring must be
+ *          located in the AXI or D2 SRAM, the lines and the stride must be multiples of 4 bytes. The restart
+ *          after a DCMI error waits for the end of the capture in the interrupt (HAL_DCMI_Stop).
+ *          One instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one CaptureService.
+ *
+ */
+class CameraPortHal : public ICameraPort
+{
+    public:
+
+        /**
+         * @brief   Constructs the port for initialised handles.
+         *
+         * @param   hdcmi       The DCMI with its DMA.
+         * @param   hmdma       The MDMA channel of the copies.
+         * @param   lineRing    The line ring, at least two lines.
+         */
+        CameraPortHal(DCMI_HandleTypeDef& hdcmi, MDMA_HandleTypeDef& hmdma, std::span<uint32_t> lineRing);
+
+        /// @brief Destructor.
+        ~CameraPortHal() override;
+
+        CameraPortHal(CameraPortHal const &) = delete;             //!< Copy constructor
+        CameraPortHal& operator=(CameraPortHal const &) = delete;  //!< Copy assignment
+
+        /// @copydoc ICameraPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ICameraPort::Start
+        Status Start(const CaptureConfig& config, uint8_t* pFrame) override;
+
+        /// @copydoc ICameraPort::Stop
+        void Stop() override;
+
+        /**
+         * @brief   A half of the line ring is filled, called by the DMA callbacks.
+         *
+         * @param   half    0 for the first, 1 for the second half.
+         */
+        void OnHalf(uint8_t half);
+
+        /// @brief The copy of a half is done, called by the MDMA callback.
+        void OnCopyDone();
+
+        /// @brief DCMI overrun or synchronisation error, called by HAL_DCMI_ErrorCallback.
+        void OnError();
+
+        /// @brief DMA or MDMA error, stops the capture and reports HW_ERROR.
+        void OnFault();
+
+        /// @brief Port which uses a DCMI handle or nullptr.
+        static CameraPortHal* GetInstance(const DCMI_HandleTypeDef* hdcmi);
+
+        /// @brief Port which uses a MDMA handle or nullptr.
+        static CameraPortHal* GetInstance(const MDMA_HandleTypeDef* hmdma);
+
+    private:
+
+        /// @brief Start the DMA into the line ring, the capture begins with the next frame.
+        HAL_StatusTypeDef StartDma();
+
+        /// @brief Report the frame and take the buffer of the next one.
+        void FinishFrame(Status status);
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The DCMI.
+        DCMI_HandleTypeDef& mHdcmi;
+
+        /// @brief The MDMA channel.
+        MDMA_HandleTypeDef& mHmdma;
+
+        /// @brief The line ring.
+        std::span<uint32_t> mLineRing;
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        CaptureConfig mConfig{};            //!< The running capture
+        uint32_t mLinesPerHalf{0U};         //!< Lines of a half of the ring
+        uint8_t* mpFrame{nullptr};          //!< Buffer of the running frame
+        uint32_t mLine{0U};                 //!< Lines of the running frame received
+        Status mStatus{Status::OK};         //!< Result of the running frame
+        volatile bool mCopying{false};      //!< A MDMA copy runs
+        volatile bool mEndPending{false};   //!< The frame ends with the running copy
+        volatile bool mRunning{false};      //!< The capture runs
+
+        /// @brief The single port instance, the device has one DCMI.
+        static CameraPortHal* spInstance;
+};
+
+} // end namespace Video
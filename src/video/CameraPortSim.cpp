@@ -0,0 +1,87 @@
+/**
+ ********************************************************************************
+ * @file        CameraPortSim.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, synthetic camera sensor implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CameraPortSim.hpp"
+
+using namespace Video;
+
+
+Status CameraPortSim::Start(const CaptureConfig& config, uint8_t* pFrame)
+{
+    if (mRunning)
+    {
+        return Status::BUSY;
+    }
+    if (config.window.IsEmpty() || !Rect{0U, 0U, mWidth, mHeight}.Contains(config.window)
+        || (config.stride < config.LineBytes()))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mConfig = config;
+    mpFrame = pFrame;
+    mFrame = 0U;
+    mOverrun = false;
+    mFault = false;
+    mRunning = true;
+    return Status::OK;
+}
+
+
+uint32_t CameraPortSim::Capture(uint32_t frames)
+{
+    uint32_t captured = 0U;
+    while (mRunning && (captured < frames))
+    {
+        Status status = Status::OK;
+        uint32_t lines = mConfig.window.height;
+        if (mFault)
+        {
+            status = Status::HW_ERROR;
+            lines = 0U;
+        }
+        else if (mOverrun)
+        {
+            status = Status::OVERRUN;
+            lines /= 2U;
+        }
+        mOverrun = false;
+
+        const uint32_t bytes = BytesPerPixel(mConfig.format);
+        for (uint32_t y = 0U; (mpFrame != nullptr) && (y < lines); y++)
+        {
+            uint8_t* pLine = mpFrame + (static_cast<size_t>(y) * mConfig.stride);
+            for (uint32_t x = 0U; x < mConfig.window.width; x++)
+            {
+                for (uint32_t b = 0U; b < bytes; b++)
+                {
+                    pLine[(x * bytes) + b] = Byte(mConfig.window.x + x, mConfig.window.y + y, b, mFrame);
+                }
+            }
+        }
+        mFrame++;
+        captured++;
+
+        uint8_t* pDone = mpFrame;
+        mpFrame = nullptr;
+        if (status == Status::HW_ERROR)
+        {
+            mRunning = false;
+        }
+        if (mpListener != nullptr)
+        {
+            uint8_t* pNext = mpListener->OnFrame(pDone, status);
+            mpFrame = mRunning ? pNext : nullptr;
+        }
+    }
+    return captured;
+}
@@ -0,0 +1,106 @@
+/**
+ ********************************************************************************
+ * @file        CameraPortSim.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, synthetic camera sensor on the host.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICameraPort.hpp"
+namespace Video {
+
+
+/**
+ * @brief   This class provides an ICameraPort with a synthetic sensor in host memory.
+ * @details The sensor side (@ref Capture) produces frame by frame: the window of the sensor frame is copied
+ *          line by line into the buffer of the frame, every byte is the test pattern @ref Byte of its sensor
+ *          position and the frame number, so a consumer can check any buffer for a torn or stale frame. The
+ *          listener is called synchronously like the frame interrupt.\n
+ *          @ref InjectOverrun loses the second half of the next frame, @ref InjectFault stops the capture
+ *          like a DMA error.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * @ref Capture may run in another thread (the simulated interrupt context) while no Start or Stop is called.
+ *
+ */
+class CameraPortSim : public ICameraPort
+{
+    public:
+
+        /**
+         * @brief   Constructs the sensor.
+         *
+         * @param   width       Pixels per line of the sensor frame.
+         * @param   height      Lines of the sensor frame.
+         */
+        CameraPortSim(uint16_t width, uint16_t height) : mWidth(width), mHeight(height) {};
+
+        /// @copydoc ICameraPort::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc ICameraPort::Start
+        Status Start(const CaptureConfig& config, uint8_t* pFrame) override;
+
+        /// @copydoc ICameraPort::Stop
+        void Stop() override {mRunning = false;};
+
+        /**
+         * @brief   Sensor side: produce frames.
+         *
+         * @param   frames  Count of frames.
+         *
+         * @return  Count of produced frames, 0 if stopped.
+         */
+        uint32_t Capture(uint32_t frames);
+
+        /// @brief The second half of the next frame is lost.
+        void InjectOverrun() {mOverrun = true;};
+
+        /// @brief The next frame fails, the capture stops.
+        void InjectFault() {mFault = true;};
+
+        /// @brief The capture runs.
+        bool IsRunning() const {return mRunning;};
+
+        /// @brief Sensor frames since the start.
+        uint32_t GetFrames() const {return mFrame;};
+
+        /**
+         * @brief   The test pattern.
+         *
+         * @param   x       Column in the sensor frame.
+         * @param   y       Line in the sensor frame.
+         * @param   index   Byte of the pixel.
+         * @param   frame   Frame number since the start.
+         *
+         * @return  The byte.
+         */
+        static uint8_t Byte(uint32_t x, uint32_t y, uint32_t index, uint32_t frame)
+        {
+            return static_cast<uint8_t>((x * 3U) + (y * 5U) + (index * 7U) + (frame * 11U));
+        }
+
+    private:
+
+        uint16_t mWidth;                    //!< Pixels per line of the sensor
+        uint16_t mHeight;                   //!< Lines of the sensor
+        IListener* mpListener{nullptr};     //!< Frame receiver
+        CaptureConfig mConfig{};            //!< The running capture
+        uint8_t* mpFrame{nullptr};          //!< Buffer of the next frame
+        uint32_t mFrame{0U};                //!< Next frame number
+        bool mOverrun{false};               //!< Lose data of the next frame
+        bool mFault{false};                 //!< Fail the next frame
+        bool mRunning{false};               //!< The capture runs
+};
+
+} // end namespace Video
@@ -0,0 +1,218 @@
+/**
+ ********************************************************************************
+ * @file        CaptureService.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, camera capture implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "CaptureService.hpp"
+#include <bit>
+
+using namespace Video;
+
+
+CaptureService::CaptureService(ICameraPort& port)
+: mPort(port)
+{
+    mPort.SetListener(this);
+}
+
+
+CaptureService::~CaptureService()
+{
+    Stop();
+    mPort.SetListener(nullptr);
+}
+
+
+Status CaptureService::Start(const CaptureConfig& config, uint8_t* const* pBuffers, uint32_t count)
+{
+    if (IsRunning())
+    {
+        return Status::BUSY;
+    }
+    if ((pBuffers == nullptr) || (count < 2U) || (count > MAX_FRAMES))
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (pBuffers[i] == nullptr)
+        {
+            return Status::INVALID_PARAM;
+        }
+    }
+
+    // the interrupt is idle, buffer 0 goes to the port, the others are free
+    mConfig = config;
+    mCount = count;
+    for (uint32_t i = 0U; i < MAX_FRAMES; i++)
+    {
+        mBuffers[i] = (i < count) ? pBuffers[i] : nullptr;
+        mRefs[i].store(0U, std::memory_order_relaxed);
+        mSeen[i].store(false, std::memory_order_relaxed);
+    }
+    mRefs[0].store(1U, std::memory_order_relaxed);
+    mCapturing = 0U;
+    mFree.store(((1U << count) - 1U) & ~1U, std::memory_order_relaxed);
+    mLatest.store(NONE, std::memory_order_relaxed);
+    mCaptured.store(0U, std::memory_order_relaxed);
+    mSkipped.store(0U, std::memory_order_relaxed);
+    mReplaced.store(0U, std::memory_order_relaxed);
+    mErrors.store(0U, std::memory_order_relaxed);
+    mRunning.store(true, std::memory_order_release);
+
+    const Status status = mPort.Start(config, mBuffers[0]);
+    if (status != Status::OK)
+    {
+        mRunning.store(false, std::memory_order_release);
+    }
+    return status;
+}
+
+
+void CaptureService::Stop()
+{
+    if (IsRunning())
+    {
+        mPort.Stop();
+        mRunning.store(false, std::memory_order_release);
+        if (mCapturing != NONE)
+        {
+            Unref(mCapturing);
+            mCapturing = NONE;
+        }
+    }
+}
+
+
+bool CaptureService::Acquire(CapturedFrame& frame)
+{
+    for (;;)
+    {
+        const uint32_t index = mLatest.load(std::memory_order_acquire);
+        if (index == NONE)
+        {
+            return false;
+        }
+        // a buffer without references may already be in the capture
+        uint32_t refs = mRefs[index].load(std::memory_order_relaxed);
+        if ((refs == 0U) || !mRefs[index].compare_exchange_weak(refs, refs + 1U, std::memory_order_acq_rel))
+        {
+            continue;
+        }
+        // held now, it is valid if it was still the newest frame
+        if (mLatest.load(std::memory_order_acquire) != index)
+        {
+            Unref(index);
+            continue;
+        }
+        mSeen[index].store(true, std::memory_order_relaxed);
+        frame.frame = {mBuffers[index], mConfig.window.width, mConfig.window.height, mConfig.stride, mConfig.format};
+        frame.sequence = mSequences[index];
+        frame.index = static_cast<uint8_t>(index);
+        return true;
+    }
+}
+
+
+void CaptureService::AddRef(const CapturedFrame& frame)
+{
+    if (frame.index < mCount)
+    {
+        mRefs[frame.index].fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+
+void CaptureService::Release(const CapturedFrame& frame)
+{
+    if (frame.index < mCount)
+    {
+        Unref(frame.index);
+    }
+}
+
+
+uint8_t* CaptureService::OnFrame(uint8_t* pFrame, Status status)
+{
+    const uint32_t index = IndexOf(pFrame);
+    if (index == NONE)
+    {
+        mSkipped.fetch_add(1U, std::memory_order_relaxed);
+    }
+    else if (status == Status::OK)
+    {
+        // the reference of the port becomes the one of the newest frame
+        mSequences[index] = mCaptured.load(std::memory_order_relaxed);
+        mSeen[index].store(false, std::memory_order_relaxed);
+        const uint32_t previous = mLatest.exchange(index, std::memory_order_acq_rel);
+        mCaptured.fetch_add(1U, std::memory_order_release);
+        if (previous != NONE)
+        {
+            if (!mSeen[previous].load(std::memory_order_relaxed))
+            {
+                mReplaced.fetch_add(1U, std::memory_order_relaxed);
+            }
+            Unref(previous);
+        }
+    }
+    else
+    {
+        mErrors.fetch_add(1U, std::memory_order_relaxed);
+        Unref(index);
+    }
+
+    mCapturing = NONE;
+    if (status == Status::HW_ERROR)
+    {
+        // the port has stopped
+        mRunning.store(false, std::memory_order_release);
+        return nullptr;
+    }
+    mCapturing = Claim();
+    return (mCapturing != NONE) ? mBuffers[mCapturing] : nullptr;
+}
+
+
+uint32_t CaptureService::Claim()
+{
+    // the interrupt is the only one which takes buffers, the consumers only return them
+    const uint32_t free = mFree.load(std::memory_order_acquire);
+    if (free == 0U)
+    {
+        return NONE;
+    }
+    const auto index = static_cast<uint32_t>(std::countr_zero(free));
+    mFree.fetch_and(~(1U << index), std::memory_order_acq_rel);
+    mRefs[index].store(1U, std::memory_order_relaxed);
+    return index;
+}
+
+
+void CaptureService::Unref(uint32_t index)
+{
+    if (mRefs[index].fetch_sub(1U, std::memory_order_acq_rel) == 1U)
+    {
+        mFree.fetch_or(1U << index, std::memory_order_release);
+    }
+}
+
+
+uint32_t CaptureService::IndexOf(const uint8_t* pFrame) const
+{
+    for (uint32_t i = 0U; (pFrame != nullptr) && (i < mCount); i++)
+    {
+        if (mBuffers[i] == pFrame)
+        {
+            return i;
+        }
+    }
+    return NONE;
+}
@@ -0,0 +1,162 @@
+/**
+ ********************************************************************************
+ * @file        CaptureService.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, continuous camera capture with a reference counted frame queue.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "ICameraPort.hpp"
+#include <array>
+#include <atomic>
+namespace Video {
+
+
+/// @brief A captured frame handed out by the CaptureService.
+struct CapturedFrame
+{
+    Frame frame{};              //!< The image in the buffer
+    uint32_t sequence{0U};      //!< Running number of the complete frames since the start
+    uint8_t index{0U};          //!< Buffer of the frame
+};
+
+
+/**
+ * @brief   This class provides the newest camera frame to any number of consumers without copy.
+ * @details The port captures continuously into a queue of 2 to @ref MAX_FRAMES buffers (e.g. in the SDRAM).
+ *          At the end of every frame the service, in the interrupt context,
+ *          - publishes a complete frame as the newest one, the previous newest frame is released
+ *          - returns an incomplete frame to the free buffers
+ *          - hands the next free buffer to the port, without a free buffer the port skips the next frame.
+ *
+ *          Every buffer has a reference count: the newest frame holds one reference, each consumer one
+ *          more. @ref Acquire takes a reference to the newest frame, @ref AddRef shares it with a further
+ *          consumer and @ref Release drops a reference, at zero the buffer is free for the capture again.
+ *          A held frame is never rewritten, the capture only gets free buffers. All counts are lock-free
+ *          atomics, so consumers in several threads and the interrupt never block each other.
+ * @note    Consumers which want every frame once compare the sequence with the one they saw last.
+ *          Release all frames before a restart.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe and ISR safe for @ref Acquire, @ref AddRef, @ref Release and the
+ * counters from any thread and the port interrupt. @ref Start and @ref Stop from one control thread.
+ *
+ */
+class CaptureService : private ICameraPort::IListener
+{
+    public:
+
+        /// @brief Maximum of buffers.
+        static constexpr uint32_t MAX_FRAMES{8U};
+
+        /**
+         * @brief   Constructs the service on a port.
+         *
+         * @param   port    The camera port.
+         */
+        explicit CaptureService(ICameraPort& port);
+
+        /// @brief Destructor, stops the capture.
+        ~CaptureService();
+
+        CaptureService(CaptureService const &) = delete;             //!< Copy constructor
+        CaptureService& operator=(CaptureService const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Start the continuous capture, the counters restart.
+         *
+         * @param   config      The capture.
+         * @param   pBuffers    The buffers of config.FrameBytes(), they stay valid while the service is used.
+         * @param   count       Count of buffers, 2 .. @ref MAX_FRAMES.
+         *
+         * @return  OK, BUSY, INVALID_PARAM or the error of the port.
+         */
+        Status Start(const CaptureConfig& config, uint8_t* const* pBuffers, uint32_t count);
+
+        /// @brief Stop the capture, the newest frame stays available.
+        void Stop();
+
+        /**
+         * @brief   Take a reference to the newest complete frame.
+         *
+         * @param   frame   Receives the frame.
+         *
+         * @return  true if a frame was taken.
+         */
+        bool Acquire(CapturedFrame& frame);
+
+        /// @brief Take a further reference to an acquired frame.
+        void AddRef(const CapturedFrame& frame);
+
+        /// @brief Drop a reference to an acquired frame.
+        void Release(const CapturedFrame& frame);
+
+        /// @brief The capture runs.
+        bool IsRunning() const {return mRunning.load(std::memory_order_acquire);};
+
+        /// @brief Complete frames since the start.
+        uint32_t GetCaptured() const {return mCaptured.load(std::memory_order_acquire);};
+
+        /// @brief Frames skipped without a free buffer since the start.
+        uint32_t GetSkipped() const {return mSkipped.load(std::memory_order_relaxed);};
+
+        /// @brief Complete frames replaced before any consumer took them since the start.
+        uint32_t GetReplaced() const {return mReplaced.load(std::memory_order_relaxed);};
+
+        /// @brief Incomplete frames since the start.
+        uint32_t GetErrors() const {return mErrors.load(std::memory_order_relaxed);};
+
+    private:
+
+        /// @brief No buffer.
+        static constexpr uint32_t NONE{MAX_FRAMES};
+
+        /// @copydoc ICameraPort::IListener::OnFrame
+        uint8_t* OnFrame(uint8_t* pFrame, Status status) override;
+
+        /// @brief Take a free buffer for the capture or NONE.
+        uint32_t Claim();
+
+        /// @brief Drop a reference, the last one frees the buffer.
+        void Unref(uint32_t index);
+
+        /// @brief Buffer index of a frame address or NONE.
+        uint32_t IndexOf(const uint8_t* pFrame) const;
+
+        /// @brief The camera port.
+        ICameraPort& mPort;
+
+        /// @brief The running capture.
+        CaptureConfig mConfig{};
+
+        /// @brief The buffers.
+        std::array<uint8_t*, MAX_FRAMES> mBuffers{};
+
+        /// @brief Count of buffers.
+        uint32_t mCount{0U};
+
+        /// @brief Sequence per buffer, written before it is published.
+        std::array<uint32_t, MAX_FRAMES> mSequences{};
+
+        std::array<std::atomic<uint32_t>, MAX_FRAMES> mRefs{};  //!< References per buffer
+        std::array<std::atomic<bool>, MAX_FRAMES> mSeen{};      //!< A consumer took the frame
+        std::atomic<uint32_t> mFree{0U};                        //!< Free buffers, one bit each
+        std::atomic<uint32_t> mLatest{NONE};                    //!< Newest complete frame
+        uint32_t mCapturing{NONE};                              //!< Buffer of the port, by the interrupt
+
+        std::atomic<bool> mRunning{false};      //!< The capture runs
+        std::atomic<uint32_t> mCaptured{0U};    //!< Complete frames, written by the interrupt
+        std::atomic<uint32_t> mSkipped{0U};     //!< Skipped frames, written by the interrupt
+        std::atomic<uint32_t> mReplaced{0U};    //!< Unseen frames, written by the interrupt
+        std::atomic<uint32_t> mErrors{0U};      //!< Incomplete frames, written by the interrupt
+};
+
+} // end namespace Video
@@ -0,0 +1,103 @@
+/**
+ ********************************************************************************
+ * @file        DirtyRegion.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, set of changed rectangles implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DirtyRegion.hpp"
+
+using namespace Video;
+
+
+void DirtyRegion::Add(const Rect& rect)
+{
+    if (rect.IsEmpty() || Covers(rect))
+    {
+        return;
+    }
+
+    Rect merged = rect;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (uint32_t i = 0U; i < mCount; i++)
+        {
+            const Rect bounds = mRects[i].Union(merged);
+            if (bounds.Area() <= (mRects[i].Area() + merged.Area()))
+            {
+                // the bounding box costs no extra pixels, the grown rectangle may reach further ones
+                merged = bounds;
+                Remove(i);
+                changed = true;
+                break;
+            }
+        }
+        if (!changed && (mCount == MAX_RECTS))
+        {
+            uint32_t best = 0U;
+            uint32_t bestGrowth = UINT32_MAX;
+            for (uint32_t i = 0U; i < mCount; i++)
+            {
+                const uint32_t growth = mRects[i].Union(merged).Area() - mRects[i].Area();
+                if (growth < bestGrowth)
+                {
+                    best = i;
+                    bestGrowth = growth;
+                }
+            }
+            merged = mRects[best].Union(merged);
+            Remove(best);
+            changed = true;
+        }
+    }
+    mRects[mCount] = merged;
+    mCount++;
+}
+
+
+void DirtyRegion::Add(const DirtyRegion& region)
+{
+    for (const Rect& rect : region)
+    {
+        Add(rect);
+    }
+}
+
+
+uint32_t DirtyRegion::GetArea() const
+{
+    uint32_t area = 0U;
+    for (const Rect& rect : *this)
+    {
+        area += rect.Area();
+    }
+    return area;
+}
+
+
+bool DirtyRegion::Covers(const Rect& rect) const
+{
+    for (const Rect& own : *this)
+    {
+        if (own.Contains(rect))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void DirtyRegion::Remove(uint32_t index)
+{
+    mCount--;
+    mRects[index] = mRects[mCount];
+}
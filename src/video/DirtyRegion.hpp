@@ -0,0 +1,82 @@
+/**
+ ********************************************************************************
+ * @file        DirtyRegion.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, set of changed rectangles of a frame.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "GfxTypes.hpp"
+#include <array>
+namespace Video {
+
+
+/**
+ * @brief   This class provides a region of changed pixels as a small set of rectangles.
+ * @details A new rectangle is dropped if it lies inside one of the set, otherwise it absorbs every rectangle
+ *          whose bounding box with it adds no pixels (contained, adjacent in a line or column, or overlapping
+ *          enough). If the set is full, the new rectangle is merged with the one which grows the least.
+ *          The region may cover more pixels than added, never less.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class DirtyRegion
+{
+    public:
+
+        /// @brief Rectangles of the set.
+        static constexpr uint32_t MAX_RECTS{8U};
+
+        /**
+         * @brief   Add a rectangle.
+         *
+         * @param   rect    The rectangle, an empty one is ignored.
+         */
+        void Add(const Rect& rect);
+
+        /// @brief Add all rectangles of a region.
+        void Add(const DirtyRegion& region);
+
+        /// @brief Remove all rectangles.
+        void Clear() {mCount = 0U;};
+
+        /// @brief True if no rectangle is set.
+        bool IsEmpty() const {return mCount == 0U;};
+
+        /// @brief Rectangles of the set.
+        uint32_t GetCount() const {return mCount;};
+
+        /// @brief Pixels of the rectangles, overlapping pixels are counted per rectangle.
+        uint32_t GetArea() const;
+
+        /// @brief True if the rectangle lies inside one rectangle of the set.
+        bool Covers(const Rect& rect) const;
+
+        /// @brief Iteration over the rectangles.
+        const Rect* begin() const {return mRects.data();};
+        const Rect* end() const {return mRects.data() + mCount;};  //!< End of the rectangles
+
+    private:
+
+        /// @brief Remove a rectangle, the last one takes its place.
+        void Remove(uint32_t index);
+
+        /// @brief The rectangles.
+        std::array<Rect, MAX_RECTS> mRects{};
+
+        /// @brief Count of rectangles.
+        uint32_t mCount{0U};
+};
+
+} // end namespace Video
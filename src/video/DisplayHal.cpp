@@ -0,0 +1,222 @@
+/**
+ ********************************************************************************
+ * @file        DisplayHal.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, LTDC display controller implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DisplayHal.hpp"
+
+#if defined(LTDC)
+
+using namespace Video;
+
+DisplayHal* DisplayHal::spInstance{nullptr};
+
+namespace {
+
+/// @brief CLUT entries of an L8 layer.
+constexpr uint32_t CLUT_SIZE{256U};
+
+/// @brief LTDC pixel format of a format.
+inline uint32_t LayerFormat(PixelFormat format)
+{
+    switch (format)
+    {
+        case PixelFormat::ARGB8888:
+            return LTDC_PIXEL_FORMAT_ARGB8888;
+        case PixelFormat::RGB888:
+            return LTDC_PIXEL_FORMAT_RGB888;
+        case PixelFormat::RGB565:
+            return LTDC_PIXEL_FORMAT_RGB565;
+        default:
+            return LTDC_PIXEL_FORMAT_L8;
+    }
+}
+
+/// @brief True if two states differ in the address only.
+inline bool SameExceptAddress(const LayerConfig& a, const LayerConfig& b)
+{
+    return (a.frame.width == b.frame.width) && (a.frame.height == b.frame.height)
+           && (a.frame.stride == b.frame.stride) && (a.frame.format == b.frame.format) && (a.x == b.x)
+           && (a.y == b.y) && (a.alpha == b.alpha) && (a.enabled == b.enabled) && (a.pClut == b.pClut);
+}
+
+} // end anonymous namespace
+
+
+DisplayHal::DisplayHal(LTDC_HandleTypeDef& hltdc)
+: mHltdc(hltdc)
+{
+    spInstance = this;
+}
+
+
+DisplayHal::~DisplayHal()
+{
+    __HAL_LTDC_DISABLE_IT(&mHltdc, LTDC_IT_LI | LTDC_IT_RR);
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+DisplayHal* DisplayHal::GetInstance(const LTDC_HandleTypeDef* hltdc)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHltdc == hltdc))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+uint16_t DisplayHal::GetWidth() const
+{
+    return static_cast<uint16_t>(mHltdc.Init.AccumulatedActiveW - mHltdc.Init.AccumulatedHBP);
+}
+
+
+uint16_t DisplayHal::GetHeight() const
+{
+    return static_cast<uint16_t>(mHltdc.Init.AccumulatedActiveH - mHltdc.Init.AccumulatedVBP);
+}
+
+
+Status DisplayHal::Configure(uint8_t layer, const LayerConfig& config)
+{
+    if (layer >= LAYERS)
+    {
+        return Status::INVALID_PARAM;
+    }
+    const Frame& frame = config.frame;
+    if (!config.enabled)
+    {
+        __HAL_LTDC_LAYER_DISABLE(&mHltdc, layer);
+        mConfigs[layer] = config;
+        return Status::OK;
+    }
+    const uint32_t bytes = BytesPerPixel(frame.format);
+    if ((frame.pData == nullptr) || (frame.width == 0U) || (frame.height == 0U)
+        || ((config.x + frame.width) > GetWidth()) || ((config.y + frame.height) > GetHeight())
+        || (frame.stride < (frame.width * bytes)) || ((frame.stride % bytes) != 0U)
+        || ((frame.format == PixelFormat::L8) && (config.pClut == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    Status status = Status::OK;
+    if (SameExceptAddress(config, mConfigs[layer]))
+    {
+        status = ToStatus(HAL_LTDC_SetAddress_NoReload(&mHltdc, reinterpret_cast<uint32_t>(frame.pData), layer));
+    }
+    else
+    {
+        LTDC_LayerCfgTypeDef cfg{};
+        cfg.WindowX0 = config.x;
+        cfg.WindowX1 = config.x + frame.width;
+        cfg.WindowY0 = config.y;
+        cfg.WindowY1 = config.y + frame.height;
+        cfg.PixelFormat = LayerFormat(frame.format);
+        cfg.Alpha = config.alpha;
+        cfg.Alpha0 = 0U;
+        cfg.BlendingFactor1 = LTDC_BLENDING_FACTOR1_PAxCA;
+        cfg.BlendingFactor2 = LTDC_BLENDING_FACTOR2_PAxCA;
+        cfg.FBStartAdress = reinterpret_cast<uint32_t>(frame.pData);
+        cfg.ImageWidth = frame.width;
+        cfg.ImageHeight = frame.height;
+        status = ToStatus(HAL_LTDC_ConfigLayer_NoReload(&mHltdc, &cfg, layer));
+        if ((status == Status::OK) && (frame.stride != (frame.width * bytes)))
+        {
+            status = ToStatus(HAL_LTDC_SetPitch_NoReload(&mHltdc, frame.stride / bytes, layer));
+        }
+        if ((status == Status::OK) && (frame.format == PixelFormat::L8))
+        {
+            status = ToStatus(HAL_LTDC_ConfigCLUT(&mHltdc, config.pClut, CLUT_SIZE, layer));
+            if (status == Status::OK)
+            {
+                status = ToStatus(HAL_LTDC_EnableCLUT_NoReload(&mHltdc, layer));
+            }
+        }
+        else if (status == Status::OK)
+        {
+            status = ToStatus(HAL_LTDC_DisableCLUT_NoReload(&mHltdc, layer));
+        }
+    }
+    if (status == Status::OK)
+    {
+        mConfigs[layer] = config;
+    }
+    else
+    {
+        // program the whole layer next time
+        mConfigs[layer] = LayerConfig{};
+    }
+    return status;
+}
+
+
+Status DisplayHal::Commit()
+{
+    // the first line of the vertical front porch
+    return ToStatus(HAL_LTDC_ProgramLineEvent(&mHltdc, mHltdc.Init.AccumulatedActiveH + 1U));
+}
+
+
+void DisplayHal::OnLineEvent()
+{
+    // the line event interrupt is one shot, the reload interrupt follows
+    (void)HAL_LTDC_Reload(&mHltdc, LTDC_RELOAD_IMMEDIATE);
+}
+
+
+void DisplayHal::OnReloadEvent()
+{
+    if (mpListener != nullptr)
+    {
+        mpListener->OnReload();
+    }
+}
+
+
+Status DisplayHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_LTDC_LineEventCallback(LTDC_HandleTypeDef* hltdc)
+{
+    DisplayHal* pDisplay = DisplayHal::GetInstance(hltdc);
+    if (pDisplay != nullptr)
+    {
+        pDisplay->OnLineEvent();
+    }
+}
+
+
+extern "C" void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef* hltdc)
+{
+    DisplayHal* pDisplay = DisplayHal::GetInstance(hltdc);
+    if (pDisplay != nullptr)
+    {
+        pDisplay->OnReloadEvent();
+    }
+}
+
+#endif
@@ -0,0 +1,100 @@
+/**
+ ********************************************************************************
+ * @file        DisplayHal.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, display controller on the LTDC.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IDisplay.hpp"
+#include "stm32h7xx_hal.h"
+#include <array>
+
+#if defined(LTDC)
+namespace Video {
+
+
+/**
+ * @brief   This class provides the IDisplay on the LTDC of the STM32H7.
+ * @details @ref Configure compares the new state of a layer with the configured one: a changed address
+ *          only is written with HAL_LTDC_SetAddress_NoReload, other changes program the whole layer with
+ *          HAL_LTDC_ConfigLayer_NoReload (and the pitch for strides wider than the window). Blending uses
+ *          the factors PAxCA.\n
+ *          @ref Commit programs the line event on the first line after the active area. In its interrupt
+ *          the shadow registers are reloaded immediately, the scanout is in the vertical front porch, so a
+ *          swap never tears. The reload interrupt reports to the listener.
+ * @note    The application initialises the handle with HAL_LTDC_Init (timings, clock and NVIC in
+ *          HAL_LTDC_MspInit), LTDC_IRQHandler calls HAL_LTDC_IRQHandler. One LTDC instance is supported.
+ *          The CLUT of an L8 layer is written at once (not shadowed).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * The listener is called from the interrupt context.
+ *
+ */
+class DisplayHal : public IDisplay
+{
+    public:
+
+        /**
+         * @brief   Constructs the display for an initialised LTDC handle.
+         *
+         * @param   hltdc       The LTDC handle.
+         */
+        explicit DisplayHal(LTDC_HandleTypeDef& hltdc);
+
+        /// @brief Destructor.
+        ~DisplayHal() override;
+
+        /// @copydoc IDisplay::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IDisplay::Configure
+        Status Configure(uint8_t layer, const LayerConfig& config) override;
+
+        /// @copydoc IDisplay::Commit
+        Status Commit() override;
+
+        /// @copydoc IDisplay::GetWidth
+        uint16_t GetWidth() const override;
+
+        /// @copydoc IDisplay::GetHeight
+        uint16_t GetHeight() const override;
+
+        /// @brief Line event, called by the callback of the HAL.
+        void OnLineEvent();
+
+        /// @brief Reload done, called by the callback of the HAL.
+        void OnReloadEvent();
+
+        /// @brief Display bound to a LTDC handle or nullptr.
+        static DisplayHal* GetInstance(const LTDC_HandleTypeDef* hltdc);
+
+    private:
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The LTDC handle.
+        LTDC_HandleTypeDef& mHltdc;
+
+        /// @brief Reload receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief The configured state per layer.
+        std::array<LayerConfig, LAYERS> mConfigs{};
+
+        /// @brief The single display instance, the device has one LTDC.
+        static DisplayHal* spInstance;
+};
+
+} // end namespace Video
+#endif
@@ -0,0 +1,219 @@
+/**
+ ********************************************************************************
+ * @file        DisplaySim.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, display controller emulation implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "DisplaySim.hpp"
+#include "Gfx2D.hpp"
+#include <algorithm>
+#include <cstdio>
+
+using namespace Video;
+
+namespace {
+
+/// @brief Bytes of a stored deflate block.
+constexpr uint32_t STORED_BLOCK{65535U};
+
+/// @brief CRC-32 (IEEE, reflected) table of the PNG chunks.
+constexpr std::array<uint32_t, 256U> CRC_TABLE = []()
+{
+    std::array<uint32_t, 256U> table{};
+    for (uint32_t i = 0U; i < 256U; i++)
+    {
+        uint32_t crc = i;
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 1U) != 0U) ? (0xEDB88320U ^ (crc >> 1U)) : (crc >> 1U);
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+/// @brief Append a big endian word.
+void PutWord(std::vector<uint8_t>& out, uint32_t value)
+{
+    out.push_back(static_cast<uint8_t>(value >> 24U));
+    out.push_back(static_cast<uint8_t>(value >> 16U));
+    out.push_back(static_cast<uint8_t>(value >> 8U));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/// @brief Append a chunk with length, type, data and CRC.
+void PutChunk(std::vector<uint8_t>& out, const char* pType, const std::vector<uint8_t>& data)
+{
+    PutWord(out, static_cast<uint32_t>(data.size()));
+    const size_t start = out.size();
+    out.insert(out.end(), pType, pType + 4U);
+    out.insert(out.end(), data.begin(), data.end());
+    uint32_t crc = 0xFFFFFFFFU;
+    for (size_t i = start; i < out.size(); i++)
+    {
+        crc = CRC_TABLE[(crc ^ out[i]) & 0xFFU] ^ (crc >> 8U);
+    }
+    PutWord(out, crc ^ 0xFFFFFFFFU);
+}
+
+} // end anonymous namespace
+
+
+DisplaySim::DisplaySim(uint16_t width, uint16_t height, uint32_t background)
+: mWidth(width)
+, mHeight(height)
+, mBackground(background | 0xFF000000U)
+, mPixels(static_cast<size_t>(width) * height * 4U)
+{
+    mScreen = Frame{mPixels.data(), width, height, static_cast<uint32_t>(width) * 4U, PixelFormat::ARGB8888};
+}
+
+
+Status DisplaySim::Configure(uint8_t layer, const LayerConfig& config)
+{
+    if (layer >= LAYERS)
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (config.enabled)
+    {
+        const Frame& frame = config.frame;
+        if ((frame.pData == nullptr) || (frame.width == 0U) || (frame.height == 0U)
+            || ((config.x + frame.width) > mWidth) || ((config.y + frame.height) > mHeight)
+            || (frame.stride < (frame.width * BytesPerPixel(frame.format)))
+            || ((frame.format == PixelFormat::L8) && (config.pClut == nullptr)))
+        {
+            return Status::INVALID_PARAM;
+        }
+    }
+    mShadow[layer] = config;
+    return Status::OK;
+}
+
+
+bool DisplaySim::LineEvent()
+{
+    if (!mReloadRequested)
+    {
+        return false;
+    }
+    mReloadRequested = false;
+    mActive = mShadow;
+    mReloads++;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnReload();
+    }
+    return true;
+}
+
+
+const Frame& DisplaySim::Scanout()
+{
+    GfxCommand command{};
+    command.operation = GfxOperation::FILL;
+    command.dst = mScreen;
+    command.color = mBackground;
+    (void)mEngine.Process(command);
+
+    for (const LayerConfig& layer : mActive)
+    {
+        if (!layer.enabled || (layer.alpha == 0U))
+        {
+            continue;
+        }
+        command.operation = GfxOperation::BLEND;
+        command.src = layer.frame;
+        command.dst = Frame{&mPixels[((static_cast<size_t>(layer.y) * mWidth) + layer.x) * 4U], layer.frame.width,
+                            layer.frame.height, mScreen.stride, PixelFormat::ARGB8888};
+        command.alpha = layer.alpha;
+        command.pClut = layer.pClut;
+        (void)mEngine.Process(command);
+    }
+    return mScreen;
+}
+
+
+void DisplaySim::EncodePng(const Frame& frame, std::vector<uint8_t>& png)
+{
+    // filter type 0 and RGBA per line
+    const uint32_t lineBytes = 1U + (frame.width * 4U);
+    std::vector<uint8_t> raw(static_cast<size_t>(lineBytes) * frame.height);
+    std::vector<uint32_t> line(frame.width);
+    GfxEngineSoft engine;
+    GfxCommand command{};
+    command.operation = GfxOperation::BLIT;
+    command.pClut = Gfx2D::GrayClut();
+    for (uint32_t y = 0U; y < frame.height; y++)
+    {
+        command.src = Frame{&frame.pData[y * frame.stride], frame.width, 1U, frame.stride, frame.format};
+        command.dst = Frame{reinterpret_cast<uint8_t*>(line.data()), frame.width, 1U, frame.width * 4U,
+                            PixelFormat::ARGB8888};
+        (void)engine.Process(command);
+        uint8_t* pOut = &raw[y * lineBytes];
+        pOut[0] = 0U;
+        for (uint32_t x = 0U; x < frame.width; x++)
+        {
+            const uint32_t pixel = line[x];
+            pOut[1U + (4U * x)] = static_cast<uint8_t>(pixel >> 16U);
+            pOut[2U + (4U * x)] = static_cast<uint8_t>(pixel >> 8U);
+            pOut[3U + (4U * x)] = static_cast<uint8_t>(pixel);
+            pOut[4U + (4U * x)] = static_cast<uint8_t>(pixel >> 24U);
+        }
+    }
+
+    // zlib stream of stored blocks with Adler-32
+    std::vector<uint8_t> zlib{0x78U, 0x01U};
+    uint32_t a = 1U;
+    uint32_t b = 0U;
+    for (size_t offset = 0U; offset < raw.size(); offset += STORED_BLOCK)
+    {
+        const uint32_t length = static_cast<uint32_t>(std::min<size_t>(STORED_BLOCK, raw.size() - offset));
+        zlib.push_back(((offset + length) == raw.size()) ? 1U : 0U);
+        zlib.push_back(static_cast<uint8_t>(length));
+        zlib.push_back(static_cast<uint8_t>(length >> 8U));
+        zlib.push_back(static_cast<uint8_t>(~length));
+        zlib.push_back(static_cast<uint8_t>(~length >> 8U));
+        zlib.insert(zlib.end(), raw.begin() + static_cast<ptrdiff_t>(offset),
+                    raw.begin() + static_cast<ptrdiff_t>(offset + length));
+        for (uint32_t i = 0U; i < length; i++)
+        {
+            a = (a + raw[offset + i]) % 65521U;
+            b = (b + a) % 65521U;
+        }
+    }
+    PutWord(zlib, (b << 16U) | a);
+
+    std::vector<uint8_t> header;
+    PutWord(header, frame.width);
+    PutWord(header, frame.height);
+    // 8 bit RGBA, deflate, adaptive filtering, no interlace
+    header.insert(header.end(), {8U, 6U, 0U, 0U, 0U});
+
+    png.assign({0x89U, 'P', 'N', 'G', '\r', '\n', 0x1AU, '\n'});
+    PutChunk(png, "IHDR", header);
+    PutChunk(png, "IDAT", zlib);
+    PutChunk(png, "IEND", std::vector<uint8_t>{});
+}
+
+
+Status DisplaySim::DumpPng(const char* pPath)
+{
+    std::vector<uint8_t> png;
+    EncodePng(Scanout(), png);
+    std::FILE* pFile = std::fopen(pPath, "wb");
+    if (pFile == nullptr)
+    {
+        return Status::HW_ERROR;
+    }
+    const size_t written = std::fwrite(png.data(), 1U, png.size(), pFile);
+    const bool closed = (std::fclose(pFile) == 0);
+    return ((written == png.size()) && closed) ? Status::OK : Status::HW_ERROR;
+}
@@ -0,0 +1,134 @@
+/**
+ ********************************************************************************
+ * @file        DisplaySim.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, display controller emulation with an in-memory panel.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IDisplay.hpp"
+#include "GfxEngineSoft.hpp"
+#include <array>
+#include <vector>
+namespace Video {
+
+
+/**
+ * @brief   This class provides an IDisplay in host memory.
+ * @details @ref Configure writes the shadow state, @ref LineEvent stands in for the line interrupt in the
+ *          vertical blanking: a committed shadow state becomes active and the listener is called.
+ *          @ref Scanout composes the active layers like the LTDC into an ARGB8888 panel image: the background
+ *          color, then layer 0 and layer 1 blended with pixel alpha times constant alpha. The panel image
+ *          can be dumped as PNG (8 bit RGBA, stored deflate blocks) for a visual check.
+ * @note    Only available on the host (PLATFORM Unittest).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class DisplaySim : public IDisplay
+{
+    public:
+
+        /**
+         * @brief   Constructs the panel.
+         *
+         * @param   width       Pixels per line.
+         * @param   height      Lines.
+         * @param   background  Background color (RGB, the alpha is ignored).
+         */
+        DisplaySim(uint16_t width, uint16_t height, uint32_t background = 0U);
+
+        /// @copydoc IDisplay::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IDisplay::Configure
+        Status Configure(uint8_t layer, const LayerConfig& config) override;
+
+        /// @copydoc IDisplay::Commit
+        Status Commit() override {mReloadRequested = true; return Status::OK;};
+
+        /// @copydoc IDisplay::GetWidth
+        uint16_t GetWidth() const override {return mWidth;};
+
+        /// @copydoc IDisplay::GetHeight
+        uint16_t GetHeight() const override {return mHeight;};
+
+        /**
+         * @brief   The line event in the vertical blanking, reloads a committed state.
+         *
+         * @return  True if the state was reloaded and the listener called.
+         */
+        bool LineEvent();
+
+        /// @brief The active state of a layer.
+        const LayerConfig& GetLayer(uint8_t layer) const {return mActive[layer];};
+
+        /// @brief Reloads since construction.
+        uint32_t GetReloadCount() const {return mReloads;};
+
+        /**
+         * @brief   Compose the active layers into the panel image.
+         *
+         * @return  The ARGB8888 panel image, valid until the next scanout.
+         */
+        const Frame& Scanout();
+
+        /**
+         * @brief   Encode a frame as PNG.
+         *
+         * @param   frame   The frame, any pixel format (L8 as gray).
+         * @param   png     Returns the PNG file.
+         */
+        static void EncodePng(const Frame& frame, std::vector<uint8_t>& png);
+
+        /**
+         * @brief   Scan out and write the panel image to a PNG file.
+         *
+         * @param   pPath   The file.
+         *
+         * @return  OK, HW_ERROR if the file can't be written.
+         */
+        Status DumpPng(const char* pPath);
+
+    private:
+
+        /// @brief Panel size.
+        uint16_t mWidth;
+        uint16_t mHeight;   //!< Lines of the panel
+
+        /// @brief Background color.
+        uint32_t mBackground;
+
+        /// @brief Reload receiver.
+        IListener* mpListener{nullptr};
+
+        std::array<LayerConfig, LAYERS> mShadow{};  //!< Configured state
+        std::array<LayerConfig, LAYERS> mActive{};  //!< Shown state
+
+        /// @brief A commit waits for the line event.
+        bool mReloadRequested{false};
+
+        /// @brief Reloads.
+        uint32_t mReloads{0U};
+
+        /// @brief Composer.
+        GfxEngineSoft mEngine;
+
+        /// @brief Panel pixels.
+        std::vector<uint8_t> mPixels;
+
+        /// @brief Panel image.
+        Frame mScreen{};
+};
+
+} // end namespace Video
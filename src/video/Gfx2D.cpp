@@ -0,0 +1,273 @@
+/**
+ ********************************************************************************
+ * @file        Gfx2D.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, 2D graphics command queue implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "Gfx2D.hpp"
+#include "CriticalSection.hpp"
+#include <algorithm>
+
+using namespace Video;
+
+namespace {
+
+/// @brief Largest line offset of the DMA2D in pixels.
+constexpr uint32_t MAX_LINE_OFFSET{0x3FFFU};
+
+/// @brief Gray ramp, generated at compile time.
+constexpr std::array<uint32_t, 256> MakeGrayClut()
+{
+    std::array<uint32_t, 256> clut{};
+    for (uint32_t l = 0U; l < 256U; l++)
+    {
+        clut[l] = 0xFF000000U | (l << 16U) | (l << 8U) | l;
+    }
+    return clut;
+}
+
+alignas(32) constexpr std::array<uint32_t, 256> GRAY_CLUT = MakeGrayClut();
+
+} // end anonymous namespace
+
+
+Gfx2D::Gfx2D(IGfxEngine& engine)
+: mEngine(engine)
+{
+    mEngine.SetListener(this);
+}
+
+
+Gfx2D::~Gfx2D()
+{
+    mEngine.SetListener(nullptr);
+}
+
+
+const uint32_t* Gfx2D::GrayClut()
+{
+    return GRAY_CLUT.data();
+}
+
+
+bool Gfx2D::IsValid(const Frame& frame, bool destination)
+{
+    const uint32_t bpp = BytesPerPixel(frame.format);
+    return (frame.pData != nullptr) && (frame.width > 0U) && (frame.height > 0U)
+        && (frame.stride >= (frame.width * bpp)) && ((frame.stride % bpp) == 0U)
+        && (((frame.stride / bpp) - frame.width) <= MAX_LINE_OFFSET)
+        && (!destination || (frame.format != PixelFormat::L8));
+}
+
+
+Frame Gfx2D::Region(const Frame& frame, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+    Frame region = frame;
+    region.pData = &frame.pData[(y * frame.stride) + (x * BytesPerPixel(frame.format))];
+    region.width = width;
+    region.height = height;
+    return region;
+}
+
+
+Gfx2D::Slot* Gfx2D::Record()
+{
+    if ((mTail - mHead) >= QUEUE_SIZE)
+    {
+        return nullptr;
+    }
+    Slot* pSlot = &mSlots[mTail % QUEUE_SIZE];
+    *pSlot = Slot{};
+    mTail++;
+    return pSlot;
+}
+
+
+Status Gfx2D::Fill(const Frame& dst, const Rect& rect, uint32_t color)
+{
+    if (!IsValid(dst, true))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if ((rect.x >= dst.width) || (rect.y >= dst.height) || (rect.width == 0U) || (rect.height == 0U))
+    {
+        return Status::OK;
+    }
+    Slot* pSlot = Record();
+    if (pSlot == nullptr)
+    {
+        return Status::BUSY;
+    }
+    GfxCommand& command = pSlot->command;
+    command.operation = GfxOperation::FILL;
+    command.dst = Region(dst, rect.x, rect.y, std::min<uint16_t>(rect.width, dst.width - rect.x),
+                         std::min<uint16_t>(rect.height, dst.height - rect.y));
+    command.color = color;
+    return Status::OK;
+}
+
+
+Status Gfx2D::Blit(const Frame& src, const Rect& srcRect, const Frame& dst, uint16_t x, uint16_t y)
+{
+    return RecordCopy(GfxOperation::BLIT, src, srcRect, dst, x, y, 255U);
+}
+
+
+Status Gfx2D::Blend(const Frame& src, const Rect& srcRect, const Frame& dst, uint16_t x, uint16_t y,
+                    uint8_t alpha)
+{
+    return RecordCopy(GfxOperation::BLEND, src, srcRect, dst, x, y, alpha);
+}
+
+
+Status Gfx2D::RecordCopy(GfxOperation operation, const Frame& src, const Rect& srcRect, const Frame& dst,
+                         uint16_t x, uint16_t y, uint8_t alpha)
+{
+    if (!IsValid(src, false) || !IsValid(dst, true))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if ((srcRect.x >= src.width) || (srcRect.y >= src.height) || (x >= dst.width) || (y >= dst.height)
+        || (alpha == 0U))
+    {
+        return Status::OK;
+    }
+    const uint16_t width = std::min({srcRect.width, static_cast<uint16_t>(src.width - srcRect.x),
+                                     static_cast<uint16_t>(dst.width - x)});
+    const uint16_t height = std::min({srcRect.height, static_cast<uint16_t>(src.height - srcRect.y),
+                                      static_cast<uint16_t>(dst.height - y)});
+    if ((width == 0U) || (height == 0U))
+    {
+        return Status::OK;
+    }
+    Slot* pSlot = Record();
+    if (pSlot == nullptr)
+    {
+        return Status::BUSY;
+    }
+    GfxCommand& command = pSlot->command;
+    command.operation = operation;
+    command.dst = Region(dst, x, y, width, height);
+    command.src = Region(src, srcRect.x, srcRect.y, width, height);
+    command.alpha = alpha;
+    command.pClut = (src.format == PixelFormat::L8) ? mpClut : nullptr;
+    return Status::OK;
+}
+
+
+Status Gfx2D::Flush(Callback pCallback, void* pContext)
+{
+    if (pCallback != nullptr)
+    {
+        Slot* pSlot{nullptr};
+        if (mTail != mFlushed)
+        {
+            pSlot = &mSlots[(mTail - 1U) % QUEUE_SIZE];
+        }
+        else
+        {
+            pSlot = Record();
+            if (pSlot == nullptr)
+            {
+                return Status::BUSY;
+            }
+            pSlot->marker = true;
+        }
+        pSlot->pCallback = pCallback;
+        pSlot->pContext = pContext;
+    }
+    {
+        Utils::CriticalSection cs;
+        mFlushed = mTail;
+    }
+    StartNext();
+    return Status::OK;
+}
+
+
+bool Gfx2D::IsIdle() const
+{
+    Utils::CriticalSection cs;
+    return (mHead == mTail) && !mActive;
+}
+
+
+void Gfx2D::StartNext()
+{
+    for (;;)
+    {
+        Slot* pSlot{nullptr};
+        {
+            Utils::CriticalSection cs;
+            if (mActive || mStarting || (mHead == mFlushed))
+            {
+                return;
+            }
+            pSlot = &mSlots[mHead % QUEUE_SIZE];
+            mActive = true;
+            mStarting = true;
+        }
+
+        const Status status = pSlot->marker ? Status::OK : mEngine.Start(pSlot->command);
+
+        {
+            Utils::CriticalSection cs;
+            mStarting = false;
+        }
+
+        // a marker or a rejected command completes here, the loop starts the next one
+        if (pSlot->marker || (status != Status::OK))
+        {
+            const Slot slot = Release(status);
+            if (slot.pCallback != nullptr)
+            {
+                slot.pCallback(slot.pContext);
+            }
+        }
+    }
+}
+
+
+void Gfx2D::OnCommandDone(const GfxCommand& command, Status status)
+{
+    (void)command;
+    Finish(status);
+}
+
+
+void Gfx2D::Finish(Status status)
+{
+    const Slot slot = Release(status);
+
+    // keep the engine busy while the callback runs
+    StartNext();
+    if (slot.pCallback != nullptr)
+    {
+        slot.pCallback(slot.pContext);
+    }
+}
+
+
+Gfx2D::Slot Gfx2D::Release(Status status)
+{
+    Utils::CriticalSection cs;
+    const Slot slot = mSlots[mHead % QUEUE_SIZE];
+    if (!slot.marker)
+    {
+        mCompleted = mCompleted + 1U;
+        if (status != Status::OK)
+        {
+            mErrors = mErrors + 1U;
+        }
+    }
+    mHead = mHead + 1U;
+    mActive = false;
+    return slot;
+}
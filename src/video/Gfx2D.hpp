@@ -0,0 +1,203 @@
+/**
+ ********************************************************************************
+ * @file        Gfx2D.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, 2D graphics primitives batched into a command queue of a graphics engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IGfxEngine.hpp"
+#include <array>
+namespace Video {
+
+
+/**
+ * @brief   This class provides fill, blit, blend and format conversion on frames, executed by a graphics engine.
+ * @details The primitives clip their rectangles, resolve them to regions and record them as commands into a
+ *          ring. @ref Flush hands the recorded batch to the engine, which runs the commands one after another:
+ *          the completion of a command (the DMA2D transfer complete interrupt on the target) starts the next
+ *          one, so the CPU only records and the engine never waits for it. While a batch runs, the next one
+ *          can be recorded into the free slots.\n
+ *          A flush may carry a callback, which is called when the commands up to it are done, e.g. to
+ *          present a frame.
+ * @note    Destinations are ARGB8888, RGB888 or RGB565 (DMA2D output formats), sources may be L8 too. The
+ *          strides must be multiples of the pixel size. For the DMA2D the frames must be located in a DMA
+ *          accessible RAM (AXI SRAM or SDRAM, not DTCM), see also @ref GfxCommand.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * Record and flush from one context, the completion path and the flush callbacks run in the engine context.
+ *
+ */
+class Gfx2D : private IGfxEngine::IListener
+{
+    public:
+
+        /// @brief Slots of the command ring.
+        static constexpr uint32_t QUEUE_SIZE{32U};
+
+        /// @brief Flush callback.
+        using Callback = void (*)(void* pContext);
+
+        /**
+         * @brief   Constructs the library and binds it to the engine.
+         *
+         * @param   engine      The engine which executes the commands.
+         */
+        explicit Gfx2D(IGfxEngine& engine);
+
+        /// @brief Destructor, unbinds the engine.
+        ~Gfx2D();
+
+        Gfx2D(Gfx2D const &) = delete;             //!< Copy constructor
+        Gfx2D& operator=(Gfx2D const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Record a filled rectangle.
+         *
+         * @param   dst     The destination frame.
+         * @param   rect    The rectangle, clipped to the frame.
+         * @param   color   ARGB8888 color, converted to the destination format.
+         *
+         * @return  OK if recorded or empty after clipping, BUSY if the ring is full, INVALID_PARAM.
+         */
+        Status Fill(const Frame& dst, const Rect& rect, uint32_t color);
+
+        /**
+         * @brief   Record a copy of a rectangle with pixel format conversion.
+         *
+         * @param   src     The source frame.
+         * @param   srcRect The source rectangle, clipped to both frames.
+         * @param   dst     The destination frame.
+         * @param   x       Left column in the destination.
+         * @param   y       Top line in the destination.
+         *
+         * @return  OK if recorded or empty after clipping, BUSY if the ring is full, INVALID_PARAM.
+         */
+        Status Blit(const Frame& src, const Rect& srcRect, const Frame& dst, uint16_t x, uint16_t y);
+
+        /**
+         * @brief   Record the blending of a rectangle over the destination.
+         *
+         * @param   src     The source frame, its alpha (and the CLUT alpha of L8) is used.
+         * @param   srcRect The source rectangle, clipped to both frames.
+         * @param   dst     The destination frame, the background.
+         * @param   x       Left column in the destination.
+         * @param   y       Top line in the destination.
+         * @param   alpha   Constant alpha combined with the source alpha, 0 records nothing.
+         *
+         * @return  OK if recorded or empty after clipping, BUSY if the ring is full, INVALID_PARAM.
+         */
+        Status Blend(const Frame& src, const Rect& srcRect, const Frame& dst, uint16_t x, uint16_t y,
+                     uint8_t alpha = 255U);
+
+        /**
+         * @brief   Record the conversion of a whole frame, the common area of both frames.
+         *
+         * @param   src     The source frame.
+         * @param   dst     The destination frame.
+         *
+         * @return  See @ref Blit.
+         */
+        Status Convert(const Frame& src, const Frame& dst)
+        {
+            return Blit(src, Rect{0U, 0U, src.width, src.height}, dst, 0U, 0U);
+        };
+
+        /**
+         * @brief   Set the palette of the following L8 sources.
+         *
+         * @param   pClut   256 ARGB8888 entries which stay valid while used, nullptr for the gray ramp.
+         */
+        void SetClut(const uint32_t* pClut) {mpClut = (pClut != nullptr) ? pClut : GrayClut();};
+
+        /**
+         * @brief   Start the recorded commands.
+         *
+         * @param   pCallback   Optional, called when the commands up to this flush are done.
+         * @param   pContext    User context passed to the callback.
+         *
+         * @return  OK, BUSY if a callback needs a slot and the ring is full.
+         */
+        Status Flush(Callback pCallback = nullptr, void* pContext = nullptr);
+
+        /// @brief True if no command is recorded, queued or running.
+        bool IsIdle() const;
+
+        /// @brief Commands finished since construction.
+        uint32_t GetCompletedCount() const {return mCompleted;};
+
+        /// @brief Commands the engine failed or rejected.
+        uint32_t GetErrorCount() const {return mErrors;};
+
+        /// @brief The gray ramp palette (L8 to ARGB8888 with R = G = B = L).
+        static const uint32_t* GrayClut();
+
+    private:
+
+        /// @brief A slot of the ring.
+        struct Slot
+        {
+            GfxCommand command{};           //!< The command
+            bool marker{false};             //!< Callback only, no command
+            Callback pCallback{nullptr};    //!< Flush callback after the command
+            void* pContext{nullptr};        //!< Context of the callback
+        };
+
+        /// @brief Engine completion, see IGfxEngine::IListener.
+        void OnCommandDone(const GfxCommand& command, Status status) override;
+
+        /// @brief Start flushed commands while the engine is idle.
+        void StartNext();
+
+        /// @brief Release the head slot, start the next command and call the callback of the slot.
+        void Finish(Status status);
+
+        /// @brief Release the head slot, returns its callback.
+        Slot Release(Status status);
+
+        /// @brief Reserve the next free slot, nullptr if the ring is full.
+        Slot* Record();
+
+        /// @brief Clip and record a BLIT or BLEND.
+        Status RecordCopy(GfxOperation operation, const Frame& src, const Rect& srcRect, const Frame& dst,
+                          uint16_t x, uint16_t y, uint8_t alpha);
+
+        /// @brief Region of a frame at a position.
+        static Frame Region(const Frame& frame, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+        /// @brief Check a frame for use as source or destination.
+        static bool IsValid(const Frame& frame, bool destination);
+
+        /// @brief The executing engine.
+        IGfxEngine& mEngine;
+
+        /// @brief The command ring.
+        std::array<Slot, QUEUE_SIZE> mSlots{};
+
+        volatile uint32_t mHead{0U};        //!< Next slot to run
+        volatile uint32_t mFlushed{0U};     //!< End of the flushed slots
+        uint32_t mTail{0U};                 //!< End of the recorded slots
+
+        /// @brief Palette of L8 sources.
+        const uint32_t* mpClut{GrayClut()};
+
+        /// @brief The head command is on the engine.
+        volatile bool mActive{false};
+
+        /// @brief Set while IGfxEngine::Start runs, turns synchronous completions into a loop.
+        volatile bool mStarting{false};
+
+        volatile uint32_t mCompleted{0U};   //!< Finished commands
+        volatile uint32_t mErrors{0U};      //!< Failed commands
+};
+
+} // end namespace Video
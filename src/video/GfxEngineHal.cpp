@@ -0,0 +1,249 @@
+/**
+ ********************************************************************************
+ * @file        GfxEngineHal.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, DMA2D graphics engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "GfxEngineHal.hpp"
+#include "DCache.hpp"
+
+#if defined(DMA2D)
+
+using namespace Video;
+
+GfxEngineHal* GfxEngineHal::spInstance{nullptr};
+
+namespace {
+
+/// @brief Timeout of the CLUT loading in ms, it takes 256 bus transfers.
+constexpr uint32_t CLUT_TIMEOUT_MS{2U};
+
+/// @brief Bytes from the first to the last pixel of a region.
+inline uint32_t RegionBytes(const Frame& frame)
+{
+    return ((frame.height - 1U) * frame.stride) + (frame.width * BytesPerPixel(frame.format));
+}
+
+/// @brief DMA2D input color mode of a format.
+inline uint32_t InputMode(PixelFormat format)
+{
+    switch (format)
+    {
+        case PixelFormat::ARGB8888:
+            return DMA2D_INPUT_ARGB8888;
+        case PixelFormat::RGB888:
+            return DMA2D_INPUT_RGB888;
+        case PixelFormat::RGB565:
+            return DMA2D_INPUT_RGB565;
+        default:
+            return DMA2D_INPUT_L8;
+    }
+}
+
+/// @brief DMA2D output color mode of a format, L8 is no output format.
+inline uint32_t OutputMode(PixelFormat format)
+{
+    return (format == PixelFormat::ARGB8888) ? DMA2D_OUTPUT_ARGB8888 :
+           ((format == PixelFormat::RGB888) ? DMA2D_OUTPUT_RGB888 : DMA2D_OUTPUT_RGB565);
+}
+
+/// @brief Line offset of a region in pixels.
+inline uint32_t LineOffset(const Frame& frame)
+{
+    return (frame.stride / BytesPerPixel(frame.format)) - frame.width;
+}
+
+void TransferComplete(DMA2D_HandleTypeDef* hdma2d)
+{
+    GfxEngineHal* pEngine = GfxEngineHal::GetInstance(hdma2d);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnTransferDone(Status::OK);
+    }
+}
+
+void TransferError(DMA2D_HandleTypeDef* hdma2d)
+{
+    GfxEngineHal* pEngine = GfxEngineHal::GetInstance(hdma2d);
+    if (pEngine != nullptr)
+    {
+        pEngine->OnTransferDone(Status::HW_ERROR);
+    }
+}
+
+} // end anonymous namespace
+
+
+GfxEngineHal::GfxEngineHal(DMA2D_HandleTypeDef& hdma2d)
+: mHdma2d(hdma2d)
+{
+    spInstance = this;
+    mHdma2d.XferCpltCallback = TransferComplete;
+    mHdma2d.XferErrorCallback = TransferError;
+}
+
+
+GfxEngineHal::~GfxEngineHal()
+{
+    (void)HAL_DMA2D_Abort(&mHdma2d);
+    mHdma2d.XferCpltCallback = nullptr;
+    mHdma2d.XferErrorCallback = nullptr;
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+GfxEngineHal* GfxEngineHal::GetInstance(const DMA2D_HandleTypeDef* hdma2d)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHdma2d == hdma2d))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status GfxEngineHal::ConfigLayer(const Frame& frame, uint32_t layer, uint8_t alpha)
+{
+    DMA2D_LayerCfgTypeDef& cfg = mHdma2d.LayerCfg[layer];
+    cfg.InputOffset = LineOffset(frame);
+    cfg.InputColorMode = InputMode(frame.format);
+    cfg.AlphaMode = (alpha == 255U) ? DMA2D_NO_MODIF_ALPHA : DMA2D_COMBINE_ALPHA;
+    cfg.InputAlpha = alpha;
+    cfg.AlphaInverted = DMA2D_REGULAR_ALPHA;
+    cfg.RedBlueSwap = DMA2D_RB_REGULAR;
+    cfg.ChromaSubSampling = DMA2D_NO_CSS;
+    return ToStatus(HAL_DMA2D_ConfigLayer(&mHdma2d, layer));
+}
+
+
+Status GfxEngineHal::Start(const GfxCommand& command)
+{
+    const Frame& dst = command.dst;
+    const Frame& src = command.src;
+    if ((dst.pData == nullptr) || (dst.format == PixelFormat::L8)
+        || ((command.operation != GfxOperation::FILL) && (src.pData == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (HAL_DMA2D_GetState(&mHdma2d) != HAL_DMA2D_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+
+    mHdma2d.Init.Mode = (command.operation == GfxOperation::FILL) ? DMA2D_R2M :
+                        ((command.operation == GfxOperation::BLEND) ? DMA2D_M2M_BLEND :
+                         ((src.format == dst.format) ? DMA2D_M2M : DMA2D_M2M_PFC));
+    mHdma2d.Init.ColorMode = OutputMode(dst.format);
+    mHdma2d.Init.OutputOffset = LineOffset(dst);
+    mHdma2d.Init.AlphaInverted = DMA2D_REGULAR_ALPHA;
+    mHdma2d.Init.RedBlueSwap = DMA2D_RB_REGULAR;
+    mHdma2d.Init.BytesSwap = DMA2D_BYTES_REGULAR;
+    mHdma2d.Init.LineOffsetMode = DMA2D_LOM_PIXELS;
+    Status status = ToStatus(HAL_DMA2D_Init(&mHdma2d));
+
+    if ((status == Status::OK) && (command.operation != GfxOperation::FILL))
+    {
+        status = ConfigLayer(src, DMA2D_FOREGROUND_LAYER, command.alpha);
+        if ((status == Status::OK) && (command.operation == GfxOperation::BLEND))
+        {
+            status = ConfigLayer(dst, DMA2D_BACKGROUND_LAYER, 255U);
+        }
+        if ((status == Status::OK) && (src.format == PixelFormat::L8))
+        {
+            if (command.pClut == nullptr)
+            {
+                return Status::INVALID_PARAM;
+            }
+            if (command.pClut != mpLoadedClut)
+            {
+                DMA2D_CLUTCfgTypeDef clut{};
+                clut.pCLUT = const_cast<uint32_t*>(command.pClut);
+                clut.CLUTColorMode = DMA2D_CCM_ARGB8888;
+                clut.Size = 255U;
+                Utils::DCache::Clean(command.pClut, 256U * sizeof(uint32_t));
+                (void)HAL_DMA2D_CLUTLoad(&mHdma2d, clut, DMA2D_FOREGROUND_LAYER);
+                status = ToStatus(HAL_DMA2D_PollForTransfer(&mHdma2d, CLUT_TIMEOUT_MS));
+                mpLoadedClut = (status == Status::OK) ? command.pClut : nullptr;
+            }
+        }
+    }
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    if (command.operation != GfxOperation::FILL)
+    {
+        Utils::DCache::Clean(src.pData, RegionBytes(src));
+    }
+    Utils::DCache::CleanInvalidate(dst.pData, RegionBytes(dst));
+    mpCommand = &command;
+    const uint32_t dstAddress = reinterpret_cast<uint32_t>(dst.pData);
+    if (command.operation == GfxOperation::FILL)
+    {
+        status = ToStatus(HAL_DMA2D_Start_IT(&mHdma2d, command.color, dstAddress, dst.width, dst.height));
+    }
+    else if (command.operation == GfxOperation::BLEND)
+    {
+        status = ToStatus(HAL_DMA2D_BlendingStart_IT(&mHdma2d, reinterpret_cast<uint32_t>(src.pData), dstAddress,
+                                                     dstAddress, dst.width, dst.height));
+    }
+    else
+    {
+        status = ToStatus(HAL_DMA2D_Start_IT(&mHdma2d, reinterpret_cast<uint32_t>(src.pData), dstAddress,
+                                             dst.width, dst.height));
+    }
+    if (status != Status::OK)
+    {
+        mpCommand = nullptr;
+    }
+    return status;
+}
+
+
+void GfxEngineHal::OnTransferDone(Status status)
+{
+    const GfxCommand* pCommand = mpCommand;
+    mpCommand = nullptr;
+    if (pCommand == nullptr)
+    {
+        return;
+    }
+    if (status != Status::OK)
+    {
+        // the HAL leaves the handle in the error state, the next command initialises it again
+        mHdma2d.State = HAL_DMA2D_STATE_READY;
+    }
+    // lines fetched speculatively during the transfer are stale
+    Utils::DCache::Invalidate(pCommand->dst.pData, RegionBytes(pCommand->dst));
+    if (mpListener != nullptr)
+    {
+        mpListener->OnCommandDone(*pCommand, status);
+    }
+}
+
+
+Status GfxEngineHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+#endif
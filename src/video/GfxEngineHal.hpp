@@ -0,0 +1,97 @@
+/**
+ ********************************************************************************
+ * @file        GfxEngineHal.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, 2D graphics engine on the DMA2D.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IGfxEngine.hpp"
+#include "stm32h7xx_hal.h"
+
+#if defined(DMA2D)
+namespace Video {
+
+
+/**
+ * @brief   This class provides the IGfxEngine on the DMA2D of the STM32H7.
+ * @details A command programs the output (mode, color mode and line offset in pixels), the foreground layer
+ *          (source) and for BLEND the background layer (the destination region), then starts the transfer
+ *          with interrupt:
+ *          - FILL: register to memory, the color is converted to the output format by the HAL,
+ *          - BLIT: memory to memory, with pixel format conversion if the formats differ,
+ *          - BLEND: memory to memory with blending, the constant alpha is combined with the source alpha.
+ *
+ *          L8 sources load the CLUT of the command into the foreground CLUT. The CLUT stays loaded, it is
+ *          loaded again only for a different table.\n
+ *          The source lines are cleaned from the D-Cache and the destination lines cleaned and invalidated
+ *          before the transfer. The destination is invalidated again at the completion (XferCpltCallback of
+ *          the handle), which reports the command to the listener.
+ * @note    The application initialises the handle with HAL_DMA2D_Init (clock and NVIC in HAL_DMA2D_MspInit),
+ *          DMA2D_IRQHandler calls HAL_DMA2D_IRQHandler. One DMA2D instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * The listener is called from the interrupt context.
+ *
+ */
+class GfxEngineHal : public IGfxEngine
+{
+    public:
+
+        /**
+         * @brief   Constructs the engine for an initialised DMA2D handle and takes its callbacks.
+         *
+         * @param   hdma2d      The DMA2D handle.
+         */
+        explicit GfxEngineHal(DMA2D_HandleTypeDef& hdma2d);
+
+        /// @brief Destructor, aborts a running transfer.
+        ~GfxEngineHal() override;
+
+        /// @copydoc IGfxEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IGfxEngine::Start
+        Status Start(const GfxCommand& command) override;
+
+        /// @brief Transfer done or failed, called by the callbacks of the handle.
+        void OnTransferDone(Status status);
+
+        /// @brief Engine bound to a DMA2D handle or nullptr.
+        static GfxEngineHal* GetInstance(const DMA2D_HandleTypeDef* hdma2d);
+
+    private:
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief Program a layer for a source region.
+        Status ConfigLayer(const Frame& frame, uint32_t layer, uint8_t alpha);
+
+        /// @brief The DMA2D handle.
+        DMA2D_HandleTypeDef& mHdma2d;
+
+        /// @brief Event receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief Command of the running transfer.
+        const GfxCommand* volatile mpCommand{nullptr};
+
+        /// @brief CLUT in the foreground CLUT memory.
+        const uint32_t* mpLoadedClut{nullptr};
+
+        /// @brief The single engine instance, the device has one DMA2D.
+        static GfxEngineHal* spInstance;
+};
+
+} // end namespace Video
+#endif
@@ -0,0 +1,535 @@
+/**
+ ********************************************************************************
+ * @file        GfxEngineSoft.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, software graphics engine implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "GfxEngineSoft.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VIDEO_HAS_X86_INTRINSICS 1
+#endif
+
+using namespace Video;
+
+namespace {
+
+/// @brief x / 255 rounded, exact for 0 <= x <= 255 * 255.
+inline uint32_t Div255(uint32_t x)
+{
+    x += 128U;
+    return (x + (x >> 8U)) >> 8U;
+}
+
+void Expand565Scalar(const uint8_t* pIn, uint32_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const uint32_t v = pIn[2U * i] | (static_cast<uint32_t>(pIn[(2U * i) + 1U]) << 8U);
+        const uint32_t r = v >> 11U;
+        const uint32_t g = (v >> 5U) & 0x3FU;
+        const uint32_t b = v & 0x1FU;
+        pOut[i] = 0xFF000000U | (((r << 3U) | (r >> 2U)) << 16U) | (((g << 2U) | (g >> 4U)) << 8U)
+                | ((b << 3U) | (b >> 2U));
+    }
+}
+
+void Pack565Scalar(const uint32_t* pIn, uint8_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const uint32_t p = pIn[i];
+        const uint32_t v = ((p >> 8U) & 0xF800U) | ((p >> 5U) & 0x07E0U) | ((p >> 3U) & 0x001FU);
+        pOut[2U * i] = static_cast<uint8_t>(v);
+        pOut[(2U * i) + 1U] = static_cast<uint8_t>(v >> 8U);
+    }
+}
+
+void Expand888Scalar(const uint8_t* pIn, uint32_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const uint8_t* p = &pIn[3U * i];
+        pOut[i] = 0xFF000000U | (static_cast<uint32_t>(p[2]) << 16U) | (static_cast<uint32_t>(p[1]) << 8U) | p[0];
+    }
+}
+
+void Pack888Scalar(const uint32_t* pIn, uint8_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        uint8_t* p = &pOut[3U * i];
+        p[0] = static_cast<uint8_t>(pIn[i]);
+        p[1] = static_cast<uint8_t>(pIn[i] >> 8U);
+        p[2] = static_cast<uint8_t>(pIn[i] >> 16U);
+    }
+}
+
+void ClutScalar(const uint8_t* pIn, const uint32_t* pClut, uint32_t* pOut, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        pOut[i] = pClut[pIn[i]];
+    }
+}
+
+/// @brief Blend the foreground over the background in place, see GfxCommand.
+void BlendScalar(const uint32_t* pFg, uint32_t* pBg, uint32_t count, uint32_t alpha)
+{
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const uint32_t fg = pFg[i];
+        const uint32_t bg = pBg[i];
+        const uint32_t af = Div255((fg >> 24U) * alpha);
+        const uint32_t ab = bg >> 24U;
+        const uint32_t am = Div255(af * ab);
+        const uint32_t ao = af + ab - am;
+        const uint32_t wb = ab - am;
+        const float inv = 1.0F / static_cast<float>(std::max(ao, 1U));
+        uint32_t out = ao << 24U;
+        for (uint32_t shift = 0U; shift < 24U; shift += 8U)
+        {
+            const uint32_t n = (((fg >> shift) & 0xFFU) * af) + (((bg >> shift) & 0xFFU) * wb);
+            const uint32_t c = static_cast<uint32_t>(std::nearbyint(static_cast<float>(n) * inv));
+            out |= std::min(c, 255U) << shift;
+        }
+        pBg[i] = out;
+    }
+}
+
+#if defined(VIDEO_HAS_X86_INTRINSICS)
+
+bool CpuHasSse41()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1") != 0;
+}
+
+bool CpuHasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}
+
+__attribute__((target("sse4.1")))
+inline __m128i Div255Sse(__m128i x)
+{
+    x = _mm_add_epi32(x, _mm_set1_epi32(128));
+    return _mm_srli_epi32(_mm_add_epi32(x, _mm_srli_epi32(x, 8)), 8);
+}
+
+/// @brief 4 RGB565 values in 32 bit lanes to ARGB8888.
+__attribute__((target("sse4.1")))
+inline __m128i Expand565Lanes(__m128i v)
+{
+    const __m128i r = _mm_srli_epi32(v, 11);
+    const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x3F));
+    const __m128i b = _mm_and_si128(v, _mm_set1_epi32(0x1F));
+    const __m128i r8 = _mm_or_si128(_mm_slli_epi32(r, 3), _mm_srli_epi32(r, 2));
+    const __m128i g8 = _mm_or_si128(_mm_slli_epi32(g, 2), _mm_srli_epi32(g, 4));
+    const __m128i b8 = _mm_or_si128(_mm_slli_epi32(b, 3), _mm_srli_epi32(b, 2));
+    return _mm_or_si128(_mm_or_si128(_mm_set1_epi32(static_cast<int32_t>(0xFF000000U)), _mm_slli_epi32(r8, 16)),
+                        _mm_or_si128(_mm_slli_epi32(g8, 8), b8));
+}
+
+/// @brief 4 ARGB8888 pixels to RGB565 values in 32 bit lanes.
+__attribute__((target("sse4.1")))
+inline __m128i Pack565Lanes(__m128i p)
+{
+    return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xF800)),
+                                     _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x07E0))),
+                        _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x001F)));
+}
+
+__attribute__((target("sse4.1")))
+void Expand565Sse(const uint8_t* pIn, uint32_t* pOut, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pIn[2U * i]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pOut[i]), Expand565Lanes(_mm_cvtepu16_epi32(v)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pOut[i + 4U]),
+                         Expand565Lanes(_mm_cvtepu16_epi32(_mm_srli_si128(v, 8))));
+    }
+    Expand565Scalar(&pIn[2U * i], &pOut[i], count - i);
+}
+
+__attribute__((target("sse4.1")))
+void Pack565Sse(const uint32_t* pIn, uint8_t* pOut, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        const __m128i lo = Pack565Lanes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pIn[i])));
+        const __m128i hi = Pack565Lanes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pIn[i + 4U])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pOut[2U * i]), _mm_packus_epi32(lo, hi));
+    }
+    Pack565Scalar(&pIn[i], &pOut[2U * i], count - i);
+}
+
+__attribute__((target("sse4.1")))
+void Expand888Sse(const uint8_t* pIn, uint32_t* pOut, uint32_t count)
+{
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int32_t>(0xFF000000U));
+    uint32_t i = 0U;
+    // the 16 byte load reads 4 bytes ahead, keep it inside the line
+    for (; (i + 6U) <= count; i += 4U)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pIn[3U * i]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pOut[i]), _mm_or_si128(_mm_shuffle_epi8(v, shuffle), alpha));
+    }
+    Expand888Scalar(&pIn[3U * i], &pOut[i], count - i);
+}
+
+__attribute__((target("sse4.1")))
+void Pack888Sse(const uint32_t* pIn, uint8_t* pOut, uint32_t count)
+{
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    uint32_t i = 0U;
+    for (; (i + 4U) <= count; i += 4U)
+    {
+        const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pIn[i])), shuffle);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&pOut[3U * i]), v);
+        const int32_t last = _mm_extract_epi32(v, 2);
+        (void)std::memcpy(&pOut[(3U * i) + 8U], &last, sizeof(last));
+    }
+    Pack888Scalar(&pIn[i], &pOut[3U * i], count - i);
+}
+
+__attribute__((target("sse4.1")))
+void BlendSse(const uint32_t* pFg, uint32_t* pBg, uint32_t count, uint32_t alpha)
+{
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i constant = _mm_set1_epi32(static_cast<int32_t>(alpha));
+    uint32_t i = 0U;
+    for (; (i + 4U) <= count; i += 4U)
+    {
+        const __m128i fg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pFg[i]));
+        const __m128i bg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pBg[i]));
+        const __m128i af = Div255Sse(_mm_mullo_epi32(_mm_srli_epi32(fg, 24), constant));
+        const __m128i ab = _mm_srli_epi32(bg, 24);
+        const __m128i am = Div255Sse(_mm_mullo_epi32(af, ab));
+        const __m128i ao = _mm_sub_epi32(_mm_add_epi32(af, ab), am);
+        const __m128i wb = _mm_sub_epi32(ab, am);
+        const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0F), _mm_cvtepi32_ps(_mm_max_epi32(ao, one)));
+        __m128i out = _mm_slli_epi32(ao, 24);
+        for (int32_t shift = 0; shift < 24; shift += 8)
+        {
+            const __m128i cf = _mm_and_si128(_mm_srl_epi32(fg, _mm_cvtsi32_si128(shift)), mask);
+            const __m128i cb = _mm_and_si128(_mm_srl_epi32(bg, _mm_cvtsi32_si128(shift)), mask);
+            const __m128i n = _mm_add_epi32(_mm_mullo_epi32(cf, af), _mm_mullo_epi32(cb, wb));
+            const __m128i c = _mm_min_epi32(_mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(n), inv)), mask);
+            out = _mm_or_si128(out, _mm_sll_epi32(c, _mm_cvtsi32_si128(shift)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pBg[i]), out);
+    }
+    BlendScalar(&pFg[i], &pBg[i], count - i, alpha);
+}
+
+__attribute__((target("avx2")))
+inline __m256i Div255Avx(__m256i x)
+{
+    x = _mm256_add_epi32(x, _mm256_set1_epi32(128));
+    return _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(x, 8)), 8);
+}
+
+__attribute__((target("avx2")))
+void Expand565Avx(const uint8_t* pIn, uint32_t* pOut, uint32_t count)
+{
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int32_t>(0xFF000000U));
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        const __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pIn[2U * i])));
+        const __m256i r = _mm256_srli_epi32(v, 11);
+        const __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x3F));
+        const __m256i b = _mm256_and_si256(v, _mm256_set1_epi32(0x1F));
+        const __m256i r8 = _mm256_or_si256(_mm256_slli_epi32(r, 3), _mm256_srli_epi32(r, 2));
+        const __m256i g8 = _mm256_or_si256(_mm256_slli_epi32(g, 2), _mm256_srli_epi32(g, 4));
+        const __m256i b8 = _mm256_or_si256(_mm256_slli_epi32(b, 3), _mm256_srli_epi32(b, 2));
+        const __m256i p = _mm256_or_si256(_mm256_or_si256(alpha, _mm256_slli_epi32(r8, 16)),
+                                          _mm256_or_si256(_mm256_slli_epi32(g8, 8), b8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[i]), p);
+    }
+    Expand565Scalar(&pIn[2U * i], &pOut[i], count - i);
+}
+
+__attribute__((target("avx2")))
+void Pack565Avx(const uint32_t* pIn, uint8_t* pOut, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 16U) <= count; i += 16U)
+    {
+        __m256i v[2];
+        for (uint32_t k = 0U; k < 2U; k++)
+        {
+            const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pIn[i + (8U * k)]));
+            v[k] = _mm256_or_si256(
+                _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(p, 8), _mm256_set1_epi32(0xF800)),
+                                _mm256_and_si256(_mm256_srli_epi32(p, 5), _mm256_set1_epi32(0x07E0))),
+                _mm256_and_si256(_mm256_srli_epi32(p, 3), _mm256_set1_epi32(0x001F)));
+        }
+        // the pack works per 128 bit lane, restore the pixel order
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v[0], v[1]), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[2U * i]), packed);
+    }
+    Pack565Sse(&pIn[i], &pOut[2U * i], count - i);
+}
+
+__attribute__((target("avx2")))
+void ClutAvx(const uint8_t* pIn, const uint32_t* pClut, uint32_t* pOut, uint32_t count)
+{
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&pIn[i])));
+        const __m256i p = _mm256_i32gather_epi32(reinterpret_cast<const int*>(pClut), index, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pOut[i]), p);
+    }
+    ClutScalar(&pIn[i], pClut, &pOut[i], count - i);
+}
+
+__attribute__((target("avx2")))
+void BlendAvx(const uint32_t* pFg, uint32_t* pBg, uint32_t count, uint32_t alpha)
+{
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i constant = _mm256_set1_epi32(static_cast<int32_t>(alpha));
+    uint32_t i = 0U;
+    for (; (i + 8U) <= count; i += 8U)
+    {
+        const __m256i fg = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pFg[i]));
+        const __m256i bg = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pBg[i]));
+        const __m256i af = Div255Avx(_mm256_mullo_epi32(_mm256_srli_epi32(fg, 24), constant));
+        const __m256i ab = _mm256_srli_epi32(bg, 24);
+        const __m256i am = Div255Avx(_mm256_mullo_epi32(af, ab));
+        const __m256i ao = _mm256_sub_epi32(_mm256_add_epi32(af, ab), am);
+        const __m256i wb = _mm256_sub_epi32(ab, am);
+        const __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0F), _mm256_cvtepi32_ps(_mm256_max_epi32(ao, one)));
+        __m256i out = _mm256_slli_epi32(ao, 24);
+        for (int32_t shift = 0; shift < 24; shift += 8)
+        {
+            const __m128i count128 = _mm_cvtsi32_si128(shift);
+            const __m256i cf = _mm256_and_si256(_mm256_srl_epi32(fg, count128), mask);
+            const __m256i cb = _mm256_and_si256(_mm256_srl_epi32(bg, count128), mask);
+            const __m256i n = _mm256_add_epi32(_mm256_mullo_epi32(cf, af), _mm256_mullo_epi32(cb, wb));
+            const __m256i c = _mm256_min_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(n), inv)), mask);
+            out = _mm256_or_si256(out, _mm256_sll_epi32(c, count128));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pBg[i]), out);
+    }
+    BlendSse(&pFg[i], &pBg[i], count - i, alpha);
+}
+
+#endif
+
+/// @brief A kernel set.
+struct Kernels
+{
+    void (*expand565)(const uint8_t* pIn, uint32_t* pOut, uint32_t count);
+    void (*pack565)(const uint32_t* pIn, uint8_t* pOut, uint32_t count);
+    void (*expand888)(const uint8_t* pIn, uint32_t* pOut, uint32_t count);
+    void (*pack888)(const uint32_t* pIn, uint8_t* pOut, uint32_t count);
+    void (*clut)(const uint8_t* pIn, const uint32_t* pClut, uint32_t* pOut, uint32_t count);
+    void (*blend)(const uint32_t* pFg, uint32_t* pBg, uint32_t count, uint32_t alpha);
+};
+
+#if defined(VIDEO_HAS_X86_INTRINSICS)
+/// @brief The kernel sets in the order of GfxEngineSoft::Kernel, the 24 bit kernels have no AVX2 version.
+constexpr std::array<Kernels, 3> KERNELS{{
+    {Expand565Scalar, Pack565Scalar, Expand888Scalar, Pack888Scalar, ClutScalar, BlendScalar},
+    {Expand565Sse, Pack565Sse, Expand888Sse, Pack888Sse, ClutScalar, BlendSse},
+    {Expand565Avx, Pack565Avx, Expand888Sse, Pack888Sse, ClutAvx, BlendAvx}
+}};
+#else
+constexpr std::array<Kernels, 1> KERNELS{{
+    {Expand565Scalar, Pack565Scalar, Expand888Scalar, Pack888Scalar, ClutScalar, BlendScalar}
+}};
+#endif
+
+/// @brief The kernel set of a selection.
+inline const Kernels& KernelsOf(GfxEngineSoft::Kernel kernel)
+{
+    return KERNELS[std::min<size_t>(static_cast<size_t>(kernel), KERNELS.size() - 1U)];
+}
+
+} // end anonymous namespace
+
+
+GfxEngineSoft::GfxEngineSoft(Kernel kernel)
+: mKernel(std::min(kernel, GetBestKernel()))
+{
+}
+
+
+GfxEngineSoft::Kernel GfxEngineSoft::GetBestKernel()
+{
+#if defined(VIDEO_HAS_X86_INTRINSICS)
+    if (CpuHasAvx2())
+    {
+        return Kernel::AVX2;
+    }
+    if (CpuHasSse41())
+    {
+        return Kernel::SSE41;
+    }
+#endif
+    return Kernel::SCALAR;
+}
+
+
+Status GfxEngineSoft::Start(const GfxCommand& command)
+{
+    const Status status = Process(command);
+    if (mpListener != nullptr)
+    {
+        mpListener->OnCommandDone(command, status);
+    }
+    return Status::OK;
+}
+
+
+Status GfxEngineSoft::Process(const GfxCommand& command)
+{
+    if ((command.dst.pData == nullptr) || (command.dst.format == PixelFormat::L8))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (command.operation == GfxOperation::FILL)
+    {
+        ProcessFill(command);
+        return Status::OK;
+    }
+    if ((command.src.pData == nullptr) || ((command.src.format == PixelFormat::L8) && (command.pClut == nullptr)))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (command.operation == GfxOperation::BLIT)
+    {
+        ProcessBlit(command);
+    }
+    else
+    {
+        ProcessBlend(command);
+    }
+    return Status::OK;
+}
+
+
+void GfxEngineSoft::Fetch(const Frame& frame, const uint8_t* pLine, const uint32_t* pClut, uint32_t* pOut,
+                          uint32_t count) const
+{
+    const Kernels& kernels = KernelsOf(mKernel);
+    switch (frame.format)
+    {
+        case PixelFormat::ARGB8888:
+            (void)std::memcpy(pOut, pLine, count * sizeof(uint32_t));
+            break;
+        case PixelFormat::RGB888:
+            kernels.expand888(pLine, pOut, count);
+            break;
+        case PixelFormat::RGB565:
+            kernels.expand565(pLine, pOut, count);
+            break;
+        default:
+            kernels.clut(pLine, pClut, pOut, count);
+            break;
+    }
+}
+
+
+void GfxEngineSoft::Store(const Frame& frame, const uint32_t* pIn, uint8_t* pLine, uint32_t count) const
+{
+    const Kernels& kernels = KernelsOf(mKernel);
+    switch (frame.format)
+    {
+        case PixelFormat::ARGB8888:
+            (void)std::memcpy(pLine, pIn, count * sizeof(uint32_t));
+            break;
+        case PixelFormat::RGB888:
+            kernels.pack888(pIn, pLine, count);
+            break;
+        default:
+            kernels.pack565(pIn, pLine, count);
+            break;
+    }
+}
+
+
+void GfxEngineSoft::ProcessFill(const GfxCommand& command)
+{
+    const Frame& dst = command.dst;
+    const uint32_t bpp = BytesPerPixel(dst.format);
+    mBg.fill(command.color);
+    // pack the first line, copy it to the others
+    for (uint32_t x = 0U; x < dst.width; x += CHUNK_PIXELS)
+    {
+        Store(dst, mBg.data(), &dst.pData[x * bpp], std::min(CHUNK_PIXELS, dst.width - x));
+    }
+    for (uint32_t y = 1U; y < dst.height; y++)
+    {
+        (void)std::memcpy(&dst.pData[y * dst.stride], dst.pData, dst.width * bpp);
+    }
+}
+
+
+void GfxEngineSoft::ProcessBlit(const GfxCommand& command)
+{
+    const Frame& dst = command.dst;
+    const Frame& src = command.src;
+    if (src.format == dst.format)
+    {
+        for (uint32_t y = 0U; y < dst.height; y++)
+        {
+            (void)std::memmove(&dst.pData[y * dst.stride], &src.pData[y * src.stride],
+                               dst.width * BytesPerPixel(dst.format));
+        }
+        return;
+    }
+    const uint32_t srcBpp = BytesPerPixel(src.format);
+    const uint32_t dstBpp = BytesPerPixel(dst.format);
+    for (uint32_t y = 0U; y < dst.height; y++)
+    {
+        for (uint32_t x = 0U; x < dst.width; x += CHUNK_PIXELS)
+        {
+            const uint32_t count = std::min(CHUNK_PIXELS, dst.width - x);
+            Fetch(src, &src.pData[(y * src.stride) + (x * srcBpp)], command.pClut, mFg.data(), count);
+            Store(dst, mFg.data(), &dst.pData[(y * dst.stride) + (x * dstBpp)], count);
+        }
+    }
+}
+
+
+void GfxEngineSoft::ProcessBlend(const GfxCommand& command)
+{
+    const Frame& dst = command.dst;
+    const Frame& src = command.src;
+    const uint32_t srcBpp = BytesPerPixel(src.format);
+    const uint32_t dstBpp = BytesPerPixel(dst.format);
+    const Kernels& kernels = KernelsOf(mKernel);
+    for (uint32_t y = 0U; y < dst.height; y++)
+    {
+        for (uint32_t x = 0U; x < dst.width; x += CHUNK_PIXELS)
+        {
+            const uint32_t count = std::min(CHUNK_PIXELS, dst.width - x);
+            uint8_t* pDst = &dst.pData[(y * dst.stride) + (x * dstBpp)];
+            Fetch(src, &src.pData[(y * src.stride) + (x * srcBpp)], command.pClut, mFg.data(), count);
+            Fetch(dst, pDst, nullptr, mBg.data(), count);
+            kernels.blend(mFg.data(), mBg.data(), count, command.alpha);
+            Store(dst, mBg.data(), pDst, count);
+        }
+    }
+}
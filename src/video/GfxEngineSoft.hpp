@@ -0,0 +1,117 @@
+/**
+ ********************************************************************************
+ * @file        GfxEngineSoft.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, software 2D graphics engine with SIMD kernels.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IGfxEngine.hpp"
+#include <array>
+namespace Video {
+
+
+/**
+ * @brief   This class provides a software graphics engine with the IGfxEngine interface.
+ * @details The command is processed synchronously inside @ref Start and reported to the listener before
+ *          Start returns. The pixel operations follow the DMA2D (see @ref GfxCommand), so the results can be
+ *          compared with the hardware. A line is processed in chunks: the sources are expanded to ARGB8888,
+ *          blended and packed into the destination format. Fills pack one line and copy it, blits of the
+ *          same format copy the lines.\n
+ *          On the host the expand, pack, CLUT and blend kernels use SSE4.1 or AVX2 if present. All kernel
+ *          sets give identical pixels, the scalar one is the reference.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class GfxEngineSoft : public IGfxEngine
+{
+    public:
+
+        /// @brief Kernel sets.
+        enum class Kernel : uint8_t
+        {
+            SCALAR=0,   //!< Portable C++
+            SSE41=1,    //!< 4 pixels per step
+            AVX2=2      //!< 8 pixels per step
+        };
+
+        /// @brief Constructor, uses the best kernel set of the CPU.
+        GfxEngineSoft() : GfxEngineSoft(GetBestKernel()) {};
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   kernel      Kernel set, limited to the best one of the CPU.
+         */
+        explicit GfxEngineSoft(Kernel kernel);
+
+        /// @brief Destructor.
+        ~GfxEngineSoft() override = default;
+
+        /// @copydoc IGfxEngine::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IGfxEngine::Start
+        Status Start(const GfxCommand& command) override;
+
+        /**
+         * @brief   Process a command without listener (blocking).
+         *
+         * @param   command     The command.
+         *
+         * @return  Result of the command.
+         */
+        Status Process(const GfxCommand& command);
+
+        /// @brief The kernel set in use.
+        Kernel GetKernel() const {return mKernel;};
+
+        /// @brief The best kernel set of the CPU.
+        static Kernel GetBestKernel();
+
+    private:
+
+        /// @brief Pixels per chunk of a line, keeps the buffers in L1.
+        static constexpr uint32_t CHUNK_PIXELS{256U};
+
+        /// @brief Expand pixels of a format to ARGB8888.
+        void Fetch(const Frame& frame, const uint8_t* pLine, const uint32_t* pClut, uint32_t* pOut,
+                   uint32_t count) const;
+
+        /// @brief Pack ARGB8888 pixels into a format.
+        void Store(const Frame& frame, const uint32_t* pIn, uint8_t* pLine, uint32_t count) const;
+
+        /// @brief Fill the region.
+        void ProcessFill(const GfxCommand& command);
+
+        /// @brief Copy or convert the region.
+        void ProcessBlit(const GfxCommand& command);
+
+        /// @brief Blend the source over the region.
+        void ProcessBlend(const GfxCommand& command);
+
+        /// @brief Completion receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief The kernel set.
+        Kernel mKernel;
+
+        /// @brief Foreground chunk.
+        alignas(32) std::array<uint32_t, CHUNK_PIXELS> mFg{};
+
+        /// @brief Background and result chunk.
+        alignas(32) std::array<uint32_t, CHUNK_PIXELS> mBg{};
+};
+
+} // end namespace Video
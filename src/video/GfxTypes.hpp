@@ -0,0 +1,97 @@
+/**
+ ********************************************************************************
+ * @file        GfxTypes.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, types of the 2D graphics commands.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "VideoTypes.hpp"
+namespace Video {
+
+
+/// @brief A rectangle in pixels.
+struct Rect
+{
+    uint16_t x{0U};         //!< Left column
+    uint16_t y{0U};         //!< Top line
+    uint16_t width{0U};     //!< Columns
+    uint16_t height{0U};    //!< Lines
+
+    /// @brief Pixels of the rectangle.
+    constexpr uint32_t Area() const
+    {
+        return static_cast<uint32_t>(width) * height;
+    };
+
+    /// @brief True if the rectangle has no pixels.
+    constexpr bool IsEmpty() const
+    {
+        return (width == 0U) || (height == 0U);
+    };
+
+    /// @brief True if the other rectangle lies completely inside this one.
+    constexpr bool Contains(const Rect& other) const
+    {
+        return (other.x >= x) && (other.y >= y) && ((other.x + other.width) <= (x + width))
+               && ((other.y + other.height) <= (y + height));
+    };
+
+    /// @brief The bounding rectangle of both, an empty rectangle doesn't count.
+    constexpr Rect Union(const Rect& other) const
+    {
+        if (other.IsEmpty())
+        {
+            return *this;
+        }
+        if (IsEmpty())
+        {
+            return other;
+        }
+        const uint16_t left = (x < other.x) ? x : other.x;
+        const uint16_t top = (y < other.y) ? y : other.y;
+        const uint32_t right = ((x + width) > (other.x + other.width)) ? (x + width) : (other.x + other.width);
+        const uint32_t bottom = ((y + height) > (other.y + other.height)) ? (y + height) : (other.y + other.height);
+        return Rect{left, top, static_cast<uint16_t>(right - left), static_cast<uint16_t>(bottom - top)};
+    };
+};
+
+/// @brief Kind of a graphics command.
+enum class GfxOperation : uint8_t
+{
+    FILL=0,     //!< Fill the destination with a color (DMA2D register to memory)
+    BLIT=1,     //!< Copy the source, converting its pixel format (DMA2D memory to memory with PFC)
+    BLEND=2     //!< Blend the source over the destination (DMA2D memory to memory with blending)
+};
+
+
+/**
+ * @brief   One graphics command on resolved regions, as it is programmed to the DMA2D.
+ * @details The frames describe the regions: pData is the first pixel of the region, width and height
+ *          the size of the region and stride the line pitch of the surface. Source and destination have
+ *          the size of the destination region.\n
+ *          The pixel operations follow the DMA2D pixel format converter and blender:
+ *          - RGB565 is expanded to 8 bit by replicating the upper bits, 8 bit is truncated to RGB565,
+ *          - RGB565 and RGB888 read with alpha 255, L8 reads through the CLUT (ARGB8888),
+ *          - the constant alpha is combined: Af = Af * alpha / 255,
+ *          - blending: Am = Af * Ab / 255, Ao = Af + Ab - Am, Co = (Cf * Af + Cb * (Ab - Am)) / Ao,
+ *            the divisions by 255 are rounded, the division by Ao as float with a reciprocal.
+ */
+struct GfxCommand
+{
+    GfxOperation operation{GfxOperation::FILL};     //!< Operation
+    Frame dst{};                                    //!< Destination region (and background of BLEND)
+    Frame src{};                                    //!< BLIT, BLEND: source region
+    uint32_t color{0U};                             //!< FILL: color (ARGB8888)
+    uint8_t alpha{255U};                            //!< BLEND: constant alpha of the source
+    const uint32_t* pClut{nullptr};                 //!< L8 source: 256 ARGB8888 entries
+};
+
+} // end namespace Video
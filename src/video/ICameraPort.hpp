@@ -0,0 +1,106 @@
+/**
+ ********************************************************************************
+ * @file        ICameraPort.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, interface of a parallel camera port.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "GfxTypes.hpp"
+namespace Video {
+
+
+/**
+ * @brief   Configuration of a continuous capture.
+ * @details The window is cut out of the sensor frame by the port (hardware cropping), the frames in memory
+ *          have the size of the window.
+ */
+struct CaptureConfig
+{
+    Rect window{};                              //!< Captured part of the sensor frame
+    PixelFormat format{PixelFormat::RGB565};    //!< Pixel format of the sensor
+    uint32_t stride{0U};                        //!< Bytes from line to line in memory
+
+    /// @brief Bytes of a line of the window.
+    constexpr uint32_t LineBytes() const {return static_cast<uint32_t>(window.width) * BytesPerPixel(format);};
+
+    /// @brief Bytes of a frame in memory.
+    constexpr uint32_t FrameBytes() const {return stride * window.height;};
+};
+
+
+/**
+ * @brief   This class provides the interface of a camera port (DCMI, PSSI or a host sensor).
+ * @details The port captures continuously: every frame of the sensor goes into the buffer the listener has
+ *          handed out at the end of the previous frame, without a new start in between. A frame without
+ *          buffer is skipped. The port reports every frame end with the filled buffer.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to drive it through one CaptureService.
+ *
+ */
+class ICameraPort
+{
+    public:
+
+        /// @brief Receiver of the frame events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief A frame has ended, called from the interrupt context.
+                 * @param pFrame    The buffer of the frame, nullptr if it was skipped.
+                 * @param status    OK, OVERRUN (data lost, the frame is incomplete) or HW_ERROR (the capture
+                 *                  stopped).
+                 * @return The buffer of the next frame, nullptr to skip it.
+                 */
+                virtual uint8_t* OnFrame(uint8_t* pFrame, Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~ICameraPort() = default;
+
+        /**
+         * @brief Register the listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start the continuous capture with the next frame of the sensor.
+         * @param config    The capture, the window must lie inside the sensor frame.
+         * @param pFrame    Buffer of the first frame, at least config.FrameBytes().
+         * @return OK, BUSY, INVALID_PARAM, HW_ERROR.
+         */
+        virtual Status Start(const CaptureConfig& config, uint8_t* pFrame) = 0;
+
+        /// @brief Stop the capture, the running frame is not reported.
+        virtual void Stop() = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        ICameraPort() = default;
+
+        ICameraPort(ICameraPort const &) = default;             //!< Copy constructor
+        ICameraPort(ICameraPort &&) = default;                  //!< Move constructor
+
+        ICameraPort& operator=(ICameraPort const &) = default;  //!< Copy assignment
+        ICameraPort& operator=(ICameraPort &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Video
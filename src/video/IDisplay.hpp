@@ -0,0 +1,112 @@
+/**
+ ********************************************************************************
+ * @file        IDisplay.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, interface of a display controller with layers and shadow registers.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "GfxTypes.hpp"
+namespace Video {
+
+
+/**
+ * @brief   Declarative state of a display layer.
+ * @details The window has the size of the frame, the layer is blended over the layers below (and the
+ *          background color) with the pixel alpha times the constant alpha, like the LTDC blending factors
+ *          PAxCA.
+ */
+struct LayerConfig
+{
+    Frame frame{};                  //!< The framebuffer shown in the window
+    uint16_t x{0U};                 //!< Left column of the window on the panel
+    uint16_t y{0U};                 //!< Top line of the window on the panel
+    uint8_t alpha{255U};            //!< Constant alpha
+    bool enabled{false};            //!< The layer is shown
+    const uint32_t* pClut{nullptr}; //!< L8: 256 ARGB8888 entries (the alpha is not used)
+};
+
+
+/**
+ * @brief   This class provides the interface of a display controller (LTDC) with shadowed layer registers.
+ * @details @ref Configure describes the complete state of a layer, the controller works out what changed
+ *          and programs the shadow registers without reload, the panel keeps showing the active state.
+ *          @ref Commit schedules the reload of all shadow registers at the line event in the vertical
+ *          blanking, so the scanout never shows a half updated frame. The listener is called when the
+ *          reload has been done, after it the previous framebuffers aren't read any more.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * The listener is called from the interrupt context of the controller.
+ *
+ */
+class IDisplay
+{
+    public:
+
+        /// @brief Layers of the controller.
+        static constexpr uint8_t LAYERS{2U};
+
+        /// @brief Receiver of the reload event.
+        class IListener
+        {
+            public:
+                /// @brief The committed configuration is active (vertical blanking).
+                virtual void OnReload() = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IDisplay() = default;
+
+        /**
+         * @brief Register the reload listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Set the state of a layer, active after the next @ref Commit.
+         * @param layer     Layer index, 0 is the bottom layer.
+         * @param config    The new state, the window must lie inside the panel.
+         * @return OK, INVALID_PARAM.
+         */
+        virtual Status Configure(uint8_t layer, const LayerConfig& config) = 0;
+
+        /**
+         * @brief Schedule the reload of the configured state at the next vertical blanking.
+         * @return OK, the listener is called at the reload.
+         */
+        virtual Status Commit() = 0;
+
+        /// @brief Pixels per line of the panel.
+        virtual uint16_t GetWidth() const = 0;
+
+        /// @brief Lines of the panel.
+        virtual uint16_t GetHeight() const = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IDisplay() = default;
+
+        IDisplay(IDisplay const &) = default;             //!< Copy constructor
+        IDisplay(IDisplay &&) = default;                  //!< Move constructor
+
+        IDisplay& operator=(IDisplay const &) = default;  //!< Copy assignment
+        IDisplay& operator=(IDisplay &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Video
@@ -0,0 +1,82 @@
+/**
+ ********************************************************************************
+ * @file        IGfxEngine.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, interface of a 2D graphics engine.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "GfxTypes.hpp"
+namespace Video {
+
+
+/**
+ * @brief   This class provides the interface of a 2D graphics engine which executes one command at a time.
+ * @details The engine starts a command with @ref Start and reports the completion to its listener.
+ *          A hardware engine reports from the interrupt context, a software engine may report
+ *          synchronously from inside @ref Start.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users responsibility to start a command only when the previous one has been reported.
+ *
+ */
+class IGfxEngine
+{
+    public:
+
+        /// @brief Receiver of the command completion.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief Called exactly once per started command.
+                 * @param command   The finished command.
+                 * @param status    Result of the command.
+                 */
+                virtual void OnCommandDone(const GfxCommand& command, Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IGfxEngine() = default;
+
+        /**
+         * @brief Register the completion listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start a command.
+         * @param command   A validated command, it stays valid until it has been reported.
+         * @return OK if the command was started (completion follows via the listener),
+         *         otherwise the command was not started and the listener is not called.
+         */
+        virtual Status Start(const GfxCommand& command) = 0;
+
+    protected:
+
+        /// @brief Constructor.
+        IGfxEngine() = default;
+
+        IGfxEngine(IGfxEngine const &) = default;             //!< Copy constructor
+        IGfxEngine(IGfxEngine &&) = default;                  //!< Move constructor
+
+        IGfxEngine& operator=(IGfxEngine const &) = default;  //!< Copy assignment
+        IGfxEngine& operator=(IGfxEngine &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Video
@@ -0,0 +1,137 @@
+/**
+ ********************************************************************************
+ * @file        IJpegCodec.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, interface of a streaming JPEG codec (hardware or software backend).
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "VideoTypes.hpp"
+namespace Video {
+
+
+/**
+ * @brief   This class provides the interface of a JPEG codec which streams one image at a time in chunks.
+ * @details The codec works on YCbCr MCUs like the JPEG peripheral: the encoder takes MCUs and writes the
+ *          JPEG stream (with headers), the decoder takes the stream and writes MCUs (see @ref Subsampling
+ *          for the block order). The input and the output are handed over in chunks:
+ *          - @ref IListener::OnInputConsumed asks for the next input chunk,
+ *          - @ref IListener::OnOutput returns a filled output chunk and asks for the next output buffer.
+ *
+ *          The listener may feed the next chunk from inside the callback, otherwise the codec pauses
+ *          until @ref FeedInput / @ref FeedOutput is called (HAL_JPEG_Pause / HAL_JPEG_Resume).
+ *          Encoder input chunks and decoder output chunks hold whole MCUs.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * A hardware codec calls the listener from the interrupt context, a software codec from @ref Poll.
+ *
+ */
+class IJpegCodec
+{
+    public:
+
+        /// @brief Receiver of the codec events.
+        class IListener
+        {
+            public:
+                /**
+                 * @brief Decoder: the header was parsed, called before the first output.
+                 * @param info  Parameters of the image.
+                 */
+                virtual void OnInfo(const JpegInfo& info) = 0;
+
+                /// @brief The input chunk is consumed, feed the next one.
+                virtual void OnInputConsumed() = 0;
+
+                /**
+                 * @brief An output chunk is complete (full or end of image), feed the next buffer.
+                 * @param pData     Start of the chunk.
+                 * @param length    Bytes written.
+                 */
+                virtual void OnOutput(uint8_t* pData, uint32_t length) = 0;
+
+                /**
+                 * @brief The image is finished (after its last output), called exactly once per started image.
+                 * @param status    OK, FORMAT_ERROR, INVALID_PARAM or HW_ERROR.
+                 */
+                virtual void OnDone(Status status) = 0;
+
+            protected:
+                /// @brief Destructor, no deletion by interface.
+                ~IListener() = default;
+        };
+
+        /// @brief Virtual destructor for proper cleanup in derived classes.
+        virtual ~IJpegCodec() = default;
+
+        /**
+         * @brief Register the event listener.
+         * @param pListener  The listener, nullptr to unregister.
+         */
+        virtual void SetListener(IListener* pListener) = 0;
+
+        /**
+         * @brief Start to encode an image.
+         * @param config    Size, subsampling and quality.
+         * @param pInput    First MCU chunk.
+         * @param inLength  Bytes of the chunk, whole MCUs.
+         * @param pOutput   First output buffer.
+         * @param outLength Bytes of the buffer.
+         * @return OK if started, BUSY or INVALID_PARAM (the listener is not called then).
+         */
+        virtual Status StartEncode(const JpegInfo& config, const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput,
+                                   uint32_t outLength) = 0;
+
+        /**
+         * @brief Start to decode an image.
+         * @param pInput    First stream chunk.
+         * @param inLength  Bytes of the chunk.
+         * @param pOutput   First output buffer.
+         * @param outLength Bytes of the buffer, at least one MCU.
+         * @return OK if started, BUSY or INVALID_PARAM (the listener is not called then).
+         */
+        virtual Status StartDecode(const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput, uint32_t outLength) = 0;
+
+        /**
+         * @brief Hand over the next input chunk, after @ref IListener::OnInputConsumed.
+         * @param pInput    The chunk.
+         * @param length    Bytes of the chunk.
+         */
+        virtual void FeedInput(const uint8_t* pInput, uint32_t length) = 0;
+
+        /**
+         * @brief Hand over the next output buffer, after @ref IListener::OnOutput.
+         * @param pOutput   The buffer.
+         * @param length    Bytes of the buffer.
+         */
+        virtual void FeedOutput(uint8_t* pOutput, uint32_t length) = 0;
+
+        /// @brief Stop the image, the listener is not called for it anymore.
+        virtual void Abort() = 0;
+
+        /// @brief Make progress without interrupt, a software codec codes here.
+        virtual void Poll() {};
+
+    protected:
+
+        /// @brief Constructor.
+        IJpegCodec() = default;
+
+        IJpegCodec(IJpegCodec const &) = default;             //!< Copy constructor
+        IJpegCodec(IJpegCodec &&) = default;                  //!< Move constructor
+
+        IJpegCodec& operator=(IJpegCodec const &) = default;  //!< Copy assignment
+        IJpegCodec& operator=(IJpegCodec &&) = default;       //!< Move assignment
+
+};
+
+} // end namespace Video
@@ -0,0 +1,302 @@
+/**
+ ********************************************************************************
+ * @file        JpegCodecHal.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, JPEG peripheral codec implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "JpegCodecHal.hpp"
+#include "DCache.hpp"
+
+#if defined(JPEG)
+
+using namespace Video;
+
+JpegCodecHal* JpegCodecHal::spInstance{nullptr};
+
+JpegCodecHal::JpegCodecHal(JPEG_HandleTypeDef& hjpeg)
+: mHjpeg(hjpeg)
+{
+    spInstance = this;
+}
+
+
+JpegCodecHal::~JpegCodecHal()
+{
+    (void)HAL_JPEG_Abort(&mHjpeg);
+    if (spInstance == this)
+    {
+        spInstance = nullptr;
+    }
+}
+
+
+JpegCodecHal* JpegCodecHal::GetInstance(const JPEG_HandleTypeDef* hjpeg)
+{
+    if ((spInstance != nullptr) && (&spInstance->mHjpeg == hjpeg))
+    {
+        return spInstance;
+    }
+    return nullptr;
+}
+
+
+Status JpegCodecHal::StartEncode(const JpegInfo& config, const uint8_t* pInput, uint32_t inLength,
+                                 uint8_t* pOutput, uint32_t outLength)
+{
+    if ((pInput == nullptr) || (pOutput == nullptr) || (inLength == 0U) || (outLength < 4U)
+        || (config.quality == 0U) || (config.quality > 100U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (HAL_JPEG_GetState(&mHjpeg) != HAL_JPEG_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+
+    JPEG_ConfTypeDef conf{};
+    conf.ColorSpace = (config.subsampling == Subsampling::GRAY) ? JPEG_GRAYSCALE_COLORSPACE : JPEG_YCBCR_COLORSPACE;
+    conf.ChromaSubsampling = (config.subsampling == Subsampling::YCBCR_420) ? JPEG_420_SUBSAMPLING :
+                             ((config.subsampling == Subsampling::YCBCR_422) ? JPEG_422_SUBSAMPLING :
+                              JPEG_444_SUBSAMPLING);
+    conf.ImageWidth = config.width;
+    conf.ImageHeight = config.height;
+    conf.ImageQuality = config.quality;
+    if (HAL_JPEG_ConfigEncoding(&mHjpeg, &conf) != HAL_OK)
+    {
+        return Status::INVALID_PARAM;
+    }
+
+    mpIn = pInput;
+    mInLength = inLength;
+    mpOut = pOutput;
+    mOutLength = outLength;
+    mInputPaused = false;
+    mOutputPaused = false;
+    Utils::DCache::Clean(pInput, inLength);
+    Utils::DCache::CleanInvalidate(pOutput, outLength);
+    return ToStatus(HAL_JPEG_Encode_DMA(&mHjpeg, const_cast<uint8_t*>(pInput), inLength, pOutput, outLength));
+}
+
+
+Status JpegCodecHal::StartDecode(const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput, uint32_t outLength)
+{
+    if ((pInput == nullptr) || (pOutput == nullptr) || (inLength == 0U) || (outLength < JPEG_BLOCK_SIZE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    if (HAL_JPEG_GetState(&mHjpeg) != HAL_JPEG_STATE_READY)
+    {
+        return Status::BUSY;
+    }
+    mpIn = pInput;
+    mInLength = inLength;
+    mpOut = pOutput;
+    mOutLength = outLength;
+    mInputPaused = false;
+    mOutputPaused = false;
+    Utils::DCache::Clean(pInput, inLength);
+    Utils::DCache::CleanInvalidate(pOutput, outLength);
+    return ToStatus(HAL_JPEG_Decode_DMA(&mHjpeg, const_cast<uint8_t*>(pInput), inLength, pOutput, outLength));
+}
+
+
+void JpegCodecHal::FeedInput(const uint8_t* pInput, uint32_t length)
+{
+    Utils::DCache::Clean(pInput, length);
+    mpIn = pInput;
+    mInLength = length;
+    mInputFed = true;
+    HAL_JPEG_ConfigInputBuffer(&mHjpeg, const_cast<uint8_t*>(pInput), length);
+    if (mInputPaused)
+    {
+        mInputPaused = false;
+        (void)HAL_JPEG_Resume(&mHjpeg, JPEG_PAUSE_RESUME_INPUT);
+    }
+}
+
+
+void JpegCodecHal::FeedOutput(uint8_t* pOutput, uint32_t length)
+{
+    Utils::DCache::CleanInvalidate(pOutput, length);
+    mpOut = pOutput;
+    mOutLength = length;
+    mOutputFed = true;
+    HAL_JPEG_ConfigOutputBuffer(&mHjpeg, pOutput, length);
+    if (mOutputPaused)
+    {
+        mOutputPaused = false;
+        (void)HAL_JPEG_Resume(&mHjpeg, JPEG_PAUSE_RESUME_OUTPUT);
+    }
+}
+
+
+void JpegCodecHal::Abort()
+{
+    (void)HAL_JPEG_Abort(&mHjpeg);
+    mInputPaused = false;
+    mOutputPaused = false;
+}
+
+
+void JpegCodecHal::OnInfo(const JPEG_ConfTypeDef& conf)
+{
+    JpegInfo info{};
+    info.width = static_cast<uint16_t>(conf.ImageWidth);
+    info.height = static_cast<uint16_t>(conf.ImageHeight);
+    info.quality = static_cast<uint8_t>(conf.ImageQuality);
+    if (conf.ColorSpace == JPEG_GRAYSCALE_COLORSPACE)
+    {
+        info.subsampling = Subsampling::GRAY;
+    }
+    else if (conf.ColorSpace == JPEG_YCBCR_COLORSPACE)
+    {
+        info.subsampling = (conf.ChromaSubsampling == JPEG_420_SUBSAMPLING) ? Subsampling::YCBCR_420 :
+                           ((conf.ChromaSubsampling == JPEG_422_SUBSAMPLING) ? Subsampling::YCBCR_422 :
+                            Subsampling::YCBCR_444);
+    }
+    else
+    {
+        // CMYK has no MCU layout of the IJpegCodec
+        (void)HAL_JPEG_Abort(&mHjpeg);
+        OnDone(Status::FORMAT_ERROR);
+        return;
+    }
+    if (mpListener != nullptr)
+    {
+        mpListener->OnInfo(info);
+    }
+}
+
+
+void JpegCodecHal::OnGetData(uint32_t consumed)
+{
+    if (consumed < mInLength)
+    {
+        // the decoder stopped inside the chunk (end of the header), it continues with the rest
+        mpIn = &mpIn[consumed];
+        mInLength -= consumed;
+        HAL_JPEG_ConfigInputBuffer(&mHjpeg, const_cast<uint8_t*>(mpIn), mInLength);
+        return;
+    }
+    mInputFed = false;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnInputConsumed();
+    }
+    if (!mInputFed)
+    {
+        mInputPaused = true;
+        (void)HAL_JPEG_Pause(&mHjpeg, JPEG_PAUSE_RESUME_INPUT);
+    }
+}
+
+
+void JpegCodecHal::OnDataReady(uint8_t* pData, uint32_t length)
+{
+    // lines fetched speculatively during the transfer are stale
+    Utils::DCache::Invalidate(pData, length);
+    mOutputFed = false;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnOutput(pData, length);
+    }
+    if (!mOutputFed)
+    {
+        mOutputPaused = true;
+        (void)HAL_JPEG_Pause(&mHjpeg, JPEG_PAUSE_RESUME_OUTPUT);
+    }
+}
+
+
+void JpegCodecHal::OnDone(Status status)
+{
+    mInputPaused = false;
+    mOutputPaused = false;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(status);
+    }
+}
+
+
+Status JpegCodecHal::ToStatus(HAL_StatusTypeDef result)
+{
+    switch (result)
+    {
+        case HAL_OK:
+            return Status::OK;
+        case HAL_BUSY:
+            return Status::BUSY;
+        default:
+            return Status::HW_ERROR;
+    }
+}
+
+
+extern "C" void HAL_JPEG_InfoReadyCallback(JPEG_HandleTypeDef* hjpeg, JPEG_ConfTypeDef* pInfo)
+{
+    JpegCodecHal* pCodec = JpegCodecHal::GetInstance(hjpeg);
+    if ((pCodec != nullptr) && (pInfo != nullptr))
+    {
+        pCodec->OnInfo(*pInfo);
+    }
+}
+
+
+extern "C" void HAL_JPEG_GetDataCallback(JPEG_HandleTypeDef* hjpeg, uint32_t NbDecodedData)
+{
+    JpegCodecHal* pCodec = JpegCodecHal::GetInstance(hjpeg);
+    if (pCodec != nullptr)
+    {
+        pCodec->OnGetData(NbDecodedData);
+    }
+}
+
+
+extern "C" void HAL_JPEG_DataReadyCallback(JPEG_HandleTypeDef* hjpeg, uint8_t* pDataOut, uint32_t OutDataLength)
+{
+    JpegCodecHal* pCodec = JpegCodecHal::GetInstance(hjpeg);
+    if (pCodec != nullptr)
+    {
+        pCodec->OnDataReady(pDataOut, OutDataLength);
+    }
+}
+
+
+extern "C" void HAL_JPEG_EncodeCpltCallback(JPEG_HandleTypeDef* hjpeg)
+{
+    JpegCodecHal* pCodec = JpegCodecHal::GetInstance(hjpeg);
+    if (pCodec != nullptr)
+    {
+        pCodec->OnDone(Status::OK);
+    }
+}
+
+
+extern "C" void HAL_JPEG_DecodeCpltCallback(JPEG_HandleTypeDef* hjpeg)
+{
+    JpegCodecHal* pCodec = JpegCodecHal::GetInstance(hjpeg);
+    if (pCodec != nullptr)
+    {
+        pCodec->OnDone(Status::OK);
+    }
+}
+
+
+extern "C" void HAL_JPEG_ErrorCallback(JPEG_HandleTypeDef* hjpeg)
+{
+    JpegCodecHal* pCodec = JpegCodecHal::GetInstance(hjpeg);
+    if (pCodec != nullptr)
+    {
+        pCodec->OnDone(Status::HW_ERROR);
+    }
+}
+
+#endif
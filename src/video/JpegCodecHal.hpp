@@ -0,0 +1,122 @@
+/**
+ ********************************************************************************
+ * @file        JpegCodecHal.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, JPEG codec on the JPEG peripheral with DMA.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IJpegCodec.hpp"
+#include "stm32h7xx_hal.h"
+
+#if defined(JPEG)
+namespace Video {
+
+
+/**
+ * @brief   This class provides the IJpegCodec on the JPEG peripheral of the STM32H7.
+ * @details StartEncode configures the header generator (HAL_JPEG_ConfigEncoding) and runs HAL_JPEG_Encode_DMA,
+ *          StartDecode runs HAL_JPEG_Decode_DMA with header parsing. The events map to the HAL callbacks:
+ *          - HAL_JPEG_InfoReadyCallback: @ref IListener::OnInfo,
+ *          - HAL_JPEG_GetDataCallback: @ref IListener::OnInputConsumed, a partly consumed chunk is fed again
+ *            with its rest first,
+ *          - HAL_JPEG_DataReadyCallback: @ref IListener::OnOutput,
+ *          - HAL_JPEG_EncodeCpltCallback, HAL_JPEG_DecodeCpltCallback and HAL_JPEG_ErrorCallback:
+ *            @ref IListener::OnDone.
+ *
+ *          If the listener doesn't feed the next chunk from inside the callback, the transfer is paused
+ *          (HAL_JPEG_Pause) and resumed by FeedInput / FeedOutput.\n
+ *          The D-Cache lines of an input chunk are cleaned before it is fed, the lines of an output buffer are
+ *          cleaned and invalidated before and invalidated again when it is returned.
+ * @note    The application initialises the handle with HAL_JPEG_Init (MDMA channels in HAL_JPEG_MspInit),
+ *          JPEG_IRQHandler and MDMA_IRQHandler call the HAL handlers. The chunks must be aligned to 32 bytes
+ *          and located in AXI SRAM or SDRAM, their lengths multiples of 4. One JPEG instance is supported.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * The listener is called from the interrupt context.
+ *
+ */
+class JpegCodecHal : public IJpegCodec
+{
+    public:
+
+        /**
+         * @brief   Constructs the codec for an initialised JPEG handle.
+         *
+         * @param   hjpeg       The JPEG handle.
+         */
+        explicit JpegCodecHal(JPEG_HandleTypeDef& hjpeg);
+
+        /// @brief Destructor, aborts the image.
+        ~JpegCodecHal() override;
+
+        /// @copydoc IJpegCodec::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IJpegCodec::StartEncode
+        Status StartEncode(const JpegInfo& config, const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput,
+                           uint32_t outLength) override;
+
+        /// @copydoc IJpegCodec::StartDecode
+        Status StartDecode(const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput, uint32_t outLength) override;
+
+        /// @copydoc IJpegCodec::FeedInput
+        void FeedInput(const uint8_t* pInput, uint32_t length) override;
+
+        /// @copydoc IJpegCodec::FeedOutput
+        void FeedOutput(uint8_t* pOutput, uint32_t length) override;
+
+        /// @copydoc IJpegCodec::Abort
+        void Abort() override;
+
+        /// @brief Header parsed, called by HAL_JPEG_InfoReadyCallback.
+        void OnInfo(const JPEG_ConfTypeDef& conf);
+
+        /// @brief Input chunk consumed, called by HAL_JPEG_GetDataCallback.
+        void OnGetData(uint32_t consumed);
+
+        /// @brief Output chunk ready, called by HAL_JPEG_DataReadyCallback.
+        void OnDataReady(uint8_t* pData, uint32_t length);
+
+        /// @brief Image done or failed, called by the complete and error callbacks.
+        void OnDone(Status status);
+
+        /// @brief Codec bound to a JPEG handle or nullptr.
+        static JpegCodecHal* GetInstance(const JPEG_HandleTypeDef* hjpeg);
+
+    private:
+
+        /// @brief Map the HAL result.
+        static Status ToStatus(HAL_StatusTypeDef result);
+
+        /// @brief The JPEG handle.
+        JPEG_HandleTypeDef& mHjpeg;
+
+        /// @brief Event receiver.
+        IListener* mpListener{nullptr};
+
+        const uint8_t* mpIn{nullptr};           //!< Input chunk
+        uint32_t mInLength{0U};                 //!< Bytes of the input chunk
+        uint8_t* mpOut{nullptr};                //!< Output buffer
+        uint32_t mOutLength{0U};                //!< Bytes of the output buffer
+
+        volatile bool mInputFed{false};         //!< FeedInput was called inside the callback
+        volatile bool mOutputFed{false};        //!< FeedOutput was called inside the callback
+        volatile bool mInputPaused{false};      //!< The input transfer is paused
+        volatile bool mOutputPaused{false};     //!< The output transfer is paused
+
+        /// @brief The single codec instance, the device has one JPEG.
+        static JpegCodecHal* spInstance;
+};
+
+} // end namespace Video
+#endif
@@ -0,0 +1,1169 @@
+/**
+ ********************************************************************************
+ * @file        JpegCodecSoft.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, software baseline JPEG codec implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "JpegCodecSoft.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+using namespace Video;
+
+namespace {
+
+// markers
+constexpr uint8_t SOI{0xD8U};
+constexpr uint8_t EOI{0xD9U};
+constexpr uint8_t SOF0{0xC0U};
+constexpr uint8_t SOF1{0xC1U};
+constexpr uint8_t DHT{0xC4U};
+constexpr uint8_t DQT{0xDBU};
+constexpr uint8_t DRI{0xDDU};
+constexpr uint8_t SOS{0xDAU};
+constexpr uint8_t RST0{0xD0U};
+
+/// @brief Natural index of the zigzag positions.
+constexpr std::array<uint8_t, 64> ZIGZAG{
+     0U,  1U,  8U, 16U,  9U,  2U,  3U, 10U, 17U, 24U, 32U, 25U, 18U, 11U,  4U,  5U,
+    12U, 19U, 26U, 33U, 40U, 48U, 41U, 34U, 27U, 20U, 13U,  6U,  7U, 14U, 21U, 28U,
+    35U, 42U, 49U, 56U, 57U, 50U, 43U, 36U, 29U, 22U, 15U, 23U, 30U, 37U, 44U, 51U,
+    58U, 59U, 52U, 45U, 38U, 31U, 39U, 46U, 53U, 60U, 61U, 54U, 47U, 55U, 62U, 63U};
+
+/// @brief Luminance quantization table of ITU T.81 K.1 (natural order).
+constexpr std::array<uint8_t, 64> LUMA_QUANT{
+    16U, 11U, 10U, 16U,  24U,  40U,  51U,  61U,  12U, 12U, 14U, 19U,  26U,  58U,  60U,  55U,
+    14U, 13U, 16U, 24U,  40U,  57U,  69U,  56U,  14U, 17U, 22U, 29U,  51U,  87U,  80U,  62U,
+    18U, 22U, 37U, 56U,  68U, 109U, 103U,  77U,  24U, 35U, 55U, 64U,  81U, 104U, 113U,  92U,
+    49U, 64U, 78U, 87U, 103U, 121U, 120U, 101U,  72U, 92U, 95U, 98U, 112U, 100U, 103U,  99U};
+
+/// @brief Chrominance quantization table of ITU T.81 K.2 (natural order).
+constexpr std::array<uint8_t, 64> CHROMA_QUANT{
+    17U, 18U, 24U, 47U, 99U, 99U, 99U, 99U,  18U, 21U, 26U, 66U, 99U, 99U, 99U, 99U,
+    24U, 26U, 56U, 99U, 99U, 99U, 99U, 99U,  47U, 66U, 99U, 99U, 99U, 99U, 99U, 99U,
+    99U, 99U, 99U, 99U, 99U, 99U, 99U, 99U,  99U, 99U, 99U, 99U, 99U, 99U, 99U, 99U,
+    99U, 99U, 99U, 99U, 99U, 99U, 99U, 99U,  99U, 99U, 99U, 99U, 99U, 99U, 99U, 99U};
+
+/// @brief A Huffman table as in a DHT segment.
+struct HuffmanSpec
+{
+    std::array<uint8_t, 17> counts;     //!< Codes per length 1..16 (index 0 unused)
+    std::array<uint8_t, 162> values;    //!< Symbols in code order
+};
+
+/// @brief Standard tables of ITU T.81 K.3 to K.6: luminance DC, chrominance DC, luminance AC, chrominance AC.
+constexpr std::array<HuffmanSpec, 4> STANDARD_TABLES{{
+    {{0U, 0U, 1U, 5U, 1U, 1U, 1U, 1U, 1U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U},
+     {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U}},
+    {{0U, 0U, 3U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 0U, 0U, 0U, 0U, 0U},
+     {0U, 1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U}},
+    {{0U, 0U, 2U, 1U, 3U, 3U, 2U, 4U, 3U, 5U, 5U, 4U, 4U, 0U, 0U, 1U, 0x7DU},
+     {0x01U, 0x02U, 0x03U, 0x00U, 0x04U, 0x11U, 0x05U, 0x12U, 0x21U, 0x31U, 0x41U, 0x06U, 0x13U, 0x51U, 0x61U, 0x07U,
+      0x22U, 0x71U, 0x14U, 0x32U, 0x81U, 0x91U, 0xA1U, 0x08U, 0x23U, 0x42U, 0xB1U, 0xC1U, 0x15U, 0x52U, 0xD1U, 0xF0U,
+      0x24U, 0x33U, 0x62U, 0x72U, 0x82U, 0x09U, 0x0AU, 0x16U, 0x17U, 0x18U, 0x19U, 0x1AU, 0x25U, 0x26U, 0x27U, 0x28U,
+      0x29U, 0x2AU, 0x34U, 0x35U, 0x36U, 0x37U, 0x38U, 0x39U, 0x3AU, 0x43U, 0x44U, 0x45U, 0x46U, 0x47U, 0x48U, 0x49U,
+      0x4AU, 0x53U, 0x54U, 0x55U, 0x56U, 0x57U, 0x58U, 0x59U, 0x5AU, 0x63U, 0x64U, 0x65U, 0x66U, 0x67U, 0x68U, 0x69U,
+      0x6AU, 0x73U, 0x74U, 0x75U, 0x76U, 0x77U, 0x78U, 0x79U, 0x7AU, 0x83U, 0x84U, 0x85U, 0x86U, 0x87U, 0x88U, 0x89U,
+      0x8AU, 0x92U, 0x93U, 0x94U, 0x95U, 0x96U, 0x97U, 0x98U, 0x99U, 0x9AU, 0xA2U, 0xA3U, 0xA4U, 0xA5U, 0xA6U, 0xA7U,
+      0xA8U, 0xA9U, 0xAAU, 0xB2U, 0xB3U, 0xB4U, 0xB5U, 0xB6U, 0xB7U, 0xB8U, 0xB9U, 0xBAU, 0xC2U, 0xC3U, 0xC4U, 0xC5U,
+      0xC6U, 0xC7U, 0xC8U, 0xC9U, 0xCAU, 0xD2U, 0xD3U, 0xD4U, 0xD5U, 0xD6U, 0xD7U, 0xD8U, 0xD9U, 0xDAU, 0xE1U, 0xE2U,
+      0xE3U, 0xE4U, 0xE5U, 0xE6U, 0xE7U, 0xE8U, 0xE9U, 0xEAU, 0xF1U, 0xF2U, 0xF3U, 0xF4U, 0xF5U, 0xF6U, 0xF7U, 0xF8U,
+      0xF9U, 0xFAU}},
+    {{0U, 0U, 2U, 1U, 2U, 4U, 4U, 3U, 4U, 7U, 5U, 4U, 4U, 0U, 1U, 2U, 0x77U},
+     {0x00U, 0x01U, 0x02U, 0x03U, 0x11U, 0x04U, 0x05U, 0x21U, 0x31U, 0x06U, 0x12U, 0x41U, 0x51U, 0x07U, 0x61U, 0x71U,
+      0x13U, 0x22U, 0x32U, 0x81U, 0x08U, 0x14U, 0x42U, 0x91U, 0xA1U, 0xB1U, 0xC1U, 0x09U, 0x23U, 0x33U, 0x52U, 0xF0U,
+      0x15U, 0x62U, 0x72U, 0xD1U, 0x0AU, 0x16U, 0x24U, 0x34U, 0xE1U, 0x25U, 0xF1U, 0x17U, 0x18U, 0x19U, 0x1AU, 0x26U,
+      0x27U, 0x28U, 0x29U, 0x2AU, 0x35U, 0x36U, 0x37U, 0x38U, 0x39U, 0x3AU, 0x43U, 0x44U, 0x45U, 0x46U, 0x47U, 0x48U,
+      0x49U, 0x4AU, 0x53U, 0x54U, 0x55U, 0x56U, 0x57U, 0x58U, 0x59U, 0x5AU, 0x63U, 0x64U, 0x65U, 0x66U, 0x67U, 0x68U,
+      0x69U, 0x6AU, 0x73U, 0x74U, 0x75U, 0x76U, 0x77U, 0x78U, 0x79U, 0x7AU, 0x82U, 0x83U, 0x84U, 0x85U, 0x86U, 0x87U,
+      0x88U, 0x89U, 0x8AU, 0x92U, 0x93U, 0x94U, 0x95U, 0x96U, 0x97U, 0x98U, 0x99U, 0x9AU, 0xA2U, 0xA3U, 0xA4U, 0xA5U,
+      0xA6U, 0xA7U, 0xA8U, 0xA9U, 0xAAU, 0xB2U, 0xB3U, 0xB4U, 0xB5U, 0xB6U, 0xB7U, 0xB8U, 0xB9U, 0xBAU, 0xC2U, 0xC3U,
+      0xC4U, 0xC5U, 0xC6U, 0xC7U, 0xC8U, 0xC9U, 0xCAU, 0xD2U, 0xD3U, 0xD4U, 0xD5U, 0xD6U, 0xD7U, 0xD8U, 0xD9U, 0xDAU,
+      0xE2U, 0xE3U, 0xE4U, 0xE5U, 0xE6U, 0xE7U, 0xE8U, 0xE9U, 0xEAU, 0xF2U, 0xF3U, 0xF4U, 0xF5U, 0xF6U, 0xF7U, 0xF8U,
+      0xF9U, 0xFAU}}
+}};
+
+/// @brief Symbols of a table.
+uint32_t SymbolCount(const std::array<uint8_t, 17>& counts)
+{
+    uint32_t total = 0U;
+    for (uint32_t length = 1U; length <= 16U; length++)
+    {
+        total += counts[length];
+    }
+    return total;
+}
+
+/// @brief DCT basis c(u) / 2 * cos((2x + 1) * u * pi / 16), index u * 8 + x.
+const std::array<float, 64>& Basis()
+{
+    static const std::array<float, 64> basis = []()
+    {
+        std::array<float, 64> table{};
+        for (uint32_t u = 0U; u < 8U; u++)
+        {
+            const double scale = (u == 0U) ? (0.5 / std::sqrt(2.0)) : 0.5;
+            for (uint32_t x = 0U; x < 8U; x++)
+            {
+                const double angle = ((2.0 * x) + 1.0) * u * std::numbers::pi / 16.0;
+                table[(u * 8U) + x] = static_cast<float>(scale * std::cos(angle));
+            }
+        }
+        return table;
+    }();
+    return basis;
+}
+
+/// @brief Bits of a magnitude.
+inline uint32_t BitLength(uint32_t value)
+{
+    uint32_t bits = 0U;
+    while (value != 0U)
+    {
+        bits++;
+        value >>= 1U;
+    }
+    return bits;
+}
+
+/// @brief Sign extension of a received value of s bits (T.81 F.2.2.1).
+inline int32_t Extend(uint32_t value, int32_t bits)
+{
+    return (value < (1U << (bits - 1))) ? (static_cast<int32_t>(value) - (1 << bits) + 1) : static_cast<int32_t>(value);
+}
+
+/// @brief Quality of a luminance table, the estimate of the HAL (inverse of the IJG scaling).
+uint8_t EstimateQuality(const std::array<uint16_t, 64>& quant)
+{
+    uint32_t scale = 0U;
+    for (uint32_t k = 0U; k < 64U; k++)
+    {
+        const uint32_t standard = LUMA_QUANT[ZIGZAG[k]];
+        scale += ((quant[k] * 100U) + (standard / 2U)) / standard;
+    }
+    scale = (scale + 32U) / 64U;
+    const uint32_t quality = (scale <= 100U) ? ((201U - scale) / 2U) : (5000U / scale);
+    return static_cast<uint8_t>(std::clamp(quality, 1U, 100U));
+}
+
+} // end anonymous namespace
+
+
+JpegCodecSoft::JpegCodecSoft()
+{
+    for (uint32_t t = 0U; t < STANDARD_TABLES.size(); t++)
+    {
+        const HuffmanSpec& spec = STANDARD_TABLES[t];
+        HuffmanCode& codes = mCodes[t];
+        uint32_t code = 0U;
+        uint32_t k = 0U;
+        for (uint32_t length = 1U; length <= 16U; length++)
+        {
+            for (uint32_t i = 0U; i < spec.counts[length]; i++)
+            {
+                codes.code[spec.values[k]] = static_cast<uint16_t>(code);
+                codes.size[spec.values[k]] = static_cast<uint8_t>(length);
+                code++;
+                k++;
+            }
+            code <<= 1U;
+        }
+    }
+}
+
+
+Status JpegCodecSoft::StartEncode(const JpegInfo& config, const uint8_t* pInput, uint32_t inLength,
+                                  uint8_t* pOutput, uint32_t outLength)
+{
+    if (mState != State::IDLE)
+    {
+        return Status::BUSY;
+    }
+    if ((config.width == 0U) || (config.height == 0U) || (config.quality == 0U) || (config.quality > 100U)
+        || (pInput == nullptr) || (pOutput == nullptr) || (outLength == 0U))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mInfo = config;
+
+    // IJG scaling of the standard tables
+    const uint32_t scale = (config.quality < 50U) ? (5000U / config.quality) : (200U - (2U * config.quality));
+    for (uint32_t k = 0U; k < 64U; k++)
+    {
+        mQuant[0][k] = static_cast<uint16_t>(std::clamp((LUMA_QUANT[ZIGZAG[k]] * scale + 50U) / 100U, 1U, 255U));
+        mQuant[1][k] = static_cast<uint16_t>(std::clamp((CHROMA_QUANT[ZIGZAG[k]] * scale + 50U) / 100U, 1U, 255U));
+    }
+
+    mMcu = 0U;
+    mEncodeDc.fill(0);
+    mBitBuffer = 0U;
+    mBitCount = 0U;
+    mPendingLen = 0U;
+    mPendingPos = 0U;
+    mpIn = pInput;
+    mInLength = inLength;
+    mReader = Reader{};
+    mpOut = pOutput;
+    mOutLength = outLength;
+    mOutPos = 0U;
+    mState = State::ENCODE_HEADER;
+    return Status::OK;
+}
+
+
+Status JpegCodecSoft::StartDecode(const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput, uint32_t outLength)
+{
+    if (mState != State::IDLE)
+    {
+        return Status::BUSY;
+    }
+    if ((pInput == nullptr) || (pOutput == nullptr) || (outLength < JPEG_BLOCK_SIZE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    mInfo = JpegInfo{};
+    mMcu = 0U;
+    for (HuffmanTable& table : mTables)
+    {
+        table.valid = false;
+    }
+    mComponentCount = 0U;
+    mRestartInterval = 0U;
+    mFrame = false;
+    mStart = false;
+    mSkip = 0U;
+    mCarryLength = 0U;
+    mReader = Reader{};
+    mpIn = pInput;
+    mInLength = inLength;
+    mpOut = pOutput;
+    mOutLength = outLength;
+    mOutPos = 0U;
+    mState = State::DECODE_HEADER;
+    return Status::OK;
+}
+
+
+void JpegCodecSoft::FeedInput(const uint8_t* pInput, uint32_t length)
+{
+    mpIn = pInput;
+    mInLength = length;
+    mReader.inPos = 0U;
+}
+
+
+void JpegCodecSoft::FeedOutput(uint8_t* pOutput, uint32_t length)
+{
+    mpOut = pOutput;
+    mOutLength = length;
+    mOutPos = 0U;
+}
+
+
+void JpegCodecSoft::Abort()
+{
+    mState = State::IDLE;
+    mpIn = nullptr;
+    mInLength = 0U;
+    mpOut = nullptr;
+    mOutLength = 0U;
+}
+
+
+void JpegCodecSoft::Poll()
+{
+    const uint32_t mcuSize = mInfo.McuSize();
+    while (true)
+    {
+        switch (mState)
+        {
+            case State::ENCODE_HEADER:
+                WriteHeader();
+                mState = State::ENCODE_DATA;
+                break;
+
+            case State::ENCODE_DATA:
+                if (!Drain())
+                {
+                    return;
+                }
+                if (mMcu == mInfo.McuCount())
+                {
+                    // pad the last byte with ones
+                    if (mBitCount > 0U)
+                    {
+                        PutBits((1U << (8U - mBitCount)) - 1U, 8U - mBitCount);
+                    }
+                    PutByte(0xFFU);
+                    PutByte(EOI);
+                    mState = State::ENCODE_END;
+                }
+                else if ((mpIn == nullptr) || ((mInLength - mReader.inPos) < mcuSize))
+                {
+                    if (!RequestInput(false))
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    EncodeMcu(&mpIn[mReader.inPos]);
+                    mReader.inPos += mcuSize;
+                    mMcu++;
+                }
+                break;
+
+            case State::ENCODE_END:
+                if (!Drain())
+                {
+                    return;
+                }
+                if (mOutPos > 0U)
+                {
+                    EmitOutput();
+                }
+                Finish(Status::OK);
+                return;
+
+            case State::DECODE_HEADER:
+            {
+                const Status status = ParseHeader();
+                if (status == Status::PENDING)
+                {
+                    if (!RequestInput(true))
+                    {
+                        return;
+                    }
+                }
+                else if (status != Status::OK)
+                {
+                    Finish(status);
+                    return;
+                }
+                else
+                {
+                    mState = State::DECODE_DATA;
+                    if (mpListener != nullptr)
+                    {
+                        mpListener->OnInfo(mInfo);
+                    }
+                }
+                break;
+            }
+
+            case State::DECODE_DATA:
+            {
+                const uint32_t size = mInfo.McuSize();
+                if (mMcu == mInfo.McuCount())
+                {
+                    if (mOutPos > 0U)
+                    {
+                        EmitOutput();
+                    }
+                    Finish(Status::OK);
+                    return;
+                }
+                if (mpOut == nullptr)
+                {
+                    return;
+                }
+                if ((mOutLength - mOutPos) < size)
+                {
+                    if (mOutPos == 0U)
+                    {
+                        Finish(Status::INVALID_PARAM);
+                        return;
+                    }
+                    EmitOutput();
+                    break;
+                }
+                const Reader start = mReader;
+                mStarved = false;
+                mError = false;
+                DecodeMcu(&mpOut[mOutPos]);
+                if (mStarved)
+                {
+                    // retry the MCU with the next chunk
+                    mReader = start;
+                    if (!RequestInput(true))
+                    {
+                        return;
+                    }
+                }
+                else if (mError)
+                {
+                    Finish(Status::FORMAT_ERROR);
+                    return;
+                }
+                else
+                {
+                    mOutPos += size;
+                    mMcu++;
+                }
+                break;
+            }
+
+            default:
+                return;
+        }
+    }
+}
+
+
+void JpegCodecSoft::WriteHeader()
+{
+    const bool gray = (mInfo.subsampling == Subsampling::GRAY);
+    const uint32_t components = gray ? 1U : 3U;
+    const uint32_t tables = gray ? 1U : 2U;
+
+    PutByte(0xFFU);
+    PutByte(SOI);
+
+    PutByte(0xFFU);
+    PutByte(DQT);
+    const uint32_t dqtLength = 2U + (tables * 65U);
+    PutByte(static_cast<uint8_t>(dqtLength >> 8U));
+    PutByte(static_cast<uint8_t>(dqtLength));
+    for (uint32_t t = 0U; t < tables; t++)
+    {
+        PutByte(static_cast<uint8_t>(t));
+        for (uint32_t k = 0U; k < 64U; k++)
+        {
+            PutByte(static_cast<uint8_t>(mQuant[t][k]));
+        }
+    }
+
+    PutByte(0xFFU);
+    PutByte(SOF0);
+    const uint32_t sofLength = 8U + (3U * components);
+    PutByte(static_cast<uint8_t>(sofLength >> 8U));
+    PutByte(static_cast<uint8_t>(sofLength));
+    PutByte(8U);
+    PutByte(static_cast<uint8_t>(mInfo.height >> 8U));
+    PutByte(static_cast<uint8_t>(mInfo.height));
+    PutByte(static_cast<uint8_t>(mInfo.width >> 8U));
+    PutByte(static_cast<uint8_t>(mInfo.width));
+    PutByte(static_cast<uint8_t>(components));
+    for (uint32_t c = 0U; c < components; c++)
+    {
+        const uint8_t sampling = (c > 0U) ? 0x11U : static_cast<uint8_t>(((McuWidth(mInfo.subsampling) / 8U) << 4U)
+                               | (McuHeight(mInfo.subsampling) / 8U));
+        PutByte(static_cast<uint8_t>(c + 1U));
+        PutByte(sampling);
+        PutByte((c > 0U) ? 1U : 0U);
+    }
+
+    // DC 0, DC 1, AC 0, AC 1
+    for (uint32_t t = 0U; t < STANDARD_TABLES.size(); t++)
+    {
+        const bool chroma = ((t & 1U) != 0U);
+        if (gray && chroma)
+        {
+            continue;
+        }
+        const HuffmanSpec& spec = STANDARD_TABLES[t];
+        const uint32_t symbols = SymbolCount(spec.counts);
+        const uint32_t dhtLength = 2U + 17U + symbols;
+        PutByte(0xFFU);
+        PutByte(DHT);
+        PutByte(static_cast<uint8_t>(dhtLength >> 8U));
+        PutByte(static_cast<uint8_t>(dhtLength));
+        PutByte(static_cast<uint8_t>(((t >> 1U) << 4U) | (chroma ? 1U : 0U)));
+        for (uint32_t length = 1U; length <= 16U; length++)
+        {
+            PutByte(spec.counts[length]);
+        }
+        for (uint32_t i = 0U; i < symbols; i++)
+        {
+            PutByte(spec.values[i]);
+        }
+    }
+
+    PutByte(0xFFU);
+    PutByte(SOS);
+    const uint32_t sosLength = 6U + (2U * components);
+    PutByte(static_cast<uint8_t>(sosLength >> 8U));
+    PutByte(static_cast<uint8_t>(sosLength));
+    PutByte(static_cast<uint8_t>(components));
+    for (uint32_t c = 0U; c < components; c++)
+    {
+        PutByte(static_cast<uint8_t>(c + 1U));
+        PutByte((c > 0U) ? 0x11U : 0x00U);
+    }
+    PutByte(0U);
+    PutByte(63U);
+    PutByte(0U);
+}
+
+
+void JpegCodecSoft::EncodeMcu(const uint8_t* pMcu)
+{
+    if (mInfo.subsampling == Subsampling::GRAY)
+    {
+        EncodeBlock(pMcu, 0U, mEncodeDc[0]);
+        return;
+    }
+    const uint32_t lumaBlocks = McuBlocks(mInfo.subsampling) - 2U;
+    for (uint32_t b = 0U; b < lumaBlocks; b++)
+    {
+        EncodeBlock(&pMcu[b * JPEG_BLOCK_SIZE], 0U, mEncodeDc[0]);
+    }
+    EncodeBlock(&pMcu[lumaBlocks * JPEG_BLOCK_SIZE], 1U, mEncodeDc[1]);
+    EncodeBlock(&pMcu[(lumaBlocks + 1U) * JPEG_BLOCK_SIZE], 1U, mEncodeDc[2]);
+}
+
+
+void JpegCodecSoft::EncodeBlock(const uint8_t* pBlock, uint32_t table, int32_t& dc)
+{
+    // separable forward DCT: rows, then columns
+    const std::array<float, 64>& basis = Basis();
+    std::array<float, 64> rows{};
+    for (uint32_t y = 0U; y < 8U; y++)
+    {
+        for (uint32_t u = 0U; u < 8U; u++)
+        {
+            float sum = 0.0F;
+            for (uint32_t x = 0U; x < 8U; x++)
+            {
+                sum += (static_cast<float>(pBlock[(y * 8U) + x]) - 128.0F) * basis[(u * 8U) + x];
+            }
+            rows[(y * 8U) + u] = sum;
+        }
+    }
+    std::array<int32_t, 64> coefficients{};
+    const std::array<uint16_t, 64>& quant = mQuant[table];
+    for (uint32_t k = 0U; k < 64U; k++)
+    {
+        const uint32_t v = ZIGZAG[k] / 8U;
+        const uint32_t u = ZIGZAG[k] % 8U;
+        float sum = 0.0F;
+        for (uint32_t y = 0U; y < 8U; y++)
+        {
+            sum += rows[(y * 8U) + u] * basis[(v * 8U) + y];
+        }
+        coefficients[k] = std::clamp(static_cast<int32_t>(std::lround(sum / static_cast<float>(quant[k]))),
+                                     -1023, 1023);
+    }
+
+    const HuffmanCode& dcCodes = mCodes[table];
+    const HuffmanCode& acCodes = mCodes[table + 2U];
+    const int32_t diff = coefficients[0] - dc;
+    dc = coefficients[0];
+    uint32_t bits = BitLength(static_cast<uint32_t>(std::abs(diff)));
+    PutBits(dcCodes.code[bits], dcCodes.size[bits]);
+    if (bits > 0U)
+    {
+        PutBits(static_cast<uint32_t>((diff < 0) ? (diff - 1) : diff) & ((1U << bits) - 1U), bits);
+    }
+    uint32_t run = 0U;
+    for (uint32_t k = 1U; k < 64U; k++)
+    {
+        const int32_t value = coefficients[k];
+        if (value == 0)
+        {
+            run++;
+            continue;
+        }
+        while (run > 15U)
+        {
+            PutBits(acCodes.code[0xF0U], acCodes.size[0xF0U]);
+            run -= 16U;
+        }
+        bits = BitLength(static_cast<uint32_t>(std::abs(value)));
+        const uint32_t symbol = (run << 4U) | bits;
+        PutBits(acCodes.code[symbol], acCodes.size[symbol]);
+        PutBits(static_cast<uint32_t>((value < 0) ? (value - 1) : value) & ((1U << bits) - 1U), bits);
+        run = 0U;
+    }
+    if (run > 0U)
+    {
+        PutBits(acCodes.code[0x00U], acCodes.size[0x00U]);
+    }
+}
+
+
+void JpegCodecSoft::PutBits(uint32_t code, uint32_t size)
+{
+    mBitBuffer = (mBitBuffer << size) | code;
+    mBitCount += size;
+    while (mBitCount >= 8U)
+    {
+        const uint8_t value = static_cast<uint8_t>(mBitBuffer >> (mBitCount - 8U));
+        mPending[mPendingLen++] = value;
+        if (value == 0xFFU)
+        {
+            mPending[mPendingLen++] = 0x00U;
+        }
+        mBitCount -= 8U;
+    }
+    mBitBuffer &= (1U << mBitCount) - 1U;
+}
+
+
+bool JpegCodecSoft::Drain()
+{
+    while (mPendingPos < mPendingLen)
+    {
+        if (mpOut == nullptr)
+        {
+            return false;
+        }
+        const uint32_t count = std::min(mPendingLen - mPendingPos, mOutLength - mOutPos);
+        std::memcpy(&mpOut[mOutPos], &mPending[mPendingPos], count);
+        mOutPos += count;
+        mPendingPos += count;
+        if (mOutPos == mOutLength)
+        {
+            EmitOutput();
+        }
+    }
+    mPendingLen = 0U;
+    mPendingPos = 0U;
+    return true;
+}
+
+
+Status JpegCodecSoft::ParseHeader()
+{
+    while (true)
+    {
+        if (mSkip > 0U)
+        {
+            const uint32_t count = std::min(mSkip, Available());
+            SkipBytes(count);
+            mSkip -= count;
+            if (mSkip > 0U)
+            {
+                return Status::PENDING;
+            }
+        }
+        if (Available() < 2U)
+        {
+            return Status::PENDING;
+        }
+        if (PeekByte(0U) != 0xFF)
+        {
+            return Status::FORMAT_ERROR;
+        }
+        const uint8_t marker = static_cast<uint8_t>(PeekByte(1U));
+        if (marker == 0xFFU)
+        {
+            // fill byte
+            SkipBytes(1U);
+            continue;
+        }
+        if (marker == SOI)
+        {
+            SkipBytes(2U);
+            mStart = true;
+            continue;
+        }
+        if (!mStart || (marker == EOI))
+        {
+            return Status::FORMAT_ERROR;
+        }
+        if (Available() < 4U)
+        {
+            return Status::PENDING;
+        }
+        const uint32_t length = (static_cast<uint32_t>(PeekByte(2U)) << 8U) | static_cast<uint32_t>(PeekByte(3U));
+        if (length < 2U)
+        {
+            return Status::FORMAT_ERROR;
+        }
+        const bool parsed = (marker == DQT) || (marker == DHT) || (marker == SOF0) || (marker == SOF1)
+                         || (marker == DRI) || (marker == SOS);
+        if (!parsed)
+        {
+            // other frame types (progressive, lossless, arithmetic) are not baseline
+            if ((marker >= 0xC2U) && (marker <= 0xCFU) && (marker != 0xC4U) && (marker != 0xC8U) && (marker != 0xCCU))
+            {
+                return Status::FORMAT_ERROR;
+            }
+            SkipBytes(2U);
+            mSkip = length;
+            continue;
+        }
+        if (Available() < (length + 2U))
+        {
+            // the segment has to fit into the carry buffer to continue it with the next chunk
+            return ((length + 2U) > CARRY_SIZE) ? Status::FORMAT_ERROR : Status::PENDING;
+        }
+        SkipBytes(4U);
+        const Status status = ParseSegment(marker, length - 2U);
+        if ((status != Status::OK) || (marker == SOS))
+        {
+            return status;
+        }
+    }
+}
+
+
+Status JpegCodecSoft::ParseSegment(uint8_t marker, uint32_t length)
+{
+    if (marker == DQT)
+    {
+        while (length >= 65U)
+        {
+            const uint8_t spec = ReadByte();
+            if ((spec >> 4U) != 0U)
+            {
+                return Status::FORMAT_ERROR;
+            }
+            for (uint16_t& value : mQuant[spec & 3U])
+            {
+                value = ReadByte();
+            }
+            length -= 65U;
+        }
+        SkipBytes(length);
+        return (length == 0U) ? Status::OK : Status::FORMAT_ERROR;
+    }
+    if (marker == DHT)
+    {
+        while (length >= 17U)
+        {
+            const uint8_t spec = ReadByte();
+            std::array<uint8_t, 17> counts{};
+            for (uint32_t i = 1U; i <= 16U; i++)
+            {
+                counts[i] = ReadByte();
+            }
+            const uint32_t symbols = SymbolCount(counts);
+            if (((spec >> 4U) > 1U) || ((spec & 0x0FU) > 3U) || (symbols > 256U) || ((17U + symbols) > length))
+            {
+                return Status::FORMAT_ERROR;
+            }
+            HuffmanTable& table = mTables[((spec >> 4U) * 4U) + (spec & 3U)];
+            for (uint32_t i = 0U; i < symbols; i++)
+            {
+                table.values[i] = ReadByte();
+            }
+            BuildTable(counts, table);
+            length -= 17U + symbols;
+        }
+        SkipBytes(length);
+        return (length == 0U) ? Status::OK : Status::FORMAT_ERROR;
+    }
+    if (marker == DRI)
+    {
+        if (length != 2U)
+        {
+            return Status::FORMAT_ERROR;
+        }
+        mRestartInterval = static_cast<uint32_t>(ReadByte()) << 8U;
+        mRestartInterval |= ReadByte();
+        return Status::OK;
+    }
+    if ((marker == SOF0) || (marker == SOF1))
+    {
+        const uint8_t precision = ReadByte();
+        const uint32_t height = (static_cast<uint32_t>(ReadByte()) << 8U) | ReadByte();
+        const uint32_t width = (static_cast<uint32_t>(ReadByte()) << 8U) | ReadByte();
+        const uint32_t components = ReadByte();
+        if ((precision != 8U) || (height == 0U) || (width == 0U) || ((components != 1U) && (components != 3U))
+            || (length != (6U + (3U * components))))
+        {
+            return Status::FORMAT_ERROR;
+        }
+        std::array<uint8_t, 3> sampling{};
+        for (uint32_t c = 0U; c < components; c++)
+        {
+            mComponents[c].id = ReadByte();
+            sampling[c] = ReadByte();
+            mComponents[c].quant = static_cast<uint8_t>(ReadByte() & 3U);
+        }
+        mInfo.width = static_cast<uint16_t>(width);
+        mInfo.height = static_cast<uint16_t>(height);
+        if (components == 1U)
+        {
+            // a single component scan codes single blocks whatever its sampling factors are
+            mInfo.subsampling = Subsampling::GRAY;
+        }
+        else if ((sampling[1] != 0x11U) || (sampling[2] != 0x11U))
+        {
+            return Status::FORMAT_ERROR;
+        }
+        else if (sampling[0] == 0x11U)
+        {
+            mInfo.subsampling = Subsampling::YCBCR_444;
+        }
+        else if (sampling[0] == 0x21U)
+        {
+            mInfo.subsampling = Subsampling::YCBCR_422;
+        }
+        else if (sampling[0] == 0x22U)
+        {
+            mInfo.subsampling = Subsampling::YCBCR_420;
+        }
+        else
+        {
+            return Status::FORMAT_ERROR;
+        }
+        mComponentCount = components;
+        mFrame = true;
+        return Status::OK;
+    }
+
+    // SOS: one interleaved scan with all components
+    const uint32_t components = ReadByte();
+    if (!mFrame || (components != mComponentCount) || (length != (4U + (2U * components))))
+    {
+        return Status::FORMAT_ERROR;
+    }
+    for (uint32_t c = 0U; c < components; c++)
+    {
+        const uint8_t id = ReadByte();
+        const uint8_t tables = ReadByte();
+        if ((id != mComponents[c].id) || ((tables >> 4U) > 3U) || !mTables[tables >> 4U].valid || !mTables[4U + (tables & 3U)].valid)
+        {
+            return Status::FORMAT_ERROR;
+        }
+        mComponents[c].dc = static_cast<uint8_t>(tables >> 4U);
+        mComponents[c].ac = static_cast<uint8_t>(4U + (tables & 3U));
+    }
+    SkipBytes(3U);
+    mInfo.quality = EstimateQuality(mQuant[mComponents[0].quant]);
+    mReader.bits = 0U;
+    mReader.count = 0;
+    mReader.marker = false;
+    mReader.dc.fill(0);
+    mReader.restartLeft = mRestartInterval;
+    return Status::OK;
+}
+
+
+void JpegCodecSoft::DecodeMcu(uint8_t* pMcu)
+{
+    if ((mRestartInterval > 0U) && (mReader.restartLeft == 0U))
+    {
+        // the bits before the marker are padding
+        mReader.bits = 0U;
+        mReader.count = 0;
+        mReader.marker = false;
+        while (PeekByte(0U) == 0xFF && PeekByte(1U) == 0xFF)
+        {
+            SkipBytes(1U);
+        }
+        const int32_t marker = PeekByte(1U);
+        if (marker < 0)
+        {
+            mStarved = true;
+            return;
+        }
+        if ((PeekByte(0U) != 0xFF) || ((marker & 0xF8) != RST0))
+        {
+            mError = true;
+            return;
+        }
+        SkipBytes(2U);
+        mReader.dc.fill(0);
+        mReader.restartLeft = mRestartInterval;
+    }
+    if (mInfo.subsampling == Subsampling::GRAY)
+    {
+        DecodeBlock(mComponents[0], mReader.dc[0], pMcu);
+    }
+    else
+    {
+        const uint32_t lumaBlocks = McuBlocks(mInfo.subsampling) - 2U;
+        for (uint32_t b = 0U; b < lumaBlocks; b++)
+        {
+            DecodeBlock(mComponents[0], mReader.dc[0], &pMcu[b * JPEG_BLOCK_SIZE]);
+        }
+        DecodeBlock(mComponents[1], mReader.dc[1], &pMcu[lumaBlocks * JPEG_BLOCK_SIZE]);
+        DecodeBlock(mComponents[2], mReader.dc[2], &pMcu[(lumaBlocks + 1U) * JPEG_BLOCK_SIZE]);
+    }
+    mReader.restartLeft--;
+}
+
+
+void JpegCodecSoft::DecodeBlock(const Component& component, int32_t& dc, uint8_t* pBlock)
+{
+    const std::array<uint16_t, 64>& quant = mQuant[component.quant];
+    std::array<float, 64> coefficients{};
+    const int32_t bits = DecodeSymbol(mTables[component.dc]);
+    if ((bits < 0) || (bits > 11))
+    {
+        mError = true;
+        return;
+    }
+    if (bits > 0)
+    {
+        dc += Extend(GetBits(bits), bits);
+    }
+    coefficients[0] = static_cast<float>(dc * quant[0]);
+    for (uint32_t k = 1U; k < 64U;)
+    {
+        const int32_t symbol = DecodeSymbol(mTables[component.ac]);
+        if (symbol < 0)
+        {
+            mError = true;
+            return;
+        }
+        const int32_t size = symbol & 0x0F;
+        const uint32_t run = static_cast<uint32_t>(symbol) >> 4U;
+        if (size == 0)
+        {
+            if (run != 15U)
+            {
+                break;
+            }
+            k += 16U;
+            continue;
+        }
+        k += run;
+        if (k > 63U)
+        {
+            mError = true;
+            return;
+        }
+        coefficients[ZIGZAG[k]] = static_cast<float>(Extend(GetBits(size), size) * quant[k]);
+        k++;
+    }
+    if (mStarved || mError)
+    {
+        return;
+    }
+
+    // separable inverse DCT: columns, then rows
+    const std::array<float, 64>& basis = Basis();
+    std::array<float, 64> columns{};
+    for (uint32_t y = 0U; y < 8U; y++)
+    {
+        for (uint32_t u = 0U; u < 8U; u++)
+        {
+            float sum = 0.0F;
+            for (uint32_t v = 0U; v < 8U; v++)
+            {
+                sum += coefficients[(v * 8U) + u] * basis[(v * 8U) + y];
+            }
+            columns[(y * 8U) + u] = sum;
+        }
+    }
+    for (uint32_t y = 0U; y < 8U; y++)
+    {
+        for (uint32_t x = 0U; x < 8U; x++)
+        {
+            float sum = 128.0F;
+            for (uint32_t u = 0U; u < 8U; u++)
+            {
+                sum += columns[(y * 8U) + u] * basis[(u * 8U) + x];
+            }
+            pBlock[(y * 8U) + x] = static_cast<uint8_t>(std::clamp(static_cast<int32_t>(std::lround(sum)), 0, 255));
+        }
+    }
+}
+
+
+int32_t JpegCodecSoft::DecodeSymbol(const HuffmanTable& table)
+{
+    const uint32_t prefix = PeekBits(9);
+    const uint16_t entry = table.lookup[prefix];
+    if (entry != 0U)
+    {
+        SkipBits(static_cast<int32_t>(entry >> 8U));
+        return entry & 0xFF;
+    }
+    int32_t code = static_cast<int32_t>(GetBits(9));
+    for (uint32_t length = 10U; length <= 16U; length++)
+    {
+        code = (code << 1) | static_cast<int32_t>(GetBits(1));
+        if (code <= table.maxCode[length])
+        {
+            return table.values[static_cast<uint32_t>(table.valuePtr[length] + code - table.minCode[length])];
+        }
+    }
+    return -1;
+}
+
+
+uint32_t JpegCodecSoft::PeekBits(int32_t n)
+{
+    Fill();
+    if ((mReader.count < n) && !mReader.marker)
+    {
+        mStarved = true;
+    }
+    return mReader.bits >> (32 - n);
+}
+
+
+void JpegCodecSoft::SkipBits(int32_t n)
+{
+    mReader.bits <<= n;
+    // past a marker the stream continues with zeros
+    mReader.count = std::max(mReader.count - n, 0);
+}
+
+
+uint32_t JpegCodecSoft::GetBits(int32_t n)
+{
+    const uint32_t value = PeekBits(n);
+    SkipBits(n);
+    return value;
+}
+
+
+void JpegCodecSoft::Fill()
+{
+    while ((mReader.count <= 24) && !mReader.marker)
+    {
+        const int32_t value = PeekByte(0U);
+        if (value < 0)
+        {
+            return;
+        }
+        if (value == 0xFF)
+        {
+            const int32_t next = PeekByte(1U);
+            if (next < 0)
+            {
+                return;
+            }
+            if (next != 0x00)
+            {
+                mReader.marker = true;
+                return;
+            }
+            SkipBytes(2U);
+        }
+        else
+        {
+            SkipBytes(1U);
+        }
+        mReader.bits |= static_cast<uint32_t>(value) << (24 - mReader.count);
+        mReader.count += 8;
+    }
+}
+
+
+int32_t JpegCodecSoft::PeekByte(uint32_t offset) const
+{
+    const uint32_t carry = mCarryLength - mReader.carryPos;
+    if (offset < carry)
+    {
+        return mCarry[mReader.carryPos + offset];
+    }
+    offset -= carry;
+    if ((mpIn != nullptr) && ((mReader.inPos + offset) < mInLength))
+    {
+        return mpIn[mReader.inPos + offset];
+    }
+    return -1;
+}
+
+
+void JpegCodecSoft::SkipBytes(uint32_t count)
+{
+    const uint32_t carry = std::min(count, mCarryLength - mReader.carryPos);
+    mReader.carryPos += carry;
+    mReader.inPos += count - carry;
+}
+
+
+uint8_t JpegCodecSoft::ReadByte()
+{
+    const int32_t value = PeekByte(0U);
+    SkipBytes(1U);
+    return static_cast<uint8_t>(value);
+}
+
+
+bool JpegCodecSoft::RequestInput(bool keep)
+{
+    if (keep)
+    {
+        // the unread bytes are less than a segment or an MCU, the next chunk continues behind them
+        const uint32_t carry = mCarryLength - mReader.carryPos;
+        const uint32_t rest = (mpIn != nullptr) ? (mInLength - mReader.inPos) : 0U;
+        if ((carry + rest) > CARRY_SIZE)
+        {
+            Finish(Status::FORMAT_ERROR);
+            return false;
+        }
+        std::memmove(mCarry.data(), &mCarry[mReader.carryPos], carry);
+        if (rest > 0U)
+        {
+            std::memcpy(&mCarry[carry], &mpIn[mReader.inPos], rest);
+        }
+        mCarryLength = carry + rest;
+        mReader.carryPos = 0U;
+    }
+    mpIn = nullptr;
+    mInLength = 0U;
+    mReader.inPos = 0U;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnInputConsumed();
+    }
+    return mpIn != nullptr;
+}
+
+
+void JpegCodecSoft::EmitOutput()
+{
+    uint8_t* pData = mpOut;
+    const uint32_t length = mOutPos;
+    mpOut = nullptr;
+    mOutLength = 0U;
+    mOutPos = 0U;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnOutput(pData, length);
+    }
+}
+
+
+void JpegCodecSoft::Finish(Status status)
+{
+    mState = State::IDLE;
+    mpIn = nullptr;
+    mInLength = 0U;
+    mpOut = nullptr;
+    mOutLength = 0U;
+    if (mpListener != nullptr)
+    {
+        mpListener->OnDone(status);
+    }
+}
+
+
+void JpegCodecSoft::BuildTable(const std::array<uint8_t, 17>& counts, HuffmanTable& table)
+{
+    table.lookup.fill(0U);
+    int32_t code = 0;
+    int32_t k = 0;
+    for (uint32_t length = 1U; length <= 16U; length++)
+    {
+        table.valuePtr[length] = k;
+        table.minCode[length] = code;
+        for (uint32_t i = 0U; i < counts[length]; i++)
+        {
+            if (length <= 9U)
+            {
+                // every 9 bit prefix which starts with the code
+                const uint32_t first = static_cast<uint32_t>(code) << (9U - length);
+                for (uint32_t j = 0U; j < (1U << (9U - length)); j++)
+                {
+                    table.lookup[first + j] = static_cast<uint16_t>((length << 8U) | table.values[k]);
+                }
+            }
+            code++;
+            k++;
+        }
+        table.maxCode[length] = (counts[length] > 0U) ? (code - 1) : -1;
+        code <<= 1;
+    }
+    table.maxCode[17] = 0x7FFFFFFF;
+    table.valid = true;
+}
@@ -0,0 +1,274 @@
+/**
+ ********************************************************************************
+ * @file        JpegCodecSoft.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, software baseline JPEG codec with the IJpegCodec interface.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IJpegCodec.hpp"
+#include <array>
+namespace Video {
+
+
+/**
+ * @brief   This class provides a software baseline JPEG codec with the streaming semantics of the JPEG peripheral.
+ * @details It stands in for JpegCodecHal on the host and takes the same MCUs and chunks, so a service or a test
+ *          sees the same callbacks. The encoder writes SOI, DQT (IJG quality scaling), SOF0, the standard
+ *          Huffman tables (ITU T.81 Annex K), SOS and EOI like the header generator of the peripheral. The
+ *          decoder reads baseline streams (8 bit, gray or YCbCr 4:4:4/4:2:2/4:2:0, restart intervals), which
+ *          covers the output of the peripheral and of libjpeg(-turbo). The DCT is a separable float DCT.\n
+ *          The work is done in @ref Poll. The decoder keeps the unread bytes of an input chunk which ends
+ *          inside an MCU or a marker segment and continues with them when the next chunk arrives, the
+ *          encoder keeps the coded bytes of an MCU until an output buffer takes them.
+ * @note    Slow on the target, it is meant for the host and tests.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * It's in users reponsibility to make sure a clean access in one context.
+ *
+ */
+class JpegCodecSoft : public IJpegCodec
+{
+    public:
+
+        /// @brief Stream bytes kept between two input chunks (the largest marker segment or coded MCU).
+        static constexpr uint32_t CARRY_SIZE{4096U};
+
+        /// @brief Coded bytes which wait for an output buffer (the headers or one MCU).
+        static constexpr uint32_t PENDING_SIZE{4096U};
+
+        /// @brief Constructor.
+        JpegCodecSoft();
+
+        /// @brief Destructor.
+        ~JpegCodecSoft() override = default;
+
+        /// @copydoc IJpegCodec::SetListener
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        /// @copydoc IJpegCodec::StartEncode
+        Status StartEncode(const JpegInfo& config, const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput,
+                           uint32_t outLength) override;
+
+        /// @copydoc IJpegCodec::StartDecode
+        Status StartDecode(const uint8_t* pInput, uint32_t inLength, uint8_t* pOutput, uint32_t outLength) override;
+
+        /// @copydoc IJpegCodec::FeedInput
+        void FeedInput(const uint8_t* pInput, uint32_t length) override;
+
+        /// @copydoc IJpegCodec::FeedOutput
+        void FeedOutput(uint8_t* pOutput, uint32_t length) override;
+
+        /// @copydoc IJpegCodec::Abort
+        void Abort() override;
+
+        /// @brief Code until the image is done or a chunk is missing.
+        void Poll() override;
+
+        /// @brief True if no image is started.
+        bool IsIdle() const {return mState == State::IDLE;};
+
+    private:
+
+        /// @brief Progress of the image.
+        enum class State : uint8_t
+        {
+            IDLE=0,             //!< No image
+            ENCODE_HEADER=1,    //!< Headers not written
+            ENCODE_DATA=2,      //!< Coding MCUs
+            ENCODE_END=3,       //!< EOI written, draining
+            DECODE_HEADER=4,    //!< Parsing marker segments
+            DECODE_DATA=5,      //!< Decoding MCUs
+        };
+
+        /// @brief Code and size per symbol.
+        struct HuffmanCode
+        {
+            std::array<uint16_t, 256> code{};   //!< Code of a symbol
+            std::array<uint8_t, 256> size{};    //!< Bits of the code, 0 if unused
+        };
+
+        /// @brief Canonical decoding table with a 9 bit lookahead.
+        struct HuffmanTable
+        {
+            std::array<uint8_t, 256> values{};      //!< Symbols in code order
+            std::array<int32_t, 18> maxCode{};      //!< Largest code per length, -1 if none
+            std::array<int32_t, 17> minCode{};      //!< Smallest code per length
+            std::array<int32_t, 17> valuePtr{};     //!< Index of the smallest code per length
+            std::array<uint16_t, 512> lookup{};     //!< (length << 8) | symbol of the 9 bit prefixes, 0 if longer
+            bool valid{false};                      //!< Defined by a DHT segment
+        };
+
+        /// @brief A component of the frame header.
+        struct Component
+        {
+            uint8_t id{0U};         //!< Component identifier
+            uint8_t quant{0U};      //!< Quantization table
+            uint8_t dc{0U};         //!< DC Huffman table
+            uint8_t ac{0U};         //!< AC Huffman table
+        };
+
+        /// @brief Position and bit state of the decoder, saved at an MCU start to retry it with more input.
+        struct Reader
+        {
+            uint32_t carryPos{0U};              //!< Next byte in the carry buffer
+            uint32_t inPos{0U};                 //!< Next byte in the input chunk
+            uint32_t bits{0U};                  //!< Bit buffer, MSB first
+            int32_t count{0};                   //!< Valid bits in the buffer
+            bool marker{false};                 //!< A marker stopped the bit buffer, zeros follow
+            std::array<int32_t, 3> dc{};        //!< DC predictors
+            uint32_t restartLeft{0U};           //!< MCUs until the next restart marker
+        };
+
+        /// @brief Write the headers to the pending bytes.
+        void WriteHeader();
+
+        /// @brief Code an MCU to the pending bytes.
+        void EncodeMcu(const uint8_t* pMcu);
+
+        /// @brief Code one block.
+        void EncodeBlock(const uint8_t* pBlock, uint32_t table, int32_t& dc);
+
+        /// @brief Append bits to the pending bytes with byte stuffing.
+        void PutBits(uint32_t code, uint32_t size);
+
+        /// @brief Append a byte without stuffing.
+        void PutByte(uint8_t value) {mPending[mPendingLen++] = value;};
+
+        /// @brief Copy the pending bytes to the output, false if an output buffer is missing.
+        bool Drain();
+
+        /// @brief Parse marker segments up to SOS.
+        Status ParseHeader();
+
+        /// @brief Parse a DQT, DHT, SOF, DRI or SOS segment of a length (without the marker).
+        Status ParseSegment(uint8_t marker, uint32_t length);
+
+        /// @brief Decode an MCU, sets mStarved if the input ends inside.
+        void DecodeMcu(uint8_t* pMcu);
+
+        /// @brief Decode one block.
+        void DecodeBlock(const Component& component, int32_t& dc, uint8_t* pBlock);
+
+        /// @brief Decode a Huffman symbol, -1 on an invalid code.
+        int32_t DecodeSymbol(const HuffmanTable& table);
+
+        /// @brief The next n bits (n <= 16) without consuming.
+        uint32_t PeekBits(int32_t n);
+
+        /// @brief Consume n bits.
+        void SkipBits(int32_t n);
+
+        /// @brief Read n bits (n <= 16).
+        uint32_t GetBits(int32_t n);
+
+        /// @brief Move stream bytes into the bit buffer up to a marker.
+        void Fill();
+
+        /// @brief Stream bytes left in the carry buffer and the input chunk.
+        uint32_t Available() const {return (mCarryLength - mReader.carryPos) + (mInLength - mReader.inPos);};
+
+        /// @brief A stream byte ahead of the position, -1 if not available.
+        int32_t PeekByte(uint32_t offset) const;
+
+        /// @brief Consume stream bytes.
+        void SkipBytes(uint32_t count);
+
+        /// @brief Read a stream byte.
+        uint8_t ReadByte();
+
+        /**
+         * @brief   Ask for the next input chunk.
+         *
+         * @param   keep    Keep the unread bytes for the decoder.
+         *
+         * @return  True if a chunk was fed from inside the callback.
+         */
+        bool RequestInput(bool keep);
+
+        /// @brief Return the output chunk.
+        void EmitOutput();
+
+        /// @brief End the image and report it.
+        void Finish(Status status);
+
+        /// @brief Build the decoding table from the DHT counts and symbols.
+        static void BuildTable(const std::array<uint8_t, 17>& counts, HuffmanTable& table);
+
+        /// @brief Event receiver.
+        IListener* mpListener{nullptr};
+
+        /// @brief Progress of the image.
+        State mState{State::IDLE};
+
+        /// @brief Parameters of the image.
+        JpegInfo mInfo{};
+
+        /// @brief MCUs of the image which are coded.
+        uint32_t mMcu{0U};
+
+        const uint8_t* mpIn{nullptr};           //!< Input chunk
+        uint32_t mInLength{0U};                 //!< Bytes of the input chunk
+        uint8_t* mpOut{nullptr};                //!< Output buffer
+        uint32_t mOutLength{0U};                //!< Bytes of the output buffer
+        uint32_t mOutPos{0U};                   //!< Written bytes of the output buffer
+
+        /// @brief Quantization tables in zigzag order.
+        std::array<std::array<uint16_t, 64>, 4> mQuant{};
+
+        /// @brief Encoder: DC and AC codes of luminance and chrominance.
+        std::array<HuffmanCode, 4> mCodes{};
+
+        /// @brief Encoder: DC predictors.
+        std::array<int32_t, 3> mEncodeDc{};
+
+        uint32_t mBitBuffer{0U};                //!< Encoder: bits not yet written
+        uint32_t mBitCount{0U};                 //!< Encoder: valid bits in mBitBuffer
+
+        /// @brief Encoder: coded bytes which wait for the output.
+        std::array<uint8_t, PENDING_SIZE> mPending{};
+        uint32_t mPendingLen{0U};               //!< Encoder: bytes in mPending
+        uint32_t mPendingPos{0U};               //!< Encoder: bytes of mPending copied to the output
+
+        /// @brief Decoder: DC tables 0..3, AC tables 4..7.
+        std::array<HuffmanTable, 8> mTables{};
+
+        /// @brief Decoder: components of the frame.
+        std::array<Component, 3> mComponents{};
+
+        /// @brief Decoder: components of the frame header.
+        uint32_t mComponentCount{0U};
+
+        /// @brief Decoder: MCUs between restart markers, 0 without.
+        uint32_t mRestartInterval{0U};
+
+        /// @brief Decoder: a frame header was parsed.
+        bool mFrame{false};
+
+        /// @brief Decoder: SOI was found.
+        bool mStart{false};
+
+        /// @brief Decoder: bytes of a segment which is skipped.
+        uint32_t mSkip{0U};
+
+        /// @brief Decoder: position and bit state.
+        Reader mReader{};
+
+        bool mStarved{false};                   //!< Decoder: the input ended inside the MCU
+        bool mError{false};                     //!< Decoder: the MCU is corrupt
+
+        /// @brief Decoder: unread bytes of the previous input chunks.
+        std::array<uint8_t, CARRY_SIZE> mCarry{};
+        uint32_t mCarryLength{0U};              //!< Decoder: bytes in mCarry
+};
+
+} // end namespace Video
@@ -0,0 +1,306 @@
+/**
+ ********************************************************************************
+ * @file        JpegColor.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, color conversion between frames and JPEG MCUs implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "JpegColor.hpp"
+#include <algorithm>
+#include <array>
+
+using namespace Video;
+
+namespace {
+
+/// @brief 16 bit fixed point of a coefficient.
+constexpr int32_t Fix(double value)
+{
+    return static_cast<int32_t>((value * 65536.0) + 0.5);
+}
+
+constexpr int32_t ONE_HALF{1 << 15};
+constexpr int32_t CHROMA_OFFSET{128 << 16};
+
+using Table = std::array<int32_t, 256>;
+
+/// @brief A table of coefficient * i + offset.
+constexpr Table MakeTable(int32_t coefficient, int32_t offset)
+{
+    Table table{};
+    for (int32_t i = 0; i < 256; i++)
+    {
+        table[static_cast<size_t>(i)] = (coefficient * i) + offset;
+    }
+    return table;
+}
+
+/// @brief A table of (coefficient * (i - 128) + offset) >> shift.
+constexpr Table MakeChromaTable(int32_t coefficient, int32_t offset, int32_t shift)
+{
+    Table table{};
+    for (int32_t i = 0; i < 256; i++)
+    {
+        table[static_cast<size_t>(i)] = ((coefficient * (i - 128)) + offset) >> shift;
+    }
+    return table;
+}
+
+// RGB to YCbCr, the rounding is folded into the blue tables
+constexpr Table R_Y{MakeTable(Fix(0.29900), 0)};
+constexpr Table G_Y{MakeTable(Fix(0.58700), 0)};
+constexpr Table B_Y{MakeTable(Fix(0.11400), ONE_HALF)};
+constexpr Table R_CB{MakeTable(-Fix(0.16874), 0)};
+constexpr Table G_CB{MakeTable(-Fix(0.33126), 0)};
+constexpr Table B_CB{MakeTable(Fix(0.50000), CHROMA_OFFSET + ONE_HALF - 1)};    // also R_CR
+constexpr Table G_CR{MakeTable(-Fix(0.41869), 0)};
+constexpr Table B_CR{MakeTable(-Fix(0.08131), 0)};
+
+// YCbCr to RGB, the green terms stay scaled for one common shift
+constexpr Table CR_R{MakeChromaTable(Fix(1.40200), ONE_HALF, 16)};
+constexpr Table CB_B{MakeChromaTable(Fix(1.77200), ONE_HALF, 16)};
+constexpr Table CR_G{MakeChromaTable(-Fix(0.71414), 0, 0)};
+constexpr Table CB_G{MakeChromaTable(-Fix(0.34414), ONE_HALF, 0)};
+
+inline uint8_t Clamp8(int32_t value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+
+/// @brief Read the RGB of a pixel.
+template <PixelFormat FORMAT>
+inline void Load(const uint8_t* p, uint32_t& r, uint32_t& g, uint32_t& b)
+{
+    if constexpr ((FORMAT == PixelFormat::ARGB8888) || (FORMAT == PixelFormat::RGB888))
+    {
+        b = p[0];
+        g = p[1];
+        r = p[2];
+    }
+    else if constexpr (FORMAT == PixelFormat::RGB565)
+    {
+        const uint32_t pixel = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8U);
+        r = ((pixel >> 11U) * 527U + 23U) >> 6U;
+        g = (((pixel >> 5U) & 0x3FU) * 259U + 33U) >> 6U;
+        b = ((pixel & 0x1FU) * 527U + 23U) >> 6U;
+    }
+    else
+    {
+        r = p[0];
+        g = p[0];
+        b = p[0];
+    }
+}
+
+/// @brief Write the RGB of a pixel, L8 takes the luminance.
+template <PixelFormat FORMAT>
+inline void Store(uint8_t* p, uint8_t y, uint8_t r, uint8_t g, uint8_t b)
+{
+    if constexpr (FORMAT == PixelFormat::ARGB8888)
+    {
+        p[0] = b;
+        p[1] = g;
+        p[2] = r;
+        p[3] = 0xFFU;
+    }
+    else if constexpr (FORMAT == PixelFormat::RGB888)
+    {
+        p[0] = b;
+        p[1] = g;
+        p[2] = r;
+    }
+    else if constexpr (FORMAT == PixelFormat::RGB565)
+    {
+        const uint32_t pixel = ((static_cast<uint32_t>(r) >> 3U) << 11U) | ((static_cast<uint32_t>(g) >> 2U) << 5U)
+                             | (static_cast<uint32_t>(b) >> 3U);
+        p[0] = static_cast<uint8_t>(pixel);
+        p[1] = static_cast<uint8_t>(pixel >> 8U);
+    }
+    else
+    {
+        p[0] = y;
+    }
+}
+
+/// @brief Offset of a luminance sample in an MCU, the blocks are ordered left to right, top to bottom.
+inline uint32_t LumaOffset(Subsampling subsampling, uint32_t x, uint32_t y)
+{
+    const uint32_t block = (subsampling == Subsampling::YCBCR_420) ? ((x >> 3U) + ((y >> 3U) << 1U)) : (x >> 3U);
+    return (block * JPEG_BLOCK_SIZE) + ((y & 7U) * 8U) + (x & 7U);
+}
+
+template <PixelFormat FORMAT>
+void ToMcusOf(const Frame& frame, Subsampling subsampling, uint32_t firstMcu, uint32_t count, uint8_t* pMcus)
+{
+    constexpr uint32_t BPP = BytesPerPixel(FORMAT);
+    const uint32_t mcuWidth = McuWidth(subsampling);
+    const uint32_t mcuHeight = McuHeight(subsampling);
+    const JpegInfo info{frame.width, frame.height, subsampling, 0U};
+    const uint32_t perRow = info.McusPerRow();
+    const uint32_t lumaBlocks = McuBlocks(subsampling) - ((subsampling == Subsampling::GRAY) ? 0U : 2U);
+    const uint32_t hShift = (mcuWidth == 16U) ? 1U : 0U;
+    const uint32_t vShift = (mcuHeight == 16U) ? 1U : 0U;
+
+    // RGB of the MCU pixels, the edge pixels are repeated beyond the image
+    std::array<uint8_t, 256> red{};
+    std::array<uint8_t, 256> green{};
+    std::array<uint8_t, 256> blue{};
+    for (uint32_t n = 0U; n < count; n++)
+    {
+        const uint32_t mcu = firstMcu + n;
+        const uint32_t x0 = (mcu % perRow) * mcuWidth;
+        const uint32_t y0 = (mcu / perRow) * mcuHeight;
+        uint8_t* pMcu = &pMcus[n * McuBlocks(subsampling) * JPEG_BLOCK_SIZE];
+        for (uint32_t y = 0U; y < mcuHeight; y++)
+        {
+            const uint8_t* pLine = &frame.pData[std::min(y0 + y, frame.height - 1U) * frame.stride];
+            for (uint32_t x = 0U; x < mcuWidth; x++)
+            {
+                uint32_t r = 0U;
+                uint32_t g = 0U;
+                uint32_t b = 0U;
+                Load<FORMAT>(&pLine[std::min(x0 + x, frame.width - 1U) * BPP], r, g, b);
+                const uint32_t i = (y * mcuWidth) + x;
+                red[i] = static_cast<uint8_t>(r);
+                green[i] = static_cast<uint8_t>(g);
+                blue[i] = static_cast<uint8_t>(b);
+                pMcu[LumaOffset(subsampling, x, y)] = static_cast<uint8_t>((R_Y[r] + G_Y[g] + B_Y[b]) >> 16);
+            }
+        }
+        if (subsampling == Subsampling::GRAY)
+        {
+            continue;
+        }
+
+        // chroma of the averaged RGB of 1, 2 or 4 pixels
+        uint8_t* pCb = &pMcu[lumaBlocks * JPEG_BLOCK_SIZE];
+        uint8_t* pCr = &pCb[JPEG_BLOCK_SIZE];
+        const uint32_t shift = hShift + vShift;
+        const uint32_t round = (1U << shift) >> 1U;
+        for (uint32_t cy = 0U; cy < 8U; cy++)
+        {
+            for (uint32_t cx = 0U; cx < 8U; cx++)
+            {
+                uint32_t r = 0U;
+                uint32_t g = 0U;
+                uint32_t b = 0U;
+                for (uint32_t dy = 0U; dy <= vShift; dy++)
+                {
+                    for (uint32_t dx = 0U; dx <= hShift; dx++)
+                    {
+                        const uint32_t i = ((((cy << vShift) + dy) * mcuWidth) + (cx << hShift)) + dx;
+                        r += red[i];
+                        g += green[i];
+                        b += blue[i];
+                    }
+                }
+                r = (r + round) >> shift;
+                g = (g + round) >> shift;
+                b = (b + round) >> shift;
+                pCb[(cy * 8U) + cx] = static_cast<uint8_t>((R_CB[r] + G_CB[g] + B_CB[b]) >> 16);
+                pCr[(cy * 8U) + cx] = static_cast<uint8_t>((B_CB[r] + G_CR[g] + B_CR[b]) >> 16);
+            }
+        }
+    }
+}
+
+template <PixelFormat FORMAT>
+void FromMcusOf(const uint8_t* pMcus, const JpegInfo& info, uint32_t firstMcu, uint32_t count, const Frame& frame)
+{
+    constexpr uint32_t BPP = BytesPerPixel(FORMAT);
+    const Subsampling subsampling = info.subsampling;
+    const uint32_t mcuWidth = McuWidth(subsampling);
+    const uint32_t mcuHeight = McuHeight(subsampling);
+    const uint32_t perRow = info.McusPerRow();
+    const uint32_t width = std::min<uint32_t>(info.width, frame.width);
+    const uint32_t height = std::min<uint32_t>(info.height, frame.height);
+    const uint32_t chroma = (subsampling == Subsampling::GRAY) ? 0U : ((McuBlocks(subsampling) - 2U) * JPEG_BLOCK_SIZE);
+    const uint32_t hShift = (mcuWidth == 16U) ? 1U : 0U;
+    const uint32_t vShift = (mcuHeight == 16U) ? 1U : 0U;
+
+    for (uint32_t n = 0U; n < count; n++)
+    {
+        const uint32_t mcu = firstMcu + n;
+        const uint32_t x0 = (mcu % perRow) * mcuWidth;
+        const uint32_t y0 = (mcu / perRow) * mcuHeight;
+        if ((x0 >= width) || (y0 >= height))
+        {
+            continue;
+        }
+        const uint8_t* pMcu = &pMcus[n * info.McuSize()];
+        const uint32_t columns = std::min(mcuWidth, width - x0);
+        const uint32_t lines = std::min(mcuHeight, height - y0);
+        for (uint32_t y = 0U; y < lines; y++)
+        {
+            uint8_t* pPixel = &frame.pData[((y0 + y) * frame.stride) + (x0 * BPP)];
+            for (uint32_t x = 0U; x < columns; x++)
+            {
+                const uint8_t luma = pMcu[LumaOffset(subsampling, x, y)];
+                if (subsampling == Subsampling::GRAY)
+                {
+                    Store<FORMAT>(pPixel, luma, luma, luma, luma);
+                }
+                else
+                {
+                    const uint32_t c = chroma + ((y >> vShift) * 8U) + (x >> hShift);
+                    const uint8_t cb = pMcu[c];
+                    const uint8_t cr = pMcu[c + JPEG_BLOCK_SIZE];
+                    const int32_t yy = luma;
+                    Store<FORMAT>(pPixel, luma, Clamp8(yy + CR_R[cr]), Clamp8(yy + ((CB_G[cb] + CR_G[cr]) >> 16)),
+                                  Clamp8(yy + CB_B[cb]));
+                }
+                pPixel += BPP;
+            }
+        }
+    }
+}
+
+} // end anonymous namespace
+
+
+void JpegColor::ToMcus(const Frame& frame, Subsampling subsampling, uint32_t firstMcu, uint32_t count,
+                       uint8_t* pMcus)
+{
+    switch (frame.format)
+    {
+        case PixelFormat::ARGB8888:
+            ToMcusOf<PixelFormat::ARGB8888>(frame, subsampling, firstMcu, count, pMcus);
+            break;
+        case PixelFormat::RGB888:
+            ToMcusOf<PixelFormat::RGB888>(frame, subsampling, firstMcu, count, pMcus);
+            break;
+        case PixelFormat::RGB565:
+            ToMcusOf<PixelFormat::RGB565>(frame, subsampling, firstMcu, count, pMcus);
+            break;
+        default:
+            ToMcusOf<PixelFormat::L8>(frame, subsampling, firstMcu, count, pMcus);
+            break;
+    }
+}
+
+
+void JpegColor::FromMcus(const uint8_t* pMcus, const JpegInfo& info, uint32_t firstMcu, uint32_t count,
+                         const Frame& frame)
+{
+    switch (frame.format)
+    {
+        case PixelFormat::ARGB8888:
+            FromMcusOf<PixelFormat::ARGB8888>(pMcus, info, firstMcu, count, frame);
+            break;
+        case PixelFormat::RGB888:
+            FromMcusOf<PixelFormat::RGB888>(pMcus, info, firstMcu, count, frame);
+            break;
+        case PixelFormat::RGB565:
+            FromMcusOf<PixelFormat::RGB565>(pMcus, info, firstMcu, count, frame);
+            break;
+        default:
+            FromMcusOf<PixelFormat::L8>(pMcus, info, firstMcu, count, frame);
+            break;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ ********************************************************************************
+ * @file        JpegColor.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, table driven color conversion between frames and JPEG MCUs.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "VideoTypes.hpp"
+namespace Video {
+
+
+/**
+ * @brief   This class converts between frames and the YCbCr MCUs of the JPEG codec.
+ * @details The conversion uses the JFIF (BT.601 full range) matrix in 16 bit fixed point with one lookup
+ *          table per matrix coefficient, like the jpeg_utils of the STM32 examples, so a pixel costs table
+ *          loads and adds only. A range of MCUs is converted at a time, which lets the caller convert the
+ *          next chunk while the codec works on the previous one.\n
+ *          The encoder side averages the chroma of 2x1 (4:2:2) or 2x2 (4:2:0) pixels and repeats the
+ *          edge pixels into MCUs which exceed the image. The decoder side repeats the chroma and clips the
+ *          image to the frame.
+ * @note    L8 frames are read as gray and written from the luminance. A GRAY image written to a color
+ *          frame gets R = G = B.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is thread safe (no state).
+ *
+ */
+class JpegColor
+{
+    public:
+
+        /**
+         * @brief   Convert MCUs from a frame.
+         *
+         * @param   frame       The image, its size is the image size.
+         * @param   subsampling Layout of the MCUs.
+         * @param   firstMcu    First MCU (raster order).
+         * @param   count       MCUs.
+         * @param   pMcus       Output, count MCUs.
+         */
+        static void ToMcus(const Frame& frame, Subsampling subsampling, uint32_t firstMcu, uint32_t count,
+                           uint8_t* pMcus);
+
+        /**
+         * @brief   Convert MCUs into a frame.
+         *
+         * @param   pMcus       count MCUs.
+         * @param   info        Size and subsampling of the image.
+         * @param   firstMcu    First MCU (raster order).
+         * @param   count       MCUs.
+         * @param   frame       The destination.
+         */
+        static void FromMcus(const uint8_t* pMcus, const JpegInfo& info, uint32_t firstMcu, uint32_t count,
+                             const Frame& frame);
+};
+
+} // end namespace Video
@@ -0,0 +1,409 @@
+/**
+ ********************************************************************************
+ * @file        JpegService.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, JPEG job pipeline implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "JpegService.hpp"
+#include "JpegColor.hpp"
+#include "CriticalSection.hpp"
+#include <algorithm>
+
+using namespace Video;
+
+namespace {
+
+/// @brief Image parameters of an encode job.
+inline JpegInfo EncodeInfo(const JpegJob& job)
+{
+    return JpegInfo{job.frame.width, job.frame.height, job.subsampling, job.quality};
+}
+
+} // end anonymous namespace
+
+
+JpegService::JpegService(IJpegCodec& codec, const Config& config)
+: mCodec(codec)
+, mConfig(config)
+{
+    mConfig.chunkMcus = std::clamp(mConfig.chunkMcus & ~1U, 2U, MAX_CHUNK_MCUS);
+    mConfig.streamChunk = std::max(mConfig.streamChunk & ~3U, 4U);
+    mCodec.SetListener(this);
+}
+
+
+JpegService::~JpegService()
+{
+    mCodec.SetListener(nullptr);
+}
+
+
+bool JpegService::IsValid(const JpegJob& job)
+{
+    const Frame& frame = job.frame;
+    return (frame.pData != nullptr) && (frame.width > 0U) && (frame.height > 0U)
+        && (frame.stride >= (frame.width * BytesPerPixel(frame.format)))
+        && (job.pStream != nullptr) && (job.streamSize > 0U)
+        && ((job.operation == JpegOperation::DECODE) || ((job.quality > 0U) && (job.quality <= 100U)));
+}
+
+
+Status JpegService::Submit(JpegJob& job)
+{
+    if (!IsValid(job))
+    {
+        return Status::INVALID_PARAM;
+    }
+    job.status = Status::PENDING;
+    job.streamLength = 0U;
+    job.pNext = nullptr;
+    if (mpTail == nullptr)
+    {
+        mpHead = &job;
+    }
+    else
+    {
+        mpTail->pNext = &job;
+    }
+    mpTail = &job;
+    return Status::PENDING;
+}
+
+
+bool JpegService::Service()
+{
+    // the outputs of a finished job were reported before its end
+    const bool done = mDone;
+
+    // decode: convert the filled buffers and give one back to a waiting codec
+    for (uint32_t i = 0U; i < BUFFERS; i++)
+    {
+        Buffer& buffer = mBuffers[i];
+        if (buffer.slot != Slot::FILLED)
+        {
+            continue;
+        }
+        JpegColor::FromMcus(DataOf(i), buffer.pJob->info, buffer.firstMcu, buffer.mcus, buffer.pJob->frame);
+        Utils::CriticalSection lock;
+        buffer.slot = Slot::FREE;
+        if (mOutputWait && (mpActive != nullptr) && (mpActive->operation == JpegOperation::DECODE))
+        {
+            mOutputWait = false;
+            buffer.slot = Slot::CODEC;
+            buffer.pJob = mpActive;
+            mOutputIndex = i;
+            mCodec.FeedOutput(DataOf(i), mConfig.chunkMcus * JPEG_MAX_MCU_SIZE);
+        }
+    }
+
+    if (mpActive != nullptr)
+    {
+        if (done)
+        {
+            Finish(mDoneStatus);
+        }
+        else if (mTruncated)
+        {
+            mCodec.Abort();
+            Finish(Status::FORMAT_ERROR);
+        }
+        else if (mOutputWait && (mpActive->operation == JpegOperation::ENCODE)
+                 && (mpActive->streamLength == mpActive->streamSize))
+        {
+            mCodec.Abort();
+            Finish(Status::NO_SPACE);
+        }
+    }
+
+    if ((mpActive == nullptr) && (mpHead != nullptr))
+    {
+        (void)StartNext();
+    }
+    while (ConvertNext())
+    {
+    }
+    return !IsIdle();
+}
+
+
+bool JpegService::StartNext()
+{
+    JpegJob& job = *mpHead;
+    uint32_t index = BUFFERS;
+    if (job.operation == JpegOperation::ENCODE)
+    {
+        if (mpConvert != &job)
+        {
+            mpConvert = &job;
+            mConvertMcu = 0U;
+        }
+        // the first chunk may have been converted while the previous job ran
+        for (uint32_t pass = 0U; (pass < 2U) && (index == BUFFERS); pass++)
+        {
+            for (uint32_t i = 0U; i < BUFFERS; i++)
+            {
+                if ((mBuffers[i].slot == Slot::READY) && (mBuffers[i].pJob == &job) && (mBuffers[i].firstMcu == 0U))
+                {
+                    index = i;
+                }
+            }
+            if ((index == BUFFERS) && !ConvertNext())
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0U; (i < BUFFERS) && (index == BUFFERS); i++)
+        {
+            if (mBuffers[i].slot == Slot::FREE)
+            {
+                index = i;
+            }
+        }
+    }
+    if (index == BUFFERS)
+    {
+        return false;
+    }
+
+    mpHead = job.pNext;
+    if (mpHead == nullptr)
+    {
+        mpTail = nullptr;
+    }
+    job.pNext = nullptr;
+    mpActive = &job;
+    mDone = false;
+    mInputWait = false;
+    mOutputWait = false;
+    mTruncated = false;
+    job.streamLength = 0U;
+
+    Buffer& buffer = mBuffers[index];
+    buffer.slot = Slot::CODEC;
+    buffer.pJob = &job;
+    const uint32_t stream = std::min(mConfig.streamChunk, job.streamSize);
+    Status status = Status::OK;
+    if (job.operation == JpegOperation::ENCODE)
+    {
+        job.info = EncodeInfo(job);
+        mFeedMcu = buffer.mcus;
+        mInputIndex = index;
+        status = mCodec.StartEncode(job.info, DataOf(index), buffer.mcus * job.info.McuSize(), job.pStream, stream);
+    }
+    else
+    {
+        job.info = JpegInfo{};
+        mOutMcu = 0U;
+        mStreamPos = stream;
+        mOutputIndex = index;
+        status = mCodec.StartDecode(job.pStream, stream, DataOf(index), mConfig.chunkMcus * JPEG_MAX_MCU_SIZE);
+    }
+    if (status != Status::OK)
+    {
+        Finish(status);
+    }
+    return true;
+}
+
+
+bool JpegService::ConvertNext()
+{
+    // the active job chunk by chunk, then the first chunk of the next one
+    JpegJob* pJob = mpConvert;
+    if ((pJob == nullptr) || (mConvertMcu >= EncodeInfo(*pJob).McuCount()))
+    {
+        if ((mpHead == nullptr) || (mpHead == pJob) || (mpHead->operation != JpegOperation::ENCODE))
+        {
+            return false;
+        }
+        pJob = mpHead;
+        mpConvert = pJob;
+        mConvertMcu = 0U;
+    }
+    if ((pJob != mpActive) && (mConvertMcu > 0U))
+    {
+        return false;
+    }
+
+    uint32_t index = BUFFERS;
+    {
+        Utils::CriticalSection lock;
+        for (uint32_t i = 0U; (i < BUFFERS) && (index == BUFFERS); i++)
+        {
+            if (mBuffers[i].slot == Slot::FREE)
+            {
+                index = i;
+                mBuffers[i].slot = Slot::CONVERTING;
+            }
+        }
+    }
+    if (index == BUFFERS)
+    {
+        return false;
+    }
+
+    const JpegInfo info = EncodeInfo(*pJob);
+    Buffer& buffer = mBuffers[index];
+    buffer.pJob = pJob;
+    buffer.firstMcu = mConvertMcu;
+    buffer.mcus = std::min(mConfig.chunkMcus, info.McuCount() - mConvertMcu);
+    JpegColor::ToMcus(pJob->frame, pJob->subsampling, buffer.firstMcu, buffer.mcus, DataOf(index));
+    mConvertMcu += buffer.mcus;
+
+    Utils::CriticalSection lock;
+    buffer.slot = Slot::READY;
+    if (mInputWait && (pJob == mpActive))
+    {
+        (void)FeedNext();
+    }
+    return true;
+}
+
+
+bool JpegService::FeedNext()
+{
+    for (uint32_t i = 0U; i < BUFFERS; i++)
+    {
+        Buffer& buffer = mBuffers[i];
+        if ((buffer.slot == Slot::READY) && (buffer.pJob == mpActive) && (buffer.firstMcu == mFeedMcu))
+        {
+            buffer.slot = Slot::CODEC;
+            mInputIndex = i;
+            mFeedMcu += buffer.mcus;
+            mInputWait = false;
+            mCodec.FeedInput(DataOf(i), buffer.mcus * mpActive->info.McuSize());
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void JpegService::OnInfo(const JpegInfo& info)
+{
+    if (mpActive != nullptr)
+    {
+        mpActive->info = info;
+    }
+}
+
+
+void JpegService::OnInputConsumed()
+{
+    JpegJob* pJob = mpActive;
+    if (pJob == nullptr)
+    {
+        return;
+    }
+    if (pJob->operation == JpegOperation::ENCODE)
+    {
+        mBuffers[mInputIndex].slot = Slot::FREE;
+        if (!FeedNext() && (mFeedMcu < pJob->info.McuCount()))
+        {
+            mInputWait = true;
+            mInputStalls = mInputStalls + 1U;
+        }
+    }
+    else if (mStreamPos < pJob->streamSize)
+    {
+        const uint32_t length = std::min(mConfig.streamChunk, pJob->streamSize - mStreamPos);
+        mCodec.FeedInput(&pJob->pStream[mStreamPos], length);
+        mStreamPos += length;
+    }
+    else
+    {
+        mTruncated = true;
+    }
+}
+
+
+void JpegService::OnOutput(uint8_t* pData, uint32_t length)
+{
+    (void)pData;
+    JpegJob* pJob = mpActive;
+    if (pJob == nullptr)
+    {
+        return;
+    }
+    if (pJob->operation == JpegOperation::ENCODE)
+    {
+        // the stream goes directly into the job buffer
+        pJob->streamLength += length;
+        const uint32_t space = pJob->streamSize - pJob->streamLength;
+        if (space > 0U)
+        {
+            mCodec.FeedOutput(&pJob->pStream[pJob->streamLength], std::min(mConfig.streamChunk, space));
+        }
+        else
+        {
+            mOutputWait = true;
+        }
+        return;
+    }
+
+    Buffer& filled = mBuffers[mOutputIndex];
+    filled.pJob = pJob;
+    filled.firstMcu = mOutMcu;
+    filled.mcus = length / pJob->info.McuSize();
+    mOutMcu += filled.mcus;
+    filled.slot = Slot::FILLED;
+    for (uint32_t i = 0U; i < BUFFERS; i++)
+    {
+        Buffer& buffer = mBuffers[i];
+        if (buffer.slot == Slot::FREE)
+        {
+            buffer.slot = Slot::CODEC;
+            buffer.pJob = pJob;
+            mOutputIndex = i;
+            mCodec.FeedOutput(DataOf(i), mConfig.chunkMcus * JPEG_MAX_MCU_SIZE);
+            return;
+        }
+    }
+    mOutputWait = true;
+    mOutputStalls = mOutputStalls + 1U;
+}
+
+
+void JpegService::OnDone(Status status)
+{
+    mDoneStatus = status;
+    mDone = true;
+}
+
+
+void JpegService::Finish(Status status)
+{
+    JpegJob& job = *mpActive;
+    for (Buffer& buffer : mBuffers)
+    {
+        if ((buffer.pJob == &job) && (buffer.slot != Slot::FREE))
+        {
+            buffer.slot = Slot::FREE;
+        }
+    }
+    if (mpConvert == &job)
+    {
+        mpConvert = nullptr;
+    }
+    mpActive = nullptr;
+    mDone = false;
+    mInputWait = false;
+    mOutputWait = false;
+    mTruncated = false;
+    mCompleted++;
+    job.status = status;
+    if (job.pCallback != nullptr)
+    {
+        job.pCallback(job, job.pContext);
+    }
+}
@@ -0,0 +1,200 @@
+/**
+ ********************************************************************************
+ * @file        JpegService.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, JPEG encode/decode job pipeline in front of a JPEG codec.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "IJpegCodec.hpp"
+#include <array>
+namespace Video {
+
+
+/**
+ * @brief   This class provides a JPEG job queue which streams frames through a codec in MCU chunks.
+ * @details Jobs are linked intrusively into a FIFO. The color conversion (see @ref JpegColor) runs in
+ *          @ref Service on a ring of MCU buffers while the codec works on another one:
+ *          - encode: Service converts the next chunk of the frame, the codec takes the converted chunks
+ *            from its input callback and writes the stream directly into the job buffer,
+ *          - decode: the codec reads the stream directly from the job buffer and fills the MCU buffers,
+ *            Service converts the filled ones into the frame.
+ *
+ *          The codec callbacks only hand over ready buffers, so the peripheral keeps running as long as
+ *          Service keeps up. Frames are pipelined: when the last chunk of an encode job is converted, a
+ *          free buffer takes the first chunk of the next job, which starts right after the previous one
+ *          is done.
+ * @note    The service and its buffers must be located in a DMA accessible RAM (not DTCM).
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * Submit and Service must be called from one context, the codec callbacks may run in an ISR.
+ *
+ */
+class JpegService : private IJpegCodec::IListener
+{
+    public:
+
+        /// @brief MCU buffers.
+        static constexpr uint32_t BUFFERS{3U};
+
+        /// @brief Largest chunk in MCUs.
+        static constexpr uint32_t MAX_CHUNK_MCUS{16U};
+
+        /// @brief Configuration.
+        struct Config
+        {
+            uint32_t chunkMcus;     //!< MCUs per buffer, even and at most MAX_CHUNK_MCUS
+            uint32_t streamChunk;   //!< Bytes of the stream per codec transfer
+        };
+
+        /**
+         * @brief   Constructs the service with the default configuration and binds it to the codec.
+         *
+         * @param   codec       The codec.
+         */
+        explicit JpegService(IJpegCodec& codec) : JpegService(codec, Config{MAX_CHUNK_MCUS, 32768U}) {};
+
+        /**
+         * @brief   Constructs the service and binds it to the codec.
+         *
+         * @param   codec       The codec.
+         * @param   config      Chunk sizes.
+         */
+        JpegService(IJpegCodec& codec, const Config& config);
+
+        /// @brief Destructor, unbinds the codec.
+        ~JpegService();
+
+        JpegService(JpegService const &) = delete;             //!< Copy constructor
+        JpegService& operator=(JpegService const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Validate and queue a job.
+         *
+         * @param   job     The job descriptor, owned by the caller until completion.
+         *
+         * @return  PENDING if queued, INVALID_PARAM if the descriptor was rejected.
+         */
+        Status Submit(JpegJob& job);
+
+        /**
+         * @brief   Check the descriptor of a job.
+         *
+         * @param   job     The job descriptor.
+         *
+         * @return  true if the job can be processed.
+         */
+        static bool IsValid(const JpegJob& job);
+
+        /**
+         * @brief   Convert chunks, finish and start jobs, call it as often as possible.
+         *
+         * @return  True if jobs are queued or running.
+         */
+        bool Service();
+
+        /// @brief True if no job is queued or running.
+        bool IsIdle() const {return (mpHead == nullptr) && (mpActive == nullptr);};
+
+        /// @brief Finished jobs since construction.
+        uint32_t GetCompletedCount() const {return mCompleted;};
+
+        /// @brief Times the codec waited for a converted chunk.
+        uint32_t GetInputStalls() const {return mInputStalls;};
+
+        /// @brief Times the codec waited for a free MCU buffer.
+        uint32_t GetOutputStalls() const {return mOutputStalls;};
+
+    private:
+
+        /// @brief Owner of an MCU buffer.
+        enum class Slot : uint8_t
+        {
+            FREE=0,         //!< Unused
+            CONVERTING=1,   //!< Service converts into it
+            READY=2,        //!< Encode: converted, waits for the codec
+            CODEC=3,        //!< Owned by the codec
+            FILLED=4        //!< Decode: written by the codec, waits for the conversion
+        };
+
+        /// @brief An MCU buffer.
+        struct Buffer
+        {
+            volatile Slot slot{Slot::FREE};     //!< Owner
+            JpegJob* pJob{nullptr};             //!< Job of the MCUs
+            uint32_t firstMcu{0U};              //!< First MCU
+            uint32_t mcus{0U};                  //!< MCUs
+        };
+
+        /// @brief Decoder header, see IJpegCodec::IListener.
+        void OnInfo(const JpegInfo& info) override;
+
+        /// @brief Next input chunk, see IJpegCodec::IListener.
+        void OnInputConsumed() override;
+
+        /// @brief Output chunk complete, see IJpegCodec::IListener.
+        void OnOutput(uint8_t* pData, uint32_t length) override;
+
+        /// @brief Image done, see IJpegCodec::IListener.
+        void OnDone(Status status) override;
+
+        /// @brief Start the head job on the idle codec, false if it needs a buffer first.
+        bool StartNext();
+
+        /// @brief Convert the next encode chunk into a free buffer, false if nothing to do.
+        bool ConvertNext();
+
+        /// @brief Hand the next converted chunk to the codec (in a critical section).
+        bool FeedNext();
+
+        /// @brief Stop the active job and report it.
+        void Finish(Status status);
+
+        /// @brief Start of the data of a buffer.
+        uint8_t* DataOf(uint32_t index) {return &mData[index * MAX_CHUNK_MCUS * JPEG_MAX_MCU_SIZE];};
+
+        /// @brief The codec.
+        IJpegCodec& mCodec;
+
+        /// @brief Chunk sizes.
+        Config mConfig;
+
+        JpegJob* mpHead{nullptr};           //!< First queued job
+        JpegJob* mpTail{nullptr};           //!< Last queued job
+        JpegJob* mpActive{nullptr};         //!< Job on the codec
+
+        /// @brief The MCU buffers.
+        std::array<Buffer, BUFFERS> mBuffers{};
+
+        /// @brief Data of the MCU buffers.
+        alignas(32) std::array<uint8_t, BUFFERS * MAX_CHUNK_MCUS * JPEG_MAX_MCU_SIZE> mData{};
+
+        JpegJob* mpConvert{nullptr};        //!< Encode: job of the next conversion
+        uint32_t mConvertMcu{0U};           //!< Encode: next MCU to convert
+        uint32_t mFeedMcu{0U};              //!< Encode: next MCU for the codec
+        uint32_t mOutMcu{0U};               //!< Decode: first MCU of the next output
+        uint32_t mStreamPos{0U};            //!< Bytes of the stream handed to the codec
+        uint32_t mInputIndex{0U};           //!< Encode: buffer of the codec input
+        uint32_t mOutputIndex{0U};          //!< Decode: buffer of the codec output
+
+        volatile bool mInputWait{false};    //!< The codec waits for input
+        volatile bool mOutputWait{false};   //!< The codec waits for an output buffer
+        volatile bool mTruncated{false};    //!< Decode: the stream ended before the image
+        volatile bool mDone{false};         //!< The codec finished the active job
+        volatile Status mDoneStatus{Status::OK};    //!< Result of the codec
+
+        uint32_t mCompleted{0U};            //!< Finished jobs
+        volatile uint32_t mInputStalls{0U};     //!< Codec waits for input
+        volatile uint32_t mOutputStalls{0U};    //!< Codec waits for output
+};
+
+} // end namespace Video
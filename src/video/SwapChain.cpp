@@ -0,0 +1,252 @@
+/**
+ ********************************************************************************
+ * @file        SwapChain.cpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, double or triple buffered display layer implementation.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#include "SwapChain.hpp"
+#include "CriticalSection.hpp"
+#include <algorithm>
+
+using namespace Video;
+
+
+SwapChain::SwapChain(IDisplay& display, Gfx2D& gfx, uint8_t layer)
+: mDisplay(display)
+, mGfx(gfx)
+, mLayer(layer)
+{
+    mDisplay.SetListener(this);
+}
+
+
+SwapChain::~SwapChain()
+{
+    mDisplay.SetListener(nullptr);
+}
+
+
+Status SwapChain::Start(const LayerConfig& config, uint8_t* const* pBuffers, uint32_t count)
+{
+    if ((pBuffers == nullptr) || (count < 2U) || (count > MAX_BUFFERS) || (mLayer >= IDisplay::LAYERS)
+        || (mOpen != NONE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        if (pBuffers[i] == nullptr)
+        {
+            return Status::INVALID_PARAM;
+        }
+    }
+
+    LayerConfig shown = config;
+    shown.frame.pData = pBuffers[0];
+    shown.enabled = true;
+    const Status status = mDisplay.Configure(mLayer, shown);
+    if (status != Status::OK)
+    {
+        return status;
+    }
+
+    Utils::CriticalSection lock;
+    mConfig = shown;
+    mCount = count;
+    const Rect all{0U, 0U, config.frame.width, config.frame.height};
+    for (uint32_t i = 0U; i < MAX_BUFFERS; i++)
+    {
+        mBuffers[i] = (i < count) ? pBuffers[i] : nullptr;
+        mStates[i] = (i == 0U) ? BufferState::FRONT : BufferState::FREE;
+        mStale[i].Clear();
+        mStale[i].Add(all);
+    }
+    mDamage.Clear();
+    mDamage.Add(all);
+    mNewest = NONE;
+    return mDisplay.Commit();
+}
+
+
+void SwapChain::Invalidate(const Rect& rect)
+{
+    if ((rect.x >= mConfig.frame.width) || (rect.y >= mConfig.frame.height))
+    {
+        return;
+    }
+    Rect clipped = rect;
+    clipped.width = static_cast<uint16_t>(std::min<uint32_t>(rect.width, mConfig.frame.width - rect.x));
+    clipped.height = static_cast<uint16_t>(std::min<uint32_t>(rect.height, mConfig.frame.height - rect.y));
+    mDamage.Add(clipped);
+}
+
+
+Status SwapChain::Begin(Frame& frame)
+{
+    if ((mCount == 0U) || (mOpen != NONE))
+    {
+        return Status::INVALID_PARAM;
+    }
+    uint32_t index = NONE;
+    {
+        Utils::CriticalSection lock;
+        // a swap refused by the display in the interrupt is retried
+        Swap();
+        for (uint32_t i = 0U; i < mCount; i++)
+        {
+            if (mStates[i] == BufferState::FREE)
+            {
+                index = i;
+                mStates[i] = BufferState::RENDERING;
+                break;
+            }
+        }
+    }
+    if (index == NONE)
+    {
+        return Status::BUSY;
+    }
+
+    mCurrent = mDamage;
+    mDamage.Clear();
+    frame = FrameOf(index);
+    if (mNewest != NONE)
+    {
+        // bring the missed regions up to date, the damage is redrawn anyway
+        const Frame newest = FrameOf(mNewest);
+        for (const Rect& rect : mStale[index])
+        {
+            if (!mCurrent.Covers(rect))
+            {
+                while (mGfx.Blit(newest, rect, frame, rect.x, rect.y) == Status::BUSY)
+                {
+                    (void)mGfx.Flush();
+                }
+                mCopied += rect.Area();
+            }
+        }
+        (void)mGfx.Flush();
+    }
+    mStale[index].Clear();
+    for (uint32_t i = 0U; i < mCount; i++)
+    {
+        if (i != index)
+        {
+            mStale[i].Add(mCurrent);
+        }
+    }
+    mNewest = index;
+    mOpen = index;
+    return Status::OK;
+}
+
+
+Status SwapChain::Present()
+{
+    if (mOpen == NONE)
+    {
+        return Status::INVALID_PARAM;
+    }
+    {
+        Utils::CriticalSection lock;
+        mStates[mOpen] = BufferState::SUBMITTED;
+        mOrder[mOpen] = mNextOrder;
+    }
+    const Status status = mGfx.Flush(Rendered, this);
+    if (status != Status::OK)
+    {
+        Utils::CriticalSection lock;
+        mStates[mOpen] = BufferState::RENDERING;
+        return status;
+    }
+    mNextOrder++;
+    mOpen = NONE;
+    return Status::OK;
+}
+
+
+bool SwapChain::IsSwapped() const
+{
+    Utils::CriticalSection lock;
+    return (Oldest(BufferState::SUBMITTED) == NONE) && (Oldest(BufferState::READY) == NONE)
+           && (Oldest(BufferState::PENDING) == NONE);
+}
+
+
+void SwapChain::Rendered(void* pContext)
+{
+    SwapChain* pThis = static_cast<SwapChain*>(pContext);
+    Utils::CriticalSection lock;
+    const uint32_t index = pThis->Oldest(BufferState::SUBMITTED);
+    if (index != NONE)
+    {
+        pThis->mStates[index] = BufferState::READY;
+        pThis->Swap();
+    }
+}
+
+
+void SwapChain::OnReload()
+{
+    Utils::CriticalSection lock;
+    const uint32_t index = Oldest(BufferState::PENDING);
+    if (index == NONE)
+    {
+        return;
+    }
+    for (uint32_t i = 0U; i < mCount; i++)
+    {
+        if (mStates[i] == BufferState::FRONT)
+        {
+            mStates[i] = BufferState::FREE;
+        }
+    }
+    mStates[index] = BufferState::FRONT;
+    mSwaps = mSwaps + 1U;
+    Swap();
+}
+
+
+void SwapChain::Swap()
+{
+    const uint32_t index = Oldest(BufferState::READY);
+    if ((index == NONE) || (Oldest(BufferState::PENDING) != NONE))
+    {
+        return;
+    }
+    mConfig.frame.pData = mBuffers[index];
+    if ((mDisplay.Configure(mLayer, mConfig) == Status::OK) && (mDisplay.Commit() == Status::OK))
+    {
+        mStates[index] = BufferState::PENDING;
+    }
+}
+
+
+uint32_t SwapChain::Oldest(BufferState state) const
+{
+    uint32_t oldest = NONE;
+    for (uint32_t i = 0U; i < mCount; i++)
+    {
+        // the order wraps, compare the distance
+        if ((mStates[i] == state) && ((oldest == NONE) || (static_cast<int32_t>(mOrder[i] - mOrder[oldest]) < 0)))
+        {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+
+Frame SwapChain::FrameOf(uint32_t index) const
+{
+    Frame frame = mConfig.frame;
+    frame.pData = mBuffers[index];
+    return frame;
+}
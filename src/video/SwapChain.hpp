@@ -0,0 +1,182 @@
+/**
+ ********************************************************************************
+ * @file        SwapChain.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, double or triple buffered display layer with dirty rectangles.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include "DirtyRegion.hpp"
+#include "Gfx2D.hpp"
+#include "IDisplay.hpp"
+namespace Video {
+
+
+/**
+ * @brief   This class provides the framebuffers of a display layer, 2 or 3 buffers which are rendered and
+ *          swapped in turn.
+ * @details A frame goes through the buffer states:
+ *          - @ref Begin takes a free buffer. The changes since the last frame (@ref Invalidate) become the
+ *            damage of the frame, which the application redraws. The other pixels of the buffer are brought
+ *            up to date by copying only the regions it missed since it was rendered last, from the newest
+ *            buffer, with the Gfx2D (DMA2D). Regions covered by the damage are not copied.
+ *          - @ref Present flushes the Gfx2D batch. When the batch is done, the buffer address is configured
+ *            in the shadow registers and the reload is committed for the line event in the vertical blanking.
+ *          - At the reload the buffer becomes the front buffer and the previous front buffer is free again.
+ *
+ *          With 2 buffers Begin waits (BUSY) for the swap of the previous frame, with 3 buffers the next
+ *          frame is rendered while the swap is pending. Only the damage is redrawn and the copies are
+ *          limited to the damage of the recent frames, instead of full frames.
+ * @note    Draw into the buffer through the same Gfx2D, the refresh copies are queued in it. Software drawing
+ *          has to wait until the Gfx2D is idle. One swap chain per display, it is the reload listener.
+ *  - - -
+ *
+ * __Thread safety:__
+ * The access to this class is not thread safe.\n
+ * Begin, Present and Invalidate from one context, the swap runs in the Gfx2D and display interrupts.
+ *
+ */
+class SwapChain : private IDisplay::IListener
+{
+    public:
+
+        /// @brief Maximum of buffers.
+        static constexpr uint32_t MAX_BUFFERS{3U};
+
+        /**
+         * @brief   Constructs the swap chain of a layer.
+         *
+         * @param   display     The display controller.
+         * @param   gfx         Graphics queue for the refresh copies.
+         * @param   layer       The display layer.
+         */
+        SwapChain(IDisplay& display, Gfx2D& gfx, uint8_t layer);
+
+        /// @brief Destructor, unbinds the display.
+        ~SwapChain();
+
+        SwapChain(SwapChain const &) = delete;             //!< Copy constructor
+        SwapChain& operator=(SwapChain const &) = delete;  //!< Copy assignment
+
+        /**
+         * @brief   Show the first buffer on the layer and invalidate the whole frame.
+         *
+         * @param   config      The layer, the frame gives size, stride and format of all buffers.
+         * @param   pBuffers    The buffers, they stay valid while the swap chain is used.
+         * @param   count       Count of buffers, 2 or 3.
+         *
+         * @return  OK, INVALID_PARAM.
+         */
+        Status Start(const LayerConfig& config, uint8_t* const* pBuffers, uint32_t count);
+
+        /// @brief Mark a rectangle as changed for the next frame, it's clipped to the frame.
+        void Invalidate(const Rect& rect);
+
+        /// @brief True if the next frame has changes.
+        bool IsDirty() const {return !mDamage.IsEmpty();};
+
+        /**
+         * @brief   Begin a frame.
+         *
+         * @param   frame   Returns the buffer to draw into.
+         *
+         * @return  OK, BUSY if no buffer is free, INVALID_PARAM if not started or a frame is open.
+         */
+        Status Begin(Frame& frame);
+
+        /// @brief The damage of the open frame, the regions to redraw.
+        const DirtyRegion& GetDamage() const {return mCurrent;};
+
+        /**
+         * @brief   Present the open frame, the swap follows when its drawing is done.
+         *
+         * @return  OK, BUSY if the Gfx2D ring is full (try again), INVALID_PARAM if no frame is open.
+         */
+        Status Present();
+
+        /// @brief True if no presented frame waits for its swap.
+        bool IsSwapped() const;
+
+        /// @brief Frames shown since the start.
+        uint32_t GetSwapCount() const {return mSwaps;};
+
+        /// @brief Pixels copied to refresh buffers since the start.
+        uint32_t GetCopiedPixels() const {return mCopied;};
+
+    private:
+
+        /// @brief States of a buffer.
+        enum class BufferState : uint8_t
+        {
+            FREE=0,         //!< Can be rendered
+            RENDERING=1,    //!< The open frame
+            SUBMITTED=2,    //!< Presented, the drawing runs
+            READY=3,        //!< Drawn, waits for the display
+            PENDING=4,      //!< In the shadow registers, waits for the reload
+            FRONT=5         //!< Shown
+        };
+
+        /// @brief No buffer.
+        static constexpr uint32_t NONE{MAX_BUFFERS};
+
+        /// @brief The drawing of the oldest submitted frame is done, called by the Gfx2D.
+        static void Rendered(void* pContext);
+
+        /// @brief Reload done, see IDisplay::IListener.
+        void OnReload() override;
+
+        /// @brief Hand the oldest ready buffer to the display if no swap is pending.
+        void Swap();
+
+        /// @brief Oldest buffer in a state or NONE.
+        uint32_t Oldest(BufferState state) const;
+
+        /// @brief Frame of a buffer.
+        Frame FrameOf(uint32_t index) const;
+
+        /// @brief The display controller.
+        IDisplay& mDisplay;
+
+        /// @brief The graphics queue.
+        Gfx2D& mGfx;
+
+        /// @brief The display layer.
+        uint8_t mLayer;
+
+        /// @brief The layer, frame.pData is the front or pending buffer.
+        LayerConfig mConfig{};
+
+        /// @brief The buffers.
+        std::array<uint8_t*, MAX_BUFFERS> mBuffers{};
+
+        /// @brief Count of buffers, 0 if not started.
+        uint32_t mCount{0U};
+
+        /// @brief State per buffer.
+        std::array<volatile BufferState, MAX_BUFFERS> mStates{};
+
+        /// @brief Presentation order per buffer.
+        std::array<uint32_t, MAX_BUFFERS> mOrder{};
+
+        /// @brief Per buffer the regions which differ from the newest frame.
+        std::array<DirtyRegion, MAX_BUFFERS> mStale{};
+
+        DirtyRegion mDamage{};          //!< Changes for the next frame
+        DirtyRegion mCurrent{};         //!< Damage of the open frame
+
+        uint32_t mOpen{NONE};           //!< Buffer of the open frame
+        uint32_t mNewest{NONE};         //!< Buffer of the newest frame
+        uint32_t mNextOrder{0U};        //!< Next presentation order
+
+        volatile uint32_t mSwaps{0U};   //!< Frames shown
+        uint32_t mCopied{0U};           //!< Pixels copied
+};
+
+} // end namespace Video
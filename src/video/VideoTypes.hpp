@@ -0,0 +1,172 @@
+/**
+ ********************************************************************************
+ * @file        VideoTypes.hpp
+ *
+ * @namespace   Video
+ *
+ * @brief       Video, common types of the image and codec services.
+ *
+ * @author      toberg
+ *
+ * @date        2026/10/19
+********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+namespace Video {
+
+
+/// @brief Result of a video operation or request.
+enum class Status : uint8_t
+{
+    OK=0,             //!< Operation finished successfully
+    BUSY=1,           //!< The engine is in use
+    INVALID_PARAM=2,  //!< Parameter or descriptor is inconsistent
+    HW_ERROR=3,       //!< The peripheral or its DMA reported an error
+    PENDING=4,        //!< Job is queued or running
+    FORMAT_ERROR=5,   //!< The compressed stream is corrupt, truncated or not supported
+    NO_SPACE=6,       //!< The output buffer is too small
+    OVERRUN=7         //!< Data was lost, the frame is incomplete
+};
+
+/// @brief Pixel formats in memory, the names give the bit order of a little endian pixel word (like DMA2D/LTDC).
+enum class PixelFormat : uint8_t
+{
+    ARGB8888=0,     //!< 32 bit, bytes B, G, R, A
+    RGB888=1,       //!< 24 bit, bytes B, G, R
+    RGB565=2,       //!< 16 bit
+    L8=3            //!< 8 bit luminance
+};
+
+/// @brief Bytes of a pixel.
+constexpr uint32_t BytesPerPixel(PixelFormat format)
+{
+    return (format == PixelFormat::ARGB8888) ? 4U : ((format == PixelFormat::RGB888) ? 3U :
+           ((format == PixelFormat::RGB565) ? 2U : 1U));
+}
+
+
+/**
+ * @brief   An image in memory.
+ * @note    For DMA the buffer must be located in a DMA accessible RAM (AXI SRAM or SDRAM, not DTCM).
+ */
+struct Frame
+{
+    uint8_t* pData{nullptr};                    //!< First pixel
+    uint16_t width{0U};                         //!< Pixels per line
+    uint16_t height{0U};                        //!< Lines
+    uint32_t stride{0U};                        //!< Bytes from line to line
+    PixelFormat format{PixelFormat::RGB565};    //!< Pixel format
+};
+
+
+/// @brief Color space and chroma subsampling of a JPEG image.
+enum class Subsampling : uint8_t
+{
+    GRAY=0,         //!< Luminance only, MCU of one 8x8 block
+    YCBCR_444=1,    //!< MCU of 8x8 pixels: Y, Cb, Cr
+    YCBCR_422=2,    //!< MCU of 16x8 pixels: Y0, Y1, Cb, Cr
+    YCBCR_420=3     //!< MCU of 16x16 pixels: Y0..Y3 (left to right, top to bottom), Cb, Cr
+};
+
+/// @brief Bytes of an 8x8 block.
+constexpr uint32_t JPEG_BLOCK_SIZE{64U};
+
+/// @brief Bytes of the largest MCU (4:2:0).
+constexpr uint32_t JPEG_MAX_MCU_SIZE{6U * JPEG_BLOCK_SIZE};
+
+/// @brief Blocks of an MCU.
+constexpr uint32_t McuBlocks(Subsampling subsampling)
+{
+    return (subsampling == Subsampling::GRAY) ? 1U : ((subsampling == Subsampling::YCBCR_444) ? 3U :
+           ((subsampling == Subsampling::YCBCR_422) ? 4U : 6U));
+}
+
+/// @brief Pixels per line of an MCU.
+constexpr uint32_t McuWidth(Subsampling subsampling)
+{
+    return ((subsampling == Subsampling::YCBCR_422) || (subsampling == Subsampling::YCBCR_420)) ? 16U : 8U;
+}
+
+/// @brief Lines of an MCU.
+constexpr uint32_t McuHeight(Subsampling subsampling)
+{
+    return (subsampling == Subsampling::YCBCR_420) ? 16U : 8U;
+}
+
+
+/**
+ * @brief   Parameters of a JPEG image, the encoder configuration and the decoder header information.
+ * @details The same structure as JPEG_ConfTypeDef of the HAL.
+ */
+struct JpegInfo
+{
+    uint16_t width{0U};                                 //!< Pixels per line
+    uint16_t height{0U};                                //!< Lines
+    Subsampling subsampling{Subsampling::YCBCR_420};    //!< Color space and subsampling
+    uint8_t quality{90U};                               //!< Quality 1..100 (IJG scaling of the standard tables)
+
+    /// @brief MCUs per MCU row.
+    constexpr uint32_t McusPerRow() const
+    {
+        return (width + McuWidth(subsampling) - 1U) / McuWidth(subsampling);
+    };
+
+    /// @brief MCUs of the image.
+    constexpr uint32_t McuCount() const
+    {
+        return McusPerRow() * ((height + McuHeight(subsampling) - 1U) / McuHeight(subsampling));
+    };
+
+    /// @brief Bytes of an MCU.
+    constexpr uint32_t McuSize() const
+    {
+        return McuBlocks(subsampling) * JPEG_BLOCK_SIZE;
+    };
+};
+
+/// @brief Kind of a JPEG job.
+enum class JpegOperation : uint8_t
+{
+    ENCODE=0,   //!< Frame to JPEG stream
+    DECODE=1    //!< JPEG stream to frame
+};
+
+
+/**
+ * @brief   Descriptor of one JPEG job.
+ * @details The descriptor, the frame and the stream buffer are owned by the caller and must stay valid
+ *          until the completion callback has been called (or @ref status left PENDING).
+ */
+struct JpegJob
+{
+    /// @brief Completion callback, called from JpegService::Service.
+    using Callback = void (*)(JpegJob& job, void* pContext);
+
+    JpegOperation operation{JpegOperation::ENCODE};    //!< Encode or decode
+
+    /// @brief Encode: the source image. Decode: the destination, the image is clipped to it.
+    Frame frame{};
+
+    Subsampling subsampling{Subsampling::YCBCR_420};    //!< Encode: subsampling of the stream
+    uint8_t quality{90U};                               //!< Encode: quality 1..100
+
+    uint8_t* pStream{nullptr};                  //!< Encode: output buffer. Decode: the JPEG stream
+    uint32_t streamSize{0U};                    //!< Encode: capacity. Decode: length of the stream
+    uint32_t streamLength{0U};                  //!< Encode: returns the length of the stream
+
+    JpegInfo info{};                            //!< Returns the image parameters
+
+    Callback pCallback{nullptr};                //!< Optional completion callback
+    void* pContext{nullptr};                    //!< User context passed to the callback
+
+    /// @brief Result, PENDING while queued or running.
+    volatile Status status{Status::OK};
+
+    /// @brief Intrusive queue link, owned by the service.
+    JpegJob* pNext{nullptr};
+};
+
+} // end namespace Video
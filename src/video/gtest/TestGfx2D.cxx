@@ -0,0 +1,407 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../Gfx2D.hpp"
+#include "../GfxEngineSoft.hpp"
+#include <cstring>
+#include <random>
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Video;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  FillsAndClipsRects
+*   (0)  ConvertsLikeTheDma2d
+*   (0)  BlendsWithTheDma2dFormula
+*   (0)  KernelSetsArePixelIdentical
+*   (0)  ChainsBatchesOnCompletion
+*/
+
+namespace {
+
+/// @brief A frame with its pixel storage, the stride has some padding.
+struct TestFrame
+{
+    std::vector<uint8_t> data;
+    Frame frame;
+
+    TestFrame(uint16_t width, uint16_t height, PixelFormat format, uint16_t padding = 3U)
+    : data(static_cast<size_t>(width + padding) * height * BytesPerPixel(format), 0xEEU)
+    , frame{data.data(), width, height, (width + padding) * BytesPerPixel(format), format}
+    {
+    }
+
+    /// @brief Pixel value (little endian) at a position.
+    uint32_t At(uint32_t x, uint32_t y) const
+    {
+        uint32_t value = 0U;
+        (void)std::memcpy(&value, &data[(y * frame.stride) + (x * BytesPerPixel(frame.format))],
+                          BytesPerPixel(frame.format));
+        return value;
+    }
+
+    /// @brief Set a pixel value (little endian).
+    void Set(uint32_t x, uint32_t y, uint32_t value)
+    {
+        (void)std::memcpy(&data[(y * frame.stride) + (x * BytesPerPixel(frame.format))], &value,
+                          BytesPerPixel(frame.format));
+    }
+};
+
+/// @brief Random pixels, the padding too.
+void Randomize(TestFrame& image, uint32_t seed)
+{
+    std::mt19937 random(seed);
+    for (uint8_t& byte : image.data)
+    {
+        byte = static_cast<uint8_t>(random());
+    }
+}
+
+/// @brief Engine which completes its command on request, like an interrupt.
+class DeferredEngine : public IGfxEngine
+{
+    public:
+        void SetListener(IListener* pListener) override {mpListener = pListener;};
+
+        Status Start(const GfxCommand& command) override
+        {
+            if (mpCommand != nullptr)
+            {
+                return Status::BUSY;
+            }
+            if (command.operation == GfxOperation::BLIT && (command.src.format == PixelFormat::ARGB8888)
+                && (command.dst.format == PixelFormat::RGB888) && mRejectRgb888)
+            {
+                return Status::HW_ERROR;
+            }
+            mpCommand = &command;
+            mStarted++;
+            return Status::OK;
+        }
+
+        /// @brief Run the started command and report it, false if none.
+        bool Complete()
+        {
+            const GfxCommand* pCommand = mpCommand;
+            if (pCommand == nullptr)
+            {
+                return false;
+            }
+            mpCommand = nullptr;
+            const Status status = mSoft.Process(*pCommand);
+            mpListener->OnCommandDone(*pCommand, status);
+            return true;
+        }
+
+        uint32_t mStarted{0U};
+        bool mRejectRgb888{false};
+
+    private:
+        IListener* mpListener{nullptr};
+        const GfxCommand* mpCommand{nullptr};
+        GfxEngineSoft mSoft;
+};
+
+/// @brief Count the flush callbacks.
+void CountFlush(void* pContext)
+{
+    (*static_cast<uint32_t*>(pContext))++;
+}
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(Gfx2D_Test, FillsAndClipsRects)
+{
+    GfxEngineSoft engine;
+    Gfx2D gfx(engine);
+
+    TestFrame argb(40U, 30U, PixelFormat::ARGB8888);
+    TestFrame rgb(40U, 30U, PixelFormat::RGB888);
+    TestFrame rgb565(40U, 30U, PixelFormat::RGB565);
+    for (TestFrame* pImage : {&argb, &rgb, &rgb565})
+    {
+        // the rectangle leaves the frame at the right and bottom
+        ASSERT_EQ(gfx.Fill(pImage->frame, Rect{30U, 25U, 20U, 20U}, 0x80FF8040U), Status::OK);
+    }
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    EXPECT_TRUE(gfx.IsIdle());
+    EXPECT_EQ(gfx.GetCompletedCount(), 3U);
+
+    EXPECT_EQ(argb.At(30U, 25U), 0x80FF8040U);
+    EXPECT_EQ(argb.At(39U, 29U), 0x80FF8040U);
+    EXPECT_EQ(argb.At(29U, 29U), 0xEEEEEEEEU);
+    EXPECT_EQ(argb.At(30U, 24U), 0xEEEEEEEEU);
+    EXPECT_EQ(rgb.At(35U, 27U), 0xFF8040U);
+    // 8 bit truncated to 5/6/5
+    EXPECT_EQ(rgb565.At(39U, 29U), (0x1FU << 11U) | (0x20U << 5U) | 0x08U);
+    // the padding behind the line is untouched
+    EXPECT_EQ(rgb565.data[(29U * rgb565.frame.stride) + 80U], 0xEEU);
+
+    // nothing to draw
+    EXPECT_EQ(gfx.Fill(argb.frame, Rect{40U, 0U, 5U, 5U}, 0U), Status::OK);
+    EXPECT_EQ(gfx.Fill(argb.frame, Rect{0U, 0U, 0U, 5U}, 0U), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    EXPECT_EQ(gfx.GetCompletedCount(), 3U);
+
+    // rejected frames
+    TestFrame l8(8U, 8U, PixelFormat::L8);
+    EXPECT_EQ(gfx.Fill(l8.frame, Rect{0U, 0U, 1U, 1U}, 0U), Status::INVALID_PARAM);
+    Frame odd = rgb565.frame;
+    odd.stride = 81U;
+    EXPECT_EQ(gfx.Fill(odd, Rect{0U, 0U, 1U, 1U}, 0U), Status::INVALID_PARAM);
+    Frame empty{};
+    EXPECT_EQ(gfx.Fill(empty, Rect{0U, 0U, 1U, 1U}, 0U), Status::INVALID_PARAM);
+}
+
+
+TEST(Gfx2D_Test, ConvertsLikeTheDma2d)
+{
+    GfxEngineSoft engine;
+    Gfx2D gfx(engine);
+
+    // RGB565 expands by replicating the upper bits
+    TestFrame rgb565(4U, 1U, PixelFormat::RGB565);
+    rgb565.Set(0U, 0U, 0xFFFFU);
+    rgb565.Set(1U, 0U, 0x0000U);
+    rgb565.Set(2U, 0U, (0x10U << 11U) | (0x21U << 5U) | 0x01U);
+    rgb565.Set(3U, 0U, 0xF800U);
+    TestFrame argb(4U, 1U, PixelFormat::ARGB8888);
+    ASSERT_EQ(gfx.Convert(rgb565.frame, argb.frame), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    EXPECT_EQ(argb.At(0U, 0U), 0xFFFFFFFFU);
+    EXPECT_EQ(argb.At(1U, 0U), 0xFF000000U);
+    EXPECT_EQ(argb.At(2U, 0U), 0xFF848608U);
+    EXPECT_EQ(argb.At(3U, 0U), 0xFFFF0000U);
+
+    // and back without loss
+    TestFrame back(4U, 1U, PixelFormat::RGB565);
+    ASSERT_EQ(gfx.Convert(argb.frame, back.frame), Status::OK);
+    // RGB888 drops the alpha
+    TestFrame rgb(4U, 1U, PixelFormat::RGB888);
+    ASSERT_EQ(gfx.Convert(argb.frame, rgb.frame), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    for (uint32_t x = 0U; x < 4U; x++)
+    {
+        EXPECT_EQ(back.At(x, 0U), rgb565.At(x, 0U));
+        EXPECT_EQ(rgb.At(x, 0U), argb.At(x, 0U) & 0xFFFFFFU);
+    }
+
+    // L8 through the gray ramp and through a palette
+    TestFrame l8(16U, 2U, PixelFormat::L8);
+    for (uint32_t x = 0U; x < 16U; x++)
+    {
+        l8.Set(x, 0U, x * 17U);
+        l8.Set(x, 1U, x);
+    }
+    TestFrame gray(16U, 2U, PixelFormat::ARGB8888);
+    ASSERT_EQ(gfx.Convert(l8.frame, gray.frame), Status::OK);
+    std::vector<uint32_t> palette(256U);
+    for (uint32_t i = 0U; i < 256U; i++)
+    {
+        palette[i] = 0x10000000U * (i & 0xFU) + i;
+    }
+    gfx.SetClut(palette.data());
+    TestFrame colored(16U, 2U, PixelFormat::ARGB8888);
+    ASSERT_EQ(gfx.Convert(l8.frame, colored.frame), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    EXPECT_EQ(gray.At(15U, 0U), 0xFFFFFFFFU);
+    EXPECT_EQ(gray.At(1U, 0U), 0xFF111111U);
+    EXPECT_EQ(colored.At(3U, 1U), 0x30000003U);
+    EXPECT_EQ(colored.At(1U, 0U), 0x10000011U);
+
+    // a blit of the same format copies a sub rectangle
+    TestFrame source(20U, 10U, PixelFormat::ARGB8888);
+    Randomize(source, 1U);
+    TestFrame target(8U, 8U, PixelFormat::ARGB8888);
+    ASSERT_EQ(gfx.Blit(source.frame, Rect{15U, 6U, 10U, 10U}, target.frame, 2U, 3U), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    EXPECT_EQ(target.At(2U, 3U), source.At(15U, 6U));
+    EXPECT_EQ(target.At(6U, 6U), source.At(19U, 9U));
+    EXPECT_EQ(target.At(7U, 6U), 0xEEEEEEEEU);
+    EXPECT_EQ(target.At(2U, 7U), 0xEEEEEEEEU);
+    EXPECT_EQ(target.At(1U, 3U), 0xEEEEEEEEU);
+}
+
+
+TEST(Gfx2D_Test, BlendsWithTheDma2dFormula)
+{
+    GfxEngineSoft engine(GfxEngineSoft::Kernel::SCALAR);
+    Gfx2D gfx(engine);
+
+    TestFrame fg(4U, 1U, PixelFormat::ARGB8888);
+    fg.Set(0U, 0U, 0x80FF0000U);   // half red
+    fg.Set(1U, 0U, 0xFF00FF00U);   // opaque green
+    fg.Set(2U, 0U, 0x00FFFFFFU);   // transparent
+    fg.Set(3U, 0U, 0x80FF0000U);   // half red over a transparent background
+
+    TestFrame bg(4U, 1U, PixelFormat::ARGB8888);
+    bg.Set(0U, 0U, 0xFF0000FFU);
+    bg.Set(1U, 0U, 0xFF0000FFU);
+    bg.Set(2U, 0U, 0xFF0000FFU);
+    bg.Set(3U, 0U, 0x00000000U);
+    ASSERT_EQ(gfx.Blend(fg.frame, Rect{0U, 0U, 4U, 1U}, bg.frame, 0U, 0U), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    // (255 * 128 + 0 * 127) / 255 = 128, (0 * 128 + 255 * 127) / 255 = 127
+    EXPECT_EQ(bg.At(0U, 0U), 0xFF80007FU);
+    EXPECT_EQ(bg.At(1U, 0U), 0xFF00FF00U);
+    EXPECT_EQ(bg.At(2U, 0U), 0xFF0000FFU);
+    // Ao = Af, the color stays unscaled
+    EXPECT_EQ(bg.At(3U, 0U), 0x80FF0000U);
+
+    // the constant alpha combines, an opaque RGB565 background stays opaque
+    TestFrame screen(2U, 1U, PixelFormat::RGB565);
+    screen.Set(0U, 0U, 0x0000U);
+    screen.Set(1U, 0U, 0xFFFFU);
+    TestFrame white(2U, 1U, PixelFormat::RGB888);
+    white.Set(0U, 0U, 0xFFFFFFU);
+    white.Set(1U, 0U, 0x000000U);
+    ASSERT_EQ(gfx.Blend(white.frame, Rect{0U, 0U, 2U, 1U}, screen.frame, 0U, 0U, 64U), Status::OK);
+    // alpha 0 draws nothing
+    ASSERT_EQ(gfx.Blend(white.frame, Rect{0U, 0U, 2U, 1U}, screen.frame, 0U, 0U, 0U), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    // 255 * 64 / 255 = 64 -> 0x40 -> 5 bit 8, 6 bit 16
+    EXPECT_EQ(screen.At(0U, 0U), (8U << 11U) | (16U << 5U) | 8U);
+    // 255 * 191 / 255 = 191 -> 0xBF
+    EXPECT_EQ(screen.At(1U, 0U), (0x17U << 11U) | (0x2FU << 5U) | 0x17U);
+    EXPECT_EQ(gfx.GetCompletedCount(), 2U);
+}
+
+
+TEST(Gfx2D_Test, KernelSetsArePixelIdentical)
+{
+    const PixelFormat sources[] = {PixelFormat::ARGB8888, PixelFormat::RGB888, PixelFormat::RGB565, PixelFormat::L8};
+    const PixelFormat targets[] = {PixelFormat::ARGB8888, PixelFormat::RGB888, PixelFormat::RGB565};
+    const GfxEngineSoft::Kernel kernels[] = {GfxEngineSoft::Kernel::SSE41, GfxEngineSoft::Kernel::AVX2};
+    std::vector<uint32_t> palette(256U);
+    std::mt19937 random(7U);
+    for (uint32_t& entry : palette)
+    {
+        entry = random();
+    }
+
+    GfxEngineSoft reference(GfxEngineSoft::Kernel::SCALAR);
+    Gfx2D referenceGfx(reference);
+    referenceGfx.SetClut(palette.data());
+    for (const GfxEngineSoft::Kernel kernel : kernels)
+    {
+        GfxEngineSoft engine(kernel);
+        Gfx2D gfx(engine);
+        gfx.SetClut(palette.data());
+        for (const PixelFormat source : sources)
+        {
+            for (const PixelFormat target : targets)
+            {
+                // odd widths leave tails for the scalar code, more than a chunk per line
+                TestFrame src(301U, 7U, source);
+                Randomize(src, 11U);
+                TestFrame expected(299U, 9U, target);
+                Randomize(expected, 12U);
+                TestFrame actual(299U, 9U, target);
+                actual.data = expected.data;
+                actual.frame.pData = actual.data.data();
+
+                const Rect rect{1U, 0U, 300U, 7U};
+                ASSERT_EQ(referenceGfx.Blend(src.frame, rect, expected.frame, 3U, 1U, 200U), Status::OK);
+                ASSERT_EQ(referenceGfx.Blit(src.frame, Rect{5U, 2U, 17U, 3U}, expected.frame, 250U, 5U), Status::OK);
+                ASSERT_EQ(referenceGfx.Blend(src.frame, Rect{0U, 0U, 64U, 7U}, expected.frame, 100U, 2U), Status::OK);
+                ASSERT_EQ(referenceGfx.Flush(), Status::OK);
+                ASSERT_EQ(gfx.Blend(src.frame, rect, actual.frame, 3U, 1U, 200U), Status::OK);
+                ASSERT_EQ(gfx.Blit(src.frame, Rect{5U, 2U, 17U, 3U}, actual.frame, 250U, 5U), Status::OK);
+                ASSERT_EQ(gfx.Blend(src.frame, Rect{0U, 0U, 64U, 7U}, actual.frame, 100U, 2U), Status::OK);
+                ASSERT_EQ(gfx.Flush(), Status::OK);
+                EXPECT_EQ(actual.data, expected.data) << static_cast<int>(engine.GetKernel()) << ": "
+                                                      << static_cast<int>(source) << " -> " << static_cast<int>(target);
+            }
+        }
+    }
+}
+
+
+TEST(Gfx2D_Test, ChainsBatchesOnCompletion)
+{
+    DeferredEngine engine;
+    Gfx2D gfx(engine);
+    TestFrame screen(32U, 32U, PixelFormat::RGB565);
+    uint32_t flushes = 0U;
+
+    // recording doesn't start the engine
+    for (uint16_t i = 0U; i < 4U; i++)
+    {
+        ASSERT_EQ(gfx.Fill(screen.frame, Rect{0U, static_cast<uint16_t>(8U * i), 32U, 8U}, 0xFF000000U | i), Status::OK);
+    }
+    EXPECT_EQ(engine.mStarted, 0U);
+    EXPECT_FALSE(gfx.IsIdle());
+
+    // the flush starts the first command, each completion the next one
+    ASSERT_EQ(gfx.Flush(CountFlush, &flushes), Status::OK);
+    EXPECT_EQ(engine.mStarted, 1U);
+    ASSERT_TRUE(engine.Complete());
+    EXPECT_EQ(engine.mStarted, 2U);
+
+    // the next batch is recorded while the first runs
+    TestFrame argb(32U, 32U, PixelFormat::ARGB8888);
+    ASSERT_EQ(gfx.Convert(screen.frame, argb.frame), Status::OK);
+    ASSERT_EQ(gfx.Flush(CountFlush, &flushes), Status::OK);
+    EXPECT_EQ(engine.mStarted, 2U);
+    for (uint32_t i = 0U; i < 3U; i++)
+    {
+        ASSERT_TRUE(engine.Complete());
+    }
+    EXPECT_EQ(flushes, 1U);
+    ASSERT_TRUE(engine.Complete());
+    EXPECT_FALSE(engine.Complete());
+    EXPECT_EQ(flushes, 2U);
+    EXPECT_TRUE(gfx.IsIdle());
+    EXPECT_EQ(argb.At(0U, 31U), 0xFF000000U);
+    EXPECT_EQ(gfx.GetCompletedCount(), 5U);
+
+    // a flush callback without commands follows the running ones
+    ASSERT_EQ(gfx.Fill(screen.frame, Rect{0U, 0U, 1U, 1U}, 0U), Status::OK);
+    ASSERT_EQ(gfx.Flush(), Status::OK);
+    ASSERT_EQ(gfx.Flush(CountFlush, &flushes), Status::OK);
+    EXPECT_EQ(flushes, 2U);
+    ASSERT_TRUE(engine.Complete());
+    EXPECT_EQ(flushes, 3U);
+    ASSERT_EQ(gfx.Flush(CountFlush, &flushes), Status::OK);
+    EXPECT_EQ(flushes, 4U);
+
+    // a full ring refuses, a rejected command counts as error and the chain goes on
+    for (uint32_t i = 0U; i < Gfx2D::QUEUE_SIZE; i++)
+    {
+        ASSERT_EQ(gfx.Fill(screen.frame, Rect{0U, 0U, 1U, 1U}, 0U), Status::OK);
+    }
+    EXPECT_EQ(gfx.Fill(screen.frame, Rect{0U, 0U, 1U, 1U}, 0U), Status::BUSY);
+    EXPECT_EQ(gfx.Flush(), Status::OK);
+    while (engine.Complete())
+    {
+    }
+    engine.mRejectRgb888 = true;
+    TestFrame rgb(32U, 32U, PixelFormat::RGB888);
+    ASSERT_EQ(gfx.Convert(argb.frame, rgb.frame), Status::OK);
+    ASSERT_EQ(gfx.Fill(rgb.frame, Rect{0U, 0U, 32U, 32U}, 0U), Status::OK);
+    ASSERT_EQ(gfx.Flush(CountFlush, &flushes), Status::OK);
+    EXPECT_EQ(gfx.GetErrorCount(), 1U);
+    ASSERT_TRUE(engine.Complete());
+    EXPECT_EQ(flushes, 5U);
+    EXPECT_TRUE(gfx.IsIdle());
+    EXPECT_EQ(gfx.GetCompletedCount(), 6U + Gfx2D::QUEUE_SIZE + 2U);
+}
+
+} // end namespace GTest
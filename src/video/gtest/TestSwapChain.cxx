@@ -0,0 +1,398 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "../SwapChain.hpp"
+#include "../DisplaySim.hpp"
+#include "../GfxEngineSoft.hpp"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using ::testing::_; // NOSONAR gtest wild card parameter
+using namespace Video;
+
+namespace GTest {
+
+
+/**
+*   TestList
+*   ========
+*
+*   Explanation
+*   -----------
+*   (0) Done.\n
+*   (1) Masked by code inspection, no test necessary.\n
+*   (2) Operation deleted, no test necessary.\n
+*   (3) Disabled because th test has been failed. To-do: find and fix the bug.\n
+*-----------------------------------------------------------------------------------------
+*   (0)  DirtyRegionMergesRects
+*   (0)  SwapsOnTheLineEvent
+*   (0)  TripleBufferingRendersAhead
+*   (0)  CopiesOnlyStaleRegions
+*   (0)  DumpsPngOfThePanel
+*/
+
+namespace {
+
+/// @brief Panel size.
+constexpr uint16_t WIDTH{64U};
+constexpr uint16_t HEIGHT{48U};
+
+/// @brief RGB565 framebuffers and the scene the application renders from.
+struct Buffers
+{
+    std::vector<std::vector<uint8_t>> pixels;
+    std::vector<uint8_t*> pointers;
+    std::vector<uint8_t> scenePixels;
+    Frame scene;
+    LayerConfig config;
+
+    explicit Buffers(uint32_t count)
+    : pixels(count, std::vector<uint8_t>(WIDTH * HEIGHT * 2U, 0xEEU))
+    , scenePixels(WIDTH * HEIGHT * 2U, 0U)
+    , scene{scenePixels.data(), WIDTH, HEIGHT, WIDTH * 2U, PixelFormat::RGB565}
+    {
+        for (std::vector<uint8_t>& buffer : pixels)
+        {
+            pointers.push_back(buffer.data());
+        }
+        config.frame = Frame{nullptr, WIDTH, HEIGHT, WIDTH * 2U, PixelFormat::RGB565};
+    }
+};
+
+/// @brief Render the damage of the open frame from the scene.
+void Render(Gfx2D& gfx, const SwapChain& chain, const Frame& scene, const Frame& frame)
+{
+    for (const Rect& rect : chain.GetDamage())
+    {
+        ASSERT_EQ(gfx.Blit(scene, rect, frame, rect.x, rect.y), Status::OK);
+    }
+}
+
+/// @brief True if the panel shows the scene.
+bool ShowsScene(DisplaySim& display, const Frame& scene)
+{
+    const Frame& panel = display.Scanout();
+    std::vector<uint32_t> expected(WIDTH * HEIGHT);
+    GfxEngineSoft engine;
+    GfxCommand command{};
+    command.operation = GfxOperation::BLIT;
+    command.src = scene;
+    command.dst = Frame{reinterpret_cast<uint8_t*>(expected.data()), WIDTH, HEIGHT, WIDTH * 4U, PixelFormat::ARGB8888};
+    (void)engine.Process(command);
+    return std::memcmp(expected.data(), panel.pData, expected.size() * 4U) == 0;
+}
+
+/// @brief Big endian word.
+uint32_t Word(const std::vector<uint8_t>& data, size_t offset)
+{
+    return (static_cast<uint32_t>(data[offset]) << 24U) | (static_cast<uint32_t>(data[offset + 1U]) << 16U)
+           | (static_cast<uint32_t>(data[offset + 2U]) << 8U) | data[offset + 3U];
+}
+
+/// @brief CRC-32 (IEEE) bitwise.
+uint32_t Crc32(const uint8_t* pData, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+    for (size_t i = 0U; i < length; i++)
+    {
+        crc ^= pData[i];
+        for (uint32_t bit = 0U; bit < 8U; bit++)
+        {
+            crc = ((crc & 1U) != 0U) ? (0xEDB88320U ^ (crc >> 1U)) : (crc >> 1U);
+        }
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+} // end anonymous namespace
+
+//################################### Tests start here #######################################
+
+
+TEST(SwapChain_Test, DirtyRegionMergesRects)
+{
+    DirtyRegion region;
+    region.Add(Rect{10U, 10U, 20U, 10U});
+    region.Add(Rect{12U, 12U, 5U, 5U});         // inside
+    region.Add(Rect{0U, 0U, 0U, 5U});           // empty
+    EXPECT_EQ(region.GetCount(), 1U);
+    EXPECT_TRUE(region.Covers(Rect{10U, 10U, 20U, 10U}));
+
+    // adjacent below, the bounding box adds no pixels
+    region.Add(Rect{10U, 20U, 20U, 5U});
+    ASSERT_EQ(region.GetCount(), 1U);
+    EXPECT_EQ(region.GetArea(), 300U);
+
+    // far apart stays separate, a covering rectangle absorbs both
+    region.Add(Rect{50U, 40U, 4U, 4U});
+    EXPECT_EQ(region.GetCount(), 2U);
+    region.Add(Rect{0U, 0U, 60U, 48U});
+    ASSERT_EQ(region.GetCount(), 1U);
+    EXPECT_EQ(region.GetArea(), 60U * 48U);
+
+    // overflow merges, the region never loses pixels
+    region.Clear();
+    EXPECT_TRUE(region.IsEmpty());
+    std::vector<Rect> added;
+    for (uint16_t i = 0U; i < 20U; i++)
+    {
+        const Rect rect{static_cast<uint16_t>((i * 37U) % 200U), static_cast<uint16_t>((i * 53U) % 150U), 6U, 4U};
+        region.Add(rect);
+        added.push_back(rect);
+        EXPECT_LE(region.GetCount(), DirtyRegion::MAX_RECTS);
+    }
+    for (const Rect& rect : added)
+    {
+        EXPECT_TRUE(region.Covers(rect));
+    }
+}
+
+
+TEST(SwapChain_Test, SwapsOnTheLineEvent)
+{
+    DisplaySim display(WIDTH, HEIGHT);
+    GfxEngineSoft engine;
+    Gfx2D gfx(engine);
+    SwapChain chain(display, gfx, 0U);
+    Buffers buffers(2U);
+    Frame frame{};
+
+    EXPECT_EQ(chain.Begin(frame), Status::INVALID_PARAM);
+    EXPECT_EQ(chain.Start(buffers.config, buffers.pointers.data(), 1U), Status::INVALID_PARAM);
+    ASSERT_EQ(chain.Start(buffers.config, buffers.pointers.data(), 2U), Status::OK);
+    EXPECT_TRUE(display.LineEvent());
+    EXPECT_EQ(display.GetLayer(0U).frame.pData, buffers.pointers[0]);
+    EXPECT_TRUE(chain.IsDirty());
+
+    // the first frame redraws everything into the back buffer
+    ASSERT_EQ(chain.Begin(frame), Status::OK);
+    EXPECT_EQ(frame.pData, buffers.pointers[1]);
+    EXPECT_EQ(chain.GetDamage().GetArea(), static_cast<uint32_t>(WIDTH) * HEIGHT);
+    EXPECT_EQ(chain.Begin(frame), Status::INVALID_PARAM);
+    ASSERT_EQ(gfx.Fill(frame, Rect{0U, 0U, WIDTH, HEIGHT}, 0xFF00FF00U), Status::OK);
+    ASSERT_EQ(chain.Present(), Status::OK);
+    EXPECT_EQ(chain.Present(), Status::INVALID_PARAM);
+
+    // the drawing is done, the address waits in the shadow registers for the line event
+    EXPECT_FALSE(chain.IsSwapped());
+    EXPECT_EQ(display.GetLayer(0U).frame.pData, buffers.pointers[0]);
+    EXPECT_EQ(chain.Begin(frame), Status::BUSY);
+    EXPECT_TRUE(display.LineEvent());
+    EXPECT_TRUE(chain.IsSwapped());
+    EXPECT_EQ(display.GetLayer(0U).frame.pData, buffers.pointers[1]);
+    EXPECT_EQ(chain.GetSwapCount(), 1U);
+    EXPECT_EQ(display.Scanout().pData[0], 0x00U);
+    EXPECT_EQ(display.Scanout().pData[1], 0xFFU);
+
+    // no new changes: the old front buffer only gets the missed frame copied
+    EXPECT_FALSE(chain.IsDirty());
+    ASSERT_EQ(chain.Begin(frame), Status::OK);
+    EXPECT_EQ(frame.pData, buffers.pointers[0]);
+    EXPECT_TRUE(chain.GetDamage().IsEmpty());
+    EXPECT_EQ(chain.GetCopiedPixels(), static_cast<uint32_t>(WIDTH) * HEIGHT);
+    EXPECT_EQ(buffers.pixels[0], buffers.pixels[1]);
+    ASSERT_EQ(chain.Present(), Status::OK);
+    EXPECT_TRUE(display.LineEvent());
+    EXPECT_FALSE(display.LineEvent());
+    EXPECT_EQ(chain.GetSwapCount(), 2U);
+}
+
+
+TEST(SwapChain_Test, TripleBufferingRendersAhead)
+{
+    DisplaySim display(WIDTH, HEIGHT);
+    GfxEngineSoft engine;
+    Gfx2D gfx(engine);
+    SwapChain chain(display, gfx, 1U);
+    Buffers buffers(3U);
+    Frame frame{};
+    ASSERT_EQ(chain.Start(buffers.config, buffers.pointers.data(), 3U), Status::OK);
+    ASSERT_TRUE(display.LineEvent());
+
+    // two frames without a line event
+    ASSERT_EQ(chain.Begin(frame), Status::OK);
+    EXPECT_EQ(frame.pData, buffers.pointers[1]);
+    ASSERT_EQ(chain.Present(), Status::OK);
+    chain.Invalidate(Rect{60U, 40U, 10U, 10U});
+    ASSERT_EQ(chain.Begin(frame), Status::OK);
+    EXPECT_EQ(frame.pData, buffers.pointers[2]);
+    EXPECT_EQ(chain.GetDamage().GetArea(), 4U * 8U);
+    ASSERT_EQ(chain.Present(), Status::OK);
+    EXPECT_EQ(chain.Begin(frame), Status::BUSY);
+
+    // the frames are shown in order, one per line event
+    ASSERT_TRUE(display.LineEvent());
+    EXPECT_EQ(display.GetLayer(1U).frame.pData, buffers.pointers[1]);
+    EXPECT_FALSE(chain.IsSwapped());
+    ASSERT_TRUE(display.LineEvent());
+    EXPECT_EQ(display.GetLayer(1U).frame.pData, buffers.pointers[2]);
+    EXPECT_TRUE(chain.IsSwapped());
+    EXPECT_EQ(chain.GetSwapCount(), 2U);
+    EXPECT_EQ(display.GetReloadCount(), 3U);
+
+    // the first front buffer is free again
+    ASSERT_EQ(chain.Begin(frame), Status::OK);
+    EXPECT_EQ(frame.pData, buffers.pointers[0]);
+    ASSERT_EQ(chain.Present(), Status::OK);
+    ASSERT_TRUE(display.LineEvent());
+    EXPECT_EQ(display.GetLayer(1U).frame.pData, buffers.pointers[0]);
+}
+
+
+TEST(SwapChain_Test, CopiesOnlyStaleRegions)
+{
+    for (uint32_t count = 2U; count <= SwapChain::MAX_BUFFERS; count++)
+    {
+        DisplaySim display(WIDTH, HEIGHT, 0x123456U);
+        GfxEngineSoft engine;
+        Gfx2D gfx(engine);
+        SwapChain chain(display, gfx, 0U);
+        Buffers buffers(count);
+        std::mt19937 random(count);
+        ASSERT_EQ(chain.Start(buffers.config, buffers.pointers.data(), count), Status::OK);
+        ASSERT_TRUE(display.LineEvent());
+        ASSERT_EQ(gfx.Fill(buffers.scene, Rect{0U, 0U, WIDTH, HEIGHT}, 0xFF204080U), Status::OK);
+
+        const uint32_t FRAMES = 40U;
+        uint32_t damaged = 0U;
+        for (uint32_t n = 0U; n < FRAMES; n++)
+        {
+            // the scene changes in a few small rectangles
+            const uint32_t changes = 1U + (random() % 3U);
+            for (uint32_t i = 0U; i < changes; i++)
+            {
+                const Rect rect{static_cast<uint16_t>(random() % WIDTH), static_cast<uint16_t>(random() % HEIGHT),
+                                static_cast<uint16_t>(1U + (random() % 12U)), static_cast<uint16_t>(1U + (random() % 9U))};
+                ASSERT_EQ(gfx.Fill(buffers.scene, rect, 0xFF000000U | random()), Status::OK);
+                chain.Invalidate(rect);
+            }
+            ASSERT_EQ(gfx.Flush(), Status::OK);
+
+            Frame frame{};
+            ASSERT_EQ(chain.Begin(frame), Status::OK);
+            damaged += chain.GetDamage().GetArea();
+            Render(gfx, chain, buffers.scene, frame);
+            ASSERT_EQ(chain.Present(), Status::OK);
+            // with 3 buffers every other frame waits for two line events
+            if (((n % 2U) == 0U) || (count == 2U))
+            {
+                while (display.LineEvent())
+                {
+                }
+                ASSERT_TRUE(chain.IsSwapped());
+                ASSERT_TRUE(ShowsScene(display, buffers.scene)) << count << " buffers, frame " << n;
+            }
+        }
+        EXPECT_TRUE(gfx.IsIdle());
+        EXPECT_EQ(gfx.GetErrorCount(), 0U);
+        // the first frame is complete, after it only damage is drawn and copied
+        const uint32_t full = static_cast<uint32_t>(WIDTH) * HEIGHT;
+        EXPECT_LT(damaged + chain.GetCopiedPixels(), (count + 4U) * full) << count << " buffers";
+        EXPECT_LT(damaged + chain.GetCopiedPixels(), FRAMES * full / 4U) << count << " buffers";
+    }
+}
+
+
+TEST(SwapChain_Test, DumpsPngOfThePanel)
+{
+    DisplaySim display(WIDTH, HEIGHT, 0x0000FFU);
+
+    // bottom layer RGB565 red window, top layer ARGB8888 half transparent white window
+    std::vector<uint16_t> red(32U * 16U, 0xF800U);
+    std::vector<uint32_t> white(8U * 8U, 0x80FFFFFFU);
+    LayerConfig bottom{};
+    bottom.frame = Frame{reinterpret_cast<uint8_t*>(red.data()), 32U, 16U, 64U, PixelFormat::RGB565};
+    bottom.x = 4U;
+    bottom.y = 2U;
+    bottom.enabled = true;
+    LayerConfig top{};
+    top.frame = Frame{reinterpret_cast<uint8_t*>(white.data()), 8U, 8U, 32U, PixelFormat::ARGB8888};
+    top.x = 30U;
+    top.y = 10U;
+    top.enabled = true;
+    ASSERT_EQ(display.Configure(0U, bottom), Status::OK);
+    ASSERT_EQ(display.Configure(1U, top), Status::OK);
+    top.x = 60U;
+    EXPECT_EQ(display.Configure(1U, top), Status::INVALID_PARAM);
+    EXPECT_EQ(display.Configure(2U, bottom), Status::INVALID_PARAM);
+
+    // nothing shown before the commit and the line event
+    const uint32_t* pPanel = reinterpret_cast<const uint32_t*>(display.Scanout().pData);
+    EXPECT_EQ(pPanel[(10U * WIDTH) + 30U], 0xFF0000FFU);
+    EXPECT_FALSE(display.LineEvent());
+    ASSERT_EQ(display.Commit(), Status::OK);
+    ASSERT_TRUE(display.LineEvent());
+    pPanel = reinterpret_cast<const uint32_t*>(display.Scanout().pData);
+    EXPECT_EQ(pPanel[0], 0xFF0000FFU);
+    EXPECT_EQ(pPanel[(2U * WIDTH) + 4U], 0xFFFF0000U);
+    EXPECT_EQ(pPanel[(10U * WIDTH) + 30U], 0xFFFF8080U);
+    EXPECT_EQ(pPanel[(10U * WIDTH) + 36U], 0xFF8080FFU);
+
+    std::vector<uint8_t> png;
+    DisplaySim::EncodePng(display.Scanout(), png);
+    const uint8_t SIGNATURE[] = {0x89U, 'P', 'N', 'G', '\r', '\n', 0x1AU, '\n'};
+    ASSERT_GT(png.size(), sizeof(SIGNATURE));
+    ASSERT_EQ(std::memcmp(png.data(), SIGNATURE, sizeof(SIGNATURE)), 0);
+
+    // walk the chunks, check the CRCs and collect the image data
+    std::vector<uint8_t> zlib;
+    std::vector<std::string> types;
+    size_t offset = sizeof(SIGNATURE);
+    while ((offset + 12U) <= png.size())
+    {
+        const uint32_t length = Word(png, offset);
+        ASSERT_LE(offset + 12U + length, png.size());
+        types.emplace_back(reinterpret_cast<const char*>(&png[offset + 4U]), 4U);
+        EXPECT_EQ(Word(png, offset + 8U + length), Crc32(&png[offset + 4U], length + 4U)) << types.back();
+        if (types.back() == "IHDR")
+        {
+            EXPECT_EQ(Word(png, offset + 8U), WIDTH);
+            EXPECT_EQ(Word(png, offset + 12U), HEIGHT);
+            EXPECT_EQ(png[offset + 16U], 8U);
+            EXPECT_EQ(png[offset + 17U], 6U);
+        }
+        if (types.back() == "IDAT")
+        {
+            zlib.insert(zlib.end(), png.begin() + static_cast<ptrdiff_t>(offset + 8U),
+                        png.begin() + static_cast<ptrdiff_t>(offset + 8U + length));
+        }
+        offset += 12U + length;
+    }
+    EXPECT_EQ(offset, png.size());
+    EXPECT_THAT(types, ::testing::ElementsAre("IHDR", "IDAT", "IEND"));
+
+    // stored deflate blocks
+    ASSERT_GE(zlib.size(), 6U);
+    EXPECT_EQ(((zlib[0] << 8U) | zlib[1]) % 31U, 0U);
+    std::vector<uint8_t> raw;
+    size_t position = 2U;
+    bool last = false;
+    while (!last && ((position + 5U) <= zlib.size()))
+    {
+        last = (zlib[position] & 1U) != 0U;
+        ASSERT_EQ(zlib[position] & 6U, 0U);
+        const uint32_t length = zlib[position + 1U] | (zlib[position + 2U] << 8U);
+        ASSERT_EQ(length ^ (zlib[position + 3U] | (zlib[position + 4U] << 8U)), 0xFFFFU);
+        raw.insert(raw.end(), zlib.begin() + static_cast<ptrdiff_t>(position + 5U),
+                   zlib.begin() + static_cast<ptrdiff_t>(position + 5U + length));
+        position += 5U + length;
+    }
+    EXPECT_TRUE(last);
+    EXPECT_EQ(position + 4U, zlib.size());
+    ASSERT_EQ(raw.size(), HEIGHT * (1U + (WIDTH * 4U)));
+
+    // RGBA of the panel, a blended pixel
+    const uint8_t* pLine = &raw[10U * (1U + (WIDTH * 4U))];
+    EXPECT_EQ(pLine[0], 0U);
+    EXPECT_EQ(pLine[1U + (30U * 4U)], 0xFFU);
+    EXPECT_EQ(pLine[2U + (30U * 4U)], 0x80U);
+    EXPECT_EQ(pLine[3U + (30U * 4U)], 0x80U);
+    EXPECT_EQ(pLine[4U + (30U * 4U)], 0xFFU);
+
+    const std::string path = ::testing::TempDir() + "TestSwapChainPanel.png";
+    EXPECT_EQ(display.DumpPng(path.c_str()), Status::OK);
+    EXPECT_EQ(display.DumpPng("/nonexistent/panel.png"), Status::HW_ERROR);
+}
+
+} // end namespace GTest